@@ -587,6 +587,32 @@ int wc_ecc_free(ecc_key* key);
 WOLFSSL_API
 void wc_ecc_fp_free(void);
 
+/*!
+    \ingroup ECC
+
+    \brief This function sets the number of public points the fixed-point
+    cache keeps a lookup table for. Each thread resizes its cache, dropping
+    the tables already built, on its next fixed-point operation. Curve
+    generator tables are shared by all threads and not counted. To use this
+    functionality, FP_ECC (fixed-point ecc), should be defined.
+
+    \return 0 Returned on success.
+    \return BAD_FUNC_ARG Returned if entries is less than 2 or more than
+    FP_MAX_ENTRIES.
+
+    \param entries number of cache entries
+
+    _Example_
+    \code
+    // keep the tables of up to 64 intermediate CA keys per thread
+    wc_ecc_fp_set_entries(64);
+    \endcode
+
+    \sa wc_ecc_fp_free
+*/
+WOLFSSL_API
+int wc_ecc_fp_set_entries(int entries);
+
 /*!
     \ingroup ECC
 
@@ -123,6 +123,45 @@ WOLFSSL_API int wc_HmacFinal(Hmac*, byte*);
 */
 WOLFSSL_API int wolfSSL_GetHmacMaxSize(void);
 
+/*!
+    \ingroup HMAC
+
+    \brief Computes HMAC-SHA256 of count independent messages, each with its
+    own key, using wc_Sha256_MultiBuffer to hash several at once. Requires
+    WOLFSSL_SHA256_MULTI_BUFFER (--enable-sha256mb).
+
+    \return 0 Success
+    \return BAD_FUNC_ARG an array is NULL, a key is NULL with a non-zero
+    size, or an output buffer is NULL.
+
+    \param key array of count key pointers.
+    \param keySz array of count key sizes.
+    \param data array of count message pointers.
+    \param sz array of count message sizes.
+    \param mac array of count buffers of WC_SHA256_DIGEST_SIZE bytes.
+    \param count number of messages.
+
+    _Example_
+    \code
+    const byte* key[2] = { key1, key2 };
+    word32 keySz[2] = { key1Sz, key2Sz };
+    const byte* data[2] = { msg1, msg2 };
+    word32 sz[2] = { msg1Sz, msg2Sz };
+    byte mac1[WC_SHA256_DIGEST_SIZE], mac2[WC_SHA256_DIGEST_SIZE];
+    byte* mac[2] = { mac1, mac2 };
+
+    if (wc_HmacSha256_MultiBuffer(key, keySz, data, sz, mac, 2) != 0) {
+        // error computing the MACs
+    }
+    \endcode
+
+    \sa wc_Sha256_MultiBuffer
+    \sa wc_HmacSetKey
+*/
+WOLFSSL_API int wc_HmacSha256_MultiBuffer(const byte* const* key,
+                            const word32* keySz, const byte* const* data,
+                            const word32* sz, byte* const* mac, word32 count);
+
 /*!
     \ingroup HMAC
 
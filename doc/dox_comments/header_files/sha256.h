@@ -123,6 +123,42 @@ WOLFSSL_API int wc_Sha256Final(wc_Sha256*, byte*);
 */
 WOLFSSL_API void wc_Sha256Free(wc_Sha256*);
 
+/*!
+    \ingroup SHA
+
+    \brief Hashes count independent messages with SHA-256. With
+    --enable-intelasm, up to WC_SHA256_MB_LANES messages are hashed side by
+    side: eight AVX2 lanes, or two interleaved streams when the CPU has the
+    SHA extensions. Otherwise the messages are hashed one after the other.
+    Requires WOLFSSL_SHA256_MULTI_BUFFER (--enable-sha256mb).
+
+    \return 0 Success
+    \return BAD_FUNC_ARG data, sz or hash is NULL, a message is NULL with a
+    non-zero size, or an output buffer is NULL.
+
+    \param data array of count message pointers.
+    \param sz array of count message sizes.
+    \param hash array of count buffers of WC_SHA256_DIGEST_SIZE bytes.
+    \param count number of messages.
+
+    _Example_
+    \code
+    const byte* data[2] = { msg1, msg2 };
+    word32 sz[2] = { msg1Sz, msg2Sz };
+    byte hash1[WC_SHA256_DIGEST_SIZE], hash2[WC_SHA256_DIGEST_SIZE];
+    byte* hash[2] = { hash1, hash2 };
+
+    if (wc_Sha256_MultiBuffer(data, sz, hash, 2) != 0) {
+        // error hashing messages
+    }
+    \endcode
+
+    \sa wc_Sha256Hash
+    \sa wc_HmacSha256_MultiBuffer
+*/
+WOLFSSL_API int wc_Sha256_MultiBuffer(const byte* const* data,
+                            const word32* sz, byte* const* hash, word32 count);
+
 /*!
     \ingroup SHA
 
@@ -73,6 +73,35 @@ bench_tls(args);
     #include <pthread.h>
 #endif
 
+/* CRL lookup benchmark signs a synthetic CRL with the test CA */
+#if defined(HAVE_CRL) && !defined(NO_RSA) && !defined(NO_SHA256) && \
+    !defined(NO_SIG_WRAPPER) && !defined(NO_ASN_TIME)
+    #define BENCH_CRL
+    #include <wolfssl/wolfcrypt/rsa.h>
+    #include <wolfssl/wolfcrypt/signature.h>
+    #include <time.h>
+#endif
+
+/* Bulk write benchmark runs a client and server over a socketpair */
+#if defined(HAVE_PTHREAD) && defined(HAVE_AESGCM) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_USER_IO) && !defined(USE_WINDOWS_API)
+    #define BENCH_BULK
+#endif
+
+/* Connection setup benchmark creates and frees SSL objects in threads */
+#if defined(HAVE_PTHREAD) && !defined(NO_WOLFSSL_CLIENT)
+    #define BENCH_CONN
+#endif
+
+/* CA directory load benchmark writes generated ECC CA certs to a directory */
+#if defined(WOLFSSL_CERT_GEN) && defined(HAVE_ECC) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_WOLFSSL_DIR) && \
+    !defined(USE_WINDOWS_API)
+    #define BENCH_CA_LOAD
+    #include <wolfssl/wolfcrypt/ecc.h>
+    #include <wolfssl/wolfcrypt/asn_public.h>
+#endif
+
 #if 0
 #define BENCH_USE_NONBLOCK
 #endif
@@ -264,6 +293,7 @@ typedef struct {
     double rxTime;
     double txTime;
     int connCount;
+    int resumeCount;
     int rxTotal;
     int txTotal;
 } stats_t;
@@ -283,6 +313,7 @@ typedef struct {
     int runTimeSec;
     int showPeerInfo;
     int showVerbose;
+    int doResume;
 #ifndef NO_WOLFSSL_SERVER
     int listenFd;
 #endif
@@ -781,6 +812,9 @@ static int bench_tls_client(info_t* info)
     int ret, readBufSz;
     WOLFSSL_CTX* cli_ctx = NULL;
     WOLFSSL* cli_ssl = NULL;
+#ifndef NO_SESSION_CACHE
+    WOLFSSL_SESSION* session = NULL;
+#endif
     int haveShownPeerInfo = 0;
     int tls13 = XSTRNCMP(info->cipher, "TLS13", 5) == 0;
     int total_sz;
@@ -905,6 +939,16 @@ static int bench_tls_client(info_t* info)
         wolfSSL_SetIOReadCtx(cli_ssl, info);
         wolfSSL_SetIOWriteCtx(cli_ssl, info);
 
+#ifndef NO_SESSION_CACHE
+        /* resume from the session cache shared by all threads */
+        if (info->doResume && session != NULL) {
+            ret = wolfSSL_set_session(cli_ssl, session);
+            if (ret != WOLFSSL_SUCCESS) {
+                session = NULL; /* expired, do a full handshake */
+            }
+        }
+#endif
+
 #if defined(HAVE_PTHREAD) && defined(WOLFSSL_DTLS)
         /* synchronize with server */
         if (info->doDTLS && !info->clientOrserverOnly) {
@@ -937,6 +981,9 @@ static int bench_tls_client(info_t* info)
         }
         info->client_stats.connTime += start;
         info->client_stats.connCount++;
+        if (wolfSSL_session_reused(cli_ssl)) {
+            info->client_stats.resumeCount++;
+        }
 
         if ((info->showPeerInfo) && (!haveShownPeerInfo)) {
             haveShownPeerInfo = 1;
@@ -1020,6 +1067,12 @@ static int bench_tls_client(info_t* info)
 
         CloseAndCleanupSocket(&info->client.sockFd);
 
+#ifndef NO_SESSION_CACHE
+        if (info->doResume) {
+            session = wolfSSL_get_session(cli_ssl);
+        }
+#endif
+
         wolfSSL_free(cli_ssl);
         cli_ssl = NULL;
     }
@@ -1497,6 +1550,648 @@ static void print_stats(stats_t* wcStat, const char* desc, const char* cipher, i
            wcStat->connTime * 1000 / wcStat->connCount);
 }
 
+#ifdef BENCH_CRL
+/* DER encoded sha256WithRSAEncryption AlgorithmIdentifier */
+static const byte benchCrlSigAlgo[] = {
+    0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86,
+    0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00
+};
+#define BENCH_CRL_SERIAL_SZ 8
+#define BENCH_CRL_TIME_SZ   13 /* YYMMDDHHMMSSZ */
+#define BENCH_CRL_ENTRY_SZ  (2 + 2 + BENCH_CRL_SERIAL_SZ + 2 + BENCH_CRL_TIME_SZ)
+
+/* write DER tag and length to out, returns header size */
+static word32 BenchCrlHeader(byte* out, byte tag, word32 len)
+{
+    word32 i = 0, lenBytes = 0, j;
+
+    out[i++] = tag;
+    if (len < 0x80) {
+        out[i++] = (byte)len;
+        return i;
+    }
+    for (j = len; j > 0; j >>= 8)
+        lenBytes++;
+    out[i++] = (byte)(0x80 | lenBytes);
+    for (j = lenBytes; j > 0; j--)
+        out[i++] = (byte)(len >> ((j - 1) * 8));
+
+    return i;
+}
+
+static word32 BenchCrlHeaderSz(word32 len)
+{
+    byte hdr[8];
+    return BenchCrlHeader(hdr, 0, len);
+}
+
+/* read DER tag and length at *idx, leaves *idx after the header */
+static int BenchCrlGetHeader(const byte* in, word32 inSz, word32* idx,
+    word32* len)
+{
+    word32 i = *idx + 1, lenBytes;
+
+    if (i >= inSz)
+        return -1;
+    *len = in[i++];
+    if (*len & 0x80) {
+        lenBytes = *len & 0x7f;
+        if (lenBytes > 3 || i + lenBytes > inSz)
+            return -1;
+        for (*len = 0; lenBytes > 0; lenBytes--)
+            *len = (*len << 8) | in[i++];
+    }
+    if (i + *len > inSz)
+        return -1;
+    *idx = i;
+
+    return 0;
+}
+
+/* find the raw issuer Name in a DER certificate */
+static int BenchCrlCertIssuer(const byte* cert, word32 certSz,
+    const byte** name, word32* nameSz)
+{
+    word32 idx = 0, len, start;
+    int skip;
+
+    /* Certificate and TBSCertificate SEQUENCEs */
+    if (BenchCrlGetHeader(cert, certSz, &idx, &len) != 0 ||
+        BenchCrlGetHeader(cert, certSz, &idx, &len) != 0)
+        return -1;
+    /* optional version, serial and signature algorithm */
+    for (skip = (cert[idx] == 0xa0) ? 3 : 2; skip > 0; skip--) {
+        if (BenchCrlGetHeader(cert, certSz, &idx, &len) != 0)
+            return -1;
+        idx += len;
+    }
+    start = idx;
+    if (BenchCrlGetHeader(cert, certSz, &idx, &len) != 0)
+        return -1;
+    *name = cert + start;
+    *nameSz = idx + len - start;
+
+    return 0;
+}
+
+static void BenchCrlTime(byte* out, time_t t)
+{
+    char buf[BENCH_CRL_TIME_SZ + 3];
+
+    /* UTCTime drops the century */
+    strftime(buf, sizeof(buf), "%Y%m%d%H%M%SZ", gmtime(&t));
+    XMEMCPY(out, buf + 2, BENCH_CRL_TIME_SZ);
+}
+
+/* Build a CRL signed by the 2048-bit test CA revoking count random serials */
+static int BenchCrlCreate(int count, byte** out, word32* outSz)
+{
+    WC_RNG  rng;
+    RsaKey  key;
+    const byte* issuer = NULL;
+    word32  issuerSz = 0, idx = 0, keyIdx = 0, tbsIdx;
+    word32  revokedSz, tbsContentSz, tbsSz, sigSz, crlContentSz, crlSz;
+    word32  i, j;
+    word32  serial = 0x2545F491, part[2];
+    byte    thisUpdate[BENCH_CRL_TIME_SZ], nextUpdate[BENCH_CRL_TIME_SZ];
+    byte*   crl;
+    int     ret;
+
+    if (BenchCrlCertIssuer(ca_cert_der_2048, sizeof_ca_cert_der_2048,
+                                                &issuer, &issuerSz) != 0)
+        return -1;
+
+    BenchCrlTime(thisUpdate, time(NULL) - 24 * 60 * 60);
+    BenchCrlTime(nextUpdate, time(NULL) + 24 * 60 * 60);
+
+    ret = wc_InitRng(&rng);
+    if (ret != 0)
+        return ret;
+    ret = wc_InitRsaKey(&key, NULL);
+    if (ret != 0) {
+        wc_FreeRng(&rng);
+        return ret;
+    }
+    ret = wc_RsaPrivateKeyDecode(ca_key_der_2048, &keyIdx, &key,
+                                 sizeof_ca_key_der_2048);
+    if (ret != 0)
+        goto exit;
+    sigSz = (word32)wc_SignatureGetSize(WC_SIGNATURE_TYPE_RSA_W_ENC, &key,
+                                        sizeof(key));
+
+    revokedSz = (word32)count * BENCH_CRL_ENTRY_SZ;
+    tbsContentSz = 3 + sizeof(benchCrlSigAlgo) + issuerSz +
+                   2 * (2 + BENCH_CRL_TIME_SZ) +
+                   BenchCrlHeaderSz(revokedSz) + revokedSz;
+    tbsSz = BenchCrlHeaderSz(tbsContentSz) + tbsContentSz;
+    crlContentSz = tbsSz + sizeof(benchCrlSigAlgo) +
+                   BenchCrlHeaderSz(sigSz + 1) + sigSz + 1;
+    crlSz = BenchCrlHeaderSz(crlContentSz) + crlContentSz;
+
+    crl = (byte*)XMALLOC(crlSz, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    if (crl == NULL) {
+        ret = MEMORY_E;
+        goto exit;
+    }
+
+    /* CertificateList and TBSCertList */
+    idx += BenchCrlHeader(crl + idx, 0x30, crlContentSz);
+    tbsIdx = idx;
+    idx += BenchCrlHeader(crl + idx, 0x30, tbsContentSz);
+    crl[idx++] = 0x02; crl[idx++] = 0x01; crl[idx++] = 0x01; /* v2 */
+    XMEMCPY(crl + idx, benchCrlSigAlgo, sizeof(benchCrlSigAlgo));
+    idx += sizeof(benchCrlSigAlgo);
+    XMEMCPY(crl + idx, issuer, issuerSz);
+    idx += issuerSz;
+    idx += BenchCrlHeader(crl + idx, 0x17, BENCH_CRL_TIME_SZ);
+    XMEMCPY(crl + idx, thisUpdate, BENCH_CRL_TIME_SZ);
+    idx += BENCH_CRL_TIME_SZ;
+    idx += BenchCrlHeader(crl + idx, 0x17, BENCH_CRL_TIME_SZ);
+    XMEMCPY(crl + idx, nextUpdate, BENCH_CRL_TIME_SZ);
+    idx += BENCH_CRL_TIME_SZ;
+
+    /* revokedCertificates, xorshift serials so the list is unsorted */
+    idx += BenchCrlHeader(crl + idx, 0x30, revokedSz);
+    for (i = 0; i < (word32)count; i++) {
+        for (j = 0; j < 2; j++) {
+            serial ^= serial << 13;
+            serial ^= serial >> 17;
+            serial ^= serial << 5;
+            part[j] = serial;
+        }
+        /* keep serials positive and longer than the test cert serials */
+        part[0] = (part[0] & 0x3fffffff) | 0x40000000;
+
+        crl[idx++] = 0x30;
+        crl[idx++] = BENCH_CRL_ENTRY_SZ - 2;
+        crl[idx++] = 0x02;
+        crl[idx++] = BENCH_CRL_SERIAL_SZ;
+        for (j = 0; j < BENCH_CRL_SERIAL_SZ; j++)
+            crl[idx++] = (byte)(part[j / 4] >> ((3 - (j % 4)) * 8));
+        crl[idx++] = 0x17;
+        crl[idx++] = BENCH_CRL_TIME_SZ;
+        XMEMCPY(crl + idx, thisUpdate, BENCH_CRL_TIME_SZ);
+        idx += BENCH_CRL_TIME_SZ;
+    }
+
+    /* signatureAlgorithm and signatureValue */
+    XMEMCPY(crl + idx, benchCrlSigAlgo, sizeof(benchCrlSigAlgo));
+    idx += sizeof(benchCrlSigAlgo);
+    idx += BenchCrlHeader(crl + idx, 0x03, sigSz + 1);
+    crl[idx++] = 0x00;
+    ret = wc_SignatureGenerate(WC_HASH_TYPE_SHA256, WC_SIGNATURE_TYPE_RSA_W_ENC,
+        crl + tbsIdx, tbsSz, crl + idx, &sigSz, &key, sizeof(key), &rng);
+    if (ret != 0) {
+        XFREE(crl, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        goto exit;
+    }
+
+    *out = crl;
+    *outSz = crlSz;
+
+exit:
+    wc_FreeRsaKey(&key);
+    wc_FreeRng(&rng);
+
+    return ret;
+}
+
+/* Load a CRL with count revoked serials and time revocation checks */
+static int bench_crl(int count, int runTimeSec)
+{
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+    byte*  crl = NULL;
+    word32 crlSz = 0;
+    double start, total;
+    int    checks = 0;
+    int    ret;
+
+    ret = BenchCrlCreate(count, &crl, &crlSz);
+    if (ret != 0) {
+        printf("Creating synthetic CRL failed %d\n", ret);
+        return ret;
+    }
+
+    cm = wolfSSL_CertManagerNew();
+    if (cm == NULL) {
+        ret = MEMORY_E; goto exit;
+    }
+    ret = wolfSSL_CertManagerLoadCABuffer(cm, ca_cert_der_2048,
+        sizeof_ca_cert_der_2048, WOLFSSL_FILETYPE_ASN1);
+    if (ret != WOLFSSL_SUCCESS)
+        goto exit;
+
+    start = gettime_secs(1);
+    ret = wolfSSL_CertManagerLoadCRLBuffer(cm, crl, crlSz,
+                                           WOLFSSL_FILETYPE_ASN1);
+    total = gettime_secs(0) - start;
+    if (ret != WOLFSSL_SUCCESS)
+        goto exit;
+    printf("CRL with %d revoked certs (%u bytes) loaded in %.3f ms\n",
+        count, crlSz, total * 1000);
+
+    /* the server cert is not on the list so each check is a full miss */
+    start = gettime_secs(1);
+    do {
+        ret = wolfSSL_CertManagerCheckCRL(cm, (byte*)server_cert_der_2048,
+                                          sizeof_server_cert_der_2048);
+        if (ret != WOLFSSL_SUCCESS)
+            goto exit;
+        checks++;
+        total = gettime_secs(0) - start;
+    } while (total < runTimeSec);
+
+    printf("CRL check: %d checks in %.3f sec, %.3f us/check\n",
+        checks, total, total * 1000000 / checks);
+
+exit:
+    if (ret != WOLFSSL_SUCCESS) {
+        printf("CRL Error: %d (%s)\n", ret,
+            wolfSSL_ERR_reason_error_string(ret));
+    }
+    else {
+        ret = 0;
+    }
+    wolfSSL_CertManagerFree(cm);
+    XFREE(crl, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+#endif /* BENCH_CRL */
+
+#ifdef BENCH_BULK
+#ifdef WOLFSSL_TLS13
+    #define BENCH_BULK_CIPHER "TLS13-AES128-GCM-SHA256"
+#else
+    #define BENCH_BULK_CIPHER "ECDHE-RSA-AES128-GCM-SHA256"
+#endif
+
+typedef struct {
+    WOLFSSL* ssl;
+    double   bytes;
+    int      ret;
+} bench_bulk_t;
+
+/* read until the client closes */
+static void* bench_bulk_server(void* args)
+{
+    bench_bulk_t* srv = (bench_bulk_t*)args;
+    byte buf[16 * 1024];
+    int  ret;
+
+    srv->ret = wolfSSL_accept(srv->ssl) == WOLFSSL_SUCCESS ? 0 : -1;
+    while (srv->ret == 0 &&
+                       (ret = wolfSSL_read(srv->ssl, buf, sizeof(buf))) > 0) {
+        srv->bytes += ret;
+    }
+
+    return NULL;
+}
+
+/* Time writeSz byte writes for runTimeSec */
+static int bench_bulk_run(WOLFSSL_CTX* cliCtx, WOLFSSL_CTX* srvCtx,
+    const byte* data, int writeSz, int runTimeSec)
+{
+    WOLFSSL*     cli = NULL;
+    bench_bulk_t srv;
+    pthread_t    tid;
+    int          sv[2];
+    double       start, total = 0;
+    int          ret = -1;
+
+    XMEMSET(&srv, 0, sizeof(srv));
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+        printf("socketpair failed\n");
+        return -1;
+    }
+
+    cli = wolfSSL_new(cliCtx);
+    srv.ssl = wolfSSL_new(srvCtx);
+    if (cli == NULL || srv.ssl == NULL)
+        goto exit;
+    wolfSSL_set_fd(cli, sv[0]);
+    wolfSSL_set_fd(srv.ssl, sv[1]);
+
+    if (pthread_create(&tid, NULL, bench_bulk_server, &srv) != 0)
+        goto exit;
+    if (wolfSSL_connect(cli) == WOLFSSL_SUCCESS) {
+        start = gettime_secs(1);
+        do {
+            if (wolfSSL_write(cli, data, writeSz) != writeSz)
+                break;
+            total = gettime_secs(0) - start;
+        } while (total < runTimeSec);
+        wolfSSL_shutdown(cli);
+    }
+    shutdown(sv[0], SHUT_WR);
+    pthread_join(tid, NULL);
+
+    if (srv.ret != 0 || total <= 0) {
+        printf("Bulk write failed: client %d, server %d\n",
+            wolfSSL_get_error(cli, 0), wolfSSL_get_error(srv.ssl, 0));
+    }
+    else {
+        printf("%-26s %10.3f MB/s (%d byte writes)\n",
+            wolfSSL_get_cipher_name(cli),
+            srv.bytes / total / 1024 / 1024, writeSz);
+        ret = 0;
+    }
+
+exit:
+    wolfSSL_free(cli);
+    wolfSSL_free(srv.ssl);
+    close(sv[0]);
+    close(sv[1]);
+
+    return ret;
+}
+
+/* Bulk write throughput over a socketpair */
+static int bench_bulk(int writeSz, int runTimeSec, const char* cipher)
+{
+    WOLFSSL_CTX* cliCtx = NULL;
+    WOLFSSL_CTX* srvCtx = NULL;
+    byte* data = NULL;
+    int   ret = -1;
+
+    if (cipher == NULL)
+        cipher = BENCH_BULK_CIPHER;
+
+    data = (byte*)XMALLOC(writeSz, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#if defined(WOLFSSL_TLS13) && !defined(WOLFSSL_NO_TLS12)
+    if (XSTRNCMP(cipher, "TLS13", 5) != 0)
+        cliCtx = wolfSSL_CTX_new(wolfTLSv1_2_client_method());
+    else
+#endif
+        cliCtx = wolfSSL_CTX_new(wolfSSLv23_client_method());
+    srvCtx = wolfSSL_CTX_new(wolfSSLv23_server_method());
+    if (data == NULL || cliCtx == NULL || srvCtx == NULL)
+        goto exit;
+    XMEMSET(data, 0x5a, writeSz);
+
+    wolfSSL_CTX_set_verify(cliCtx, WOLFSSL_VERIFY_NONE, NULL);
+    if (wolfSSL_CTX_use_certificate_buffer(srvCtx, server_cert_der_2048,
+            sizeof_server_cert_der_2048, WOLFSSL_FILETYPE_ASN1)
+                                                        != WOLFSSL_SUCCESS ||
+        wolfSSL_CTX_use_PrivateKey_buffer(srvCtx, server_key_der_2048,
+            sizeof_server_key_der_2048, WOLFSSL_FILETYPE_ASN1)
+                                                        != WOLFSSL_SUCCESS ||
+        wolfSSL_CTX_set_cipher_list(cliCtx, cipher) != WOLFSSL_SUCCESS ||
+        wolfSSL_CTX_set_cipher_list(srvCtx, cipher) != WOLFSSL_SUCCESS) {
+        printf("Bulk setup failed for %s\n", cipher);
+        goto exit;
+    }
+
+    ret = bench_bulk_run(cliCtx, srvCtx, data, writeSz, runTimeSec);
+
+exit:
+    wolfSSL_CTX_free(cliCtx);
+    wolfSSL_CTX_free(srvCtx);
+    XFREE(data, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+#endif /* BENCH_BULK */
+
+#ifdef BENCH_CONN
+typedef struct {
+    WOLFSSL_CTX* ctx;
+    int          runTimeSec;
+    int          count;
+    double       total;
+    int          ret;
+} bench_conn_t;
+
+/* create and free connections until runTimeSec has passed */
+static void* bench_conn_thread(void* args)
+{
+    bench_conn_t* conn = (bench_conn_t*)args;
+    WOLFSSL* ssl;
+    double   start = gettime_secs(1);
+
+    do {
+        ssl = wolfSSL_new(conn->ctx);
+        if (ssl == NULL) {
+            conn->ret = -1;
+            break;
+        }
+        wolfSSL_free(ssl);
+        conn->count++;
+        conn->total = gettime_secs(0) - start;
+    } while (conn->total < conn->runTimeSec);
+#ifdef WOLFSSL_THREAD_LOCAL_RNG
+    wc_RNG_ThreadLocalFree();
+#endif
+
+    return NULL;
+}
+
+/* Connection setup rate with threads each creating their own connections,
+ * covers the per connection RNG instantiation and state allocation */
+static int bench_conn(int threads, int runTimeSec)
+{
+    WOLFSSL_CTX*  ctx;
+    bench_conn_t* conn;
+    pthread_t*    tids;
+    double        rate = 0;
+    int           count = 0, i, started = 0;
+    int           ret = 0;
+
+    ctx = wolfSSL_CTX_new(wolfSSLv23_client_method());
+    conn = (bench_conn_t*)XMALLOC(sizeof(bench_conn_t) * threads, NULL,
+                                  DYNAMIC_TYPE_TMP_BUFFER);
+    tids = (pthread_t*)XMALLOC(sizeof(pthread_t) * threads, NULL,
+                               DYNAMIC_TYPE_TMP_BUFFER);
+    if (ctx == NULL || conn == NULL || tids == NULL) {
+        ret = MEMORY_E; goto exit;
+    }
+    XMEMSET(conn, 0, sizeof(bench_conn_t) * threads);
+
+    for (started = 0; started < threads; started++) {
+        conn[started].ctx = ctx;
+        conn[started].runTimeSec = runTimeSec;
+        if (pthread_create(&tids[started], NULL, bench_conn_thread,
+                                                       &conn[started]) != 0) {
+            ret = -1;
+            break;
+        }
+    }
+    for (i = 0; i < started; i++) {
+        pthread_join(tids[i], NULL);
+        if (conn[i].ret != 0)
+            ret = conn[i].ret;
+        count += conn[i].count;
+        if (conn[i].total > 0)
+            rate += conn[i].count / conn[i].total;
+    }
+
+    if (ret != 0) {
+        printf("Connection setup failed\n");
+    }
+    else {
+        printf("Connection setup, %d threads: %d conns, %.0f conns/sec "
+               "(%.3f us/conn per thread)\n", threads, count, rate,
+               threads * 1000000 / rate);
+    }
+
+exit:
+    wolfSSL_CTX_free(ctx);
+    XFREE(conn, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(tids, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+#endif /* BENCH_CONN */
+
+#ifdef BENCH_CA_LOAD
+#define BENCH_CA_DER_SZ 1024
+#define BENCH_CA_PEM_SZ 2048
+
+/* Write count self-signed ECC CA certs, one PEM file each, to dir */
+static int BenchCaDirCreate(const char* dir, int count)
+{
+    WC_RNG  rng;
+    ecc_key key;
+    Cert    cert;
+    byte    der[BENCH_CA_DER_SZ];
+    byte    pem[BENCH_CA_PEM_SZ];
+    char    name[256];
+    int     derSz, pemSz;
+    int     i;
+    int     ret;
+    FILE*   f;
+
+    ret = wc_InitRng(&rng);
+    if (ret != 0)
+        return ret;
+
+    for (i = 0; i < count && ret == 0; i++) {
+        ret = wc_ecc_init(&key);
+        if (ret != 0)
+            break;
+        ret = wc_ecc_make_key(&rng, 32, &key);
+        if (ret == 0)
+            ret = wc_InitCert(&cert);
+        if (ret == 0) {
+            XSNPRINTF(cert.subject.commonName, CTC_NAME_SIZE,
+                      "wolfSSL bench CA %d", i);
+            XSTRNCPY(cert.subject.org, "wolfSSL", CTC_NAME_SIZE);
+            cert.isCA    = 1;
+            cert.sigType = CTC_SHA256wECDSA;
+            ret = wc_MakeCert_ex(&cert, der, sizeof(der), ECC_TYPE, &key,
+                                 &rng);
+        }
+        if (ret >= 0) {
+            ret = wc_SignCert_ex(cert.bodySz, cert.sigType, der, sizeof(der),
+                                 ECC_TYPE, &key, &rng);
+        }
+        wc_ecc_free(&key);
+        if (ret < 0)
+            break;
+        derSz = ret;
+
+        pemSz = wc_DerToPem(der, derSz, pem, sizeof(pem), CERT_TYPE);
+        if (pemSz <= 0) {
+            ret = pemSz;
+            break;
+        }
+
+        XSNPRINTF(name, sizeof(name), "%s/ca%05d.pem", dir, i);
+        f = fopen(name, "wb");
+        if (f == NULL) {
+            ret = -1;
+            break;
+        }
+        if (fwrite(pem, 1, pemSz, f) != (size_t)pemSz)
+            ret = -1;
+        else
+            ret = 0;
+        fclose(f);
+    }
+
+    wc_FreeRng(&rng);
+
+    return ret;
+}
+
+static void BenchCaDirRemove(const char* dir, int count)
+{
+    char name[256];
+    int  i;
+
+    for (i = 0; i < count; i++) {
+        XSNPRINTF(name, sizeof(name), "%s/ca%05d.pem", dir, i);
+        (void)unlink(name);
+    }
+    (void)rmdir(dir);
+}
+
+/* Time loading a directory of count CA files, one thread then threads */
+static int bench_ca_load(int count, int threads)
+{
+    char   dir[] = "/tmp/wolfssl_bench_caXXXXXX";
+    double start, total;
+    int    runs[2];
+    int    runCnt = 1;
+    int    i;
+    int    ret;
+
+    if (mkdtemp(dir) == NULL) {
+        printf("Creating CA directory failed %d\n", errno);
+        return -1;
+    }
+
+    start = gettime_secs(1);
+    ret = BenchCaDirCreate(dir, count);
+    total = gettime_secs(0) - start;
+    if (ret != 0) {
+        printf("Creating CA certs failed %d\n", ret);
+        BenchCaDirRemove(dir, count);
+        return ret;
+    }
+    printf("Generated %d CA certs in %s (%.3f sec)\n", count, dir, total);
+
+    runs[0] = 1;
+#ifdef WOLFSSL_PARALLEL_CA_LOAD
+    runs[runCnt++] = threads > 1 ? threads : 0; /* 0 keeps the CTX default */
+#else
+    (void)threads;
+#endif
+
+    for (i = 0; i < runCnt; i++) {
+        WOLFSSL_CTX* ctx = wolfSSL_CTX_new(wolfSSLv23_client_method());
+        if (ctx == NULL) {
+            ret = MEMORY_E;
+            break;
+        }
+    #ifdef WOLFSSL_PARALLEL_CA_LOAD
+        if (runs[i] > 0)
+            wolfSSL_CTX_SetLoadVerifyThreads(ctx, runs[i]);
+    #endif
+        start = gettime_secs(1);
+        ret = wolfSSL_CTX_load_verify_locations(ctx, NULL, dir);
+        total = gettime_secs(0) - start;
+        wolfSSL_CTX_free(ctx);
+        if (ret != WOLFSSL_SUCCESS) {
+            printf("CA directory load error: %d (%s)\n", ret,
+                wolfSSL_ERR_reason_error_string(ret));
+            break;
+        }
+        ret = 0;
+        if (runs[i] > 0)
+            printf("CA directory load, %2d thread(s): ", runs[i]);
+        else
+            printf("CA directory load, default threads: ");
+        printf("%.3f ms, %.3f us/cert\n", total * 1000,
+            total * 1000000 / count);
+    }
+
+    BenchCaDirRemove(dir, count);
+
+    return ret;
+}
+#endif /* BENCH_CA_LOAD */
+
 static void Usage(void)
 {
     printf("tls_bench "    LIBWOLFSSL_VERSION_STRING
@@ -1516,6 +2211,21 @@ static void Usage(void)
 #endif
     printf("-S <num>    The total size <num> in bytes (default %d)\n", TEST_MAX_SIZE);
     printf("-v          Show verbose output\n");
+#ifndef NO_SESSION_CACHE
+    printf("-R          Resume sessions, use with -T for session cache contention\n");
+#endif
+#ifdef BENCH_CRL
+    printf("-C <num>    CRL check with <num> revoked certs instead of TLS\n");
+#endif
+#ifdef BENCH_BULK
+    printf("-B <num>    Bulk <num> byte writes over a socketpair (-l cipher)\n");
+#endif
+#ifdef BENCH_CONN
+    printf("-N          Connection setup rate instead of TLS, use with -T\n");
+#endif
+#ifdef BENCH_CA_LOAD
+    printf("-L <num>    Load a directory of <num> CA files, use with -T\n");
+#endif
 #ifdef DEBUG_WOLFSSL
     printf("-d          Enable debug messages\n");
 #endif
@@ -1565,6 +2275,19 @@ int bench_tls(void* args)
     const char* argHost = BENCH_DEFAULT_HOST;
     int argPort = BENCH_DEFAULT_PORT;
     int argShowPeerInfo = 0;
+    int argResume = 0;
+#ifdef BENCH_CRL
+    int argCrlCount = 0;
+#endif
+#ifdef BENCH_BULK
+    int argBulkSize = 0;
+#endif
+#ifdef BENCH_CONN
+    int argConnRate = 0;
+#endif
+#ifdef BENCH_CA_LOAD
+    int argCaLoadCount = 0;
+#endif
 #ifdef HAVE_PTHREAD
     int doShutdown;
 #endif
@@ -1588,7 +2311,7 @@ int bench_tls(void* args)
     wolfSSL_Init();
 
     /* Parse command line arguments */
-    while ((ch = mygetopt(argc, argv, "?" "udeil:p:t:vT:sch:P:mS:")) != -1) {
+    while ((ch = mygetopt(argc, argv, "?" "udeil:p:t:vT:sch:P:mS:RC:B:NL:")) != -1) {
         switch (ch) {
             case '?' :
                 Usage();
@@ -1652,6 +2375,36 @@ int bench_tls(void* args)
                 argShowVerbose = 1;
                 break;
 
+            case 'R' :
+            #ifndef NO_SESSION_CACHE
+                argResume = 1;
+            #endif
+                break;
+
+            case 'C' :
+            #ifdef BENCH_CRL
+                argCrlCount = atoi(myoptarg);
+            #endif
+                break;
+
+            case 'B' :
+            #ifdef BENCH_BULK
+                argBulkSize = atoi(myoptarg);
+            #endif
+                break;
+
+            case 'N' :
+            #ifdef BENCH_CONN
+                argConnRate = 1;
+            #endif
+                break;
+
+            case 'L' :
+            #ifdef BENCH_CA_LOAD
+                argCaLoadCount = atoi(myoptarg);
+            #endif
+                break;
+
             case 'T' :
             #ifdef HAVE_PTHREAD
                 argThreadPairs = atoi(myoptarg);
@@ -1683,6 +2436,34 @@ int bench_tls(void* args)
     /* reset for test cases */
     myoptind = 0;
 
+#ifdef BENCH_CRL
+    if (argCrlCount > 0) {
+        ret = bench_crl(argCrlCount, argRuntimeSec);
+        goto exit;
+    }
+#endif
+
+#ifdef BENCH_BULK
+    if (argBulkSize > 0) {
+        ret = bench_bulk(argBulkSize, argRuntimeSec, argCipherList);
+        goto exit;
+    }
+#endif
+
+#ifdef BENCH_CONN
+    if (argConnRate) {
+        ret = bench_conn(argThreadPairs, argRuntimeSec);
+        goto exit;
+    }
+#endif
+
+#ifdef BENCH_CA_LOAD
+    if (argCaLoadCount > 0) {
+        ret = bench_ca_load(argCaLoadCount, argThreadPairs);
+        goto exit;
+    }
+#endif
+
     if (argCipherList != NULL) {
         /* Use the list from CL argument */
         cipher = argCipherList;
@@ -1773,6 +2554,7 @@ int bench_tls(void* args)
             info->maxSize = argTestMaxSize;
             info->showPeerInfo = argShowPeerInfo;
             info->showVerbose = argShowVerbose;
+            info->doResume = argResume;
         #ifndef NO_WOLFSSL_SERVER
             info->listenFd = listenFd;
         #endif
@@ -1869,6 +2651,8 @@ int bench_tls(void* args)
             cli_comb.connCount += info->client_stats.connCount;
             srv_comb.connCount += info->server_stats.connCount;
 
+            cli_comb.resumeCount += info->client_stats.resumeCount;
+
             cli_comb.connTime += info->client_stats.connTime;
             srv_comb.connTime += info->server_stats.connTime;
 
@@ -1902,6 +2686,11 @@ int bench_tls(void* args)
         #endif
         }
 
+        if (argResume && !argServerOnly) {
+            printf("Resumed %d of %d client connections\n",
+                cli_comb.resumeCount, cli_comb.connCount);
+        }
+
         /* target next cipher */
         cipher = (next_cipher != NULL) ? (next_cipher + 1) : NULL;
     } /* while */
@@ -55,6 +55,7 @@ int InitCRL(WOLFSSL_CRL* crl, WOLFSSL_CERT_MANAGER* cm)
         crl->heap = NULL;
     crl->cm = cm;
     crl->crlList = NULL;
+    XMEMSET(crl->crlTable, 0, sizeof(crl->crlTable));
     crl->monitors[0].path = NULL;
     crl->monitors[1].path = NULL;
 #ifdef HAVE_CRL_MONITOR
@@ -75,6 +76,125 @@ int InitCRL(WOLFSSL_CRL* crl, WOLFSSL_CERT_MANAGER* cm)
 }
 
 
+/* issuerHash is a SHA digest of the issuer name, use first 32 bits as row */
+static WC_INLINE word32 HashCRL(const byte* issuerHash)
+{
+    return (((word32)issuerHash[0] << 24) | ((word32)issuerHash[1] << 16) |
+            ((word32)issuerHash[2] <<  8) |  (word32)issuerHash[3]) %
+            CRL_TABLE_SIZE;
+}
+
+
+/* Order revoked certs by serial size then serial bytes */
+static int CompareRevokedSerial(const RevokedCert* rc, const byte* serial,
+                                int serialSz)
+{
+    if (rc->serialSz != serialSz)
+        return rc->serialSz < serialSz ? -1 : 1;
+
+    return XMEMCMP(rc->serialNumber, serial, serialSz);
+}
+
+
+static void SiftDownRevoked(RevokedCert** idx, int i, int sz)
+{
+    RevokedCert* tmp;
+    int          child;
+
+    while ((child = 2 * i + 1) < sz) {
+        if (child + 1 < sz && CompareRevokedSerial(idx[child],
+                idx[child + 1]->serialNumber, idx[child + 1]->serialSz) < 0)
+            child++;
+        if (CompareRevokedSerial(idx[i], idx[child]->serialNumber,
+                                 idx[child]->serialSz) >= 0)
+            break;
+        tmp = idx[i];
+        idx[i] = idx[child];
+        idx[child] = tmp;
+        i = child;
+    }
+}
+
+
+/* Build the sorted serial index of the revoked cert list once at load time so
+ * checks can binary search instead of walking the list. The index is only an
+ * optimization, on allocation failure lookups fall back to the list */
+static void IndexRevokedCerts(CRL_Entry* crle, void* heap)
+{
+    RevokedCert* rc;
+    RevokedCert* tmp;
+    int          sz = 0;
+    int          i;
+
+    crle->certsIndex = NULL;
+    crle->totalIndex = 0;
+
+    for (rc = crle->certs; rc != NULL; rc = rc->next)
+        sz++;
+    if (sz == 0)
+        return;
+
+    crle->certsIndex = (RevokedCert**)XMALLOC(sizeof(RevokedCert*) * sz, heap,
+                                              DYNAMIC_TYPE_REVOKED);
+    if (crle->certsIndex == NULL) {
+        WOLFSSL_MSG("alloc CRL serial index failed, using list");
+        return;
+    }
+
+    for (i = 0, rc = crle->certs; rc != NULL; rc = rc->next)
+        crle->certsIndex[i++] = rc;
+
+    /* heap sort, no recursion or extra memory */
+    for (i = sz / 2 - 1; i >= 0; i--)
+        SiftDownRevoked(crle->certsIndex, i, sz);
+    for (i = sz - 1; i > 0; i--) {
+        tmp = crle->certsIndex[0];
+        crle->certsIndex[0] = crle->certsIndex[i];
+        crle->certsIndex[i] = tmp;
+        SiftDownRevoked(crle->certsIndex, 0, i);
+    }
+
+    crle->totalIndex = sz;
+
+    (void)heap;
+}
+
+
+/* Is serial on the revoked list of crle, 1 if revoked */
+static int FindRevokedCert(const CRL_Entry* crle, const byte* serial,
+                           int serialSz)
+{
+    RevokedCert* rc;
+
+    if (crle->certsIndex != NULL) {
+        int lo = 0;
+        int hi = crle->totalIndex - 1;
+
+        while (lo <= hi) {
+            int mid = lo + (hi - lo) / 2;
+            int cmp = CompareRevokedSerial(crle->certsIndex[mid], serial,
+                                           serialSz);
+            if (cmp == 0)
+                return 1;
+            if (cmp < 0)
+                lo = mid + 1;
+            else
+                hi = mid - 1;
+        }
+
+        return 0;
+    }
+
+    for (rc = crle->certs; rc != NULL; rc = rc->next) {
+        if (rc->serialSz == serialSz &&
+                XMEMCMP(rc->serialNumber, serial, rc->serialSz) == 0)
+            return 1;
+    }
+
+    return 0;
+}
+
+
 /* Initialize CRL Entry */
 static int InitCRL_Entry(CRL_Entry* crle, DecodedCRL* dcrl, const byte* buff,
                          int verified, void* heap)
@@ -88,6 +208,11 @@ static int InitCRL_Entry(CRL_Entry* crle, DecodedCRL* dcrl, const byte* buff,
     XMEMCPY(crle->nextDate, dcrl->nextDate, MAX_DATE_SIZE);
     crle->lastDateFormat = dcrl->lastDateFormat;
     crle->nextDateFormat = dcrl->nextDateFormat;
+    crle->tableNext = NULL;
+    crle->certsIndex = NULL;
+    crle->totalIndex = 0;
+    crle->refCount = 1;          /* held by the list */
+    crle->verifying = 0;
 
     crle->certs = dcrl->certs;   /* take ownsership */
     dcrl->certs = NULL;
@@ -120,6 +245,8 @@ static int InitCRL_Entry(CRL_Entry* crle, DecodedCRL* dcrl, const byte* buff,
         crle->signature = NULL;
     }
 
+    IndexRevokedCerts(crle, heap);
+
     (void)verified;
     (void)heap;
 
@@ -140,6 +267,8 @@ static void FreeCRL_Entry(CRL_Entry* crle, void* heap)
         XFREE(tmp, heap, DYNAMIC_TYPE_REVOKED);
         tmp = next;
     }
+    if (crle->certsIndex != NULL)
+        XFREE(crle->certsIndex, heap, DYNAMIC_TYPE_REVOKED);
     if (crle->signature != NULL)
         XFREE(crle->signature, heap, DYNAMIC_TYPE_REVOKED);
     if (crle->toBeSigned != NULL)
@@ -186,149 +315,168 @@ void FreeCRL(WOLFSSL_CRL* crl, int dynamic)
 }
 
 
+/* Drop a verifier of a pinned entry, caller holds crlLock. The signed data is
+ * only needed until the last verifier is done with it */
+static void DoneVerifyCRL_Entry(CRL_Entry* crle, void* heap)
+{
+    if (--crle->verifying == 0 && crle->verified != 0) {
+        XFREE(crle->toBeSigned, heap, DYNAMIC_TYPE_CRL_ENTRY);
+        crle->toBeSigned = NULL;
+        XFREE(crle->signature, heap, DYNAMIC_TYPE_CRL_ENTRY);
+        crle->signature = NULL;
+    }
+
+    (void)heap;
+}
+
+
+/* Drop a reference taken by CheckCertCRLList, and its verifying count if the
+ * lazy verify could not. The last reference to an entry that was swapped off
+ * the list frees it */
+static void ReleaseCRL_Entry(WOLFSSL_CRL* crl, CRL_Entry* crle, int verifying)
+{
+    int doFree;
+
+    if (wc_LockMutex(&crl->crlLock) != 0) {
+        WOLFSSL_MSG("wc_LockMutex failed, leaking CRL entry reference");
+        return;
+    }
+    if (verifying)
+        DoneVerifyCRL_Entry(crle, crl->heap);
+    doFree = (--crle->refCount == 0);
+    wc_UnLockMutex(&crl->crlLock);
+
+    if (doFree) {
+        FreeCRL_Entry(crle, crl->heap);
+        XFREE(crle, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+    }
+}
+
+
+/* Verify the signature of a CRL loaded without its issuer CA. The caller holds
+ * a reference and is counted in verifying so the signed data stays valid.
+ * Loads and monitor swaps already verify every CRL whose CA is known then,
+ * so this only runs on a check for a CRL whose CA was loaded after it, once
+ * per entry. Returns the verified state, or ASN_CRL_NO_SIGNER_E if the CA is
+ * still missing */
+static int VerifyCRL_Entry(WOLFSSL_CRL* crl, CRL_Entry* crle)
+{
+    Signer*      ca = NULL;
+    SignatureCtx sigCtx;
+    int          ret;
+
+#ifndef NO_SKID
+    if (crle->extAuthKeyIdSet)
+        ca = GetCA(crl->cm, crle->extAuthKeyId);
+    if (ca == NULL)
+        ca = GetCAByName(crl->cm, crle->issuerHash);
+#else /* NO_SKID */
+    ca = GetCA(crl->cm, crle->issuerHash);
+#endif /* NO_SKID */
+    if (ca == NULL) {
+        WOLFSSL_MSG("Did NOT find CRL issuer CA");
+        ret = ASN_CRL_NO_SIGNER_E;
+    }
+    else {
+        ret = VerifyCRL_Signature(&sigCtx, crle->toBeSigned, crle->tbsSz,
+                                  crle->signature, crle->signatureSz,
+                                  crle->signatureOID, ca, crl->heap);
+    }
+
+    if (wc_LockMutex(&crl->crlLock) != 0) {
+        WOLFSSL_MSG("wc_LockMutex failed");
+        return BAD_MUTEX_E; /* still verifying, ReleaseCRL_Entry drops it */
+    }
+
+    if (ret != ASN_CRL_NO_SIGNER_E && crle->verified == 0)
+        crle->verified = (ret == 0) ? 1 : ret;
+
+    DoneVerifyCRL_Entry(crle, crl->heap);
+    if (ret != ASN_CRL_NO_SIGNER_E)
+        ret = crle->verified;
+
+    wc_UnLockMutex(&crl->crlLock);
+
+    return ret;
+}
+
+
+/* Readers only hold crlLock to find and pin the issuer's entry. Loaded
+ * entries are immutable so the date and serial checks run unlocked and a
+ * monitor reload swapping the list never waits on them */
 static int CheckCertCRLList(WOLFSSL_CRL* crl, DecodedCert* cert, int *pFoundEntry)
 {
     CRL_Entry* crle;
     int        foundEntry = 0;
+    int        verified = 0;
     int        ret = 0;
 
+    *pFoundEntry = 0;
+
     if (wc_LockMutex(&crl->crlLock) != 0) {
         WOLFSSL_MSG("wc_LockMutex failed");
         return BAD_MUTEX_E;
     }
 
-    crle = crl->crlList;
-
+    crle = crl->crlTable[HashCRL(cert->issuerHash)];
     while (crle) {
-        if (XMEMCMP(crle->issuerHash, cert->issuerHash, CRL_DIGEST_SIZE) == 0) {
-            WOLFSSL_MSG("Found CRL Entry on list");
-
-            if (crle->verified == 0) {
-                Signer* ca = NULL;
-            #ifndef NO_SKID
-                byte extAuthKeyId[KEYID_SIZE];
-            #endif
-                byte issuerHash[CRL_DIGEST_SIZE];
-                byte* tbs;
-                word32 tbsSz = crle->tbsSz;
-                byte* sig = NULL;
-                word32 sigSz = crle->signatureSz;
-                word32 sigOID = crle->signatureOID;
-                SignatureCtx sigCtx;
-
-                tbs = (byte*)XMALLOC(tbsSz, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
-                if (tbs == NULL) {
-                    wc_UnLockMutex(&crl->crlLock);
-                    return MEMORY_E;
-                }
-                sig = (byte*)XMALLOC(sigSz, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
-                if (sig == NULL) {
-                    XFREE(tbs, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
-                    wc_UnLockMutex(&crl->crlLock);
-                    return MEMORY_E;
-                }
-
-                XMEMCPY(tbs, crle->toBeSigned, tbsSz);
-                XMEMCPY(sig, crle->signature, sigSz);
-            #ifndef NO_SKID
-                XMEMCPY(extAuthKeyId, crle->extAuthKeyId,
-                                                          sizeof(extAuthKeyId));
-            #endif
-                XMEMCPY(issuerHash, crle->issuerHash, sizeof(issuerHash));
-
-                wc_UnLockMutex(&crl->crlLock);
-
-            #ifndef NO_SKID
-                if (crle->extAuthKeyIdSet)
-                    ca = GetCA(crl->cm, extAuthKeyId);
-                if (ca == NULL)
-                    ca = GetCAByName(crl->cm, issuerHash);
-            #else /* NO_SKID */
-                ca = GetCA(crl->cm, issuerHash);
-            #endif /* NO_SKID */
-                if (ca == NULL) {
-                    XFREE(sig, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
-                    XFREE(tbs, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
-                    WOLFSSL_MSG("Did NOT find CRL issuer CA");
-                    return ASN_CRL_NO_SIGNER_E;
-                }
+        if (XMEMCMP(crle->issuerHash, cert->issuerHash, CRL_DIGEST_SIZE) == 0)
+            break;
+        crle = crle->tableNext;
+    }
+    if (crle != NULL) {
+        crle->refCount++;
+        verified = crle->verified;
+        if (verified == 0)
+            crle->verifying++;
+    }
 
-                ret = VerifyCRL_Signature(&sigCtx, tbs, tbsSz, sig, sigSz,
-                                          sigOID, ca, crl->heap);
+    wc_UnLockMutex(&crl->crlLock);
 
-                XFREE(sig, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
-                XFREE(tbs, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+    if (crle == NULL)
+        return 0;
 
-                if (wc_LockMutex(&crl->crlLock) != 0) {
-                    WOLFSSL_MSG("wc_LockMutex failed");
-                    return BAD_MUTEX_E;
-                }
+    WOLFSSL_MSG("Found CRL Entry on list");
 
-                crle = crl->crlList;
-                while (crle) {
-                    if (XMEMCMP(crle->issuerHash, cert->issuerHash,
-                        CRL_DIGEST_SIZE) == 0) {
-
-                        if (ret == 0)
-                            crle->verified = 1;
-                        else
-                            crle->verified = ret;
-
-                        XFREE(crle->toBeSigned, crl->heap,
-                                                        DYNAMIC_TYPE_CRL_ENTRY);
-                        crle->toBeSigned = NULL;
-                        XFREE(crle->signature, crl->heap,
-                                                        DYNAMIC_TYPE_CRL_ENTRY);
-                        crle->signature = NULL;
-                        break;
-                    }
-                    crle = crle->next;
-                }
-                if (crle == NULL || crle->verified < 0)
-                    break;
-            }
-            else if (crle->verified < 0) {
-                WOLFSSL_MSG("Cannot use CRL as it didn't verify");
-                ret = crle->verified;
-                break;
-            }
+    if (verified == 0) {
+        verified = VerifyCRL_Entry(crl, crle);
+        if (verified == ASN_CRL_NO_SIGNER_E || verified == BAD_MUTEX_E) {
+            ReleaseCRL_Entry(crl, crle, verified == BAD_MUTEX_E);
+            return verified;
+        }
+    }
 
-            WOLFSSL_MSG("Checking next date validity");
+    if (verified < 0) {
+        WOLFSSL_MSG("Cannot use CRL as it didn't verify");
+        ret = verified;
+    }
+    else {
+        WOLFSSL_MSG("Checking next date validity");
 
-        #ifdef WOLFSSL_NO_CRL_NEXT_DATE
-            if (crle->nextDateFormat != ASN_OTHER_TYPE)
-        #endif
-            {
-            #ifndef NO_ASN_TIME
-                if (!XVALIDATE_DATE(crle->nextDate,crle->nextDateFormat, AFTER)) {
-                    WOLFSSL_MSG("CRL next date is no longer valid");
-                    ret = ASN_AFTER_DATE_E;
-                }
-            #endif
-            }
-            if (ret == 0) {
-                foundEntry = 1;
+    #ifdef WOLFSSL_NO_CRL_NEXT_DATE
+        if (crle->nextDateFormat != ASN_OTHER_TYPE)
+    #endif
+        {
+        #ifndef NO_ASN_TIME
+            if (!XVALIDATE_DATE(crle->nextDate,crle->nextDateFormat, AFTER)) {
+                WOLFSSL_MSG("CRL next date is no longer valid");
+                ret = ASN_AFTER_DATE_E;
             }
-            break;
+        #endif
+        }
+        if (ret == 0) {
+            foundEntry = 1;
         }
-        crle = crle->next;
     }
 
     if (foundEntry) {
-        RevokedCert* rc = crle->certs;
-
-        while (rc) {
-            if (rc->serialSz == cert->serialSz &&
-                   XMEMCMP(rc->serialNumber, cert->serial, rc->serialSz) == 0) {
-                WOLFSSL_MSG("Cert revoked");
-                ret = CRL_CERT_REVOKED;
-                break;
-            }
-            rc = rc->next;
+        if (FindRevokedCert(crle, cert->serial, cert->serialSz)) {
+            WOLFSSL_MSG("Cert revoked");
+            ret = CRL_CERT_REVOKED;
         }
     }
 
-    wc_UnLockMutex(&crl->crlLock);
+    ReleaseCRL_Entry(crl, crle, 0);
 
     *pFoundEntry = foundEntry;
 
@@ -394,6 +542,7 @@ static int AddCRL(WOLFSSL_CRL* crl, DecodedCRL* dcrl, const byte* buff,
                   int verified)
 {
     CRL_Entry* crle;
+    word32     row;
 
     WOLFSSL_ENTER("AddCRL");
 
@@ -417,12 +566,36 @@ static int AddCRL(WOLFSSL_CRL* crl, DecodedCRL* dcrl, const byte* buff,
     }
     crle->next = crl->crlList;
     crl->crlList = crle;
+    row = HashCRL(crle->issuerHash);
+    crle->tableNext = crl->crlTable[row];
+    crl->crlTable[row] = crle;
     wc_UnLockMutex(&crl->crlLock);
 
     return 0;
 }
 
 
+#ifdef OPENSSL_EXTRA
+/* Rebuild the issuer table from crlList after the list was replaced, keeps
+ * list order within each row. Caller holds crlLock if the CRL is shared */
+static void IndexCRLTable(WOLFSSL_CRL* crl)
+{
+    CRL_Entry*  crle;
+    CRL_Entry** tail;
+
+    XMEMSET(crl->crlTable, 0, sizeof(crl->crlTable));
+
+    for (crle = crl->crlList; crle != NULL; crle = crle->next) {
+        tail = &crl->crlTable[HashCRL(crle->issuerHash)];
+        while (*tail != NULL)
+            tail = &(*tail)->tableNext;
+        crle->tableNext = NULL;
+        *tail = crle;
+    }
+}
+#endif /* OPENSSL_EXTRA */
+
+
 /* Load CRL File of type, WOLFSSL_SUCCESS on ok */
 int BufferLoadCRL(WOLFSSL_CRL* crl, const byte* buff, long sz, int type,
                   int verify)
@@ -562,9 +735,11 @@ static CRL_Entry* DupCRL_Entry(const CRL_Entry* ent, void* heap)
     dup->lastDateFormat = ent->lastDateFormat;
     dup->nextDateFormat = ent->nextDateFormat;
     dup->certs = DupRevokedCertList(ent->certs, heap);
+    IndexRevokedCerts(dup, heap);
 
     dup->totalCerts = ent->totalCerts;
     dup->verified = ent->verified;
+    dup->refCount = 1;
 
     if (!ent->verified) {
         dup->tbsSz = ent->tbsSz;
@@ -677,6 +852,7 @@ static int DupX509_CRL(WOLFSSL_X509_CRL *dup, const WOLFSSL_X509_CRL* crl)
     }
 
     dup->crlList = DupCRL_list(crl->crlList, dup->heap);
+    IndexCRLTable(dup);
 #ifdef HAVE_CRL_IO
     dup->crlIOCb = crl->crlIOCb;
 #endif
@@ -725,6 +901,7 @@ int wolfSSL_X509_STORE_add_crl(WOLFSSL_X509_STORE *store, WOLFSSL_X509_CRL *newc
             while (tail->next != NULL) tail = tail->next;
             tail->next = toAdd;
         }
+        IndexCRLTable(crl);
         wc_UnLockMutex(&crl->crlLock);
     }
 
@@ -764,7 +941,7 @@ static int SignalSetup(WOLFSSL_CRL* crl, int status)
 static int SwapLists(WOLFSSL_CRL* crl)
 {
     int        ret;
-    CRL_Entry* newList;
+    CRL_Entry* oldList;
 #ifdef WOLFSSL_SMALL_STACK
     WOLFSSL_CRL* tmp;
 #else
@@ -818,11 +995,23 @@ static int SwapLists(WOLFSSL_CRL* crl)
         return -1;
     }
 
-    newList = tmp->crlList;
+    oldList = crl->crlList;
 
-    /* swap lists */
-    tmp->crlList  = crl->crlList;
-    crl->crlList = newList;
+    /* publish the new list, loaded and verified without holding crlLock */
+    crl->crlList = tmp->crlList;
+    XMEMCPY(crl->crlTable, tmp->crlTable, sizeof(crl->crlTable));
+
+    /* drop the list reference on old entries, ones still pinned by a CRL check
+     * are freed by its ReleaseCRL_Entry, the rest go back to tmp to free */
+    tmp->crlList = NULL;
+    while (oldList) {
+        CRL_Entry* next = oldList->next;
+        if (--oldList->refCount == 0) {
+            oldList->next = tmp->crlList;
+            tmp->crlList = oldList;
+        }
+        oldList = next;
+    }
 
     wc_UnLockMutex(&crl->crlLock);
 
@@ -1037,7 +1226,7 @@ static void* DoMonitor(void* arg)
 
     if (crl->monitors[0].path) {
         wd = inotify_add_watch(notifyFd, crl->monitors[0].path, IN_CLOSE_WRITE |
-                                                                IN_DELETE);
+                                                   IN_MOVED_TO | IN_DELETE);
         if (wd < 0) {
             WOLFSSL_MSG("PEM notify add watch failed");
             close(crl->mfd);
@@ -1049,7 +1238,7 @@ static void* DoMonitor(void* arg)
 
     if (crl->monitors[1].path) {
         wd = inotify_add_watch(notifyFd, crl->monitors[1].path, IN_CLOSE_WRITE |
-                                                                IN_DELETE);
+                                                   IN_MOVED_TO | IN_DELETE);
         if (wd < 0) {
             WOLFSSL_MSG("DER notify add watch failed");
             close(crl->mfd);
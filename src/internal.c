@@ -1647,6 +1647,13 @@ int InitSSL_Ctx(WOLFSSL_CTX* ctx, WOLFSSL_METHOD* method, void* heap)
         ctx->err = CTX_INIT_MUTEX_E;
         return BAD_MUTEX_E;
     }
+#ifdef WOLFSSL_CTX_RSA_KEY
+    if (wc_InitMutex(&ctx->rsaKeyMutex) < 0) {
+        WOLFSSL_MSG("Mutex error on CTX RSA key init");
+        ctx->err = CTX_INIT_MUTEX_E;
+        return BAD_MUTEX_E;
+    }
+#endif
 
 #ifndef NO_DH
     ctx->minDhKeySz  = MIN_DHKEY_SZ;
@@ -1691,10 +1698,16 @@ int InitSSL_Ctx(WOLFSSL_CTX* ctx, WOLFSSL_METHOD* method, void* heap)
     #else
         ctx->CBIORecv = EmbedReceive;
         ctx->CBIOSend = EmbedSend;
+        #ifdef WOLFSSL_IO_SENDV
+        ctx->CBIOSendv = EmbedSendv;
+        #endif
         #ifdef WOLFSSL_DTLS
             if (method->version.major == DTLS_MAJOR) {
                 ctx->CBIORecv   = EmbedReceiveFrom;
                 ctx->CBIOSend   = EmbedSendTo;
+            #ifdef WOLFSSL_IO_SENDV
+                ctx->CBIOSendv  = NULL;
+            #endif
             }
             #ifdef WOLFSSL_SESSION_EXPORT
             ctx->CBGetPeer = EmbedGetPeer;
@@ -1753,6 +1766,9 @@ int InitSSL_Ctx(WOLFSSL_CTX* ctx, WOLFSSL_METHOD* method, void* heap)
     /* setup WOLFSSL_X509_STORE */
     ctx->x509_store.cm = ctx->cm;
     #endif
+    #ifdef WOLFSSL_PARALLEL_CA_LOAD
+    ctx->caLoadThreads = WOLFSSL_CA_LOAD_THREADS;
+    #endif
 #endif
 
 #if defined(HAVE_EXTENDED_MASTER) && !defined(NO_WOLFSSL_CLIENT)
@@ -1811,6 +1827,11 @@ void SSL_CtxResourceFree(WOLFSSL_CTX* ctx)
     XFREE(ctx->method, ctx->heap, DYNAMIC_TYPE_METHOD);
 #endif
     ctx->method = NULL;
+#if defined(HAVE_EXT_CACHE) && !defined(NO_SESSION_CACHE)
+    /* cached sessions outlive the ctx, stop evictions calling back into it */
+    if (ctx->rem_sess_cb != NULL)
+        RemoveSessionCacheOwner(ctx);
+#endif
     if (ctx->suites) {
         XFREE(ctx->suites, ctx->heap, DYNAMIC_TYPE_SUITES);
         ctx->suites = NULL;
@@ -1833,6 +1854,9 @@ void SSL_CtxResourceFree(WOLFSSL_CTX* ctx)
 
 #ifndef NO_CERTS
     FreeDer(&ctx->privateKey);
+#ifdef WOLFSSL_CTX_RSA_KEY
+    FreeCtxRsaKey(ctx);
+#endif
     FreeDer(&ctx->certificate);
     #ifdef KEEP_OUR_CERT
         if (ctx->ourCert && ctx->ownOurCert) {
@@ -1878,6 +1902,12 @@ void SSL_CtxResourceFree(WOLFSSL_CTX* ctx)
         XFREE(ctx->certOcspRequest, ctx->heap, DYNAMIC_TYPE_OCSP_REQUEST);
     }
 #endif
+#ifdef WOLFSSL_STAPLE_CACHE
+    if (ctx->staple) {
+        XFREE(ctx->staple, ctx->heap, DYNAMIC_TYPE_OCSP);
+        ctx->staple = NULL;
+    }
+#endif
 
 #ifdef HAVE_CERTIFICATE_STATUS_REQUEST_V2
     for (i = 0; i < MAX_CHAIN_DEPTH; i++) {
@@ -1932,6 +1962,9 @@ void FreeSSL_Ctx(WOLFSSL_CTX* ctx)
         WOLFSSL_MSG("CTX ref count down to 0, doing full free");
         SSL_CtxResourceFree(ctx);
         wc_FreeMutex(&ctx->countMutex);
+#ifdef WOLFSSL_CTX_RSA_KEY
+        wc_FreeMutex(&ctx->rsaKeyMutex);
+#endif
 #ifdef WOLFSSL_STATIC_MEMORY
         if (ctx->onHeap == 0) {
             heap = NULL;
@@ -5384,6 +5417,9 @@ int SetSSL_CTX(WOLFSSL* ssl, WOLFSSL_CTX* ctx, int writeDup)
 
     ssl->CBIORecv = ctx->CBIORecv;
     ssl->CBIOSend = ctx->CBIOSend;
+#ifdef WOLFSSL_IO_SENDV
+    ssl->CBIOSendv = ctx->CBIOSendv;
+#endif
 #ifdef OPENSSL_EXTRA
     ssl->readAhead = ctx->readAhead;
 #endif
@@ -5810,7 +5846,14 @@ int InitSSL(WOLFSSL* ssl, WOLFSSL_CTX* ctx, int writeDup)
         ssl->options.weOwnRng = 1;
 
         /* FIPS RNG API does not accept a heap hint */
-#ifndef HAVE_FIPS
+#if defined(WOLFSSL_THREAD_LOCAL_RNG)
+        /* seeded from this thread's parent DRBG, no OS entropy read */
+        if ( (ret = wc_InitRng_ThreadLocal(ssl->rng, ssl->heap,
+                                                         ssl->devId)) != 0) {
+            WOLFSSL_MSG("RNG Init error");
+            return ret;
+        }
+#elif !defined(HAVE_FIPS)
         if ( (ret = wc_InitRng_ex(ssl->rng, ssl->heap, ssl->devId)) != 0) {
             WOLFSSL_MSG("RNG Init error");
             return ret;
@@ -6048,13 +6091,15 @@ int AllocKey(WOLFSSL* ssl, int type, void** pKey)
     #endif /* HAVE_ECC */
     #ifdef HAVE_ED25519
         case DYNAMIC_TYPE_ED25519:
-            wc_ed25519_init((ed25519_key*)*pKey);
+            wc_ed25519_init_ex((ed25519_key*)*pKey, ssl->heap,
+                               ssl->devId);
             ret = 0;
             break;
     #endif /* HAVE_CURVE25519 */
     #ifdef HAVE_CURVE25519
         case DYNAMIC_TYPE_CURVE25519:
-            wc_curve25519_init((curve25519_key*)*pKey);
+            wc_curve25519_init_ex((curve25519_key*)*pKey, ssl->heap,
+                                  ssl->devId);
             ret = 0;
             break;
     #endif /* HAVE_CURVE25519 */
@@ -6111,13 +6156,14 @@ static int ReuseKey(WOLFSSL* ssl, int type, void* pKey)
     #ifdef HAVE_ED25519
         case DYNAMIC_TYPE_ED25519:
             wc_ed25519_free((ed25519_key*)pKey);
-            ret = wc_ed25519_init((ed25519_key*)pKey);
+            ret = wc_ed25519_init_ex((ed25519_key*)pKey, ssl->heap, ssl->devId);
             break;
     #endif /* HAVE_CURVE25519 */
     #ifdef HAVE_CURVE25519
         case DYNAMIC_TYPE_CURVE25519:
             wc_curve25519_free((curve25519_key*)pKey);
-            ret = wc_curve25519_init((curve25519_key*)pKey);
+            ret = wc_curve25519_init_ex((curve25519_key*)pKey, ssl->heap,
+                                        ssl->devId);
             break;
     #endif /* HAVE_CURVE25519 */
     #ifdef HAVE_ED448
@@ -8071,26 +8117,75 @@ void ShrinkInputBuffer(WOLFSSL* ssl, int forcedFree)
 {
     int usedLength = ssl->buffers.inputBuffer.length -
                      ssl->buffers.inputBuffer.idx;
-    if (!forcedFree && usedLength > STATIC_BUFFER_LEN)
+    byte*  toBuffer = ssl->buffers.inputBuffer.staticBuffer;
+    word32 toSize   = STATIC_BUFFER_LEN;
+
+#ifdef WOLFSSL_ZERO_COPY_READ
+    /* go back to the caller's record buffer rather than the static one */
+    if (ssl->buffers.userInput != NULL) {
+        toBuffer = ssl->buffers.userInput;
+        toSize   = ssl->buffers.userInputSz;
+    }
+#endif
+
+    if (!forcedFree && usedLength > (int)toSize)
         return;
 
     WOLFSSL_MSG("Shrinking input buffer\n");
 
     if (!forcedFree && usedLength > 0)
-        XMEMCPY(ssl->buffers.inputBuffer.staticBuffer,
+        XMEMCPY(toBuffer,
                ssl->buffers.inputBuffer.buffer + ssl->buffers.inputBuffer.idx,
                usedLength);
 
     XFREE(ssl->buffers.inputBuffer.buffer - ssl->buffers.inputBuffer.offset,
           ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
-    ssl->buffers.inputBuffer.buffer = ssl->buffers.inputBuffer.staticBuffer;
-    ssl->buffers.inputBuffer.bufferSize  = STATIC_BUFFER_LEN;
+    ssl->buffers.inputBuffer.buffer = toBuffer;
+    ssl->buffers.inputBuffer.bufferSize  = toSize;
     ssl->buffers.inputBuffer.dynamicFlag = 0;
     ssl->buffers.inputBuffer.offset      = 0;
     ssl->buffers.inputBuffer.idx = 0;
     ssl->buffers.inputBuffer.length = usedLength;
 }
 
+#ifdef WOLFSSL_IO_SENDV
+/* Send the pending output with one call to the vectored send callback.
+ * The output buffer holds whole TLS records from its start, so an iovec entry
+ * is made for each record, the first one trimmed to what is still unsent.
+ * Entries always cover the pending bytes in order, so a header that does not
+ * parse only costs the record boundaries, never data. */
+static int SendBufferedV(WOLFSSL* ssl)
+{
+    struct iovec iov[WOLFSSL_SENDV_MAX_IOV];
+    byte*  buf = ssl->buffers.outputBuffer.buffer;
+    word32 idx = ssl->buffers.outputBuffer.idx;
+    word32 end = idx + ssl->buffers.outputBuffer.length;
+    word32 pos = 0;
+    int    cnt = 0;
+
+    while (idx < end) {
+        word32 recEnd = end;
+        word16 recSz;
+
+        if (cnt < WOLFSSL_SENDV_MAX_IOV - 1 && pos + RECORD_HEADER_SZ <= end) {
+            ato16(buf + pos + 3, &recSz);
+            if (pos + RECORD_HEADER_SZ + recSz <= end)
+                recEnd = pos + RECORD_HEADER_SZ + recSz;
+        }
+        pos = recEnd;
+        if (recEnd <= idx)
+            continue;
+
+        iov[cnt].iov_base = (char*)buf + idx;
+        iov[cnt].iov_len  = recEnd - idx;
+        cnt++;
+        idx = recEnd;
+    }
+
+    return ssl->CBIOSendv(ssl, iov, cnt, ssl->IOCB_WriteCtx);
+}
+#endif
+
 int SendBuffered(WOLFSSL* ssl)
 {
     if (ssl->CBIOSend == NULL) {
@@ -8107,8 +8202,14 @@ int SendBuffered(WOLFSSL* ssl)
 #endif
 
     while (ssl->buffers.outputBuffer.length > 0) {
-        int sent = ssl->CBIOSend(ssl,
-                                      (char*)ssl->buffers.outputBuffer.buffer +
+        int sent;
+
+    #ifdef WOLFSSL_IO_SENDV
+        if (ssl->CBIOSendv != NULL && !ssl->options.dtls)
+            sent = SendBufferedV(ssl);
+        else
+    #endif
+        sent = ssl->CBIOSend(ssl, (char*)ssl->buffers.outputBuffer.buffer +
                                       ssl->buffers.outputBuffer.idx,
                                       (int)ssl->buffers.outputBuffer.length,
                                       ssl->IOCB_WriteCtx);
@@ -10443,6 +10544,94 @@ static int ProcessPeerCertParse(WOLFSSL* ssl, ProcPeerCertArgs* args,
     return ret;
 }
 
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+/* Can a chain CA cert be taken from the verified cert cache? Not when later
+   checks need the fully decoded cert. */
+static int ProcessPeerCertCacheOk(WOLFSSL* ssl)
+{
+    WOLFSSL_CERT_MANAGER* cm = ssl->ctx->cm;
+
+    if (ssl->options.verifyNone)
+        return 0;
+#ifdef HAVE_OCSP
+    if (cm->ocspEnabled && cm->ocspCheckAll)
+        return 0;
+    #ifdef HAVE_CERTIFICATE_STATUS_REQUEST_V2
+    if (ssl->status_request_v2)
+        return 0;
+    #endif
+#endif
+#ifdef HAVE_CRL
+    if (cm->crlEnabled && cm->crlCheckAll)
+        return 0;
+#endif
+#ifndef NO_WOLFSSL_CM_VERIFY
+    if (cm->verifyCallback != NULL)
+        return 0;
+#endif
+#ifdef WOLFSSL_VERIFY_CB_ALL_CERTS
+    if (ssl->verifyCallback != NULL)
+        return 0;
+    #ifdef OPENSSL_ALL
+    if (ssl->ctx->verifyCertCb != NULL)
+        return 0;
+    #endif
+#endif
+#ifdef OPENSSL_EXTRA
+    if (ssl->param != NULL &&
+            (ssl->param->hostName[0] != '\0' || ssl->param->ipasc[0] != '\0'))
+        return 0;
+#endif
+    (void)cm;
+
+    return 1;
+}
+
+/* Look up the current chain cert in the verified cert cache. On a hit the
+   decoded cert only has the fields used for chain CA processing set.
+   Returns 1 on a hit, otherwise 0 and the cert needs a full parse. */
+static int ProcessPeerCertCached(WOLFSSL* ssl, ProcPeerCertArgs* args,
+    byte** pSubjectHash, int* pAlreadySigner)
+{
+    buffer*      cert;
+    byte         derHash[WC_SHA256_DIGEST_SIZE];
+    VerifiedCert vc;
+
+    if (args->dCertInit || args->dCert == NULL ||
+            args->certIdx > args->count || ssl->ctx->cm->vcMax == 0 ||
+            !ProcessPeerCertCacheOk(ssl)) {
+        return 0;
+    }
+
+    cert = &args->certs[args->certIdx];
+    if (wc_Sha256Hash(cert->buffer, cert->length, derHash) != 0)
+        return 0;
+    if (GetVerifiedCert(ssl->ctx->cm, derHash, &vc) != 1)
+        return 0;
+
+    WOLFSSL_MSG("Chain cert found in verified cert cache");
+    InitDecodedCert(args->dCert, cert->buffer, cert->length, ssl->heap);
+    args->dCertInit = 1;
+    args->dCert->isCA            = 1;
+    args->dCert->keyOID          = vc.keyOID;
+    args->dCert->pubKeySize      = vc.pubKeySize;
+    args->dCert->extSubjKeyIdSet = vc.extSubjKeyIdSet;
+    args->dCert->extAuthKeyIdSet = vc.extAuthKeyIdSet;
+    XMEMCPY(args->dCert->subjectHash, vc.subjectHash, KEYID_SIZE);
+    XMEMCPY(args->dCert->extSubjKeyId, vc.extSubjKeyId, KEYID_SIZE);
+
+#ifndef NO_SKID
+    if (args->dCert->extAuthKeyIdSet)
+        *pSubjectHash = args->dCert->extSubjKeyId;
+    else
+#endif
+        *pSubjectHash = args->dCert->subjectHash;
+    *pAlreadySigner = AlreadySigner(ssl->ctx->cm, *pSubjectHash);
+
+    return 1;
+}
+#endif /* WOLFSSL_CERT_VERIFY_CACHE */
+
 /* Check key sizes for certs. Is redundant check since
    ProcessBuffer also performs this check. */
 static int ProcessPeerCertCheckKey(WOLFSSL* ssl, ProcPeerCertArgs* args)
@@ -10835,13 +11024,21 @@ int ProcessPeerCerts(WOLFSSL* ssl, byte* input, word32* inOutIdx,
                 #endif /* WOLFSSL_TRUST_PEER_CERT */
                 ) {
                     int skipAddCA = 0;
+                    int cacheHit = 0;
 
                     /* select last certificate */
                     args->certIdx = args->count - 1;
 
-                    ret = ProcessPeerCertParse(ssl, args, CERT_TYPE,
-                        !ssl->options.verifyNone ? VERIFY : NO_VERIFY,
-                        &subjectHash, &alreadySigner);
+                #ifdef WOLFSSL_CERT_VERIFY_CACHE
+                    cacheHit = ProcessPeerCertCached(ssl, args, &subjectHash,
+                                                     &alreadySigner);
+                #endif
+                    if (cacheHit)
+                        ret = 0;
+                    else
+                        ret = ProcessPeerCertParse(ssl, args, CERT_TYPE,
+                            !ssl->options.verifyNone ? VERIFY : NO_VERIFY,
+                            &subjectHash, &alreadySigner);
                 #ifdef WOLFSSL_ASYNC_CRYPT
                     if (ret == WC_PENDING_E)
                         goto exit_ppc;
@@ -10968,6 +11165,19 @@ int ProcessPeerCerts(WOLFSSL* ssl, byte* input, word32* inOutIdx,
                                 cert->buffer, cert->length);
                         }
                     #endif /* SESSION_CERTS && WOLFSSL_ALT_CERT_CHAINS */
+                    #ifdef WOLFSSL_CERT_VERIFY_CACHE
+                        if (!cacheHit && args->dCert->ca != NULL &&
+                                ssl->ctx->cm->vcMax != 0) {
+                            byte derHash[WC_SHA256_DIGEST_SIZE];
+
+                            if (wc_Sha256Hash(cert->buffer, cert->length,
+                                              derHash) == 0) {
+                                /* cache is best effort, ignore failures */
+                                (void)AddVerifiedCert(ssl->ctx->cm, derHash,
+                                                      args->dCert);
+                            }
+                        }
+                    #endif
                         if (!alreadySigner) {
                             DerBuffer* add = NULL;
                             ret = AllocDer(&add, cert->length, CA_TYPE, ssl->heap);
@@ -17248,6 +17458,63 @@ int SendCertificateRequest(WOLFSSL* ssl)
 #ifndef NO_WOLFSSL_SERVER
 #if defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
  || defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2)
+/* Protect and send the CertificateStatus message built in output. */
+static int SendCertificateStatusOutput(WOLFSSL* ssl, byte* output, word32 idx,
+                                                                     int sendSz)
+{
+    int ret = 0;
+
+    if (IsEncryptionOn(ssl, 1)) {
+        byte* input;
+        int   inputSz = idx; /* build msg adds rec hdr */
+        int   recordHeaderSz = RECORD_HEADER_SZ;
+
+        if (ssl->options.dtls)
+            recordHeaderSz += DTLS_RECORD_EXTRA;
+        inputSz -= recordHeaderSz;
+        input = (byte*)XMALLOC(inputSz, ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
+        if (input == NULL)
+            return MEMORY_E;
+
+        XMEMCPY(input, output + recordHeaderSz, inputSz);
+        #ifdef WOLFSSL_DTLS
+            ret = DtlsMsgPoolSave(ssl, input, inputSz, certificate_status);
+        #endif
+        if (ret == 0)
+            sendSz = BuildMessage(ssl, output, sendSz, input, inputSz,
+                                  handshake, 1, 0, 0, CUR_ORDER);
+        XFREE(input, ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
+
+        if (sendSz < 0)
+            ret = sendSz;
+    }
+    else {
+        #ifdef WOLFSSL_DTLS
+            if (ret == 0 && IsDtlsNotSctpMode(ssl))
+                ret = DtlsMsgPoolSave(ssl, output, sendSz, certificate_status);
+            if (ret == 0 && ssl->options.dtls)
+                DtlsSEQIncrement(ssl, CUR_ORDER);
+        #endif
+        ret = HashOutput(ssl, output, sendSz, 0);
+    }
+
+#if defined(WOLFSSL_CALLBACKS) || defined(OPENSSL_EXTRA)
+    if (ret == 0 && ssl->hsInfoOn)
+        AddPacketName(ssl, "CertificateStatus");
+    if (ret == 0 && ssl->toInfoOn)
+        AddPacketInfo(ssl, "CertificateStatus", handshake, output, sendSz,
+                WRITE_PROTO, ssl->heap);
+#endif
+
+    if (ret == 0) {
+        ssl->buffers.outputBuffer.length += sendSz;
+        if (!ssl->options.groupMessages)
+            ret = SendBuffered(ssl);
+    }
+
+    return ret;
+}
+
 static int BuildCertificateStatus(WOLFSSL* ssl, byte type, buffer* status,
                                                                      byte count)
 {
@@ -17300,58 +17567,217 @@ static int BuildCertificateStatus(WOLFSSL* ssl, byte type, buffer* status,
             idx += status[i].length;
         }
 
-        if (IsEncryptionOn(ssl, 1)) {
-            byte* input;
-            int   inputSz = idx; /* build msg adds rec hdr */
-            int   recordHeaderSz = RECORD_HEADER_SZ;
+        ret = SendCertificateStatusOutput(ssl, output, idx, sendSz);
+    }
 
-            if (ssl->options.dtls)
-                recordHeaderSz += DTLS_RECORD_EXTRA;
-            inputSz -= recordHeaderSz;
-            input = (byte*)XMALLOC(inputSz, ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
-            if (input == NULL)
-                return MEMORY_E;
+    WOLFSSL_LEAVE("BuildCertificateStatus", ret);
+    return ret;
+}
 
-            XMEMCPY(input, output + recordHeaderSz, inputSz);
-            #ifdef WOLFSSL_DTLS
-                ret = DtlsMsgPoolSave(ssl, input, inputSz, certificate_status);
-            #endif
-            if (ret == 0)
-                sendSz = BuildMessage(ssl, output, sendSz, input, inputSz,
-                                      handshake, 1, 0, 0, CUR_ORDER);
-            XFREE(input, ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
+#ifdef WOLFSSL_STAPLE_CACHE
+/* Drop a reference to a staple. Caller holds the stapling OCSP lock. */
+static void UnrefStapleCache(WOLFSSL_CTX* ctx, StapleCache* staple)
+{
+    if (staple != NULL && --staple->refCount == 0)
+        XFREE(staple, ctx->heap, DYNAMIC_TYPE_OCSP);
+    (void)ctx;
+}
 
-            if (sendSz < 0)
-                ret = sendSz;
-        }
+/* Fetch the status for the CTX certificate and encode it as a
+ * CertificateStatus body. *staple is left NULL when there is no status.
+ *
+ * Returns 0 on success
+ */
+static int BuildStapleCache(WOLFSSL* ssl, word32 generation,
+                                                          StapleCache** staple)
+{
+    WOLFSSL_CTX*  ctx     = ssl->ctx;
+    OcspRequest*  request = ctx->certOcspRequest;
+    StapleCache*  fresh   = NULL;
+    buffer        response;
+    word32        length;
+    int           ret;
+
+    *staple = NULL;
+
+    WOLFSSL_MSG("Building stapled OCSP response");
+
+    ret = CreateOcspResponse(ssl, &request, &response);
+    if (ret != 0)
+        return ret;
+
+    if (response.buffer) {
+        length = ENUM_LEN + OPAQUE24_LEN + response.length;
+        fresh = (StapleCache*)XMALLOC(sizeof(StapleCache) + length, ctx->heap,
+                                                             DYNAMIC_TYPE_OCSP);
+        if (fresh == NULL)
+            ret = MEMORY_E;
         else {
-            #ifdef WOLFSSL_DTLS
-                if (ret == 0 && IsDtlsNotSctpMode(ssl))
-                    ret = DtlsMsgPoolSave(ssl, output, sendSz, certificate_status);
-                if (ret == 0 && ssl->options.dtls)
-                    DtlsSEQIncrement(ssl, CUR_ORDER);
-            #endif
-            ret = HashOutput(ssl, output, sendSz, 0);
+            fresh->refCount   = 1;
+            fresh->generation = generation;
+            fresh->nextUpdate = OcspNextUpdate(ctx->cm->ocsp_stapling,
+                                                                      request);
+            fresh->length     = length;
+            fresh->msg[0]     = WOLFSSL_CSR2_OCSP;
+            c32to24(response.length, fresh->msg + ENUM_LEN);
+            XMEMCPY(fresh->msg + ENUM_LEN + OPAQUE24_LEN, response.buffer,
+                                                              response.length);
+            *staple = fresh;
         }
 
-    #if defined(WOLFSSL_CALLBACKS) || defined(OPENSSL_EXTRA)
-        if (ret == 0 && ssl->hsInfoOn)
-            AddPacketName(ssl, "CertificateStatus");
-        if (ret == 0 && ssl->toInfoOn)
-            AddPacketInfo(ssl, "CertificateStatus", handshake, output, sendSz,
-                    WRITE_PROTO, ssl->heap);
-    #endif
+        XFREE(response.buffer, ssl->heap, DYNAMIC_TYPE_OCSP_REQUEST);
+    }
 
-        if (ret == 0) {
-            ssl->buffers.outputBuffer.length += sendSz;
-            if (!ssl->options.groupMessages)
-                ret = SendBuffered(ssl);
+    /* if a request was successfully created and not stored in ssl->ctx then
+     * free it */
+    if (request != ctx->certOcspRequest) {
+        FreeOcspRequest(request);
+        XFREE(request, ssl->heap, DYNAMIC_TYPE_OCSP_REQUEST);
+    }
+
+    return ret;
+}
+
+/* A staple can be reused until its nextUpdate, 0 when the response has none.
+ * Without ASN time there is no clock to check it against, so it is never
+ * reused. Caller holds the stapling OCSP lock. */
+static int StapleCacheFresh(StapleCache* staple, word32 generation)
+{
+#ifndef NO_ASN_TIME
+    return staple != NULL && staple->generation == generation &&
+           (staple->nextUpdate == 0 || staple->nextUpdate > (long)XTIME(0));
+#else
+    (void)staple;
+    (void)generation;
+    return 0;
+#endif
+}
+
+/* Get a reference to the encoded CertificateStatus for the CTX certificate,
+ * building it when missing, replaced in the OCSP cache or past its
+ * nextUpdate. *staple is left NULL when there is no status to send.
+ *
+ * Returns 0 on success
+ */
+static int GetStapleCache(WOLFSSL* ssl, StapleCache** staple)
+{
+    WOLFSSL_CTX*  ctx   = ssl->ctx;
+    WOLFSSL_OCSP* ocsp  = ctx->cm->ocsp_stapling;
+    StapleCache*  fresh = NULL;
+    word32        generation;
+    int           attempt;
+    int           shared;
+    int           ret   = 0;
+
+    *staple = NULL;
+
+    for (attempt = 0; attempt < 2; attempt++) {
+        if (wc_LockMutex(&ocsp->ocspLock) != 0)
+            return BAD_MUTEX_E;
+
+        generation = ocsp->generation;
+        if (StapleCacheFresh(ctx->staple, generation)) {
+            ctx->staple->refCount++;
+            *staple = ctx->staple;
+        }
+
+        wc_UnLockMutex(&ocsp->ocspLock);
+
+        if (*staple != NULL)
+            return 0;
+
+        ret = BuildStapleCache(ssl, generation, &fresh);
+        if (ret != 0 || fresh == NULL)
+            return ret;
+
+        if (wc_LockMutex(&ocsp->ocspLock) != 0) {
+            XFREE(fresh, ctx->heap, DYNAMIC_TYPE_OCSP);
+            return BAD_MUTEX_E;
+        }
+
+        /* Fetching a missing status stores it, so the cache may have moved
+         * on while building. Share the staple only if it is current. */
+        shared = (ocsp->generation == generation);
+        if (shared) {
+            UnrefStapleCache(ctx, ctx->staple);
+            fresh->refCount++;
+            ctx->staple = fresh;
         }
+
+        wc_UnLockMutex(&ocsp->ocspLock);
+
+        /* when the cache keeps changing use it for this handshake only */
+        if (shared || attempt > 0) {
+            *staple = fresh;
+            break;
+        }
+
+        XFREE(fresh, ctx->heap, DYNAMIC_TYPE_OCSP);
+        fresh = NULL;
     }
 
-    WOLFSSL_LEAVE("BuildCertificateStatus", ret);
     return ret;
 }
+
+static void ReleaseStapleCache(WOLFSSL* ssl, StapleCache* staple)
+{
+    wolfSSL_Mutex* ocspLock = &ssl->ctx->cm->ocsp_stapling->ocspLock;
+
+    if (wc_LockMutex(ocspLock) == 0) {
+        UnrefStapleCache(ssl->ctx, staple);
+        wc_UnLockMutex(ocspLock);
+    }
+}
+
+/* Send the shared CertificateStatus body, framed for this connection.
+ * The body is copied into the output buffer rather than referenced: it is
+ * hashed into the transcript and, with groupMessages or DTLS, sent or
+ * retransmitted after the staple reference is dropped. The copy costs one
+ * memcpy of the OCSP response per handshake, the lookup and encoding of the
+ * response are what the cache saves. */
+static int SendStapleCache(WOLFSSL* ssl, StapleCache* staple)
+{
+    byte*  output = NULL;
+    word32 idx    = RECORD_HEADER_SZ + HANDSHAKE_HEADER_SZ;
+    int    sendSz = idx + staple->length;
+    int    ret;
+
+    WOLFSSL_ENTER("SendStapleCache");
+
+    if (ssl->keys.encryptionOn)
+        sendSz += MAX_MSG_EXTRA;
+
+    if ((ret = CheckAvailableSize(ssl, sendSz)) == 0) {
+        output = ssl->buffers.outputBuffer.buffer +
+                 ssl->buffers.outputBuffer.length;
+
+        AddHeaders(output, staple->length, certificate_status, ssl);
+        XMEMCPY(output + idx, staple->msg, staple->length);
+        idx += staple->length;
+
+        ret = SendCertificateStatusOutput(ssl, output, idx, sendSz);
+    }
+
+    WOLFSSL_LEAVE("SendStapleCache", ret);
+    return ret;
+}
+
+/* Only a status for the CTX certificate, fetched without a per connection
+ * callback, can be shared between connections. */
+static int UseStapleCache(WOLFSSL* ssl)
+{
+    if (ssl->buffers.weOwnCert || ssl->ctx->cm == NULL ||
+                                      ssl->ctx->cm->ocspStaplingEnabled == 0 ||
+                                      ssl->ctx->cm->ocsp_stapling == NULL)
+        return 0;
+#if defined(OPENSSL_ALL) || defined(OPENSSL_EXTRA) || \
+    defined(WOLFSSL_NGINX) || defined(WOLFSSL_HAPROXY)
+    if (ssl->ctx->cm->ocsp_stapling->statusCb != NULL)
+        return 0;
+#endif
+    return 1;
+}
+#endif /* WOLFSSL_STAPLE_CACHE */
 #endif
 #endif /* NO_WOLFSSL_SERVER */
 
@@ -17385,6 +17811,19 @@ int SendCertificateStatus(WOLFSSL* ssl)
             OcspRequest* request = ssl->ctx->certOcspRequest;
             buffer response;
 
+        #ifdef WOLFSSL_STAPLE_CACHE
+            if (UseStapleCache(ssl)) {
+                StapleCache* staple;
+
+                ret = GetStapleCache(ssl, &staple);
+                if (ret == 0 && staple != NULL) {
+                    ret = SendStapleCache(ssl, staple);
+                    ReleaseStapleCache(ssl, staple);
+                }
+                break;
+            }
+        #endif
+
             ret = CreateOcspResponse(ssl, &request, &response);
 
             /* if a request was successfully created and not stored in
@@ -17605,13 +18044,53 @@ static WC_INLINE int IsSCR(WOLFSSL* ssl)
 }
 
 
-int SendData(WOLFSSL* ssl, const void* data, int sz)
+#ifdef WOLFSSL_IO_SENDV
+/* Plaintext held in the caller's iovec list */
+typedef struct SendDataIov {
+    const struct iovec* iov;
+    int   iovcnt;
+    byte* gather;    /* record sized, for records that span entries */
+} SendDataIov;
+
+/* Get len bytes of plaintext at offset. Points into the caller's entry when
+ * the record fits in one, otherwise gathers the pieces. */
+static byte* SendDataGather(SendDataIov* vec, int offset, int len)
+{
+    int i = 0;
+    int copied = 0;
+
+    while (i < vec->iovcnt && offset >= (int)vec->iov[i].iov_len) {
+        offset -= (int)vec->iov[i].iov_len;
+        i++;
+    }
+    if (i < vec->iovcnt && (int)vec->iov[i].iov_len - offset >= len)
+        return (byte*)vec->iov[i].iov_base + offset;
+
+    for (; i < vec->iovcnt && copied < len; i++) {
+        int part = min((int)vec->iov[i].iov_len - offset, len - copied);
+        XMEMCPY(vec->gather + copied, (byte*)vec->iov[i].iov_base + offset,
+                part);
+        copied += part;
+        offset = 0;
+    }
+
+    return vec->gather;
+}
+#endif
+
+/* data is the plaintext, or a SendDataIov when vec is set */
+static int SendDataEx(WOLFSSL* ssl, const void* data, int sz, int vec)
 {
     int sent = 0,  /* plainText size */
         sendSz,
         ret,
         dtlsExtra = 0;
     int groupMsgs = 0;
+    int pending = 0;  /* plainText built into records not yet sent */
+#ifdef WOLFSSL_IO_SENDV
+    int batch = 0;
+    int batched = 0;
+#endif
 
     if (ssl->error == WANT_WRITE
     #ifdef WOLFSSL_ASYNC_CRYPT
@@ -17691,6 +18170,16 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
     }
 #endif
 
+#ifdef WOLFSSL_IO_SENDV
+    /* build several records and send them together */
+    batch = ssl->CBIOSendv != NULL && !ssl->options.dtls && !groupMsgs &&
+            ssl->options.partialWrite == 0;
+    #ifdef WOLFSSL_ASYNC_CRYPT
+    batch = 0; /* a pending record must stay the last one in the buffer */
+    #endif
+#endif
+    (void)vec;
+
     for (;;) {
         int   len;
         byte* out;
@@ -17714,9 +18203,22 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
 
         /* check for available size */
         outputSz = len + COMP_EXTRA + dtlsExtra + MAX_MSG_EXTRA;
+#ifdef WOLFSSL_IO_SENDV
+        if (batch && batched == 0) {
+            /* size the buffer for the whole batch up front */
+            int recs = min((sz - sent + len - 1) / len, WOLFSSL_SENDV_RECORDS);
+            if ((ret = CheckAvailableSize(ssl, outputSz * recs)) != 0)
+                return ssl->error = ret;
+        }
+#endif
         if ((ret = CheckAvailableSize(ssl, outputSz)) != 0)
             return ssl->error = ret;
 
+#ifdef WOLFSSL_IO_SENDV
+        if (vec)
+            sendBuffer = SendDataGather((SendDataIov*)data, sent, len);
+#endif
+
         /* get output buffer */
         out = ssl->buffers.outputBuffer.buffer +
               ssl->buffers.outputBuffer.length;
@@ -17752,12 +18254,24 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
 
         ssl->buffers.outputBuffer.length += sendSz;
 
+#ifdef WOLFSSL_IO_SENDV
+        if (batch && ++batched < WOLFSSL_SENDV_RECORDS && sent + len < sz) {
+            sent    += len;
+            pending += len;
+            /* account for the built records should a later one fail */
+            ssl->buffers.plainSz  = pending;
+            ssl->buffers.prevSent = sent - pending;
+            continue;
+        }
+        batched = 0;
+#endif
+
         if ( (ssl->error = SendBuffered(ssl)) < 0) {
             WOLFSSL_ERROR(ssl->error);
             /* store for next call if WANT_WRITE or user embedSend() that
                doesn't present like WANT_WRITE */
-            ssl->buffers.plainSz  = len;
-            ssl->buffers.prevSent = sent;
+            ssl->buffers.plainSz  = pending + len;
+            ssl->buffers.prevSent = sent - pending;
             if (ssl->error == SOCKET_ERROR_E && (ssl->options.connReset ||
                                                  ssl->options.isClosed)) {
                 ssl->error = SOCKET_PEER_CLOSED_E;
@@ -17768,6 +18282,7 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
         }
 
         sent += len;
+        pending = 0;
 
         /* only one message per attempt */
         if (ssl->options.partialWrite == 1) {
@@ -17779,13 +18294,43 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
     return sent;
 }
 
-/* process input data */
-int ReceiveData(WOLFSSL* ssl, byte* output, int sz, int peek)
+int SendData(WOLFSSL* ssl, const void* data, int sz)
 {
-    int size;
+    return SendDataEx(ssl, data, sz, 0);
+}
 
-    WOLFSSL_ENTER("ReceiveData()");
+#ifdef WOLFSSL_IO_SENDV
+/* Send sz bytes from the iovec list, records are built straight from the
+ * entries and only those spanning two entries are gathered */
+int SendDataV(WOLFSSL* ssl, const struct iovec* iov, int iovcnt, int sz)
+{
+    SendDataIov vec;
+    int ret;
+
+    vec.iov    = iov;
+    vec.iovcnt = iovcnt;
+    vec.gather = NULL;
+
+    if (iovcnt > 1 && sz > 0) {
+        vec.gather = (byte*)XMALLOC(min(sz, MAX_RECORD_SIZE), ssl->heap,
+                                                           DYNAMIC_TYPE_WRITEV);
+        if (vec.gather == NULL)
+            return MEMORY_E;
+    }
 
+    ret = SendDataEx(ssl, &vec, sz, 1);
+
+    if (vec.gather != NULL)
+        XFREE(vec.gather, ssl->heap, DYNAMIC_TYPE_WRITEV);
+
+    return ret;
+}
+#endif
+
+/* Process input until decrypted application data is ready.
+ * returns the plaintext size ready, 0 when no more data is coming, or error */
+static int ReceiveDataReady(WOLFSSL* ssl)
+{
     /* reset error state */
     if (ssl->error == WANT_READ) {
         ssl->error = 0;
@@ -17864,17 +18409,34 @@ startScr:
         #endif
     }
 
-    if (sz < (int)ssl->buffers.clearOutputBuffer.length)
+    return (int)ssl->buffers.clearOutputBuffer.length;
+}
+
+/* drop size bytes of plaintext the application has taken */
+static void ReceiveDataConsume(WOLFSSL* ssl, int size)
+{
+    ssl->buffers.clearOutputBuffer.length -= size;
+    ssl->buffers.clearOutputBuffer.buffer += size;
+}
+
+/* process input data */
+int ReceiveData(WOLFSSL* ssl, byte* output, int sz, int peek)
+{
+    int size;
+
+    WOLFSSL_ENTER("ReceiveData()");
+
+    size = ReceiveDataReady(ssl);
+    if (size <= 0)
+        return size;
+
+    if (sz < size)
         size = sz;
-    else
-        size = ssl->buffers.clearOutputBuffer.length;
 
     XMEMCPY(output, ssl->buffers.clearOutputBuffer.buffer, size);
 
-    if (peek == 0) {
-        ssl->buffers.clearOutputBuffer.length -= size;
-        ssl->buffers.clearOutputBuffer.buffer += size;
-    }
+    if (peek == 0)
+        ReceiveDataConsume(ssl, size);
 
     if (ssl->buffers.clearOutputBuffer.length == 0 &&
                                            ssl->buffers.inputBuffer.dynamicFlag)
@@ -17884,6 +18446,40 @@ startScr:
     return size;
 }
 
+#ifdef WOLFSSL_ZERO_COPY_READ
+/* Point data at the decrypted plaintext left in the input buffer instead of
+ * copying it out. The data stays put until ReceiveDataRelease consumes it.
+ * returns the plaintext size, 0 when no more data is coming, or error */
+int ReceiveDataBorrow(WOLFSSL* ssl, const byte** data)
+{
+    int size;
+
+    WOLFSSL_ENTER("ReceiveDataBorrow()");
+
+    size = ReceiveDataReady(ssl);
+    if (size > 0)
+        *data = ssl->buffers.clearOutputBuffer.buffer;
+
+    WOLFSSL_LEAVE("ReceiveDataBorrow()", size);
+    return size;
+}
+
+/* Consume sz bytes of borrowed plaintext, returns 0 or BAD_FUNC_ARG */
+int ReceiveDataRelease(WOLFSSL* ssl, int sz)
+{
+    if (sz < 0 || sz > (int)ssl->buffers.clearOutputBuffer.length)
+        return BAD_FUNC_ARG;
+
+    ReceiveDataConsume(ssl, sz);
+
+    if (ssl->buffers.clearOutputBuffer.length == 0 &&
+                                           ssl->buffers.inputBuffer.dynamicFlag)
+       ShrinkInputBuffer(ssl, NO_FORCED_FREE);
+
+    return 0;
+}
+#endif /* WOLFSSL_ZERO_COPY_READ */
+
 
 /* send alert message */
 int SendAlert(WOLFSSL* ssl, int severity, int type)
@@ -19722,6 +20318,62 @@ int PickHashSigAlgo(WOLFSSL* ssl, const byte* hashSigAlgo, word32 hashSigAlgoSz)
 
 #if !defined(NO_CERTS)
 
+#ifdef WOLFSSL_CTX_RSA_KEY
+/* Free the decoded CTX RSA private key, called when the private key changes */
+void FreeCtxRsaKey(WOLFSSL_CTX* ctx)
+{
+    if (ctx->rsaKey != NULL) {
+        wc_FreeRsaKey(ctx->rsaKey);
+        XFREE(ctx->rsaKey, ctx->heap, DYNAMIC_TYPE_RSA);
+        ctx->rsaKey = NULL;
+    }
+}
+
+/* Copy the CTX RSA private key into the handshake key. The CTX key is decoded
+ * and precomputed by the first handshake that needs it, later handshakes skip
+ * the decode and the per key setup of the private operation.
+ */
+static int CopyCtxRsaKey(WOLFSSL* ssl, RsaKey* key)
+{
+    WOLFSSL_CTX* ctx = ssl->ctx;
+    word32       idx = 0;
+    int          ret = 0;
+
+    if (wc_LockMutex(&ctx->rsaKeyMutex) != 0) {
+        WOLFSSL_MSG("Couldn't lock CTX RSA key mutex");
+        return BAD_MUTEX_E;
+    }
+
+    if (ctx->rsaKey == NULL) {
+        RsaKey* rsaKey = (RsaKey*)XMALLOC(sizeof(RsaKey), ctx->heap,
+                                          DYNAMIC_TYPE_RSA);
+        if (rsaKey == NULL)
+            ret = MEMORY_E;
+        else
+            ret = wc_InitRsaKey_ex(rsaKey, ctx->heap, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_RsaPrivateKeyDecode(ctx->privateKey->buffer, &idx, rsaKey,
+                                         ctx->privateKey->length);
+            if (ret == 0)
+                ret = wc_RsaPrecompute(rsaKey, ssl->rng);
+            if (ret == 0)
+                ctx->rsaKey = rsaKey;
+            else
+                wc_FreeRsaKey(rsaKey);
+        }
+        if (ret != 0 && rsaKey != NULL)
+            XFREE(rsaKey, ctx->heap, DYNAMIC_TYPE_RSA);
+    }
+
+    if (ret == 0)
+        ret = wc_RsaPrecomputeCopy(ctx->rsaKey, key, ssl->rng);
+
+    wc_UnLockMutex(&ctx->rsaKeyMutex);
+
+    return ret;
+}
+#endif /* WOLFSSL_CTX_RSA_KEY */
+
 /* Decode the private key - RSA/ECC/Ed25519/Ed448 - and creates a key object.
  * The signature type is set as well.
  * The maximum length of a signature is returned.
@@ -19812,11 +20464,21 @@ int DecodePrivateKey(WOLFSSL *ssl, word16* length)
 
         WOLFSSL_MSG("Trying RSA private key");
 
-        /* Set start of data to beginning of buffer. */
-        idx = 0;
-        /* Decode the key assuming it is an RSA private key. */
-        ret = wc_RsaPrivateKeyDecode(ssl->buffers.key->buffer, &idx,
-                    (RsaKey*)ssl->hsKey, ssl->buffers.key->length);
+    #ifdef WOLFSSL_CTX_RSA_KEY
+        if (ssl->buffers.keyType == rsa_sa_algo &&
+                                   ssl->buffers.key == ssl->ctx->privateKey) {
+            /* copy of the decoded and precomputed CTX key */
+            ret = CopyCtxRsaKey(ssl, (RsaKey*)ssl->hsKey);
+        }
+        else
+    #endif
+        {
+            /* Set start of data to beginning of buffer. */
+            idx = 0;
+            /* Decode the key assuming it is an RSA private key. */
+            ret = wc_RsaPrivateKeyDecode(ssl->buffers.key->buffer, &idx,
+                        (RsaKey*)ssl->hsKey, ssl->buffers.key->length);
+        }
         if (ret == 0) {
             WOLFSSL_MSG("Using RSA private key");
 
@@ -2292,6 +2292,10 @@ static int SetKeys(Ciphers* enc, Ciphers* dec, Keys* keys, CipherSpecs* specs,
                     (ChaCha*)XMALLOC(sizeof(ChaCha), heap, DYNAMIC_TYPE_CIPHER);
         if (dec && dec->chacha == NULL)
             return MEMORY_E;
+        if (enc && wc_Chacha_Init(enc->chacha, heap, devId) != 0)
+            return BAD_FUNC_ARG;
+        if (dec && wc_Chacha_Init(dec->chacha, heap, devId) != 0)
+            return BAD_FUNC_ARG;
         if (side == WOLFSSL_CLIENT_END) {
             if (enc) {
                 chachaRet = wc_Chacha_SetKey(enc->chacha, keys->client_write_key,
@@ -51,6 +51,13 @@ int InitOCSP(WOLFSSL_OCSP* ocsp, WOLFSSL_CERT_MANAGER* cm)
 
     if (wc_InitMutex(&ocsp->ocspLock) != 0)
         return BAD_MUTEX_E;
+#ifdef HAVE_OCSP_REFRESH
+    if (pthread_cond_init(&ocsp->cond, 0) != 0) {
+        WOLFSSL_MSG("Pthread condition init failed");
+        wc_FreeMutex(&ocsp->ocspLock);
+        return BAD_COND_E;
+    }
+#endif
 
     ocsp->cm = cm;
 
@@ -58,6 +65,34 @@ int InitOCSP(WOLFSSL_OCSP* ocsp, WOLFSSL_CERT_MANAGER* cm)
 }
 
 
+/* Row of the entry table for an issuer name hash. */
+static WC_INLINE word32 HashOcspEntry(const byte* issuerHash)
+{
+    word32 hash = 0;
+
+    hash = ((word32)issuerHash[0] << 24) | ((word32)issuerHash[1] << 16) |
+           ((word32)issuerHash[2] <<  8) |  (word32)issuerHash[3];
+
+    return hash % OCSP_TABLE_SIZE;
+}
+
+
+/* Row of the status table for an issuer name hash and serial number. */
+static WC_INLINE word32 HashOcspStatus(const byte* issuerHash,
+                                               const byte* serial, int serialSz)
+{
+    word32 hash = 2166136261U;  /* FNV-1a */
+    int    i;
+
+    for (i = 0; i < 4; i++)
+        hash = (hash ^ issuerHash[i]) * 16777619U;
+    for (i = 0; i < serialSz; i++)
+        hash = (hash ^ serial[i]) * 16777619U;
+
+    return hash % OCSP_STATUS_TABLE_SIZE;
+}
+
+
 static int InitOcspEntry(OcspEntry* entry, OcspRequest* request)
 {
     WOLFSSL_ENTER("InitOcspEntry");
@@ -82,6 +117,8 @@ static void FreeOcspEntry(OcspEntry* entry, void* heap)
 
         if (status->rawOcspResponse)
             XFREE(status->rawOcspResponse, heap, DYNAMIC_TYPE_OCSP_STATUS);
+        if (status->url)
+            XFREE(status->url, heap, DYNAMIC_TYPE_OCSP_STATUS);
 
         XFREE(status, heap, DYNAMIC_TYPE_OCSP_STATUS);
     }
@@ -96,12 +133,19 @@ void FreeOCSP(WOLFSSL_OCSP* ocsp, int dynamic)
 
     WOLFSSL_ENTER("FreeOCSP");
 
+#ifdef HAVE_OCSP_REFRESH
+    StopOCSPRefresh(ocsp);
+#endif
+
     for (entry = ocsp->ocspList; entry; entry = next) {
         next = entry->next;
         FreeOcspEntry(entry, ocsp->cm->heap);
         XFREE(entry, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_ENTRY);
     }
 
+#ifdef HAVE_OCSP_REFRESH
+    pthread_cond_destroy(&ocsp->cond);
+#endif
     wc_FreeMutex(&ocsp->ocspLock);
 
     if (dynamic)
@@ -167,6 +211,8 @@ int CheckCertOCSP(WOLFSSL_OCSP* ocsp, DecodedCert* cert, buffer* responseBuffer)
 static int GetOcspEntry(WOLFSSL_OCSP* ocsp, OcspRequest* request,
                                                               OcspEntry** entry)
 {
+    word32 row;
+
     WOLFSSL_ENTER("GetOcspEntry");
 
     *entry = NULL;
@@ -176,7 +222,9 @@ static int GetOcspEntry(WOLFSSL_OCSP* ocsp, OcspRequest* request,
         return BAD_MUTEX_E;
     }
 
-    for (*entry = ocsp->ocspList; *entry; *entry = (*entry)->next)
+    row = HashOcspEntry(request->issuerHash);
+
+    for (*entry = ocsp->ocspTable[row]; *entry; *entry = (*entry)->tableNext)
         if (XMEMCMP((*entry)->issuerHash,    request->issuerHash,
                                                          OCSP_DIGEST_SIZE) == 0
         &&  XMEMCMP((*entry)->issuerKeyHash, request->issuerKeyHash,
@@ -190,6 +238,8 @@ static int GetOcspEntry(WOLFSSL_OCSP* ocsp, OcspRequest* request,
             InitOcspEntry(*entry, request);
             (*entry)->next = ocsp->ocspList;
             ocsp->ocspList = *entry;
+            (*entry)->tableNext = ocsp->ocspTable[row];
+            ocsp->ocspTable[row] = *entry;
         }
     }
 
@@ -206,19 +256,25 @@ static int GetOcspEntry(WOLFSSL_OCSP* ocsp, OcspRequest* request,
 static int GetOcspStatus(WOLFSSL_OCSP* ocsp, OcspRequest* request,
                   OcspEntry* entry, CertStatus** status, buffer* responseBuffer)
 {
-    int ret = OCSP_INVALID_STATUS;
+    int    ret = OCSP_INVALID_STATUS;
+    word32 row;
 
     WOLFSSL_ENTER("GetOcspStatus");
 
     *status = NULL;
 
+    row = HashOcspStatus(request->issuerHash, request->serial,
+                                                             request->serialSz);
+
     if (wc_LockMutex(&ocsp->ocspLock) != 0) {
         WOLFSSL_LEAVE("CheckCertOCSP", BAD_MUTEX_E);
         return BAD_MUTEX_E;
     }
 
-    for (*status = entry->status; *status; *status = (*status)->next)
-        if ((*status)->serialSz == request->serialSz
+    for (*status = ocsp->statusTable[row]; *status;
+                                             *status = (*status)->tableNext)
+        if ((*status)->entry == entry
+        &&  (*status)->serialSz == request->serialSz
         &&  !XMEMCMP((*status)->serial, request->serial, (*status)->serialSz))
             break;
 
@@ -251,11 +307,30 @@ static int GetOcspStatus(WOLFSSL_OCSP* ocsp, OcspRequest* request,
         }
     }
 
+    if (ret == OCSP_INVALID_STATUS)
+        ocsp->misses++;
+    else
+        ocsp->hits++;
+
     wc_UnLockMutex(&ocsp->ocspLock);
 
     return ret;
 }
 
+/* Is the entry one of ours, or was it passed in by the application. Caller
+ * holds ocspLock. */
+static int OcspEntryInTable(WOLFSSL_OCSP* ocsp, OcspEntry* entry)
+{
+    OcspEntry* cur;
+
+    for (cur = ocsp->ocspTable[HashOcspEntry(entry->issuerHash)]; cur;
+                                                         cur = cur->tableNext)
+        if (cur == entry)
+            return 1;
+
+    return 0;
+}
+
 /* Check that the response for validity. Store result in status.
  *
  * ocsp           Context object for OCSP status.
@@ -342,7 +417,11 @@ WOLFSSL_LOCAL int CheckOcspResponse(WOLFSSL_OCSP *ocsp, byte *response, int resp
         }
 
         /* Replace existing certificate entry with updated */
-        newStatus->next = status->next;
+        newStatus->next      = status->next;
+        newStatus->tableNext = status->tableNext;
+        newStatus->entry     = status->entry;
+        newStatus->url       = status->url;
+        newStatus->urlSz     = status->urlSz;
         XMEMCPY(status, newStatus, sizeof(CertStatus));
     }
     else {
@@ -354,9 +433,32 @@ WOLFSSL_LOCAL int CheckOcspResponse(WOLFSSL_OCSP *ocsp, byte *response, int resp
             status->next  = entry->status;
             entry->status = status;
             entry->totalStatus++;
+
+            if (OcspEntryInTable(ocsp, entry)) {
+                word32 row = HashOcspStatus(entry->issuerHash,
+                                            status->serial, status->serialSz);
+                status->entry = entry;
+                status->tableNext = ocsp->statusTable[row];
+                ocsp->statusTable[row] = status;
+            }
+        }
+    }
+
+    /* Remember the responder so the status can be refreshed later */
+    if (status && status->url == NULL && ocspRequest != NULL &&
+                            ocspRequest->url != NULL && ocspRequest->urlSz > 0) {
+        status->url = (byte*)XMALLOC(ocspRequest->urlSz + 1, ocsp->cm->heap,
+                                                      DYNAMIC_TYPE_OCSP_STATUS);
+        if (status->url) {
+            XMEMCPY(status->url, ocspRequest->url, ocspRequest->urlSz);
+            status->url[ocspRequest->urlSz] = '\0';
+            status->urlSz = ocspRequest->urlSz;
         }
     }
 
+    if (status)
+        ocsp->generation++;
+
     if (status && responseBuffer && responseBuffer->buffer) {
         status->rawOcspResponse = (byte*)XMALLOC(responseBuffer->length,
                                                  ocsp->cm->heap,
@@ -491,6 +593,392 @@ int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
     return ret;
 }
 
+#ifndef NO_ASN_TIME
+/* Seconds since the epoch of a UTC calendar time. */
+static long OcspTimeToEpoch(const struct tm* t)
+{
+    long year  = t->tm_year + 1900;
+    long month = t->tm_mon + 1;
+    long era, yoe, doy, doe;
+
+    /* days from civil, proleptic Gregorian */
+    year -= (month <= 2);
+    era = (year >= 0 ? year : year - 399) / 400;
+    yoe = year - era * 400;
+    doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + t->tm_mday - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return (era * 146097 + doe - 719468) * 86400L +
+           t->tm_hour * 3600L + t->tm_min * 60L + t->tm_sec;
+}
+
+
+/* Does the status's nextUpdate fall within margin seconds of now. Statuses
+ * without a nextUpdate are never refreshed. */
+static int OcspStatusExpiring(CertStatus* status, long now, long margin)
+{
+    struct tm next;
+
+    if (status->nextDate[0] == 0)
+        return 0;
+
+    if (wc_GetDateAsCalendarTime(status->nextDate, MAX_DATE_SIZE,
+                                       status->nextDateFormat, &next) != 0)
+        return 0;
+
+    return OcspTimeToEpoch(&next) - now <= margin;
+}
+
+
+/* Fill in request for an already cached status. Caller holds ocspLock. */
+static int OcspRefreshRequest(WOLFSSL_OCSP* ocsp, OcspEntry* entry,
+                                     CertStatus* status, OcspRequest* request)
+{
+    int ret;
+
+    ret = InitOcspRequest(request, NULL, ocsp->cm->ocspSendNonce,
+                                                                ocsp->cm->heap);
+    if (ret != 0)
+        return ret;
+
+    XMEMCPY(request->issuerHash,    entry->issuerHash,    OCSP_DIGEST_SIZE);
+    XMEMCPY(request->issuerKeyHash, entry->issuerKeyHash, OCSP_DIGEST_SIZE);
+
+    request->serial = (byte*)XMALLOC(status->serialSz, ocsp->cm->heap,
+                                                     DYNAMIC_TYPE_OCSP_REQUEST);
+    if (request->serial == NULL)
+        return MEMORY_E;
+    XMEMCPY(request->serial, status->serial, status->serialSz);
+    request->serialSz = status->serialSz;
+
+    if (status->url != NULL) {
+        request->url = (byte*)XMALLOC(status->urlSz + 1, ocsp->cm->heap,
+                                                     DYNAMIC_TYPE_OCSP_REQUEST);
+        if (request->url == NULL)
+            return MEMORY_E;
+        XMEMCPY(request->url, status->url, status->urlSz + 1);
+        request->urlSz = status->urlSz;
+    }
+
+    return 0;
+}
+
+
+/* Fetch a fresh response for a cached status and store it in place.
+ *
+ * Returns 0 when the status was updated.
+ */
+static int OcspRefreshStatus(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
+                      OcspEntry* entry, CertStatus* status, int keepResponse)
+{
+    byte*       request    = NULL;
+    int         requestSz  = 2048;
+    byte*       response   = NULL;
+    int         responseSz = 0;
+    const char* url        = NULL;
+    int         urlSz      = 0;
+    int         ret        = OCSP_LOOKUP_FAIL;
+    buffer      responseBuffer;
+
+    if (ocsp->cm->ocspIOCb == NULL)
+        return OCSP_LOOKUP_FAIL;
+
+    if (ocsp->cm->ocspUseOverrideURL) {
+        url = ocsp->cm->ocspOverrideURL;
+        if (url != NULL && url[0] != '\0')
+            urlSz = (int)XSTRLEN(url);
+    }
+    else if (ocspRequest->urlSz != 0 && ocspRequest->url != NULL) {
+        url = (const char *)ocspRequest->url;
+        urlSz = ocspRequest->urlSz;
+    }
+    if (urlSz == 0)
+        return OCSP_NEED_URL;
+
+    request = (byte*)XMALLOC(requestSz, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+    if (request == NULL)
+        return MEMORY_E;
+
+    requestSz = EncodeOcspRequest(ocspRequest, request, requestSz);
+    if (requestSz > 0) {
+        responseSz = ocsp->cm->ocspIOCb(ocsp->cm->ocspIOCtx, url, urlSz,
+                                        request, requestSz, &response);
+    }
+
+    XFREE(request, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+
+    if (responseSz > 0 && response) {
+        responseBuffer.buffer = NULL;
+        responseBuffer.length = 0;
+
+        ret = CheckOcspResponse(ocsp, response, responseSz,
+                  keepResponse ? &responseBuffer : NULL, status, entry,
+                  ocspRequest);
+
+        if (responseBuffer.buffer)
+            XFREE(responseBuffer.buffer, ocsp->cm->heap,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+        if (ret == OCSP_CERT_REVOKED)
+            ret = 0;
+    }
+
+    if (response != NULL && ocsp->cm->ocspRespFreeCb)
+        ocsp->cm->ocspRespFreeCb(ocsp->cm->ocspIOCtx, response);
+
+    return ret;
+}
+#endif /* !NO_ASN_TIME */
+
+
+/* nextUpdate of the cached status for request in seconds since the epoch,
+ * 0 when it is not cached or has no nextUpdate. */
+long OcspNextUpdate(WOLFSSL_OCSP* ocsp, OcspRequest* request)
+{
+    long next = 0;
+#ifndef NO_ASN_TIME
+    OcspEntry*  entry;
+    CertStatus* status = NULL;
+    struct tm   nextTm;
+
+    if (ocsp == NULL || request == NULL)
+        return 0;
+
+    if (wc_LockMutex(&ocsp->ocspLock) != 0)
+        return 0;
+
+    for (entry = ocsp->ocspTable[HashOcspEntry(request->issuerHash)]; entry;
+                                                     entry = entry->tableNext)
+        if (XMEMCMP(entry->issuerHash,    request->issuerHash,
+                                                         OCSP_DIGEST_SIZE) == 0
+        &&  XMEMCMP(entry->issuerKeyHash, request->issuerKeyHash,
+                                                         OCSP_DIGEST_SIZE) == 0)
+            break;
+
+    if (entry != NULL) {
+        status = ocsp->statusTable[HashOcspStatus(request->issuerHash,
+                                          request->serial, request->serialSz)];
+        for (; status; status = status->tableNext)
+            if (status->entry == entry
+            &&  status->serialSz == request->serialSz
+            &&  !XMEMCMP(status->serial, request->serial, status->serialSz))
+                break;
+    }
+
+    if (status != NULL && status->nextDate[0] != 0 &&
+            wc_GetDateAsCalendarTime(status->nextDate, MAX_DATE_SIZE,
+                                     status->nextDateFormat, &nextTm) == 0)
+        next = OcspTimeToEpoch(&nextTm);
+
+    wc_UnLockMutex(&ocsp->ocspLock);
+#else
+    (void)ocsp;
+    (void)request;
+#endif
+
+    return next;
+}
+
+
+/* Fetch new responses for every cached status whose nextUpdate is within
+ * margin seconds, so lookups keep hitting the cache across expiry.
+ *
+ * Returns the number of statuses refreshed or a negative error.
+ */
+int RefreshOCSP(WOLFSSL_OCSP* ocsp, long margin)
+{
+#ifndef NO_ASN_TIME
+    OcspEntry*   entry;
+    CertStatus*  status;
+    long         now;
+    int          ret;
+    int          refreshed = 0;
+#ifdef WOLFSSL_SMALL_STACK
+    OcspRequest* ocspRequest;
+#else
+    OcspRequest  ocspRequest[1];
+#endif
+
+    WOLFSSL_ENTER("RefreshOCSP");
+
+    if (ocsp == NULL)
+        return BAD_FUNC_ARG;
+
+#ifdef WOLFSSL_SMALL_STACK
+    ocspRequest = (OcspRequest*)XMALLOC(sizeof(OcspRequest), NULL,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+    if (ocspRequest == NULL)
+        return MEMORY_E;
+#endif
+
+    now = (long)XTIME(0);
+
+    if (wc_LockMutex(&ocsp->ocspLock) != 0) {
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(ocspRequest, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+        return BAD_MUTEX_E;
+    }
+
+    /* Entries and statuses are only freed with the OCSP object and new ones
+     * are added at the head, so the walk survives dropping the lock. */
+    for (entry = ocsp->ocspList; entry; entry = entry->next) {
+        for (status = entry->status; status; status = status->next) {
+            int keepResponse;
+
+            if (!OcspStatusExpiring(status, now, margin))
+                continue;
+
+            ret = OcspRefreshRequest(ocsp, entry, status, ocspRequest);
+            keepResponse = status->rawOcspResponse != NULL;
+            wc_UnLockMutex(&ocsp->ocspLock);
+
+            if (ret == 0)
+                ret = OcspRefreshStatus(ocsp, ocspRequest, entry, status,
+                                                                 keepResponse);
+            FreeOcspRequest(ocspRequest);
+
+            if (wc_LockMutex(&ocsp->ocspLock) != 0) {
+            #ifdef WOLFSSL_SMALL_STACK
+                XFREE(ocspRequest, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+            #endif
+                return BAD_MUTEX_E;
+            }
+
+            if (ret == 0) {
+                ocsp->refreshes++;
+                refreshed++;
+            }
+            else {
+                WOLFSSL_MSG("OCSP status refresh failed");
+            }
+        }
+    }
+
+    wc_UnLockMutex(&ocsp->ocspLock);
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(ocspRequest, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    WOLFSSL_LEAVE("RefreshOCSP", refreshed);
+    return refreshed;
+#else
+    (void)ocsp;
+    (void)margin;
+    return NOT_COMPILED_IN;
+#endif /* !NO_ASN_TIME */
+}
+
+
+#ifdef HAVE_OCSP_REFRESH
+
+typedef struct OcspRefreshArgs {
+    WOLFSSL_OCSP* ocsp;
+    int           interval;
+    long          margin;
+} OcspRefreshArgs;
+
+/* OCSP refresh thread: wake every interval seconds until stopped. */
+static void* DoOcspRefresh(void* arg)
+{
+    OcspRefreshArgs* args = (OcspRefreshArgs*)arg;
+    WOLFSSL_OCSP*    ocsp = args->ocsp;
+    int              interval = args->interval;
+    long             margin = args->margin;
+    struct timespec  wake;
+
+    WOLFSSL_ENTER("DoOcspRefresh");
+
+    XFREE(args, ocsp->cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+    if (wc_LockMutex(&ocsp->ocspLock) != 0) {
+        WOLFSSL_MSG("wc_LockMutex ocspLock failed");
+        return NULL;
+    }
+
+    while (ocsp->refreshStop == 0) {
+        clock_gettime(CLOCK_REALTIME, &wake);
+        wake.tv_sec += interval;
+
+        while (ocsp->refreshStop == 0) {
+            if (pthread_cond_timedwait(&ocsp->cond, &ocsp->ocspLock,
+                                                               &wake) != 0)
+                break;  /* timed out */
+        }
+        if (ocsp->refreshStop)
+            break;
+
+        wc_UnLockMutex(&ocsp->ocspLock);
+        RefreshOCSP(ocsp, margin);
+        if (wc_LockMutex(&ocsp->ocspLock) != 0) {
+            WOLFSSL_MSG("wc_LockMutex ocspLock failed");
+            return NULL;
+        }
+    }
+
+    wc_UnLockMutex(&ocsp->ocspLock);
+
+    return NULL;
+}
+
+
+/* Start refreshing statuses in a thread, interval seconds apart */
+int StartOCSPRefresh(WOLFSSL_OCSP* ocsp, int interval, long margin)
+{
+    OcspRefreshArgs* args;
+
+    WOLFSSL_ENTER("StartOCSPRefresh");
+
+    if (ocsp == NULL || interval <= 0)
+        return BAD_FUNC_ARG;
+
+    if (ocsp->tid != 0) {
+        WOLFSSL_MSG("OCSP refresh thread already running");
+        return 0;
+    }
+
+    args = (OcspRefreshArgs*)XMALLOC(sizeof(OcspRefreshArgs), ocsp->cm->heap,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+    if (args == NULL)
+        return MEMORY_E;
+    args->ocsp     = ocsp;
+    args->interval = interval;
+    args->margin   = margin;
+
+    ocsp->refreshStop = 0;
+    if (pthread_create(&ocsp->tid, NULL, DoOcspRefresh, args) != 0) {
+        WOLFSSL_MSG("Thread creation error");
+        XFREE(args, ocsp->cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        ocsp->tid = 0;
+        return THREAD_CREATE_E;
+    }
+
+    return 0;
+}
+
+
+/* Signal the refresh thread and wait for it to finish */
+void StopOCSPRefresh(WOLFSSL_OCSP* ocsp)
+{
+    WOLFSSL_ENTER("StopOCSPRefresh");
+
+    if (ocsp == NULL || ocsp->tid == 0)
+        return;
+
+    if (wc_LockMutex(&ocsp->ocspLock) != 0) {
+        WOLFSSL_MSG("wc_LockMutex ocspLock failed");
+        return;
+    }
+    ocsp->refreshStop = 1;
+    pthread_cond_signal(&ocsp->cond);
+    wc_UnLockMutex(&ocsp->ocspLock);
+
+    pthread_join(ocsp->tid, NULL);
+    ocsp->tid = 0;
+}
+
+#endif /* HAVE_OCSP_REFRESH */
+
 #if defined(OPENSSL_ALL) || defined(WOLFSSL_NGINX) || defined(WOLFSSL_HAPROXY) || \
     defined(WOLFSSL_APACHE_HTTPD)
 
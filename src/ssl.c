@@ -48,6 +48,32 @@
     #include <wolfcrypt/src/misc.c>
 #endif
 
+#if defined(WOLFSSL_CA_SNAPSHOT) && !defined(NO_FILESYSTEM) && \
+    !defined(USE_WINDOWS_API)
+    /* CA snapshot files are mapped read-only */
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <errno.h>
+    #define WOLFSSL_CA_SNAPSHOT_MMAP
+#endif
+
+#if defined(WOLFSSL_SHARED_SESSION_CACHE) && !defined(NO_SESSION_CACHE)
+    /* session cache rows live in an anonymous shared mapping */
+    #include <sys/mman.h>
+    #if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+        #define MAP_ANONYMOUS MAP_ANON
+    #endif
+    #include <errno.h>
+    /* a process that dies holding a shared lock must not block the others,
+       without robust mutexes the cache is mapped private to each process */
+    #if !defined(WOLFSSL_NO_ROBUST_MUTEX) && !defined(__APPLE__) && \
+        defined(EOWNERDEAD)
+        #define WOLFSSL_SESSION_CACHE_ROBUST
+    #endif
+#endif
+
 
 #if !defined(WOLFSSL_ALLOW_NO_SUITES) && !defined(WOLFCRYPT_ONLY)
     #if defined(NO_DH) && !defined(HAVE_ECC) && !defined(WOLFSSL_STATIC_RSA) \
@@ -1931,14 +1957,15 @@ int wolfSSL_GetDhKey_Sz(WOLFSSL* ssl)
 #endif /* !NO_DH */
 
 
-WOLFSSL_ABI
-int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
+/* common argument and state checks before application data is sent
+ * returns 0 when ready to write */
+static int wolfSSL_write_prepare(WOLFSSL* ssl)
 {
+#if defined(WOLFSSL_EARLY_DATA) || defined(HAVE_WRITE_DUP)
     int ret;
+#endif
 
-    WOLFSSL_ENTER("SSL_write()");
-
-    if (ssl == NULL || data == NULL || sz < 0)
+    if (ssl == NULL)
         return BAD_FUNC_ARG;
 
 #ifdef WOLFSSL_EARLY_DATA
@@ -1989,6 +2016,23 @@ int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
         ssl->cbmode = SSL_CB_WRITE;
     }
     #endif
+
+    return 0;
+}
+
+WOLFSSL_ABI
+int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
+{
+    int ret;
+
+    WOLFSSL_ENTER("SSL_write()");
+
+    if (data == NULL || sz < 0)
+        return BAD_FUNC_ARG;
+
+    if ((ret = wolfSSL_write_prepare(ssl)) != 0)
+        return ret;
+
     ret = SendData(ssl, data, sz);
 
     WOLFSSL_LEAVE("SSL_write()", ret);
@@ -1999,13 +2043,15 @@ int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
         return ret;
 }
 
-static int wolfSSL_read_internal(WOLFSSL* ssl, void* data, int sz, int peek)
+/* borrow, when set, gets a pointer to the plaintext instead of a copy */
+static int wolfSSL_read_internal(WOLFSSL* ssl, void* data, int sz, int peek,
+                                 const byte** borrow)
 {
     int ret;
 
     WOLFSSL_ENTER("wolfSSL_read_internal()");
 
-    if (ssl == NULL || data == NULL || sz < 0)
+    if (ssl == NULL || (data == NULL && borrow == NULL) || sz < 0)
         return BAD_FUNC_ARG;
 
 #ifdef HAVE_WRITE_DUP
@@ -2033,6 +2079,11 @@ static int wolfSSL_read_internal(WOLFSSL* ssl, void* data, int sz, int peek)
 
     sz = wolfSSL_GetMaxRecordSize(ssl, sz);
 
+#ifdef WOLFSSL_ZERO_COPY_READ
+    if (borrow != NULL)
+        ret = ReceiveDataBorrow(ssl, borrow);
+    else
+#endif
     ret = ReceiveData(ssl, (byte*)data, sz, peek);
 
 #ifdef HAVE_WRITE_DUP
@@ -2066,7 +2117,7 @@ int wolfSSL_peek(WOLFSSL* ssl, void* data, int sz)
 {
     WOLFSSL_ENTER("wolfSSL_peek()");
 
-    return wolfSSL_read_internal(ssl, data, sz, TRUE);
+    return wolfSSL_read_internal(ssl, data, sz, TRUE, NULL);
 }
 
 
@@ -2081,10 +2132,85 @@ int wolfSSL_read(WOLFSSL* ssl, void* data, int sz)
         ssl->cbmode = SSL_CB_READ;
     }
     #endif
-    return wolfSSL_read_internal(ssl, data, sz, FALSE);
+    return wolfSSL_read_internal(ssl, data, sz, FALSE, NULL);
 }
 
 
+#ifdef WOLFSSL_ZERO_COPY_READ
+/* Borrow the decrypted plaintext of the current record without a copy.
+ * *data points into the record buffer and stays valid until
+ * wolfSSL_read_release() or the next read call.
+ * returns the plaintext size, 0 when closed or WOLFSSL_FATAL_ERROR */
+int wolfSSL_read_borrow(WOLFSSL* ssl, const unsigned char** data)
+{
+    WOLFSSL_ENTER("wolfSSL_read_borrow()");
+
+    if (ssl == NULL || data == NULL)
+        return BAD_FUNC_ARG;
+
+    *data = NULL;
+
+    #ifdef OPENSSL_EXTRA
+    if (ssl->CBIS != NULL) {
+        ssl->CBIS(ssl, SSL_CB_READ, SSL_SUCCESS);
+        ssl->cbmode = SSL_CB_READ;
+    }
+    #endif
+    return wolfSSL_read_internal(ssl, NULL, OUTPUT_RECORD_SIZE, FALSE, data);
+}
+
+
+/* Give back sz bytes of borrowed plaintext, the rest stays borrowed
+ * returns WOLFSSL_SUCCESS or BAD_FUNC_ARG */
+int wolfSSL_read_release(WOLFSSL* ssl, int sz)
+{
+    WOLFSSL_ENTER("wolfSSL_read_release()");
+
+    if (ssl == NULL || ReceiveDataRelease(ssl, sz) != 0)
+        return BAD_FUNC_ARG;
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+/* Receive records into the caller's buffer rather than the internal one.
+ * WOLFSSL_READ_BUFFER_SZ bytes hold any record, records that don't fit go
+ * through a dynamic buffer until read. buf NULL goes back to the internal
+ * buffer. The buffer must stay valid until it is replaced or ssl is freed.
+ * returns WOLFSSL_SUCCESS, BAD_FUNC_ARG or BAD_STATE_E with input pending */
+int wolfSSL_set_read_buffer(WOLFSSL* ssl, unsigned char* buf, int sz)
+{
+    WOLFSSL_ENTER("wolfSSL_set_read_buffer()");
+
+    if (ssl == NULL || (buf != NULL && sz < STATIC_BUFFER_LEN))
+        return BAD_FUNC_ARG;
+
+    if (ssl->buffers.inputBuffer.length != ssl->buffers.inputBuffer.idx ||
+                                ssl->buffers.clearOutputBuffer.length != 0) {
+        WOLFSSL_MSG("Input still buffered, can't switch read buffer");
+        return BAD_STATE_E;
+    }
+
+    ssl->buffers.userInput   = buf;
+    ssl->buffers.userInputSz = buf != NULL ? (word32)sz : 0;
+
+    if (ssl->buffers.inputBuffer.dynamicFlag) {
+        ShrinkInputBuffer(ssl, FORCED_FREE);
+    }
+    else {
+        ssl->buffers.inputBuffer.buffer = buf != NULL ? buf :
+                                        ssl->buffers.inputBuffer.staticBuffer;
+        ssl->buffers.inputBuffer.bufferSize = buf != NULL ? (word32)sz :
+                                                          STATIC_BUFFER_LEN;
+        ssl->buffers.inputBuffer.idx    = 0;
+        ssl->buffers.inputBuffer.length = 0;
+    }
+
+    return WOLFSSL_SUCCESS;
+}
+#endif /* WOLFSSL_ZERO_COPY_READ */
+
+
 #ifdef WOLFSSL_MULTICAST
 
 int wolfSSL_mcast_read(WOLFSSL* ssl, word16* id, void* data, int sz)
@@ -2096,7 +2222,7 @@ int wolfSSL_mcast_read(WOLFSSL* ssl, word16* id, void* data, int sz)
     if (ssl == NULL)
         return BAD_FUNC_ARG;
 
-    ret = wolfSSL_read_internal(ssl, data, sz, FALSE);
+    ret = wolfSSL_read_internal(ssl, data, sz, FALSE, NULL);
     if (ssl->options.dtls && ssl->options.haveMcast && id != NULL)
         *id = ssl->keys.curPeerId;
     return ret;
@@ -3569,6 +3695,155 @@ WOLFSSL_CERT_MANAGER* wolfSSL_CTX_GetCertManager(WOLFSSL_CTX* ctx)
     return cm;
 }
 
+/* Allocate an empty signer table with rows entries, NULL on failure */
+static Signer** NewSignerTable(word32 rows, void* heap)
+{
+    Signer** table;
+
+    table = (Signer**)XMALLOC(rows * sizeof(Signer*), heap,
+                              DYNAMIC_TYPE_CERT_MANAGER);
+    if (table != NULL)
+        XMEMSET(table, 0, rows * sizeof(Signer*));
+
+    (void)heap;
+
+    return table;
+}
+
+
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+/* Free all the verified cert cache entries, keeps the rows, have vcLock */
+static void FreeVerifiedCerts(WOLFSSL_CERT_MANAGER* cm)
+{
+    VerifiedCert* vc = cm->vcLruHead;
+
+    while (vc) {
+        VerifiedCert* next = vc->lruNext;
+        XFREE(vc, cm->heap, DYNAMIC_TYPE_CERT);
+        vc = next;
+    }
+    if (cm->vcTable != NULL)
+        XMEMSET(cm->vcTable, 0, cm->vcTableSz * sizeof(VerifiedCert*));
+    cm->vcLruHead = NULL;
+    cm->vcLruTail = NULL;
+    cm->vcCount = 0;
+}
+#endif /* WOLFSSL_CERT_VERIFY_CACHE */
+
+
+#ifdef WOLFSSL_CA_SNAPSHOT
+
+#define WOLFSSL_CA_SNAPSHOT_MAGIC   0x77434153  /* "wCAS" */
+#define WOLFSSL_CA_SNAPSHOT_VERSION 1
+#define CA_SNAPSHOT_SKID            0x01    /* keyIdHash is the SKID hash */
+#ifndef NO_SKID
+    #define CA_SNAPSHOT_FLAGS       CA_SNAPSHOT_SKID
+#else
+    #define CA_SNAPSHOT_FLAGS       0
+#endif
+#define CA_SNAPSHOT_ALIGN(x)        (((x) + 3) & ~(word32)3)
+
+/* CA snapshot layout, every offset is from the start of the snapshot and
+   every part is 4 byte aligned, an offset of 0 means none:
+
+   1) CASnapshotHeader
+   2) key id hash rows, offset of the first CASnapshotSigner on the row
+   3) subject name hash rows, same
+   4) CASnapshotSigner records
+   5) public keys, names, CASnapshotName constraints and DER certs
+
+   Snapshots are only ever read in place so they can be mapped read-only
+   and shared by processes, update WOLFSSL_CA_SNAPSHOT_VERSION if the layout
+   changes */
+typedef struct CASnapshotHeader {
+    word32 magic;                 /* also catches a different byte order */
+    word32 version;
+    word32 totalSz;
+    word32 flags;
+    word32 signerSz;              /* sizeof(CASnapshotSigner) */
+    word32 digestSz;              /* SIGNER_DIGEST_SIZE */
+    word32 keyIdSz;               /* KEYID_SIZE */
+    word32 signers;
+    word32 rows;
+    word32 keyRowsOff;
+    word32 nameRowsOff;
+    word32 signersOff;
+} CASnapshotHeader;
+
+typedef struct CASnapshotSigner {
+    word32 next;                  /* next signer on the key id row */
+    word32 nameNext;              /* next signer on the subject name row */
+    word32 keyOID;
+    word32 pubKeyOff;
+    word32 pubKeySize;
+    word32 nameOff;
+    word32 nameLen;
+    word32 constraintsOff;
+    word32 constraints;           /* CASnapshotName entries */
+    word32 derOff;
+    word32 derSz;
+    word16 keyUsage;
+    byte   maxPathLen;
+    byte   pathLength;
+    byte   pathLengthSet;
+    byte   selfSigned;
+    byte   pad[2];
+    byte   keyIdHash[SIGNER_DIGEST_SIZE];       /* GetCA() hash */
+    byte   subjectNameHash[SIGNER_DIGEST_SIZE];
+    byte   subjectKeyHash[KEYID_SIZE];
+} CASnapshotSigner;
+
+typedef struct CASnapshotName {
+    word16 nameSz;
+    byte   type;
+    byte   excluded;              /* excluded instead of permitted subtree */
+} CASnapshotName;                 /* followed by the name, 4 byte aligned */
+
+
+/* Drop the attached CA snapshot, have write lock */
+static void DetachCASnapshot(WOLFSSL_CERT_MANAGER* cm)
+{
+    if (cm->caSnap != NULL && cm->caSnapOwned) {
+    #ifdef WOLFSSL_CA_SNAPSHOT_MMAP
+        munmap((void*)cm->caSnap, cm->caSnapSz);
+    #else
+        XFREE((void*)cm->caSnap, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+    }
+    cm->caSnap = NULL;
+    cm->caSnapSz = 0;
+    cm->caSnapOwned = 0;
+}
+
+#endif /* WOLFSSL_CA_SNAPSHOT */
+
+
+/* Free all the signers in the CA tables, keeps the rows, have write lock */
+static void FreeCATables(WOLFSSL_CERT_MANAGER* cm)
+{
+#ifdef WOLFSSL_CA_SNAPSHOT
+    DetachCASnapshot(cm);
+#endif
+
+    if (cm->caTable == NULL)
+        return;
+
+    FreeSignerTable(cm->caTable, (int)cm->caTableSz, cm->heap);
+#ifndef NO_SKID
+    XMEMSET(cm->caNameTable, 0, cm->caTableSz * sizeof(Signer*));
+#endif
+    cm->caCount = 0;
+
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    /* cached certs were verified by signers that are gone now */
+    if (wc_LockMutex(&cm->vcLock) == 0) {
+        FreeVerifiedCerts(cm);
+        wc_UnLockMutex(&cm->vcLock);
+    }
+#endif
+}
+
+
 WOLFSSL_CERT_MANAGER* wolfSSL_CertManagerNew_ex(void* heap)
 {
     WOLFSSL_CERT_MANAGER* cm;
@@ -3580,11 +3855,20 @@ WOLFSSL_CERT_MANAGER* wolfSSL_CertManagerNew_ex(void* heap)
     if (cm) {
         XMEMSET(cm, 0, sizeof(WOLFSSL_CERT_MANAGER));
 
-        if (wc_InitMutex(&cm->caLock) != 0) {
+        if (wc_InitRwLock(&cm->caLock) != 0) {
+            WOLFSSL_MSG("Bad rwlock init");
+            XFREE(cm, heap, DYNAMIC_TYPE_CERT_MANAGER);
+            return NULL;
+        }
+
+        #ifdef WOLFSSL_CERT_VERIFY_CACHE
+        if (wc_InitMutex(&cm->vcLock) != 0) {
             WOLFSSL_MSG("Bad mutex init");
-            wolfSSL_CertManagerFree(cm);
+            wc_FreeRwLock(&cm->caLock);
+            XFREE(cm, heap, DYNAMIC_TYPE_CERT_MANAGER);
             return NULL;
         }
+        #endif
 
         #ifdef WOLFSSL_TRUST_PEER_CERT
         if (wc_InitMutex(&cm->tpLock) != 0) {
@@ -3602,6 +3886,21 @@ WOLFSSL_CERT_MANAGER* wolfSSL_CertManagerNew_ex(void* heap)
             cm->minEccKeySz = MIN_ECCKEY_SZ;
         #endif
             cm->heap = heap;
+
+        cm->caTable = NewSignerTable(CA_TABLE_SIZE, heap);
+        #ifndef NO_SKID
+        cm->caNameTable = NewSignerTable(CA_TABLE_SIZE, heap);
+        if (cm->caNameTable == NULL) {
+            XFREE(cm->caTable, heap, DYNAMIC_TYPE_CERT_MANAGER);
+            cm->caTable = NULL;
+        }
+        #endif
+        if (cm->caTable == NULL) {
+            WOLFSSL_MSG("CA table allocation failed");
+            wolfSSL_CertManagerFree(cm);
+            return NULL;
+        }
+        cm->caTableSz = CA_TABLE_SIZE;
     }
 
     return cm;
@@ -3634,8 +3933,17 @@ void wolfSSL_CertManagerFree(WOLFSSL_CERT_MANAGER* cm)
                 FreeOCSP(cm->ocsp_stapling, 1);
         #endif
         #endif
-        FreeSignerTable(cm->caTable, CA_TABLE_SIZE, cm->heap);
-        wc_FreeMutex(&cm->caLock);
+        FreeCATables(cm);
+        XFREE(cm->caTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        #ifndef NO_SKID
+        XFREE(cm->caNameTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        #endif
+        wc_FreeRwLock(&cm->caLock);
+        #ifdef WOLFSSL_CERT_VERIFY_CACHE
+        FreeVerifiedCerts(cm);
+        XFREE(cm->vcTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        wc_FreeMutex(&cm->vcLock);
+        #endif
 
         #ifdef WOLFSSL_TRUST_PEER_CERT
         FreeTrustedPeerTable(cm->tpTable, TP_TABLE_SIZE, cm->heap);
@@ -3674,11 +3982,11 @@ WOLFSSL_STACK* wolfSSL_CertManagerGetCerts(WOLFSSL_CERT_MANAGER* cm)
         return NULL;
     }
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
         goto error_init;
     }
 
-    for (row = 0; row < CA_TABLE_SIZE; row++) {
+    for (row = 0; row < cm->caTableSz; row++) {
         signers = cm->caTable[row];
         while (signers && signers->derCert && signers->derCert->buffer) {
 
@@ -3729,7 +4037,7 @@ WOLFSSL_STACK* wolfSSL_CertManagerGetCerts(WOLFSSL_CERT_MANAGER* cm)
             dCert = NULL;
         }
     }
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     if (!found) {
        goto error_init;
@@ -3738,7 +4046,7 @@ WOLFSSL_STACK* wolfSSL_CertManagerGetCerts(WOLFSSL_CERT_MANAGER* cm)
     return sk;
 
 error:
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
 error_init:
 
@@ -3851,16 +4159,107 @@ int wolfSSL_CertManagerUnloadCAs(WOLFSSL_CERT_MANAGER* cm)
     if (cm == NULL)
         return BAD_FUNC_ARG;
 
-    if (wc_LockMutex(&cm->caLock) != 0)
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0)
+        return BAD_MUTEX_E;
+
+    FreeCATables(cm);
+
+    wc_UnLockRwLock(&cm->caLock);
+
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+/* Enable the verified cert cache holding up to maxEntries chain CA certs,
+   0 for the default size. Drops any certs already cached. */
+int wolfSSL_CertManagerEnableVerifyCache(WOLFSSL_CERT_MANAGER* cm,
+                                         int maxEntries)
+{
+    VerifiedCert** table;
+    word32         rows;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerEnableVerifyCache");
+
+    if (cm == NULL || maxEntries < 0)
+        return BAD_FUNC_ARG;
+
+    if (maxEntries == 0)
+        maxEntries = CERT_VERIFY_CACHE_SZ;
+    rows = (word32)maxEntries / CA_TABLE_MAX_LOAD + 1;
+
+    table = (VerifiedCert**)XMALLOC(rows * sizeof(VerifiedCert*), cm->heap,
+                                    DYNAMIC_TYPE_CERT_MANAGER);
+    if (table == NULL)
+        return MEMORY_E;
+    XMEMSET(table, 0, rows * sizeof(VerifiedCert*));
+
+    if (wc_LockMutex(&cm->vcLock) != 0) {
+        XFREE(table, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        return BAD_MUTEX_E;
+    }
+
+    FreeVerifiedCerts(cm);
+    XFREE(cm->vcTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+    cm->vcTable   = table;
+    cm->vcTableSz = rows;
+    cm->vcMax     = (word32)maxEntries;
+
+    wc_UnLockMutex(&cm->vcLock);
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+/* Disable the verified cert cache and free its entries */
+int wolfSSL_CertManagerDisableVerifyCache(WOLFSSL_CERT_MANAGER* cm)
+{
+    WOLFSSL_ENTER("wolfSSL_CertManagerDisableVerifyCache");
+
+    if (cm == NULL)
+        return BAD_FUNC_ARG;
+
+    if (wc_LockMutex(&cm->vcLock) != 0)
         return BAD_MUTEX_E;
 
-    FreeSignerTable(cm->caTable, CA_TABLE_SIZE, cm->heap);
+    FreeVerifiedCerts(cm);
+    XFREE(cm->vcTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+    cm->vcTable   = NULL;
+    cm->vcTableSz = 0;
+    cm->vcMax     = 0;
+
+    wc_UnLockMutex(&cm->vcLock);
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+/* Get verified cert cache hit, miss and eviction counts. Any count may be
+   NULL. */
+int wolfSSL_CertManagerGetVerifyCacheStats(WOLFSSL_CERT_MANAGER* cm,
+              unsigned int* hits, unsigned int* misses, unsigned int* evictions)
+{
+    WOLFSSL_ENTER("wolfSSL_CertManagerGetVerifyCacheStats");
+
+    if (cm == NULL)
+        return BAD_FUNC_ARG;
+
+    if (wc_LockMutex(&cm->vcLock) != 0)
+        return BAD_MUTEX_E;
 
-    wc_UnLockMutex(&cm->caLock);
+    if (hits)
+        *hits = cm->vcHits;
+    if (misses)
+        *misses = cm->vcMisses;
+    if (evictions)
+        *evictions = cm->vcEvictions;
 
+    wc_UnLockMutex(&cm->vcLock);
 
     return WOLFSSL_SUCCESS;
 }
+#endif /* WOLFSSL_CERT_VERIFY_CACHE */
 
 
 #ifdef WOLFSSL_TRUST_PEER_CERT
@@ -4150,28 +4549,105 @@ static WC_INLINE word32 MakeWordFromHash(const byte* hashID)
 #ifndef NO_CERTS
 
 /* hash is the SHA digest of name, just use first 32 bits as hash */
-static WC_INLINE word32 HashSigner(const byte* hash)
+static WC_INLINE word32 HashSigner(const byte* hash, word32 rows)
 {
-    return MakeWordFromHash(hash) % CA_TABLE_SIZE;
+    return MakeWordFromHash(hash) % rows;
 }
 
 
-/* does CA already exist on signer list */
-int AlreadySigner(WOLFSSL_CERT_MANAGER* cm, byte* hash)
+/* Rehash the CA tables into about twice the rows, have write lock. If the
+   new tables can't be allocated the old ones are kept, rows just get longer */
+static void GrowSignerTable(WOLFSSL_CERT_MANAGER* cm)
 {
-    Signer* signers;
-    int     ret = 0;
-    word32  row;
+    word32   rows = cm->caTableSz * 2 + 1;
+    word32   i;
+    Signer*  signer;
+    Signer** table;
+#ifndef NO_SKID
+    Signer** nameTable;
+#endif
 
-    if (cm == NULL || hash == NULL) {
-        return ret;
+    table = NewSignerTable(rows, cm->heap);
+    if (table == NULL)
+        return;
+#ifndef NO_SKID
+    nameTable = NewSignerTable(rows, cm->heap);
+    if (nameTable == NULL) {
+        XFREE(table, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        return;
     }
+#endif
 
-    row = HashSigner(hash);
+    for (i = 0; i < cm->caTableSz; i++) {
+        signer = cm->caTable[i];
+        while (signer) {
+            Signer* next = signer->next;
+            word32  row;
+        #ifndef NO_SKID
+            row = HashSigner(signer->subjectKeyIdHash, rows);
+        #else
+            row = HashSigner(signer->subjectNameHash, rows);
+        #endif
+            signer->next = table[row];
+            table[row] = signer;
+            signer = next;
+        }
+    #ifndef NO_SKID
+        signer = cm->caNameTable[i];
+        while (signer) {
+            Signer* next = signer->nameNext;
+            word32  row  = HashSigner(signer->subjectNameHash, rows);
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        return ret;
+            signer->nameNext = nameTable[row];
+            nameTable[row] = signer;
+            signer = next;
+        }
+    #endif
     }
+
+    XFREE(cm->caTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+    cm->caTable = table;
+#ifndef NO_SKID
+    XFREE(cm->caNameTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+    cm->caNameTable = nameTable;
+#endif
+    cm->caTableSz = rows;
+}
+
+
+/* Add signer to the CA tables, tables take ownership, have write lock.
+   Returns the row signer was put on */
+static word32 AddSignerToTable(WOLFSSL_CERT_MANAGER* cm, Signer* signer)
+{
+    word32 row;
+
+    if (cm->caCount >= cm->caTableSz * CA_TABLE_MAX_LOAD)
+        GrowSignerTable(cm);
+
+#ifndef NO_SKID
+    row = HashSigner(signer->subjectNameHash, cm->caTableSz);
+    signer->nameNext = cm->caNameTable[row];
+    cm->caNameTable[row] = signer;
+
+    row = HashSigner(signer->subjectKeyIdHash, cm->caTableSz);
+#else
+    row = HashSigner(signer->subjectNameHash, cm->caTableSz);
+#endif
+    signer->next = cm->caTable[row];
+    cm->caTable[row] = signer;
+    cm->caCount++;
+
+    return row;
+}
+
+
+/* find the signer with hash in the CA table, have caLock */
+static Signer* FindSigner(WOLFSSL_CERT_MANAGER* cm, const byte* hash)
+{
+    Signer* signers;
+    word32  row;
+
+    row = HashSigner(hash, cm->caTableSz);
     signers = cm->caTable[row];
     while (signers) {
         byte* subjectHash;
@@ -4182,13 +4658,262 @@ int AlreadySigner(WOLFSSL_CERT_MANAGER* cm, byte* hash)
         subjectHash = signers->subjectNameHash;
     #endif
 
-        if (XMEMCMP(hash, subjectHash, SIGNER_DIGEST_SIZE) == 0) {
-            ret = 1; /* success */
+        if (XMEMCMP(hash, subjectHash, SIGNER_DIGEST_SIZE) == 0)
+            return signers;
+        signers = signers->next;
+    }
+
+    return NULL;
+}
+
+
+#ifndef NO_SKID
+/* find the signer with subject name hash in the CA table, have caLock */
+static Signer* FindSignerByName(WOLFSSL_CERT_MANAGER* cm, const byte* hash)
+{
+    Signer* signers;
+    word32  row;
+
+    row = HashSigner(hash, cm->caTableSz);
+    signers = cm->caNameTable[row];
+    while (signers) {
+        if (XMEMCMP(hash, signers->subjectNameHash, SIGNER_DIGEST_SIZE) == 0)
+            return signers;
+        signers = signers->nameNext;
+    }
+
+    return NULL;
+}
+#endif
+
+
+#ifdef WOLFSSL_CA_SNAPSHOT
+/* is [off, off + sz) inside the attached snapshot */
+static int SnapshotRangeOk(WOLFSSL_CERT_MANAGER* cm, word32 off, word32 sz)
+{
+    return sz <= cm->caSnapSz && off <= cm->caSnapSz - sz;
+}
+
+
+/* get the snapshot signer record at off, NULL if off is bad, have caLock */
+static const CASnapshotSigner* SnapshotSignerAt(WOLFSSL_CERT_MANAGER* cm,
+                                                word32 off)
+{
+    if (off < sizeof(CASnapshotHeader) || (off & 3) != 0 ||
+            !SnapshotRangeOk(cm, off, sizeof(CASnapshotSigner)))
+        return NULL;
+
+    return (const CASnapshotSigner*)(cm->caSnap + off);
+}
+
+
+/* find the signer with key id or subject name hash in the attached snapshot,
+   have caLock */
+static const CASnapshotSigner* FindSnapshotSigner(WOLFSSL_CERT_MANAGER* cm,
+                                                  const byte* hash, int byName)
+{
+    const CASnapshotHeader* hdr = (const CASnapshotHeader*)cm->caSnap;
+    const CASnapshotSigner* rec;
+    const word32* rows;
+    word32 off;
+    word32 steps;
+
+    if (hdr == NULL)
+        return NULL;
+
+    rows = (const word32*)(cm->caSnap + (byName ? hdr->nameRowsOff :
+                                                  hdr->keyRowsOff));
+    off = rows[HashSigner(hash, hdr->rows)];
+
+    /* bound the walk so a corrupt snapshot can't loop */
+    for (steps = 0; off != 0 && steps < hdr->signers; steps++) {
+        rec = SnapshotSignerAt(cm, off);
+        if (rec == NULL)
             break;
+        if (XMEMCMP(hash, byName ? rec->subjectNameHash : rec->keyIdHash,
+                    SIGNER_DIGEST_SIZE) == 0)
+            return rec;
+        off = byName ? rec->nameNext : rec->next;
+    }
+
+    return NULL;
+}
+
+
+#ifndef IGNORE_NAME_CONSTRAINTS
+/* add the snapshot name constraints of rec to signer, have caLock */
+static int MakeSnapshotNames(WOLFSSL_CERT_MANAGER* cm,
+                             const CASnapshotSigner* rec, Signer* signer)
+{
+    Base_entry*  entry;
+    Base_entry** permittedTail = &signer->permittedNames;
+    Base_entry** excludedTail  = &signer->excludedNames;
+    CASnapshotName name;
+    word32 off = rec->constraintsOff;
+    word32 i;
+
+    for (i = 0; i < rec->constraints; i++) {
+        if (!SnapshotRangeOk(cm, off, sizeof(CASnapshotName)))
+            return BUFFER_E;
+        XMEMCPY(&name, cm->caSnap + off, sizeof(CASnapshotName));
+        off += sizeof(CASnapshotName);
+        if (!SnapshotRangeOk(cm, off, name.nameSz))
+            return BUFFER_E;
+
+        entry = (Base_entry*)XMALLOC(sizeof(Base_entry), cm->heap,
+                                     DYNAMIC_TYPE_ALTNAME);
+        if (entry == NULL)
+            return MEMORY_E;
+        XMEMSET(entry, 0, sizeof(Base_entry));
+        entry->name = (char*)XMALLOC(name.nameSz + 1, cm->heap,
+                                     DYNAMIC_TYPE_ALTNAME);
+        if (entry->name == NULL) {
+            XFREE(entry, cm->heap, DYNAMIC_TYPE_ALTNAME);
+            return MEMORY_E;
+        }
+        XMEMCPY(entry->name, cm->caSnap + off, name.nameSz);
+        entry->name[name.nameSz] = '\0';
+        entry->nameSz = name.nameSz;
+        entry->type   = name.type;
+
+        /* keep the order the cert had */
+        if (name.excluded) {
+            *excludedTail = entry;
+            excludedTail = &entry->next;
+        }
+        else {
+            *permittedTail = entry;
+            permittedTail = &entry->next;
+        }
+        off += CA_SNAPSHOT_ALIGN(name.nameSz);
+    }
+
+    return 0;
+}
+#endif
+
+
+/* make a Signer owning copies of the snapshot record data, have caLock */
+static Signer* MakeSnapshotSigner(WOLFSSL_CERT_MANAGER* cm,
+                                  const CASnapshotSigner* rec)
+{
+    Signer* signer;
+    int     ret = 0;
+
+    if (!SnapshotRangeOk(cm, rec->pubKeyOff, rec->pubKeySize) ||
+            !SnapshotRangeOk(cm, rec->nameOff, rec->nameLen) ||
+            !SnapshotRangeOk(cm, rec->derOff, rec->derSz)) {
+        WOLFSSL_MSG("Bad CA snapshot signer");
+        return NULL;
+    }
+
+    signer = MakeSigner(cm->heap);
+    if (signer == NULL)
+        return NULL;
+
+    signer->keyOID        = rec->keyOID;
+    signer->keyUsage      = rec->keyUsage;
+    signer->maxPathLen    = rec->maxPathLen;
+    signer->pathLength    = rec->pathLength;
+    signer->pathLengthSet = rec->pathLengthSet;
+    signer->selfSigned    = rec->selfSigned;
+    XMEMCPY(signer->subjectNameHash, rec->subjectNameHash, SIGNER_DIGEST_SIZE);
+#ifndef NO_SKID
+    XMEMCPY(signer->subjectKeyIdHash, rec->keyIdHash, SIGNER_DIGEST_SIZE);
+#endif
+#ifdef HAVE_OCSP
+    XMEMCPY(signer->subjectKeyHash, rec->subjectKeyHash, KEYID_SIZE);
+#endif
+
+    if (rec->pubKeySize > 0) {
+        byte* publicKey = (byte*)XMALLOC(rec->pubKeySize, cm->heap,
+                                         DYNAMIC_TYPE_PUBLIC_KEY);
+        if (publicKey == NULL)
+            ret = MEMORY_E;
+        else {
+            XMEMCPY(publicKey, cm->caSnap + rec->pubKeyOff, rec->pubKeySize);
+            signer->publicKey  = publicKey;
+            signer->pubKeySize = rec->pubKeySize;
+        }
+    }
+    if (ret == 0 && rec->nameLen > 0) {
+        signer->name = (char*)XMALLOC(rec->nameLen, cm->heap,
+                                      DYNAMIC_TYPE_SUBJECT_CN);
+        if (signer->name == NULL)
+            ret = MEMORY_E;
+        else {
+            XMEMCPY(signer->name, cm->caSnap + rec->nameOff, rec->nameLen);
+            signer->nameLen = (int)rec->nameLen;
         }
-        signers = signers->next;
     }
-    wc_UnLockMutex(&cm->caLock);
+#ifndef IGNORE_NAME_CONSTRAINTS
+    if (ret == 0)
+        ret = MakeSnapshotNames(cm, rec, signer);
+#endif
+#ifdef WOLFSSL_SIGNER_DER_CERT
+    if (ret == 0 && rec->derSz > 0) {
+        ret = AllocDer(&signer->derCert, rec->derSz, CA_TYPE, cm->heap);
+        if (ret == 0)
+            XMEMCPY(signer->derCert->buffer, cm->caSnap + rec->derOff,
+                    rec->derSz);
+    }
+#endif
+
+    if (ret != 0) {
+        FreeSigner(signer, cm->heap);
+        signer = NULL;
+    }
+
+    return signer;
+}
+
+
+/* Get the snapshot CA with hash, it is added to the CA table on first use so
+   it is owned and freed like any loaded CA */
+static Signer* GetSnapshotCA(WOLFSSL_CERT_MANAGER* cm, const byte* hash,
+                             int byName)
+{
+    const CASnapshotSigner* rec;
+    Signer* ret = NULL;
+
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0)
+        return NULL;
+
+    rec = FindSnapshotSigner(cm, hash, byName);
+    if (rec != NULL) {
+        /* may have been added since the read lock was dropped */
+        ret = FindSigner(cm, rec->keyIdHash);
+        if (ret == NULL) {
+            ret = MakeSnapshotSigner(cm, rec);
+            if (ret != NULL)
+                (void)AddSignerToTable(cm, ret);
+        }
+    }
+    wc_UnLockRwLock(&cm->caLock);
+
+    return ret;
+}
+#endif /* WOLFSSL_CA_SNAPSHOT */
+
+
+/* does CA already exist on signer list */
+int AlreadySigner(WOLFSSL_CERT_MANAGER* cm, byte* hash)
+{
+    int ret = 0;
+
+    if (cm == NULL || hash == NULL) {
+        return ret;
+    }
+
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
+        return ret;
+    }
+    ret = FindSigner(cm, hash) != NULL;
+#ifdef WOLFSSL_CA_SNAPSHOT
+    if (ret == 0)
+        ret = FindSnapshotSigner(cm, hash, 0) != NULL;
+#endif
+    wc_UnLockRwLock(&cm->caLock);
 
     return ret;
 }
@@ -4305,67 +5030,251 @@ Signer* GetCA(void* vp, byte* hash)
 {
     WOLFSSL_CERT_MANAGER* cm = (WOLFSSL_CERT_MANAGER*)vp;
     Signer* ret = NULL;
-    Signer* signers;
-    word32  row = HashSigner(hash);
+#ifdef WOLFSSL_CA_SNAPSHOT
+    int     inSnapshot = 0;
+#endif
 
     if (cm == NULL)
         return NULL;
 
-    if (wc_LockMutex(&cm->caLock) != 0)
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0)
         return ret;
 
-    signers = cm->caTable[row];
-    while (signers) {
-        byte* subjectHash;
-        #ifndef NO_SKID
-            subjectHash = signers->subjectKeyIdHash;
-        #else
-            subjectHash = signers->subjectNameHash;
-        #endif
-        if (XMEMCMP(hash, subjectHash, SIGNER_DIGEST_SIZE) == 0) {
-            ret = signers;
-            break;
-        }
-        signers = signers->next;
-    }
-    wc_UnLockMutex(&cm->caLock);
+    ret = FindSigner(cm, hash);
+#ifdef WOLFSSL_CA_SNAPSHOT
+    if (ret == NULL)
+        inSnapshot = FindSnapshotSigner(cm, hash, 0) != NULL;
+#endif
+    wc_UnLockRwLock(&cm->caLock);
+
+#ifdef WOLFSSL_CA_SNAPSHOT
+    if (inSnapshot)
+        ret = GetSnapshotCA(cm, hash, 0);
+#endif
 
     return ret;
 }
 
 
 #ifndef NO_SKID
-/* return CA if found, otherwise NULL. Walk through hash table. */
+/* return CA if found, otherwise NULL. Uses the subject name hash table. */
 Signer* GetCAByName(void* vp, byte* hash)
 {
     WOLFSSL_CERT_MANAGER* cm = (WOLFSSL_CERT_MANAGER*)vp;
     Signer* ret = NULL;
-    Signer* signers;
-    word32  row;
+#ifdef WOLFSSL_CA_SNAPSHOT
+    int     inSnapshot = 0;
+#endif
 
     if (cm == NULL)
         return NULL;
 
-    if (wc_LockMutex(&cm->caLock) != 0)
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0)
         return ret;
 
-    for (row = 0; row < CA_TABLE_SIZE && ret == NULL; row++) {
-        signers = cm->caTable[row];
-        while (signers && ret == NULL) {
-            if (XMEMCMP(hash, signers->subjectNameHash,
-                        SIGNER_DIGEST_SIZE) == 0) {
-                ret = signers;
-            }
-            signers = signers->next;
-        }
-    }
-    wc_UnLockMutex(&cm->caLock);
+    ret = FindSignerByName(cm, hash);
+#ifdef WOLFSSL_CA_SNAPSHOT
+    if (ret == NULL)
+        inSnapshot = FindSnapshotSigner(cm, hash, 1) != NULL;
+#endif
+    wc_UnLockRwLock(&cm->caLock);
+
+#ifdef WOLFSSL_CA_SNAPSHOT
+    if (inSnapshot)
+        ret = GetSnapshotCA(cm, hash, 1);
+#endif
 
     return ret;
 }
 #endif
 
 
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+/* Take vc off the verified cert cache LRU list, have vcLock */
+static void VerifiedCertLruRemove(WOLFSSL_CERT_MANAGER* cm, VerifiedCert* vc)
+{
+    if (vc->lruPrev)
+        vc->lruPrev->lruNext = vc->lruNext;
+    else
+        cm->vcLruHead = vc->lruNext;
+    if (vc->lruNext)
+        vc->lruNext->lruPrev = vc->lruPrev;
+    else
+        cm->vcLruTail = vc->lruPrev;
+    vc->lruPrev = NULL;
+    vc->lruNext = NULL;
+}
+
+
+/* Put vc at the most recently used end of the LRU list, have vcLock */
+static void VerifiedCertLruAdd(WOLFSSL_CERT_MANAGER* cm, VerifiedCert* vc)
+{
+    vc->lruPrev = NULL;
+    vc->lruNext = cm->vcLruHead;
+    if (cm->vcLruHead)
+        cm->vcLruHead->lruPrev = vc;
+    else
+        cm->vcLruTail = vc;
+    cm->vcLruHead = vc;
+}
+
+
+/* Find the verified cert with DER digest derHash, have vcLock */
+static VerifiedCert* FindVerifiedCert(WOLFSSL_CERT_MANAGER* cm,
+                                      const byte* derHash, word32* row)
+{
+    VerifiedCert* vc;
+
+    *row = MakeWordFromHash(derHash) % cm->vcTableSz;
+    for (vc = cm->vcTable[*row]; vc != NULL; vc = vc->next) {
+        if (XMEMCMP(vc->derHash, derHash, WC_SHA256_DIGEST_SIZE) == 0)
+            break;
+    }
+
+    return vc;
+}
+
+
+/* Copy the verified cert cache entry for the DER digest derHash into vc.
+   Only a hit when the cert is still in its validity period and the signer
+   that verified it is still trusted. Returns 1 on a hit, otherwise 0. */
+int GetVerifiedCert(WOLFSSL_CERT_MANAGER* cm, const byte* derHash,
+                    VerifiedCert* vc)
+{
+    VerifiedCert* entry;
+    word32        row;
+    int           found = 0;
+
+    if (cm == NULL || derHash == NULL || vc == NULL)
+        return 0;
+
+    if (wc_LockMutex(&cm->vcLock) != 0)
+        return 0;
+    if (cm->vcMax == 0) {
+        wc_UnLockMutex(&cm->vcLock);
+        return 0;
+    }
+    entry = FindVerifiedCert(cm, derHash, &row);
+    if (entry != NULL) {
+        VerifiedCertLruRemove(cm, entry);
+        VerifiedCertLruAdd(cm, entry);
+        XMEMCPY(vc, entry, sizeof(VerifiedCert));
+        found = 1;
+    }
+    wc_UnLockMutex(&cm->vcLock);
+
+    /* don't hold vcLock while taking caLock, unloading takes them the other
+       way around */
+#ifndef NO_ASN_TIME
+    if (found &&
+            (!XVALIDATE_DATE(vc->beforeDate, vc->beforeDateFormat, BEFORE) ||
+             !XVALIDATE_DATE(vc->afterDate, vc->afterDateFormat, AFTER))) {
+        WOLFSSL_MSG("Verified cert cache entry out of date");
+        found = 0;
+    }
+#endif
+    if (found && GetCA(cm, vc->signerHash) == NULL) {
+        WOLFSSL_MSG("Verified cert cache entry signer gone");
+        found = 0;
+    }
+
+    if (wc_LockMutex(&cm->vcLock) == 0) {
+        if (found)
+            cm->vcHits++;
+        else
+            cm->vcMisses++;
+        wc_UnLockMutex(&cm->vcLock);
+    }
+
+    return found;
+}
+
+
+/* Remember that cert, with DER digest derHash, was verified by cert->ca.
+   Evicts the least recently used entries to stay within the cache size. */
+int AddVerifiedCert(WOLFSSL_CERT_MANAGER* cm, const byte* derHash,
+                    DecodedCert* cert)
+{
+    VerifiedCert* vc;
+    word32        row;
+
+    if (cm == NULL || derHash == NULL || cert == NULL || cert->ca == NULL)
+        return BAD_FUNC_ARG;
+
+#ifndef NO_ASN_TIME
+    /* dates are kept as the value after the tag and short form length */
+    if (cert->beforeDate == NULL || cert->beforeDateLen <= 2 ||
+            cert->beforeDateLen - 2 > MAX_DATE_SIZE ||
+            cert->afterDate == NULL || cert->afterDateLen <= 2 ||
+            cert->afterDateLen - 2 > MAX_DATE_SIZE) {
+        return ASN_DATE_SZ_E;
+    }
+#endif
+
+    vc = (VerifiedCert*)XMALLOC(sizeof(VerifiedCert), cm->heap,
+                                DYNAMIC_TYPE_CERT);
+    if (vc == NULL)
+        return MEMORY_E;
+    XMEMSET(vc, 0, sizeof(VerifiedCert));
+
+    XMEMCPY(vc->derHash, derHash, WC_SHA256_DIGEST_SIZE);
+#ifndef NO_SKID
+    XMEMCPY(vc->signerHash, cert->ca->subjectKeyIdHash, SIGNER_DIGEST_SIZE);
+#else
+    XMEMCPY(vc->signerHash, cert->ca->subjectNameHash, SIGNER_DIGEST_SIZE);
+#endif
+    XMEMCPY(vc->subjectHash, cert->subjectHash, KEYID_SIZE);
+    XMEMCPY(vc->extSubjKeyId, cert->extSubjKeyId, KEYID_SIZE);
+    vc->keyOID          = cert->keyOID;
+    vc->pubKeySize      = cert->pubKeySize;
+    vc->extSubjKeyIdSet = cert->extSubjKeyIdSet;
+    vc->extAuthKeyIdSet = cert->extAuthKeyIdSet;
+#ifndef NO_ASN_TIME
+    vc->beforeDateFormat = cert->beforeDate[0];
+    XMEMCPY(vc->beforeDate, cert->beforeDate + 2, cert->beforeDateLen - 2);
+    vc->afterDateFormat  = cert->afterDate[0];
+    XMEMCPY(vc->afterDate, cert->afterDate + 2, cert->afterDateLen - 2);
+#endif
+
+    if (wc_LockMutex(&cm->vcLock) != 0) {
+        XFREE(vc, cm->heap, DYNAMIC_TYPE_CERT);
+        return BAD_MUTEX_E;
+    }
+
+    if (cm->vcMax == 0 || FindVerifiedCert(cm, derHash, &row) != NULL) {
+        /* disabled, or another connection added it first */
+        wc_UnLockMutex(&cm->vcLock);
+        XFREE(vc, cm->heap, DYNAMIC_TYPE_CERT);
+        return 0;
+    }
+
+    while (cm->vcCount >= cm->vcMax && cm->vcLruTail != NULL) {
+        VerifiedCert*  old = cm->vcLruTail;
+        VerifiedCert** prev;
+        word32         oldRow;
+
+        (void)FindVerifiedCert(cm, old->derHash, &oldRow);
+        for (prev = &cm->vcTable[oldRow]; *prev != old; prev = &(*prev)->next)
+            ;
+        *prev = old->next;
+        VerifiedCertLruRemove(cm, old);
+        XFREE(old, cm->heap, DYNAMIC_TYPE_CERT);
+        cm->vcCount--;
+        cm->vcEvictions++;
+    }
+
+    vc->next = cm->vcTable[row];
+    cm->vcTable[row] = vc;
+    VerifiedCertLruAdd(cm, vc);
+    cm->vcCount++;
+
+    wc_UnLockMutex(&cm->vcLock);
+
+    return 0;
+}
+#endif /* WOLFSSL_CERT_VERIFY_CACHE */
+
+
 #ifdef WOLFSSL_TRUST_PEER_CERT
 /* add a trusted peer cert to linked list */
 int AddTrustedPeer(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int verify)
@@ -4499,36 +5408,17 @@ int AddTrustedPeer(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int verify)
 /* owns der, internal now uses too */
 /* type flag ids from user or from chain received during verify
    don't allow chain ones to be added w/o isCA extension */
-int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
+/* Parse the CA in cert, initialized over der, and make its signer without
+   adding it. *pSigner is left NULL when the CA is already loaded. */
+static int MakeCASigner(WOLFSSL_CERT_MANAGER* cm, DecodedCert* cert,
+                        int type, int verify, Signer** pSigner)
 {
     int         ret;
     Signer*     signer = NULL;
-    word32      row;
     byte*       subjectHash;
-#ifdef WOLFSSL_SMALL_STACK
-    DecodedCert* cert = NULL;
-#else
-    DecodedCert  cert[1];
-#endif
-    DerBuffer*   der = *pDer;
-
-    WOLFSSL_MSG("Adding a CA");
-
-    if (cm == NULL) {
-        FreeDer(pDer);
-        return BAD_FUNC_ARG;
-    }
 
-#ifdef WOLFSSL_SMALL_STACK
-    cert = (DecodedCert*)XMALLOC(sizeof(DecodedCert), NULL,
-                                 DYNAMIC_TYPE_DCERT);
-    if (cert == NULL) {
-        FreeDer(pDer);
-        return MEMORY_E;
-    }
-#endif
+    *pSigner = NULL;
 
-    InitDecodedCert(cert, der->buffer, der->length, cm->heap);
     ret = ParseCert(cert, CA_TYPE, verify, cm);
     WOLFSSL_MSG("\tParsed new CA");
 
@@ -4609,10 +5499,10 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
     }
     if (ret == 0 && signer != NULL) {
     #ifdef WOLFSSL_SIGNER_DER_CERT
-        ret = AllocDer(&signer->derCert, der->length, der->type, NULL);
+        ret = AllocDer(&signer->derCert, cert->maxIdx, CA_TYPE, NULL);
     }
     if (ret == 0 && signer != NULL) {
-        XMEMCPY(signer->derCert->buffer, der->buffer, der->length);
+        XMEMCPY(signer->derCert->buffer, cert->source, cert->maxIdx);
     #endif
         signer->keyOID         = cert->keyOID;
         if (cert->pubKeyStored) {
@@ -4650,17 +5540,58 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
         cert->permittedNames = NULL;
         cert->excludedNames = NULL;
     #endif
+    }
 
-    #ifndef NO_SKID
-        row = HashSigner(signer->subjectKeyIdHash);
-    #else
-        row = HashSigner(signer->subjectNameHash);
-    #endif
+    if (ret == 0)
+        *pSigner = signer;
+    else if (signer != NULL)
+        FreeSigner(signer, cm->heap);
+
+    return ret;
+}
+
+
+int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
+{
+    int         ret;
+    Signer*     signer = NULL;
+#if defined(WOLFSSL_RENESAS_TSIP_TLS)
+    word32      row = 0;
+#endif
+#ifdef WOLFSSL_SMALL_STACK
+    DecodedCert* cert = NULL;
+#else
+    DecodedCert  cert[1];
+#endif
+    DerBuffer*   der = *pDer;
+
+    WOLFSSL_MSG("Adding a CA");
+
+    if (cm == NULL) {
+        FreeDer(pDer);
+        return BAD_FUNC_ARG;
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    cert = (DecodedCert*)XMALLOC(sizeof(DecodedCert), NULL,
+                                 DYNAMIC_TYPE_DCERT);
+    if (cert == NULL) {
+        FreeDer(pDer);
+        return MEMORY_E;
+    }
+#endif
 
-        if (wc_LockMutex(&cm->caLock) == 0) {
-            signer->next = cm->caTable[row];
-            cm->caTable[row] = signer;   /* takes ownership */
-            wc_UnLockMutex(&cm->caLock);
+    InitDecodedCert(cert, der->buffer, der->length, cm->heap);
+    ret = MakeCASigner(cm, cert, type, verify, &signer);
+    if (ret == 0 && signer != NULL) {
+        if (wc_LockRwLock_Wr(&cm->caLock) == 0) {
+            /* takes ownership */
+        #if defined(WOLFSSL_RENESAS_TSIP_TLS)
+            row = AddSignerToTable(cm, signer);
+        #else
+            (void)AddSignerToTable(cm, signer);
+        #endif
+            wc_UnLockRwLock(&cm->caLock);
             if (cm->caCacheCallback)
                 cm->caCacheCallback(der->buffer, (int)der->length, type);
         }
@@ -4690,6 +5621,7 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
         }
     }
 #endif
+
     WOLFSSL_MSG("\tFreeing Parsed CA");
     FreeDecodedCert(cert);
 #ifdef WOLFSSL_SMALL_STACK
@@ -4730,7 +5662,28 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
        uses less than 500 bytes RAM
 
        default SESSION_CACHE stores 33 sessions (no XXX_SESSION_CACHE defined)
+
+       WOLFSSL_DYNAMIC_SESSION_CACHE allocates the rows in wolfSSL_Init()
+       instead, the XXX_SESSION_CACHE row count is only the default and can be
+       changed beforehand with wolfSSL_SetSessionCacheSize()
+
+       WOLFSSL_SHARED_SESSION_CACHE maps the rows and their locks shared in
+       wolfSSL_Init() so processes forked after it, like pre-fork server
+       workers, all use and resume from the same cache. The locks are robust,
+       rows a dead process held locked are emptied. Without robust mutexes
+       each process gets a private copy instead
     */
+    #if defined(WOLFSSL_SHARED_SESSION_CACHE) && \
+        (!defined(WOLFSSL_DYNAMIC_SESSION_CACHE) || \
+         !defined(ENABLE_SESSION_CACHE_ROW_LOCK) || \
+         !defined(WOLFSSL_PTHREADS) || defined(SINGLE_THREADED))
+        #error "WOLFSSL_SHARED_SESSION_CACHE needs WOLFSSL_DYNAMIC_SESSION_CACHE, ENABLE_SESSION_CACHE_ROW_LOCK and pthreads"
+    #endif
+    #if defined(WOLFSSL_SHARED_SESSION_CACHE) && \
+        (defined(OPENSSL_EXTRA) || defined(HAVE_EX_DATA))
+        /* cached sessions would hold process local pointers */
+        #error "WOLFSSL_SHARED_SESSION_CACHE can't be used with OPENSSL_EXTRA or HAVE_EX_DATA"
+    #endif
     #if defined(TITAN_SESSION_CACHE)
         #define SESSIONS_PER_ROW 31
         #define SESSION_ROWS 64937
@@ -4755,9 +5708,22 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
         int nextIdx;                           /* where to place next one   */
         int totalCount;                        /* sessions ever on this row */
         WOLFSSL_SESSION Sessions[SESSIONS_PER_ROW];
+    #ifdef WOLFSSL_DYNAMIC_SESSION_CACHE
+        word32 useCount;                       /* row use clock for LRU     */
+        word32 lastUse[SESSIONS_PER_ROW];      /* useCount at last use      */
+    #endif
     } SessionRow;
 
-    static WOLFSSL_GLOBAL SessionRow SessionCache[SESSION_ROWS];
+    #ifdef WOLFSSL_DYNAMIC_SESSION_CACHE
+        static WOLFSSL_GLOBAL SessionRow* SessionCache = NULL;
+        static WOLFSSL_GLOBAL word32 SessionCacheRows = SESSION_ROWS;
+        static WOLFSSL_GLOBAL int SessionCacheEvict =
+                                              WOLFSSL_SESSION_EVICT_ROUND_ROBIN;
+        #define SESSION_CACHE_ROWS SessionCacheRows
+    #else
+        static WOLFSSL_GLOBAL SessionRow SessionCache[SESSION_ROWS];
+        #define SESSION_CACHE_ROWS SESSION_ROWS
+    #endif
 
     #if defined(WOLFSSL_SESSION_STATS) && defined(WOLFSSL_PEAK_SESSIONS)
         static WOLFSSL_GLOBAL word32 PeakSessions;
@@ -4765,6 +5731,39 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
 
     static WOLFSSL_GLOBAL wolfSSL_Mutex session_mutex; /* SessionCache mutex */
 
+    #ifdef WOLFSSL_SHARED_SESSION_CACHE
+        /* row locks, ClientCache lock, SessionCache then ClientCache */
+        static WOLFSSL_GLOBAL byte*  SessionCacheMap = NULL;
+        static WOLFSSL_GLOBAL size_t SessionCacheMapSz = 0;
+        static WOLFSSL_GLOBAL wolfSSL_Mutex* client_mutex = NULL;
+        static WOLFSSL_GLOBAL int    SessionCacheShared = 0; /* 0 private */
+        #ifdef HAVE_SESSION_TICKET
+        /* tickets too long to share, guarded by session_mutex */
+        static WOLFSSL_GLOBAL word32 SessionTicketsDropped = 0;
+        #endif
+        #define CLIENT_CACHE_MUTEX (client_mutex)
+    #else
+        #define CLIENT_CACHE_MUTEX (&session_mutex)
+    #endif
+
+    /* ENABLE_SESSION_CACHE_ROW_LOCK gives every SessionCache row its own
+       mutex so lookups and inserts on different rows don't serialize. The
+       locks are kept apart from the rows so the persisted layout is the same
+       in both modes. session_mutex then only guards the ClientCache and
+       sessions that don't live in the cache. Lock order is row locks in
+       ascending order, then session_mutex. With a shared cache the
+       ClientCache has its own process shared lock, CLIENT_CACHE_MUTEX. */
+    #if defined(ENABLE_SESSION_CACHE_ROW_LOCK) && \
+                                           defined(WOLFSSL_DYNAMIC_SESSION_CACHE)
+        static WOLFSSL_GLOBAL wolfSSL_Mutex* session_row_mutex = NULL;
+        #define SESSION_ROW_MUTEX(row) (&session_row_mutex[(row)])
+    #elif defined(ENABLE_SESSION_CACHE_ROW_LOCK)
+        static WOLFSSL_GLOBAL wolfSSL_Mutex session_row_mutex[SESSION_ROWS];
+        #define SESSION_ROW_MUTEX(row) (&session_row_mutex[(row)])
+    #else
+        #define SESSION_ROW_MUTEX(row) (&session_mutex)
+    #endif
+
     #ifndef NO_CLIENT_CACHE
 
         typedef struct ClientSession {
@@ -4778,11 +5777,430 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
             ClientSession Clients[SESSIONS_PER_ROW];
         } ClientRow;
 
+    #ifdef WOLFSSL_DYNAMIC_SESSION_CACHE
+        static WOLFSSL_GLOBAL ClientRow* ClientCache = NULL;
+    #else
         static WOLFSSL_GLOBAL ClientRow ClientCache[SESSION_ROWS];
+    #endif
                                                      /* Client Cache */
                                                      /* uses session mutex */
     #endif  /* NO_CLIENT_CACHE */
 
+    #define SESSION_CACHE_SZ (SESSION_CACHE_ROWS * sizeof(SessionRow))
+    #define CLIENT_CACHE_SZ  (SESSION_CACHE_ROWS * sizeof(ClientRow))
+
+    /* mutex protecting the given session, the row lock if it lives in the
+       SessionCache and session_mutex otherwise */
+    static wolfSSL_Mutex* GetSessionMutex(const WOLFSSL_SESSION* session)
+    {
+    #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
+        const byte* p    = (const byte*)session;
+        const byte* base = (const byte*)SessionCache;
+
+        if (p >= base && p < base + SESSION_CACHE_SZ)
+            return SESSION_ROW_MUTEX((word32)(p - base) / sizeof(SessionRow));
+    #endif
+        (void)session;
+        return &session_mutex;
+    }
+
+    static int FreeSessionCache(void);
+
+    #ifdef WOLFSSL_SHARED_SESSION_CACHE
+    #ifdef WOLFSSL_SESSION_CACHE_ROBUST
+    /* init a robust mutex that works between processes sharing its memory */
+    static int InitProcessSharedMutex(wolfSSL_Mutex* m)
+    {
+        pthread_mutexattr_t attr;
+        int ret = BAD_MUTEX_E;
+
+        if (pthread_mutexattr_init(&attr) != 0)
+            return BAD_MUTEX_E;
+        if (pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) == 0 &&
+                pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST) == 0 &&
+                pthread_mutex_init(m, &attr) == 0)
+            ret = 0;
+        pthread_mutexattr_destroy(&attr);
+
+        return ret;
+    }
+
+    /* the owner of m died mid update, empty what it guards, m held */
+    static void ResetSessionCacheMutexData(wolfSSL_Mutex* m)
+    {
+        if (m >= session_row_mutex &&
+                                  m < session_row_mutex + SESSION_CACHE_ROWS) {
+            XMEMSET(&SessionCache[m - session_row_mutex], 0,
+                                                           sizeof(SessionRow));
+        }
+        #ifndef NO_CLIENT_CACHE
+        else if (m == client_mutex) {
+            XMEMSET(ClientCache, 0, CLIENT_CACHE_SZ);
+        }
+        #endif
+    }
+    #endif /* WOLFSSL_SESSION_CACHE_ROBUST */
+
+    #define SESSION_MAP_ALIGN(x) (((x) + sizeof(word64) - 1) & \
+                                  ~(sizeof(word64) - 1))
+
+    /* map the cache rows and their locks, 0 on success */
+    static int MapSessionCache(int flags)
+    {
+        size_t locksSz;
+
+        locksSz = SESSION_MAP_ALIGN((SESSION_CACHE_ROWS + 1) *
+                                    sizeof(wolfSSL_Mutex));
+        SessionCacheMapSz = locksSz + SESSION_MAP_ALIGN(SESSION_CACHE_SZ);
+        #ifndef NO_CLIENT_CACHE
+        SessionCacheMapSz += CLIENT_CACHE_SZ;
+        #endif
+
+        /* anonymous mappings start zeroed */
+        SessionCacheMap = (byte*)mmap(NULL, SessionCacheMapSz,
+                                      PROT_READ | PROT_WRITE,
+                                      flags | MAP_ANONYMOUS, -1, 0);
+        if (SessionCacheMap == (byte*)MAP_FAILED) {
+            WOLFSSL_MSG("Session cache mmap failed");
+            SessionCacheMap = NULL;
+            SessionCacheMapSz = 0;
+            return MEMORY_E;
+        }
+
+        session_row_mutex = (wolfSSL_Mutex*)SessionCacheMap;
+        client_mutex = &session_row_mutex[SESSION_CACHE_ROWS];
+        SessionCache = (SessionRow*)(SessionCacheMap + locksSz);
+        #ifndef NO_CLIENT_CACHE
+        ClientCache = (ClientRow*)(SessionCacheMap + locksSz +
+                                   SESSION_MAP_ALIGN(SESSION_CACHE_SZ));
+        #endif
+
+        return 0;
+    }
+
+    static void UnMapSessionCache(void)
+    {
+        if (SessionCacheMap != NULL)
+            munmap(SessionCacheMap, SessionCacheMapSz);
+        SessionCacheMap = NULL;
+        SessionCacheMapSz = 0;
+        SessionCacheShared = 0;
+        session_row_mutex = NULL;
+        client_mutex = NULL;
+        SessionCache = NULL;
+        #ifndef NO_CLIENT_CACHE
+        ClientCache = NULL;
+        #endif
+    }
+
+    /* map the cache rows and their locks shared, processes forked from here
+       on see the same mapping at the same address. Falls back to a private
+       mapping when robust process shared locks aren't available */
+    static int InitSharedSessionCache(void)
+    {
+        word32 i;
+        int    ret;
+
+    #ifdef WOLFSSL_SESSION_CACHE_ROBUST
+        ret = MapSessionCache(MAP_SHARED);
+        if (ret != 0)
+            return ret;
+
+        for (i = 0; i <= SESSION_CACHE_ROWS; i++) {
+            if (InitProcessSharedMutex(&session_row_mutex[i]) != 0)
+                break;
+        }
+        if (i > SESSION_CACHE_ROWS) {
+            SessionCacheShared = 1;
+            return 0;
+        }
+
+        /* nothing else has seen the mapping yet */
+        while (i-- > 0)
+            pthread_mutex_destroy(&session_row_mutex[i]);
+        UnMapSessionCache();
+    #endif
+        WOLFSSL_MSG("No robust shared mutexes, session cache not shared");
+
+        ret = MapSessionCache(MAP_PRIVATE);
+        if (ret != 0)
+            return ret;
+
+        for (i = 0; i <= SESSION_CACHE_ROWS; i++) {
+            if (wc_InitMutex(&session_row_mutex[i]) != 0) {
+                WOLFSSL_MSG("Bad Init Mutex session row");
+                while (i-- > 0)
+                    wc_FreeMutex(&session_row_mutex[i]);
+                UnMapSessionCache();
+                return BAD_MUTEX_E;
+            }
+        }
+
+        return 0;
+    }
+    #endif /* WOLFSSL_SHARED_SESSION_CACHE */
+
+    /* lock a session cache mutex, 0 on success. A shared lock whose owner
+       died is made consistent after emptying what it guards */
+    static int LockSessionMutex(wolfSSL_Mutex* m)
+    {
+    #ifdef WOLFSSL_SESSION_CACHE_ROBUST
+        int ret;
+
+        if (!SessionCacheShared)
+            return wc_LockMutex(m);
+
+        ret = pthread_mutex_lock(m);
+        if (ret == EOWNERDEAD) {
+            WOLFSSL_MSG("Session cache lock owner died, emptying its rows");
+            ResetSessionCacheMutexData(m);
+            ret = pthread_mutex_consistent(m);
+            if (ret != 0)
+                pthread_mutex_unlock(m);
+        }
+
+        return (ret == 0) ? 0 : BAD_MUTEX_E;
+    #else
+        return wc_LockMutex(m);
+    #endif
+    }
+
+    #if defined(PERSIST_SESSION_CACHE) || defined(WOLFSSL_SESSION_STATS)
+    /* lock the whole session and client cache, 0 on success */
+    static int LockSessionCache(void)
+    {
+    #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
+        int i;
+
+        for (i = 0; i < (int)SESSION_CACHE_ROWS; i++) {
+            if (LockSessionMutex(&session_row_mutex[i]) != 0) {
+                while (--i >= 0)
+                    wc_UnLockMutex(&session_row_mutex[i]);
+                return BAD_MUTEX_E;
+            }
+        }
+        if (LockSessionMutex(CLIENT_CACHE_MUTEX) != 0) {
+            for (i = 0; i < (int)SESSION_CACHE_ROWS; i++)
+                wc_UnLockMutex(&session_row_mutex[i]);
+            return BAD_MUTEX_E;
+        }
+    #else
+        if (wc_LockMutex(&session_mutex) != 0)
+            return BAD_MUTEX_E;
+    #endif
+
+        return 0;
+    }
+
+    static void UnLockSessionCache(void)
+    {
+    #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
+        int i;
+
+        for (i = 0; i < (int)SESSION_CACHE_ROWS; i++)
+            wc_UnLockMutex(&session_row_mutex[i]);
+    #endif
+        wc_UnLockMutex(CLIENT_CACHE_MUTEX);
+    }
+    #endif /* PERSIST_SESSION_CACHE || WOLFSSL_SESSION_STATS */
+
+    /* allocate the cache rows and row locks, called once from wolfSSL_Init */
+    static int InitSessionCache(void)
+    {
+    #ifdef WOLFSSL_SHARED_SESSION_CACHE
+        return InitSharedSessionCache();
+    #else
+    #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
+        word32 i;
+    #endif
+
+    #ifdef WOLFSSL_DYNAMIC_SESSION_CACHE
+        SessionCache = (SessionRow*)XMALLOC(SESSION_CACHE_SZ, NULL,
+                                                   DYNAMIC_TYPE_SESSION_CACHE);
+        #ifndef NO_CLIENT_CACHE
+        ClientCache = (ClientRow*)XMALLOC(CLIENT_CACHE_SZ, NULL,
+                                                   DYNAMIC_TYPE_SESSION_CACHE);
+        #endif
+        if (SessionCache == NULL
+        #ifndef NO_CLIENT_CACHE
+            || ClientCache == NULL
+        #endif
+            ) {
+            FreeSessionCache();
+            return MEMORY_E;
+        }
+        XMEMSET(SessionCache, 0, SESSION_CACHE_SZ);
+        #ifndef NO_CLIENT_CACHE
+        XMEMSET(ClientCache, 0, CLIENT_CACHE_SZ);
+        #endif
+    #endif /* WOLFSSL_DYNAMIC_SESSION_CACHE */
+
+    #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
+        #ifdef WOLFSSL_DYNAMIC_SESSION_CACHE
+        session_row_mutex = (wolfSSL_Mutex*)XMALLOC(
+                                  SESSION_CACHE_ROWS * sizeof(wolfSSL_Mutex),
+                                  NULL, DYNAMIC_TYPE_SESSION_CACHE);
+        if (session_row_mutex == NULL) {
+            FreeSessionCache();
+            return MEMORY_E;
+        }
+        #endif
+        for (i = 0; i < SESSION_CACHE_ROWS; i++) {
+            if (wc_InitMutex(&session_row_mutex[i]) != 0) {
+                WOLFSSL_MSG("Bad Init Mutex session row");
+                while (i-- > 0)
+                    wc_FreeMutex(&session_row_mutex[i]);
+            #ifdef WOLFSSL_DYNAMIC_SESSION_CACHE
+                XFREE(session_row_mutex, NULL, DYNAMIC_TYPE_SESSION_CACHE);
+                session_row_mutex = NULL;
+                FreeSessionCache();
+            #endif
+                return BAD_MUTEX_E;
+            }
+        }
+    #endif
+
+        return 0;
+    #endif /* WOLFSSL_SHARED_SESSION_CACHE */
+    }
+
+    static int FreeSessionCache(void)
+    {
+        int ret = 0;
+    #ifdef WOLFSSL_SHARED_SESSION_CACHE
+        /* only unmaps this process' view, other processes may still hold the
+           shared locks so they are not destroyed, private ones are. No
+           session has a dynamic ticket to free, see AddSession() */
+        if (SessionCacheMap != NULL && !SessionCacheShared) {
+            word32 i;
+
+            for (i = 0; i <= SESSION_CACHE_ROWS; i++) {
+                if (wc_FreeMutex(&session_row_mutex[i]) != 0)
+                    ret = BAD_MUTEX_E;
+            }
+        }
+        UnMapSessionCache();
+    #else
+    #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
+        word32 i;
+
+        #ifdef WOLFSSL_DYNAMIC_SESSION_CACHE
+        if (session_row_mutex != NULL)
+        #endif
+        {
+            for (i = 0; i < SESSION_CACHE_ROWS; i++) {
+                if (wc_FreeMutex(&session_row_mutex[i]) != 0)
+                    ret = BAD_MUTEX_E;
+            }
+        }
+    #endif
+
+    #ifdef WOLFSSL_DYNAMIC_SESSION_CACHE
+        #ifdef HAVE_SESSION_TICKET
+        if (SessionCache != NULL) {
+            word32 row, col;
+
+            for (row = 0; row < SESSION_CACHE_ROWS; row++) {
+                for (col = 0; col < SESSIONS_PER_ROW; col++) {
+                    if (SessionCache[row].Sessions[col].isDynamic) {
+                        XFREE(SessionCache[row].Sessions[col].ticket, NULL,
+                                                    DYNAMIC_TYPE_SESSION_TICK);
+                    }
+                }
+            }
+        }
+        #endif
+        XFREE(SessionCache, NULL, DYNAMIC_TYPE_SESSION_CACHE);
+        SessionCache = NULL;
+        #ifndef NO_CLIENT_CACHE
+        XFREE(ClientCache, NULL, DYNAMIC_TYPE_SESSION_CACHE);
+        ClientCache = NULL;
+        #endif
+        #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
+        XFREE(session_row_mutex, NULL, DYNAMIC_TYPE_SESSION_CACHE);
+        session_row_mutex = NULL;
+        #endif
+    #endif /* WOLFSSL_DYNAMIC_SESSION_CACHE */
+    #endif /* WOLFSSL_SHARED_SESSION_CACHE */
+
+        return ret;
+    }
+
+    /* pick the column a new session goes in, row lock held */
+    static word32 GetSessionRowSlot(SessionRow* sessRow)
+    {
+    #ifdef WOLFSSL_DYNAMIC_SESSION_CACHE
+        if (SessionCacheEvict == WOLFSSL_SESSION_EVICT_LRU &&
+                                       sessRow->totalCount >= SESSIONS_PER_ROW) {
+            word32 i;
+            word32 slot = 0;
+            word32 age  = 0;
+
+            /* row is full, replace the entry unused for the most row uses */
+            for (i = 0; i < SESSIONS_PER_ROW; i++) {
+                if (sessRow->useCount - sessRow->lastUse[i] > age) {
+                    age  = sessRow->useCount - sessRow->lastUse[i];
+                    slot = i;
+                }
+            }
+            return slot;
+        }
+    #endif
+
+        return (word32)sessRow->nextIdx++;
+    }
+
+    /* mark a session column as used for LRU eviction, row lock held */
+    static WC_INLINE void TouchSessionRowSlot(SessionRow* sessRow, word32 idx)
+    {
+    #ifdef WOLFSSL_DYNAMIC_SESSION_CACHE
+        sessRow->lastUse[idx] = ++sessRow->useCount;
+    #else
+        (void)sessRow;
+        (void)idx;
+    #endif
+    }
+
+    #ifdef HAVE_EXT_CACHE
+    /* drop ctx as the owner of its cached sessions so evicting them later
+       doesn't call back into it, for when it is freed or clears rem_sess_cb */
+    void RemoveSessionCacheOwner(WOLFSSL_CTX* ctx)
+    {
+        word32 i, j;
+        int    locked;
+
+    #ifdef WOLFSSL_DYNAMIC_SESSION_CACHE
+        if (SessionCache == NULL)
+            return;
+    #endif
+
+        for (i = 0; i < SESSION_CACHE_ROWS; i++) {
+            /* the row locks are gone after wolfSSL_Cleanup() */
+            locked = (initRefCount > 0 &&
+                      LockSessionMutex(SESSION_ROW_MUTEX(i)) == 0);
+            for (j = 0; j < SESSIONS_PER_ROW; j++) {
+                if (SessionCache[i].Sessions[j].ownerCtx == ctx)
+                    SessionCache[i].Sessions[j].ownerCtx = NULL;
+            }
+            if (locked)
+                wc_UnLockMutex(SESSION_ROW_MUTEX(i));
+        }
+    }
+
+    #ifdef PERSIST_SESSION_CACHE
+    /* restored sessions name ctx pointers from another run, cache locked */
+    static void ClearSessionCacheOwners(void)
+    {
+        word32 i, j;
+
+        for (i = 0; i < SESSION_CACHE_ROWS; i++) {
+            for (j = 0; j < SESSIONS_PER_ROW; j++)
+                SessionCache[i].Sessions[j].ownerCtx = NULL;
+        }
+    }
+    #endif
+    #endif /* HAVE_EXT_CACHE */
+
 #endif /* NO_SESSION_CACHE */
 
 WOLFSSL_ABI
@@ -4809,6 +6227,13 @@ int wolfSSL_Init(void)
             WOLFSSL_MSG("Bad Init Mutex session");
             return BAD_MUTEX_E;
         }
+        {
+            int ret = InitSessionCache();
+            if (ret != 0) {
+                WOLFSSL_MSG("Bad Init session cache");
+                return ret;
+            }
+        }
 #endif
         if (wc_InitMutex(&count_mutex) != 0) {
             WOLFSSL_MSG("Bad Init Mutex count");
@@ -4828,6 +6253,65 @@ int wolfSSL_Init(void)
 }
 
 
+#if defined(WOLFSSL_DYNAMIC_SESSION_CACHE) && !defined(NO_SESSION_CACHE)
+/* Set the number of sessions the cache holds and how a full row picks the
+ * entry to replace. The cache is shared by all WOLFSSL_CTX objects and is
+ * allocated by wolfSSL_Init(), so this must be called before it.
+ * sessions  rounded up to whole rows of SESSIONS_PER_ROW
+ * evict     WOLFSSL_SESSION_EVICT_ROUND_ROBIN or WOLFSSL_SESSION_EVICT_LRU
+ * returns WOLFSSL_SUCCESS, BAD_FUNC_ARG or BAD_STATE_E once allocated */
+int wolfSSL_SetSessionCacheSize(word32 sessions, int evict)
+{
+    word32 rows;
+
+    WOLFSSL_ENTER("wolfSSL_SetSessionCacheSize");
+
+    if (sessions == 0 || (evict != WOLFSSL_SESSION_EVICT_ROUND_ROBIN &&
+                          evict != WOLFSSL_SESSION_EVICT_LRU))
+        return BAD_FUNC_ARG;
+
+    /* ClientCache and SESSION_INDEX keep the row in 16 bits */
+    rows = (sessions + SESSIONS_PER_ROW - 1) / SESSIONS_PER_ROW;
+    if (rows > 0xFFFF)
+        return BAD_FUNC_ARG;
+
+    if (initRefCount != 0 || SessionCache != NULL) {
+        WOLFSSL_MSG("Session cache size must be set before wolfSSL_Init");
+        return BAD_STATE_E;
+    }
+
+    SessionCacheRows  = rows;
+    SessionCacheEvict = evict;
+
+    WOLFSSL_LEAVE("wolfSSL_SetSessionCacheSize", WOLFSSL_SUCCESS);
+
+    return WOLFSSL_SUCCESS;
+}
+
+/* number of sessions the cache holds, or will once wolfSSL_Init() runs */
+word32 wolfSSL_GetSessionCacheSize(void)
+{
+    return SESSIONS_PER_ROW * SESSION_CACHE_ROWS;
+}
+
+#if defined(WOLFSSL_SHARED_SESSION_CACHE) && defined(HAVE_SESSION_TICKET)
+/* number of session tickets this process didn't keep in the shared cache for
+ * being longer than SESSION_TICKET_LEN, their sessions are still cached */
+word32 wolfSSL_GetSessionCacheDroppedTickets(void)
+{
+    word32 dropped = 0;
+
+    if (wc_LockMutex(&session_mutex) == 0) {
+        dropped = SessionTicketsDropped;
+        wc_UnLockMutex(&session_mutex);
+    }
+
+    return dropped;
+}
+#endif
+#endif /* WOLFSSL_DYNAMIC_SESSION_CACHE && !NO_SESSION_CACHE */
+
+
 
 #ifndef NO_CERTS
 
@@ -5432,6 +6916,9 @@ int ProcessBuffer(WOLFSSL_CTX* ctx, const unsigned char* buff,
         else if (ctx) {
             FreeDer(&ctx->privateKey);
             ctx->privateKey = der;
+        #ifdef WOLFSSL_CTX_RSA_KEY
+            FreeCtxRsaKey(ctx);
+        #endif
         }
     }
     else {
@@ -6387,6 +7874,109 @@ int wolfSSL_CertManagerSetOCSP_Cb(WOLFSSL_CERT_MANAGER* cm,
 }
 
 
+/* Refresh cached OCSP statuses, including stapled responses, whose
+ * nextUpdate is within margin seconds. */
+int wolfSSL_CertManagerRefreshOCSP(WOLFSSL_CERT_MANAGER* cm, long margin)
+{
+    int ret = 0;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerRefreshOCSP");
+    if (cm == NULL)
+        return BAD_FUNC_ARG;
+
+    if (cm->ocsp != NULL)
+        ret = RefreshOCSP(cm->ocsp, margin);
+#if !defined(NO_WOLFSSL_SERVER) && (defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
+                               ||  defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2))
+    if (ret >= 0 && cm->ocsp_stapling != NULL)
+        ret = RefreshOCSP(cm->ocsp_stapling, margin);
+#endif
+
+    return ret < 0 ? ret : WOLFSSL_SUCCESS;
+}
+
+
+static void AddOCSPStats(WOLFSSL_OCSP* ocsp, unsigned int* hits,
+                               unsigned int* misses, unsigned int* refreshes)
+{
+    if (ocsp == NULL || wc_LockMutex(&ocsp->ocspLock) != 0)
+        return;
+
+    *hits      += ocsp->hits;
+    *misses    += ocsp->misses;
+    *refreshes += ocsp->refreshes;
+
+    wc_UnLockMutex(&ocsp->ocspLock);
+}
+
+
+/* Get OCSP cache hit, miss and refresh counts. Any count may be NULL. */
+int wolfSSL_CertManagerGetOCSPStats(WOLFSSL_CERT_MANAGER* cm,
+              unsigned int* hits, unsigned int* misses, unsigned int* refreshes)
+{
+    unsigned int h = 0, m = 0, r = 0;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerGetOCSPStats");
+    if (cm == NULL)
+        return BAD_FUNC_ARG;
+
+    AddOCSPStats(cm->ocsp, &h, &m, &r);
+#if !defined(NO_WOLFSSL_SERVER) && (defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
+                               ||  defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2))
+    AddOCSPStats(cm->ocsp_stapling, &h, &m, &r);
+#endif
+
+    if (hits)
+        *hits = h;
+    if (misses)
+        *misses = m;
+    if (refreshes)
+        *refreshes = r;
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+#ifdef HAVE_OCSP_REFRESH
+/* Refresh statuses in the background every interval seconds */
+int wolfSSL_CertManagerStartOCSPRefresh(WOLFSSL_CERT_MANAGER* cm,
+                                                      int interval, long margin)
+{
+    int ret = 0;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerStartOCSPRefresh");
+    if (cm == NULL || interval <= 0)
+        return BAD_FUNC_ARG;
+
+    if (cm->ocsp != NULL)
+        ret = StartOCSPRefresh(cm->ocsp, interval, margin);
+#if !defined(NO_WOLFSSL_SERVER) && (defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
+                               ||  defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2))
+    if (ret == 0 && cm->ocsp_stapling != NULL)
+        ret = StartOCSPRefresh(cm->ocsp_stapling, interval, margin);
+#endif
+
+    return ret == 0 ? WOLFSSL_SUCCESS : ret;
+}
+
+
+int wolfSSL_CertManagerStopOCSPRefresh(WOLFSSL_CERT_MANAGER* cm)
+{
+    WOLFSSL_ENTER("wolfSSL_CertManagerStopOCSPRefresh");
+    if (cm == NULL)
+        return BAD_FUNC_ARG;
+
+    StopOCSPRefresh(cm->ocsp);
+#if !defined(NO_WOLFSSL_SERVER) && (defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
+                               ||  defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2))
+    StopOCSPRefresh(cm->ocsp_stapling);
+#endif
+
+    return WOLFSSL_SUCCESS;
+}
+#endif /* HAVE_OCSP_REFRESH */
+
+
 int wolfSSL_EnableOCSP(WOLFSSL* ssl, int options)
 {
     WOLFSSL_ENTER("wolfSSL_EnableOCSP");
@@ -6618,6 +8208,313 @@ int ProcessFile(WOLFSSL_CTX* ctx, const char* fname, int format, int type,
 }
 
 /* loads file then loads each file in path, no c_rehash */
+#ifdef WOLFSSL_PARALLEL_CA_LOAD
+/* A file of a CA directory, decoded by a load worker */
+typedef struct CaLoadFile {
+    char*    name;
+    Signer*  signers;       /* decoded CAs in file order, linked by next */
+    int      ret;           /* ProcessFile style result for the file */
+} CaLoadFile;
+
+typedef struct CaLoad {
+    WOLFSSL_CTX*  ctx;
+    CaLoadFile*   files;
+    word32        count;
+    word32        next;     /* next file for a worker to take */
+    int           verify;
+    wolfSSL_Mutex lock;
+} CaLoad;
+
+
+/* Decode the CAs of a PEM file the way ProcessFile and ProcessChainBuffer do
+   for CA_TYPE, keeping the signers instead of adding them to the table */
+static int DecodeCAFile(WOLFSSL_CTX* ctx, CaLoadFile* file, int verify)
+{
+    XFILE        fp;
+    byte*        buff;
+    long         sz;
+    long         used = 0;
+    int          ret = 0;
+    int          gotOne = 0;
+    Signer**     tail = &file->signers;
+    DecodedCert* cert;
+
+    fp = XFOPEN(file->name, "rb");
+    if (fp == XBADFILE)
+        return WOLFSSL_BAD_FILE;
+    if (XFSEEK(fp, 0, XSEEK_END) != 0) {
+        XFCLOSE(fp);
+        return WOLFSSL_BAD_FILE;
+    }
+    sz = XFTELL(fp);
+    XREWIND(fp);
+    if (sz > MAX_WOLFSSL_FILE_SIZE || sz <= 0) {
+        WOLFSSL_MSG("DecodeCAFile file size error");
+        XFCLOSE(fp);
+        return WOLFSSL_BAD_FILE;
+    }
+
+    buff = (byte*)XMALLOC(sz, ctx->heap, DYNAMIC_TYPE_FILE);
+    if (buff == NULL) {
+        XFCLOSE(fp);
+        return WOLFSSL_BAD_FILE;
+    }
+    if ((long)XFREAD(buff, 1, sz, fp) != sz) {
+        XFCLOSE(fp);
+        XFREE(buff, ctx->heap, DYNAMIC_TYPE_FILE);
+        return WOLFSSL_BAD_FILE;
+    }
+    XFCLOSE(fp);
+
+    cert = (DecodedCert*)XMALLOC(sizeof(DecodedCert), ctx->heap,
+                                 DYNAMIC_TYPE_DCERT);
+    if (cert == NULL) {
+        XFREE(buff, ctx->heap, DYNAMIC_TYPE_FILE);
+        return MEMORY_E;
+    }
+
+    while (used < sz) {
+        DerBuffer*    der = NULL;
+        EncryptedInfo info;
+        Signer*       signer = NULL;
+
+        XMEMSET(&info, 0, sizeof(info));
+        ret = PemToDer(buff + used, sz - used, CA_TYPE, &der, ctx->heap,
+                       &info, NULL);
+        if (ret == 0) {
+            InitDecodedCert(cert, der->buffer, der->length, ctx->cm->heap);
+            ret = MakeCASigner(ctx->cm, cert, WOLFSSL_USER_CA, verify,
+                               &signer);
+            FreeDecodedCert(cert);
+        }
+        FreeDer(&der);
+
+        if (ret < 0) {
+            if (info.consumed > 0) { /* Made progress in file */
+                WOLFSSL_ERROR(ret);
+                WOLFSSL_MSG("CA Parse failed, with progress in file.");
+            }
+            else {
+                WOLFSSL_MSG("CA Parse failed, no progress in file.");
+                break;
+            }
+        }
+        else {
+            gotOne = 1;
+            if (signer != NULL) {
+                *tail = signer;
+                tail = &signer->next;
+            }
+        }
+        used += info.consumed;
+    }
+
+    XFREE(cert, ctx->heap, DYNAMIC_TYPE_DCERT);
+    XFREE(buff, ctx->heap, DYNAMIC_TYPE_FILE);
+
+    return gotOne ? WOLFSSL_SUCCESS : ret;
+}
+
+
+/* Take files off the load until all are decoded */
+static void* CaLoadWorker(void* args)
+{
+    CaLoad* load = (CaLoad*)args;
+    word32  i;
+
+    for (;;) {
+        if (wc_LockMutex(&load->lock) != 0)
+            break;
+        i = load->next++;
+        wc_UnLockMutex(&load->lock);
+        if (i >= load->count)
+            break;
+
+        load->files[i].ret = DecodeCAFile(load->ctx, &load->files[i],
+                                          load->verify);
+    }
+
+    return NULL;
+}
+
+
+/* Add the signers of all decoded files taking the CA write lock once. The
+   first file with a CA wins, like loading the files in order. */
+static int AddCALoadSigners(WOLFSSL_CERT_MANAGER* cm, CaLoad* load)
+{
+    Signer* signer;
+    Signer* next;
+    word32  i;
+    int     ret = 0;
+
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0) {
+        WOLFSSL_MSG("\tCA Mutex Lock failed");
+        ret = BAD_MUTEX_E;
+    }
+
+    for (i = 0; i < load->count; i++) {
+        for (signer = load->files[i].signers; signer != NULL; signer = next) {
+            next = signer->next;
+        #ifndef NO_SKID
+            if (ret == 0 && !FindSigner(cm, signer->subjectKeyIdHash))
+        #else
+            if (ret == 0 && !FindSigner(cm, signer->subjectNameHash))
+        #endif
+                (void)AddSignerToTable(cm, signer);   /* takes ownership */
+            else
+                FreeSigner(signer, cm->heap);
+        }
+        load->files[i].signers = NULL;
+        if (ret != 0)
+            load->files[i].ret = ret;
+    }
+
+    if (ret == 0)
+        wc_UnLockRwLock(&cm->caLock);
+
+    return ret;
+}
+
+
+/* Decode each regular file in path on ctx->caLoadThreads threads, then add
+   the CAs in one pass. Counts successes and failures with flags like the
+   serial loop, *pRet gets the last file's result. Returns the directory
+   read result, WC_READDIR_NOFILE when all files were read. */
+static int LoadCADirParallel(WOLFSSL_CTX* ctx, ReadDirCtx* readCtx,
+    const char* path, word32 flags, int verify, int* pRet, int* successCount,
+    int* failCount)
+{
+    CaLoad     load;
+    pthread_t* threads = NULL;
+    word32     filesSz = 0;
+    word32     nameSz;
+    word32     i;
+    int        started = 0;
+    int        fileRet;
+    char*      name = NULL;
+
+    XMEMSET(&load, 0, sizeof(load));
+    load.ctx = ctx;
+    load.verify = verify;
+
+    /* collect the file names first, readdir isn't shared with workers */
+    fileRet = wc_ReadDirFirst(readCtx, path, &name);
+    while (fileRet == 0 && name) {
+        if (load.count == filesSz) {
+            word32      newSz = filesSz ? filesSz * 2 : 64;
+            CaLoadFile* files = (CaLoadFile*)XREALLOC(load.files,
+                         newSz * sizeof(CaLoadFile), ctx->heap,
+                         DYNAMIC_TYPE_TMP_BUFFER);
+            if (files == NULL) {
+                fileRet = MEMORY_E;
+                break;
+            }
+            load.files = files;
+            filesSz = newSz;
+        }
+        nameSz = (word32)XSTRLEN(name) + 1;
+        load.files[load.count].name = (char*)XMALLOC(nameSz, ctx->heap,
+                                                     DYNAMIC_TYPE_TMP_BUFFER);
+        if (load.files[load.count].name == NULL) {
+            fileRet = MEMORY_E;
+            break;
+        }
+        XMEMCPY(load.files[load.count].name, name, nameSz);
+        load.files[load.count].signers = NULL;
+        load.files[load.count].ret = BAD_MUTEX_E; /* if no worker takes it */
+        load.count++;
+        fileRet = wc_ReadDirNext(readCtx, path, &name);
+    }
+    wc_ReadDirClose(readCtx);
+
+    if (fileRet == WC_READDIR_NOFILE && load.count > 0) {
+        if (wc_InitMutex(&load.lock) != 0) {
+            fileRet = BAD_MUTEX_E;
+        }
+        else {
+            int threadCnt = ctx->caLoadThreads - 1; /* caller works too */
+
+            if (threadCnt > (int)load.count - 1)
+                threadCnt = (int)load.count - 1;
+            if (threadCnt > 0)
+                threads = (pthread_t*)XMALLOC(threadCnt * sizeof(pthread_t),
+                                          ctx->heap, DYNAMIC_TYPE_TMP_BUFFER);
+            for (; threads != NULL && started < threadCnt; started++) {
+                if (pthread_create(&threads[started], NULL, CaLoadWorker,
+                                   &load) != 0) {
+                    WOLFSSL_MSG("CA load thread create failed");
+                    break;
+                }
+            }
+            (void)CaLoadWorker(&load);
+            for (i = 0; i < (word32)started; i++)
+                pthread_join(threads[i], NULL);
+            XFREE(threads, ctx->heap, DYNAMIC_TYPE_TMP_BUFFER);
+            wc_FreeMutex(&load.lock);
+
+            (void)AddCALoadSigners(ctx->cm, &load);
+        }
+    }
+
+    for (i = 0; i < load.count; i++) {
+        CaLoadFile* file = &load.files[i];
+        Signer*     signer;
+
+        /* left over on errors */
+        while ((signer = file->signers) != NULL) {
+            file->signers = signer->next;
+            FreeSigner(signer, ctx->cm->heap);
+        }
+
+        if (fileRet == WC_READDIR_NOFILE) {
+            WOLFSSL_MSG(file->name); /* log file name */
+            *pRet = file->ret;
+            if (*pRet != WOLFSSL_SUCCESS) {
+                /* same flags handling as the serial loop */
+                if ( (flags & WOLFSSL_LOAD_FLAG_IGNORE_ERR) ||
+                    ((flags & WOLFSSL_LOAD_FLAG_PEM_CA_ONLY) &&
+                       (*pRet == ASN_NO_PEM_HEADER))) {
+                    *pRet = WOLFSSL_SUCCESS;
+                }
+                else {
+                    WOLFSSL_ERROR(*pRet);
+                    WOLFSSL_MSG("Load CA file failed, continuing");
+                    (*failCount)++;
+                }
+            }
+            else {
+                (*successCount)++;
+            }
+        }
+        XFREE(file->name, ctx->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+    XFREE(load.files, ctx->heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return fileRet;
+}
+#endif /* WOLFSSL_PARALLEL_CA_LOAD */
+
+
+/* Set the number of threads decoding CA files when loading a directory with
+   wolfSSL_CTX_load_verify_locations, 1 loads the files one at a time.
+   Returns NOT_COMPILED_IN when parallel loading isn't built, see internal.h */
+int wolfSSL_CTX_SetLoadVerifyThreads(WOLFSSL_CTX* ctx, int threads)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_SetLoadVerifyThreads");
+
+    if (ctx == NULL || threads < 1 || threads > 0xFFFF)
+        return BAD_FUNC_ARG;
+
+#ifdef WOLFSSL_PARALLEL_CA_LOAD
+    ctx->caLoadThreads = (word16)threads;
+
+    return WOLFSSL_SUCCESS;
+#else
+    return NOT_COMPILED_IN;
+#endif
+}
+
+
 int wolfSSL_CTX_load_verify_locations_ex(WOLFSSL_CTX* ctx, const char* file,
                                      const char* path, word32 flags)
 {
@@ -6661,6 +8558,13 @@ int wolfSSL_CTX_load_verify_locations_ex(WOLFSSL_CTX* ctx, const char* file,
         ReadDirCtx readCtx[1];
     #endif
 
+    #ifdef WOLFSSL_PARALLEL_CA_LOAD
+        /* the cache callback wants each CA as it is added */
+        if (ctx->caLoadThreads > 1 && ctx->cm->caCacheCallback == NULL)
+            fileRet = LoadCADirParallel(ctx, readCtx, path, flags, verify,
+                                        &ret, &successCount, &failCount);
+        else
+    #endif
         /* try to load each regular file in path */
         fileRet = wc_ReadDirFirst(readCtx, path, &name);
         while (fileRet == 0 && name) {
@@ -10114,6 +12018,75 @@ int wolfSSL_CTX_get_cert_cache_memsize(WOLFSSL_CTX* ctx)
     return CM_GetCertCacheMemSize(ctx->cm);
 }
 
+
+#ifdef WOLFSSL_CA_SNAPSHOT
+
+#if !defined(NO_FILESYSTEM)
+
+/* Save a read-only CA snapshot to file, an existing file is replaced by
+   rename so processes that have it mapped keep reading the old snapshot */
+int wolfSSL_CTX_save_ca_snapshot(WOLFSSL_CTX* ctx, const char* fname)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_save_ca_snapshot");
+
+    if (ctx == NULL || fname == NULL)
+        return BAD_FUNC_ARG;
+
+    return CM_SaveCASnapshot(ctx->cm, fname);
+}
+
+
+/* Map a CA snapshot file read-only and use it as the CA table */
+int wolfSSL_CTX_map_ca_snapshot(WOLFSSL_CTX* ctx, const char* fname)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_map_ca_snapshot");
+
+    if (ctx == NULL || fname == NULL)
+        return BAD_FUNC_ARG;
+
+    return CM_MapCASnapshot(ctx->cm, fname);
+}
+
+#endif /* NO_FILESYSTEM */
+
+/* Save a read-only CA snapshot to memory */
+int wolfSSL_CTX_memsave_ca_snapshot(WOLFSSL_CTX* ctx, void* mem,
+                                    int sz, int* used)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_memsave_ca_snapshot");
+
+    if (ctx == NULL || mem == NULL || used == NULL || sz <= 0)
+        return BAD_FUNC_ARG;
+
+    return CM_MemSaveCASnapshot(ctx->cm, mem, sz, used);
+}
+
+
+/* Use the CA snapshot in mem as the CA table, mem is read in place so must
+   stay valid until the CAs are unloaded or ctx is freed */
+int wolfSSL_CTX_use_ca_snapshot(WOLFSSL_CTX* ctx, const void* mem, int sz)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_use_ca_snapshot");
+
+    if (ctx == NULL || mem == NULL || sz <= 0)
+        return BAD_FUNC_ARG;
+
+    return CM_UseCASnapshot(ctx->cm, mem, sz);
+}
+
+
+/* get how big the CA snapshot save buffer needs to be */
+int wolfSSL_CTX_get_ca_snapshot_memsize(WOLFSSL_CTX* ctx)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_get_ca_snapshot_memsize");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    return CM_GetCASnapshotMemSize(ctx->cm);
+}
+
+#endif /* WOLFSSL_CA_SNAPSHOT */
 #endif /* PERSIST_CERT_CACHE */
 #endif /* !NO_CERTS */
 
@@ -10213,10 +12186,10 @@ typedef struct {
 /* get how big the the session cache save buffer needs to be */
 int wolfSSL_get_session_cache_memsize(void)
 {
-    int sz  = (int)(sizeof(SessionCache) + sizeof(cache_header_t));
+    int sz  = (int)(SESSION_CACHE_SZ + sizeof(cache_header_t));
 
     #ifndef NO_CLIENT_CACHE
-        sz += (int)(sizeof(ClientCache));
+        sz += (int)(CLIENT_CACHE_SZ);
     #endif
 
     return sz;
@@ -10241,12 +12214,12 @@ int wolfSSL_memsave_session_cache(void* mem, int sz)
     }
 
     cache_header.version   = WOLFSSL_CACHE_VERSION;
-    cache_header.rows      = SESSION_ROWS;
+    cache_header.rows      = (int)SESSION_CACHE_ROWS;
     cache_header.columns   = SESSIONS_PER_ROW;
     cache_header.sessionSz = (int)sizeof(WOLFSSL_SESSION);
     XMEMCPY(mem, &cache_header, sizeof(cache_header));
 
-    if (wc_LockMutex(&session_mutex) != 0) {
+    if (LockSessionCache() != 0) {
         WOLFSSL_MSG("Session cache mutex lock failed");
         return BAD_MUTEX_E;
     }
@@ -10260,7 +12233,7 @@ int wolfSSL_memsave_session_cache(void* mem, int sz)
         XMEMCPY(clRow++, ClientCache + i, sizeof(ClientRow));
 #endif
 
-    wc_UnLockMutex(&session_mutex);
+    UnLockSessionCache();
 
     WOLFSSL_LEAVE("wolfSSL_memsave_session_cache", WOLFSSL_SUCCESS);
 
@@ -10287,7 +12260,7 @@ int wolfSSL_memrestore_session_cache(const void* mem, int sz)
 
     XMEMCPY(&cache_header, mem, sizeof(cache_header));
     if (cache_header.version   != WOLFSSL_CACHE_VERSION ||
-        cache_header.rows      != SESSION_ROWS ||
+        cache_header.rows      != (int)SESSION_CACHE_ROWS ||
         cache_header.columns   != SESSIONS_PER_ROW ||
         cache_header.sessionSz != (int)sizeof(WOLFSSL_SESSION)) {
 
@@ -10295,7 +12268,7 @@ int wolfSSL_memrestore_session_cache(const void* mem, int sz)
         return CACHE_MATCH_ERROR;
     }
 
-    if (wc_LockMutex(&session_mutex) != 0) {
+    if (LockSessionCache() != 0) {
         WOLFSSL_MSG("Session cache mutex lock failed");
         return BAD_MUTEX_E;
     }
@@ -10308,8 +12281,11 @@ int wolfSSL_memrestore_session_cache(const void* mem, int sz)
     for (i = 0; i < cache_header.rows; ++i)
         XMEMCPY(ClientCache + i, clRow++, sizeof(ClientRow));
 #endif
+#ifdef HAVE_EXT_CACHE
+    ClearSessionCacheOwners();
+#endif
 
-    wc_UnLockMutex(&session_mutex);
+    UnLockSessionCache();
 
     WOLFSSL_LEAVE("wolfSSL_memrestore_session_cache", WOLFSSL_SUCCESS);
 
@@ -10336,7 +12312,7 @@ int wolfSSL_save_session_cache(const char *fname)
         return WOLFSSL_BAD_FILE;
     }
     cache_header.version   = WOLFSSL_CACHE_VERSION;
-    cache_header.rows      = SESSION_ROWS;
+    cache_header.rows      = (int)SESSION_CACHE_ROWS;
     cache_header.columns   = SESSIONS_PER_ROW;
     cache_header.sessionSz = (int)sizeof(WOLFSSL_SESSION);
 
@@ -10348,7 +12324,7 @@ int wolfSSL_save_session_cache(const char *fname)
         return FWRITE_ERROR;
     }
 
-    if (wc_LockMutex(&session_mutex) != 0) {
+    if (LockSessionCache() != 0) {
         WOLFSSL_MSG("Session cache mutex lock failed");
         XFCLOSE(file);
         return BAD_MUTEX_E;
@@ -10376,7 +12352,7 @@ int wolfSSL_save_session_cache(const char *fname)
     }
 #endif /* NO_CLIENT_CACHE */
 
-    wc_UnLockMutex(&session_mutex);
+    UnLockSessionCache();
 
     XFCLOSE(file);
     WOLFSSL_LEAVE("wolfSSL_save_session_cache", rc);
@@ -10410,7 +12386,7 @@ int wolfSSL_restore_session_cache(const char *fname)
         return FREAD_ERROR;
     }
     if (cache_header.version   != WOLFSSL_CACHE_VERSION ||
-        cache_header.rows      != SESSION_ROWS ||
+        cache_header.rows      != (int)SESSION_CACHE_ROWS ||
         cache_header.columns   != SESSIONS_PER_ROW ||
         cache_header.sessionSz != (int)sizeof(WOLFSSL_SESSION)) {
 
@@ -10419,7 +12395,7 @@ int wolfSSL_restore_session_cache(const char *fname)
         return CACHE_MATCH_ERROR;
     }
 
-    if (wc_LockMutex(&session_mutex) != 0) {
+    if (LockSessionCache() != 0) {
         WOLFSSL_MSG("Session cache mutex lock failed");
         XFCLOSE(file);
         return BAD_MUTEX_E;
@@ -10430,7 +12406,7 @@ int wolfSSL_restore_session_cache(const char *fname)
         ret = (int)XFREAD(SessionCache + i, sizeof(SessionRow), 1, file);
         if (ret != 1) {
             WOLFSSL_MSG("Session cache member file read failed");
-            XMEMSET(SessionCache, 0, sizeof SessionCache);
+            XMEMSET(SessionCache, 0, SESSION_CACHE_SZ);
             rc = FREAD_ERROR;
             break;
         }
@@ -10442,15 +12418,18 @@ int wolfSSL_restore_session_cache(const char *fname)
         ret = (int)XFREAD(ClientCache + i, sizeof(ClientRow), 1, file);
         if (ret != 1) {
             WOLFSSL_MSG("Client cache member file read failed");
-            XMEMSET(ClientCache, 0, sizeof ClientCache);
+            XMEMSET(ClientCache, 0, CLIENT_CACHE_SZ);
             rc = FREAD_ERROR;
             break;
         }
     }
 
 #endif /* NO_CLIENT_CACHE */
+#ifdef HAVE_EXT_CACHE
+    ClearSessionCacheOwners();
+#endif
 
-    wc_UnLockMutex(&session_mutex);
+    UnLockSessionCache();
 
     XFCLOSE(file);
     WOLFSSL_LEAVE("wolfSSL_restore_session_cache", rc);
@@ -10525,19 +12504,19 @@ long wolfSSL_CTX_set_session_cache_mode(WOLFSSL_CTX* ctx, long mode)
 #if defined(PERSIST_CERT_CACHE)
 
 
-#define WOLFSSL_CACHE_CERT_VERSION 1
+#define WOLFSSL_CACHE_CERT_VERSION 2
 
 typedef struct {
     int version;                 /* cache cert layout version id */
-    int rows;                    /* hash table rows, CA_TABLE_SIZE */
-    int columns[CA_TABLE_SIZE];  /* columns per row on list */
+    int signers;                 /* number of signers that follow */
     int signerSz;                /* sizeof Signer object */
 } CertCacheHeader;
 
 /* current cert persistence layout is:
 
    1) CertCacheHeader
-   2) caTable
+   2) caTable signers, rehashed into the table on restore since the number
+      of rows depends on how many signers the table has held
 
    update WOLFSSL_CERT_CACHE_VERSION if change layout for the following
    PERSIST_CERT_CACHE functions
@@ -10579,46 +12558,27 @@ static WC_INLINE int GetCertCacheRowMemory(Signer* row)
 /* get the size of persist cert cache, have lock */
 static WC_INLINE int GetCertCacheMemSize(WOLFSSL_CERT_MANAGER* cm)
 {
-    int sz;
-    int i;
+    int    sz;
+    word32 i;
 
     sz = sizeof(CertCacheHeader);
 
-    for (i = 0; i < CA_TABLE_SIZE; i++)
+    for (i = 0; i < cm->caTableSz; i++)
         sz += GetCertCacheRowMemory(cm->caTable[i]);
 
     return sz;
 }
 
 
-/* Store cert cache header columns with number of items per list, have lock */
-static WC_INLINE void SetCertHeaderColumns(WOLFSSL_CERT_MANAGER* cm, int* columns)
-{
-    int     i;
-    Signer* row;
-
-    for (i = 0; i < CA_TABLE_SIZE; i++) {
-        int count = 0;
-        row = cm->caTable[i];
-
-        while (row) {
-            ++count;
-            row = row->next;
-        }
-        columns[i] = count;
-    }
-}
-
-
-/* Restore whole cert row from memory, have lock, return bytes consumed,
-   < 0 on error, have lock */
-static WC_INLINE int RestoreCertRow(WOLFSSL_CERT_MANAGER* cm, byte* current,
-                                 int row, int listSz, const byte* end)
+/* Restore list of listSz signers from memory, have lock, return bytes
+   consumed, < 0 on error, have lock */
+static WC_INLINE int RestoreCertList(WOLFSSL_CERT_MANAGER* cm, byte* current,
+                                     int listSz, const byte* end)
 {
     int idx = 0;
 
     if (listSz < 0) {
-        WOLFSSL_MSG("Row header corrupted, negative value");
+        WOLFSSL_MSG("Cache header corrupted, negative value");
         return PARSE_ERROR;
     }
 
@@ -10695,8 +12655,7 @@ static WC_INLINE int RestoreCertRow(WOLFSSL_CERT_MANAGER* cm, byte* current,
             idx += SIGNER_DIGEST_SIZE;
         #endif
 
-        signer->next = cm->caTable[row];
-        cm->caTable[row] = signer;
+        AddSignerToTable(cm, signer);
 
         --listSz;
     }
@@ -10706,7 +12665,8 @@ static WC_INLINE int RestoreCertRow(WOLFSSL_CERT_MANAGER* cm, byte* current,
 
 
 /* Store whole cert row into memory, have lock, return bytes added */
-static WC_INLINE int StoreCertRow(WOLFSSL_CERT_MANAGER* cm, byte* current, int row)
+static WC_INLINE int StoreCertRow(WOLFSSL_CERT_MANAGER* cm, byte* current,
+                                  word32 row)
 {
     int     added  = 0;
     Signer* list   = cm->caTable[row];
@@ -10746,9 +12706,9 @@ static WC_INLINE int StoreCertRow(WOLFSSL_CERT_MANAGER* cm, byte* current, int r
 static WC_INLINE int DoMemSaveCertCache(WOLFSSL_CERT_MANAGER* cm,
                                      void* mem, int sz)
 {
-    int realSz;
-    int ret = WOLFSSL_SUCCESS;
-    int i;
+    int    realSz;
+    int    ret = WOLFSSL_SUCCESS;
+    word32 i;
 
     WOLFSSL_ENTER("DoMemSaveCertCache");
 
@@ -10762,14 +12722,13 @@ static WC_INLINE int DoMemSaveCertCache(WOLFSSL_CERT_MANAGER* cm,
         CertCacheHeader hdr;
 
         hdr.version  = WOLFSSL_CACHE_CERT_VERSION;
-        hdr.rows     = CA_TABLE_SIZE;
-        SetCertHeaderColumns(cm, hdr.columns);
+        hdr.signers  = (int)cm->caCount;
         hdr.signerSz = (int)sizeof(Signer);
 
         XMEMCPY(mem, &hdr, sizeof(CertCacheHeader));
         current = (byte*)mem + sizeof(CertCacheHeader);
 
-        for (i = 0; i < CA_TABLE_SIZE; ++i)
+        for (i = 0; i < cm->caTableSz; ++i)
             current += StoreCertRow(cm, current, i);
     }
 
@@ -10795,8 +12754,8 @@ int CM_SaveCertCache(WOLFSSL_CERT_MANAGER* cm, const char* fname)
        return WOLFSSL_BAD_FILE;
     }
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex on caLock failed");
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Rd on caLock failed");
         XFCLOSE(file);
         return BAD_MUTEX_E;
     }
@@ -10818,7 +12777,7 @@ int CM_SaveCertCache(WOLFSSL_CERT_MANAGER* cm, const char* fname)
         XFREE(mem, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
     }
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
     XFCLOSE(file);
 
     return rc;
@@ -10889,8 +12848,8 @@ int CM_MemSaveCertCache(WOLFSSL_CERT_MANAGER* cm, void* mem, int sz, int* used)
 
     WOLFSSL_ENTER("CM_MemSaveCertCache");
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex on caLock failed");
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Rd on caLock failed");
         return BAD_MUTEX_E;
     }
 
@@ -10898,7 +12857,7 @@ int CM_MemSaveCertCache(WOLFSSL_CERT_MANAGER* cm, void* mem, int sz, int* used)
     if (ret == WOLFSSL_SUCCESS)
         *used  = GetCertCacheMemSize(cm);
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     return ret;
 }
@@ -10908,7 +12867,6 @@ int CM_MemSaveCertCache(WOLFSSL_CERT_MANAGER* cm, void* mem, int sz, int* used)
 int CM_MemRestoreCertCache(WOLFSSL_CERT_MANAGER* cm, const void* mem, int sz)
 {
     int ret = WOLFSSL_SUCCESS;
-    int i;
     CertCacheHeader* hdr = (CertCacheHeader*)mem;
     byte*            current = (byte*)mem + sizeof(CertCacheHeader);
     byte*            end     = (byte*)mem + sz;  /* don't go over */
@@ -10921,31 +12879,28 @@ int CM_MemRestoreCertCache(WOLFSSL_CERT_MANAGER* cm, const void* mem, int sz)
     }
 
     if (hdr->version  != WOLFSSL_CACHE_CERT_VERSION ||
-        hdr->rows     != CA_TABLE_SIZE ||
         hdr->signerSz != (int)sizeof(Signer)) {
 
         WOLFSSL_MSG("Cert Cache Memory header mismatch");
         return CACHE_MATCH_ERROR;
     }
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex on caLock failed");
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Wr on caLock failed");
         return BAD_MUTEX_E;
     }
 
-    FreeSignerTable(cm->caTable, CA_TABLE_SIZE, cm->heap);
+    FreeCATables(cm);
 
-    for (i = 0; i < CA_TABLE_SIZE; ++i) {
-        int added = RestoreCertRow(cm, current, i, hdr->columns[i], end);
-        if (added < 0) {
-            WOLFSSL_MSG("RestoreCertRow error");
-            ret = added;
-            break;
-        }
-        current += added;
+    ret = RestoreCertList(cm, current, hdr->signers, end);
+    if (ret < 0) {
+        WOLFSSL_MSG("RestoreCertList error");
+    }
+    else {
+        ret = WOLFSSL_SUCCESS;
     }
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     return ret;
 }
@@ -10958,18 +12913,584 @@ int CM_GetCertCacheMemSize(WOLFSSL_CERT_MANAGER* cm)
 
     WOLFSSL_ENTER("CM_GetCertCacheMemSize");
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex on caLock failed");
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Rd on caLock failed");
         return BAD_MUTEX_E;
     }
 
     sz = GetCertCacheMemSize(cm);
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     return sz;
 }
 
+
+#ifdef WOLFSSL_CA_SNAPSHOT
+
+/* get how much snapshot data space signer needs, have lock */
+static word32 GetSnapshotDataSz(Signer* signer)
+{
+    word32 sz;
+
+    sz  = CA_SNAPSHOT_ALIGN(signer->pubKeySize);
+    sz += CA_SNAPSHOT_ALIGN((word32)signer->nameLen);
+#ifndef IGNORE_NAME_CONSTRAINTS
+    {
+        Base_entry* entry;
+
+        for (entry = signer->permittedNames; entry; entry = entry->next)
+            sz += sizeof(CASnapshotName) + CA_SNAPSHOT_ALIGN(entry->nameSz);
+        for (entry = signer->excludedNames; entry; entry = entry->next)
+            sz += sizeof(CASnapshotName) + CA_SNAPSHOT_ALIGN(entry->nameSz);
+    }
+#endif
+#ifdef WOLFSSL_SIGNER_DER_CERT
+    if (signer->derCert != NULL)
+        sz += CA_SNAPSHOT_ALIGN(signer->derCert->length);
+#endif
+
+    return sz;
+}
+
+
+/* get the hash rows for a snapshot of signers */
+static WC_INLINE word32 GetSnapshotRows(word32 signers)
+{
+    return signers / CA_TABLE_MAX_LOAD + 1;
+}
+
+
+/* get how big the CA snapshot needs to be, have lock */
+static int GetCASnapshotMemSize(WOLFSSL_CERT_MANAGER* cm)
+{
+    Signer* signer;
+    word32  sz;
+    word32  i;
+
+    sz  = sizeof(CASnapshotHeader);
+    sz += 2 * GetSnapshotRows(cm->caCount) * sizeof(word32);
+    sz += cm->caCount * sizeof(CASnapshotSigner);
+    for (i = 0; i < cm->caTableSz; i++) {
+        for (signer = cm->caTable[i]; signer; signer = signer->next)
+            sz += GetSnapshotDataSz(signer);
+    }
+
+    return (int)sz;
+}
+
+
+/* copy sz bytes of in to the snapshot at *off, returns where it went or 0 if
+   there was nothing to copy */
+static word32 StoreSnapshotData(byte* mem, word32* off, const void* in,
+                                word32 sz)
+{
+    word32 start = *off;
+
+    if (sz == 0)
+        return 0;
+
+    XMEMCPY(mem + start, in, sz);
+    *off += CA_SNAPSHOT_ALIGN(sz);
+
+    return start;
+}
+
+
+#ifndef IGNORE_NAME_CONSTRAINTS
+/* store a list of name constraints at *off, returns entries stored */
+static word32 StoreSnapshotNames(byte* mem, word32* off, Base_entry* entry,
+                                 byte excluded)
+{
+    CASnapshotName name;
+    word32 cnt = 0;
+
+    for (; entry; entry = entry->next) {
+        name.nameSz   = (word16)entry->nameSz;
+        name.type     = entry->type;
+        name.excluded = excluded;
+        XMEMCPY(mem + *off, &name, sizeof(CASnapshotName));
+        *off += sizeof(CASnapshotName);
+        (void)StoreSnapshotData(mem, off, entry->name, (word32)entry->nameSz);
+        cnt++;
+    }
+
+    return cnt;
+}
+#endif
+
+
+/* Write a CA snapshot of the CA table to mem, have lock */
+static int DoMemSaveCASnapshot(WOLFSSL_CERT_MANAGER* cm, void* mem, int sz)
+{
+    CASnapshotHeader hdr;
+    CASnapshotSigner rec;
+    Signer* signer;
+    byte*   out = (byte*)mem;
+    word32  realSz;
+    word32  dataOff;
+    word32  recOff;
+    word32  row;
+    word32  n = 0;
+    word32  i;
+
+    realSz = (word32)GetCASnapshotMemSize(cm);
+    if (realSz > (word32)sz) {
+        WOLFSSL_MSG("Mem output buffer too small");
+        return BUFFER_E;
+    }
+    XMEMSET(out, 0, realSz);
+
+    XMEMSET(&hdr, 0, sizeof(hdr));
+    hdr.magic       = WOLFSSL_CA_SNAPSHOT_MAGIC;
+    hdr.version     = WOLFSSL_CA_SNAPSHOT_VERSION;
+    hdr.totalSz     = realSz;
+    hdr.flags       = CA_SNAPSHOT_FLAGS;
+    hdr.signerSz    = sizeof(CASnapshotSigner);
+    hdr.digestSz    = SIGNER_DIGEST_SIZE;
+    hdr.keyIdSz     = KEYID_SIZE;
+    hdr.signers     = cm->caCount;
+    hdr.rows        = GetSnapshotRows(cm->caCount);
+    hdr.keyRowsOff  = sizeof(CASnapshotHeader);
+    hdr.nameRowsOff = hdr.keyRowsOff + hdr.rows * sizeof(word32);
+    hdr.signersOff  = hdr.nameRowsOff + hdr.rows * sizeof(word32);
+    dataOff = hdr.signersOff + hdr.signers * sizeof(CASnapshotSigner);
+
+    for (i = 0; i < cm->caTableSz; i++) {
+        for (signer = cm->caTable[i]; signer && n < hdr.signers;
+                                      signer = signer->next) {
+            recOff = hdr.signersOff + n * sizeof(CASnapshotSigner);
+
+            XMEMSET(&rec, 0, sizeof(rec));
+            rec.keyOID        = signer->keyOID;
+            rec.keyUsage      = signer->keyUsage;
+            rec.maxPathLen    = signer->maxPathLen;
+            rec.pathLength    = signer->pathLength;
+            rec.pathLengthSet = signer->pathLengthSet;
+            rec.selfSigned    = signer->selfSigned;
+            rec.pubKeySize    = signer->pubKeySize;
+            rec.pubKeyOff     = StoreSnapshotData(out, &dataOff,
+                                       signer->publicKey, signer->pubKeySize);
+            rec.nameLen       = (word32)signer->nameLen;
+            rec.nameOff       = StoreSnapshotData(out, &dataOff, signer->name,
+                                       (word32)signer->nameLen);
+        #ifndef IGNORE_NAME_CONSTRAINTS
+            rec.constraintsOff = dataOff;
+            rec.constraints  = StoreSnapshotNames(out, &dataOff,
+                                                  signer->permittedNames, 0);
+            rec.constraints += StoreSnapshotNames(out, &dataOff,
+                                                  signer->excludedNames, 1);
+            if (rec.constraints == 0)
+                rec.constraintsOff = 0;
+        #endif
+        #ifdef WOLFSSL_SIGNER_DER_CERT
+            if (signer->derCert != NULL) {
+                rec.derSz  = signer->derCert->length;
+                rec.derOff = StoreSnapshotData(out, &dataOff,
+                                       signer->derCert->buffer, rec.derSz);
+            }
+        #endif
+        #ifndef NO_SKID
+            XMEMCPY(rec.keyIdHash, signer->subjectKeyIdHash,
+                    SIGNER_DIGEST_SIZE);
+        #else
+            XMEMCPY(rec.keyIdHash, signer->subjectNameHash,
+                    SIGNER_DIGEST_SIZE);
+        #endif
+            XMEMCPY(rec.subjectNameHash, signer->subjectNameHash,
+                    SIGNER_DIGEST_SIZE);
+        #ifdef HAVE_OCSP
+            XMEMCPY(rec.subjectKeyHash, signer->subjectKeyHash, KEYID_SIZE);
+        #endif
+
+            /* push on the front of both rows */
+            row = hdr.keyRowsOff +
+                  HashSigner(rec.keyIdHash, hdr.rows) * sizeof(word32);
+            XMEMCPY(&rec.next, out + row, sizeof(word32));
+            XMEMCPY(out + row, &recOff, sizeof(word32));
+            row = hdr.nameRowsOff +
+                  HashSigner(rec.subjectNameHash, hdr.rows) * sizeof(word32);
+            XMEMCPY(&rec.nameNext, out + row, sizeof(word32));
+            XMEMCPY(out + row, &recOff, sizeof(word32));
+
+            XMEMCPY(out + recOff, &rec, sizeof(rec));
+            n++;
+        }
+    }
+
+    XMEMCPY(out, &hdr, sizeof(hdr));
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+/* Move all the attached snapshot signers into the CA table so it holds every
+   CA, have write lock */
+static int LoadSnapshotSigners(WOLFSSL_CERT_MANAGER* cm)
+{
+    const CASnapshotHeader* hdr = (const CASnapshotHeader*)cm->caSnap;
+    const CASnapshotSigner* rec;
+    Signer* signer;
+    word32  i;
+
+    if (hdr == NULL)
+        return 0;
+
+    for (i = 0; i < hdr->signers; i++) {
+        rec = SnapshotSignerAt(cm,
+                           hdr->signersOff + i * sizeof(CASnapshotSigner));
+        if (rec == NULL)
+            return BUFFER_E;
+        if (FindSigner(cm, rec->keyIdHash) != NULL)
+            continue;
+        signer = MakeSnapshotSigner(cm, rec);
+        if (signer == NULL)
+            return MEMORY_E;
+        (void)AddSignerToTable(cm, signer);
+    }
+
+    return 0;
+}
+
+
+/* Check the CA snapshot in mem was made by a matching build and its tables
+   fit in sz */
+static int CheckCASnapshot(const void* mem, word32 sz)
+{
+    const CASnapshotHeader* hdr = (const CASnapshotHeader*)mem;
+    word32 rowsSz;
+    word32 signersSz;
+
+    if (sz < sizeof(CASnapshotHeader)) {
+        WOLFSSL_MSG("CA snapshot too small");
+        return BUFFER_E;
+    }
+    if (((wolfssl_word)mem & 3) != 0) {
+        WOLFSSL_MSG("CA snapshot not 4 byte aligned");
+        return BAD_ALIGN_E;
+    }
+
+    if (hdr->magic    != WOLFSSL_CA_SNAPSHOT_MAGIC ||
+        hdr->version  != WOLFSSL_CA_SNAPSHOT_VERSION ||
+        hdr->signerSz != sizeof(CASnapshotSigner) ||
+        hdr->digestSz != SIGNER_DIGEST_SIZE ||
+        hdr->keyIdSz  != KEYID_SIZE ||
+        hdr->flags    != CA_SNAPSHOT_FLAGS) {
+        WOLFSSL_MSG("CA snapshot header mismatch");
+        return CACHE_MATCH_ERROR;
+    }
+
+    if (hdr->totalSz > sz || hdr->rows == 0 ||
+            hdr->rows > sz / sizeof(word32) ||
+            hdr->signers > sz / sizeof(CASnapshotSigner)) {
+        WOLFSSL_MSG("CA snapshot sizes bad");
+        return BUFFER_E;
+    }
+    rowsSz    = hdr->rows * sizeof(word32);
+    signersSz = hdr->signers * sizeof(CASnapshotSigner);
+    if ((hdr->keyRowsOff & 3) != 0 || (hdr->nameRowsOff & 3) != 0 ||
+            rowsSz > sz || hdr->keyRowsOff > sz - rowsSz ||
+            hdr->nameRowsOff > sz - rowsSz ||
+            signersSz > sz || hdr->signersOff > sz - signersSz) {
+        WOLFSSL_MSG("CA snapshot offsets bad");
+        return BUFFER_E;
+    }
+
+    return 0;
+}
+
+
+/* Use the CA snapshot in mem as the CA table in place of the loaded CAs,
+   owned snapshots are unmapped or freed on detach */
+static int AttachCASnapshot(WOLFSSL_CERT_MANAGER* cm, const void* mem,
+                            word32 sz, byte owned)
+{
+    int ret;
+
+    ret = CheckCASnapshot(mem, sz);
+    if (ret != 0)
+        return ret;
+
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Wr on caLock failed");
+        return BAD_MUTEX_E;
+    }
+
+    FreeCATables(cm);
+    cm->caSnap      = (const byte*)mem;
+    cm->caSnapSz    = sz;
+    cm->caSnapOwned = owned;
+
+    wc_UnLockRwLock(&cm->caLock);
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+#if !defined(NO_FILESYSTEM)
+
+#ifdef WOLFSSL_CA_SNAPSHOT_MMAP
+/* Write a CA snapshot file through a temp file in the same directory that is
+   renamed over fname once synced. Processes that have fname mapped keep the
+   old inode and its contents, later maps see the new snapshot */
+static int WriteCASnapshotFile(const char* fname, const byte* mem, int memSz,
+                               void* heap)
+{
+    int    rc = WOLFSSL_SUCCESS;
+    int    fd;
+    int    done = 0;
+    int    tmpSz;
+    char*  tmpName;
+
+    (void)heap;
+
+    tmpSz   = (int)XSTRLEN(fname) + 24;
+    tmpName = (char*)XMALLOC(tmpSz, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (tmpName == NULL)
+        return MEMORY_E;
+    XSNPRINTF(tmpName, tmpSz, "%s.%ld.tmp", fname, (long)getpid());
+
+    fd = open(tmpName, O_WRONLY | O_CREAT | O_EXCL, 0666);
+    if (fd < 0) {
+        WOLFSSL_MSG("Couldn't open CA snapshot temp file");
+        XFREE(tmpName, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        return WOLFSSL_BAD_FILE;
+    }
+
+    while (done < memSz) {
+        ssize_t ret = write(fd, mem + done, memSz - done);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0) {
+            WOLFSSL_MSG("CA snapshot file write failed");
+            rc = FWRITE_ERROR;
+            break;
+        }
+        done += (int)ret;
+    }
+    if (rc == WOLFSSL_SUCCESS && fsync(fd) != 0) {
+        WOLFSSL_MSG("CA snapshot file sync failed");
+        rc = FWRITE_ERROR;
+    }
+    if (close(fd) != 0 && rc == WOLFSSL_SUCCESS)
+        rc = FWRITE_ERROR;
+
+    if (rc == WOLFSSL_SUCCESS && rename(tmpName, fname) != 0) {
+        WOLFSSL_MSG("CA snapshot file rename failed");
+        rc = WOLFSSL_BAD_FILE;
+    }
+    if (rc != WOLFSSL_SUCCESS)
+        (void)unlink(tmpName);
+
+    XFREE(tmpName, heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return rc;
+}
+#else
+static int WriteCASnapshotFile(const char* fname, const byte* mem, int memSz,
+                               void* heap)
+{
+    XFILE file;
+    int   rc = WOLFSSL_SUCCESS;
+
+    (void)heap;
+
+    file = XFOPEN(fname, "w+b");
+    if (file == XBADFILE) {
+       WOLFSSL_MSG("Couldn't open CA snapshot save file");
+       return WOLFSSL_BAD_FILE;
+    }
+    if ((int)XFWRITE(mem, memSz, 1, file) != 1) {
+        WOLFSSL_MSG("CA snapshot file write failed");
+        rc = FWRITE_ERROR;
+    }
+    XFCLOSE(file);
+
+    return rc;
+}
+#endif /* WOLFSSL_CA_SNAPSHOT_MMAP */
+
+
+/* Save a CA snapshot to file, replacing any earlier snapshot atomically where
+   snapshots are mapped */
+int CM_SaveCASnapshot(WOLFSSL_CERT_MANAGER* cm, const char* fname)
+{
+    int   rc;
+    int   memSz = 0;
+    byte* mem   = NULL;
+
+    WOLFSSL_ENTER("CM_SaveCASnapshot");
+
+    /* write lock, attached snapshot signers are moved into the table */
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Wr on caLock failed");
+        return BAD_MUTEX_E;
+    }
+
+    rc = LoadSnapshotSigners(cm);
+    if (rc == 0) {
+        memSz = GetCASnapshotMemSize(cm);
+        mem   = (byte*)XMALLOC(memSz, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        if (mem == NULL) {
+            WOLFSSL_MSG("Alloc for tmp buffer failed");
+            rc = MEMORY_E;
+        }
+        else
+            rc = DoMemSaveCASnapshot(cm, mem, memSz);
+    }
+
+    wc_UnLockRwLock(&cm->caLock);
+
+    if (rc == WOLFSSL_SUCCESS)
+        rc = WriteCASnapshotFile(fname, mem, memSz, cm->heap);
+    if (mem != NULL)
+        XFREE(mem, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return rc;
+}
+
+
+/* Map a CA snapshot file read-only, processes mapping the same file share
+   its pages */
+int CM_MapCASnapshot(WOLFSSL_CERT_MANAGER* cm, const char* fname)
+{
+    int   rc;
+    void* mem;
+#ifdef WOLFSSL_CA_SNAPSHOT_MMAP
+    struct stat st;
+    int   fd;
+
+    WOLFSSL_ENTER("CM_MapCASnapshot");
+
+    fd = open(fname, O_RDONLY);
+    if (fd < 0) {
+        WOLFSSL_MSG("Couldn't open CA snapshot file");
+        return WOLFSSL_BAD_FILE;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size <= 0 ||
+            st.st_size > MAX_WOLFSSL_FILE_SIZE) {
+        WOLFSSL_MSG("CM_MapCASnapshot file size error");
+        close(fd);
+        return WOLFSSL_BAD_FILE;
+    }
+
+    mem = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        WOLFSSL_MSG("CA snapshot mmap failed");
+        return WOLFSSL_BAD_FILE;
+    }
+
+    rc = AttachCASnapshot(cm, mem, (word32)st.st_size, 1);
+    if (rc != WOLFSSL_SUCCESS)
+        munmap(mem, (size_t)st.st_size);
+#else
+    XFILE file;
+    int   memSz;
+
+    WOLFSSL_ENTER("CM_MapCASnapshot");
+
+    /* no mmap, read it in to memory owned by cm instead */
+    file = XFOPEN(fname, "rb");
+    if (file == XBADFILE) {
+       WOLFSSL_MSG("Couldn't open CA snapshot file");
+       return WOLFSSL_BAD_FILE;
+    }
+
+    if (XFSEEK(file, 0, XSEEK_END) != 0) {
+        XFCLOSE(file);
+        return WOLFSSL_BAD_FILE;
+    }
+    memSz = (int)XFTELL(file);
+    XREWIND(file);
+
+    if (memSz > MAX_WOLFSSL_FILE_SIZE || memSz <= 0) {
+        WOLFSSL_MSG("CM_MapCASnapshot file size error");
+        XFCLOSE(file);
+        return WOLFSSL_BAD_FILE;
+    }
+
+    mem = XMALLOC(memSz, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (mem == NULL) {
+        WOLFSSL_MSG("Alloc for tmp buffer failed");
+        XFCLOSE(file);
+        return MEMORY_E;
+    }
+
+    if ((int)XFREAD(mem, memSz, 1, file) != 1) {
+        WOLFSSL_MSG("CA snapshot file read error");
+        rc = FREAD_ERROR;
+    }
+    else
+        rc = AttachCASnapshot(cm, mem, (word32)memSz, 1);
+    if (rc != WOLFSSL_SUCCESS)
+        XFREE(mem, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    XFCLOSE(file);
+#endif
+
+    return rc;
+}
+
+#endif /* NO_FILESYSTEM */
+
+
+/* Save a CA snapshot to memory */
+int CM_MemSaveCASnapshot(WOLFSSL_CERT_MANAGER* cm, void* mem, int sz,
+                         int* used)
+{
+    int ret;
+
+    WOLFSSL_ENTER("CM_MemSaveCASnapshot");
+
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Wr on caLock failed");
+        return BAD_MUTEX_E;
+    }
+
+    ret = LoadSnapshotSigners(cm);
+    if (ret == 0)
+        ret = DoMemSaveCASnapshot(cm, mem, sz);
+    if (ret == WOLFSSL_SUCCESS)
+        *used = GetCASnapshotMemSize(cm);
+
+    wc_UnLockRwLock(&cm->caLock);
+
+    return ret;
+}
+
+
+/* Use the CA snapshot in caller owned memory */
+int CM_UseCASnapshot(WOLFSSL_CERT_MANAGER* cm, const void* mem, int sz)
+{
+    WOLFSSL_ENTER("CM_UseCASnapshot");
+
+    return AttachCASnapshot(cm, mem, (word32)sz, 0);
+}
+
+
+/* get how big the CA snapshot save buffer needs to be */
+int CM_GetCASnapshotMemSize(WOLFSSL_CERT_MANAGER* cm)
+{
+    int sz;
+
+    WOLFSSL_ENTER("CM_GetCASnapshotMemSize");
+
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Wr on caLock failed");
+        return BAD_MUTEX_E;
+    }
+
+    sz = LoadSnapshotSigners(cm);
+    if (sz == 0)
+        sz = GetCASnapshotMemSize(cm);
+
+    wc_UnLockRwLock(&cm->caLock);
+
+    return sz;
+}
+
+#endif /* WOLFSSL_CA_SNAPSHOT */
+
 #endif /* PERSIST_CERT_CACHE */
 #endif /* NO_CERTS */
 
@@ -12245,6 +14766,8 @@ int wolfSSL_Cleanup(void)
 #ifndef NO_SESSION_CACHE
     if (wc_FreeMutex(&session_mutex) != 0)
         ret = BAD_MUTEX_E;
+    if (FreeSessionCache() != 0)
+        ret = BAD_MUTEX_E;
 #endif
     if (wc_FreeMutex(&count_mutex) != 0)
         ret = BAD_MUTEX_E;
@@ -12332,7 +14855,9 @@ WOLFSSL_SESSION* GetSessionClient(WOLFSSL* ssl, const byte* id, int len)
     word32          row;
     int             idx;
     int             count;
+    int             i;
     int             error = 0;
+    ClientSession   clients[SESSIONS_PER_ROW];
 
     WOLFSSL_ENTER("GetSessionClient");
 
@@ -12356,50 +14881,67 @@ WOLFSSL_SESSION* GetSessionClient(WOLFSSL* ssl, const byte* id, int len)
         return NULL;
 #endif
 
-    row = HashSession(id, len, &error) % SESSION_ROWS;
+    row = HashSession(id, len, &error) % SESSION_CACHE_ROWS;
     if (error != 0) {
         WOLFSSL_MSG("Hash session failed");
         return NULL;
     }
 
-    if (wc_LockMutex(&session_mutex) != 0) {
+    if (LockSessionMutex(CLIENT_CACHE_MUTEX) != 0) {
         WOLFSSL_MSG("Lock session mutex failed");
         return NULL;
     }
 
-    /* start from most recently used */
+    /* snapshot row, start from most recently used */
     count = min((word32)ClientCache[row].totalCount, SESSIONS_PER_ROW);
     idx = ClientCache[row].nextIdx - 1;
     if (idx < 0)
         idx = SESSIONS_PER_ROW - 1; /* if back to front, the previous was end */
 
-    for (; count > 0; --count, idx = idx ? idx - 1 : SESSIONS_PER_ROW - 1) {
-        WOLFSSL_SESSION* current;
-        ClientSession   clSess;
-
+    for (i = 0; i < count; i++, idx = idx ? idx - 1 : SESSIONS_PER_ROW - 1) {
         if (idx >= SESSIONS_PER_ROW || idx < 0) { /* sanity check */
             WOLFSSL_MSG("Bad idx");
             break;
         }
+        clients[i] = ClientCache[row].Clients[idx];
+    }
+    count = i;
+
+    wc_UnLockMutex(CLIENT_CACHE_MUTEX);
+
+    /* session rows are locked separately, see SESSION_ROW_MUTEX */
+    for (i = 0; i < count && ret == NULL; i++) {
+        WOLFSSL_SESSION* current;
+        wolfSSL_Mutex*   rowMutex;
+
+        if (clients[i].serverRow >= SESSION_CACHE_ROWS ||
+                                clients[i].serverIdx >= SESSIONS_PER_ROW) {
+            WOLFSSL_MSG("Bad client cache entry");
+            break;
+        }
 
-        clSess = ClientCache[row].Clients[idx];
+        rowMutex = SESSION_ROW_MUTEX(clients[i].serverRow);
+        if (LockSessionMutex(rowMutex) != 0) {
+            WOLFSSL_MSG("Lock session row mutex failed");
+            break;
+        }
 
-        current = &SessionCache[clSess.serverRow].Sessions[clSess.serverIdx];
+        current = &SessionCache[clients[i].serverRow].Sessions[
+                                                          clients[i].serverIdx];
         if (XMEMCMP(current->serverID, id, len) == 0) {
             WOLFSSL_MSG("Found a serverid match for client");
             if (LowResTimer() < (current->bornOn + current->timeout)) {
                 WOLFSSL_MSG("Session valid");
                 ret = current;
-                break;
             } else {
                 WOLFSSL_MSG("Session timed out");  /* could have more for id */
             }
         } else {
             WOLFSSL_MSG("ServerID not a match from client table");
         }
-    }
 
-    wc_UnLockMutex(&session_mutex);
+        wc_UnLockMutex(rowMutex);
+    }
 
     return ret;
 }
@@ -12483,13 +15025,13 @@ WOLFSSL_SESSION* GetSession(WOLFSSL* ssl, byte* masterSecret,
         return NULL;
 #endif
 
-    row = HashSession(id, ID_LEN, &error) % SESSION_ROWS;
+    row = HashSession(id, ID_LEN, &error) % SESSION_CACHE_ROWS;
     if (error != 0) {
         WOLFSSL_MSG("Hash session failed");
         return NULL;
     }
 
-    if (wc_LockMutex(&session_mutex) != 0)
+    if (LockSessionMutex(SESSION_ROW_MUTEX(row)) != 0)
         return 0;
 
     /* start from most recently used */
@@ -12513,6 +15055,7 @@ WOLFSSL_SESSION* GetSession(WOLFSSL* ssl, byte* masterSecret,
                 WOLFSSL_MSG("Session valid");
                 ret = current;
                 RestoreSession(ssl, ret, masterSecret, restoreSessionCerts);
+                TouchSessionRowSlot(&SessionCache[row], (word32)idx);
             } else {
                 WOLFSSL_MSG("Session timed out");
             }
@@ -12522,7 +15065,7 @@ WOLFSSL_SESSION* GetSession(WOLFSSL* ssl, byte* masterSecret,
         }
     }
 
-    wc_UnLockMutex(&session_mutex);
+    wc_UnLockMutex(SESSION_ROW_MUTEX(row));
 
     return ret;
 }
@@ -12535,6 +15078,7 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
     int ticketLen             = 0;
     int doDynamicCopy         = 0;
     int ret                   = WOLFSSL_SUCCESS;
+    wolfSSL_Mutex* sessionMutex;
 
     (void)ticketLen;
     (void)doDynamicCopy;
@@ -12543,6 +15087,8 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
     if (!ssl || !copyFrom)
         return BAD_FUNC_ARG;
 
+    sessionMutex = GetSessionMutex(copyFrom);
+
 #ifdef HAVE_SESSION_TICKET
     /* Free old dynamic ticket if we had one to avoid leak */
     if (copyInto->isDynamic) {
@@ -12552,7 +15098,7 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
     }
 #endif
 
-    if (wc_LockMutex(&session_mutex) != 0)
+    if (LockSessionMutex(sessionMutex) != 0)
         return BAD_MUTEX_E;
 
 #ifdef HAVE_SESSION_TICKET
@@ -12574,13 +15120,13 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
     copyInto->cipherSuite    = copyFrom->cipherSuite;
 #endif
 
-    if (wc_UnLockMutex(&session_mutex) != 0) {
+    if (wc_UnLockMutex(sessionMutex) != 0) {
         return BAD_MUTEX_E;
     }
 
 #ifdef HAVE_SESSION_TICKET
 #ifdef WOLFSSL_TLS13
-    if (wc_LockMutex(&session_mutex) != 0) {
+    if (LockSessionMutex(sessionMutex) != 0) {
         XFREE(tmpBuff, ssl->heap, DYNAMIC_TYPE_SESSION_TICK);
         return BAD_MUTEX_E;
     }
@@ -12599,7 +15145,7 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
 #endif
     XMEMCPY(copyInto->masterSecret, copyFrom->masterSecret, SECRET_LEN);
 
-    if (wc_UnLockMutex(&session_mutex) != 0) {
+    if (wc_UnLockMutex(sessionMutex) != 0) {
         if (ret == WOLFSSL_SUCCESS)
             ret = BAD_MUTEX_E;
     }
@@ -12612,7 +15158,7 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
         if (!tmpBuff)
             return MEMORY_ERROR;
 
-        if (wc_LockMutex(&session_mutex) != 0) {
+        if (LockSessionMutex(sessionMutex) != 0) {
             XFREE(tmpBuff, ssl->heap, DYNAMIC_TYPE_SESSION_TICK);
             return BAD_MUTEX_E;
         }
@@ -12635,7 +15181,7 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
     }
 
     if (doDynamicCopy) {
-        if (wc_UnLockMutex(&session_mutex) != 0) {
+        if (wc_UnLockMutex(sessionMutex) != 0) {
             if (ret == WOLFSSL_SUCCESS)
                 ret = BAD_MUTEX_E;
         }
@@ -12696,6 +15242,27 @@ static int get_locked_session_stats(word32* active, word32* total,
                                     word32* peak);
 #endif
 
+#ifdef HAVE_EXT_CACHE
+/* Take a reference on the ctx owning a cached session so it outlives the
+ * remove callback made after the row is unlocked. The row lock is held, so
+ * RemoveSessionCacheOwner() hasn't passed the row and ctx is still valid.
+ * Returns 0 when the ctx is already being freed. */
+static int UpRefSessionOwner(WOLFSSL_CTX* ctx)
+{
+    int ret = 0;
+
+    if (wc_LockMutex(&ctx->countMutex) != 0)
+        return 0;
+    if (ctx->refCount > 0) {
+        ctx->refCount++;
+        ret = 1;
+    }
+    wc_UnLockMutex(&ctx->countMutex);
+
+    return ret;
+}
+#endif
+
 int AddSession(WOLFSSL* ssl)
 {
     word32 row = 0;
@@ -12705,10 +15272,15 @@ int AddSession(WOLFSSL* ssl)
 #ifdef HAVE_SESSION_TICKET
     byte*  tmpBuff = NULL;
     int    ticLen  = 0;
+    int    dynTicket = 1;
 #endif
     WOLFSSL_SESSION* session;
     int i;
     int overwrite = 0;
+#ifdef HAVE_EXT_CACHE
+    WOLFSSL_CTX*     evictCtx = NULL;
+    WOLFSSL_SESSION* evicted  = NULL;
+#endif
 
     if (ssl->options.sessionCacheOff)
         return 0;
@@ -12734,8 +15306,16 @@ int AddSession(WOLFSSL* ssl)
 
 #ifdef HAVE_SESSION_TICKET
     ticLen = ssl->session.ticketLen;
+#ifdef WOLFSSL_SHARED_SESSION_CACHE
+    /* other processes can't follow a pointer into this one's heap, so the
+       shared cache only keeps tickets that fit the static buffer */
+    dynTicket = 0;
+    #ifdef HAVE_EXT_CACHE
+    dynTicket = ssl->options.internalCacheOff;
+    #endif
+#endif
     /* Alloc Memory here so if Malloc fails can exit outside of lock */
-    if (ticLen > SESSION_TICKET_LEN) {
+    if (ticLen > SESSION_TICKET_LEN && dynTicket) {
         tmpBuff = (byte*)XMALLOC(ticLen, ssl->heap,
                 DYNAMIC_TYPE_SESSION_TICK);
         if(!tmpBuff)
@@ -12759,7 +15339,7 @@ int AddSession(WOLFSSL* ssl)
     {
         /* Use the session object in the cache for external cache if required.
          */
-        row = HashSession(id, ID_LEN, &error) % SESSION_ROWS;
+        row = HashSession(id, ID_LEN, &error) % SESSION_CACHE_ROWS;
         if (error != 0) {
             WOLFSSL_MSG("Hash session failed");
 #ifdef HAVE_SESSION_TICKET
@@ -12768,7 +15348,7 @@ int AddSession(WOLFSSL* ssl)
             return error;
         }
 
-        if (wc_LockMutex(&session_mutex) != 0) {
+        if (LockSessionMutex(SESSION_ROW_MUTEX(row)) != 0) {
 #ifdef HAVE_SESSION_TICKET
             XFREE(tmpBuff, ssl->heap, DYNAMIC_TYPE_SESSION_TICK);
 #endif
@@ -12785,8 +15365,22 @@ int AddSession(WOLFSSL* ssl)
         }
 
         if (!overwrite) {
-            idx = SessionCache[row].nextIdx++;
+            idx = GetSessionRowSlot(&SessionCache[row]);
+#ifdef HAVE_EXT_CACHE
+            /* slot already used, copy the entry for its owner's remove
+               callback, made once the row is unlocked */
+            evictCtx = SessionCache[row].Sessions[idx].ownerCtx;
+            if (SessionCache[row].totalCount < SESSIONS_PER_ROW ||
+                      evictCtx == NULL || !UpRefSessionOwner(evictCtx)) {
+                evictCtx = NULL;
+            }
+            else {
+                evicted = wolfSSL_SESSION_dup(
+                                          &SessionCache[row].Sessions[idx]);
+            }
+#endif
         }
+        TouchSessionRowSlot(&SessionCache[row], idx);
 #ifdef SESSION_INDEX
         ssl->sessionIndex = (row << SESSIDX_ROW_SHIFT) | idx;
 #endif
@@ -12817,6 +15411,15 @@ int AddSession(WOLFSSL* ssl)
 
     session->timeout = ssl->timeout;
     session->bornOn  = LowResTimer();
+#ifdef HAVE_EXT_CACHE
+    /* ctx to tell on eviction, a shared cache can't hold process local
+       pointers so it has none */
+    #ifndef WOLFSSL_SHARED_SESSION_CACHE
+    session->ownerCtx = (ssl->ctx->rem_sess_cb != NULL) ? ssl->ctx : NULL;
+    #else
+    session->ownerCtx = NULL;
+    #endif
+#endif
 
 #ifdef HAVE_SESSION_TICKET
     /* Check if another thread modified ticket since alloc */
@@ -12832,7 +15435,18 @@ int AddSession(WOLFSSL* ssl)
         }
 
         /* If too large to store in static buffer, use dyn buffer */
-        if (ticLen > SESSION_TICKET_LEN) {
+        if (ticLen > SESSION_TICKET_LEN && !dynTicket) {
+            session->ticket = session->staticTicket;
+            session->isDynamic = 0;
+            ticLen = 0; /* not kept, see dynTicket */
+        #ifdef WOLFSSL_SHARED_SESSION_CACHE
+            WOLFSSL_MSG("Session ticket too long for shared cache, dropped");
+            if (wc_LockMutex(&session_mutex) == 0) {
+                SessionTicketsDropped++;
+                wc_UnLockMutex(&session_mutex);
+            }
+        #endif
+        } else if (ticLen > SESSION_TICKET_LEN) {
             session->ticket = tmpBuff;
             session->isDynamic = 1;
         } else {
@@ -12921,10 +15535,16 @@ int AddSession(WOLFSSL* ssl)
 #endif
             {
                 clientRow = HashSession(ssl->session.serverID,
-                        ssl->session.idLen, &error) % SESSION_ROWS;
+                        ssl->session.idLen, &error) % SESSION_CACHE_ROWS;
                 if (error != 0) {
                     WOLFSSL_MSG("Hash session failed");
-                } else {
+                }
+            #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
+                else if (LockSessionMutex(CLIENT_CACHE_MUTEX) != 0) {
+                    error = BAD_MUTEX_E;
+                }
+            #endif
+                else {
                     clientIdx = ClientCache[clientRow].nextIdx++;
 
                     ClientCache[clientRow].Clients[clientIdx].serverRow =
@@ -12935,6 +15555,9 @@ int AddSession(WOLFSSL* ssl)
                     ClientCache[clientRow].totalCount++;
                     if (ClientCache[clientRow].nextIdx == SESSIONS_PER_ROW)
                         ClientCache[clientRow].nextIdx = 0;
+                #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
+                    wc_UnLockMutex(CLIENT_CACHE_MUTEX);
+                #endif
                 }
             }
         }
@@ -12943,14 +15566,39 @@ int AddSession(WOLFSSL* ssl)
     }
 #endif /* NO_CLIENT_CACHE */
 
+#ifdef HAVE_EXT_CACHE
+    if (!ssl->options.internalCacheOff)
+#endif
+    {
+        int unlockRet = wc_UnLockMutex(SESSION_ROW_MUTEX(row));
+
+#ifdef HAVE_EXT_CACHE
+        /* the evicted entry is gone, its owner is told outside the lock and
+           then dropped, which may free it */
+        if (evictCtx != NULL) {
+            if (evicted != NULL && evictCtx->rem_sess_cb != NULL)
+                evictCtx->rem_sess_cb(evictCtx, evicted);
+            wolfSSL_SESSION_free(evicted);
+            FreeSSL_Ctx(evictCtx);
+        }
+#endif
+        if (unlockRet != 0)
+            return BAD_MUTEX_E;
+    }
+
 #if defined(WOLFSSL_SESSION_STATS) && defined(WOLFSSL_PEAK_SESSIONS)
 #ifdef HAVE_EXT_CACHE
     if (!ssl->options.internalCacheOff)
 #endif
     {
+        /* counting active sessions needs every row, so done after the row
+         * lock above is released */
         if (error == 0) {
             word32 active = 0;
 
+            if (LockSessionCache() != 0)
+                return BAD_MUTEX_E;
+
             error = get_locked_session_stats(&active, NULL, NULL);
             if (error == WOLFSSL_SUCCESS) {
                 error = 0;  /* back to this function ok */
@@ -12958,18 +15606,12 @@ int AddSession(WOLFSSL* ssl)
                 if (active > PeakSessions)
                     PeakSessions = active;
             }
+
+            UnLockSessionCache();
         }
     }
 #endif /* defined(WOLFSSL_SESSION_STATS) && defined(WOLFSSL_PEAK_SESSIONS) */
 
-#ifdef HAVE_EXT_CACHE
-    if (!ssl->options.internalCacheOff)
-#endif
-    {
-        if (wc_UnLockMutex(&session_mutex) != 0)
-            return BAD_MUTEX_E;
-    }
-
 #ifdef HAVE_EXT_CACHE
     if (error == 0 && ssl->ctx->new_sess_cb != NULL)
         ssl->ctx->new_sess_cb(ssl, session);
@@ -13000,18 +15642,22 @@ int wolfSSL_GetSessionAtIndex(int idx, WOLFSSL_SESSION* session)
     row = idx >> SESSIDX_ROW_SHIFT;
     col = idx & SESSIDX_IDX_MASK;
 
-    if (wc_LockMutex(&session_mutex) != 0) {
+    if (row < 0 || row >= (int)SESSION_CACHE_ROWS) {
+        WOLFSSL_LEAVE("wolfSSL_GetSessionAtIndex", result);
+        return result;
+    }
+
+    if (LockSessionMutex(SESSION_ROW_MUTEX(row)) != 0) {
         return BAD_MUTEX_E;
     }
 
-    if (row < SESSION_ROWS &&
-        col < (int)min(SessionCache[row].totalCount, SESSIONS_PER_ROW)) {
+    if (col < (int)min(SessionCache[row].totalCount, SESSIONS_PER_ROW)) {
         XMEMCPY(session,
                  &SessionCache[row].Sessions[col], sizeof(WOLFSSL_SESSION));
         result = WOLFSSL_SUCCESS;
     }
 
-    if (wc_UnLockMutex(&session_mutex) != 0)
+    if (wc_UnLockMutex(SESSION_ROW_MUTEX(row)) != 0)
         result = BAD_MUTEX_E;
 
     WOLFSSL_LEAVE("wolfSSL_GetSessionAtIndex", result);
@@ -13065,7 +15711,7 @@ WOLFSSL_X509* wolfSSL_SESSION_get0_peer(WOLFSSL_SESSION* session)
 
 #ifdef WOLFSSL_SESSION_STATS
 
-/* requires session_mutex lock held, WOLFSSL_SUCCESS on ok */
+/* requires LockSessionCache() held, WOLFSSL_SUCCESS on ok */
 static int get_locked_session_stats(word32* active, word32* total, word32* peak)
 {
     int result = WOLFSSL_SUCCESS;
@@ -13080,7 +15726,7 @@ static int get_locked_session_stats(word32* active, word32* total, word32* peak)
 
     WOLFSSL_ENTER("get_locked_session_stats");
 
-    for (i = 0; i < SESSION_ROWS; i++) {
+    for (i = 0; i < (int)SESSION_CACHE_ROWS; i++) {
         seen += SessionCache[i].totalCount;
 
         if (active == NULL)
@@ -13131,7 +15777,7 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
     WOLFSSL_ENTER("wolfSSL_get_session_stats");
 
     if (maxSessions) {
-        *maxSessions = SESSIONS_PER_ROW * SESSION_ROWS;
+        *maxSessions = SESSIONS_PER_ROW * SESSION_CACHE_ROWS;
 
         if (active == NULL && total == NULL && peak == NULL)
             return result;  /* we're done */
@@ -13141,14 +15787,13 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
     if (active == NULL && total == NULL && peak == NULL)
         return BAD_FUNC_ARG;
 
-    if (wc_LockMutex(&session_mutex) != 0) {
+    if (LockSessionCache() != 0) {
         return BAD_MUTEX_E;
     }
 
     result = get_locked_session_stats(active, total, peak);
 
-    if (wc_UnLockMutex(&session_mutex) != 0)
-        result = BAD_MUTEX_E;
+    UnLockSessionCache();
 
     WOLFSSL_LEAVE("wolfSSL_get_session_stats", result);
 
@@ -13183,9 +15828,9 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
 #endif
         printf("Max   Sessions      = %d\n", maxSessions);
 
-        E = (double)totalSessionsSeen / SESSION_ROWS;
+        E = (double)totalSessionsSeen / SESSION_CACHE_ROWS;
 
-        for (i = 0; i < SESSION_ROWS; i++) {
+        for (i = 0; i < (int)SESSION_CACHE_ROWS; i++) {
             double diff = SessionCache[i].totalCount - E;
             diff *= diff;                /* square    */
             diff /= E;                   /* normalize */
@@ -13193,8 +15838,10 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
             chiSquare += diff;
         }
         printf("  chi-square = %5.1f, d.f. = %d\n", chiSquare,
-                                                     SESSION_ROWS - 1);
-        #if (SESSION_ROWS == 11)
+                                              (int)SESSION_CACHE_ROWS - 1);
+        #if defined(WOLFSSL_DYNAMIC_SESSION_CACHE)
+            /* no p value table for run time row counts */
+        #elif (SESSION_ROWS == 11)
             printf(" .05 p value =  18.3, chi-square should be less\n");
         #elif (SESSION_ROWS == 211)
             printf(".05 p value  = 244.8, chi-square should be less\n");
@@ -13277,7 +15924,41 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
 
 
 #ifndef USE_WINDOWS_API
-    #ifndef NO_WRITEV
+    #if defined(WOLFSSL_IO_SENDV)
+
+        /* writev that builds records straight from the iovec entries, full
+           records are coalesced into one vectored send */
+        int wolfSSL_writev(WOLFSSL* ssl, const struct iovec* iov, int iovcnt)
+        {
+            int sending = 0;
+            int i;
+            int ret;
+
+            WOLFSSL_ENTER("wolfSSL_writev");
+
+            if ((iov == NULL && iovcnt > 0) || iovcnt < 0)
+                return BAD_FUNC_ARG;
+
+            for (i = 0; i < iovcnt; i++) {
+                if (iov[i].iov_base == NULL && iov[i].iov_len > 0)
+                    return BAD_FUNC_ARG;
+                sending += (int)iov[i].iov_len;
+            }
+
+            if ((ret = wolfSSL_write_prepare(ssl)) != 0)
+                return ret;
+
+            ret = SendDataV(ssl, iov, iovcnt, sending);
+
+            WOLFSSL_LEAVE("wolfSSL_writev", ret);
+
+            if (ret < 0)
+                return WOLFSSL_FATAL_ERROR;
+            else
+                return ret;
+        }
+
+    #elif !defined(NO_WRITEV)
 
         /* simulate writev semantics, doesn't actually do block at a time though
            because of SSL_write behavior and because front adds may be small */
@@ -13773,6 +16454,9 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
         int ret = WOLFSSL_FAILURE;
 
         FreeDer(&ctx->privateKey);
+    #ifdef WOLFSSL_CTX_RSA_KEY
+        FreeCtxRsaKey(ctx);
+    #endif
         if (AllocDer(&ctx->privateKey, (word32)sz, PRIVATEKEY_TYPE,
                                                               ctx->heap) == 0) {
             XMEMCPY(ctx->privateKey->buffer, id, sz);
@@ -14026,6 +16710,30 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
     }
 
 
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    int wolfSSL_CTX_EnableVerifyCache(WOLFSSL_CTX* ctx, int maxEntries)
+    {
+        WOLFSSL_ENTER("wolfSSL_CTX_EnableVerifyCache");
+
+        if (ctx == NULL)
+            return BAD_FUNC_ARG;
+
+        return wolfSSL_CertManagerEnableVerifyCache(ctx->cm, maxEntries);
+    }
+
+
+    int wolfSSL_CTX_DisableVerifyCache(WOLFSSL_CTX* ctx)
+    {
+        WOLFSSL_ENTER("wolfSSL_CTX_DisableVerifyCache");
+
+        if (ctx == NULL)
+            return BAD_FUNC_ARG;
+
+        return wolfSSL_CertManagerDisableVerifyCache(ctx->cm);
+    }
+#endif /* WOLFSSL_CERT_VERIFY_CACHE */
+
+
 #ifdef WOLFSSL_TRUST_PEER_CERT
     int wolfSSL_CTX_Unload_trust_peers(WOLFSSL_CTX* ctx)
     {
@@ -14076,18 +16784,33 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
         return WOLFSSL_SUCCESS;
     }
 
-   /* returns previous set cache size which stays constant */
+   /* returns previous set cache size, which stays constant unless built
+    * with WOLFSSL_DYNAMIC_SESSION_CACHE and called before wolfSSL_Init().
+    * A size that can't be applied, like any after wolfSSL_Init(), is logged
+    * and ignored */
     long wolfSSL_CTX_sess_set_cache_size(WOLFSSL_CTX* ctx, long sz)
     {
-        /* cache size fixed at compile time in wolfSSL */
         (void)ctx;
         (void)sz;
+        #if defined(WOLFSSL_DYNAMIC_SESSION_CACHE) && !defined(NO_SESSION_CACHE)
+        {
+            long prev = (long)(SESSIONS_PER_ROW * SESSION_CACHE_ROWS);
+
+            if (sz > 0 && wolfSSL_SetSessionCacheSize((word32)sz,
+                                        SessionCacheEvict) != WOLFSSL_SUCCESS) {
+                WOLFSSL_MSG("session cache resize ignored");
+            }
+            return prev;
+        }
+        #else
+        /* cache size fixed at compile time in wolfSSL */
         WOLFSSL_MSG("session cache is set at compile time");
         #ifndef NO_SESSION_CACHE
             return (long)(SESSIONS_PER_ROW * SESSION_ROWS);
         #else
             return 0;
         #endif
+        #endif
     }
 
 #endif
@@ -14151,6 +16874,9 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
         if (((ssl->cbioFlag & WOLFSSL_CBIO_SEND) == 0) &&
             (wr != NULL && wr->type != WOLFSSL_BIO_SOCKET)) {
             ssl->CBIOSend = BioSend;
+        #ifdef WOLFSSL_IO_SENDV
+            ssl->CBIOSendv = NULL;
+        #endif
         }
 
         /* User programs should always retry reading from these BIOs */
@@ -16830,7 +19556,7 @@ size_t wolfSSL_get_client_random(const WOLFSSL* ssl, unsigned char* out,
     {
         (void)ctx;
         #ifndef NO_SESSION_CACHE
-            return (long)(SESSIONS_PER_ROW * SESSION_ROWS);
+            return (long)(SESSIONS_PER_ROW * SESSION_CACHE_ROWS);
         #else
             return 0;
         #endif
@@ -27089,7 +29815,8 @@ void wolfSSL_CTX_sess_set_new_cb(WOLFSSL_CTX* ctx,
 
 #endif /* OPENSSL_EXTRA || HAVE_EXT_CACHE */
 
-#if defined(OPENSSL_EXTRA) || defined(WOLFSSL_WPAS_SMALL)
+#if defined(OPENSSL_EXTRA) || defined(WOLFSSL_WPAS_SMALL) || \
+                                                        defined(HAVE_EXT_CACHE)
 void wolfSSL_CTX_sess_set_remove_cb(WOLFSSL_CTX* ctx, void (*f)(WOLFSSL_CTX*,
                                                         WOLFSSL_SESSION*))
 {
@@ -27097,12 +29824,16 @@ void wolfSSL_CTX_sess_set_remove_cb(WOLFSSL_CTX* ctx, void (*f)(WOLFSSL_CTX*,
         return;
 
 #ifdef HAVE_EXT_CACHE
+    #ifndef NO_SESSION_CACHE
+    if (f == NULL && ctx->rem_sess_cb != NULL)
+        RemoveSessionCacheOwner(ctx);
+    #endif
     ctx->rem_sess_cb = f;
 #else
     (void)f;
 #endif
 }
-#endif /* OPENSSL_EXTRA || WOLFSSL_WPAS_SMALL */
+#endif /* OPENSSL_EXTRA || WOLFSSL_WPAS_SMALL || HAVE_EXT_CACHE */
 
 #ifdef OPENSSL_EXTRA
 
@@ -46337,9 +49068,7 @@ int wolfSSL_i2c_ASN1_INTEGER(WOLFSSL_ASN1_INTEGER *a, unsigned char **pp)
 #ifndef NO_CERTS
 int wolfSSL_X509_CA_num(WOLFSSL_X509_STORE* store)
 {
-    int i = 0;
     int cnt_ret = 0;
-    Signer **table;
 
     WOLFSSL_ENTER("wolfSSL_X509_CA_num");
     if (store == NULL || store->cm == NULL){
@@ -46347,19 +49076,9 @@ int wolfSSL_X509_CA_num(WOLFSSL_X509_STORE* store)
         return WOLFSSL_FAILURE;
     }
 
-    table = store->cm->caTable;
-    if (table){
-        if (wc_LockMutex(&store->cm->caLock) == 0){
-            for (i = 0; i < CA_TABLE_SIZE; i++) {
-                Signer* signer = table[i];
-                while (signer) {
-                    Signer* next = signer->next;
-                    cnt_ret++;
-                    signer = next;
-                }
-            }
-            wc_UnLockMutex(&store->cm->caLock);
-        }
+    if (wc_LockRwLock_Rd(&store->cm->caLock) == 0) {
+        cnt_ret = (int)store->cm->caCount;
+        wc_UnLockRwLock(&store->cm->caLock);
     }
 
     return cnt_ret;
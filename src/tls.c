@@ -6718,7 +6718,7 @@ static int TLSX_KeyShare_GenX25519Key(WOLFSSL *ssl, KeyShareEntry* kse)
     }
 
     /* Make an ECC key. */
-    ret = wc_curve25519_init(key);
+    ret = wc_curve25519_init_ex(key, ssl->heap, ssl->devId);
     if (ret != 0)
         goto end;
     ret = wc_curve25519_make_key(ssl->rng, CURVE25519_KEYSIZE, key);
@@ -7254,7 +7254,7 @@ static int TLSX_KeyShare_ProcessX25519(WOLFSSL* ssl,
         WOLFSSL_MSG("PeerEccKey Memory error");
         return MEMORY_ERROR;
     }
-    ret = wc_curve25519_init(peerX25519Key);
+    ret = wc_curve25519_init_ex(peerX25519Key, ssl->heap, ssl->devId);
     if (ret != 0) {
         XFREE(peerX25519Key, ssl->heap, DYNAMIC_TYPE_TLSX);
         return ret;
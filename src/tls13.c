@@ -89,6 +89,9 @@
 #include <wolfssl/error-ssl.h>
 #include <wolfssl/wolfcrypt/asn.h>
 #include <wolfssl/wolfcrypt/dh.h>
+#ifdef WOLF_CRYPTO_CB
+    #include <wolfssl/wolfcrypt/cryptocb.h>
+#endif
 #ifdef NO_INLINE
     #include <wolfssl/wolfcrypt/misc.h>
 #else
@@ -139,6 +142,7 @@
 /* Extract data using HMAC, salt and input.
  * RFC 5869 - HMAC-based Extract-and-Expand Key Derivation Function (HKDF)
  *
+ * ssl      The SSL/TLS object.
  * prk      The generated pseudorandom key.
  * salt     The salt.
  * saltLen  The length of the salt.
@@ -147,8 +151,8 @@
  * mac      The type of digest to use.
  * returns 0 on success, otherwise failure.
  */
-static int Tls13_HKDF_Extract(byte* prk, const byte* salt, int saltLen,
-                             byte* ikm, int ikmLen, int mac)
+static int Tls13_HKDF_Extract(WOLFSSL* ssl, byte* prk, const byte* salt,
+                              int saltLen, byte* ikm, int ikmLen, int mac)
 {
     int ret;
     int hash = 0;
@@ -190,7 +194,8 @@ static int Tls13_HKDF_Extract(byte* prk, const byte* salt, int saltLen,
     WOLFSSL_BUFFER(ikm, ikmLen);
 #endif
 
-    ret = wc_HKDF_Extract(hash, salt, saltLen, ikm, ikmLen, prk);
+    ret = wc_HKDF_Extract_ex(hash, salt, saltLen, ikm, ikmLen, prk,
+                             ssl->heap, ssl->devId);
 
 #ifdef WOLFSSL_DEBUG_TLS
     WOLFSSL_MSG("  PRK");
@@ -203,6 +208,7 @@ static int Tls13_HKDF_Extract(byte* prk, const byte* salt, int saltLen,
 /* Expand data using HMAC, salt and label and info.
  * TLS v1.3 defines this function.
  *
+ * ssl          The SSL/TLS object.
  * okm          The generated pseudorandom key - output key material.
  * okmLen       The length of generated pseudorandom key - output key material.
  * prk          The salt - pseudo-random key.
@@ -214,7 +220,7 @@ static int Tls13_HKDF_Extract(byte* prk, const byte* salt, int saltLen,
  * digest       The type of digest to use.
  * returns 0 on success, otherwise failure.
  */
-static int HKDF_Expand_Label(byte* okm, word32 okmLen,
+static int HKDF_Expand_Label(WOLFSSL* ssl, byte* okm, word32 okmLen,
                              const byte* prk, word32 prkLen,
                              const byte* protocol, word32 protocolLen,
                              const byte* label, word32 labelLen,
@@ -249,7 +255,8 @@ static int HKDF_Expand_Label(byte* okm, word32 okmLen,
     WOLFSSL_BUFFER(data, idx);
 #endif
 
-    ret = wc_HKDF_Expand(digest, prk, prkLen, data, idx, okm, okmLen);
+    ret = wc_HKDF_Expand_ex(digest, prk, prkLen, data, idx, okm, okmLen,
+                            ssl->heap, ssl->devId);
 
 #ifdef WOLFSSL_DEBUG_TLS
     WOLFSSL_MSG("  OKM");
@@ -294,7 +301,7 @@ static int DeriveKeyMsg(WOLFSSL* ssl, byte* output, int outputLen,
     switch (hashAlgo) {
 #ifndef NO_WOLFSSL_SHA256
         case sha256_mac:
-            ret = wc_InitSha256_ex(&digest.sha256, ssl->heap, INVALID_DEVID);
+            ret = wc_InitSha256_ex(&digest.sha256, ssl->heap, ssl->devId);
             if (ret == 0) {
                     ret = wc_Sha256Update(&digest.sha256, msg, msgLen);
                 if (ret == 0)
@@ -307,7 +314,7 @@ static int DeriveKeyMsg(WOLFSSL* ssl, byte* output, int outputLen,
 #endif
 #ifdef WOLFSSL_SHA384
         case sha384_mac:
-            ret = wc_InitSha384_ex(&digest.sha384, ssl->heap, INVALID_DEVID);
+            ret = wc_InitSha384_ex(&digest.sha384, ssl->heap, ssl->devId);
             if (ret == 0) {
                 ret = wc_Sha384Update(&digest.sha384, msg, msgLen);
                 if (ret == 0)
@@ -320,7 +327,7 @@ static int DeriveKeyMsg(WOLFSSL* ssl, byte* output, int outputLen,
 #endif
 #ifdef WOLFSSL_TLS13_SHA512
         case sha512_mac:
-            ret = wc_InitSha512_ex(&digest.sha512, ssl->heap, INVALID_DEVID);
+            ret = wc_InitSha512_ex(&digest.sha512, ssl->heap, ssl->devId);
             if (ret == 0) {
                 ret = wc_Sha512Update(&digest.sha512, msg, msgLen);
                 if (ret == 0)
@@ -354,7 +361,7 @@ static int DeriveKeyMsg(WOLFSSL* ssl, byte* output, int outputLen,
     if (outputLen == -1)
         outputLen = hashSz;
 
-    return HKDF_Expand_Label(output, outputLen, secret, hashSz,
+    return HKDF_Expand_Label(ssl, output, outputLen, secret, hashSz,
                              protocol, protocolLen, label, labelLen,
                              hash, hashSz, digestAlg);
 }
@@ -423,7 +430,7 @@ static int DeriveKey(WOLFSSL* ssl, byte* output, int outputLen,
     if (includeMsgs)
         hashOutSz = hashSz;
 
-    return HKDF_Expand_Label(output, outputLen, secret, hashSz,
+    return HKDF_Expand_Label(ssl, output, outputLen, secret, hashSz,
                              protocol, protocolLen, label, labelLen,
                              hash, hashOutSz, digestAlg);
 }
@@ -765,11 +772,11 @@ static int DeriveEarlySecret(WOLFSSL* ssl)
 {
     WOLFSSL_MSG("Derive Early Secret");
 #if defined(HAVE_SESSION_TICKET) || !defined(NO_PSK)
-    return Tls13_HKDF_Extract(ssl->arrays->secret, NULL, 0,
+    return Tls13_HKDF_Extract(ssl, ssl->arrays->secret, NULL, 0,
             ssl->arrays->psk_key, ssl->arrays->psk_keySz,
             ssl->specs.mac_algorithm);
 #else
-    return Tls13_HKDF_Extract(ssl->arrays->secret, NULL, 0,
+    return Tls13_HKDF_Extract(ssl, ssl->arrays->secret, NULL, 0,
             ssl->arrays->masterSecret, 0, ssl->specs.mac_algorithm);
 #endif
 }
@@ -797,7 +804,7 @@ static int DeriveHandshakeSecret(WOLFSSL* ssl)
     if (ret != 0)
         return ret;
 
-    return Tls13_HKDF_Extract(ssl->arrays->preMasterSecret,
+    return Tls13_HKDF_Extract(ssl, ssl->arrays->preMasterSecret,
             key, ssl->specs.hash_size,
             ssl->arrays->preMasterSecret, ssl->arrays->preMasterSz,
             ssl->specs.mac_algorithm);
@@ -820,7 +827,7 @@ static int DeriveMasterSecret(WOLFSSL* ssl)
     if (ret != 0)
         return ret;
 
-    return Tls13_HKDF_Extract(ssl->arrays->masterSecret,
+    return Tls13_HKDF_Extract(ssl, ssl->arrays->masterSecret,
             key, ssl->specs.hash_size,
             ssl->arrays->masterSecret, 0, ssl->specs.mac_algorithm);
 }
@@ -871,7 +878,7 @@ static int DeriveResumptionPSK(WOLFSSL* ssl, byte* nonce, byte nonceLen,
             return BAD_FUNC_ARG;
     }
 
-    return HKDF_Expand_Label(secret, ssl->specs.hash_size,
+    return HKDF_Expand_Label(ssl, secret, ssl->specs.hash_size,
                              ssl->session.masterSecret, ssl->specs.hash_size,
                              protocol, protocolLen, resumptionLabel,
                              RESUMPTION_LABEL_SZ, nonce, nonceLen, digestAlg);
@@ -1538,6 +1545,16 @@ static int ChaCha20Poly1305_Encrypt(WOLFSSL* ssl, byte* output,
     int    ret    = 0;
     byte   poly[CHACHA20_256_KEY_SIZE];
 
+#ifdef WOLF_CRYPTO_CB
+    if (ssl->encrypt.chacha->devId != INVALID_DEVID) {
+        ret = wc_CryptoCb_ChaCha20Poly1305Encrypt(ssl->encrypt.chacha, output,
+                                      input, sz, nonce, tag, aad, aadSz);
+        if (ret != CRYPTOCB_UNAVAILABLE)
+            return ret;
+        /* fall-through when unavailable */
+    }
+#endif
+
     /* Poly1305 key is 256 bits of zero encrypted with ChaCha20. */
     XMEMSET(poly, 0, sizeof(poly));
 
@@ -1821,6 +1838,20 @@ static int ChaCha20Poly1305_Decrypt(WOLFSSL* ssl, byte* output,
     byte tag[POLY1305_AUTH_SZ];
     byte poly[CHACHA20_256_KEY_SIZE]; /* generated key for mac */
 
+#ifdef WOLF_CRYPTO_CB
+    if (ssl->decrypt.chacha->devId != INVALID_DEVID) {
+        ret = wc_CryptoCb_ChaCha20Poly1305Decrypt(ssl->decrypt.chacha, output,
+                                      input, sz, nonce, tagIn, aad, aadSz);
+        if (ret == MAC_CMP_FAILED_E) {
+            WOLFSSL_MSG("MAC did not match");
+            return VERIFY_MAC_ERROR;
+        }
+        if (ret != CRYPTOCB_UNAVAILABLE)
+            return ret;
+        /* fall-through when unavailable */
+    }
+#endif
+
     /* Poly1305 key is 256 bits of zero encrypted with ChaCha20. */
     XMEMSET(poly, 0, sizeof(poly));
 
@@ -251,6 +251,34 @@ int EmbedReceive(WOLFSSL *ssl, char *buf, int sz, void *ctx)
     return recvd;
 }
 
+/* Map the last socket error from a failed send to a WOLFSSL_CBIO_ERR_* */
+static int EmbedSendError(void)
+{
+    int err = wolfSSL_LastError();
+    WOLFSSL_MSG("Embed Send error");
+
+    if (err == SOCKET_EWOULDBLOCK || err == SOCKET_EAGAIN) {
+        WOLFSSL_MSG("\tWould Block");
+        return WOLFSSL_CBIO_ERR_WANT_WRITE;
+    }
+    else if (err == SOCKET_ECONNRESET) {
+        WOLFSSL_MSG("\tConnection reset");
+        return WOLFSSL_CBIO_ERR_CONN_RST;
+    }
+    else if (err == SOCKET_EINTR) {
+        WOLFSSL_MSG("\tSocket interrupted");
+        return WOLFSSL_CBIO_ERR_ISR;
+    }
+    else if (err == SOCKET_EPIPE) {
+        WOLFSSL_MSG("\tSocket EPIPE");
+        return WOLFSSL_CBIO_ERR_CONN_CLOSE;
+    }
+    else {
+        WOLFSSL_MSG("\tGeneral error");
+        return WOLFSSL_CBIO_ERR_GENERAL;
+    }
+}
+
 /* The send embedded callback
  *  return : nb bytes sent, or error
  */
@@ -265,34 +293,35 @@ int EmbedSend(WOLFSSL* ssl, char *buf, int sz, void *ctx)
 #endif
 
     sent = wolfIO_Send(sd, buf, sz, ssl->wflags);
-    if (sent < 0) {
-        int err = wolfSSL_LastError();
-        WOLFSSL_MSG("Embed Send error");
+    if (sent < 0)
+        return EmbedSendError();
 
-        if (err == SOCKET_EWOULDBLOCK || err == SOCKET_EAGAIN) {
-            WOLFSSL_MSG("\tWould Block");
-            return WOLFSSL_CBIO_ERR_WANT_WRITE;
-        }
-        else if (err == SOCKET_ECONNRESET) {
-            WOLFSSL_MSG("\tConnection reset");
-            return WOLFSSL_CBIO_ERR_CONN_RST;
-        }
-        else if (err == SOCKET_EINTR) {
-            WOLFSSL_MSG("\tSocket interrupted");
-            return WOLFSSL_CBIO_ERR_ISR;
-        }
-        else if (err == SOCKET_EPIPE) {
-            WOLFSSL_MSG("\tSocket EPIPE");
-            return WOLFSSL_CBIO_ERR_CONN_CLOSE;
-        }
-        else {
-            WOLFSSL_MSG("\tGeneral error");
-            return WOLFSSL_CBIO_ERR_GENERAL;
-        }
-    }
+    return sent;
+}
+
+#ifdef WOLFSSL_IO_SENDV
+/* The vectored send embedded callback, writes all records with one sendmsg
+ *  return : nb bytes sent, or error
+ */
+int EmbedSendv(WOLFSSL* ssl, const struct iovec* iov, int iovcnt, void *ctx)
+{
+    int sd = *(int*)ctx;
+    int sent;
+
+#ifdef WOLFSSL_MAX_SEND_SZ
+    /* keep the per call limit, only the first record goes out */
+    if (iovcnt > 0)
+        return EmbedSend(ssl, (char*)iov[0].iov_base, (int)iov[0].iov_len,
+                         ctx);
+#endif
+
+    sent = wolfIO_Sendv(sd, iov, iovcnt, ssl->wflags);
+    if (sent < 0)
+        return EmbedSendError();
 
     return sent;
 }
+#endif /* WOLFSSL_IO_SENDV */
 
 
 #ifdef WOLFSSL_DTLS
@@ -659,6 +688,23 @@ int wolfIO_Send(SOCKET_T sd, char *buf, int sz, int wrFlags)
     return sent;
 }
 
+#ifdef WOLFSSL_IO_SENDV
+int wolfIO_Sendv(SOCKET_T sd, const struct iovec* iov, int iovcnt, int wrFlags)
+{
+    struct msghdr msg;
+    int sent;
+
+    XMEMSET(&msg, 0, sizeof(msg));
+    msg.msg_iov    = (struct iovec*)iov;
+    msg.msg_iovlen = iovcnt;
+
+    sent = (int)sendmsg(sd, &msg, wrFlags);
+    sent = TranslateReturnCode(sent, sd);
+
+    return sent;
+}
+#endif
+
 #endif /* USE_WOLFSSL_IO */
 
 
@@ -1540,6 +1586,9 @@ void wolfSSL_CTX_SetIOSend(WOLFSSL_CTX *ctx, CallbackIOSend CBIOSend)
 {
     if (ctx) {
         ctx->CBIOSend = CBIOSend;
+    #ifdef WOLFSSL_IO_SENDV
+        ctx->CBIOSendv = NULL;
+    #endif
     #ifdef OPENSSL_EXTRA
         ctx->cbioFlag |= WOLFSSL_CBIO_SEND;
     #endif
@@ -1547,6 +1596,15 @@ void wolfSSL_CTX_SetIOSend(WOLFSSL_CTX *ctx, CallbackIOSend CBIOSend)
 }
 
 
+#ifdef WOLFSSL_IO_SENDV
+void wolfSSL_CTX_SetIOSendv(WOLFSSL_CTX *ctx, CallbackIOSendv CBIOSendv)
+{
+    if (ctx)
+        ctx->CBIOSendv = CBIOSendv;
+}
+#endif
+
+
 /* sets the IO callback to use for receives at WOLFSSL level */
 void wolfSSL_SSLSetIORecv(WOLFSSL *ssl, CallbackIORecv CBIORecv)
 {
@@ -1564,6 +1622,9 @@ void wolfSSL_SSLSetIOSend(WOLFSSL *ssl, CallbackIOSend CBIOSend)
 {
     if (ssl) {
         ssl->CBIOSend = CBIOSend;
+    #ifdef WOLFSSL_IO_SENDV
+        ssl->CBIOSendv = NULL;
+    #endif
     #ifdef OPENSSL_EXTRA
         ssl->cbioFlag |= WOLFSSL_CBIO_SEND;
     #endif
@@ -1571,6 +1632,16 @@ void wolfSSL_SSLSetIOSend(WOLFSSL *ssl, CallbackIOSend CBIOSend)
 }
 
 
+#ifdef WOLFSSL_IO_SENDV
+/* sets the vectored IO callback to use for sends at WOLFSSL level */
+void wolfSSL_SSLSetIOSendv(WOLFSSL *ssl, CallbackIOSendv CBIOSendv)
+{
+    if (ssl)
+        ssl->CBIOSendv = CBIOSendv;
+}
+#endif
+
+
 void wolfSSL_SetIOReadCtx(WOLFSSL* ssl, void *rctx)
 {
     if (ssl)
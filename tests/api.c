@@ -234,6 +234,10 @@
     #include <wolfssl/wolfcrypt/signature.h>
 #endif
 
+#ifdef WOLF_CRYPTO_CB
+    #include <wolfssl/wolfcrypt/cryptocb.h>
+#endif
+
 
 #ifdef HAVE_AESCCM
     #include <wolfssl/wolfcrypt/aes.h>
@@ -451,6 +455,40 @@ static int test_wolfSSL_Cleanup(void)
 }
 
 
+/* The run time session cache size can only be changed before wolfSSL_Init */
+static void test_wolfSSL_SetSessionCacheSize(void)
+{
+#if defined(WOLFSSL_DYNAMIC_SESSION_CACHE) && !defined(NO_SESSION_CACHE)
+    unsigned int defSz = wolfSSL_GetSessionCacheSize();
+
+    printf(testingFmt, "wolfSSL_SetSessionCacheSize()");
+
+    AssertIntEQ(wolfSSL_SetSessionCacheSize(0, WOLFSSL_SESSION_EVICT_LRU),
+                                                                 BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_SetSessionCacheSize(64, 2), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_SetSessionCacheSize(64, WOLFSSL_SESSION_EVICT_LRU),
+                                                              WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_Init(), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_SetSessionCacheSize(64, WOLFSSL_SESSION_EVICT_LRU),
+                                                                  BAD_STATE_E);
+#ifdef OPENSSL_EXTRA
+    AssertIntGE(wolfSSL_CTX_sess_get_cache_size(NULL), 64);
+    /* too late to resize, the size in use is still returned */
+    AssertIntEQ(wolfSSL_CTX_sess_set_cache_size(NULL, 128),
+                (long)wolfSSL_GetSessionCacheSize());
+#endif
+    AssertIntGE(wolfSSL_GetSessionCacheSize(), 64);
+    AssertIntEQ(wolfSSL_Cleanup(), WOLFSSL_SUCCESS);
+
+    /* back to the default for the rest of the tests */
+    AssertIntEQ(wolfSSL_SetSessionCacheSize(defSz,
+                    WOLFSSL_SESSION_EVICT_ROUND_ROBIN), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_GetSessionCacheSize(), defSz);
+
+    printf(resultFmt, passed);
+#endif
+}
+
 /*  Initialize the wolfCrypt state.
  *  POST: 0 success.
  */
@@ -1306,6 +1344,259 @@ static void test_wolfSSL_CertManagerCRL(void)
 #endif
 }
 
+static void test_wolfSSL_CertManagerCheckCRL(void)
+{
+#if !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && defined(HAVE_CRL) && \
+    !defined(NO_RSA) && defined(HAVE_ECC)
+    const char* ca_cert     = "./certs/ca-cert.pem";
+    const char* ca_ecc_cert = "./certs/ca-ecc-cert.pem";
+    /* two CRLs from one issuer and one from another */
+    const char* crls[] = {
+        "./certs/crl/crl.pem",
+        "./certs/crl/crl2.pem",
+        "./certs/crl/caEccCrl.pem"
+    };
+    byte*  crl_buf;
+    size_t crl_sz;
+    int    i;
+
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+
+    printf(testingFmt, "wolfSSL_CertManagerCheckCRL()");
+
+    AssertNotNull(cm = wolfSSL_CertManagerNew());
+    AssertIntEQ(WOLFSSL_SUCCESS,
+        wolfSSL_CertManagerLoadCA(cm, ca_cert, NULL));
+    AssertIntEQ(WOLFSSL_SUCCESS,
+        wolfSSL_CertManagerLoadCA(cm, ca_ecc_cert, NULL));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerEnableCRL(cm, 0));
+
+    /* no CRL loaded for the issuer yet */
+    AssertIntEQ(CRL_MISSING, wolfSSL_CertManagerVerify(cm,
+        "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM));
+
+    for (i = 0; i < (int)(sizeof(crls) / sizeof(crls[0])); i++) {
+        AssertIntEQ(0, load_file(crls[i], &crl_buf, &crl_sz));
+        AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerLoadCRLBuffer(cm,
+            crl_buf, (long)crl_sz, WOLFSSL_FILETYPE_PEM));
+        free(crl_buf);
+    }
+
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerVerify(cm,
+        "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM));
+    AssertIntEQ(CRL_CERT_REVOKED, wolfSSL_CertManagerVerify(cm,
+        "./certs/server-revoked-cert.pem", WOLFSSL_FILETYPE_PEM));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerVerify(cm,
+        "./certs/server-ecc.pem", WOLFSSL_FILETYPE_PEM));
+
+    wolfSSL_CertManagerFree(cm);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+#if !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && defined(HAVE_CRL) && \
+    defined(HAVE_CRL_MONITOR) && !defined(NO_RSA) && !defined(SINGLE_THREADED)
+static WOLFSSL_CERT_MANAGER* test_crlSwapCm;
+
+/* Checks certs against the monitored CRL while it is swapped underneath */
+static THREAD_RETURN WOLFSSL_THREAD test_CrlSwapCheck(void* args)
+{
+    func_args* myArgs = (func_args*)args;
+    int i;
+
+    myArgs->return_code = 0;
+    for (i = 0; i < 200; i++) {
+        if (wolfSSL_CertManagerVerify(test_crlSwapCm, svrCertFile,
+                                   WOLFSSL_FILETYPE_PEM) != WOLFSSL_SUCCESS)
+            myArgs->return_code++;
+        if (wolfSSL_CertManagerVerify(test_crlSwapCm,
+                    "./certs/server-revoked-cert.pem",
+                    WOLFSSL_FILETYPE_PEM) != CRL_CERT_REVOKED)
+            myArgs->return_code++;
+    }
+
+    return 0;
+}
+#endif
+
+/* Testing that a monitor reload swaps the CRL under in-flight checks */
+static void test_wolfSSL_CertManagerCRL_swap(void)
+{
+#if !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && defined(HAVE_CRL) && \
+    defined(HAVE_CRL_MONITOR) && !defined(NO_RSA) && !defined(SINGLE_THREADED)
+    char        dir[] = "/tmp/wolfssl_crlXXXXXX";
+    char        tmpDir[] = "/tmp/wolfssl_crltmpXXXXXX";
+    char        tmpFile[64];
+    char        crlFile[64];
+    byte*       crl_buf;
+    size_t      crl_sz;
+    func_args   args[2];
+    THREAD_TYPE threads[2];
+    XFILE       f;
+    int         i;
+
+    printf(testingFmt, "wolfSSL_CertManagerCRL_swap()");
+
+    /* the temp file is written outside the monitored directory so a reload
+     * never sees it partially written */
+    AssertNotNull(mkdtemp(dir));
+    AssertNotNull(mkdtemp(tmpDir));
+    XSNPRINTF(tmpFile, sizeof(tmpFile), "%s/crl.tmp", tmpDir);
+    XSNPRINTF(crlFile, sizeof(crlFile), "%s/crl.pem", dir);
+    AssertIntEQ(0, load_file("./certs/crl/crl.pem", &crl_buf, &crl_sz));
+    AssertTrue((f = XFOPEN(crlFile, "wb")) != XBADFILE);
+    AssertIntEQ(XFWRITE(crl_buf, 1, crl_sz, f), crl_sz);
+    XFCLOSE(f);
+
+    AssertNotNull(test_crlSwapCm = wolfSSL_CertManagerNew());
+    AssertIntEQ(WOLFSSL_SUCCESS,
+        wolfSSL_CertManagerLoadCA(test_crlSwapCm, caCertFile, NULL));
+    AssertIntEQ(WOLFSSL_SUCCESS,
+        wolfSSL_CertManagerEnableCRL(test_crlSwapCm, 0));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerLoadCRL(test_crlSwapCm,
+        dir, WOLFSSL_FILETYPE_PEM,
+        WOLFSSL_CRL_MONITOR | WOLFSSL_CRL_START_MON));
+
+    XMEMSET(args, 0, sizeof(args));
+    for (i = 0; i < 2; i++)
+        start_thread(test_CrlSwapCheck, &args[i], &threads[i]);
+
+    /* each rename into the directory has the monitor reload and swap the
+     * whole list, crl.pem is complete for every reload */
+    for (i = 0; i < 100; i++) {
+        AssertTrue((f = XFOPEN(tmpFile, "wb")) != XBADFILE);
+        AssertIntEQ(XFWRITE(crl_buf, 1, crl_sz, f), crl_sz);
+        XFCLOSE(f);
+        AssertIntEQ(rename(tmpFile, crlFile), 0);
+    }
+
+    for (i = 0; i < 2; i++) {
+        join_thread(threads[i]);
+        AssertIntEQ(args[i].return_code, 0);
+    }
+
+    wolfSSL_CertManagerFree(test_crlSwapCm);
+    test_crlSwapCm = NULL;
+    free(crl_buf);
+    AssertIntEQ(remove(crlFile), 0);
+    AssertIntEQ(rmdir(dir), 0);
+    AssertIntEQ(rmdir(tmpDir), 0);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+#if defined(HAVE_OCSP) && !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && \
+    !defined(NO_RSA) && !defined(NO_SHA) && !defined(NO_ASN_TIME) && \
+    defined(WOLFSSL_PEM_TO_DER)
+typedef struct OcspTestResponder {
+    byte*  response;
+    size_t responseSz;
+    int    requests;
+} OcspTestResponder;
+
+/* Stands in for the OCSP responder, answering with a canned response */
+static int test_OcspTestResponder(void* ctx, const char* url, int urlSz,
+                     unsigned char* request, int requestSz, unsigned char** response)
+{
+    OcspTestResponder* responder = (OcspTestResponder*)ctx;
+
+    (void)url;
+    (void)urlSz;
+    (void)request;
+    (void)requestSz;
+
+    responder->requests++;
+    *response = responder->response;
+    return (int)responder->responseSz;
+}
+#endif
+
+static void test_wolfSSL_CertManagerOCSPCache(void)
+{
+#if defined(HAVE_OCSP) && !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && \
+    !defined(NO_RSA) && !defined(NO_SHA) && !defined(NO_ASN_TIME) && \
+    defined(WOLFSSL_PEM_TO_DER)
+    const char* root_ca = "./certs/ocsp/root-ca-cert.pem";
+    const char* int1_ca = "./certs/ocsp/intermediate1-ca-cert.pem";
+    /* good status for intermediate CA 1, signed by root CA, next update 2040 */
+    const char* response = "./certs/ocsp/test-response-intermediate1.der";
+    OcspTestResponder responder;
+    byte*  pem;
+    size_t pemSz;
+    byte   der[FOURK_BUF];
+    int    derSz;
+    unsigned int hits, misses, refreshes;
+
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+
+    printf(testingFmt, "wolfSSL_CertManagerOCSPCache()");
+
+    XMEMSET(&responder, 0, sizeof(responder));
+    AssertIntEQ(0, load_file(response, &responder.response,
+                                                        &responder.responseSz));
+    AssertIntEQ(0, load_file(int1_ca, &pem, &pemSz));
+    derSz = wc_CertPemToDer(pem, (int)pemSz, der, sizeof(der), CERT_TYPE);
+    AssertIntGT(derSz, 0);
+    free(pem);
+
+    AssertNotNull(cm = wolfSSL_CertManagerNew());
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerLoadCA(cm, root_ca, NULL));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerEnableOCSP(cm,
+                           WOLFSSL_OCSP_URL_OVERRIDE | WOLFSSL_OCSP_NO_NONCE));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerSetOCSPOverrideURL(cm,
+                                                     "http://127.0.0.1:22221"));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerSetOCSP_Cb(cm,
+                                    test_OcspTestResponder, NULL, &responder));
+
+    /* first lookup goes to the responder, second is answered from cache */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerCheckOCSP(cm, der, derSz));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerCheckOCSP(cm, der, derSz));
+    AssertIntEQ(responder.requests, 1);
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerGetOCSPStats(cm,
+                                                   &hits, &misses, &refreshes));
+    AssertIntEQ(hits, 1);
+    AssertIntEQ(misses, 1);
+    AssertIntEQ(refreshes, 0);
+
+    /* nothing is close to its next update */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerRefreshOCSP(cm, 60));
+    AssertIntEQ(responder.requests, 1);
+
+    /* everything is within 30 years of its next update */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerRefreshOCSP(cm,
+                                                   30L * 365 * 24 * 60 * 60));
+    AssertIntEQ(responder.requests, 2);
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerGetOCSPStats(cm,
+                                                   NULL, NULL, &refreshes));
+    AssertIntEQ(refreshes, 1);
+
+    /* refreshed status is still served from cache */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerCheckOCSP(cm, der, derSz));
+    AssertIntEQ(responder.requests, 2);
+
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CertManagerGetOCSPStats(NULL,
+                                                   &hits, &misses, &refreshes));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CertManagerRefreshOCSP(NULL, 0));
+
+#ifdef HAVE_OCSP_REFRESH
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CertManagerStartOCSPRefresh(cm, 0, 0));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerStartOCSPRefresh(cm,
+                                                               3600, 60));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerStopOCSPRefresh(cm));
+    /* freeing the manager stops a running refresh thread */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerStartOCSPRefresh(cm,
+                                                               3600, 60));
+#endif
+
+    wolfSSL_CertManagerFree(cm);
+    free(responder.response);
+
+    printf(resultFmt, passed);
+#endif
+}
+
 static void test_wolfSSL_CTX_load_verify_locations_ex(void)
 {
 #if !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
@@ -5676,6 +5967,235 @@ static int test_wolfSSL_UseOCSPStaplingV2 (void)
 
 } /*END test_wolfSSL_UseOCSPStaplingV2*/
 
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER)
+/* One direction of an in memory client/server connection */
+typedef struct test_memio_pipe {
+    byte buf[16384];
+    int  len;
+} test_memio_pipe;
+
+typedef struct test_memio {
+    test_memio_pipe c2s;                /* client to server */
+    test_memio_pipe s2c;                /* server to client */
+} test_memio;
+
+static WC_INLINE int test_memio_recv(WOLFSSL* ssl, char* buf, int sz,
+                                     void* ctx)
+{
+    test_memio_pipe* in = (test_memio_pipe*)ctx;
+
+    (void)ssl;
+
+    if (in->len == 0)
+        return WOLFSSL_CBIO_ERR_WANT_READ;
+    if (sz > in->len)
+        sz = in->len;
+
+    XMEMCPY(buf, in->buf, sz);
+    XMEMMOVE(in->buf, in->buf + sz, in->len - sz);
+    in->len -= sz;
+
+    return sz;
+}
+
+static WC_INLINE int test_memio_send(WOLFSSL* ssl, char* buf, int sz,
+                                     void* ctx)
+{
+    test_memio_pipe* out = (test_memio_pipe*)ctx;
+
+    (void)ssl;
+
+    if (out->len + sz > (int)sizeof(out->buf))
+        return WOLFSSL_CBIO_ERR_WANT_WRITE;
+
+    XMEMCPY(out->buf + out->len, buf, sz);
+    out->len += sz;
+
+    return sz;
+}
+
+/* Connect a client and server through the empty buffers in io */
+static WC_INLINE void test_memio_setup(test_memio* io, WOLFSSL* clientSsl,
+                                       WOLFSSL* serverSsl)
+{
+    io->c2s.len = io->s2c.len = 0;
+
+    wolfSSL_SSLSetIORecv(clientSsl, test_memio_recv);
+    wolfSSL_SSLSetIOSend(clientSsl, test_memio_send);
+    wolfSSL_SetIOReadCtx(clientSsl, &io->s2c);
+    wolfSSL_SetIOWriteCtx(clientSsl, &io->c2s);
+    wolfSSL_SSLSetIORecv(serverSsl, test_memio_recv);
+    wolfSSL_SSLSetIOSend(serverSsl, test_memio_send);
+    wolfSSL_SetIOReadCtx(serverSsl, &io->c2s);
+    wolfSSL_SetIOWriteCtx(serverSsl, &io->s2c);
+}
+
+/* Step both ends of a non-blocking connection until their handshakes are
+ * done. WOLFSSL_FAILURE on any error other than waiting for the peer. */
+static WC_INLINE int test_handshake_pair(WOLFSSL* clientSsl,
+                                         WOLFSSL* serverSsl)
+{
+    int clientDone = 0, serverDone = 0;
+    int i;
+
+    for (i = 0; i < 20 && !(clientDone && serverDone); i++) {
+        if (!clientDone) {
+            if (wolfSSL_connect(clientSsl) == WOLFSSL_SUCCESS)
+                clientDone = 1;
+            else if (wolfSSL_get_error(clientSsl, 0) != WOLFSSL_ERROR_WANT_READ)
+                return WOLFSSL_FAILURE;
+        }
+        if (!serverDone) {
+            if (wolfSSL_accept(serverSsl) == WOLFSSL_SUCCESS)
+                serverDone = 1;
+            else if (wolfSSL_get_error(serverSsl, 0) != WOLFSSL_ERROR_WANT_READ)
+                return WOLFSSL_FAILURE;
+        }
+    }
+
+    return clientDone && serverDone ? WOLFSSL_SUCCESS : WOLFSSL_FAILURE;
+}
+
+/* Handshake a new client and server from the CTXs over memory buffers */
+static WC_INLINE int test_memio_handshake(WOLFSSL_CTX* clientCtx,
+                                          WOLFSSL_CTX* serverCtx)
+{
+    test_memio io;
+    WOLFSSL* clientSsl;
+    WOLFSSL* serverSsl;
+    int ret;
+
+    AssertNotNull(clientSsl = wolfSSL_new(clientCtx));
+    AssertNotNull(serverSsl = wolfSSL_new(serverCtx));
+    test_memio_setup(&io, clientSsl, serverSsl);
+
+    ret = test_handshake_pair(clientSsl, serverSsl);
+
+    wolfSSL_free(clientSsl);
+    wolfSSL_free(serverSsl);
+
+    return ret;
+}
+#endif /* !NO_WOLFSSL_CLIENT && !NO_WOLFSSL_SERVER */
+
+#if defined(WC_RSA_PRECOMPUTE) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_RSA_PUBLIC_ONLY)
+#include "wolfssl/internal.h" /* for the CTX RSA key */
+#endif
+
+/* Testing that handshakes sign with copies of the precomputed CTX RSA key */
+static void test_wolfSSL_CTX_RsaKeyCache(void)
+{
+#if defined(WOLFSSL_CTX_RSA_KEY) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER)
+    WOLFSSL_CTX* clientCtx;
+    WOLFSSL_CTX* serverCtx;
+    RsaKey*      rsaKey;
+
+    printf(testingFmt, "wolfSSL_CTX RSA key cache");
+
+    AssertNotNull(clientCtx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+    AssertNotNull(serverCtx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+    AssertTrue(wolfSSL_CTX_load_verify_locations(clientCtx, caCertFile, 0));
+    AssertTrue(wolfSSL_CTX_use_certificate_file(serverCtx, svrCertFile,
+                                                WOLFSSL_FILETYPE_PEM));
+    AssertTrue(wolfSSL_CTX_use_PrivateKey_file(serverCtx, svrKeyFile,
+                                               WOLFSSL_FILETYPE_PEM));
+
+    /* decoded by the first handshake that signs, kept for the next */
+    AssertNull(serverCtx->rsaKey);
+    AssertIntEQ(WOLFSSL_SUCCESS, test_memio_handshake(clientCtx, serverCtx));
+    AssertNotNull(rsaKey = serverCtx->rsaKey);
+    AssertIntEQ(WOLFSSL_SUCCESS, test_memio_handshake(clientCtx, serverCtx));
+    AssertPtrEq(serverCtx->rsaKey, rsaKey);
+
+    /* a new private key drops the decoded one */
+    AssertTrue(wolfSSL_CTX_use_PrivateKey_file(serverCtx, svrKeyFile,
+                                               WOLFSSL_FILETYPE_PEM));
+    AssertNull(serverCtx->rsaKey);
+    AssertIntEQ(WOLFSSL_SUCCESS, test_memio_handshake(clientCtx, serverCtx));
+    AssertNotNull(serverCtx->rsaKey);
+
+    wolfSSL_CTX_free(clientCtx);
+    wolfSSL_CTX_free(serverCtx);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+/* Testing that handshakes on one server CTX share the encoded status */
+static void test_wolfSSL_CTX_StapleCache(void)
+{
+#if defined(HAVE_CERTIFICATE_STATUS_REQUEST) && defined(HAVE_OCSP) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(NO_SHA) && !defined(NO_ASN_TIME) && \
+    defined(WOLFSSL_PEM_TO_DER) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_WOLFSSL_STAPLE_CACHE)
+    /* good status for server1, signed by intermediate CA 1 */
+    const char* response = "./certs/ocsp/test-response-server1.der";
+    OcspTestResponder responder;
+    WOLFSSL_CTX* clientCtx;
+    WOLFSSL_CTX* serverCtx;
+    unsigned int hits, misses, hitsNow;
+
+    printf(testingFmt, "wolfSSL_CTX_StapleCache()");
+
+    XMEMSET(&responder, 0, sizeof(responder));
+    AssertIntEQ(0, load_file(response, &responder.response,
+                                                        &responder.responseSz));
+
+    AssertNotNull(serverCtx = wolfSSL_CTX_new(wolfTLSv1_2_server_method()));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_use_certificate_chain_file(
+                                serverCtx, "./certs/ocsp/server1-cert.pem"));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_use_PrivateKey_file(serverCtx,
+                   "./certs/ocsp/server1-key.pem", WOLFSSL_FILETYPE_PEM));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_load_verify_locations(serverCtx,
+                                      "./certs/ocsp/root-ca-cert.pem", NULL));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_load_verify_locations(serverCtx,
+                             "./certs/ocsp/intermediate1-ca-cert.pem", NULL));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_EnableOCSPStapling(serverCtx));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_SetOCSP_Cb(serverCtx,
+                                    test_OcspTestResponder, NULL, &responder));
+
+    AssertNotNull(clientCtx = wolfSSL_CTX_new(wolfTLSv1_2_client_method()));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_load_verify_locations(clientCtx,
+                                      "./certs/ocsp/root-ca-cert.pem", NULL));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_EnableOCSPStapling(clientCtx));
+    AssertIntEQ(WOLFSSL_SUCCESS,
+                wolfSSL_CTX_UseOCSPStapling(clientCtx, WOLFSSL_CSR_OCSP, 0));
+
+    AssertIntEQ(WOLFSSL_SUCCESS, test_memio_handshake(clientCtx, serverCtx));
+    AssertIntEQ(responder.requests, 1);
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerGetOCSPStats(
+                  wolfSSL_CTX_GetCertManager(serverCtx), &hits, &misses, NULL));
+    AssertIntEQ(misses, 1);
+
+    /* the second handshake never looks in the OCSP cache */
+    AssertIntEQ(WOLFSSL_SUCCESS, test_memio_handshake(clientCtx, serverCtx));
+    AssertIntEQ(responder.requests, 1);
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerGetOCSPStats(
+                  wolfSSL_CTX_GetCertManager(serverCtx), &hitsNow, NULL, NULL));
+    AssertIntEQ(hitsNow, hits);
+
+    /* a refreshed status replaces the shared staple */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerRefreshOCSP(
+          wolfSSL_CTX_GetCertManager(serverCtx), 30L * 365 * 24 * 60 * 60));
+    AssertIntEQ(responder.requests, 2);
+    AssertIntEQ(WOLFSSL_SUCCESS, test_memio_handshake(clientCtx, serverCtx));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerGetOCSPStats(
+                  wolfSSL_CTX_GetCertManager(serverCtx), &hitsNow, NULL, NULL));
+    AssertIntGT(hitsNow, hits);
+    AssertIntEQ(responder.requests, 2);
+
+    wolfSSL_CTX_free(clientCtx);
+    wolfSSL_CTX_free(serverCtx);
+    free(responder.response);
+
+    printf(resultFmt, passed);
+#endif
+}
+
 /*----------------------------------------------------------------------------*
  | Multicast Tests
  *----------------------------------------------------------------------------*/
@@ -5718,6 +6238,224 @@ static void test_wolfSSL_mcast(void)
 #endif /* WOLFSSL_DTLS && WOLFSSL_MULTICAST */
 }
 
+#if (defined(WOLFSSL_IO_SENDV) || defined(WOLFSSL_ZERO_COPY_READ)) && \
+    defined(USE_WOLFSSL_IO) && !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && \
+    !defined(NO_RSA) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER)
+static byte test_sendMsg[5 * 16384 + 100];
+static byte test_sendGot[sizeof(test_sendMsg)];
+
+typedef struct SendBatchPair {
+    WOLFSSL_CTX* clientCtx;
+    WOLFSSL_CTX* serverCtx;
+    WOLFSSL*     client;
+    WOLFSSL*     server;
+    int          sv[2];
+} SendBatchPair;
+
+#ifdef WOLFSSL_IO_SENDV
+static int test_sendvCalls;
+static int test_sendvRecords;
+
+static int test_SendvCount(WOLFSSL* ssl, const struct iovec* iov, int iovcnt,
+                           void* ctx)
+{
+    test_sendvCalls++;
+    test_sendvRecords += iovcnt;
+
+    return EmbedSendv(ssl, iov, iovcnt, ctx);
+}
+#endif
+
+static int test_SendvRead(WOLFSSL* ssl, byte* buf, int sz)
+{
+    int got = 0;
+    int ret;
+
+    while (got < sz) {
+        ret = wolfSSL_read(ssl, buf + got, sz - got);
+        if (ret <= 0)
+            return ret;
+        got += ret;
+    }
+
+    return got;
+}
+
+/* Handshake a client and server over a non-blocking socketpair */
+static void test_SendBatchConnect(SendBatchPair* pair)
+{
+    int i;
+
+    for (i = 0; i < (int)sizeof(test_sendMsg); i++)
+        test_sendMsg[i] = (byte)i;
+
+    AssertIntEQ(socketpair(AF_UNIX, SOCK_STREAM, 0, pair->sv), 0);
+    tcp_set_nonblocking(&pair->sv[0]);
+    tcp_set_nonblocking(&pair->sv[1]);
+
+    AssertNotNull(pair->clientCtx =
+                               wolfSSL_CTX_new(wolfSSLv23_client_method()));
+    AssertNotNull(pair->serverCtx =
+                               wolfSSL_CTX_new(wolfSSLv23_server_method()));
+    AssertTrue(wolfSSL_CTX_load_verify_locations(pair->clientCtx, caCertFile,
+                                                                        0));
+    AssertTrue(wolfSSL_CTX_use_certificate_file(pair->serverCtx, svrCertFile,
+                                                       WOLFSSL_FILETYPE_PEM));
+    AssertTrue(wolfSSL_CTX_use_PrivateKey_file(pair->serverCtx, svrKeyFile,
+                                                       WOLFSSL_FILETYPE_PEM));
+
+    AssertNotNull(pair->client = wolfSSL_new(pair->clientCtx));
+    AssertNotNull(pair->server = wolfSSL_new(pair->serverCtx));
+    AssertIntEQ(wolfSSL_set_fd(pair->client, pair->sv[0]), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_set_fd(pair->server, pair->sv[1]), WOLFSSL_SUCCESS);
+
+    AssertIntEQ(test_handshake_pair(pair->client, pair->server),
+                                                              WOLFSSL_SUCCESS);
+}
+
+static void test_SendBatchFree(SendBatchPair* pair)
+{
+    wolfSSL_free(pair->client);
+    wolfSSL_free(pair->server);
+    wolfSSL_CTX_free(pair->clientCtx);
+    wolfSSL_CTX_free(pair->serverCtx);
+    close(pair->sv[0]);
+    close(pair->sv[1]);
+}
+#endif
+
+/* Testing that large writes leave as one vectored send of several records */
+static void test_wolfSSL_SSLSetIOSendv(void)
+{
+#if defined(WOLFSSL_IO_SENDV) && defined(USE_WOLFSSL_IO) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER)
+    SendBatchPair pair;
+    struct iovec iov[3];
+    byte* msg = test_sendMsg;
+    byte* got = test_sendGot;
+    int   msgSz = (int)sizeof(test_sendMsg);
+
+    printf(testingFmt, "wolfSSL_SSLSetIOSendv()");
+
+    test_SendBatchConnect(&pair);
+
+    /* six records coalesced into one call */
+    wolfSSL_SSLSetIOSendv(pair.client, test_SendvCount);
+    test_sendvCalls = test_sendvRecords = 0;
+    AssertIntEQ(wolfSSL_write(pair.client, msg, msgSz), msgSz);
+    AssertIntEQ(test_sendvCalls, 1);
+    AssertIntEQ(test_sendvRecords, 6);
+    AssertIntEQ(test_SendvRead(pair.server, got, msgSz), msgSz);
+    AssertIntEQ(XMEMCMP(msg, got, msgSz), 0);
+
+    /* records spanning entries are gathered, the rest read in place */
+    iov[0].iov_base = (char*)msg;
+    iov[0].iov_len  = 10;
+    iov[1].iov_base = (char*)msg + 10;
+    iov[1].iov_len  = 40000;
+    iov[2].iov_base = (char*)msg + 40010;
+    iov[2].iov_len  = 7;
+    test_sendvCalls = 0;
+    AssertIntEQ(wolfSSL_writev(pair.client, iov, 3), 40017);
+    AssertIntEQ(test_sendvCalls, 1);
+    XMEMSET(got, 0, msgSz);
+    AssertIntEQ(test_SendvRead(pair.server, got, 40017), 40017);
+    AssertIntEQ(XMEMCMP(msg, got, 40017), 0);
+
+    /* a plain send callback replaces the vectored one */
+    wolfSSL_SSLSetIOSend(pair.client, EmbedSend);
+    test_sendvCalls = 0;
+    AssertIntEQ(wolfSSL_write(pair.client, msg, 100), 100);
+    AssertIntEQ(test_sendvCalls, 0);
+    AssertIntEQ(test_SendvRead(pair.server, got, 100), 100);
+
+    AssertIntEQ(wolfSSL_writev(NULL, iov, 3), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_writev(pair.client, NULL, 1), BAD_FUNC_ARG);
+
+    test_SendBatchFree(&pair);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+/* Testing that borrowed plaintext is read in place from the record buffer */
+static void test_wolfSSL_read_borrow(void)
+{
+#if defined(WOLFSSL_ZERO_COPY_READ) && defined(USE_WOLFSSL_IO) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER)
+    SendBatchPair pair;
+    const unsigned char* data = NULL;
+    byte* msg = test_sendMsg;
+    byte* got = test_sendGot;
+    int   msgSz = (int)sizeof(test_sendMsg);
+    int   gotSz;
+    int   ret;
+    byte* readBuf;
+
+    printf(testingFmt, "wolfSSL_read_borrow()");
+
+    AssertIntEQ(wolfSSL_read_borrow(NULL, &data), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_read_release(NULL, 0), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_set_read_buffer(NULL, NULL, 0), BAD_FUNC_ARG);
+
+    AssertNotNull(readBuf = (byte*)XMALLOC(WOLFSSL_READ_BUFFER_SZ, NULL,
+                                           DYNAMIC_TYPE_TMP_BUFFER));
+
+    test_SendBatchConnect(&pair);
+    AssertIntEQ(wolfSSL_read_borrow(pair.server, NULL), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_set_read_buffer(pair.server, readBuf, 1),
+                                                              BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_set_read_buffer(pair.server, readBuf,
+                              WOLFSSL_READ_BUFFER_SZ), WOLFSSL_SUCCESS);
+
+    /* whole records read straight out of the caller's buffer */
+    AssertIntEQ(wolfSSL_write(pair.client, msg, msgSz), msgSz);
+    for (gotSz = 0; gotSz < msgSz; gotSz += ret) {
+        ret = wolfSSL_read_borrow(pair.server, &data);
+        AssertIntGT(ret, 0);
+        AssertTrue(data >= readBuf && data + ret <= readBuf +
+                                                     WOLFSSL_READ_BUFFER_SZ);
+        AssertIntEQ(XMEMCMP(data, msg + gotSz, ret), 0);
+        AssertIntEQ(wolfSSL_read_release(pair.server, ret + 1), BAD_FUNC_ARG);
+        AssertIntEQ(wolfSSL_read_release(pair.server, ret), WOLFSSL_SUCCESS);
+    }
+    AssertIntEQ(gotSz, msgSz);
+
+    /* partial release leaves the rest borrowed, readable with wolfSSL_read */
+    AssertIntEQ(wolfSSL_write(pair.client, msg, 1000), 1000);
+    AssertIntEQ(wolfSSL_read_borrow(pair.server, &data), 1000);
+    AssertIntEQ(wolfSSL_read_release(pair.server, 10), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_set_read_buffer(pair.server, NULL, 0), BAD_STATE_E);
+    AssertIntEQ(wolfSSL_read_borrow(pair.server, &data), 990);
+    AssertIntEQ(XMEMCMP(data, msg + 10, 990), 0);
+    AssertIntEQ(test_SendvRead(pair.server, got, 990), 990);
+    AssertIntEQ(XMEMCMP(got, msg + 10, 990), 0);
+
+    /* back on the internal buffer */
+    AssertIntEQ(wolfSSL_set_read_buffer(pair.server, NULL, 0),
+                                                           WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_write(pair.client, msg, msgSz), msgSz);
+    XMEMSET(got, 0, msgSz);
+    for (gotSz = 0; gotSz < msgSz; gotSz += ret) {
+        ret = wolfSSL_read_borrow(pair.server, &data);
+        AssertIntGT(ret, 0);
+        AssertFalse(data >= readBuf && data < readBuf +
+                                                     WOLFSSL_READ_BUFFER_SZ);
+        XMEMCPY(got + gotSz, data, ret);
+        AssertIntEQ(wolfSSL_read_release(pair.server, ret), WOLFSSL_SUCCESS);
+    }
+    AssertIntEQ(XMEMCMP(msg, got, msgSz), 0);
+
+    test_SendBatchFree(&pair);
+    XFREE(readBuf, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    printf(resultFmt, passed);
+#endif
+}
+
 
 /*----------------------------------------------------------------------------*
  |  Wolfcrypt
@@ -6638,6 +7376,129 @@ static int test_wc_Sha256Copy (void)
     return flag;
 
 } /* END test_wc_Sha256Copy */
+
+/*
+ * Unit test function for wc_Sha256_MultiBuffer() and
+ * wc_HmacSha256_MultiBuffer()
+ */
+static int test_wc_Sha256_MultiBuffer (void)
+{
+    int flag = 0;
+#if defined(WOLFSSL_SHA256_MULTI_BUFFER) && !defined(NO_SHA256)
+    static const word32 sizes[] = { 0, 1, 55, 56, 63, 64, 65, 119, 120, 200,
+                                    1000 };
+    #define MB_TEST_CNT (int)(sizeof(sizes) / sizeof(sizes[0]))
+    byte        buf[1000 + MB_TEST_CNT];
+    byte        hash[MB_TEST_CNT][WC_SHA256_DIGEST_SIZE];
+    byte        expect[WC_SHA256_DIGEST_SIZE];
+    const byte* data[MB_TEST_CNT];
+    word32      sz[MB_TEST_CNT];
+    byte*       out[MB_TEST_CNT];
+#ifndef NO_HMAC
+    const byte* key[MB_TEST_CNT];
+    word32      keySz[MB_TEST_CNT];
+    Hmac        hmac;
+#endif
+    int         i;
+
+    printf(testingFmt, "wc_Sha256_MultiBuffer()");
+
+    for (i = 0; i < (int)sizeof(buf); i++) {
+        buf[i] = (byte)(i * 7 + 3);
+    }
+    for (i = 0; i < MB_TEST_CNT; i++) {
+        data[i] = buf + i;
+        sz[i] = sizes[i];
+        out[i] = hash[i];
+    #ifndef NO_HMAC
+        key[i] = buf + MB_TEST_CNT - i;
+        keySz[i] = (word32)(i * 9);
+    #endif
+    }
+
+    flag = wc_Sha256_MultiBuffer(data, sz, out, MB_TEST_CNT);
+    for (i = 0; flag == 0 && i < MB_TEST_CNT; i++) {
+        flag = wc_Sha256Hash(data[i], sz[i], expect);
+        if (flag == 0 && XMEMCMP(hash[i], expect, sizeof(expect)) != 0) {
+            flag = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    /* Fewer messages than lanes. */
+    if (flag == 0) {
+        flag = wc_Sha256_MultiBuffer(data + 7, sz + 7, out, 3);
+    }
+    for (i = 0; flag == 0 && i < 3; i++) {
+        flag = wc_Sha256Hash(data[i + 7], sz[i + 7], expect);
+        if (flag == 0 && XMEMCMP(hash[i], expect, sizeof(expect)) != 0) {
+            flag = WOLFSSL_FATAL_ERROR;
+        }
+    }
+
+#ifndef NO_HMAC
+    if (flag == 0) {
+        flag = wc_HmacSha256_MultiBuffer(key, keySz, data, sz, out,
+                                         MB_TEST_CNT);
+    }
+    if (flag == 0) {
+        flag = wc_HmacInit(&hmac, NULL, INVALID_DEVID);
+    }
+    for (i = 0; flag == 0 && i < MB_TEST_CNT; i++) {
+        flag = wc_HmacSetKey(&hmac, WC_SHA256, key[i], keySz[i]);
+        if (flag == 0) {
+            flag = wc_HmacUpdate(&hmac, data[i], sz[i]);
+        }
+        if (flag == 0) {
+            flag = wc_HmacFinal(&hmac, expect);
+        }
+        if (flag == 0 && XMEMCMP(hash[i], expect, sizeof(expect)) != 0) {
+            flag = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    wc_HmacFree(&hmac);
+#endif
+
+    /* Bad arguments. */
+    if (flag == 0) {
+        if (wc_Sha256_MultiBuffer(NULL, sz, out, 1) != BAD_FUNC_ARG ||
+                wc_Sha256_MultiBuffer(data, NULL, out, 1) != BAD_FUNC_ARG ||
+                wc_Sha256_MultiBuffer(data, sz, NULL, 1) != BAD_FUNC_ARG) {
+            flag = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    if (flag == 0) {
+        out[1] = NULL;
+        if (wc_Sha256_MultiBuffer(data, sz, out, 2) != BAD_FUNC_ARG) {
+            flag = WOLFSSL_FATAL_ERROR;
+        }
+        out[1] = hash[1];
+    }
+    if (flag == 0) {
+        data[1] = NULL;
+        if (wc_Sha256_MultiBuffer(data, sz, out, 2) != BAD_FUNC_ARG) {
+            flag = WOLFSSL_FATAL_ERROR;
+        }
+        data[1] = buf;
+    }
+#ifndef NO_HMAC
+    if (flag == 0) {
+        if (wc_HmacSha256_MultiBuffer(NULL, keySz, data, sz, out, 1)
+                != BAD_FUNC_ARG ||
+            wc_HmacSha256_MultiBuffer(key, NULL, data, sz, out, 1)
+                != BAD_FUNC_ARG ||
+            wc_HmacSha256_MultiBuffer(key, keySz, data, sz, NULL, 1)
+                != BAD_FUNC_ARG) {
+            flag = WOLFSSL_FATAL_ERROR;
+        }
+    }
+#endif
+    #undef MB_TEST_CNT
+
+    printf(resultFmt, flag == 0 ? passed : failed);
+
+#endif
+    return flag;
+
+} /* END test_wc_Sha256_MultiBuffer */
 /*
  * Testing wc_InitSha512()
  */
@@ -9261,6 +10122,209 @@ static int test_wc_Shake256_Copy (void)
 
 } /* END test_wc_Shake256_Copy */
 
+/*
+ * Unit test function for wc_Shake128_SqueezeBlocks() and
+ * wc_Shake256_SqueezeBlocks()
+ */
+static int test_wc_Shake_SqueezeBlocks (void)
+{
+    int flag = 0;
+#if (defined(WOLFSSL_SHAKE128) && !defined(WOLFSSL_NO_SHAKE128)) || \
+    (defined(WOLFSSL_SHAKE256) && !defined(WOLFSSL_NO_SHAKE256))
+    wc_Shake    shake;
+    const char* msg = "Everyone gets Friday off.";
+    word32      msglen = (word32)XSTRLEN(msg);
+    byte        squeeze[2 * 168];
+    byte        hash[2 * 168];
+
+    printf(testingFmt, "wc_Shake_SqueezeBlocks()");
+
+#if defined(WOLFSSL_SHAKE128) && !defined(WOLFSSL_NO_SHAKE128)
+    flag = wc_InitShake128(&shake, HEAP_HINT, devId);
+    if (flag == 0) {
+        flag = wc_Shake128_Absorb(&shake, (byte*)msg, msglen);
+    }
+    if (flag == 0) {
+        flag = wc_Shake128_SqueezeBlocks(&shake, squeeze, 2);
+    }
+    if (flag == 0) {
+        flag = wc_InitShake128(&shake, HEAP_HINT, devId);
+    }
+    if (flag == 0) {
+        flag = wc_Shake128_Update(&shake, (byte*)msg, msglen);
+    }
+    if (flag == 0) {
+        flag = wc_Shake128_Final(&shake, hash, 2 * WC_SHAKE128_BLOCK_SIZE);
+    }
+    if (flag == 0 && XMEMCMP(squeeze, hash, 2 * WC_SHAKE128_BLOCK_SIZE) != 0) {
+        flag = WOLFSSL_FATAL_ERROR;
+    }
+    /* Bad arguments. */
+    if (flag == 0) {
+        if (wc_Shake128_Absorb(NULL, (byte*)msg, msglen) != BAD_FUNC_ARG ||
+                wc_Shake128_Absorb(&shake, NULL, 1) != BAD_FUNC_ARG ||
+                wc_Shake128_SqueezeBlocks(NULL, squeeze, 1) != BAD_FUNC_ARG ||
+                wc_Shake128_SqueezeBlocks(&shake, NULL, 1) != BAD_FUNC_ARG) {
+            flag = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    wc_Shake128_Free(&shake);
+#endif
+
+#if defined(WOLFSSL_SHAKE256) && !defined(WOLFSSL_NO_SHAKE256)
+    if (flag == 0) {
+        flag = wc_InitShake256(&shake, HEAP_HINT, devId);
+    }
+    if (flag == 0) {
+        flag = wc_Shake256_Absorb(&shake, (byte*)msg, msglen);
+    }
+    if (flag == 0) {
+        flag = wc_Shake256_SqueezeBlocks(&shake, squeeze, 2);
+    }
+    if (flag == 0) {
+        flag = wc_InitShake256(&shake, HEAP_HINT, devId);
+    }
+    if (flag == 0) {
+        flag = wc_Shake256_Update(&shake, (byte*)msg, msglen);
+    }
+    if (flag == 0) {
+        flag = wc_Shake256_Final(&shake, hash, 2 * WC_SHAKE256_BLOCK_SIZE);
+    }
+    if (flag == 0 && XMEMCMP(squeeze, hash, 2 * WC_SHAKE256_BLOCK_SIZE) != 0) {
+        flag = WOLFSSL_FATAL_ERROR;
+    }
+    /* Bad arguments. */
+    if (flag == 0) {
+        if (wc_Shake256_Absorb(NULL, (byte*)msg, msglen) != BAD_FUNC_ARG ||
+                wc_Shake256_Absorb(&shake, NULL, 1) != BAD_FUNC_ARG ||
+                wc_Shake256_SqueezeBlocks(NULL, squeeze, 1) != BAD_FUNC_ARG ||
+                wc_Shake256_SqueezeBlocks(&shake, NULL, 1) != BAD_FUNC_ARG) {
+            flag = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    wc_Shake256_Free(&shake);
+#endif
+
+    printf(resultFmt, flag == 0 ? passed : failed);
+
+#endif
+    return flag;
+
+} /* END test_wc_Shake_SqueezeBlocks */
+
+/*
+ * Unit test function for wc_Shake128_MultiBuffer() and
+ * wc_Shake256_MultiBuffer()
+ */
+static int test_wc_Shake_MultiBuffer (void)
+{
+    int flag = 0;
+#if (defined(WOLFSSL_SHAKE128) && !defined(WOLFSSL_NO_SHAKE128)) || \
+    (defined(WOLFSSL_SHAKE256) && !defined(WOLFSSL_NO_SHAKE256))
+    static const word32 sizes[] = { 0, 1, 135, 136, 137, 167, 168, 169, 300,
+                                    1000 };
+    #define MB_TEST_CNT (int)(sizeof(sizes) / sizeof(sizes[0]))
+    #define MB_OUT_SZ   400
+    byte        buf[1000 + MB_TEST_CNT];
+    byte        hash[MB_TEST_CNT][MB_OUT_SZ];
+    byte        expect[MB_OUT_SZ];
+    const byte* data[MB_TEST_CNT];
+    word32      sz[MB_TEST_CNT];
+    byte*       out[MB_TEST_CNT];
+    wc_Shake    shake;
+    word32      outSz;
+    int         i, j;
+
+    printf(testingFmt, "wc_Shake_MultiBuffer()");
+
+    for (i = 0; i < (int)sizeof(buf); i++) {
+        buf[i] = (byte)(i * 7 + 3);
+    }
+    for (i = 0; i < MB_TEST_CNT; i++) {
+        data[i] = buf + i;
+        sz[i] = sizes[i];
+        out[i] = hash[i];
+    }
+
+    /* Output of less than a block and of several blocks. */
+    for (j = 0; j < 2; j++) {
+        outSz = (j == 0) ? 32 : MB_OUT_SZ;
+    #if defined(WOLFSSL_SHAKE128) && !defined(WOLFSSL_NO_SHAKE128)
+        if (flag == 0) {
+            flag = wc_Shake128_MultiBuffer(data, sz, out, outSz, MB_TEST_CNT);
+        }
+        for (i = 0; flag == 0 && i < MB_TEST_CNT; i++) {
+            flag = wc_InitShake128(&shake, HEAP_HINT, devId);
+            if (flag == 0) {
+                flag = wc_Shake128_Update(&shake, data[i], sz[i]);
+            }
+            if (flag == 0) {
+                flag = wc_Shake128_Final(&shake, expect, outSz);
+            }
+            if (flag == 0 && XMEMCMP(hash[i], expect, outSz) != 0) {
+                flag = WOLFSSL_FATAL_ERROR;
+            }
+            wc_Shake128_Free(&shake);
+        }
+    #endif
+    #if defined(WOLFSSL_SHAKE256) && !defined(WOLFSSL_NO_SHAKE256)
+        if (flag == 0) {
+            flag = wc_Shake256_MultiBuffer(data, sz, out, outSz, MB_TEST_CNT);
+        }
+        for (i = 0; flag == 0 && i < MB_TEST_CNT; i++) {
+            flag = wc_InitShake256(&shake, HEAP_HINT, devId);
+            if (flag == 0) {
+                flag = wc_Shake256_Update(&shake, data[i], sz[i]);
+            }
+            if (flag == 0) {
+                flag = wc_Shake256_Final(&shake, expect, outSz);
+            }
+            if (flag == 0 && XMEMCMP(hash[i], expect, outSz) != 0) {
+                flag = WOLFSSL_FATAL_ERROR;
+            }
+            wc_Shake256_Free(&shake);
+        }
+    #endif
+    }
+
+    /* Bad arguments. */
+#if defined(WOLFSSL_SHAKE128) && !defined(WOLFSSL_NO_SHAKE128)
+    if (flag == 0) {
+        if (wc_Shake128_MultiBuffer(NULL, sz, out, 32, 1) != BAD_FUNC_ARG ||
+                wc_Shake128_MultiBuffer(data, NULL, out, 32, 1)
+                    != BAD_FUNC_ARG ||
+                wc_Shake128_MultiBuffer(data, sz, NULL, 32, 1)
+                    != BAD_FUNC_ARG) {
+            flag = WOLFSSL_FATAL_ERROR;
+        }
+    }
+#endif
+#if defined(WOLFSSL_SHAKE256) && !defined(WOLFSSL_NO_SHAKE256)
+    if (flag == 0) {
+        out[1] = NULL;
+        if (wc_Shake256_MultiBuffer(data, sz, out, 32, 2) != BAD_FUNC_ARG) {
+            flag = WOLFSSL_FATAL_ERROR;
+        }
+        out[1] = hash[1];
+    }
+    if (flag == 0) {
+        data[1] = NULL;
+        if (wc_Shake256_MultiBuffer(data, sz, out, 32, 2) != BAD_FUNC_ARG) {
+            flag = WOLFSSL_FATAL_ERROR;
+        }
+        data[1] = buf;
+    }
+#endif
+    #undef MB_OUT_SZ
+    #undef MB_TEST_CNT
+
+    printf(resultFmt, flag == 0 ? passed : failed);
+
+#endif
+    return flag;
+
+} /* END test_wc_Shake_MultiBuffer */
+
 
 /*
  * unit test for wc_IdeaSetKey()
@@ -14211,6 +15275,186 @@ static int test_wc_RsaSSL_SignVerify (void)
 
 } /* END test_wc_RsaSSL_SignVerify */
 
+/*
+ * Testing wc_RsaPrecompute()
+ */
+static int test_wc_RsaPrecompute (void)
+{
+    int     ret = 0;
+#if !defined(NO_RSA) && defined(WC_RSA_PRECOMPUTE) && \
+    !defined(WOLFSSL_RSA_PUBLIC_ONLY) && !defined(HAVE_USER_RSA)
+    RsaKey  key;
+    WC_RNG  rng;
+    const char* inStr = "Everyone gets Friday off.";
+    word32  inLen = (word32)XSTRLEN(inStr);
+    word32  idx = 0;
+    int     i;
+    byte    sig[RSA_MAX_SIZE / 8];
+    byte    sigPc[RSA_MAX_SIZE / 8];
+    byte    plain[RSA_MAX_SIZE / 8];
+    int     sigSz = 0;
+
+    printf(testingFmt, "wc_RsaPrecompute()");
+
+    ret = wc_InitRsaKey(&key, NULL);
+    if (ret == 0) {
+        ret = wc_InitRng(&rng);
+    }
+    if (ret == 0) {
+    #ifdef USE_CERT_BUFFERS_1024
+        ret = wc_RsaPrivateKeyDecode(client_key_der_1024, &idx, &key,
+                                     sizeof_client_key_der_1024);
+    #else
+        ret = wc_RsaPrivateKeyDecode(client_key_der_2048, &idx, &key,
+                                     sizeof_client_key_der_2048);
+    #endif
+    }
+    /* Reference signature without precomputation. */
+    if (ret == 0) {
+        sigSz = wc_RsaSSL_Sign((const byte*)inStr, inLen, sig, sizeof(sig),
+                               &key, &rng);
+        ret = (sigSz > 0) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    /* Test bad args. */
+    if (ret == 0) {
+        ret = wc_RsaPrecompute(NULL, &rng);
+        ret = (ret == BAD_FUNC_ARG) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    /* PKCS #1 v1.5 signatures are deterministic, so each signature made with
+     * the cached Montgomery values and refreshed blinding pair must match. */
+    if (ret == 0) {
+        ret = wc_RsaPrecompute(&key, &rng);
+    }
+    for (i = 0; ret == 0 && i < 5; i++) {
+        ret = wc_RsaSSL_Sign((const byte*)inStr, inLen, sigPc, sizeof(sigPc),
+                             &key, &rng);
+        if (ret != sigSz || XMEMCMP(sig, sigPc, sigSz) != 0) {
+            ret = WOLFSSL_FATAL_ERROR;
+        }
+        else {
+            ret = wc_RsaSSL_Verify(sigPc, sigSz, plain, sizeof(plain), &key);
+            ret = (ret == (int)inLen && XMEMCMP(plain, inStr, inLen) == 0) ?
+                  0 : WOLFSSL_FATAL_ERROR;
+        }
+    }
+    /* Without an RNG the blinding pair is made by the first private op. */
+    if (ret == 0) {
+        ret = wc_RsaPrecompute(&key, NULL);
+    }
+    for (i = 0; ret == 0 && i < 2; i++) {
+        ret = wc_RsaSSL_Sign((const byte*)inStr, inLen, sigPc, sizeof(sigPc),
+                             &key, &rng);
+        ret = (ret == sigSz && XMEMCMP(sig, sigPc, sigSz) == 0) ?
+              0 : WOLFSSL_FATAL_ERROR;
+    }
+
+    if (wc_FreeRsaKey(&key) || ret != 0) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    if (wc_FreeRng(&rng) || ret != 0) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+
+    printf(resultFmt, ret == 0 ? passed : failed);
+
+#endif
+    return ret;
+
+} /* END test_wc_RsaPrecompute */
+
+/*
+ * Testing wc_RsaPrecomputeCopy()
+ */
+static int test_wc_RsaPrecomputeCopy (void)
+{
+    int     ret = 0;
+#if !defined(NO_RSA) && defined(WC_RSA_PRECOMPUTE) && \
+    !defined(WOLFSSL_RSA_PUBLIC_ONLY) && !defined(HAVE_USER_RSA)
+    RsaKey  key;
+    RsaKey  copy;
+    WC_RNG  rng;
+    const char* inStr = "Everyone gets Friday off.";
+    word32  inLen = (word32)XSTRLEN(inStr);
+    word32  idx = 0;
+    int     i;
+    byte    sig[RSA_MAX_SIZE / 8];
+    byte    sigPc[RSA_MAX_SIZE / 8];
+    int     sigSz = 0;
+
+    printf(testingFmt, "wc_RsaPrecomputeCopy()");
+
+    ret = wc_InitRsaKey(&key, NULL);
+    if (ret == 0) {
+        ret = wc_InitRsaKey(&copy, NULL);
+    }
+    if (ret == 0) {
+        ret = wc_InitRng(&rng);
+    }
+    if (ret == 0) {
+    #ifdef USE_CERT_BUFFERS_1024
+        ret = wc_RsaPrivateKeyDecode(client_key_der_1024, &idx, &key,
+                                     sizeof_client_key_der_1024);
+    #else
+        ret = wc_RsaPrivateKeyDecode(client_key_der_2048, &idx, &key,
+                                     sizeof_client_key_der_2048);
+    #endif
+    }
+    if (ret == 0) {
+        sigSz = wc_RsaSSL_Sign((const byte*)inStr, inLen, sig, sizeof(sig),
+                               &key, &rng);
+        ret = (sigSz > 0) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    /* Test bad args, the source has to be precomputed. */
+    if (ret == 0) {
+        ret = wc_RsaPrecomputeCopy(&key, &copy, &rng);
+        ret = (ret == BAD_FUNC_ARG) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        ret = wc_RsaPrecompute(&key, &rng);
+    }
+    if (ret == 0) {
+        ret = wc_RsaPrecomputeCopy(NULL, &copy, &rng);
+        ret = (ret == BAD_FUNC_ARG) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        ret = wc_RsaPrecomputeCopy(&key, NULL, &rng);
+        ret = (ret == BAD_FUNC_ARG) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    /* The copy signs with the blinding pair it took, then a fresh one. */
+    if (ret == 0) {
+        ret = wc_RsaPrecomputeCopy(&key, &copy, &rng);
+    }
+    for (i = 0; ret == 0 && i < 2; i++) {
+        ret = wc_RsaSSL_Sign((const byte*)inStr, inLen, sigPc, sizeof(sigPc),
+                             &copy, &rng);
+        ret = (ret == sigSz && XMEMCMP(sig, sigPc, sigSz) == 0) ?
+              0 : WOLFSSL_FATAL_ERROR;
+    }
+    /* The source moved on to the next pair. */
+    if (ret == 0) {
+        ret = wc_RsaSSL_Sign((const byte*)inStr, inLen, sigPc, sizeof(sigPc),
+                             &key, &rng);
+        ret = (ret == sigSz && XMEMCMP(sig, sigPc, sigSz) == 0) ?
+              0 : WOLFSSL_FATAL_ERROR;
+    }
+
+    if (wc_FreeRsaKey(&copy) || ret != 0) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    if (wc_FreeRsaKey(&key) || ret != 0) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    if (wc_FreeRng(&rng) || ret != 0) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+
+    printf(resultFmt, ret == 0 ? passed : failed);
+
+#endif
+    return ret;
+
+} /* END test_wc_RsaPrecomputeCopy */
+
 /*
  * Testing wc_RsaEncryptSize()
  */
@@ -15783,6 +17027,250 @@ static int test_wc_ed25519_sign_msg (void)
 
 } /* END test_wc_ed25519_sign_msg */
 
+/*
+ * Testing wc_ed25519_verify_batch()
+ */
+static int test_wc_ed25519_verify_batch (void)
+{
+    int             ret = 0;
+
+#if defined(HAVE_ED25519) && defined(HAVE_ED25519_SIGN) && \
+    defined(HAVE_ED25519_VERIFY) && defined(WOLFSSL_VERIFY_BATCH)
+    WC_RNG          rng;
+    ed25519_key     key1;
+    ed25519_key     key2;
+    byte            msgBuf[10][16];
+    byte            sigBuf[10][ED25519_SIG_SIZE];
+    const byte*     msg[10];
+    const byte*     sig[10];
+    word32          msgLen[10];
+    word32          sigLen[10];
+    ed25519_key*    keys[10];
+    int             res[10];
+    int             i;
+    /* key of a valid point plus one of order 8, with a signature made with
+     * the private key of the valid point */
+    const byte      torPub[] = {
+        0xb5, 0x02, 0xff, 0x3d, 0x92, 0xe3, 0x1d, 0x81,
+        0x90, 0xb4, 0xaa, 0x4e, 0xa0, 0x41, 0x40, 0x05,
+        0x16, 0x7f, 0xad, 0x08, 0x9c, 0x4d, 0xe9, 0xda,
+        0xc8, 0xa2, 0xfc, 0x85, 0x0f, 0xed, 0x4f, 0x58
+    };
+    const byte      torMsg[] = {
+        0x74, 0x6f, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x01
+    };
+    const byte      torSig[] = {
+        0xb3, 0x1b, 0x20, 0xf5, 0x04, 0x26, 0x24, 0x25,
+        0x14, 0xd8, 0x1b, 0x38, 0x35, 0x48, 0xbd, 0x90,
+        0xde, 0x72, 0xfd, 0x0b, 0x8c, 0xf2, 0x38, 0x2a,
+        0x88, 0xf9, 0xf5, 0x2c, 0xe5, 0x07, 0x6b, 0x23,
+        0x51, 0xd2, 0x5d, 0xbc, 0x3b, 0xd0, 0x13, 0x2e,
+        0x05, 0xb5, 0xf7, 0x95, 0xa2, 0x03, 0xd1, 0x40,
+        0xbd, 0xff, 0x2c, 0x7d, 0x50, 0xb6, 0xae, 0x7b,
+        0x08, 0x23, 0x8d, 0x25, 0x8e, 0x33, 0xdd, 0x0f
+    };
+    /* valid key with a signature whose R has a component of order 8 */
+    const byte      rtorPub[] = {
+        0x03, 0xa1, 0x07, 0xbf, 0xf3, 0xce, 0x10, 0xbe,
+        0x1d, 0x70, 0xdd, 0x18, 0xe7, 0x4b, 0xc0, 0x99,
+        0x67, 0xe4, 0xd6, 0x30, 0x9b, 0xa5, 0x0d, 0x5f,
+        0x1d, 0xdc, 0x86, 0x64, 0x12, 0x55, 0x31, 0xb8
+    };
+    const byte      rtorSig[] = {
+        0x69, 0x14, 0x60, 0x32, 0x17, 0xb1, 0x81, 0x1a,
+        0x8d, 0x3b, 0xfe, 0x00, 0x97, 0xa6, 0xad, 0xae,
+        0x3f, 0x86, 0x33, 0x3d, 0x23, 0x0a, 0xdd, 0x7c,
+        0xa9, 0x63, 0xd1, 0x57, 0x36, 0xb2, 0x2b, 0xb4,
+        0x43, 0x60, 0xac, 0xe7, 0xf4, 0x74, 0x2a, 0x21,
+        0x57, 0xd3, 0x25, 0xd7, 0xa9, 0xf7, 0xce, 0x6b,
+        0xe7, 0x30, 0xdc, 0xdb, 0x08, 0x5a, 0x63, 0x82,
+        0xef, 0xf6, 0xfb, 0xf3, 0x3c, 0xbf, 0xcc, 0x01
+    };
+    /* key of order 8, its signature holds for every message cofactored */
+    const byte      smallPub[] = {
+        0xc7, 0x17, 0x6a, 0x70, 0x3d, 0x4d, 0xd8, 0x4f,
+        0xba, 0x3c, 0x0b, 0x76, 0x0d, 0x10, 0x67, 0x0f,
+        0x2a, 0x20, 0x53, 0xfa, 0x2c, 0x39, 0xcc, 0xc6,
+        0x4e, 0xc7, 0xfd, 0x77, 0x92, 0xac, 0x03, 0x7a
+    };
+    const byte      smallMsg[] = {
+        0x73, 0x6d, 0x61, 0x6c, 0x6c, 0x00
+    };
+    const byte      smallSig[] = {
+        0xb3, 0x1b, 0x20, 0xf5, 0x04, 0x26, 0x24, 0x25,
+        0x14, 0xd8, 0x1b, 0x38, 0x35, 0x48, 0xbd, 0x90,
+        0xde, 0x72, 0xfd, 0x0b, 0x8c, 0xf2, 0x38, 0x2a,
+        0x88, 0xf9, 0xf5, 0x2c, 0xe5, 0x07, 0x6b, 0x23,
+        0xe8, 0x78, 0xdc, 0xa5, 0x48, 0x66, 0x40, 0x51,
+        0xe5, 0xe6, 0x95, 0xd8, 0xc1, 0x57, 0xb5, 0x38,
+        0xa5, 0x06, 0xf9, 0xa3, 0xdd, 0x9f, 0x0e, 0x9c,
+        0xfe, 0xd7, 0xf4, 0xde, 0x62, 0x23, 0x82, 0x07
+    };
+    ed25519_key     torKey;
+    int             verify = 1;
+
+    ret = wc_InitRng(&rng);
+    if (ret == 0) {
+        ret = wc_ed25519_init(&torKey);
+    }
+    if (ret == 0) {
+        ret = wc_ed25519_init(&key1);
+    }
+    if (ret == 0) {
+        ret = wc_ed25519_init(&key2);
+    }
+    if (ret == 0) {
+        ret = wc_ed25519_make_key(&rng, ED25519_KEY_SIZE, &key1);
+    }
+    if (ret == 0) {
+        ret = wc_ed25519_make_key(&rng, ED25519_KEY_SIZE, &key2);
+    }
+    for (i = 0; ret == 0 && i < 10; i++) {
+        XMEMSET(msgBuf[i], i, sizeof(msgBuf[i]));
+        msg[i] = msgBuf[i];
+        sig[i] = sigBuf[i];
+        msgLen[i] = sizeof(msgBuf[i]);
+        sigLen[i] = sizeof(sigBuf[i]);
+        keys[i] = (i & 1) ? &key2 : &key1;
+        ret = wc_ed25519_sign_msg(msg[i], msgLen[i], sigBuf[i], &sigLen[i],
+                                  keys[i]);
+    }
+
+    printf(testingFmt, "wc_ed25519_verify_batch()");
+
+    if (ret == 0) {
+        ret = wc_ed25519_verify_batch(sig, sigLen, msg, msgLen, res, keys, 10,
+                                      &rng);
+        for (i = 0; ret == 0 && i < 10; i++) {
+            if (res[i] != 1)
+                ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    /* A bad signature, message and length only fail their own entries. */
+    if (ret == 0) {
+        sigBuf[3][ED25519_SIG_SIZE/2] ^= 1;
+        msgBuf[6][0] ^= 1;
+        sigLen[8] = ED25519_SIG_SIZE - 1;
+        ret = wc_ed25519_verify_batch(sig, sigLen, msg, msgLen, res, keys, 10,
+                                      &rng);
+        if (ret == SIG_VERIFY_E) {
+            ret = 0;
+            for (i = 0; ret == 0 && i < 10; i++) {
+                if (res[i] != ((i == 3 || i == 6 || i == 8) ? 0 : 1))
+                    ret = WOLFSSL_FATAL_ERROR;
+            }
+        }
+        else if (ret == 0) {
+            ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    /* Torsioned keys and R values verify cofactored, alone as in a batch. */
+    for (i = 0; ret == 0 && i < 2; i++) {
+        const byte* pub  = (i == 0) ? torPub : rtorPub;
+        const byte* tSig = (i == 0) ? torSig : rtorSig;
+
+        ret = wc_ed25519_import_public(pub, ED25519_PUB_KEY_SIZE, &torKey);
+        if (ret == 0) {
+            ret = wc_ed25519_verify_msg(tSig, ED25519_SIG_SIZE, torMsg,
+                                        sizeof(torMsg), &verify, &torKey);
+        #ifndef ED25519_SMALL
+            if (ret != 0 || verify != 1) {
+                ret = WOLFSSL_FATAL_ERROR;
+            }
+        #else
+            if (ret == SIG_VERIFY_E && verify == 0) {
+                ret = 0;
+            }
+        #endif
+        }
+        if (ret == 0) {
+            sig[1] = tSig;
+            msg[1] = torMsg;
+            msgLen[1] = sizeof(torMsg);
+            keys[1] = &torKey;
+            ret = wc_ed25519_verify_batch(sig, sigLen, msg, msgLen, res, keys,
+                                          2, &rng);
+            if (ret == SIG_VERIFY_E && verify == 0) {
+                ret = 0;
+            }
+            if (ret == 0 && (res[0] != 1 || res[1] != verify)) {
+                ret = WOLFSSL_FATAL_ERROR;
+            }
+        }
+    }
+    /* A key of small order is rejected alone and in a batch. */
+    if (ret == 0) {
+        ret = wc_ed25519_import_public(smallPub, sizeof(smallPub), &torKey);
+    }
+    if (ret == 0) {
+        ret = wc_ed25519_verify_msg(smallSig, sizeof(smallSig), smallMsg,
+                                    sizeof(smallMsg), &verify, &torKey);
+        if (ret == SIG_VERIFY_E && verify == 0) {
+            ret = 0;
+        } else {
+            ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    if (ret == 0) {
+        sig[1] = smallSig;
+        msg[1] = smallMsg;
+        msgLen[1] = sizeof(smallMsg);
+        ret = wc_ed25519_verify_batch(sig, sigLen, msg, msgLen, res, keys, 2,
+                                      &rng);
+        if (ret == SIG_VERIFY_E && res[0] == 1 && res[1] == 0) {
+            ret = 0;
+        } else {
+            ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    if (ret == 0) {
+        sig[1] = sigBuf[1];
+        msg[1] = msgBuf[1];
+        msgLen[1] = sizeof(msgBuf[1]);
+        keys[1] = &key2;
+    }
+    /* Test bad args. */
+    if (ret == 0) {
+        ret = wc_ed25519_verify_batch(NULL, sigLen, msg, msgLen, res, keys,
+                                      10, &rng);
+        if (ret == BAD_FUNC_ARG) {
+            ret = wc_ed25519_verify_batch(sig, sigLen, msg, msgLen, NULL, keys,
+                                          10, &rng);
+        }
+        if (ret == BAD_FUNC_ARG) {
+            ret = wc_ed25519_verify_batch(sig, sigLen, msg, msgLen, res, keys,
+                                          0, &rng);
+        }
+        if (ret == BAD_FUNC_ARG) {
+            ret = wc_ed25519_verify_batch(sig, sigLen, msg, msgLen, res, keys,
+                                          10, NULL);
+        }
+        if (ret == BAD_FUNC_ARG) {
+            keys[5] = NULL;
+            ret = wc_ed25519_verify_batch(sig, sigLen, msg, msgLen, res, keys,
+                                          10, &rng);
+        }
+        if (ret == BAD_FUNC_ARG) {
+            ret = 0;
+        } else if (ret == 0) {
+            ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+
+    if (wc_FreeRng(&rng) && ret == 0) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+
+    printf(resultFmt, ret == 0 ? passed : failed);
+
+    wc_ed25519_free(&torKey);
+    wc_ed25519_free(&key1);
+    wc_ed25519_free(&key2);
+#endif
+    return ret;
+
+} /* END test_wc_ed25519_verify_batch */
+
 /*
  * Testing wc_ed25519_import_public()
  */
@@ -18879,6 +20367,115 @@ static int test_wc_ecc_signVerify_hash (void)
 
 } /*  END test_wc_ecc_sign_hash */
 
+/*
+ * Testing wc_ecc_verify_hash_batch()
+ */
+static int test_wc_ecc_verify_hash_batch (void)
+{
+    int         ret = 0;
+
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && \
+    defined(HAVE_ECC_VERIFY) && !defined(NO_ASN) && \
+    !defined(WC_NO_RNG) && defined(WOLFSSL_VERIFY_BATCH)
+    WC_RNG      rng;
+    ecc_key     key1;
+    ecc_key     key2;
+    byte        hashBuf[10][WC_SHA256_DIGEST_SIZE];
+    byte        sigBuf[10][ECC_MAX_SIG_SIZE];
+    const byte* hash[10];
+    const byte* sig[10];
+    word32      hashLen[10];
+    word32      sigLen[10];
+    ecc_key*    keys[10];
+    int         res[10];
+    int         i;
+
+    XMEMSET(&key1, 0, sizeof(key1));
+    XMEMSET(&key2, 0, sizeof(key2));
+
+    ret = wc_InitRng(&rng);
+    if (ret == 0) {
+        ret = wc_ecc_init(&key1);
+    }
+    if (ret == 0) {
+        ret = wc_ecc_init(&key2);
+    }
+    if (ret == 0) {
+        ret = wc_ecc_make_key(&rng, KEY32, &key1);
+    }
+    if (ret == 0) {
+        ret = wc_ecc_make_key(&rng, KEY32, &key2);
+    }
+    for (i = 0; ret == 0 && i < 10; i++) {
+        XMEMSET(hashBuf[i], i, sizeof(hashBuf[i]));
+        hash[i] = hashBuf[i];
+        sig[i] = sigBuf[i];
+        hashLen[i] = sizeof(hashBuf[i]);
+        sigLen[i] = sizeof(sigBuf[i]);
+        keys[i] = (i & 1) ? &key2 : &key1;
+        ret = wc_ecc_sign_hash(hash[i], hashLen[i], sigBuf[i], &sigLen[i],
+                               &rng, keys[i]);
+    }
+
+    printf(testingFmt, "wc_ecc_verify_hash_batch()");
+
+    if (ret == 0) {
+        ret = wc_ecc_verify_hash_batch(sig, sigLen, hash, hashLen, res, keys,
+                                       10);
+        for (i = 0; ret == 0 && i < 10; i++) {
+            if (res[i] != 1)
+                ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    /* A bad signature, hash and encoding only fail their own entries. */
+    if (ret == 0) {
+        sigBuf[2][sigLen[2] - 1] ^= 1;
+        hashBuf[5][0] ^= 1;
+        sigLen[8] = 3;
+        ret = wc_ecc_verify_hash_batch(sig, sigLen, hash, hashLen, res, keys,
+                                       10);
+        for (i = 0; ret == 0 && i < 10; i++) {
+            if (res[i] != ((i == 2 || i == 5 || i == 8) ? 0 : 1))
+                ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    /* Test bad args. */
+    if (ret == 0) {
+        ret = wc_ecc_verify_hash_batch(NULL, sigLen, hash, hashLen, res, keys,
+                                       10);
+        if (ret == ECC_BAD_ARG_E) {
+            ret = wc_ecc_verify_hash_batch(sig, sigLen, hash, hashLen, NULL,
+                                           keys, 10);
+        }
+        if (ret == ECC_BAD_ARG_E) {
+            ret = wc_ecc_verify_hash_batch(sig, sigLen, hash, hashLen, res,
+                                           keys, 0);
+        }
+        if (ret == ECC_BAD_ARG_E) {
+            keys[4] = NULL;
+            ret = wc_ecc_verify_hash_batch(sig, sigLen, hash, hashLen, res,
+                                           keys, 10);
+        }
+        if (ret == ECC_BAD_ARG_E) {
+            ret = 0;
+        } else if (ret == 0) {
+            ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+
+    if (wc_FreeRng(&rng) && ret == 0) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+
+    printf(resultFmt, ret == 0 ? passed : failed);
+
+    wc_ecc_free(&key1);
+    wc_ecc_free(&key2);
+#endif
+    return ret;
+
+} /* END test_wc_ecc_verify_hash_batch */
+
 
 /*
  * Testing wc_ecc_shared_secret()
@@ -20247,6 +21844,88 @@ static int test_wc_ecc_shared_secret_ssh (void)
 
 } /* END test_wc_ecc_shared_secret_ssh */
 
+/*
+ * Testing wc_ecc_fp_set_entries() with more keys than cache entries
+ */
+static int test_wc_ecc_fp_set_entries (void)
+{
+    int             ret = 0;
+
+#if defined(HAVE_ECC) && defined(FP_ECC) && defined(HAVE_ECC_SIGN) && \
+    defined(HAVE_ECC_VERIFY) && !defined(WC_NO_RNG)
+    ecc_key         key[4];
+    WC_RNG          rng;
+    byte            hash[32];
+    byte            sig[ECC_MAX_SIG_SIZE];
+    word32          sigSz;
+    int             verify;
+    int             i, j;
+
+    printf(testingFmt, "wc_ecc_fp_set_entries()");
+
+    XMEMSET(&rng, 0, sizeof(rng));
+    XMEMSET(key, 0, sizeof(key));
+    XMEMSET(hash, 0x5a, sizeof(hash));
+
+    /* Test bad args. */
+    if (wc_ecc_fp_set_entries(1) != BAD_FUNC_ARG ||
+            wc_ecc_fp_set_entries(0x7fffffff) != BAD_FUNC_ARG) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        ret = wc_ecc_fp_set_entries(2);
+    }
+    if (ret == 0) {
+        ret = wc_InitRng(&rng);
+    }
+    for (i = 0; ret == 0 && i < 4; i++) {
+        ret = wc_ecc_init(&key[i]);
+        if (ret == 0) {
+            ret = wc_ecc_make_key(&rng, KEY32, &key[i]);
+        }
+    }
+
+    /* Keys evict each other while the generator LUT stays put. */
+    for (j = 0; ret == 0 && j < 3; j++) {
+        for (i = 0; ret == 0 && i < 4; i++) {
+            hash[0] = (byte)(i + j);
+            sigSz = sizeof(sig);
+            ret = wc_ecc_sign_hash(hash, sizeof(hash), sig, &sigSz, &rng,
+                                   &key[i]);
+            if (ret == 0) {
+                ret = wc_ecc_verify_hash(sig, sigSz, hash, sizeof(hash),
+                                         &verify, &key[i]);
+                if (ret == 0 && verify != 1) {
+                    ret = WOLFSSL_FATAL_ERROR;
+                }
+            }
+            if (ret == 0) {
+                ret = wc_ecc_verify_hash(sig, sigSz, hash, sizeof(hash),
+                                         &verify, &key[(i + 1) % 4]);
+                if (ret == 0 && verify != 0) {
+                    ret = WOLFSSL_FATAL_ERROR;
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < 4; i++) {
+        wc_ecc_free(&key[i]);
+    }
+    if (wc_FreeRng(&rng) && ret == 0) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    if (wc_ecc_fp_set_entries(15) != 0 && ret == 0) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    wc_ecc_fp_free();
+
+    printf(resultFmt, ret == 0 ? passed : failed);
+#endif
+    return ret;
+
+} /* END test_wc_ecc_fp_set_entries */
+
 /*
  * Testing wc_ecc_verify_hash_ex() and wc_ecc_verify_hash_ex()
  */
@@ -22617,6 +24296,333 @@ static int test_wc_SignatureGetSize_rsa(void)
    return ret;
 }/* END test_wc_SignatureGetSize_rsa(void) */
 
+/*
+ * Testing wc_SignatureBatchInit(), wc_SignatureBatchSubmit(),
+ * wc_SignatureBatchPoll(), wc_SignatureBatchFlush() and
+ * wc_SignatureBatchFree()
+ */
+static int test_wc_SignatureBatch(void)
+{
+    int ret = 0;
+#if defined(WOLFSSL_SIGN_BATCH) && !defined(NO_SIG_WRAPPER)
+    WC_RNG               rng;
+    wc_SignatureBatch    batch;
+    wc_SignatureBatchReq req[WC_SIG_BATCH_MAX + 3];
+    word32               sigSz[WC_SIG_BATCH_MAX + 3];
+    byte                 hash[WC_SIG_BATCH_MAX + 3][WC_SHA256_DIGEST_SIZE];
+    int                  i;
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && \
+    defined(HAVE_ECC_VERIFY) && !defined(NO_ASN)
+    ecc_key              eccKey;
+    byte                 eccSig[WC_SIG_BATCH_MAX + 3][ECC_MAX_SIG_SIZE];
+    int                  verify;
+#endif
+#if !defined(NO_RSA) && !defined(WOLFSSL_RSA_PUBLIC_ONLY) && \
+    !defined(HAVE_USER_RSA)
+    RsaKey               rsaKey;
+    byte                 rsaSig[3][RSA_MAX_SIZE / 8];
+    byte                 rsaRef[RSA_MAX_SIZE / 8];
+    word32               idx = 0;
+    int                  refSz = 0;
+#endif
+
+    printf(testingFmt, "wc_SignatureBatch()");
+
+    /* Queued requests reference the hash so each needs its own buffer. */
+    for (i = 0; i < WC_SIG_BATCH_MAX + 3; i++) {
+        XMEMSET(hash[i], (byte)i, WC_SHA256_DIGEST_SIZE);
+    }
+
+    ret = wc_InitRng(&rng);
+
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && \
+    defined(HAVE_ECC_VERIFY) && !defined(NO_ASN)
+    if (ret == 0) {
+        ret = wc_ecc_init(&eccKey);
+    }
+    if (ret == 0) {
+        ret = wc_ecc_make_key(&rng, 32, &eccKey);
+    }
+    /* Test bad args. */
+    if (ret == 0) {
+        ret = wc_SignatureBatchInit(NULL, WC_SIGNATURE_TYPE_ECC, &eccKey,
+                                    sizeof(eccKey), &rng);
+        if (ret == BAD_FUNC_ARG) {
+            ret = wc_SignatureBatchInit(&batch, WC_SIGNATURE_TYPE_RSA_W_ENC,
+                                        &eccKey, sizeof(eccKey), &rng);
+        }
+        if (ret == BAD_FUNC_ARG) {
+            ret = wc_SignatureBatchInit(&batch, WC_SIGNATURE_TYPE_ECC,
+                                        &eccKey, sizeof(eccKey), NULL);
+        }
+        ret = (ret == BAD_FUNC_ARG) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        ret = wc_SignatureBatchInit(&batch, WC_SIGNATURE_TYPE_ECC, &eccKey,
+                                    sizeof(eccKey), &rng);
+    }
+    /* The request that fills the batch runs it. */
+    for (i = 0; ret == 0 && i < WC_SIG_BATCH_MAX + 3; i++) {
+        sigSz[i] = ECC_MAX_SIG_SIZE;
+        ret = wc_SignatureBatchSubmit(&batch, &req[i], hash[i],
+                                      sizeof(hash[i]), eccSig[i], &sigSz[i]);
+        if (i == WC_SIG_BATCH_MAX - 1)
+            ret = (ret == 0) ? 0 : WOLFSSL_FATAL_ERROR;
+        else
+            ret = (ret == WC_PENDING_E) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        ret = wc_SignatureBatchPoll(&batch, &req[WC_SIG_BATCH_MAX]);
+        ret = (ret == WC_PENDING_E) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        ret = wc_SignatureBatchFlush(&batch);
+    }
+    for (i = 0; ret == 0 && i < WC_SIG_BATCH_MAX + 3; i++) {
+        ret = wc_SignatureBatchPoll(&batch, &req[i]);
+        if (ret == 0) {
+            verify = 0;
+            ret = wc_ecc_verify_hash(eccSig[i], sigSz[i], hash[i],
+                                     sizeof(hash[i]), &verify, &eccKey);
+            if (ret == 0 && verify != 1)
+                ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    if (ret == 0) {
+        wc_SignatureBatchFree(&batch);
+    }
+    wc_ecc_free(&eccKey);
+#endif
+
+#if !defined(NO_RSA) && !defined(WOLFSSL_RSA_PUBLIC_ONLY) && \
+    !defined(HAVE_USER_RSA)
+    if (ret == 0) {
+        ret = wc_InitRsaKey(&rsaKey, NULL);
+    }
+    if (ret == 0) {
+    #ifdef USE_CERT_BUFFERS_1024
+        ret = wc_RsaPrivateKeyDecode(client_key_der_1024, &idx, &rsaKey,
+                                     sizeof_client_key_der_1024);
+    #else
+        ret = wc_RsaPrivateKeyDecode(client_key_der_2048, &idx, &rsaKey,
+                                     sizeof_client_key_der_2048);
+    #endif
+    }
+    if (ret == 0) {
+        refSz = wc_RsaSSL_Sign(hash[0], sizeof(hash[0]), rsaRef,
+                               sizeof(rsaRef), &rsaKey, &rng);
+        ret = (refSz > 0) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        ret = wc_SignatureBatchInit(&batch, WC_SIGNATURE_TYPE_RSA, &rsaKey,
+                                    sizeof(rsaKey), &rng);
+    }
+    for (i = 0; ret == 0 && i < 3; i++) {
+        sigSz[i] = sizeof(rsaSig[i]);
+        ret = wc_SignatureBatchSubmit(&batch, &req[i], hash[0],
+                                      sizeof(hash[0]), rsaSig[i], &sigSz[i]);
+        ret = (ret == WC_PENDING_E) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    /* Free runs what is still queued. */
+    if (ret == 0) {
+        wc_SignatureBatchFree(&batch);
+    }
+    for (i = 0; ret == 0 && i < 3; i++) {
+        if (req[i].ret != 0 || (int)sigSz[i] != refSz ||
+                XMEMCMP(rsaSig[i], rsaRef, refSz) != 0) {
+            ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    wc_FreeRsaKey(&rsaKey);
+#endif
+
+    if (wc_FreeRng(&rng) || ret != 0) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+
+    printf(resultFmt, ret == 0 ? passed : failed);
+#endif
+    return ret;
+}/* END test_wc_SignatureBatch */
+
+/*
+ * Testing wc_CryptoCb_QueueInit(), wc_CryptoCb_QueuePoll(),
+ * wc_CryptoCb_QueueWait() and wc_CryptoCb_QueueFree() with the software
+ * device
+ */
+static int test_wc_CryptoCb_Queue(void)
+{
+    int ret = 0;
+#ifdef WOLF_CRYPTO_CB_QUEUE
+    const int         queueDevId = 7;
+    wc_CryptoCbQueue* queue = NULL;
+    WC_RNG            rng;
+    byte              hash[WC_SHA256_DIGEST_SIZE];
+    int               res;
+    int               i;
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && \
+    defined(HAVE_ECC_VERIFY) && !defined(NO_ASN)
+    ecc_key           eccKey[4];
+    byte              eccSig[4][ECC_MAX_SIG_SIZE];
+    word32            eccSigSz[4];
+    int               verify[4];
+    WOLF_EVENT*       events[4];
+    int               count;
+    int               done;
+#endif
+#if !defined(NO_RSA) && !defined(WOLFSSL_RSA_PUBLIC_ONLY) && \
+    !defined(HAVE_USER_RSA)
+    RsaKey            rsaKey;
+    RsaKey            rsaRef;
+    byte              rsaSig[RSA_MAX_SIZE / 8];
+    byte              rsaRefSig[RSA_MAX_SIZE / 8];
+    word32            idx;
+    int               refSz = 0;
+#endif
+
+    printf(testingFmt, "wc_CryptoCb_Queue()");
+
+    XMEMSET(hash, 0x5a, sizeof(hash));
+
+    ret = wc_InitRng(&rng);
+
+    /* Test bad args. */
+    if (ret == 0) {
+        ret = wc_CryptoCb_QueueInit(NULL, queueDevId, 2, NULL, NULL,
+                                    HEAP_HINT);
+        if (ret == BAD_FUNC_ARG) {
+            ret = wc_CryptoCb_QueueInit(&queue, INVALID_DEVID, 2, NULL, NULL,
+                                        HEAP_HINT);
+        }
+        if (ret == BAD_FUNC_ARG) {
+            ret = wc_CryptoCb_QueueInit(&queue, queueDevId, 0, NULL, NULL,
+                                        HEAP_HINT);
+        }
+        ret = (ret == BAD_FUNC_ARG) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        ret = wc_CryptoCb_QueueInit(&queue, queueDevId, 2, NULL, NULL,
+                                    HEAP_HINT);
+    }
+
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && \
+    defined(HAVE_ECC_VERIFY) && !defined(NO_ASN)
+    for (i = 0; i < 4; i++) {
+        wc_ecc_init_ex(&eccKey[i], HEAP_HINT, queueDevId);
+    }
+    /* Key generation completes on the device. */
+    for (i = 0; ret == 0 && i < 4; i++) {
+        ret = wc_ecc_make_key(&rng, 32, &eccKey[i]);
+        ret = (ret == WC_PENDING_E) ? 0 : WOLFSSL_FATAL_ERROR;
+        if (ret == 0) {
+            ret = wc_CryptoCb_QueueWait(queue, &eccKey[i], &res);
+        }
+        if (ret == 0) {
+            ret = res;
+        }
+    }
+    /* Post a batch of signatures then collect the completions. */
+    for (i = 0; ret == 0 && i < 4; i++) {
+        eccSigSz[i] = ECC_MAX_SIG_SIZE;
+        ret = wc_ecc_sign_hash(hash, sizeof(hash), eccSig[i], &eccSigSz[i],
+                               &rng, &eccKey[i]);
+        ret = (ret == WC_PENDING_E) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    for (done = 0; ret == 0 && done < 4; done += count) {
+        ret = wc_CryptoCb_QueuePoll(queue, NULL, events, 4, &count);
+        for (i = 0; ret == 0 && i < count; i++) {
+            if (events[i]->type != WOLF_EVENT_TYPE_CRYPTOCB ||
+                    events[i]->state != WOLF_EVENT_STATE_DONE ||
+                    events[i]->ret != 0) {
+                ret = WOLFSSL_FATAL_ERROR;
+            }
+            wc_CryptoCb_QueueEventFree(queue, events[i]);
+        }
+    }
+    for (i = 0; ret == 0 && i < 4; i++) {
+        verify[i] = 0;
+        ret = wc_ecc_verify_hash(eccSig[i], eccSigSz[i], hash, sizeof(hash),
+                                 &verify[i], &eccKey[i]);
+        ret = (ret == WC_PENDING_E) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    for (i = 0; ret == 0 && i < 4; i++) {
+        ret = wc_CryptoCb_QueueWait(queue, &eccKey[i], &res);
+        if (ret == 0 && (res != 0 || verify[i] != 1)) {
+            ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    if (ret == 0) {
+        ret = wc_CryptoCb_QueueWait(queue, &eccKey[0], &res);
+        ret = (ret == WC_NOT_PENDING_E) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    for (i = 0; i < 4; i++) {
+        wc_ecc_free(&eccKey[i]);
+    }
+#endif
+
+#if !defined(NO_RSA) && !defined(WOLFSSL_RSA_PUBLIC_ONLY) && \
+    !defined(HAVE_USER_RSA)
+    if (ret == 0) {
+        ret = wc_InitRsaKey_ex(&rsaRef, HEAP_HINT, INVALID_DEVID);
+    }
+    if (ret == 0) {
+        ret = wc_InitRsaKey_ex(&rsaKey, HEAP_HINT, queueDevId);
+    }
+    for (i = 0; ret == 0 && i < 2; i++) {
+        idx = 0;
+    #ifdef USE_CERT_BUFFERS_1024
+        ret = wc_RsaPrivateKeyDecode(client_key_der_1024, &idx,
+                                     i == 0 ? &rsaRef : &rsaKey,
+                                     sizeof_client_key_der_1024);
+    #else
+        ret = wc_RsaPrivateKeyDecode(client_key_der_2048, &idx,
+                                     i == 0 ? &rsaRef : &rsaKey,
+                                     sizeof_client_key_der_2048);
+    #endif
+    }
+    if (ret == 0) {
+        refSz = wc_RsaSSL_Sign(hash, sizeof(hash), rsaRefSig,
+                               sizeof(rsaRefSig), &rsaRef, &rng);
+        ret = (refSz > 0) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    /* RSA is finished by calling again once the device completes. */
+    if (ret == 0) {
+        ret = wc_RsaSSL_Sign(hash, sizeof(hash), rsaSig, sizeof(rsaSig),
+                             &rsaKey, &rng);
+        ret = (ret == WC_PENDING_E) ? 0 : WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        ret = wc_CryptoCb_QueueWait(queue, &rsaKey, &res);
+    }
+    if (ret == 0 && res < 0) {
+        ret = res;
+    }
+    if (ret == 0) {
+        ret = wc_RsaSSL_Sign(hash, sizeof(hash), rsaSig, sizeof(rsaSig),
+                             &rsaKey, &rng);
+        if (ret != refSz || XMEMCMP(rsaSig, rsaRefSig, refSz) != 0) {
+            ret = WOLFSSL_FATAL_ERROR;
+        }
+        else {
+            ret = 0;
+        }
+    }
+    wc_FreeRsaKey(&rsaKey);
+    wc_FreeRsaKey(&rsaRef);
+#endif
+
+    /* Posted operations are released with the queue. */
+    wc_CryptoCb_QueueFree(queue);
+
+    if (wc_FreeRng(&rng) || ret != 0) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+
+    printf(resultFmt, ret == 0 ? passed : failed);
+#endif
+    return ret;
+}/* END test_wc_CryptoCb_Queue */
+
 /*----------------------------------------------------------------------------*
  | hash.h Tests
  *----------------------------------------------------------------------------*/
@@ -24859,6 +26865,10 @@ static void test_wolfSSL_X509_LOOKUP_load_file(void)
     if (store) {
         AssertIntEQ(wolfSSL_CertManagerVerify(store->cm, svrCertFile,
                     WOLFSSL_FILETYPE_PEM), 1);
+        /* CRL was verified on first use, now checked as loaded */
+        AssertIntEQ(wolfSSL_CertManagerVerify(store->cm,
+                    "./certs/server-revoked-cert.pem", WOLFSSL_FILETYPE_PEM),
+                    CRL_CERT_REVOKED);
     }
 
     wolfSSL_X509_STORE_free(store);
@@ -33308,6 +35318,172 @@ static void test_DhCallbacks(void)
 }
 #endif /* HAVE_PK_CALLBACKS */
 
+#if defined(WOLF_CRYPTO_CB) && defined(WOLFSSL_TLS13) && \
+    defined(HAVE_CHACHA) && defined(HAVE_POLY1305) && \
+    defined(HAVE_CURVE25519) && defined(HAVE_ED25519) && \
+    defined(HAVE_ED25519_SIGN) && defined(HAVE_ED25519_VERIFY) && \
+    defined(HAVE_HKDF) && !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && \
+    !defined(NO_RSA) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER) && defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    !defined(SINGLE_THREADED)
+#define TEST_CRYPTOCB_TLS13
+/* crypto callback requests seen by one side of the connection */
+typedef struct CryptoCbCount {
+    int hash[WC_HASH_TYPE_MAX + 1];
+    int pk[WC_PK_TYPE_MAX + 1];
+    int cipher[WC_CIPHER_MAX + 1];
+    int kdf;
+} CryptoCbCount;
+
+static CryptoCbCount cryptoCbClient;
+static CryptoCbCount cryptoCbServer;
+
+/* counts the request and leaves the operation to software */
+static int test_CryptoCb_Count(int devIdArg, wc_CryptoInfo* info, void* ctx)
+{
+    CryptoCbCount* count = (CryptoCbCount*)ctx;
+
+    if (info->algo_type == WC_ALGO_TYPE_HASH &&
+            info->hash.type >= 0 && info->hash.type <= WC_HASH_TYPE_MAX) {
+        count->hash[info->hash.type]++;
+    }
+    else if (info->algo_type == WC_ALGO_TYPE_PK &&
+            info->pk.type >= 0 && info->pk.type <= WC_PK_TYPE_MAX) {
+        count->pk[info->pk.type]++;
+    }
+    else if (info->algo_type == WC_ALGO_TYPE_CIPHER &&
+            info->cipher.type >= 0 && info->cipher.type <= WC_CIPHER_MAX) {
+        count->cipher[info->cipher.type]++;
+    }
+    else if (info->algo_type == WC_ALGO_TYPE_KDF) {
+        count->kdf++;
+    }
+    (void)devIdArg;
+
+    return CRYPTOCB_UNAVAILABLE;
+}
+
+static void test_CryptoCb_client_ctx_setup(WOLFSSL_CTX* ctx)
+{
+    AssertIntEQ(wolfSSL_CTX_load_verify_locations(ctx, caEdCertFile, 0),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_set_cipher_list(ctx,
+                "TLS13-CHACHA20-POLY1305-SHA256"), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_SetDevId(ctx, 8), WOLFSSL_SUCCESS);
+}
+
+static void test_CryptoCb_server_ctx_setup(WOLFSSL_CTX* ctx)
+{
+    AssertIntEQ(wolfSSL_CTX_set_cipher_list(ctx,
+                "TLS13-CHACHA20-POLY1305-SHA256"), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_SetDevId(ctx, 9), WOLFSSL_SUCCESS);
+}
+
+static void test_CryptoCb_client_ssl_setup(WOLFSSL* ssl)
+{
+    AssertIntEQ(wolfSSL_UseKeyShare(ssl, WOLFSSL_ECC_X25519),
+                WOLFSSL_SUCCESS);
+}
+
+static void test_CryptoCb_server_ssl_setup(WOLFSSL* ssl)
+{
+    AssertIntEQ(wolfSSL_use_certificate_file(ssl, edCertFile,
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_use_PrivateKey_file(ssl, edKeyFile,
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+}
+#endif
+
+/* A TLS v1.3 ChaCha20-Poly1305 connection with X25519 and an Ed25519 server
+ * certificate reaches the crypto callback for each algorithm it uses. */
+static void test_CryptoCb_Tls13(void)
+{
+#ifdef TEST_CRYPTOCB_TLS13
+    tcp_ready   ready;
+    func_args   server_args;
+    func_args   client_args;
+    THREAD_TYPE serverThread;
+    callback_functions func_cb_client;
+    callback_functions func_cb_server;
+    int i;
+
+    printf(testingFmt, "test_CryptoCb_Tls13");
+
+    XMEMSET(&cryptoCbClient, 0, sizeof(cryptoCbClient));
+    XMEMSET(&cryptoCbServer, 0, sizeof(cryptoCbServer));
+    AssertIntEQ(wc_CryptoCb_RegisterDevice(8, test_CryptoCb_Count,
+                &cryptoCbClient), 0);
+    AssertIntEQ(wc_CryptoCb_RegisterDevice(9, test_CryptoCb_Count,
+                &cryptoCbServer), 0);
+
+#ifdef WOLFSSL_TIRTOS
+    fdOpenSession(Task_self());
+#endif
+    XMEMSET(&server_args, 0, sizeof(func_args));
+    XMEMSET(&client_args, 0, sizeof(func_args));
+    XMEMSET(&func_cb_client, 0, sizeof(callback_functions));
+    XMEMSET(&func_cb_server, 0, sizeof(callback_functions));
+
+    StartTCP();
+    InitTcpReady(&ready);
+
+#if defined(USE_WINDOWS_API)
+    /* use RNG to get random port if using windows */
+    ready.port = GetRandomPort();
+#endif
+
+    server_args.signal = &ready;
+    client_args.signal = &ready;
+    server_args.return_code = TEST_FAIL;
+    client_args.return_code = TEST_FAIL;
+
+    func_cb_client.ctx_ready = &test_CryptoCb_client_ctx_setup;
+    func_cb_client.ssl_ready = &test_CryptoCb_client_ssl_setup;
+    func_cb_client.method = wolfTLSv1_3_client_method;
+    client_args.callbacks = &func_cb_client;
+
+    func_cb_server.ctx_ready = &test_CryptoCb_server_ctx_setup;
+    func_cb_server.ssl_ready = &test_CryptoCb_server_ssl_setup;
+    func_cb_server.method = wolfTLSv1_3_server_method;
+    server_args.callbacks = &func_cb_server;
+
+    start_thread(test_server_nofail, &server_args, &serverThread);
+    wait_tcp_ready(&server_args);
+    test_client_nofail(&client_args, NULL);
+    join_thread(serverThread);
+
+    AssertTrue(client_args.return_code);
+    AssertTrue(server_args.return_code);
+
+    FreeTcpReady(&ready);
+
+#ifdef WOLFSSL_TIRTOS
+    fdOpenSession(Task_self());
+#endif
+
+    wc_CryptoCb_UnRegisterDevice(8);
+    wc_CryptoCb_UnRegisterDevice(9);
+
+    for (i = 0; i < 2; i++) {
+        CryptoCbCount* count = (i == 0) ? &cryptoCbClient : &cryptoCbServer;
+
+        AssertIntGT(count->pk[WC_PK_TYPE_CURVE25519_KEYGEN], 0);
+        AssertIntGT(count->pk[WC_PK_TYPE_CURVE25519], 0);
+        AssertIntGT(count->cipher[WC_CIPHER_CHACHA20_POLY1305], 0);
+        AssertIntGT(count->kdf, 0);
+        AssertIntGT(count->hash[WC_HASH_TYPE_SHA256], 0);
+    #ifdef WOLFSSL_SHA384
+        AssertIntGT(count->hash[WC_HASH_TYPE_SHA384], 0);
+    #endif
+    }
+    /* the server signs with Ed25519 and the client verifies */
+    AssertIntGT(cryptoCbServer.pk[WC_PK_TYPE_ED25519], 0);
+    AssertIntGT(cryptoCbClient.pk[WC_PK_TYPE_ED25519_VERIFY], 0);
+
+    printf(resultFmt, passed);
+#endif
+}
+
 #ifdef HAVE_HASHDRBG
 
 #ifdef TEST_RESEED_INTERVAL
@@ -33358,6 +35534,121 @@ static int test_wc_RNG_GenerateBlock(void)
 
     return ret;
 }
+
+#ifdef WOLFSSL_THREAD_LOCAL_RNG
+#if !defined(WC_NO_THREAD_RNG_FORK_CHECK) && !defined(USE_WINDOWS_API) && \
+    (defined(__unix__) || defined(__APPLE__))
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* The parent DRBG of a forked child must not repeat the process it was
+ * forked from. Returns 0 when the two draw different keys. */
+static int test_wc_RNG_ThreadLocalFork(void)
+{
+    WC_RNG rng;
+    byte   key[32];
+    byte   childKey[32];
+    int    fds[2];
+    int    status = 0;
+    int    ret;
+    pid_t  pid;
+
+    /* the parent DRBG exists before the fork */
+    ret = wc_InitRng_ThreadLocal(&rng, HEAP_HINT, INVALID_DEVID);
+    if (ret == 0)
+        wc_FreeRng(&rng);
+    if (ret == 0 && pipe(fds) != 0)
+        ret = -1;
+    if (ret != 0)
+        return ret;
+
+    pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        ret = wc_InitRng_ThreadLocal(&rng, HEAP_HINT, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_RNG_GenerateBlock(&rng, key, sizeof(key));
+            wc_FreeRng(&rng);
+        }
+        if (ret == 0 && write(fds[1], key, sizeof(key)) != sizeof(key))
+            ret = -1;
+        _exit(ret == 0 ? 0 : 1);
+    }
+    close(fds[1]);
+    if (pid < 0)
+        ret = -1;
+
+    if (ret == 0)
+        ret = wc_InitRng_ThreadLocal(&rng, HEAP_HINT, INVALID_DEVID);
+    if (ret == 0) {
+        ret = wc_RNG_GenerateBlock(&rng, key, sizeof(key));
+        wc_FreeRng(&rng);
+    }
+    if (ret == 0 && read(fds[0], childKey, sizeof(childKey)) !=
+                                                           sizeof(childKey))
+        ret = -1;
+    close(fds[0]);
+    if (pid > 0 && (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) ||
+                                                   WEXITSTATUS(status) != 0))
+        ret = -1;
+    if (ret == 0 && XMEMCMP(key, childKey, sizeof(key)) == 0)
+        ret = -1;
+
+    return ret;
+}
+#endif
+
+static int test_wc_RNG_ThreadLocal(void)
+{
+    int i, ret;
+    WC_RNG rng1, rng2;
+    byte key1[32], key2[32];
+
+    ret = wc_InitRng_ThreadLocal(&rng1, HEAP_HINT, INVALID_DEVID);
+    if (ret == 0)
+        ret = wc_InitRng_ThreadLocal(&rng2, HEAP_HINT, INVALID_DEVID);
+    if (ret == 0)
+        ret = wc_RNG_GenerateBlock(&rng1, key1, sizeof(key1));
+    if (ret == 0)
+        ret = wc_RNG_GenerateBlock(&rng2, key2, sizeof(key2));
+    /* children of one parent must not share state */
+    if (ret == 0 && XMEMCMP(key1, key2, sizeof(key1)) == 0)
+        ret = -1;
+    wc_FreeRng(&rng1);
+    wc_FreeRng(&rng2);
+
+    /* run past the parent's reseed interval */
+    for (i = 0; ret == 0 && i < 5000; i++) {
+        ret = wc_InitRng_ThreadLocal(&rng1, HEAP_HINT, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_RNG_GenerateBlock(&rng1, key2, sizeof(key2));
+            wc_FreeRng(&rng1);
+        }
+        if (ret == 0 && XMEMCMP(key1, key2, sizeof(key1)) == 0)
+            ret = -1;
+    }
+
+    /* parent is instantiated again after being freed */
+    wc_RNG_ThreadLocalFree();
+    if (ret == 0)
+        ret = wc_InitRng_ThreadLocal(&rng1, HEAP_HINT, INVALID_DEVID);
+    if (ret == 0) {
+        ret = wc_RNG_GenerateBlock(&rng1, key2, sizeof(key2));
+        wc_FreeRng(&rng1);
+    }
+
+    if (wc_InitRng_ThreadLocal(NULL, HEAP_HINT, INVALID_DEVID) != BAD_FUNC_ARG)
+        ret = -1;
+
+#if !defined(WC_NO_THREAD_RNG_FORK_CHECK) && !defined(USE_WINDOWS_API) && \
+    (defined(__unix__) || defined(__APPLE__))
+    if (ret == 0)
+        ret = test_wc_RNG_ThreadLocalFork();
+#endif
+
+    return ret;
+}
+#endif /* WOLFSSL_THREAD_LOCAL_RNG */
 #endif
 
 static void test_wolfSSL_X509_CRL(void)
@@ -34727,6 +37018,789 @@ static int test_various_pathlen_chains(void)
 }
 #endif /* !NO_RSA && !NO_SHA && !NO_FILESYSTEM && !NO_CERTS */
 
+#if !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA)
+#include "wolfssl/internal.h" /* for the cert manager CA table */
+#endif
+
+static void test_wolfSSL_CertManagerCATable(void)
+{
+#if !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA)
+    WOLFSSL_CERT_MANAGER* cm;
+    /* issuers are listed before the certificates they signed */
+    const char* caFiles[] = {
+        "./certs/ca-cert.pem",
+        "./certs/server-cert.pem",
+        "./certs/client-cert.pem",
+        "./certs/client-cert-ext.pem",
+        "./certs/client-uri-cert.pem",
+        "./certs/1024/ca-cert.pem",
+        "./certs/1024/server-cert.pem",
+        "./certs/1024/client-cert.pem",
+        "./certs/3072/client-cert.pem",
+        "./certs/4096/client-cert.pem",
+        "./certs/intermediate/ca-int-cert.pem",
+        "./certs/intermediate/ca-int2-cert.pem",
+        "./certs/intermediate/server-int-cert.pem",
+        "./certs/intermediate/client-int-cert.pem",
+        "./certs/ocsp/root-ca-cert.pem",
+        "./certs/ocsp/intermediate1-ca-cert.pem",
+        "./certs/ocsp/intermediate2-ca-cert.pem",
+        "./certs/ocsp/intermediate3-ca-cert.pem",
+        "./certs/ocsp/ocsp-responder-cert.pem",
+        "./certs/ocsp/server1-cert.pem",
+        "./certs/ocsp/server2-cert.pem",
+        "./certs/ocsp/server3-cert.pem",
+        "./certs/ocsp/server4-cert.pem",
+        "./certs/ocsp/server5-cert.pem",
+        "./certs/external/DigiCertGlobalRootCA.pem",
+        "./certs/external/ca-digicert-ev.pem",
+        "./certs/external/ca-globalsign-root.pem",
+        "./certs/wolfssl-website-ca.pem",
+    };
+    word32 i;
+
+    printf(testingFmt, "wolfSSL_CertManagerCATable()");
+
+    AssertNotNull(cm = wolfSSL_CertManagerNew());
+    AssertIntEQ(cm->caTableSz, CA_TABLE_SIZE);
+
+    for (i = 0; i < sizeof(caFiles) / sizeof(*caFiles); i++) {
+        AssertIntEQ(wolfSSL_CertManagerLoadCA(cm, caFiles[i], NULL),
+                    WOLFSSL_SUCCESS);
+        /* rows grow with the signers so the average chain stays short */
+        AssertIntLE(cm->caCount, cm->caTableSz * CA_TABLE_MAX_LOAD);
+    }
+    AssertIntGT(cm->caTableSz, CA_TABLE_SIZE);
+
+    /* signers are still found after the tables were rehashed */
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm, "./certs/server-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm,
+                "./certs/intermediate/server-int-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm, "./certs/ocsp/server1-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+
+    AssertIntEQ(wolfSSL_CertManagerUnloadCAs(cm), WOLFSSL_SUCCESS);
+    AssertIntEQ(cm->caCount, 0);
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm, "./certs/server-cert.pem",
+                WOLFSSL_FILETYPE_PEM), ASN_NO_SIGNER_E);
+
+    wolfSSL_CertManagerFree(cm);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+/* Testing that chain CA certs verified once are taken from the cache */
+static void test_wolfSSL_CTX_VerifyCache(void)
+{
+#if defined(WOLFSSL_CERT_VERIFY_CACHE) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER)
+    WOLFSSL_CTX* clientCtx;
+    WOLFSSL_CTX* serverCtx;
+    WOLFSSL_CERT_MANAGER* cm;
+    unsigned int hits, misses, evictions;
+
+    printf(testingFmt, "wolfSSL_CTX_VerifyCache()");
+
+    AssertNotNull(serverCtx = wolfSSL_CTX_new(wolfTLSv1_2_server_method()));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_use_certificate_chain_file(
+                serverCtx, "./certs/intermediate/server-chain.pem"));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_use_PrivateKey_file(serverCtx,
+                "./certs/server-key.pem", WOLFSSL_FILETYPE_PEM));
+
+    AssertNotNull(clientCtx = wolfSSL_CTX_new(wolfTLSv1_2_client_method()));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_load_verify_locations(clientCtx,
+                "./certs/ca-cert.pem", NULL));
+    cm = wolfSSL_CTX_GetCertManager(clientCtx);
+
+    AssertIntEQ(wolfSSL_CTX_EnableVerifyCache(NULL, 0), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CertManagerEnableVerifyCache(cm, -1), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(NULL, NULL, NULL,
+                NULL), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_EnableVerifyCache(clientCtx, 0), WOLFSSL_SUCCESS);
+
+    /* first handshake verifies both intermediates and caches them */
+    AssertIntEQ(test_memio_handshake(clientCtx, serverCtx),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(cm, &hits, &misses,
+                &evictions), WOLFSSL_SUCCESS);
+    AssertIntEQ(hits, 0);
+    AssertIntGE(misses, 1);
+    AssertIntEQ(evictions, 0);
+
+    /* second handshake takes both intermediates from the cache */
+    AssertIntEQ(test_memio_handshake(clientCtx, serverCtx),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(cm, &hits, NULL,
+                NULL), WOLFSSL_SUCCESS);
+    AssertIntEQ(hits, 2);
+
+    /* a single entry cache keeps evicting the other intermediate */
+    AssertIntEQ(wolfSSL_CTX_EnableVerifyCache(clientCtx, 1), WOLFSSL_SUCCESS);
+    AssertIntEQ(test_memio_handshake(clientCtx, serverCtx),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(cm, NULL, NULL,
+                &evictions), WOLFSSL_SUCCESS);
+    AssertIntEQ(evictions, 1);
+
+    /* unloading the CAs drops the cached certs */
+    AssertIntEQ(wolfSSL_CTX_UnloadCAs(clientCtx), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_load_verify_locations(clientCtx,
+                "./certs/ca-cert.pem", NULL), WOLFSSL_SUCCESS);
+    AssertIntEQ(test_memio_handshake(clientCtx, serverCtx),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(cm, &hits, NULL,
+                NULL), WOLFSSL_SUCCESS);
+    AssertIntEQ(hits, 2);
+
+    AssertIntEQ(wolfSSL_CTX_DisableVerifyCache(clientCtx), WOLFSSL_SUCCESS);
+    AssertIntEQ(test_memio_handshake(clientCtx, serverCtx),
+                WOLFSSL_SUCCESS);
+
+    wolfSSL_CTX_free(clientCtx);
+    wolfSSL_CTX_free(serverCtx);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+/* Testing that a CA directory decoded on threads loads the same CAs */
+static void test_wolfSSL_CTX_SetLoadVerifyThreads(void)
+{
+#if defined(WOLFSSL_PARALLEL_CA_LOAD) && !defined(NO_RSA) && \
+    (!defined(NO_WOLFSSL_CLIENT) || !defined(NO_WOLFSSL_SERVER))
+    WOLFSSL_CTX* ctx;
+    const char* paths[] = { "./certs/", "./certs/external/" };
+    const word32 flags[] = { WOLFSSL_LOAD_FLAG_IGNORE_ERR,
+                             WOLFSSL_LOAD_FLAG_PEM_CA_ONLY };
+    word32 caCount[2];
+    int threads[2] = { 1, 4 };
+    int i, j;
+
+    printf(testingFmt, "wolfSSL_CTX_SetLoadVerifyThreads()");
+
+    AssertIntEQ(wolfSSL_CTX_SetLoadVerifyThreads(NULL, 2), BAD_FUNC_ARG);
+
+    for (i = 0; i < (int)(sizeof(paths) / sizeof(*paths)); i++) {
+        for (j = 0; j < 2; j++) {
+        #ifndef NO_WOLFSSL_SERVER
+            AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+        #else
+            AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+        #endif
+            AssertIntEQ(wolfSSL_CTX_SetLoadVerifyThreads(ctx, 0),
+                        BAD_FUNC_ARG);
+            AssertIntEQ(wolfSSL_CTX_SetLoadVerifyThreads(ctx, threads[j]),
+                        WOLFSSL_SUCCESS);
+            AssertIntEQ(wolfSSL_CTX_load_verify_locations_ex(ctx, NULL,
+                        paths[i], flags[i]), WOLFSSL_SUCCESS);
+            caCount[j] = ctx->cm->caCount;
+            AssertIntGT(caCount[j], 0);
+
+            if (i == 0) {
+                AssertIntEQ(wolfSSL_CertManagerVerify(ctx->cm,
+                    "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM),
+                    WOLFSSL_SUCCESS);
+            }
+            wolfSSL_CTX_free(ctx);
+        }
+        AssertIntEQ(caCount[0], caCount[1]);
+    }
+
+    printf(resultFmt, passed);
+#elif !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && \
+    (!defined(NO_WOLFSSL_CLIENT) || !defined(NO_WOLFSSL_SERVER))
+    WOLFSSL_CTX* ctx;
+
+    printf(testingFmt, "wolfSSL_CTX_SetLoadVerifyThreads()");
+
+    /* declared whether or not parallel loads are built */
+#ifndef NO_WOLFSSL_SERVER
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+#else
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+#endif
+    AssertIntEQ(wolfSSL_CTX_SetLoadVerifyThreads(ctx, 0), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_SetLoadVerifyThreads(ctx, 4), NOT_COMPILED_IN);
+    wolfSSL_CTX_free(ctx);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+/* Testing that CA snapshots are used in place for signer lookups */
+static void test_wolfSSL_CTX_ca_snapshot(void)
+{
+#if defined(WOLFSSL_CA_SNAPSHOT) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_RSA) && \
+    (!defined(NO_WOLFSSL_CLIENT) || !defined(NO_WOLFSSL_SERVER))
+    WOLFSSL_CTX* ctx;
+    WOLFSSL_CTX* snapCtx;
+    const char*  snapFile = "./test-ca-snapshot.bin";
+    word32*      mem;
+    word32       caCount;
+    int          memSz;
+    int          used;
+
+    printf(testingFmt, "wolfSSL_CTX_ca_snapshot()");
+
+#ifndef NO_WOLFSSL_SERVER
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+    AssertNotNull(snapCtx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+#else
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+    AssertNotNull(snapCtx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+#endif
+    AssertIntEQ(wolfSSL_CTX_load_verify_locations(ctx,
+                "./certs/ca-cert.pem", NULL), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_load_verify_locations(ctx,
+                "./certs/intermediate/ca-int-cert.pem", NULL),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_load_verify_locations(ctx,
+                "./certs/intermediate/ca-int2-cert.pem", NULL),
+                WOLFSSL_SUCCESS);
+    caCount = ctx->cm->caCount;
+
+    memSz = wolfSSL_CTX_get_ca_snapshot_memsize(ctx);
+    AssertIntGT(memSz, 0);
+    AssertNotNull(mem = (word32*)XMALLOC(memSz, NULL,
+                                         DYNAMIC_TYPE_TMP_BUFFER));
+    AssertIntEQ(wolfSSL_CTX_memsave_ca_snapshot(ctx, mem, memSz - 1, &used),
+                BUFFER_E);
+    AssertIntEQ(wolfSSL_CTX_memsave_ca_snapshot(ctx, mem, memSz, &used),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(used, memSz);
+    AssertIntEQ(wolfSSL_CTX_save_ca_snapshot(ctx, snapFile), WOLFSSL_SUCCESS);
+
+    AssertIntEQ(wolfSSL_CTX_use_ca_snapshot(NULL, mem, memSz), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_use_ca_snapshot(snapCtx, (byte*)mem + 1,
+                memSz - 1), BAD_ALIGN_E);
+    AssertIntEQ(wolfSSL_CTX_use_ca_snapshot(snapCtx, mem, sizeof(word32)),
+                BUFFER_E);
+    mem[1]++; /* version */
+    AssertIntEQ(wolfSSL_CTX_use_ca_snapshot(snapCtx, mem, memSz),
+                CACHE_MATCH_ERROR);
+    mem[1]--;
+
+    /* signers come out of the snapshot as they are needed */
+    AssertIntEQ(wolfSSL_CTX_use_ca_snapshot(snapCtx, mem, memSz),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(snapCtx->cm->caCount, 0);
+    AssertIntEQ(wolfSSL_CertManagerVerify(snapCtx->cm,
+                "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(snapCtx->cm->caCount, 1);
+    AssertIntEQ(wolfSSL_CertManagerVerify(snapCtx->cm,
+                "./certs/intermediate/server-int-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertIntEQ(snapCtx->cm->caCount, 2);
+    AssertIntEQ(wolfSSL_CertManagerVerify(snapCtx->cm,
+                "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(snapCtx->cm->caCount, 2);
+
+    /* saving takes in the rest of the snapshot */
+    AssertIntEQ(wolfSSL_CTX_get_ca_snapshot_memsize(snapCtx), memSz);
+    AssertIntEQ(snapCtx->cm->caCount, caCount);
+
+    /* mapped file, dropped again by unloading the CAs */
+    AssertIntEQ(wolfSSL_CTX_map_ca_snapshot(snapCtx, "./certs/ca-cert.pem"),
+                CACHE_MATCH_ERROR);
+    AssertIntEQ(wolfSSL_CTX_map_ca_snapshot(snapCtx, snapFile),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(snapCtx->cm->caCount, 0);
+    AssertIntEQ(wolfSSL_CertManagerVerify(snapCtx->cm,
+                "./certs/intermediate/server-int-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertIntEQ(snapCtx->cm->caCount, 1);
+    AssertIntEQ(wolfSSL_CTX_UnloadCAs(snapCtx), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerify(snapCtx->cm,
+                "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM),
+                ASN_NO_SIGNER_E);
+
+    /* saving over a mapped file leaves the mapping on the old snapshot */
+    AssertIntEQ(wolfSSL_CTX_map_ca_snapshot(snapCtx, snapFile),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_UnloadCAs(ctx), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_load_verify_locations(ctx,
+                "./certs/intermediate/ca-int-cert.pem", NULL),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_save_ca_snapshot(ctx, snapFile), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerify(snapCtx->cm,
+                "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_get_ca_snapshot_memsize(snapCtx), memSz);
+    AssertIntEQ(wolfSSL_CTX_map_ca_snapshot(snapCtx, snapFile),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerify(snapCtx->cm,
+                "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM),
+                ASN_NO_SIGNER_E);
+
+    XFREE(mem, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    wolfSSL_CTX_free(snapCtx);
+    wolfSSL_CTX_free(ctx);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+#if defined(WOLFSSL_SHARED_SESSION_CACHE) && !defined(NO_SESSION_CACHE) && \
+    !defined(NO_CLIENT_CACHE) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(WOLFSSL_NO_ROBUST_MUTEX) && !defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef PERSIST_SESSION_CACHE
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <signal.h>
+#endif
+
+static void test_SharedSessionCtxs(WOLFSSL_CTX** clientCtx,
+                                   WOLFSSL_CTX** serverCtx)
+{
+    AssertNotNull(*serverCtx = wolfSSL_CTX_new(wolfTLSv1_2_server_method()));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_use_certificate_file(*serverCtx,
+                "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_use_PrivateKey_file(*serverCtx,
+                "./certs/server-key.pem", WOLFSSL_FILETYPE_PEM));
+    AssertNotNull(*clientCtx = wolfSSL_CTX_new(wolfTLSv1_2_client_method()));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_load_verify_locations(*clientCtx,
+                "./certs/ca-cert.pem", NULL));
+}
+
+/* Handshake over memory buffers, the client looks its session up by server
+ * id, returns if the session was resumed or -1 on failure */
+static int test_SharedSessionHandshake(WOLFSSL_CTX* clientCtx,
+                                       WOLFSSL_CTX* serverCtx)
+{
+    test_memio io;
+    WOLFSSL* clientSsl;
+    WOLFSSL* serverSsl;
+    int ret;
+
+    AssertNotNull(clientSsl = wolfSSL_new(clientCtx));
+    AssertNotNull(serverSsl = wolfSSL_new(serverCtx));
+    AssertIntEQ(wolfSSL_SetServerID(clientSsl, (const byte*)"shared", 6, 0),
+                WOLFSSL_SUCCESS);
+    test_memio_setup(&io, clientSsl, serverSsl);
+
+    ret = -1;
+    if (test_handshake_pair(clientSsl, serverSsl) == WOLFSSL_SUCCESS) {
+        ret = wolfSSL_session_reused(clientSsl) &&
+              wolfSSL_session_reused(serverSsl);
+    }
+
+    wolfSSL_free(clientSsl);
+    wolfSSL_free(serverSsl);
+
+    return ret;
+}
+#endif
+
+/* Testing that a session cached by a forked process is resumed by another */
+static void test_wolfSSL_SharedSessionCache(void)
+{
+#if defined(WOLFSSL_SHARED_SESSION_CACHE) && !defined(NO_SESSION_CACHE) && \
+    !defined(NO_CLIENT_CACHE) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(WOLFSSL_NO_ROBUST_MUTEX) && !defined(__APPLE__)
+    WOLFSSL_CTX* clientCtx;
+    WOLFSSL_CTX* serverCtx;
+    pid_t pid;
+    int   status = 0;
+#ifdef HAVE_SESSION_TICKET
+    WOLFSSL* clientSsl;
+    WOLFSSL* serverSsl;
+    test_memio io;
+    byte     ticket[SESSION_TICKET_LEN + 1];
+    unsigned int dropped;
+#endif
+
+    printf(testingFmt, "wolfSSL_SharedSessionCache()");
+
+    test_SharedSessionCtxs(&clientCtx, &serverCtx);
+
+    /* the child's full handshake caches the session for both sides */
+    pid = fork();
+    AssertIntGE(pid, 0);
+    if (pid == 0)
+        _exit(test_SharedSessionHandshake(clientCtx, serverCtx) == 0 ? 0 : 1);
+    AssertIntEQ(waitpid(pid, &status, 0), pid);
+    AssertTrue(WIFEXITED(status));
+    AssertIntEQ(WEXITSTATUS(status), 0);
+
+    /* this process never saw the session but finds it in the shared cache */
+    AssertIntEQ(test_SharedSessionHandshake(clientCtx, serverCtx), 1);
+
+#ifdef HAVE_SESSION_TICKET
+    /* a ticket too long for the shared cache is dropped and counted, the
+     * server has no ticket callback so it keeps the client's */
+    dropped = wolfSSL_GetSessionCacheDroppedTickets();
+    XMEMSET(ticket, 0, sizeof(ticket));
+    AssertNotNull(clientSsl = wolfSSL_new(clientCtx));
+    AssertNotNull(serverSsl = wolfSSL_new(serverCtx));
+    AssertIntEQ(wolfSSL_set_SessionTicket(clientSsl, ticket, sizeof(ticket)),
+                WOLFSSL_SUCCESS);
+    test_memio_setup(&io, clientSsl, serverSsl);
+    AssertIntEQ(test_handshake_pair(clientSsl, serverSsl), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_GetSessionCacheDroppedTickets(), dropped + 1);
+    wolfSSL_free(clientSsl);
+    wolfSSL_free(serverSsl);
+#endif
+
+    wolfSSL_CTX_free(clientCtx);
+    wolfSSL_CTX_free(serverCtx);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+/* A process killed while holding the shared cache locks doesn't block the
+ * others, the sessions it had locked are dropped. Restores the default cache
+ * size. */
+static void test_wolfSSL_SharedSessionCacheDeadOwner(void)
+{
+#if defined(WOLFSSL_SHARED_SESSION_CACHE) && !defined(NO_SESSION_CACHE) && \
+    !defined(NO_CLIENT_CACHE) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(WOLFSSL_NO_ROBUST_MUTEX) && !defined(__APPLE__) && \
+    defined(PERSIST_SESSION_CACHE)
+    WOLFSSL_CTX* clientCtx;
+    WOLFSSL_CTX* serverCtx;
+    char  dir[] = "/tmp/wolfssl_sessXXXXXX";
+    char  fifo[64];
+    char  c;
+    int   fd;
+    pid_t pid;
+    int   status = 0;
+    unsigned int defSz = wolfSSL_GetSessionCacheSize();
+
+    printf(testingFmt, "wolfSSL_SharedSessionCacheDeadOwner()");
+
+    /* big enough that saving it can't fit in a pipe */
+    AssertIntEQ(wolfSSL_SetSessionCacheSize(4096,
+                    WOLFSSL_SESSION_EVICT_ROUND_ROBIN), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_Init(), WOLFSSL_SUCCESS);
+    test_SharedSessionCtxs(&clientCtx, &serverCtx);
+
+    AssertIntEQ(test_SharedSessionHandshake(clientCtx, serverCtx), 0);
+    AssertIntEQ(test_SharedSessionHandshake(clientCtx, serverCtx), 1);
+
+    AssertNotNull(mkdtemp(dir));
+    XSNPRINTF(fifo, sizeof(fifo), "%s/cache", dir);
+    AssertIntEQ(mkfifo(fifo, 0600), 0);
+
+    /* the child saves the cache into a fifo nobody drains, it blocks holding
+     * every cache lock and is killed there */
+    pid = fork();
+    AssertIntGE(pid, 0);
+    if (pid == 0)
+        _exit(wolfSSL_save_session_cache(fifo) == WOLFSSL_SUCCESS ? 0 : 1);
+    AssertIntGE((fd = open(fifo, O_RDONLY)), 0);
+    /* rows are only written, and the header flushed, once locked */
+    AssertIntEQ(read(fd, &c, 1), 1);
+    AssertIntEQ(kill(pid, SIGKILL), 0);
+    AssertIntEQ(waitpid(pid, &status, 0), pid);
+    AssertTrue(WIFSIGNALED(status));
+    close(fd);
+    AssertIntEQ(unlink(fifo), 0);
+    AssertIntEQ(rmdir(dir), 0);
+
+    /* the locks are taken back with the rows they guarded emptied */
+    AssertIntEQ(test_SharedSessionHandshake(clientCtx, serverCtx), 0);
+    AssertIntEQ(test_SharedSessionHandshake(clientCtx, serverCtx), 1);
+
+    wolfSSL_CTX_free(clientCtx);
+    wolfSSL_CTX_free(serverCtx);
+    AssertIntEQ(wolfSSL_Cleanup(), WOLFSSL_SUCCESS);
+
+    AssertIntEQ(wolfSSL_SetSessionCacheSize(defSz,
+                    WOLFSSL_SESSION_EVICT_ROUND_ROBIN), WOLFSSL_SUCCESS);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+#if defined(WOLFSSL_DYNAMIC_SESSION_CACHE) && !defined(NO_SESSION_CACHE) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER)
+#include "wolfssl/internal.h" /* for the cached session ids */
+
+#define EVICT_TEST_CONNS 40 /* more sessions than any cache row holds */
+
+#ifdef HAVE_EXT_CACHE
+static int          test_evictCount;
+static WOLFSSL_CTX* test_evictCtx[EVICT_TEST_CONNS * 2];
+static byte         test_evictId[EVICT_TEST_CONNS * 2][ID_LEN];
+
+static void test_SessionEvictCb(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* session)
+{
+    if (test_evictCount < EVICT_TEST_CONNS * 2) {
+        test_evictCtx[test_evictCount] = ctx;
+        XMEMCPY(test_evictId[test_evictCount], session->sessionID, ID_LEN);
+        test_evictCount++;
+    }
+}
+
+/* the owner drops its last reference from the callback */
+static int test_evictFreeCount;
+
+static void test_SessionEvictFreeCb(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* session)
+{
+    (void)session;
+    test_evictFreeCount++;
+    wolfSSL_CTX_free(ctx);
+}
+
+/* the ctx told the session with id was evicted, NULL if none was */
+static WOLFSSL_CTX* test_SessionEvictedBy(const byte* id)
+{
+    int i;
+
+    for (i = 0; i < test_evictCount; i++) {
+        if (XMEMCMP(test_evictId[i], id, ID_LEN) == 0)
+            return test_evictCtx[i];
+    }
+
+    return NULL;
+}
+#endif
+
+static WOLFSSL_CTX* test_SessionEvictServer(void)
+{
+    WOLFSSL_CTX* ctx;
+
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfTLSv1_2_server_method()));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_use_certificate_file(ctx,
+                "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_use_PrivateKey_file(ctx,
+                "./certs/server-key.pem", WOLFSSL_FILETYPE_PEM));
+#ifdef HAVE_EXT_CACHE
+    wolfSSL_CTX_sess_set_remove_cb(ctx, test_SessionEvictCb);
+#endif
+
+    return ctx;
+}
+
+/* Handshake a new client with serverCtx, resuming session if not NULL.
+ * Returns the connected client for the caller to free, wolfSSL_get_session()
+ * finds its session while it is cached. */
+static WOLFSSL* test_SessionEvictConnect(WOLFSSL_CTX* clientCtx,
+                         WOLFSSL_CTX* serverCtx, WOLFSSL_SESSION* session)
+{
+    static test_memio io;
+    WOLFSSL* clientSsl;
+    WOLFSSL* serverSsl;
+
+    AssertNotNull(clientSsl = wolfSSL_new(clientCtx));
+    AssertNotNull(serverSsl = wolfSSL_new(serverCtx));
+    if (session != NULL)
+        AssertIntEQ(wolfSSL_set_session(clientSsl, session), WOLFSSL_SUCCESS);
+    test_memio_setup(&io, clientSsl, serverSsl);
+    AssertIntEQ(test_handshake_pair(clientSsl, serverSsl), WOLFSSL_SUCCESS);
+    wolfSSL_free(serverSsl);
+
+    return clientSsl;
+}
+#endif
+
+/* A full row replaces its least recently used session and tells the ctx
+ * that cached it, not the one adding. Restores the default cache size. */
+static void test_wolfSSL_SessionCacheEvict(void)
+{
+#if defined(WOLFSSL_DYNAMIC_SESSION_CACHE) && !defined(NO_SESSION_CACHE) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER)
+    WOLFSSL_CTX* clientCtx;
+    WOLFSSL_CTX* serverCtx;
+    WOLFSSL_CTX* ownerCtx;
+    WOLFSSL_CTX* freedCtx;
+#ifdef HAVE_EXT_CACHE
+    WOLFSSL_CTX* selfCtx;
+#endif
+    WOLFSSL*     kept;
+    WOLFSSL*     owned;
+    WOLFSSL*     freed;
+    WOLFSSL*     ssl;
+    byte         ownedId[ID_LEN];
+    byte         freedId[ID_LEN];
+    byte         keptId[ID_LEN];
+    unsigned int defSz = wolfSSL_GetSessionCacheSize();
+    int          i;
+
+    printf(testingFmt, "wolfSSL_SessionCacheEvict()");
+
+    /* a single row so every session competes for it */
+    AssertIntEQ(wolfSSL_SetSessionCacheSize(1, WOLFSSL_SESSION_EVICT_LRU),
+                                                              WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_Init(), WOLFSSL_SUCCESS);
+
+    AssertNotNull(clientCtx = wolfSSL_CTX_new(wolfTLSv1_2_client_method()));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_load_verify_locations(clientCtx,
+                "./certs/ca-cert.pem", NULL));
+    serverCtx = test_SessionEvictServer();
+    ownerCtx  = test_SessionEvictServer();
+    freedCtx  = test_SessionEvictServer();
+
+    /* sessions cached by other server contexts, one freed before eviction */
+    owned = test_SessionEvictConnect(clientCtx, ownerCtx, NULL);
+    XMEMCPY(ownedId, wolfSSL_get_session(owned)->sessionID, ID_LEN);
+    freed = test_SessionEvictConnect(clientCtx, freedCtx, NULL);
+    XMEMCPY(freedId, wolfSSL_get_session(freed)->sessionID, ID_LEN);
+    wolfSSL_CTX_free(freedCtx);
+
+    /* kept is resumed after every new session so it is never replaced */
+    kept = test_SessionEvictConnect(clientCtx, serverCtx, NULL);
+    XMEMCPY(keptId, wolfSSL_get_session(kept)->sessionID, ID_LEN);
+    for (i = 0; i < EVICT_TEST_CONNS; i++) {
+        wolfSSL_free(test_SessionEvictConnect(clientCtx, serverCtx, NULL));
+        ssl = test_SessionEvictConnect(clientCtx, serverCtx,
+                                       wolfSSL_get_session(kept));
+        AssertTrue(wolfSSL_session_reused(ssl));
+        wolfSSL_free(ssl);
+    }
+    AssertNull(wolfSSL_get_session(owned));
+    AssertNull(wolfSSL_get_session(freed));
+    AssertNotNull(wolfSSL_get_session(kept));
+
+#ifdef HAVE_EXT_CACHE
+    AssertIntGT(test_evictCount, 0);
+    AssertPtrEq(test_SessionEvictedBy(ownedId), ownerCtx);
+    AssertNull(test_SessionEvictedBy(freedId));
+    AssertNull(test_SessionEvictedBy(keptId));
+
+    /* the evicting add keeps the owner alive through the callback, which
+     * may free it */
+    selfCtx = test_SessionEvictServer();
+    wolfSSL_CTX_sess_set_remove_cb(selfCtx, test_SessionEvictFreeCb);
+    wolfSSL_free(test_SessionEvictConnect(clientCtx, selfCtx, NULL));
+    for (i = 0; i < EVICT_TEST_CONNS && test_evictFreeCount == 0; i++)
+        wolfSSL_free(test_SessionEvictConnect(clientCtx, serverCtx, NULL));
+    AssertIntEQ(test_evictFreeCount, 1);
+#endif
+
+    wolfSSL_free(kept);
+    wolfSSL_free(owned);
+    wolfSSL_free(freed);
+    wolfSSL_CTX_free(ownerCtx);
+    wolfSSL_CTX_free(serverCtx);
+    wolfSSL_CTX_free(clientCtx);
+    AssertIntEQ(wolfSSL_Cleanup(), WOLFSSL_SUCCESS);
+
+    AssertIntEQ(wolfSSL_SetSessionCacheSize(defSz,
+                    WOLFSSL_SESSION_EVICT_ROUND_ROBIN), WOLFSSL_SUCCESS);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+#if !defined(SINGLE_THREADED) && !defined(NO_SESSION_CACHE) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER)
+#define TEST_SESSION_THREADS 4
+#define TEST_SESSION_CONNECTS 10
+
+static WOLFSSL_CTX* test_sessionClientCtx;
+static WOLFSSL_CTX* test_sessionServerCtx;
+
+/* Each handshake adds its session to the cache and each reconnect looks the
+ * last one up to resume, racing the other threads doing the same. Returns
+ * the number of resumed handshakes in return_code. */
+static THREAD_RETURN WOLFSSL_THREAD test_SessionCacheWorker(void* args)
+{
+    func_args* myArgs = (func_args*)args;
+    test_memio io;
+    WOLFSSL*   prev = NULL;
+    WOLFSSL*   clientSsl;
+    WOLFSSL*   serverSsl;
+    WOLFSSL_SESSION* session;
+    int i;
+
+    myArgs->return_code = 0;
+    for (i = 0; i < TEST_SESSION_CONNECTS; i++) {
+        AssertNotNull(clientSsl = wolfSSL_new(test_sessionClientCtx));
+        AssertNotNull(serverSsl = wolfSSL_new(test_sessionServerCtx));
+        if (prev != NULL) {
+            session = wolfSSL_get_session(prev);
+            if (session != NULL)
+                AssertIntEQ(wolfSSL_set_session(clientSsl, session),
+                                                              WOLFSSL_SUCCESS);
+            wolfSSL_free(prev);
+        }
+        test_memio_setup(&io, clientSsl, serverSsl);
+        AssertIntEQ(test_handshake_pair(clientSsl, serverSsl),
+                                                              WOLFSSL_SUCCESS);
+        if (wolfSSL_session_reused(clientSsl))
+            myArgs->return_code++;
+        wolfSSL_free(serverSsl);
+        prev = clientSsl;
+    }
+    wolfSSL_free(prev);
+
+    return 0;
+}
+#endif
+
+/* Testing concurrent session cache adds and lookups from several threads */
+static void test_wolfSSL_SessionCacheConcurrent(void)
+{
+#if !defined(SINGLE_THREADED) && !defined(NO_SESSION_CACHE) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER)
+    func_args   args[TEST_SESSION_THREADS];
+    THREAD_TYPE threads[TEST_SESSION_THREADS];
+    int         resumed = 0;
+    int         i;
+
+    printf(testingFmt, "wolfSSL_SessionCacheConcurrent()");
+
+    AssertNotNull(test_sessionClientCtx =
+                           wolfSSL_CTX_new(wolfTLSv1_2_client_method()));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_load_verify_locations(
+                test_sessionClientCtx, caCertFile, NULL));
+    AssertNotNull(test_sessionServerCtx =
+                           wolfSSL_CTX_new(wolfTLSv1_2_server_method()));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_use_certificate_file(
+                test_sessionServerCtx, svrCertFile, WOLFSSL_FILETYPE_PEM));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_use_PrivateKey_file(
+                test_sessionServerCtx, svrKeyFile, WOLFSSL_FILETYPE_PEM));
+#ifndef NO_DH
+    /* DHE suites for builds without ECC */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_SetTmpDH_file(
+                test_sessionServerCtx, dhParamFile, WOLFSSL_FILETYPE_PEM));
+#endif
+
+    XMEMSET(args, 0, sizeof(args));
+    for (i = 0; i < TEST_SESSION_THREADS; i++)
+        start_thread(test_SessionCacheWorker, &args[i], &threads[i]);
+    for (i = 0; i < TEST_SESSION_THREADS; i++) {
+        join_thread(threads[i]);
+        resumed += args[i].return_code;
+    }
+
+    /* a session may be evicted by another thread's, not all of them */
+    AssertIntGT(resumed, 0);
+
+    wolfSSL_CTX_free(test_sessionServerCtx);
+    wolfSSL_CTX_free(test_sessionClientCtx);
+    test_sessionServerCtx = NULL;
+    test_sessionClientCtx = NULL;
+
+    printf(resultFmt, passed);
+#endif
+}
+
 /*----------------------------------------------------------------------------*
  | Main
  *----------------------------------------------------------------------------*/
@@ -34737,6 +37811,10 @@ void ApiTest(void)
     AssertTrue(test_fileAccess());
 
     printf(" Begin API Tests\n");
+    test_wolfSSL_SetSessionCacheSize();
+    test_wolfSSL_SessionCacheEvict();
+    test_wolfSSL_SharedSessionCacheDeadOwner();
+    test_wolfSSL_SessionCacheConcurrent();
     AssertIntEQ(test_wolfSSL_Init(), WOLFSSL_SUCCESS);
     /* wolfcrypt initialization tests */
     test_wolfSSL_Method_Allocators();
@@ -34755,7 +37833,15 @@ void ApiTest(void)
     test_wolfSSL_CertManagerGetCerts();
     test_wolfSSL_CertManagerSetVerify();
     test_wolfSSL_CertManagerNameConstraint();
+    test_wolfSSL_CertManagerCATable();
+    test_wolfSSL_CTX_VerifyCache();
+    test_wolfSSL_CTX_SetLoadVerifyThreads();
+    test_wolfSSL_CTX_ca_snapshot();
+    test_wolfSSL_SharedSessionCache();
     test_wolfSSL_CertManagerCRL();
+    test_wolfSSL_CertManagerCheckCRL();
+    test_wolfSSL_CertManagerCRL_swap();
+    test_wolfSSL_CertManagerOCSPCache();
     test_wolfSSL_CTX_load_verify_locations_ex();
     test_wolfSSL_CTX_load_verify_buffer_ex();
     test_wolfSSL_CTX_load_verify_chain_buffer_format();
@@ -34817,10 +37903,16 @@ void ApiTest(void)
     /*OCSP Stapling. */
     AssertIntEQ(test_wolfSSL_UseOCSPStapling(), WOLFSSL_SUCCESS);
     AssertIntEQ(test_wolfSSL_UseOCSPStaplingV2(), WOLFSSL_SUCCESS);
+    test_wolfSSL_CTX_StapleCache();
+    test_wolfSSL_CTX_RsaKeyCache();
 
     /* Multicast */
     test_wolfSSL_mcast();
 
+    /* Vectored send */
+    test_wolfSSL_SSLSetIOSendv();
+    test_wolfSSL_read_borrow();
+
     /* compatibility tests */
     test_wolfSSL_X509_NAME();
     test_wolfSSL_X509_INFO();
@@ -35052,6 +38144,7 @@ void ApiTest(void)
     /* public key callback tests */
     test_DhCallbacks();
 #endif
+    test_CryptoCb_Tls13();
 
     /*wolfcrypt */
     printf("\n-----------------wolfcrypt unit tests------------------\n");
@@ -35070,6 +38163,7 @@ void ApiTest(void)
     AssertFalse(test_wc_Sha256Free());
     AssertFalse(test_wc_Sha256GetHash());
     AssertFalse(test_wc_Sha256Copy());
+    AssertFalse(test_wc_Sha256_MultiBuffer());
     AssertFalse(test_wc_InitSha512());
     AssertFalse(test_wc_Sha512Update());
     AssertFalse(test_wc_Sha512Final());
@@ -35114,6 +38208,8 @@ void ApiTest(void)
     AssertIntEQ(testing_wc_Shake256_Update(), 0);
     AssertIntEQ(test_wc_Shake256_Final(), 0);
     AssertIntEQ(test_wc_Shake256_Copy(), 0);
+    AssertIntEQ(test_wc_Shake_SqueezeBlocks(), 0);
+    AssertIntEQ(test_wc_Shake_MultiBuffer(), 0);
 
     AssertFalse(test_wc_Md5HmacSetKey());
     AssertFalse(test_wc_Md5HmacUpdate());
@@ -35185,6 +38281,8 @@ void ApiTest(void)
     AssertIntEQ(test_wc_RsaPublicEncryptDecrypt_ex(), 0);
     AssertIntEQ(test_wc_RsaEncryptSize(), 0);
     AssertIntEQ(test_wc_RsaSSL_SignVerify(), 0);
+    AssertIntEQ(test_wc_RsaPrecompute(), 0);
+    AssertIntEQ(test_wc_RsaPrecomputeCopy(), 0);
     AssertIntEQ(test_wc_RsaFlattenPublicKey(), 0);
     AssertIntEQ(test_RsaDecryptBoundsCheck(), 0);
     AssertIntEQ(test_wc_AesCcmSetKey(), 0);
@@ -35203,6 +38301,8 @@ void ApiTest(void)
     AssertIntEQ(test_wc_DsaExportKeyRaw(), 0);
     AssertIntEQ(test_wc_SignatureGetSize_ecc(), 0);
     AssertIntEQ(test_wc_SignatureGetSize_rsa(), 0);
+    AssertIntEQ(test_wc_SignatureBatch(), 0);
+    AssertIntEQ(test_wc_CryptoCb_Queue(), 0);
     wolfCrypt_Cleanup();
 
 #ifdef OPENSSL_EXTRA
@@ -35228,11 +38328,15 @@ void ApiTest(void)
     AssertIntEQ(test_wc_RNG_GenerateBlock_Reseed(), 0);
     #endif
     AssertIntEQ(test_wc_RNG_GenerateBlock(), 0);
+    #ifdef WOLFSSL_THREAD_LOCAL_RNG
+    AssertIntEQ(test_wc_RNG_ThreadLocal(), 0);
+    #endif
 #endif
 
     AssertIntEQ(test_wc_ed25519_make_key(), 0);
     AssertIntEQ(test_wc_ed25519_init(), 0);
     AssertIntEQ(test_wc_ed25519_sign_msg(), 0);
+    AssertIntEQ(test_wc_ed25519_verify_batch(), 0);
     AssertIntEQ(test_wc_ed25519_import_public(), 0);
     AssertIntEQ(test_wc_ed25519_import_private_key(), 0);
     AssertIntEQ(test_wc_ed25519_export(), 0);
@@ -35275,6 +38379,7 @@ void ApiTest(void)
     AssertIntEQ(test_wc_ecc_size(), 0);
     test_wc_ecc_params();
     AssertIntEQ(test_wc_ecc_signVerify_hash(), 0);
+    AssertIntEQ(test_wc_ecc_verify_hash_batch(), 0);
     AssertIntEQ(test_wc_ecc_shared_secret(), 0);
     AssertIntEQ(test_wc_ecc_export_x963(), 0);
     AssertIntEQ(test_wc_ecc_export_x963_ex(), 0);
@@ -35294,6 +38399,7 @@ void ApiTest(void)
     AssertIntEQ(test_wc_ecc_pointFns(), 0);
     AssertIntEQ(test_wc_ecc_shared_secret_ssh(), 0);
     AssertIntEQ(test_wc_ecc_verify_hash_ex(), 0);
+    AssertIntEQ(test_wc_ecc_fp_set_entries(), 0);
     AssertIntEQ(test_wc_ecc_mulmod(), 0);
     AssertIntEQ(test_wc_ecc_is_valid_idx(), 0);
 
@@ -168,6 +168,9 @@
 #ifdef HAVE_ED448
     #include <wolfssl/wolfcrypt/ed448.h>
 #endif
+#ifdef WOLFSSL_SIGN_BATCH
+    #include <wolfssl/wolfcrypt/signature.h>
+#endif
 
 #include <wolfssl/wolfcrypt/dh.h>
 #ifdef HAVE_NTRU
@@ -249,6 +252,9 @@
 #define BENCH_RIPEMD             0x00001000
 #define BENCH_BLAKE2B            0x00002000
 #define BENCH_BLAKE2S            0x00004000
+#define BENCH_SHA256_MB          0x00008000
+#define BENCH_SHAKE128           0x00010000
+#define BENCH_SHAKE256           0x00020000
 
 /* MAC algorithms. */
 #define BENCH_CMAC               0x00000001
@@ -281,6 +287,9 @@
 #define BENCH_CURVE448_KA        0x00200000
 #define BENCH_ED448_KEYGEN       0x00400000
 #define BENCH_ED448_SIGN         0x00800000
+#define BENCH_SIGN_BATCH         0x01000000
+#define BENCH_VERIFY_BATCH       0x02000000
+#define BENCH_CRYPTOCB_QUEUE     0x04000000
 /* Other */
 #define BENCH_RNG                0x00000001
 #define BENCH_SCRYPT             0x00000002
@@ -389,6 +398,9 @@ static const bench_alg bench_digest_opt[] = {
 #ifndef NO_SHA256
     { "-sha256",             BENCH_SHA256            },
 #endif
+#if defined(WOLFSSL_SHA256_MULTI_BUFFER) && !defined(NO_SHA256)
+    { "-sha256-mb",          BENCH_SHA256_MB         },
+#endif
 #ifdef WOLFSSL_SHA384
     { "-sha384",             BENCH_SHA384            },
 #endif
@@ -410,6 +422,12 @@ static const bench_alg bench_digest_opt[] = {
     { "-sha3-512",           BENCH_SHA3_512          },
     #endif
 #endif
+#if defined(WOLFSSL_SHAKE128) && !defined(WOLFSSL_NO_SHAKE128)
+    { "-shake128",           BENCH_SHAKE128          },
+#endif
+#if defined(WOLFSSL_SHAKE256) && !defined(WOLFSSL_NO_SHAKE256)
+    { "-shake256",           BENCH_SHAKE256          },
+#endif
 #ifdef WOLFSSL_RIPEMD
     { "-ripemd",             BENCH_RIPEMD            },
 #endif
@@ -498,6 +516,16 @@ static const bench_alg bench_asym_opt[] = {
 #ifdef HAVE_ED448
     { "-ed448-kg",           BENCH_ED448_KEYGEN      },
     { "-ed448",              BENCH_ED448_SIGN        },
+#endif
+#ifdef WOLFSSL_SIGN_BATCH
+    { "-sign-batch",         BENCH_SIGN_BATCH        },
+#endif
+#ifdef WOLFSSL_VERIFY_BATCH
+    { "-verify-batch",       BENCH_VERIFY_BATCH      },
+#endif
+#if defined(WOLF_CRYPTO_CB_QUEUE) && defined(HAVE_ECC) && \
+    defined(HAVE_ECC_SIGN) && !defined(NO_ASN)
+    { "-cryptocb-queue",     BENCH_CRYPTOCB_QUEUE    },
 #endif
     { NULL, 0}
 };
@@ -1582,6 +1610,13 @@ static void* benchmarks_do(void* args)
     #endif
     }
 #endif
+#if defined(WOLFSSL_SHA256_MULTI_BUFFER) && !defined(NO_SHA256)
+    if (bench_all || (bench_digest_algs & BENCH_SHA256_MB)) {
+    #ifndef NO_SW_BENCH
+        bench_sha256_mb();
+    #endif
+    }
+#endif
 #ifdef WOLFSSL_SHA384
     if (bench_all || (bench_digest_algs & BENCH_SHA384)) {
     #ifndef NO_SW_BENCH
@@ -1650,6 +1685,14 @@ static void* benchmarks_do(void* args)
     }
     #endif /* WOLFSSL_NOSHA3_512 */
 #endif
+#if defined(WOLFSSL_SHAKE128) && !defined(WOLFSSL_NO_SHAKE128)
+    if (bench_all || (bench_digest_algs & BENCH_SHAKE128))
+        bench_shake128();
+#endif
+#if defined(WOLFSSL_SHAKE256) && !defined(WOLFSSL_NO_SHAKE256)
+    if (bench_all || (bench_digest_algs & BENCH_SHAKE256))
+        bench_shake256();
+#endif
 #ifdef WOLFSSL_RIPEMD
     if (bench_all || (bench_digest_algs & BENCH_RIPEMD))
         bench_ripemd();
@@ -1867,6 +1910,20 @@ static void* benchmarks_do(void* args)
         bench_ed448KeySign();
 #endif
 
+#ifdef WOLFSSL_SIGN_BATCH
+    if (bench_all || (bench_asym_algs & BENCH_SIGN_BATCH))
+        bench_sign_batch();
+#endif
+#ifdef WOLFSSL_VERIFY_BATCH
+    if (bench_all || (bench_asym_algs & BENCH_VERIFY_BATCH))
+        bench_verify_batch();
+#endif
+#if defined(WOLF_CRYPTO_CB_QUEUE) && defined(HAVE_ECC) && \
+    defined(HAVE_ECC_SIGN) && !defined(NO_ASN)
+    if (bench_all || (bench_asym_algs & BENCH_CRYPTOCB_QUEUE))
+        bench_cryptocb_queue();
+#endif
+
 exit:
     /* free benchmark buffers */
     XFREE(bench_plain, HEAP_HINT, DYNAMIC_TYPE_WOLF_BIGINT);
@@ -2052,13 +2109,21 @@ int benchmark_test(void *args)
 
 
 #ifndef WC_NO_RNG
-void bench_rng(void)
+/* generate BENCH_SIZE bytes per block in reqSz byte requests */
+static void bench_rng_internal(int drbgType, word32 reqSz, const char* desc)
 {
     int    ret, i, count;
     double start;
     long   pos, len, remain;
     WC_RNG myrng;
 
+    (void)drbgType;
+
+#ifdef HAVE_CTRDRBG
+    if (drbgType != WC_DRBG_HASH)
+        ret = wc_InitRngType_ex(&myrng, drbgType, HEAP_HINT, devId);
+    else
+#endif
 #ifndef HAVE_FIPS
     ret = wc_InitRng_ex(&myrng, HEAP_HINT, devId);
 #else
@@ -2077,8 +2142,8 @@ void bench_rng(void)
             remain = (int)BENCH_SIZE;
             while (remain > 0) {
                 len = remain;
-                if (len > RNG_MAX_BLOCK_LEN)
-                    len = RNG_MAX_BLOCK_LEN;
+                if (len > (long)reqSz)
+                    len = reqSz;
                 ret = wc_RNG_GenerateBlock(&myrng, &bench_plain[pos], (word32)len);
                 if (ret < 0)
                     goto exit_rng;
@@ -2090,10 +2155,37 @@ void bench_rng(void)
         count += i;
     } while (bench_stats_sym_check(start));
 exit_rng:
-    bench_stats_sym_finish("RNG", 0, count, bench_size, start, ret);
+    bench_stats_sym_finish(desc, 0, count, bench_size, start, ret);
 
     wc_FreeRng(&myrng);
 }
+
+void bench_rng(void)
+{
+    bench_rng_internal(WC_DRBG_HASH, RNG_MAX_BLOCK_LEN, "RNG");
+#ifdef HAVE_CTRDRBG
+    {
+        /* Hash_DRBG against CTR_DRBG for IV, nonce and key sized requests */
+        static const struct {
+            word32      sz;
+            const char* hashDesc;
+            const char* ctrDesc;
+        } reqs[] = {
+            { 16,   "RNG 16B",   "RNG-CTR 16B" },
+            { 32,   "RNG 32B",   "RNG-CTR 32B" },
+            { 256,  "RNG 256B",  "RNG-CTR 256B" },
+            { 4096, "RNG 4KB",   "RNG-CTR 4KB" }
+        };
+        int i;
+
+        bench_rng_internal(WC_DRBG_CTR, RNG_MAX_BLOCK_LEN, "RNG-CTR");
+        for (i = 0; i < (int)(sizeof(reqs) / sizeof(reqs[0])); i++) {
+            bench_rng_internal(WC_DRBG_HASH, reqs[i].sz, reqs[i].hashDesc);
+            bench_rng_internal(WC_DRBG_CTR, reqs[i].sz, reqs[i].ctrDesc);
+        }
+    }
+#endif
+}
 #endif /* WC_NO_RNG */
 
 
@@ -3343,6 +3435,110 @@ exit:
 
     FREE_ARRAY(digest, BENCH_MAX_PENDING, HEAP_HINT);
 }
+
+#ifdef WOLFSSL_SHA256_MULTI_BUFFER
+/* Size of the small messages hashed one after the other and side by side. */
+#define BENCH_MB_MSG_SZ     64
+/* Each lane gets its own HMAC key: bench_key offset by the lane index. */
+#define BENCH_MB_KEY_SZ     16
+
+/* Aggregate throughput of WC_SHA256_MB_LANES small messages, each hashed
+ * on its own and then all at once with the multi-buffer API. */
+void bench_sha256_mb(void)
+{
+    const byte* msg[WC_SHA256_MB_LANES];
+    word32 msgSz[WC_SHA256_MB_LANES];
+    byte   digest[WC_SHA256_MB_LANES][WC_SHA256_DIGEST_SIZE];
+    byte*  out[WC_SHA256_MB_LANES];
+#ifndef NO_HMAC
+    const byte* key[WC_SHA256_MB_LANES];
+    word32 keySz[WC_SHA256_MB_LANES];
+    Hmac   hmac;
+#endif
+    double start;
+    int    ret = 0, i, count, times;
+
+    for (i = 0; i < WC_SHA256_MB_LANES; i++) {
+        msg[i] = bench_plain;
+        if (bench_size >= WC_SHA256_MB_LANES * BENCH_MB_MSG_SZ)
+            msg[i] += i * BENCH_MB_MSG_SZ;
+        msgSz[i] = BENCH_MB_MSG_SZ;
+        out[i] = digest[i];
+    #ifndef NO_HMAC
+        key[i] = bench_key + i;
+        keySz[i] = BENCH_MB_KEY_SZ;
+    #endif
+    }
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            for (i = 0; ret == 0 && i < WC_SHA256_MB_LANES; i++)
+                ret = wc_Sha256Hash(msg[i], msgSz[i], digest[i]);
+            if (ret != 0)
+                goto exit_serial;
+        }
+        count += times * WC_SHA256_MB_LANES;
+    } while (bench_stats_sym_check(start));
+exit_serial:
+    bench_stats_sym_finish("SHA-256 64B", 0, count, BENCH_MB_MSG_SZ, start,
+                           ret);
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            ret = wc_Sha256_MultiBuffer(msg, msgSz, out, WC_SHA256_MB_LANES);
+            if (ret != 0)
+                goto exit_mb;
+        }
+        count += times * WC_SHA256_MB_LANES;
+    } while (bench_stats_sym_check(start));
+exit_mb:
+    bench_stats_sym_finish("SHA-256-MB 64B", 0, count, BENCH_MB_MSG_SZ, start,
+                           ret);
+
+#ifndef NO_HMAC
+    ret = wc_HmacInit(&hmac, HEAP_HINT, INVALID_DEVID);
+    if (ret != 0) {
+        printf("wc_HmacInit failed, ret = %d\n", ret);
+        return;
+    }
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            for (i = 0; ret == 0 && i < WC_SHA256_MB_LANES; i++) {
+                ret = wc_HmacSetKey(&hmac, WC_SHA256, key[i], keySz[i]);
+                if (ret == 0)
+                    ret = wc_HmacUpdate(&hmac, msg[i], msgSz[i]);
+                if (ret == 0)
+                    ret = wc_HmacFinal(&hmac, digest[i]);
+            }
+            if (ret != 0)
+                goto exit_hmac_serial;
+        }
+        count += times * WC_SHA256_MB_LANES;
+    } while (bench_stats_sym_check(start));
+exit_hmac_serial:
+    bench_stats_sym_finish("HMAC-SHA256 64B", 0, count, BENCH_MB_MSG_SZ,
+                           start, ret);
+    wc_HmacFree(&hmac);
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            ret = wc_HmacSha256_MultiBuffer(key, keySz, msg, msgSz, out,
+                                            WC_SHA256_MB_LANES);
+            if (ret != 0)
+                goto exit_hmac_mb;
+        }
+        count += times * WC_SHA256_MB_LANES;
+    } while (bench_stats_sym_check(start));
+exit_hmac_mb:
+    bench_stats_sym_finish("HMAC-SHA256-MB 64B", 0, count, BENCH_MB_MSG_SZ,
+                           start, ret);
+#endif /* !NO_HMAC */
+}
+#endif /* WOLFSSL_SHA256_MULTI_BUFFER */
 #endif
 
 #ifdef WOLFSSL_SHA384
@@ -3828,6 +4024,132 @@ exit:
 #endif /* WOLFSSL_NOSHA3_512 */
 #endif
 
+#if (defined(WOLFSSL_SHAKE128) && !defined(WOLFSSL_NO_SHAKE128)) || \
+    (defined(WOLFSSL_SHAKE256) && !defined(WOLFSSL_NO_SHAKE256))
+/* Number of seeds squeezed at once with the multi-buffer API. */
+#define BENCH_SHAKE_MB_CNT  4
+#define BENCH_SHAKE_SEED_SZ 32
+
+/* Benchmark absorbing data and streaming output out of SHAKE.
+ * Output is squeezed a block at a time from one seed and in parallel from
+ * BENCH_SHAKE_MB_CNT seeds.
+ */
+static void bench_shake(int bits)
+{
+    wc_Shake    shake;
+    byte        digest[BENCH_SHAKE_SEED_SZ];
+    const byte* seed[BENCH_SHAKE_MB_CNT];
+    word32      seedSz[BENCH_SHAKE_MB_CNT];
+    byte*       out[BENCH_SHAKE_MB_CNT];
+    word32      blockSz, blocks, outSz;
+    double      start;
+    int         ret = 0, i, count, times;
+
+    blockSz = (bits == 128) ? WC_SHAKE128_BLOCK_SIZE : WC_SHAKE256_BLOCK_SIZE;
+    blocks = bench_size / blockSz;
+    outSz = bench_size / BENCH_SHAKE_MB_CNT;
+    for (i = 0; i < BENCH_SHAKE_MB_CNT; i++) {
+        seed[i] = bench_plain + i * BENCH_SHAKE_SEED_SZ;
+        seedSz[i] = BENCH_SHAKE_SEED_SZ;
+        out[i] = bench_cipher + i * outSz;
+    }
+
+    ret = (bits == 128) ? wc_InitShake128(&shake, HEAP_HINT, INVALID_DEVID) :
+                          wc_InitShake256(&shake, HEAP_HINT, INVALID_DEVID);
+    if (ret != 0) {
+        printf("InitShake%d failed, ret = %d\n", bits, ret);
+        return;
+    }
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            if (bits == 128)
+                ret = wc_Shake128_Update(&shake, bench_plain, bench_size);
+            else
+                ret = wc_Shake256_Update(&shake, bench_plain, bench_size);
+            if (ret != 0)
+                goto exit_absorb;
+        }
+        if (bits == 128)
+            ret = wc_Shake128_Final(&shake, digest, sizeof(digest));
+        else
+            ret = wc_Shake256_Final(&shake, digest, sizeof(digest));
+        if (ret != 0)
+            goto exit_absorb;
+        count += times;
+    } while (bench_stats_sym_check(start));
+exit_absorb:
+    bench_stats_sym_finish((bits == 128) ? "SHAKE128" : "SHAKE256", 0, count,
+                           bench_size, start, ret);
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            if (bits == 128) {
+                ret = wc_Shake128_Absorb(&shake, seed[0], seedSz[0]);
+                if (ret == 0)
+                    ret = wc_Shake128_SqueezeBlocks(&shake, bench_cipher,
+                                                    blocks);
+                wc_InitShake128(&shake, HEAP_HINT, INVALID_DEVID);
+            }
+            else {
+                ret = wc_Shake256_Absorb(&shake, seed[0], seedSz[0]);
+                if (ret == 0)
+                    ret = wc_Shake256_SqueezeBlocks(&shake, bench_cipher,
+                                                    blocks);
+                wc_InitShake256(&shake, HEAP_HINT, INVALID_DEVID);
+            }
+            if (ret != 0)
+                goto exit_squeeze;
+        }
+        count += times;
+    } while (bench_stats_sym_check(start));
+exit_squeeze:
+    bench_stats_sym_finish((bits == 128) ? "SHAKE128-out" :
+                           "SHAKE256-out", 0, count, blocks * blockSz,
+                           start, ret);
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            if (bits == 128)
+                ret = wc_Shake128_MultiBuffer(seed, seedSz, out, outSz,
+                                              BENCH_SHAKE_MB_CNT);
+            else
+                ret = wc_Shake256_MultiBuffer(seed, seedSz, out, outSz,
+                                              BENCH_SHAKE_MB_CNT);
+            if (ret != 0)
+                goto exit_mb;
+        }
+        count += times;
+    } while (bench_stats_sym_check(start));
+exit_mb:
+    bench_stats_sym_finish((bits == 128) ? "SHAKE128-MB-out" :
+                           "SHAKE256-MB-out", 0, count,
+                           outSz * BENCH_SHAKE_MB_CNT, start, ret);
+
+    if (bits == 128)
+        wc_Shake128_Free(&shake);
+    else
+        wc_Shake256_Free(&shake);
+}
+#endif
+
+#if defined(WOLFSSL_SHAKE128) && !defined(WOLFSSL_NO_SHAKE128)
+void bench_shake128(void)
+{
+    bench_shake(128);
+}
+#endif
+
+#if defined(WOLFSSL_SHAKE256) && !defined(WOLFSSL_NO_SHAKE256)
+void bench_shake256(void)
+{
+    bench_shake(256);
+}
+#endif
+
 
 #ifdef WOLFSSL_RIPEMD
 int bench_ripemd(void)
@@ -4459,8 +4781,8 @@ static unsigned char rsa_3072_sig[] = {
 #endif
 
 #if !defined(WOLFSSL_RSA_PUBLIC_ONLY) || defined(WOLFSSL_PUBLIC_MP)
-static void bench_rsa_helper(int doAsync, RsaKey rsaKey[BENCH_MAX_PENDING],
-        int rsaKeySz)
+static void bench_rsa_helper(const char* algo, int doAsync,
+        RsaKey rsaKey[BENCH_MAX_PENDING], int rsaKeySz)
 {
     int         ret = 0, i, times, count = 0, pending = 0;
     word32      idx = 0;
@@ -4523,7 +4845,7 @@ static void bench_rsa_helper(int doAsync, RsaKey rsaKey[BENCH_MAX_PENDING],
             count += times;
         } while (bench_stats_sym_check(start));
 exit_rsa_pub:
-        bench_stats_asym_finish("RSA", rsaKeySz, desc[0], doAsync, count,
+        bench_stats_asym_finish(algo, rsaKeySz, desc[0], doAsync, count,
                                                                     start, ret);
 #endif
 
@@ -4558,7 +4880,7 @@ exit_rsa_pub:
             count += times;
         } while (bench_stats_sym_check(start));
 exit:
-        bench_stats_asym_finish("RSA", rsaKeySz, desc[1], doAsync, count,
+        bench_stats_asym_finish(algo, rsaKeySz, desc[1], doAsync, count,
                                                                     start, ret);
 #endif
     }
@@ -4587,7 +4909,7 @@ exit:
             count += times;
         } while (bench_stats_sym_check(start));
 exit_rsa_sign:
-        bench_stats_asym_finish("RSA", rsaKeySz, desc[4], doAsync, count, start,
+        bench_stats_asym_finish(algo, rsaKeySz, desc[4], doAsync, count, start,
                                                                            ret);
 
         if (ret < 0) {
@@ -4640,7 +4962,7 @@ exit_rsa_sign:
             count += times;
         } while (bench_stats_sym_check(start));
 exit_rsa_verify:
-        bench_stats_asym_finish("RSA", rsaKeySz, desc[5], doAsync, count,
+        bench_stats_asym_finish(algo, rsaKeySz, desc[5], doAsync, count,
                                                                     start, ret);
     }
 
@@ -4728,7 +5050,17 @@ void bench_rsa(int doAsync)
     }
 
 #if !defined(WOLFSSL_RSA_PUBLIC_ONLY) || defined(WOLFSSL_PUBLIC_MP)
-    bench_rsa_helper(doAsync, rsaKey, rsaKeySz);
+    bench_rsa_helper("RSA", doAsync, rsaKey, rsaKeySz);
+#endif
+#if defined(WC_RSA_PRECOMPUTE) && !defined(WOLFSSL_RSA_PUBLIC_ONLY)
+    /* repeat with cached Montgomery constants and blinding values */
+    for (i = 0; i < BENCH_MAX_PENDING; i++) {
+        if ((ret = wc_RsaPrecompute(&rsaKey[i], &gRng)) != 0) {
+            printf("wc_RsaPrecompute failed! %d\n", ret);
+            goto exit_bench_rsa;
+        }
+    }
+    bench_rsa_helper("RSA-PC", doAsync, rsaKey, rsaKeySz);
 #endif
 exit_bench_rsa:
     /* cleanup */
@@ -4783,7 +5115,7 @@ void bench_rsa_key(int doAsync, int rsaKeySz)
         } /* for i */
     } while (pending > 0);
 
-    bench_rsa_helper(doAsync, rsaKey, rsaKeySz);
+    bench_rsa_helper("RSA", doAsync, rsaKey, rsaKeySz);
 exit_bench_rsa_key:
 
     /* cleanup */
@@ -5812,6 +6144,352 @@ exit_ed_verify:
 }
 #endif /* HAVE_ED448 */
 
+#ifdef WOLFSSL_SIGN_BATCH
+/* Sign WC_SIG_BATCH_MAX digests at a time through a signature batch. */
+static void bench_sign_batch_helper(const char* algo, int strength,
+    enum wc_SignatureType sig_type, void* key, word32 key_len)
+{
+    int    ret = 0, i, count;
+    double start;
+    wc_SignatureBatch    batch;
+    wc_SignatureBatchReq req[WC_SIG_BATCH_MAX];
+    byte   digest[WC_SHA256_DIGEST_SIZE];
+    word32 sigSz[WC_SIG_BATCH_MAX];
+    byte*  sig;
+    int    sigMax = wc_SignatureGetSize(sig_type, key, key_len);
+
+    sig = (byte*)XMALLOC(sigMax * WC_SIG_BATCH_MAX, HEAP_HINT,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+    if (sig == NULL) {
+        printf("bench_sign_batch malloc failed\n");
+        return;
+    }
+    for (i = 0; i < (int)sizeof(digest); i++) {
+        digest[i] = (byte)i;
+    }
+
+    ret = wc_SignatureBatchInit(&batch, sig_type, key, key_len, &gRng);
+    if (ret != 0) {
+        printf("wc_SignatureBatchInit failed %d\n", ret);
+        XFREE(sig, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+        return;
+    }
+
+    bench_stats_start(&count, &start);
+    do {
+        for (i = 0; i < WC_SIG_BATCH_MAX; i++) {
+            sigSz[i] = (word32)sigMax;
+            ret = wc_SignatureBatchSubmit(&batch, &req[i], digest,
+                sizeof(digest), sig + sigMax * i, &sigSz[i]);
+            if (ret != WC_PENDING_E && ret != 0)
+                goto exit_sign_batch;
+        }
+        /* the last submit filled the batch and ran it */
+        for (i = 0; i < WC_SIG_BATCH_MAX; i++) {
+            ret = wc_SignatureBatchPoll(&batch, &req[i]);
+            if (ret != 0)
+                goto exit_sign_batch;
+        }
+        count += WC_SIG_BATCH_MAX;
+    } while (bench_stats_sym_check(start));
+exit_sign_batch:
+    bench_stats_asym_finish(algo, strength, "batchsign", 0, count, start, ret);
+
+    wc_SignatureBatchFree(&batch);
+    XFREE(sig, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+}
+
+void bench_sign_batch(void)
+{
+    int ret;
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN)
+    ecc_key eccKey;
+#endif
+#if !defined(NO_RSA) && !defined(WOLFSSL_RSA_PUBLIC_ONLY) && \
+    (defined(USE_CERT_BUFFERS_2048) || defined(USE_CERT_BUFFERS_3072))
+    RsaKey  rsaKey;
+    word32  idx = 0;
+#endif
+
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN)
+    ret = wc_ecc_init_ex(&eccKey, HEAP_HINT, INVALID_DEVID);
+    if (ret == 0)
+        ret = wc_ecc_make_key(&gRng, bench_ecc_size, &eccKey);
+    if (ret == 0) {
+        bench_sign_batch_helper("ECDSA", bench_ecc_size * 8,
+            WC_SIGNATURE_TYPE_ECC, &eccKey, sizeof(eccKey));
+    }
+    else {
+        printf("bench_sign_batch ECC key failed %d\n", ret);
+    }
+    wc_ecc_free(&eccKey);
+#endif
+
+#if !defined(NO_RSA) && !defined(WOLFSSL_RSA_PUBLIC_ONLY) && \
+    (defined(USE_CERT_BUFFERS_2048) || defined(USE_CERT_BUFFERS_3072))
+    ret = wc_InitRsaKey_ex(&rsaKey, HEAP_HINT, INVALID_DEVID);
+    #ifdef WC_RSA_BLINDING
+    if (ret == 0)
+        ret = wc_RsaSetRNG(&rsaKey, &gRng);
+    #endif
+    if (ret == 0) {
+    #ifdef USE_CERT_BUFFERS_2048
+        ret = wc_RsaPrivateKeyDecode(rsa_key_der_2048, &idx, &rsaKey,
+                                     (word32)sizeof_rsa_key_der_2048);
+    #else
+        ret = wc_RsaPrivateKeyDecode(rsa_key_der_3072, &idx, &rsaKey,
+                                     (word32)sizeof_rsa_key_der_3072);
+    #endif
+    }
+    #ifdef WC_RSA_PRECOMPUTE
+    if (ret == 0)
+        ret = wc_RsaPrecompute(&rsaKey, &gRng);
+    #endif
+    if (ret == 0) {
+        bench_sign_batch_helper("RSA", wc_RsaEncryptSize(&rsaKey) * 8,
+            WC_SIGNATURE_TYPE_RSA, &rsaKey, sizeof(rsaKey));
+    }
+    else {
+        printf("bench_sign_batch RSA key failed %d\n", ret);
+    }
+    wc_FreeRsaKey(&rsaKey);
+#endif
+    (void)ret;
+}
+#endif /* WOLFSSL_SIGN_BATCH */
+
+#ifdef WOLFSSL_VERIFY_BATCH
+#define BENCH_VERIFY_BATCH_MAX 256
+#ifdef HAVE_ECC
+    #define BENCH_VERIFY_SIG_MAX ECC_MAX_SIG_SIZE
+#else
+    #define BENCH_VERIFY_SIG_MAX ED25519_SIG_SIZE
+#endif
+
+static const int bench_verify_batch_sz[] = { 8, 16, 32, 64, 128, 256 };
+static const char* bench_verify_batch_desc[] = {
+    "verify-8", "verify-16", "verify-32", "verify-64", "verify-128",
+    "verify-256"
+};
+
+typedef struct BenchVerifyBatch {
+    const byte* sig[BENCH_VERIFY_BATCH_MAX];
+    word32      sigSz[BENCH_VERIFY_BATCH_MAX];
+    const byte* msg[BENCH_VERIFY_BATCH_MAX];
+    word32      msgSz[BENCH_VERIFY_BATCH_MAX];
+    int         res[BENCH_VERIFY_BATCH_MAX];
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && \
+    defined(HAVE_ECC_VERIFY) && !defined(NO_ASN)
+    ecc_key*    eccKey[BENCH_VERIFY_BATCH_MAX];
+#endif
+#if defined(HAVE_ED25519) && defined(HAVE_ED25519_SIGN) && \
+    defined(HAVE_ED25519_VERIFY)
+    ed25519_key* edKey[BENCH_VERIFY_BATCH_MAX];
+#endif
+    byte        msgBuf[BENCH_VERIFY_BATCH_MAX][WC_SHA256_DIGEST_SIZE];
+    byte        sigBuf[BENCH_VERIFY_BATCH_MAX][BENCH_VERIFY_SIG_MAX];
+} BenchVerifyBatch;
+
+/* Verify signatures of different digests in batches of 8 to 256. */
+void bench_verify_batch(void)
+{
+    int    ret = 0, i, j, k, count;
+    double start;
+    BenchVerifyBatch* vb;
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && \
+    defined(HAVE_ECC_VERIFY) && !defined(NO_ASN)
+    ecc_key eccKey;
+#endif
+#if defined(HAVE_ED25519) && defined(HAVE_ED25519_SIGN) && \
+    defined(HAVE_ED25519_VERIFY)
+    ed25519_key edKey;
+#endif
+
+    vb = (BenchVerifyBatch*)XMALLOC(sizeof(BenchVerifyBatch), HEAP_HINT,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+    if (vb == NULL) {
+        printf("bench_verify_batch malloc failed\n");
+        return;
+    }
+    for (i = 0; i < BENCH_VERIFY_BATCH_MAX; i++) {
+        for (j = 0; j < WC_SHA256_DIGEST_SIZE; j++)
+            vb->msgBuf[i][j] = (byte)(i + j);
+        vb->msg[i] = vb->msgBuf[i];
+        vb->msgSz[i] = WC_SHA256_DIGEST_SIZE;
+        vb->sig[i] = vb->sigBuf[i];
+    }
+
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && \
+    defined(HAVE_ECC_VERIFY) && !defined(NO_ASN)
+    ret = wc_ecc_init_ex(&eccKey, HEAP_HINT, INVALID_DEVID);
+    if (ret == 0)
+        ret = wc_ecc_make_key(&gRng, bench_ecc_size, &eccKey);
+    for (i = 0; ret == 0 && i < BENCH_VERIFY_BATCH_MAX; i++) {
+        vb->sigSz[i] = BENCH_VERIFY_SIG_MAX;
+        vb->eccKey[i] = &eccKey;
+        ret = wc_ecc_sign_hash(vb->msg[i], vb->msgSz[i], vb->sigBuf[i],
+                               &vb->sigSz[i], &gRng, &eccKey);
+    }
+    if (ret != 0)
+        printf("bench_verify_batch ECC signing failed %d\n", ret);
+
+    for (k = 0; ret == 0 && k < (int)(sizeof(bench_verify_batch_sz) /
+                                       sizeof(bench_verify_batch_sz[0])); k++) {
+        int n = bench_verify_batch_sz[k];
+
+        bench_stats_start(&count, &start);
+        do {
+            ret = wc_ecc_verify_hash_batch(vb->sig, vb->sigSz, vb->msg,
+                                vb->msgSz, vb->res, vb->eccKey, n);
+            for (i = 0; ret == 0 && i < n; i++) {
+                if (vb->res[i] != 1)
+                    ret = SIG_VERIFY_E;
+            }
+            if (ret != 0) {
+                printf("wc_ecc_verify_hash_batch failed %d\n", ret);
+                break;
+            }
+            count += n;
+        } while (bench_stats_sym_check(start));
+        bench_stats_asym_finish("ECDSA", bench_ecc_size * 8,
+                                bench_verify_batch_desc[k], 0, count, start,
+                                ret);
+    }
+    wc_ecc_free(&eccKey);
+    ret = 0;
+#endif
+
+#if defined(HAVE_ED25519) && defined(HAVE_ED25519_SIGN) && \
+    defined(HAVE_ED25519_VERIFY)
+    wc_ed25519_init(&edKey);
+    ret = wc_ed25519_make_key(&gRng, ED25519_KEY_SIZE, &edKey);
+    for (i = 0; ret == 0 && i < BENCH_VERIFY_BATCH_MAX; i++) {
+        vb->sigSz[i] = ED25519_SIG_SIZE;
+        vb->edKey[i] = &edKey;
+        ret = wc_ed25519_sign_msg(vb->msg[i], vb->msgSz[i], vb->sigBuf[i],
+                                  &vb->sigSz[i], &edKey);
+    }
+    if (ret != 0)
+        printf("bench_verify_batch Ed25519 signing failed %d\n", ret);
+
+    for (k = 0; ret == 0 && k < (int)(sizeof(bench_verify_batch_sz) /
+                                       sizeof(bench_verify_batch_sz[0])); k++) {
+        int n = bench_verify_batch_sz[k];
+
+        bench_stats_start(&count, &start);
+        do {
+            ret = wc_ed25519_verify_batch(vb->sig, vb->sigSz, vb->msg,
+                                vb->msgSz, vb->res, vb->edKey, n, &gRng);
+            if (ret != 0) {
+                printf("wc_ed25519_verify_batch failed %d\n", ret);
+                break;
+            }
+            count += n;
+        } while (bench_stats_sym_check(start));
+        bench_stats_asym_finish("ED", 25519, bench_verify_batch_desc[k], 0,
+                                count, start, ret);
+    }
+    wc_ed25519_free(&edKey);
+#endif
+
+    XFREE(vb, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    (void)ret;
+    (void)j;
+    (void)k;
+    (void)count;
+    (void)start;
+}
+#endif /* WOLFSSL_VERIFY_BATCH */
+
+#if defined(WOLF_CRYPTO_CB_QUEUE) && defined(HAVE_ECC) && \
+    defined(HAVE_ECC_SIGN) && !defined(NO_ASN)
+#define BENCH_CRYPTOCB_QUEUE_DEVID 0x51
+#define BENCH_CRYPTOCB_QUEUE_OPS   16
+
+static const int bench_cryptocb_queue_threads[] = { 1, 2, 4 };
+static const char* bench_cryptocb_queue_desc[] = {
+    "sign-q1", "sign-q2", "sign-q4"
+};
+
+/* ECDSA signing posted in batches to the software queued device with 1, 2
+ * and 4 worker threads. */
+void bench_cryptocb_queue(void)
+{
+    int    ret = 0, i, k, count, res;
+    double start;
+    wc_CryptoCbQueue* queue = NULL;
+    ecc_key* key;
+    byte   (*sig)[ECC_MAX_SIG_SIZE];
+    word32 sigSz[BENCH_CRYPTOCB_QUEUE_OPS];
+    byte   hash[WC_SHA256_DIGEST_SIZE];
+
+    key = (ecc_key*)XMALLOC(sizeof(ecc_key) * BENCH_CRYPTOCB_QUEUE_OPS,
+                            HEAP_HINT, DYNAMIC_TYPE_ECC);
+    sig = (byte(*)[ECC_MAX_SIG_SIZE])XMALLOC(
+                            ECC_MAX_SIG_SIZE * BENCH_CRYPTOCB_QUEUE_OPS,
+                            HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (key == NULL || sig == NULL) {
+        printf("bench_cryptocb_queue malloc failed\n");
+        XFREE(key, HEAP_HINT, DYNAMIC_TYPE_ECC);
+        XFREE(sig, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+        return;
+    }
+    XMEMSET(hash, 0x5a, sizeof(hash));
+
+    for (i = 0; i < BENCH_CRYPTOCB_QUEUE_OPS; i++) {
+        wc_ecc_init_ex(&key[i], HEAP_HINT, INVALID_DEVID);
+        if (ret == 0)
+            ret = wc_ecc_make_key(&gRng, bench_ecc_size, &key[i]);
+        key[i].devId = BENCH_CRYPTOCB_QUEUE_DEVID;
+    }
+    if (ret != 0)
+        printf("bench_cryptocb_queue ECC key failed %d\n", ret);
+
+    for (k = 0; ret == 0 && k < (int)(sizeof(bench_cryptocb_queue_threads) /
+                                sizeof(bench_cryptocb_queue_threads[0])); k++) {
+        ret = wc_CryptoCb_QueueInit(&queue, BENCH_CRYPTOCB_QUEUE_DEVID,
+                    bench_cryptocb_queue_threads[k], NULL, NULL, HEAP_HINT);
+        if (ret != 0) {
+            printf("wc_CryptoCb_QueueInit failed %d\n", ret);
+            break;
+        }
+
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < BENCH_CRYPTOCB_QUEUE_OPS; i++) {
+                sigSz[i] = ECC_MAX_SIG_SIZE;
+                ret = wc_ecc_sign_hash(hash, sizeof(hash), sig[i], &sigSz[i],
+                                       &gRng, &key[i]);
+                if (ret != WC_PENDING_E)
+                    break;
+                ret = 0;
+            }
+            for (i = 0; ret == 0 && i < BENCH_CRYPTOCB_QUEUE_OPS; i++) {
+                ret = wc_CryptoCb_QueueWait(queue, &key[i], &res);
+                if (ret == 0)
+                    ret = res;
+            }
+            if (ret != 0) {
+                printf("bench_cryptocb_queue sign failed %d\n", ret);
+                break;
+            }
+            count += BENCH_CRYPTOCB_QUEUE_OPS;
+        } while (bench_stats_sym_check(start));
+        bench_stats_asym_finish("ECDSA", bench_ecc_size * 8,
+                                bench_cryptocb_queue_desc[k], 0, count, start,
+                                ret);
+
+        wc_CryptoCb_QueueFree(queue);
+        queue = NULL;
+    }
+
+    for (i = 0; i < BENCH_CRYPTOCB_QUEUE_OPS; i++)
+        wc_ecc_free(&key[i]);
+    XFREE(key, HEAP_HINT, DYNAMIC_TYPE_ECC);
+    XFREE(sig, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+}
+#endif /* WOLF_CRYPTO_CB_QUEUE && HAVE_ECC && HAVE_ECC_SIGN && !NO_ASN */
+
 #ifndef HAVE_STACK_SIZE
 #if defined(_WIN32) && !defined(INTIME_RTOS)
 
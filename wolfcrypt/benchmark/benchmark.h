@@ -61,12 +61,15 @@ void bench_md5(int);
 void bench_sha(int);
 void bench_sha224(int);
 void bench_sha256(int);
+void bench_sha256_mb(void);
 void bench_sha384(int);
 void bench_sha512(int);
 void bench_sha3_224(int);
 void bench_sha3_256(int);
 void bench_sha3_384(int);
 void bench_sha3_512(int);
+void bench_shake128(void);
+void bench_shake256(void);
 int  bench_ripemd(void);
 void bench_cmac(void);
 void bench_scrypt(void);
@@ -92,6 +95,9 @@ void bench_curve448KeyGen(void);
 void bench_curve448KeyAgree(void);
 void bench_ed448KeyGen(void);
 void bench_ed448KeySign(void);
+void bench_sign_batch(void);
+void bench_verify_batch(void);
+void bench_cryptocb_queue(void);
 void bench_ntru(void);
 void bench_ntruKeyGen(void);
 void bench_rng(void);
@@ -3900,6 +3900,11 @@ int wc_AesSetIV(Aes* aes, const byte* iv)
     #endif
 
     #ifdef NEED_AES_CTR_SOFT
+        #ifdef WOLFSSL_AESNI
+            /* counter blocks encrypted per AES-NI call */
+            #define AESNI_CTR_BLOCKS 8
+        #endif
+
         /* Increment AES counter */
         static WC_INLINE void IncrementAesCounter(byte* inOutCtr)
         {
@@ -3929,6 +3934,34 @@ int wc_AesSetIV(Aes* aes, const byte* iv)
                sz--;
             }
 
+        #ifdef WOLFSSL_AESNI
+            if (haveAESNI && aes->use_aesni) {
+                /* encrypt batches of counter blocks with the 4 way AES-NI
+                 * ECB code instead of one block at a time */
+                ALIGN16 byte ctrs[AES_BLOCK_SIZE * AESNI_CTR_BLOCKS];
+                word32 blocks, i;
+
+                while (sz >= AES_BLOCK_SIZE) {
+                    blocks = min(sz / AES_BLOCK_SIZE, AESNI_CTR_BLOCKS);
+                    for (i = 0; i < blocks; i++) {
+                        XMEMCPY(ctrs + i * AES_BLOCK_SIZE, aes->reg,
+                                AES_BLOCK_SIZE);
+                        IncrementAesCounter((byte*)aes->reg);
+                    }
+                    AES_ECB_encrypt(ctrs, ctrs, blocks * AES_BLOCK_SIZE,
+                                    (byte*)aes->key, aes->rounds);
+                    xorbuf(ctrs, in, blocks * AES_BLOCK_SIZE);
+                    XMEMCPY(out, ctrs, blocks * AES_BLOCK_SIZE);
+
+                    out += blocks * AES_BLOCK_SIZE;
+                    in  += blocks * AES_BLOCK_SIZE;
+                    sz  -= blocks * AES_BLOCK_SIZE;
+                    aes->left = 0;
+                }
+                ForceZero(ctrs, sizeof(ctrs));
+            }
+        #endif
+
             /* do as many block size ops as possible */
             while (sz >= AES_BLOCK_SIZE) {
             #ifdef XTRANSFORM_AESCTRBLOCK
@@ -281,6 +281,154 @@ int wc_CryptoCb_EccVerify(const byte* sig, word32 siglen,
 }
 #endif /* HAVE_ECC */
 
+#ifdef HAVE_CURVE25519
+int wc_CryptoCb_Curve25519Gen(WC_RNG* rng, int keySize,
+    curve25519_key* key)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+    CryptoCb* dev;
+
+    if (key == NULL)
+        return ret;
+
+    /* locate registered callback */
+    dev = wc_CryptoCb_FindDevice(key->devId);
+    if (dev && dev->cb) {
+        wc_CryptoInfo cryptoInfo;
+        XMEMSET(&cryptoInfo, 0, sizeof(cryptoInfo));
+        cryptoInfo.algo_type = WC_ALGO_TYPE_PK;
+        cryptoInfo.pk.type = WC_PK_TYPE_CURVE25519_KEYGEN;
+        cryptoInfo.pk.curve25519kg.rng = rng;
+        cryptoInfo.pk.curve25519kg.size = keySize;
+        cryptoInfo.pk.curve25519kg.key = key;
+
+        ret = dev->cb(dev->devId, &cryptoInfo, dev->ctx);
+    }
+
+    return wc_CryptoCb_TranslateErrorCode(ret);
+}
+
+int wc_CryptoCb_Curve25519(curve25519_key* private_key,
+    curve25519_key* public_key, byte* out, word32* outlen, int endian)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+    CryptoCb* dev;
+
+    if (private_key == NULL)
+        return ret;
+
+    /* locate registered callback */
+    dev = wc_CryptoCb_FindDevice(private_key->devId);
+    if (dev && dev->cb) {
+        wc_CryptoInfo cryptoInfo;
+        XMEMSET(&cryptoInfo, 0, sizeof(cryptoInfo));
+        cryptoInfo.algo_type = WC_ALGO_TYPE_PK;
+        cryptoInfo.pk.type = WC_PK_TYPE_CURVE25519;
+        cryptoInfo.pk.curve25519.private_key = private_key;
+        cryptoInfo.pk.curve25519.public_key = public_key;
+        cryptoInfo.pk.curve25519.out = out;
+        cryptoInfo.pk.curve25519.outlen = outlen;
+        cryptoInfo.pk.curve25519.endian = endian;
+
+        ret = dev->cb(dev->devId, &cryptoInfo, dev->ctx);
+    }
+
+    return wc_CryptoCb_TranslateErrorCode(ret);
+}
+#endif /* HAVE_CURVE25519 */
+
+#ifdef HAVE_ED25519
+int wc_CryptoCb_Ed25519Gen(WC_RNG* rng, int keySize, ed25519_key* key)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+    CryptoCb* dev;
+
+    if (key == NULL)
+        return ret;
+
+    /* locate registered callback */
+    dev = wc_CryptoCb_FindDevice(key->devId);
+    if (dev && dev->cb) {
+        wc_CryptoInfo cryptoInfo;
+        XMEMSET(&cryptoInfo, 0, sizeof(cryptoInfo));
+        cryptoInfo.algo_type = WC_ALGO_TYPE_PK;
+        cryptoInfo.pk.type = WC_PK_TYPE_ED25519_KEYGEN;
+        cryptoInfo.pk.ed25519kg.rng = rng;
+        cryptoInfo.pk.ed25519kg.size = keySize;
+        cryptoInfo.pk.ed25519kg.key = key;
+
+        ret = dev->cb(dev->devId, &cryptoInfo, dev->ctx);
+    }
+
+    return wc_CryptoCb_TranslateErrorCode(ret);
+}
+
+int wc_CryptoCb_Ed25519Sign(const byte* in, word32 inLen, byte* out,
+    word32 *outLen, ed25519_key* key, byte type, const byte* context,
+    byte contextLen)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+    CryptoCb* dev;
+
+    if (key == NULL)
+        return ret;
+
+    /* locate registered callback */
+    dev = wc_CryptoCb_FindDevice(key->devId);
+    if (dev && dev->cb) {
+        wc_CryptoInfo cryptoInfo;
+        XMEMSET(&cryptoInfo, 0, sizeof(cryptoInfo));
+        cryptoInfo.algo_type = WC_ALGO_TYPE_PK;
+        cryptoInfo.pk.type = WC_PK_TYPE_ED25519;
+        cryptoInfo.pk.ed25519sign.in = in;
+        cryptoInfo.pk.ed25519sign.inLen = inLen;
+        cryptoInfo.pk.ed25519sign.out = out;
+        cryptoInfo.pk.ed25519sign.outLen = outLen;
+        cryptoInfo.pk.ed25519sign.key = key;
+        cryptoInfo.pk.ed25519sign.type = type;
+        cryptoInfo.pk.ed25519sign.context = context;
+        cryptoInfo.pk.ed25519sign.contextLen = contextLen;
+
+        ret = dev->cb(dev->devId, &cryptoInfo, dev->ctx);
+    }
+
+    return wc_CryptoCb_TranslateErrorCode(ret);
+}
+
+int wc_CryptoCb_Ed25519Verify(const byte* sig, word32 sigLen,
+    const byte* msg, word32 msgLen, int* res, ed25519_key* key, byte type,
+    const byte* context, byte contextLen)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+    CryptoCb* dev;
+
+    if (key == NULL)
+        return ret;
+
+    /* locate registered callback */
+    dev = wc_CryptoCb_FindDevice(key->devId);
+    if (dev && dev->cb) {
+        wc_CryptoInfo cryptoInfo;
+        XMEMSET(&cryptoInfo, 0, sizeof(cryptoInfo));
+        cryptoInfo.algo_type = WC_ALGO_TYPE_PK;
+        cryptoInfo.pk.type = WC_PK_TYPE_ED25519_VERIFY;
+        cryptoInfo.pk.ed25519verify.sig = sig;
+        cryptoInfo.pk.ed25519verify.sigLen = sigLen;
+        cryptoInfo.pk.ed25519verify.msg = msg;
+        cryptoInfo.pk.ed25519verify.msgLen = msgLen;
+        cryptoInfo.pk.ed25519verify.res = res;
+        cryptoInfo.pk.ed25519verify.key = key;
+        cryptoInfo.pk.ed25519verify.type = type;
+        cryptoInfo.pk.ed25519verify.context = context;
+        cryptoInfo.pk.ed25519verify.contextLen = contextLen;
+
+        ret = dev->cb(dev->devId, &cryptoInfo, dev->ctx);
+    }
+
+    return wc_CryptoCb_TranslateErrorCode(ret);
+}
+#endif /* HAVE_ED25519 */
+
 #ifndef NO_AES
 #ifdef HAVE_AESGCM
 int wc_CryptoCb_AesGcmEncrypt(Aes* aes, byte* out,
@@ -499,6 +647,74 @@ int wc_CryptoCb_Des3Decrypt(Des3* des3, byte* out,
 }
 #endif /* !NO_DES3 */
 
+#if defined(HAVE_CHACHA) && defined(HAVE_POLY1305)
+int wc_CryptoCb_ChaCha20Poly1305Encrypt(ChaCha* chacha, byte* out,
+    const byte* in, word32 sz, const byte* iv, byte* authTag,
+    const byte* authIn, word32 authInSz)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+    CryptoCb* dev;
+
+    if (chacha == NULL)
+        return ret;
+
+    /* locate registered callback */
+    dev = wc_CryptoCb_FindDevice(chacha->devId);
+    if (dev && dev->cb) {
+        wc_CryptoInfo cryptoInfo;
+        XMEMSET(&cryptoInfo, 0, sizeof(cryptoInfo));
+        cryptoInfo.algo_type = WC_ALGO_TYPE_CIPHER;
+        cryptoInfo.cipher.type = WC_CIPHER_CHACHA20_POLY1305;
+        cryptoInfo.cipher.enc = 1;
+        cryptoInfo.cipher.chachapoly_enc.chacha   = chacha;
+        cryptoInfo.cipher.chachapoly_enc.out      = out;
+        cryptoInfo.cipher.chachapoly_enc.in       = in;
+        cryptoInfo.cipher.chachapoly_enc.sz       = sz;
+        cryptoInfo.cipher.chachapoly_enc.iv       = iv;
+        cryptoInfo.cipher.chachapoly_enc.authTag  = authTag;
+        cryptoInfo.cipher.chachapoly_enc.authIn   = authIn;
+        cryptoInfo.cipher.chachapoly_enc.authInSz = authInSz;
+
+        ret = dev->cb(dev->devId, &cryptoInfo, dev->ctx);
+    }
+
+    return wc_CryptoCb_TranslateErrorCode(ret);
+}
+
+int wc_CryptoCb_ChaCha20Poly1305Decrypt(ChaCha* chacha, byte* out,
+    const byte* in, word32 sz, const byte* iv, const byte* authTag,
+    const byte* authIn, word32 authInSz)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+    CryptoCb* dev;
+
+    if (chacha == NULL)
+        return ret;
+
+    /* locate registered callback */
+    dev = wc_CryptoCb_FindDevice(chacha->devId);
+    if (dev && dev->cb) {
+        wc_CryptoInfo cryptoInfo;
+        XMEMSET(&cryptoInfo, 0, sizeof(cryptoInfo));
+        cryptoInfo.algo_type = WC_ALGO_TYPE_CIPHER;
+        cryptoInfo.cipher.type = WC_CIPHER_CHACHA20_POLY1305;
+        cryptoInfo.cipher.enc = 0;
+        cryptoInfo.cipher.chachapoly_dec.chacha   = chacha;
+        cryptoInfo.cipher.chachapoly_dec.out      = out;
+        cryptoInfo.cipher.chachapoly_dec.in       = in;
+        cryptoInfo.cipher.chachapoly_dec.sz       = sz;
+        cryptoInfo.cipher.chachapoly_dec.iv       = iv;
+        cryptoInfo.cipher.chachapoly_dec.authTag  = authTag;
+        cryptoInfo.cipher.chachapoly_dec.authIn   = authIn;
+        cryptoInfo.cipher.chachapoly_dec.authInSz = authInSz;
+
+        ret = dev->cb(dev->devId, &cryptoInfo, dev->ctx);
+    }
+
+    return wc_CryptoCb_TranslateErrorCode(ret);
+}
+#endif /* HAVE_CHACHA && HAVE_POLY1305 */
+
 #ifndef NO_SHA
 int wc_CryptoCb_ShaHash(wc_Sha* sha, const byte* in,
     word32 inSz, byte* digest)
@@ -565,6 +781,72 @@ int wc_CryptoCb_Sha256Hash(wc_Sha256* sha256, const byte* in,
 }
 #endif /* !NO_SHA256 */
 
+#ifdef WOLFSSL_SHA384
+int wc_CryptoCb_Sha384Hash(wc_Sha384* sha384, const byte* in,
+    word32 inSz, byte* digest)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+    CryptoCb* dev;
+
+    /* locate registered callback */
+    if (sha384) {
+        dev = wc_CryptoCb_FindDevice(sha384->devId);
+    }
+    else {
+        /* locate first callback and try using it */
+        dev = wc_CryptoCb_FindDeviceByIndex(0);
+    }
+
+    if (dev && dev->cb) {
+        wc_CryptoInfo cryptoInfo;
+        XMEMSET(&cryptoInfo, 0, sizeof(cryptoInfo));
+        cryptoInfo.algo_type = WC_ALGO_TYPE_HASH;
+        cryptoInfo.hash.type = WC_HASH_TYPE_SHA384;
+        cryptoInfo.hash.sha384 = sha384;
+        cryptoInfo.hash.in = in;
+        cryptoInfo.hash.inSz = inSz;
+        cryptoInfo.hash.digest = digest;
+
+        ret = dev->cb(dev->devId, &cryptoInfo, dev->ctx);
+    }
+
+    return wc_CryptoCb_TranslateErrorCode(ret);
+}
+#endif /* WOLFSSL_SHA384 */
+
+#ifdef WOLFSSL_SHA512
+int wc_CryptoCb_Sha512Hash(wc_Sha512* sha512, const byte* in,
+    word32 inSz, byte* digest)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+    CryptoCb* dev;
+
+    /* locate registered callback */
+    if (sha512) {
+        dev = wc_CryptoCb_FindDevice(sha512->devId);
+    }
+    else {
+        /* locate first callback and try using it */
+        dev = wc_CryptoCb_FindDeviceByIndex(0);
+    }
+
+    if (dev && dev->cb) {
+        wc_CryptoInfo cryptoInfo;
+        XMEMSET(&cryptoInfo, 0, sizeof(cryptoInfo));
+        cryptoInfo.algo_type = WC_ALGO_TYPE_HASH;
+        cryptoInfo.hash.type = WC_HASH_TYPE_SHA512;
+        cryptoInfo.hash.sha512 = sha512;
+        cryptoInfo.hash.in = in;
+        cryptoInfo.hash.inSz = inSz;
+        cryptoInfo.hash.digest = digest;
+
+        ret = dev->cb(dev->devId, &cryptoInfo, dev->ctx);
+    }
+
+    return wc_CryptoCb_TranslateErrorCode(ret);
+}
+#endif /* WOLFSSL_SHA512 */
+
 #ifndef NO_HMAC
 int wc_CryptoCb_Hmac(Hmac* hmac, int macType, const byte* in, word32 inSz,
     byte* digest)
@@ -594,6 +876,38 @@ int wc_CryptoCb_Hmac(Hmac* hmac, int macType, const byte* in, word32 inSz,
 }
 #endif /* !NO_HMAC */
 
+#ifdef HAVE_HKDF
+int wc_CryptoCb_Hkdf(int devId, int kdfType, int hashType,
+    const byte* inKey, word32 inKeySz, const byte* salt, word32 saltSz,
+    const byte* info, word32 infoSz, byte* out, word32 outSz)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+    CryptoCb* dev;
+
+    /* locate registered callback */
+    dev = wc_CryptoCb_FindDevice(devId);
+    if (dev && dev->cb) {
+        wc_CryptoInfo cryptoInfo;
+        XMEMSET(&cryptoInfo, 0, sizeof(cryptoInfo));
+        cryptoInfo.algo_type = WC_ALGO_TYPE_KDF;
+        cryptoInfo.kdf.type = kdfType;
+        cryptoInfo.kdf.hashType = hashType;
+        cryptoInfo.kdf.inKey = inKey;
+        cryptoInfo.kdf.inKeySz = inKeySz;
+        cryptoInfo.kdf.salt = salt;
+        cryptoInfo.kdf.saltSz = saltSz;
+        cryptoInfo.kdf.info = info;
+        cryptoInfo.kdf.infoSz = infoSz;
+        cryptoInfo.kdf.out = out;
+        cryptoInfo.kdf.outSz = outSz;
+
+        ret = dev->cb(dev->devId, &cryptoInfo, dev->ctx);
+    }
+
+    return wc_CryptoCb_TranslateErrorCode(ret);
+}
+#endif /* HAVE_HKDF */
+
 #ifndef WC_NO_RNG
 int wc_CryptoCb_RandomBlock(WC_RNG* rng, byte* out, word32 sz)
 {
@@ -645,4 +959,594 @@ int wc_CryptoCb_RandomSeed(OS_Seed* os, byte* seed, word32 sz)
 }
 #endif /* !WC_NO_RNG */
 
+#ifdef WOLF_CRYPTO_CB_QUEUE
+
+#ifndef WOLFSSL_PTHREADS
+    #error WOLF_CRYPTO_CB_QUEUE requires pthreads
+#endif
+
+#ifndef WC_CRYPTOCB_QUEUE_MAX_THREADS
+#define WC_CRYPTOCB_QUEUE_MAX_THREADS 64
+#endif
+
+/* Queued operation, event must be first so completed events map back */
+typedef struct CryptoCbJob {
+    WOLF_EVENT          event;
+    wc_CryptoInfo       info;
+    struct CryptoCbJob* next;
+} CryptoCbJob;
+
+struct wc_CryptoCbQueue {
+    WOLF_EVENT_QUEUE      done;       /* completion queue */
+    wolfSSL_Mutex         lock;       /* protects job lists and counters */
+    pthread_cond_t        work;       /* signaled when jobs are submitted */
+    pthread_cond_t        complete;   /* signaled when a job completes */
+    CryptoCbJob*          staged;     /* posted, not yet submitted */
+    CryptoCbJob*          stagedTail;
+    CryptoCbJob*          head;       /* submitted, waiting for a worker */
+    CryptoCbJob*          tail;
+    word32                completed;  /* completion count for waiters */
+    int                   stop;
+    int                   devId;
+    int                   threadCnt;
+    pthread_t*            threads;
+    CryptoDevCallbackFunc cb;
+    void*                 ctx;
+    void*                 heap;
+};
+
+/* returns the object an operation is queued on, NULL when not queued */
+static void* wc_CryptoCb_QueueObject(wc_CryptoInfo* info)
+{
+    void* obj = NULL;
+
+#if !defined(NO_RSA) || defined(HAVE_ECC)
+    if (info->algo_type == WC_ALGO_TYPE_PK) {
+        switch (info->pk.type) {
+        #ifndef NO_RSA
+            case WC_PK_TYPE_RSA:
+                obj = info->pk.rsa.key;
+                break;
+        #ifdef WOLFSSL_KEY_GEN
+            case WC_PK_TYPE_RSA_KEYGEN:
+                obj = info->pk.rsakg.key;
+                break;
+        #endif
+        #endif /* !NO_RSA */
+        #ifdef HAVE_ECC
+            case WC_PK_TYPE_EC_KEYGEN:
+                obj = info->pk.eckg.key;
+                break;
+            case WC_PK_TYPE_ECDH:
+                obj = info->pk.ecdh.private_key;
+                break;
+            case WC_PK_TYPE_ECDSA_SIGN:
+                obj = info->pk.eccsign.key;
+                break;
+            case WC_PK_TYPE_ECDSA_VERIFY:
+                obj = info->pk.eccverify.key;
+                break;
+        #endif /* HAVE_ECC */
+            default:
+                break;
+        }
+    }
+#endif /* !NO_RSA || HAVE_ECC */
+#if !defined(NO_AES) || !defined(NO_DES3)
+    if (info->algo_type == WC_ALGO_TYPE_CIPHER) {
+        switch (info->cipher.type) {
+        #ifndef NO_AES
+        #ifdef HAVE_AESGCM
+            case WC_CIPHER_AES_GCM:
+                obj = info->cipher.enc ? info->cipher.aesgcm_enc.aes :
+                                         info->cipher.aesgcm_dec.aes;
+                break;
+        #endif
+        #ifdef HAVE_AES_CBC
+            case WC_CIPHER_AES_CBC:
+                obj = info->cipher.aescbc.aes;
+                break;
+        #endif
+        #endif /* !NO_AES */
+        #ifndef NO_DES3
+            case WC_CIPHER_DES3:
+                obj = info->cipher.des3.des;
+                break;
+        #endif
+            default:
+                break;
+        }
+    }
+#endif /* !NO_AES || !NO_DES3 */
+
+    return obj;
+}
+
+/* Software device: runs the operation with wolfCrypt on the worker thread.
+ * The object's devId is cleared so the call does not loop back into the
+ * queue. rng is the worker's own generator, when available, as a WC_RNG is
+ * not safe to share between threads. */
+static int wc_CryptoCb_QueueSoftware(int devId, wc_CryptoInfo* info,
+    WC_RNG* rng)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+
+    (void)devId;
+    (void)rng;
+
+#if !defined(NO_RSA) || defined(HAVE_ECC)
+    if (info->algo_type == WC_ALGO_TYPE_PK) {
+    #ifndef NO_RSA
+        if (info->pk.type == WC_PK_TYPE_RSA) {
+            info->pk.rsa.key->devId = INVALID_DEVID;
+            ret = wc_RsaFunction(info->pk.rsa.in, info->pk.rsa.inLen,
+                info->pk.rsa.out, info->pk.rsa.outLen, info->pk.rsa.type,
+                info->pk.rsa.key, rng ? rng : info->pk.rsa.rng);
+            info->pk.rsa.key->devId = devId;
+        }
+    #ifdef WOLFSSL_KEY_GEN
+        else if (info->pk.type == WC_PK_TYPE_RSA_KEYGEN) {
+            info->pk.rsakg.key->devId = INVALID_DEVID;
+            ret = wc_MakeRsaKey(info->pk.rsakg.key, info->pk.rsakg.size,
+                info->pk.rsakg.e, rng ? rng : info->pk.rsakg.rng);
+            info->pk.rsakg.key->devId = devId;
+        }
+    #endif
+    #endif /* !NO_RSA */
+    #ifdef HAVE_ECC
+        if (info->pk.type == WC_PK_TYPE_EC_KEYGEN) {
+            info->pk.eckg.key->devId = INVALID_DEVID;
+            ret = wc_ecc_make_key_ex(rng ? rng : info->pk.eckg.rng,
+                info->pk.eckg.size, info->pk.eckg.key, info->pk.eckg.curveId);
+            info->pk.eckg.key->devId = devId;
+        }
+    #ifdef HAVE_ECC_DHE
+        else if (info->pk.type == WC_PK_TYPE_ECDH) {
+            info->pk.ecdh.private_key->devId = INVALID_DEVID;
+            ret = wc_ecc_shared_secret(info->pk.ecdh.private_key,
+                info->pk.ecdh.public_key, info->pk.ecdh.out,
+                info->pk.ecdh.outlen);
+            info->pk.ecdh.private_key->devId = devId;
+        }
+    #endif
+    #ifdef HAVE_ECC_SIGN
+        else if (info->pk.type == WC_PK_TYPE_ECDSA_SIGN) {
+            info->pk.eccsign.key->devId = INVALID_DEVID;
+            ret = wc_ecc_sign_hash(info->pk.eccsign.in, info->pk.eccsign.inlen,
+                info->pk.eccsign.out, info->pk.eccsign.outlen,
+                rng ? rng : info->pk.eccsign.rng, info->pk.eccsign.key);
+            info->pk.eccsign.key->devId = devId;
+        }
+    #endif
+    #ifdef HAVE_ECC_VERIFY
+        else if (info->pk.type == WC_PK_TYPE_ECDSA_VERIFY) {
+            info->pk.eccverify.key->devId = INVALID_DEVID;
+            ret = wc_ecc_verify_hash(info->pk.eccverify.sig,
+                info->pk.eccverify.siglen, info->pk.eccverify.hash,
+                info->pk.eccverify.hashlen, info->pk.eccverify.res,
+                info->pk.eccverify.key);
+            info->pk.eccverify.key->devId = devId;
+        }
+    #endif
+    #endif /* HAVE_ECC */
+    }
+#endif /* !NO_RSA || HAVE_ECC */
+#if !defined(NO_AES) || !defined(NO_DES3)
+    if (info->algo_type == WC_ALGO_TYPE_CIPHER) {
+    #ifndef NO_AES
+    #ifdef HAVE_AESGCM
+        if (info->cipher.type == WC_CIPHER_AES_GCM && info->cipher.enc) {
+            info->cipher.aesgcm_enc.aes->devId = INVALID_DEVID;
+            ret = wc_AesGcmEncrypt(info->cipher.aesgcm_enc.aes,
+                info->cipher.aesgcm_enc.out, info->cipher.aesgcm_enc.in,
+                info->cipher.aesgcm_enc.sz, info->cipher.aesgcm_enc.iv,
+                info->cipher.aesgcm_enc.ivSz, info->cipher.aesgcm_enc.authTag,
+                info->cipher.aesgcm_enc.authTagSz,
+                info->cipher.aesgcm_enc.authIn,
+                info->cipher.aesgcm_enc.authInSz);
+            info->cipher.aesgcm_enc.aes->devId = devId;
+        }
+        else if (info->cipher.type == WC_CIPHER_AES_GCM) {
+            info->cipher.aesgcm_dec.aes->devId = INVALID_DEVID;
+            ret = wc_AesGcmDecrypt(info->cipher.aesgcm_dec.aes,
+                info->cipher.aesgcm_dec.out, info->cipher.aesgcm_dec.in,
+                info->cipher.aesgcm_dec.sz, info->cipher.aesgcm_dec.iv,
+                info->cipher.aesgcm_dec.ivSz, info->cipher.aesgcm_dec.authTag,
+                info->cipher.aesgcm_dec.authTagSz,
+                info->cipher.aesgcm_dec.authIn,
+                info->cipher.aesgcm_dec.authInSz);
+            info->cipher.aesgcm_dec.aes->devId = devId;
+        }
+    #endif /* HAVE_AESGCM */
+    #ifdef HAVE_AES_CBC
+        if (info->cipher.type == WC_CIPHER_AES_CBC) {
+            info->cipher.aescbc.aes->devId = INVALID_DEVID;
+            if (info->cipher.enc) {
+                ret = wc_AesCbcEncrypt(info->cipher.aescbc.aes,
+                    info->cipher.aescbc.out, info->cipher.aescbc.in,
+                    info->cipher.aescbc.sz);
+            }
+            else {
+                ret = wc_AesCbcDecrypt(info->cipher.aescbc.aes,
+                    info->cipher.aescbc.out, info->cipher.aescbc.in,
+                    info->cipher.aescbc.sz);
+            }
+            info->cipher.aescbc.aes->devId = devId;
+        }
+    #endif /* HAVE_AES_CBC */
+    #endif /* !NO_AES */
+    #ifndef NO_DES3
+        if (info->cipher.type == WC_CIPHER_DES3) {
+            info->cipher.des3.des->devId = INVALID_DEVID;
+            if (info->cipher.enc) {
+                ret = wc_Des3_CbcEncrypt(info->cipher.des3.des,
+                    info->cipher.des3.out, info->cipher.des3.in,
+                    info->cipher.des3.sz);
+            }
+            else {
+                ret = wc_Des3_CbcDecrypt(info->cipher.des3.des,
+                    info->cipher.des3.out, info->cipher.des3.in,
+                    info->cipher.des3.sz);
+            }
+            info->cipher.des3.des->devId = devId;
+        }
+    #endif /* !NO_DES3 */
+    }
+#endif /* !NO_AES || !NO_DES3 */
+
+    return ret;
+}
+
+/* Device callback registered for the queue's devId: posts the operation */
+static int wc_CryptoCb_QueuePost(int devId, wc_CryptoInfo* info, void* ctx)
+{
+    wc_CryptoCbQueue* queue = (wc_CryptoCbQueue*)ctx;
+    CryptoCbJob* job;
+    void* obj;
+    int ret;
+
+    if (info == NULL || queue == NULL)
+        return BAD_FUNC_ARG;
+
+    obj = wc_CryptoCb_QueueObject(info);
+    if (obj == NULL) {
+        /* hash, HMAC and RNG requests are not queued */
+        if (queue->cb != NULL)
+            return queue->cb(devId, info, queue->ctx);
+        return CRYPTOCB_UNAVAILABLE;
+    }
+
+    job = (CryptoCbJob*)XMALLOC(sizeof(CryptoCbJob), queue->heap,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+    if (job == NULL)
+        return MEMORY_E;
+    XMEMSET(job, 0, sizeof(CryptoCbJob));
+
+    ret = wolfEvent_Init(&job->event, WOLF_EVENT_TYPE_CRYPTOCB, obj);
+    if (ret == 0) {
+        job->event.dev.ptr = queue;
+        job->event.ret = WC_PENDING_E;
+        job->event.state = WOLF_EVENT_STATE_PENDING;
+        XMEMCPY(&job->info, info, sizeof(wc_CryptoInfo));
+        ret = wolfEventQueue_Push(&queue->done, &job->event);
+    }
+    if (ret != 0) {
+        XFREE(job, queue->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        return ret;
+    }
+
+    /* dispatched to the workers on the next submit, after the caller has
+     * recorded its own pending state */
+    if (wc_LockMutex(&queue->lock) != 0) {
+        if (wc_LockMutex(&queue->done.lock) == 0) {
+            wolfEventQueue_Remove(&queue->done, &job->event);
+            wc_UnLockMutex(&queue->done.lock);
+            XFREE(job, queue->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        }
+        return BAD_MUTEX_E;
+    }
+    if (queue->stagedTail == NULL)
+        queue->staged = job;
+    else
+        queue->stagedTail->next = job;
+    queue->stagedTail = job;
+    wc_UnLockMutex(&queue->lock);
+
+    return WC_PENDING_E;
+}
+
+static void* wc_CryptoCb_QueueWorker(void* arg)
+{
+    wc_CryptoCbQueue* queue = (wc_CryptoCbQueue*)arg;
+    CryptoCbJob* job;
+    WC_RNG* rng = NULL;
+    int ret;
+#ifndef WC_NO_RNG
+    WC_RNG workerRng;
+
+    if (wc_InitRng_ex(&workerRng, queue->heap, INVALID_DEVID) == 0)
+        rng = &workerRng;
+#endif
+
+    for (;;) {
+        if (wc_LockMutex(&queue->lock) != 0)
+            break;
+        while (queue->head == NULL && !queue->stop)
+            pthread_cond_wait(&queue->work, &queue->lock);
+        job = queue->head;
+        if (job != NULL) {
+            queue->head = job->next;
+            if (queue->head == NULL)
+                queue->tail = NULL;
+        }
+        wc_UnLockMutex(&queue->lock);
+
+        /* stopped and drained */
+        if (job == NULL)
+            break;
+
+        ret = CRYPTOCB_UNAVAILABLE;
+        if (queue->cb != NULL) {
+            ret = wc_CryptoCb_TranslateErrorCode(
+                queue->cb(queue->devId, &job->info, queue->ctx));
+        }
+        if (ret == CRYPTOCB_UNAVAILABLE)
+            ret = wc_CryptoCb_QueueSoftware(queue->devId, &job->info, rng);
+
+        if (wc_LockMutex(&queue->done.lock) == 0) {
+            job->event.ret = ret;
+            job->event.state = WOLF_EVENT_STATE_DONE;
+            wc_UnLockMutex(&queue->done.lock);
+        }
+
+        if (wc_LockMutex(&queue->lock) == 0) {
+            queue->completed++;
+            pthread_cond_broadcast(&queue->complete);
+            wc_UnLockMutex(&queue->lock);
+        }
+    }
+
+#ifndef WC_NO_RNG
+    if (rng != NULL)
+        wc_FreeRng(rng);
+#endif
+
+    return NULL;
+}
+
+/* Creates a queued device for devId served by threads workers. cb is the
+ * backend run on the workers, returning CRYPTOCB_UNAVAILABLE from it falls
+ * back to the software device. */
+int wc_CryptoCb_QueueInit(wc_CryptoCbQueue** queue, int devId, int threads,
+    CryptoDevCallbackFunc cb, void* ctx, void* heap)
+{
+    wc_CryptoCbQueue* q;
+    int ret = 0;
+    int i;
+
+    if (queue == NULL || devId == INVALID_DEVID || threads <= 0 ||
+                                      threads > WC_CRYPTOCB_QUEUE_MAX_THREADS) {
+        return BAD_FUNC_ARG;
+    }
+    *queue = NULL;
+
+    q = (wc_CryptoCbQueue*)XMALLOC(sizeof(wc_CryptoCbQueue), heap,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+    if (q == NULL)
+        return MEMORY_E;
+    XMEMSET(q, 0, sizeof(wc_CryptoCbQueue));
+    q->devId = devId;
+    q->cb = cb;
+    q->ctx = ctx;
+    q->heap = heap;
+
+    q->threads = (pthread_t*)XMALLOC(sizeof(pthread_t) * threads, heap,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+    if (q->threads == NULL) {
+        XFREE(q, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        return MEMORY_E;
+    }
+
+    if (wolfEventQueue_Init(&q->done) != 0) {
+        ret = BAD_MUTEX_E;
+    }
+    else if (wc_InitMutex(&q->lock) != 0) {
+        wolfEventQueue_Free(&q->done);
+        ret = BAD_MUTEX_E;
+    }
+    else if (pthread_cond_init(&q->work, NULL) != 0) {
+        wc_FreeMutex(&q->lock);
+        wolfEventQueue_Free(&q->done);
+        ret = BAD_COND_E;
+    }
+    else if (pthread_cond_init(&q->complete, NULL) != 0) {
+        pthread_cond_destroy(&q->work);
+        wc_FreeMutex(&q->lock);
+        wolfEventQueue_Free(&q->done);
+        ret = BAD_COND_E;
+    }
+    if (ret != 0) {
+        XFREE(q->threads, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(q, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        return ret;
+    }
+
+    for (i = 0; i < threads; i++) {
+        if (pthread_create(&q->threads[i], NULL, wc_CryptoCb_QueueWorker,
+                                                                     q) != 0) {
+            ret = WC_INIT_E;
+            break;
+        }
+        q->threadCnt++;
+    }
+
+    if (ret == 0)
+        ret = wc_CryptoCb_RegisterDevice(devId, wc_CryptoCb_QueuePost, q);
+
+    if (ret != 0) {
+        wc_CryptoCb_QueueFree(q);
+        return ret;
+    }
+
+    *queue = q;
+
+    return 0;
+}
+
+/* Dispatches all posted operations to the workers */
+int wc_CryptoCb_QueueSubmit(wc_CryptoCbQueue* queue)
+{
+    if (queue == NULL)
+        return BAD_FUNC_ARG;
+
+    if (wc_LockMutex(&queue->lock) != 0)
+        return BAD_MUTEX_E;
+    if (queue->staged != NULL) {
+        if (queue->tail == NULL)
+            queue->head = queue->staged;
+        else
+            queue->tail->next = queue->staged;
+        queue->tail = queue->stagedTail;
+        queue->staged = NULL;
+        queue->stagedTail = NULL;
+        pthread_cond_broadcast(&queue->work);
+    }
+    wc_UnLockMutex(&queue->lock);
+
+    return 0;
+}
+
+/* Submits posted operations and removes up to maxEvents completed events,
+ * optionally only those for context. Each returned event is released with
+ * wc_CryptoCb_QueueEventFree. */
+int wc_CryptoCb_QueuePoll(wc_CryptoCbQueue* queue, void* context,
+    WOLF_EVENT** events, int maxEvents, int* eventCount)
+{
+    int ret;
+
+    if (queue == NULL || events == NULL || maxEvents <= 0 ||
+                                                        eventCount == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    ret = wc_CryptoCb_QueueSubmit(queue);
+    if (ret == 0) {
+        ret = wolfEventQueue_Poll(&queue->done, context, events, maxEvents,
+                                                               0, eventCount);
+    }
+
+    return ret;
+}
+
+/* returns 1 when an event for context is on the completion queue */
+static int wc_CryptoCb_QueueHasEvent(wc_CryptoCbQueue* queue, void* context)
+{
+    WOLF_EVENT* event;
+    int found = 0;
+
+    if (wc_LockMutex(&queue->done.lock) != 0)
+        return 0;
+    for (event = queue->done.head; event != NULL; event = event->next) {
+        if (event->context == context) {
+            found = 1;
+            break;
+        }
+    }
+    wc_UnLockMutex(&queue->done.lock);
+
+    return found;
+}
+
+/* Blocks until the operation on context completes and stores its result.
+ * Returns WC_NOT_PENDING_E when nothing is queued for context. */
+int wc_CryptoCb_QueueWait(wc_CryptoCbQueue* queue, void* context, int* result)
+{
+    WOLF_EVENT* event = NULL;
+    word32 completed;
+    int count = 0;
+    int ret;
+
+    if (queue == NULL || context == NULL || result == NULL)
+        return BAD_FUNC_ARG;
+
+    ret = wc_CryptoCb_QueueSubmit(queue);
+    while (ret == 0) {
+        if (wc_LockMutex(&queue->lock) != 0) {
+            ret = BAD_MUTEX_E;
+            break;
+        }
+        completed = queue->completed;
+        wc_UnLockMutex(&queue->lock);
+
+        ret = wolfEventQueue_Poll(&queue->done, context, &event, 1, 0, &count);
+        if (ret != 0 || count > 0)
+            break;
+        if (!wc_CryptoCb_QueueHasEvent(queue, context)) {
+            ret = WC_NOT_PENDING_E;
+            break;
+        }
+
+        /* wait for the next completion */
+        if (wc_LockMutex(&queue->lock) != 0) {
+            ret = BAD_MUTEX_E;
+            break;
+        }
+        while (queue->completed == completed)
+            pthread_cond_wait(&queue->complete, &queue->lock);
+        wc_UnLockMutex(&queue->lock);
+    }
+
+    if (ret == 0 && event != NULL) {
+        *result = event->ret;
+        wc_CryptoCb_QueueEventFree(queue, event);
+    }
+
+    return ret;
+}
+
+void wc_CryptoCb_QueueEventFree(wc_CryptoCbQueue* queue, WOLF_EVENT* event)
+{
+    if (queue != NULL && event != NULL)
+        XFREE(event, queue->heap, DYNAMIC_TYPE_TMP_BUFFER);
+}
+
+/* Unregisters the device, finishes submitted operations and releases every
+ * event still held by the queue */
+void wc_CryptoCb_QueueFree(wc_CryptoCbQueue* queue)
+{
+    WOLF_EVENT* event = NULL;
+    CryptoCb* dev;
+    void* heap;
+    int i;
+
+    if (queue == NULL)
+        return;
+    heap = queue->heap;
+
+    dev = wc_CryptoCb_FindDevice(queue->devId);
+    if (dev != NULL && dev->ctx == queue)
+        wc_CryptoCb_UnRegisterDevice(queue->devId);
+
+    if (wc_LockMutex(&queue->lock) == 0) {
+        queue->stop = 1;
+        pthread_cond_broadcast(&queue->work);
+        wc_UnLockMutex(&queue->lock);
+    }
+    for (i = 0; i < queue->threadCnt; i++)
+        pthread_join(queue->threads[i], NULL);
+
+    /* posted jobs never submitted are on the completion queue as well */
+    while (wolfEventQueue_Pop(&queue->done, &event) == 0 && event != NULL)
+        wc_CryptoCb_QueueEventFree(queue, event);
+
+    pthread_cond_destroy(&queue->complete);
+    pthread_cond_destroy(&queue->work);
+    wc_FreeMutex(&queue->lock);
+    wolfEventQueue_Free(&queue->done);
+    XFREE(queue->threads, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(queue, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    (void)heap;
+}
+#endif /* WOLF_CRYPTO_CB_QUEUE */
+
 #endif /* WOLF_CRYPTO_CB */
@@ -33,6 +33,9 @@
 
 #include <wolfssl/wolfcrypt/curve25519.h>
 #include <wolfssl/wolfcrypt/error-crypt.h>
+#ifdef WOLF_CRYPTO_CB
+    #include <wolfssl/wolfcrypt/cryptocb.h>
+#endif
 #ifdef NO_INLINE
     #include <wolfssl/wolfcrypt/misc.h>
 #else
@@ -67,6 +70,15 @@ int wc_curve25519_make_key(WC_RNG* rng, int keysize, curve25519_key* key)
     if (keysize != CURVE25519_KEYSIZE)
         return ECC_BAD_ARG_E;
 
+#ifdef WOLF_CRYPTO_CB
+    if (key->devId != INVALID_DEVID) {
+        ret = wc_CryptoCb_Curve25519Gen(rng, keysize, key);
+        if (ret != CRYPTOCB_UNAVAILABLE)
+            return ret;
+        /* fall-through when unavailable */
+    }
+#endif
+
 #ifndef FREESCALE_LTC_ECC
     fe_init();
 #endif
@@ -126,6 +138,16 @@ int wc_curve25519_shared_secret_ex(curve25519_key* private_key,
     if (public_key->p.point[CURVE25519_KEYSIZE-1] > 0x7F)
         return ECC_BAD_ARG_E;
 
+#ifdef WOLF_CRYPTO_CB
+    if (private_key->devId != INVALID_DEVID) {
+        ret = wc_CryptoCb_Curve25519(private_key, public_key, out, outlen,
+                                     endian);
+        if (ret != CRYPTOCB_UNAVAILABLE)
+            return ret;
+        /* fall-through when unavailable */
+    }
+#endif
+
     #ifdef FREESCALE_LTC_ECC
         ret = wc_curve25519(&o, private_key->k.point, &public_key->p, kLTC_Curve25519 /* input point P on Curve25519 */);
     #else
@@ -466,7 +488,7 @@ int wc_curve25519_import_private_ex(const byte* priv, word32 privSz,
 #endif /* HAVE_CURVE25519_KEY_IMPORT */
 
 
-int wc_curve25519_init(curve25519_key* key)
+int wc_curve25519_init_ex(curve25519_key* key, void* heap, int devId)
 {
     if (key == NULL)
        return BAD_FUNC_ARG;
@@ -476,6 +498,13 @@ int wc_curve25519_init(curve25519_key* key)
     /* currently the format for curve25519 */
     key->dp = &curve25519_sets[0];
 
+#ifdef WOLF_CRYPTO_CB
+    key->devId = devId;
+#else
+    (void)devId;
+#endif
+    (void)heap;
+
 #ifndef FREESCALE_LTC_ECC
     fe_init();
 #endif
@@ -483,6 +512,11 @@ int wc_curve25519_init(curve25519_key* key)
     return 0;
 }
 
+int wc_curve25519_init(curve25519_key* key)
+{
+    return wc_curve25519_init_ex(key, NULL, INVALID_DEVID);
+}
+
 
 /* Clean the memory of a key */
 void wc_curve25519_free(curve25519_key* key)
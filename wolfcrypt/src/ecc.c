@@ -51,6 +51,10 @@ Possible ECC enable options:
  * ECC_CACHE_CURVE:     Enables cache of curve info to improve perofrmance
                                                                 default: off
  * FP_ECC:              ECC Fixed Point Cache                   default: off
+ * FP_ENTRIES:          FP_ECC key cache entries per thread     default: 15
+ * FP_GEN_ENTRIES:      FP_ECC curve generator LUTs shared by all threads
+                                                                default: 4
+ * NO_FP_ECC_SHARED_GEN: Keep generator LUTs in the key cache   default: off
  * USE_ECC_B_PARAM:     Enable ECC curve B param                default: off
                          (on for HAVE_COMP_KEY)
  * WOLFSSL_ECC_CURVE_STATIC:                                    default off (on for windows)
@@ -5288,6 +5292,380 @@ int wc_ecc_sign_set_k(const byte* k, word32 klen, ecc_key* key)
 #endif /* WOLFSSL_ECDSA_SET_K */
 #endif /* WOLFSSL_ATECC508A && WOLFSSL_CRYPTOCELL*/
 
+#ifdef WOLFSSL_SIGN_BATCH
+#if !defined(WOLFSSL_SP_MATH) && !defined(ALT_ECC_SIZE) && \
+    !defined(WOLFSSL_ATECC508A) && !defined(WOLFSSL_ATECC608A) && \
+    !defined(WOLFSSL_CRYPTOCELL) && !defined(PLUTON_CRYPTO_ECC) && \
+    !defined(WOLFSSL_STM32_PKA) && !defined(FREESCALE_LTC_ECC) && \
+    !defined(WC_NO_RNG)
+    #define ECC_SIGN_BATCH_SHARED
+#endif
+
+#ifdef ECC_SIGN_BATCH_SHARED
+/* Load a digest into e, truncated to the bit length of the order. */
+static int ecc_sign_batch_load_e(const byte* in, word32 inlen, mp_int* order,
+                                 mp_int* e)
+{
+    int    err;
+    word32 orderBits = mp_count_bits(order);
+
+    /* truncate down to byte size, may be all that's needed */
+    if ((WOLFSSL_BIT_SIZE * inlen) > orderBits)
+        inlen = (orderBits + WOLFSSL_BIT_SIZE - 1) / WOLFSSL_BIT_SIZE;
+    err = mp_read_unsigned_bin(e, (byte*)in, inlen);
+
+    /* may still need bit truncation too */
+    if (err == MP_OKAY && (WOLFSSL_BIT_SIZE * inlen) > orderBits)
+        mp_rshb(e, WOLFSSL_BIT_SIZE - (orderBits & 0x7));
+
+    return err;
+}
+
+/* Sign count digests with one key, producing r and s for each.
+ * The random k values for the whole batch come from one RNG call. The
+ * k.G points are left projective and mapped to affine with a single
+ * inversion modulo the prime, and the blinded k values share a single
+ * inversion modulo the order (Montgomery's simultaneous inversion).
+ * An entry whose r or s comes out zero has res set to MP_ZERO_E for the
+ * caller to sign again on its own.
+ */
+static int ecc_sign_hash_batch_ex(const byte* const* in, const word32* inlen,
+    int count, WC_RNG* rng, ecc_key* key, mp_int* r, mp_int* s, int* res)
+{
+    int         err = MP_OKAY;
+    int         i, initCnt = 0, loop_check = 0;
+    int         kSz = key->dp->size + 8;
+    mp_digit    mp = 0;
+    mp_int*     t = NULL;
+    mp_int     *e = NULL, *k = NULL, *c = NULL;
+    mp_int     *b = NULL, *inv = NULL, *tmp = NULL;
+    ecc_point*  base = NULL;
+    ecc_point** R = NULL;
+    byte*       kBuf = NULL;
+    DECLARE_CURVE_SPECS(curve, ECC_CURVE_FIELD_COUNT);
+
+    /* e[count], k[count], c[count], b, inv, tmp */
+    t = (mp_int*)XMALLOC(sizeof(mp_int) * (3 * count + 3), key->heap,
+                                                              DYNAMIC_TYPE_ECC);
+    R = (ecc_point**)XMALLOC(sizeof(ecc_point*) * count, key->heap,
+                                                              DYNAMIC_TYPE_ECC);
+    kBuf = (byte*)XMALLOC(kSz * count, key->heap, DYNAMIC_TYPE_ECC);
+    if (t == NULL || R == NULL || kBuf == NULL)
+        err = MEMORY_E;
+
+    if (err == MP_OKAY) {
+        XMEMSET(R, 0, sizeof(ecc_point*) * count);
+        e = t;
+        k = t + count;
+        c = t + 2 * count;
+        b = t + 3 * count;
+        inv = b + 1;
+        tmp = b + 2;
+        for (; initCnt < 3 * count + 3; initCnt++) {
+            if ((err = mp_init(&t[initCnt])) != MP_OKAY)
+                break;
+        }
+    }
+
+    if (err == MP_OKAY) {
+        ALLOC_CURVE_SPECS(ECC_CURVE_FIELD_COUNT);
+        err = wc_ecc_curve_load(key->dp, &curve, ECC_CURVE_FIELD_ALL);
+    }
+    if (err == MP_OKAY)
+        err = mp_montgomery_setup(curve->prime, &mp);
+
+    if (err == MP_OKAY) {
+        base = wc_ecc_new_point_h(key->heap);
+        if (base == NULL)
+            err = MEMORY_E;
+    }
+    if (err == MP_OKAY)
+        err = mp_copy(curve->Gx, base->x);
+    if (err == MP_OKAY)
+        err = mp_copy(curve->Gy, base->y);
+    if (err == MP_OKAY)
+        err = mp_set(base->z, 1);
+
+    /* blinding value for the inversion of the k values - non-zero value */
+    if (err == MP_OKAY) {
+        do {
+            if (++loop_check > 64) {
+                err = RNG_FAILURE_E;
+                break;
+            }
+            err = wc_ecc_gen_k(rng, key->dp->size, b, curve->order);
+        }
+        while (err == MP_ZERO_E);
+    }
+
+    /* random data for all of the k values */
+    if (err == MP_OKAY)
+        err = wc_RNG_GenerateBlock(rng, kBuf, kSz * count);
+
+    /* c[i] = Z[0] * ... * Z[i] in Montgomery form */
+    for (i = 0; err == MP_OKAY && i < count; i++) {
+        err = ecc_sign_batch_load_e(in[i], inlen[i], curve->order, &e[i]);
+        if (err == MP_OKAY)
+            err = mp_read_unsigned_bin(&k[i], kBuf + kSz * i, kSz);
+        if (err == MP_OKAY)
+            err = mp_mod(&k[i], curve->order, &k[i]);
+        if (err == MP_OKAY && mp_iszero(&k[i]) == MP_YES) {
+            loop_check = 0;
+            do {
+                if (++loop_check > 64) {
+                    err = RNG_FAILURE_E;
+                    break;
+                }
+                err = wc_ecc_gen_k(rng, key->dp->size, &k[i], curve->order);
+            }
+            while (err == MP_ZERO_E);
+        }
+        if (err == MP_OKAY) {
+            R[i] = wc_ecc_new_point_h(key->heap);
+            if (R[i] == NULL)
+                err = MEMORY_E;
+        }
+        if (err == MP_OKAY) {
+            err = wc_ecc_mulmod_ex(&k[i], base, R[i], curve->Af, curve->prime,
+                                                               0, key->heap);
+            if (err == MP_MEM)
+                err = MEMORY_E;
+        }
+        if (err == MP_OKAY && mp_iszero(R[i]->z) == MP_YES)
+            err = ECC_INF_E;
+        if (err == MP_OKAY) {
+            if (i == 0) {
+                err = mp_copy(R[i]->z, &c[i]);
+            }
+            else {
+                err = mp_mul(&c[i - 1], R[i]->z, &c[i]);
+                if (err == MP_OKAY)
+                    err = mp_montgomery_reduce(&c[i], curve->prime, mp);
+            }
+        }
+    }
+
+    /* inv = 1 / (Z[0] * ... * Z[count-1]) in Montgomery form */
+    if (err == MP_OKAY) {
+#if defined(ECC_TIMING_RESISTANT) && defined(USE_FAST_MATH)
+        err = mp_invmod_mont_ct(&c[count - 1], curve->prime, inv, mp);
+#else
+        err = mp_copy(&c[count - 1], inv);
+        if (err == MP_OKAY)
+            err = mp_montgomery_reduce(inv, curve->prime, mp);
+        if (err == MP_OKAY)
+            err = mp_invmod(inv, curve->prime, inv);
+        if (err == MP_OKAY)
+            err = mp_montgomery_calc_normalization(tmp, curve->prime);
+        if (err == MP_OKAY)
+            err = mp_mulmod(inv, tmp, curve->prime, inv);
+#endif
+    }
+
+    /* r[i] = (X[i] / Z[i]^2) mod order */
+    for (i = count - 1; err == MP_OKAY && i >= 0; i--) {
+        if (i > 0) {
+            /* tmp = 1/Z[i] and inv = 1 / (Z[0] * ... * Z[i-1]) */
+            err = mp_mul(inv, &c[i - 1], tmp);
+            if (err == MP_OKAY)
+                err = mp_montgomery_reduce(tmp, curve->prime, mp);
+            if (err == MP_OKAY)
+                err = mp_mul(inv, R[i]->z, inv);
+            if (err == MP_OKAY)
+                err = mp_montgomery_reduce(inv, curve->prime, mp);
+        }
+        else {
+            err = mp_copy(inv, tmp);
+        }
+
+        /* leave Montgomery form, then tmp = 1/Z^2 */
+        if (err == MP_OKAY)
+            err = mp_montgomery_reduce(tmp, curve->prime, mp);
+        if (err == MP_OKAY)
+            err = mp_sqrmod(tmp, curve->prime, tmp);
+        if (err == MP_OKAY)
+            err = mp_mul(R[i]->x, tmp, R[i]->x);
+        if (err == MP_OKAY)
+            err = mp_montgomery_reduce(R[i]->x, curve->prime, mp);
+        if (err == MP_OKAY)
+            err = mp_mod(R[i]->x, curve->order, &r[i]);
+    }
+
+    /* k[i] = k[i].b and c[i] = k[0].b * ... * k[i].b */
+    for (i = 0; err == MP_OKAY && i < count; i++) {
+        err = mp_mulmod(&k[i], b, curve->order, &k[i]);
+        if (err == MP_OKAY) {
+            if (i == 0)
+                err = mp_copy(&k[i], &c[i]);
+            else
+                err = mp_mulmod(&c[i - 1], &k[i], curve->order, &c[i]);
+        }
+    }
+
+    /* inv = 1 / (k[0].b * ... * k[count-1].b) */
+    if (err == MP_OKAY)
+        err = mp_invmod(&c[count - 1], curve->order, inv);
+
+    for (i = count - 1; err == MP_OKAY && i >= 0; i--) {
+        /* tmp = 1/k[i].b */
+        if (i > 0) {
+            err = mp_mulmod(inv, &c[i - 1], curve->order, tmp);
+            if (err == MP_OKAY)
+                err = mp_mulmod(inv, &k[i], curve->order, inv);
+        }
+        else {
+            err = mp_copy(inv, tmp);
+        }
+
+        /* s = b.(e/k.b + x.r/k.b) = (e + x.r)/k */
+        if (err == MP_OKAY)
+            err = mp_mulmod(&key->k, &r[i], curve->order, &s[i]);
+        if (err == MP_OKAY)
+            err = mp_mulmod(tmp, &s[i], curve->order, &s[i]);
+        if (err == MP_OKAY)
+            err = mp_mulmod(tmp, &e[i], curve->order, &e[i]);
+        if (err == MP_OKAY)
+            err = mp_add(&e[i], &s[i], &s[i]);
+        if (err == MP_OKAY)
+            err = mp_mulmod(&s[i], b, curve->order, &s[i]);
+        if (err == MP_OKAY)
+            err = mp_mod(&s[i], curve->order, &s[i]);
+
+        if (err == MP_OKAY) {
+            if (mp_iszero(&r[i]) == MP_YES || mp_iszero(&s[i]) == MP_YES)
+                res[i] = MP_ZERO_E;
+            else
+                res[i] = 0;
+        }
+    }
+
+    /* clean up */
+    if (R != NULL) {
+        for (i = 0; i < count; i++)
+            wc_ecc_del_point_h(R[i], key->heap);
+        XFREE(R, key->heap, DYNAMIC_TYPE_ECC);
+    }
+    wc_ecc_del_point_h(base, key->heap);
+    if (kBuf != NULL) {
+        ForceZero(kBuf, kSz * count);
+        XFREE(kBuf, key->heap, DYNAMIC_TYPE_ECC);
+    }
+    if (t != NULL) {
+        for (i = 0; i < initCnt; i++)
+            mp_forcezero(&t[i]);
+        XFREE(t, key->heap, DYNAMIC_TYPE_ECC);
+    }
+    wc_ecc_curve_free(curve);
+    FREE_CURVE_SPECS();
+
+    return err;
+}
+#endif /* ECC_SIGN_BATCH_SHARED */
+
+#ifndef NO_ASN
+/**
+  Sign a batch of message digests with the same key
+  in        Array of count message digests to sign
+  inlen     Array of count digest lengths
+  out       Array of count buffers for the DER encoded signatures
+  outlen    Array of count lengths, in: size of out[i], out: length written
+  res       [out] Array of count results, 0 for each signature made
+  count     Number of digests
+  rng       RNG for the k values
+  key       A private ECC key
+  return    0 when the batch was processed, with the result of each signature
+            in res, or a negative error when nothing was signed
+*/
+int wc_ecc_sign_hash_batch(const byte* const* in, const word32* inlen,
+                           byte* const* out, word32* outlen, int* res,
+                           int count, WC_RNG* rng, ecc_key* key)
+{
+    int     err = 0;
+    int     i;
+    int     shared = 0;
+#ifdef ECC_SIGN_BATCH_SHARED
+    mp_int* rs = NULL;
+#endif
+
+    if (in == NULL || inlen == NULL || out == NULL || outlen == NULL ||
+            res == NULL || rng == NULL || key == NULL || count <= 0) {
+        return ECC_BAD_ARG_E;
+    }
+    for (i = 0; i < count; i++) {
+        if (in[i] == NULL || out[i] == NULL)
+            return ECC_BAD_ARG_E;
+        res[i] = WC_PENDING_E;
+    }
+
+#ifdef ECC_SIGN_BATCH_SHARED
+    /* share the inversions when signing is done here in software */
+    if ((key->type == ECC_PRIVATEKEY || key->type == ECC_PRIVATEKEY_ONLY) &&
+            wc_ecc_is_valid_idx(key->idx) == 1 && count > 1) {
+        shared = 1;
+    #ifdef WOLF_CRYPTO_CB
+        if (key->devId != INVALID_DEVID)
+            shared = 0;
+    #endif
+    #if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_ECC)
+        if (key->asyncDev.marker == WOLFSSL_ASYNC_MARKER_ECC)
+            shared = 0;
+    #endif
+    #ifdef WOLFSSL_ECDSA_SET_K
+        if (key->sign_k != NULL)
+            shared = 0;
+    #endif
+    #ifdef WOLFSSL_HAVE_SP_ECC
+        #ifndef WOLFSSL_SP_NO_256
+        if (key->idx != ECC_CUSTOM_IDX &&
+                                       ecc_sets[key->idx].id == ECC_SECP256R1)
+            shared = 0;
+        #endif
+        #ifdef WOLFSSL_SP_384
+        if (key->idx != ECC_CUSTOM_IDX &&
+                                       ecc_sets[key->idx].id == ECC_SECP384R1)
+            shared = 0;
+        #endif
+    #endif
+    }
+
+    if (shared) {
+        rs = (mp_int*)XMALLOC(sizeof(mp_int) * 2 * count, key->heap,
+                                                              DYNAMIC_TYPE_ECC);
+        if (rs == NULL)
+            return MEMORY_E;
+        for (i = 0; i < 2 * count; i++)
+            mp_init(&rs[i]);
+
+        err = ecc_sign_hash_batch_ex(in, inlen, count, rng, key, rs,
+                                                              rs + count, res);
+        /* encoded with DSA header */
+        for (i = 0; err == 0 && i < count; i++) {
+            if (res[i] == 0)
+                res[i] = StoreECC_DSA_Sig(out[i], &outlen[i], &rs[i],
+                                                             &rs[count + i]);
+        }
+
+        for (i = 0; i < 2 * count; i++)
+            mp_clear(&rs[i]);
+        XFREE(rs, key->heap, DYNAMIC_TYPE_ECC);
+
+        if (err != 0)
+            return err;
+    }
+#endif /* ECC_SIGN_BATCH_SHARED */
+
+    /* sign the rest one at a time */
+    for (i = 0; i < count; i++) {
+        if (!shared || res[i] == MP_ZERO_E)
+            res[i] = wc_ecc_sign_hash(in[i], inlen[i], out[i], &outlen[i],
+                                                                     rng, key);
+    }
+
+    return err;
+}
+#endif /* !NO_ASN */
+#endif /* WOLFSSL_SIGN_BATCH */
+
 #endif /* HAVE_ECC_SIGN */
 
 #ifdef WOLFSSL_CUSTOM_CURVES
@@ -5371,19 +5749,14 @@ int wc_ecc_free(ecc_key* key)
   C        [out] Destination point (can overlap with A or B)
   a        ECC curve parameter a
   modulus  Modulus for curve
+  map      Boolean indicating whether to map C back to affine, otherwise it
+           is left projective in Montgomery form
   return MP_OKAY on success
 */
-#ifdef FP_ECC
-static int normal_ecc_mul2add(ecc_point* A, mp_int* kA,
-                             ecc_point* B, mp_int* kB,
-                             ecc_point* C, mp_int* a, mp_int* modulus,
-                             void* heap)
-#else
-int ecc_mul2add(ecc_point* A, mp_int* kA,
-                    ecc_point* B, mp_int* kB,
-                    ecc_point* C, mp_int* a, mp_int* modulus,
-                    void* heap)
-#endif
+static int ecc_mul2add_ex(ecc_point* A, mp_int* kA,
+                          ecc_point* B, mp_int* kB,
+                          ecc_point* C, mp_int* a, mp_int* modulus,
+                          void* heap, int map)
 {
 #ifdef WOLFSSL_SMALL_STACK_CACHE
   ecc_key        key;
@@ -5657,7 +6030,7 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
   }
 
   /* reduce to affine */
-  if (err == MP_OKAY)
+  if (err == MP_OKAY && map)
     err = ecc_map(C, modulus, mp);
 
   /* clean up */
@@ -5686,6 +6059,24 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
   return err;
 }
 
+/** Computes kA*A + kB*B = C using Shamir's Trick, C is affine
+  return MP_OKAY on success
+*/
+#ifdef FP_ECC
+static int normal_ecc_mul2add(ecc_point* A, mp_int* kA,
+                             ecc_point* B, mp_int* kB,
+                             ecc_point* C, mp_int* a, mp_int* modulus,
+                             void* heap)
+#else
+int ecc_mul2add(ecc_point* A, mp_int* kA,
+                    ecc_point* B, mp_int* kB,
+                    ecc_point* C, mp_int* a, mp_int* modulus,
+                    void* heap)
+#endif
+{
+    return ecc_mul2add_ex(A, kA, B, kB, C, a, modulus, heap, 1);
+}
+
 #endif /* ECC_SHAMIR */
 #endif /* !WOLFSSL_SP_MATH && !WOLFSSL_ATECC508A && !WOLFSSL_CRYPTOCEL*/
 
@@ -6296,6 +6687,283 @@ int wc_ecc_verify_hash_ex(mp_int *r, mp_int *s, const byte* hash,
    return err;
 }
 #endif /* WOLFSSL_STM32_PKA */
+
+#if defined(WOLFSSL_VERIFY_BATCH) && !defined(NO_ASN)
+#if defined(ECC_SHAMIR) && !defined(FP_ECC) && !defined(WOLFSSL_SP_MATH) && \
+    !defined(ALT_ECC_SIZE) && !defined(WOLFSSL_ATECC508A) && \
+    !defined(WOLFSSL_ATECC608A) && !defined(WOLFSSL_CRYPTOCELL) && \
+    !defined(WOLFSSL_STM32_PKA) && !defined(WOLFSSL_PSOC6_CRYPTO) && \
+    !defined(FREESCALE_LTC_ECC) && !defined(WOLFSSL_DSP)
+    #define ECC_VERIFY_BATCH_SHARED
+#endif
+
+#ifdef ECC_VERIFY_BATCH_SHARED
+#ifndef WC_ECC_VERIFY_BATCH_SZ
+    #define WC_ECC_VERIFY_BATCH_SZ 32 /* signatures sharing an inversion */
+#endif
+
+/* Whether the key can be used in a verification batch done in software. */
+static int ecc_verify_batch_key(ecc_key* key)
+{
+    if (key->type == ECC_PRIVATEKEY_ONLY || key->dp == NULL ||
+            wc_ecc_is_valid_idx(key->idx) != 1) {
+        return 0;
+    }
+#ifdef WOLF_CRYPTO_CB
+    if (key->devId != INVALID_DEVID)
+        return 0;
+#endif
+#if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_ECC)
+    if (key->asyncDev.marker == WOLFSSL_ASYNC_MARKER_ECC)
+        return 0;
+#endif
+#ifdef WOLFSSL_HAVE_SP_ECC
+    #ifndef WOLFSSL_SP_NO_256
+    if (key->idx != ECC_CUSTOM_IDX && ecc_sets[key->idx].id == ECC_SECP256R1)
+        return 0;
+    #endif
+    #ifdef WOLFSSL_SP_384
+    if (key->idx != ECC_CUSTOM_IDX && ecc_sets[key->idx].id == ECC_SECP384R1)
+        return 0;
+    #endif
+#endif
+    return 1;
+}
+
+/* Verify the signatures listed in idx, all with keys on the same curve.
+ * The s values share one inversion modulo the order (Montgomery's
+ * simultaneous inversion) and u1.G + u2.Q is left projective: instead of
+ * mapping to affine, r is accepted when X == r.Z^2 or X == (r + n).Z^2
+ * modulo the prime. Malformed signatures are reported as invalid.
+ */
+static int ecc_verify_hash_batch_ex(const byte* const* sig,
+    const word32* siglen, const byte* const* hash, const word32* hashlen,
+    int* res, ecc_key* const* key, const int* idx, int cnt)
+{
+    int         err = MP_OKAY;
+    int         i, j, m = 0;
+    int         pos[WC_ECC_VERIFY_BATCH_SZ];
+    word32      orderBits = 0;
+    mp_digit    mp = 0;
+    void*       heap = key[idx[0]]->heap;
+    mp_int*     t;
+    mp_int      *r, *s, *e, *c, *inv, *w, *u1, *u2;
+    ecc_point   *mG = NULL, *mQ = NULL;
+    DECLARE_CURVE_SPECS(curve, ECC_CURVE_FIELD_COUNT);
+
+    /* r[cnt], s[cnt], e[cnt], c[cnt], inv, w, u1, u2 */
+    t = (mp_int*)XMALLOC(sizeof(mp_int) * (4 * cnt + 4), heap,
+                                                              DYNAMIC_TYPE_ECC);
+    if (t == NULL)
+        return MEMORY_E;
+    XMEMSET(t, 0, sizeof(mp_int) * (4 * cnt + 4));
+    r = t;
+    s = t + cnt;
+    e = t + 2 * cnt;
+    c = t + 3 * cnt;
+    inv = t + 4 * cnt;
+    w = inv + 1;
+    u1 = inv + 2;
+    u2 = inv + 3;
+    /* r and s are initialized when the signature is decoded */
+    for (i = 2 * cnt; i < 4 * cnt + 4; i++) {
+        if ((err = mp_init(&t[i])) != MP_OKAY)
+            break;
+    }
+
+    if (err == MP_OKAY) {
+        ALLOC_CURVE_SPECS(ECC_CURVE_FIELD_COUNT);
+        err = wc_ecc_curve_load(key[idx[0]]->dp, &curve, ECC_CURVE_FIELD_ALL);
+    }
+    if (err == MP_OKAY)
+        err = mp_montgomery_setup(curve->prime, &mp);
+    if (err == MP_OKAY) {
+        mG = wc_ecc_new_point_h(heap);
+        mQ = wc_ecc_new_point_h(heap);
+        if (mG == NULL || mQ == NULL)
+            err = MEMORY_E;
+    }
+    if (err == MP_OKAY)
+        orderBits = mp_count_bits(curve->order);
+
+    /* c[m] = s[pos[0]] * ... * s[pos[m]] mod order */
+    for (i = 0; err == MP_OKAY && i < cnt; i++) {
+        word32 hlen = hashlen[idx[i]];
+
+        if (DecodeECC_DSA_Sig(sig[idx[i]], siglen[idx[i]], &r[i], &s[i]) != 0
+                || mp_iszero(&r[i]) == MP_YES || mp_iszero(&s[i]) == MP_YES ||
+                mp_cmp(&r[i], curve->order) != MP_LT ||
+                mp_cmp(&s[i], curve->order) != MP_LT) {
+            res[idx[i]] = 0;
+            continue;
+        }
+
+        /* we may need to truncate if hash is longer than key size */
+        if ((WOLFSSL_BIT_SIZE * hlen) > orderBits)
+            hlen = (orderBits + WOLFSSL_BIT_SIZE - 1) / WOLFSSL_BIT_SIZE;
+        err = mp_read_unsigned_bin(&e[i], hash[idx[i]], hlen);
+        if (err == MP_OKAY && (WOLFSSL_BIT_SIZE * hlen) > orderBits)
+            mp_rshb(&e[i], WOLFSSL_BIT_SIZE - (orderBits & 0x7));
+
+        if (err == MP_OKAY) {
+            if (m == 0)
+                err = mp_copy(&s[i], &c[m]);
+            else
+                err = mp_mulmod(&c[m - 1], &s[i], curve->order, &c[m]);
+            pos[m++] = i;
+        }
+    }
+
+    /* inv = 1 / (s[pos[0]] * ... * s[pos[m-1]]) */
+    if (err == MP_OKAY && m > 0)
+        err = mp_invmod(&c[m - 1], curve->order, inv);
+
+    for (j = m - 1; err == MP_OKAY && j >= 0; j--) {
+        i = pos[j];
+
+        /* w = 1/s */
+        if (j > 0) {
+            err = mp_mulmod(inv, &c[j - 1], curve->order, w);
+            if (err == MP_OKAY)
+                err = mp_mulmod(inv, &s[i], curve->order, inv);
+        }
+        else {
+            err = mp_copy(inv, w);
+        }
+
+        /* u1 = ew, u2 = rw */
+        if (err == MP_OKAY)
+            err = mp_mulmod(&e[i], w, curve->order, u1);
+        if (err == MP_OKAY)
+            err = mp_mulmod(&r[i], w, curve->order, u2);
+
+        if (err == MP_OKAY)
+            err = mp_copy(curve->Gx, mG->x);
+        if (err == MP_OKAY)
+            err = mp_copy(curve->Gy, mG->y);
+        if (err == MP_OKAY)
+            err = mp_set(mG->z, 1);
+        if (err == MP_OKAY)
+            err = mp_copy(key[idx[i]]->pubkey.x, mQ->x);
+        if (err == MP_OKAY)
+            err = mp_copy(key[idx[i]]->pubkey.y, mQ->y);
+        if (err == MP_OKAY)
+            err = mp_copy(key[idx[i]]->pubkey.z, mQ->z);
+
+        /* X:Y:Z = u1*G + u2*Q in Montgomery form */
+        if (err == MP_OKAY) {
+            err = ecc_mul2add_ex(mG, u1, mQ, u2, mG, curve->Af, curve->prime,
+                                                                      heap, 0);
+        }
+        if (err != MP_OKAY)
+            break;
+        res[idx[i]] = 0;
+        if (mp_iszero(mG->z) == MP_YES)
+            continue;
+
+        /* u1 = Z^2, X out of Montgomery form */
+        err = mp_sqr(mG->z, u1);
+        if (err == MP_OKAY)
+            err = mp_montgomery_reduce(u1, curve->prime, mp);
+        if (err == MP_OKAY)
+            err = mp_montgomery_reduce(mG->x, curve->prime, mp);
+
+        /* accept if X == v.Z^2 for v = r or v = r + order less than prime */
+        if (err == MP_OKAY)
+            err = mp_copy(&r[i], u2);
+        while (err == MP_OKAY && mp_cmp(u2, curve->prime) == MP_LT) {
+            err = mp_mul(u1, u2, w);
+            if (err == MP_OKAY)
+                err = mp_montgomery_reduce(w, curve->prime, mp);
+            if (err == MP_OKAY && mp_cmp(w, mG->x) == MP_EQ) {
+                res[idx[i]] = 1;
+                break;
+            }
+            if (err == MP_OKAY)
+                err = mp_add(u2, curve->order, u2);
+        }
+    }
+
+    wc_ecc_del_point_h(mG, heap);
+    wc_ecc_del_point_h(mQ, heap);
+    for (i = 0; i < 4 * cnt + 4; i++)
+        mp_clear(&t[i]);
+    XFREE(t, heap, DYNAMIC_TYPE_ECC);
+    wc_ecc_curve_free(curve);
+    FREE_CURVE_SPECS();
+
+    return err;
+}
+#endif /* ECC_VERIFY_BATCH_SHARED */
+
+/**
+ Verify a batch of ECC signatures
+ sig         Array of count signatures to verify
+ siglen      Array of count signature lengths (octets)
+ hash        Array of count hashes (message digests) that were signed
+ hashlen     Array of count hash lengths (octets)
+ res         Array of count results, 1==valid, 0==invalid
+ key         Array of count public ECC keys, the same key may be repeated
+ count       Number of signatures
+ return      MP_OKAY if successful (even if signatures are not valid)
+ */
+int wc_ecc_verify_hash_batch(const byte* const* sig, const word32* siglen,
+                             const byte* const* hash, const word32* hashlen,
+                             int* res, ecc_key* const* key, int count)
+{
+    int err = MP_OKAY;
+    int i;
+#ifdef ECC_VERIFY_BATCH_SHARED
+    int n;
+    int cnt;
+    int idx[WC_ECC_VERIFY_BATCH_SZ];
+#endif
+
+    if (sig == NULL || siglen == NULL || hash == NULL || hashlen == NULL ||
+            res == NULL || key == NULL || count <= 0) {
+        return ECC_BAD_ARG_E;
+    }
+    for (i = 0; i < count; i++) {
+        if (sig[i] == NULL || hash[i] == NULL || key[i] == NULL)
+            return ECC_BAD_ARG_E;
+        res[i] = WC_PENDING_E;
+    }
+
+#ifdef ECC_VERIFY_BATCH_SHARED
+    for (n = 0; err == MP_OKAY && n < count; n++) {
+        if (res[n] != WC_PENDING_E || !ecc_verify_batch_key(key[n]))
+            continue;
+
+        /* gather the waiting signatures with keys on the same curve */
+        cnt = 0;
+        for (i = n; i < count && cnt < WC_ECC_VERIFY_BATCH_SZ; i++) {
+            if (res[i] == WC_PENDING_E && key[i]->dp == key[n]->dp &&
+                                               ecc_verify_batch_key(key[i])) {
+                idx[cnt++] = i;
+            }
+        }
+        if (cnt > 1)
+            err = ecc_verify_hash_batch_ex(sig, siglen, hash, hashlen, res,
+                                                               key, idx, cnt);
+    }
+#endif
+
+    /* verify the rest one at a time */
+    for (i = 0; err == MP_OKAY && i < count; i++) {
+        if (res[i] != WC_PENDING_E)
+            continue;
+        err = wc_ecc_verify_hash(sig[i], siglen[i], hash[i], hashlen[i],
+                                                               &res[i], key[i]);
+        /* a malformed signature only fails its own entry */
+        if (err != MP_OKAY && err != MEMORY_E) {
+            res[i] = 0;
+            err = MP_OKAY;
+        }
+    }
+
+    return err;
+}
+#endif /* WOLFSSL_VERIFY_BATCH && !NO_ASN */
 #endif /* HAVE_ECC_VERIFY */
 
 #ifdef HAVE_ECC_KEY_IMPORT
@@ -8103,6 +8771,16 @@ int wc_ecc_sig_size(ecc_key* key)
     #define FP_ENTRIES 15
 #endif
 
+/* upper bound for wc_ecc_fp_set_entries */
+#ifndef FP_MAX_ENTRIES
+    #define FP_MAX_ENTRIES 1024
+#endif
+
+/* number of curve generators with a LUT shared by all threads */
+#ifndef FP_GEN_ENTRIES
+    #define FP_GEN_ENTRIES 4
+#endif
+
 /* number of bits in LUT */
 #ifndef FP_LUT
     #define FP_LUT     8U
@@ -8133,14 +8811,44 @@ typedef struct {
                                /* permitted (0) or not (1) */
 } fp_cache_t;
 
+/* number of entries a key cache is sized to on its next use */
+static volatile int fp_entries = FP_ENTRIES;
+
 /* if HAVE_THREAD_LS this cache is per thread, no locking needed */
-static THREAD_LS_T fp_cache_t fp_cache[FP_ENTRIES];
+static THREAD_LS_T fp_cache_t* fp_cache = NULL;
+static THREAD_LS_T int         fp_cache_sz = 0;
 
 #ifndef HAVE_THREAD_LS
     static volatile int initMutex = 0;  /* prevent multiple mutex inits */
     static wolfSSL_Mutex ecc_fp_lock;
 #endif /* HAVE_THREAD_LS */
 
+#ifndef NO_FP_ECC_SHARED_GEN
+/* LUT of a curve generator, read only once built */
+typedef struct {
+   fp_cache_t fp;              /* generator and its LUT */
+   mp_int     prime;           /* modulus of the curve */
+   mp_int     a;               /* a param of the curve */
+} fp_gen_t;
+
+static fp_gen_t      fp_gen[FP_GEN_ENTRIES];
+static int           fp_gen_count = 0;  /* built entries, grows until cleanup */
+static volatile int  initGenMutex = 0;  /* prevent multiple mutex inits */
+static wolfSSL_Mutex ecc_fp_gen_lock;
+
+/* an entry is built before fp_gen_count is raised past it with a release
+   store, so lookups that load the count with acquire need no lock */
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+    #define FP_GEN_COUNT_GET()  __atomic_load_n(&fp_gen_count, __ATOMIC_ACQUIRE)
+    #define FP_GEN_COUNT_SET(n) __atomic_store_n(&fp_gen_count, (n), \
+                                                 __ATOMIC_RELEASE)
+#else
+    /* no atomics, lookups hold ecc_fp_gen_lock */
+    #define FP_GEN_LOCKED_LOOKUP
+    #define FP_GEN_COUNT_SET(n) (fp_gen_count = (n))
+#endif
+#endif /* NO_FP_ECC_SHARED_GEN */
+
 /* simple table to help direct the generation of the LUT */
 static const struct {
    int ham, terma, termb;
@@ -8672,12 +9380,63 @@ static const struct {
 };
 
 
+/* free the base point and LUT of an entry */
+static void fp_free_entry(fp_cache_t* fp)
+{
+   unsigned x;
+
+   for (x = 0; x < (1U<<FP_LUT); x++) {
+      wc_ecc_del_point(fp->LUT[x]);
+      fp->LUT[x] = NULL;
+   }
+   wc_ecc_del_point(fp->g);
+   fp->g         = NULL;
+   mp_clear(&fp->mu);
+   fp->LUT_set   = 0;
+   fp->lru_count = 0;
+   fp->lock      = 0;
+}
+
+/* free every entry of the key cache */
+static void fp_free_cache(void)
+{
+   int x;
+
+   for (x = 0; x < fp_cache_sz; x++) {
+      fp_free_entry(&fp_cache[x]);
+   }
+   XFREE(fp_cache, NULL, DYNAMIC_TYPE_ECC);
+   fp_cache    = NULL;
+   fp_cache_sz = 0;
+}
+
+/* size the key cache to fp_entries, a resize drops the cached entries */
+static int fp_cache_setup(void)
+{
+   int entries = fp_entries;
+
+   if (fp_cache != NULL && fp_cache_sz == entries) {
+      return MP_OKAY;
+   }
+
+   fp_free_cache();
+
+   fp_cache = (fp_cache_t*)XMALLOC(sizeof(fp_cache_t) * entries, NULL,
+                                   DYNAMIC_TYPE_ECC);
+   if (fp_cache == NULL) {
+      return MEMORY_E;
+   }
+   XMEMSET(fp_cache, 0, sizeof(fp_cache_t) * entries);
+   fp_cache_sz = entries;
+
+   return MP_OKAY;
+}
+
 /* find a hole and free as required, return -1 if no hole found */
 static int find_hole(void)
 {
-   unsigned x;
-   int      y, z;
-   for (z = -1, y = INT_MAX, x = 0; x < FP_ENTRIES; x++) {
+   int      x, y, z;
+   for (z = -1, y = INT_MAX, x = 0; x < fp_cache_sz; x++) {
        if (fp_cache[x].lru_count < y && fp_cache[x].lock == 0) {
           z = x;
           y = fp_cache[x].lru_count;
@@ -8685,7 +9444,7 @@ static int find_hole(void)
    }
 
    /* decrease all */
-   for (x = 0; x < FP_ENTRIES; x++) {
+   for (x = 0; x < fp_cache_sz; x++) {
       if (fp_cache[x].lru_count > 3) {
          --(fp_cache[x].lru_count);
       }
@@ -8693,15 +9452,7 @@ static int find_hole(void)
 
    /* free entry z */
    if (z >= 0 && fp_cache[z].g) {
-      mp_clear(&fp_cache[z].mu);
-      wc_ecc_del_point(fp_cache[z].g);
-      fp_cache[z].g  = NULL;
-      for (x = 0; x < (1U<<FP_LUT); x++) {
-         wc_ecc_del_point(fp_cache[z].LUT[x]);
-         fp_cache[z].LUT[x] = NULL;
-      }
-      fp_cache[z].LUT_set = 0;
-      fp_cache[z].lru_count = 0;
+      fp_free_entry(&fp_cache[z]);
    }
    return z;
 }
@@ -8710,7 +9461,7 @@ static int find_hole(void)
 static int find_base(ecc_point* g)
 {
    int x;
-   for (x = 0; x < FP_ENTRIES; x++) {
+   for (x = 0; x < fp_cache_sz; x++) {
       if (fp_cache[x].g != NULL &&
           mp_cmp(fp_cache[x].g->x, g->x) == MP_EQ &&
           mp_cmp(fp_cache[x].g->y, g->y) == MP_EQ &&
@@ -8718,48 +9469,41 @@ static int find_base(ecc_point* g)
          break;
       }
    }
-   if (x == FP_ENTRIES) {
+   if (x == fp_cache_sz) {
       x = -1;
    }
    return x;
 }
 
 /* add a new base to the cache */
-static int add_entry(int idx, ecc_point *g)
+static int add_entry(fp_cache_t* fp, ecc_point *g)
 {
-   unsigned x, y;
+   unsigned x;
 
    /* allocate base and LUT */
-   fp_cache[idx].g = wc_ecc_new_point();
-   if (fp_cache[idx].g == NULL) {
+   fp->g = wc_ecc_new_point();
+   if (fp->g == NULL) {
       return GEN_MEM_ERR;
    }
 
    /* copy x and y */
-   if ((mp_copy(g->x, fp_cache[idx].g->x) != MP_OKAY) ||
-       (mp_copy(g->y, fp_cache[idx].g->y) != MP_OKAY) ||
-       (mp_copy(g->z, fp_cache[idx].g->z) != MP_OKAY)) {
-      wc_ecc_del_point(fp_cache[idx].g);
-      fp_cache[idx].g = NULL;
+   if ((mp_copy(g->x, fp->g->x) != MP_OKAY) ||
+       (mp_copy(g->y, fp->g->y) != MP_OKAY) ||
+       (mp_copy(g->z, fp->g->z) != MP_OKAY)) {
+      fp_free_entry(fp);
       return GEN_MEM_ERR;
    }
 
    for (x = 0; x < (1U<<FP_LUT); x++) {
-      fp_cache[idx].LUT[x] = wc_ecc_new_point();
-      if (fp_cache[idx].LUT[x] == NULL) {
-         for (y = 0; y < x; y++) {
-            wc_ecc_del_point(fp_cache[idx].LUT[y]);
-            fp_cache[idx].LUT[y] = NULL;
-         }
-         wc_ecc_del_point(fp_cache[idx].g);
-         fp_cache[idx].g         = NULL;
-         fp_cache[idx].lru_count = 0;
+      fp->LUT[x] = wc_ecc_new_point();
+      if (fp->LUT[x] == NULL) {
+         fp_free_entry(fp);
          return GEN_MEM_ERR;
       }
    }
 
-   fp_cache[idx].LUT_set   = 0;
-   fp_cache[idx].lru_count = 0;
+   fp->LUT_set   = 0;
+   fp->lru_count = 0;
 
    return MP_OKAY;
 }
@@ -8771,7 +9515,7 @@ static int add_entry(int idx, ecc_point *g)
  * The algorithm builds patterns in increasing bit order by first making all
  * single bit input patterns, then all two bit input patterns and so on
  */
-static int build_lut(int idx, mp_int* a, mp_int* modulus, mp_digit mp,
+static int build_lut(fp_cache_t* fp, mp_int* a, mp_int* modulus, mp_digit mp,
     mp_int* mu)
 {
    int err;
@@ -8796,17 +9540,17 @@ static int build_lut(int idx, mp_int* a, mp_int* modulus, mp_digit mp,
     lut_gap = bitlen / FP_LUT;
 
     /* init the mu */
-    err = mp_init_copy(&fp_cache[idx].mu, mu);
+    err = mp_init_copy(&fp->mu, mu);
    }
 
    /* copy base */
    if (err == MP_OKAY) {
-     if ((mp_mulmod(fp_cache[idx].g->x, mu, modulus,
-                  fp_cache[idx].LUT[1]->x) != MP_OKAY) ||
-         (mp_mulmod(fp_cache[idx].g->y, mu, modulus,
-                  fp_cache[idx].LUT[1]->y) != MP_OKAY) ||
-         (mp_mulmod(fp_cache[idx].g->z, mu, modulus,
-                  fp_cache[idx].LUT[1]->z) != MP_OKAY)) {
+     if ((mp_mulmod(fp->g->x, mu, modulus,
+                  fp->LUT[1]->x) != MP_OKAY) ||
+         (mp_mulmod(fp->g->y, mu, modulus,
+                  fp->LUT[1]->y) != MP_OKAY) ||
+         (mp_mulmod(fp->g->z, mu, modulus,
+                  fp->LUT[1]->z) != MP_OKAY)) {
        err = MP_MULMOD_E;
      }
    }
@@ -8815,20 +9559,20 @@ static int build_lut(int idx, mp_int* a, mp_int* modulus, mp_digit mp,
    for (x = 1; x < FP_LUT; x++) {
       if (err != MP_OKAY)
           break;
-      if ((mp_copy(fp_cache[idx].LUT[1<<(x-1)]->x,
-                   fp_cache[idx].LUT[1<<x]->x) != MP_OKAY) ||
-          (mp_copy(fp_cache[idx].LUT[1<<(x-1)]->y,
-                   fp_cache[idx].LUT[1<<x]->y) != MP_OKAY) ||
-          (mp_copy(fp_cache[idx].LUT[1<<(x-1)]->z,
-                   fp_cache[idx].LUT[1<<x]->z) != MP_OKAY)){
+      if ((mp_copy(fp->LUT[1<<(x-1)]->x,
+                   fp->LUT[1<<x]->x) != MP_OKAY) ||
+          (mp_copy(fp->LUT[1<<(x-1)]->y,
+                   fp->LUT[1<<x]->y) != MP_OKAY) ||
+          (mp_copy(fp->LUT[1<<(x-1)]->z,
+                   fp->LUT[1<<x]->z) != MP_OKAY)){
           err = MP_INIT_E;
           break;
       } else {
 
          /* now double it bitlen/FP_LUT times */
          for (y = 0; y < lut_gap; y++) {
-             if ((err = ecc_projective_dbl_point(fp_cache[idx].LUT[1<<x],
-                            fp_cache[idx].LUT[1<<x], a, modulus, mp)) != MP_OKAY) {
+             if ((err = ecc_projective_dbl_point(fp->LUT[1<<x],
+                            fp->LUT[1<<x], a, modulus, mp)) != MP_OKAY) {
                  break;
              }
          }
@@ -8844,9 +9588,9 @@ static int build_lut(int idx, mp_int* a, mp_int* modulus, mp_digit mp,
 
            /* perform the add */
            if ((err = ecc_projective_add_point(
-                           fp_cache[idx].LUT[lut_orders[y].terma],
-                           fp_cache[idx].LUT[lut_orders[y].termb],
-                           fp_cache[idx].LUT[y], a, modulus, mp)) != MP_OKAY) {
+                           fp->LUT[lut_orders[y].terma],
+                           fp->LUT[lut_orders[y].termb],
+                           fp->LUT[y], a, modulus, mp)) != MP_OKAY) {
               break;
            }
        }
@@ -8858,59 +9602,192 @@ static int build_lut(int idx, mp_int* a, mp_int* modulus, mp_digit mp,
            break;
 
        /* convert z to normal from montgomery */
-       err = mp_montgomery_reduce(fp_cache[idx].LUT[x]->z, modulus, mp);
+       err = mp_montgomery_reduce(fp->LUT[x]->z, modulus, mp);
 
        /* invert it */
        if (err == MP_OKAY)
-         err = mp_invmod(fp_cache[idx].LUT[x]->z, modulus,
-                         fp_cache[idx].LUT[x]->z);
+         err = mp_invmod(fp->LUT[x]->z, modulus,
+                         fp->LUT[x]->z);
 
        if (err == MP_OKAY)
          /* now square it */
-         err = mp_sqrmod(fp_cache[idx].LUT[x]->z, modulus, &tmp);
+         err = mp_sqrmod(fp->LUT[x]->z, modulus, &tmp);
 
        if (err == MP_OKAY)
          /* fix x */
-         err = mp_mulmod(fp_cache[idx].LUT[x]->x, &tmp, modulus,
-                         fp_cache[idx].LUT[x]->x);
+         err = mp_mulmod(fp->LUT[x]->x, &tmp, modulus,
+                         fp->LUT[x]->x);
 
        if (err == MP_OKAY)
          /* get 1/z^3 */
-         err = mp_mulmod(&tmp, fp_cache[idx].LUT[x]->z, modulus, &tmp);
+         err = mp_mulmod(&tmp, fp->LUT[x]->z, modulus, &tmp);
 
        if (err == MP_OKAY)
          /* fix y */
-         err = mp_mulmod(fp_cache[idx].LUT[x]->y, &tmp, modulus,
-                         fp_cache[idx].LUT[x]->y);
+         err = mp_mulmod(fp->LUT[x]->y, &tmp, modulus,
+                         fp->LUT[x]->y);
 
        if (err == MP_OKAY)
          /* free z */
-         mp_clear(fp_cache[idx].LUT[x]->z);
+         mp_clear(fp->LUT[x]->z);
    }
 
    mp_clear(&tmp);
 
    if (err == MP_OKAY) {
-       fp_cache[idx].LUT_set = 1;
+       fp->LUT_set = 1;
        return MP_OKAY;
    }
 
    /* err cleanup */
-   for (y = 0; y < (1U<<FP_LUT); y++) {
-      wc_ecc_del_point(fp_cache[idx].LUT[y]);
-      fp_cache[idx].LUT[y] = NULL;
+   fp_free_entry(fp);
+
+   return err;
+}
+
+#ifndef NO_FP_ECC_SHARED_GEN
+/* determine if g is the generator of a built in curve, returns MP_OKAY when
+   it is and MP_VAL when not */
+static int is_curve_gen(ecc_point* g, mp_int* a, mp_int* modulus)
+{
+   int    x, size, err = MP_VAL;
+   mp_int t;
+
+   if (mp_cmp_d(g->z, 1) != MP_EQ) {
+      return MP_VAL;
+   }
+   if (mp_init(&t) != MP_OKAY) {
+      return MP_INIT_E;
    }
-   wc_ecc_del_point(fp_cache[idx].g);
-   fp_cache[idx].g         = NULL;
-   fp_cache[idx].LUT_set   = 0;
-   fp_cache[idx].lru_count = 0;
-   mp_clear(&fp_cache[idx].mu);
+
+   size = mp_unsigned_bin_size(modulus);
+   for (x = 0; ecc_sets[x].size != 0 && err != MP_OKAY; x++) {
+      if (ecc_sets[x].size != size ||
+          mp_read_radix(&t, ecc_sets[x].prime, MP_RADIX_HEX) != MP_OKAY ||
+          mp_cmp(&t, modulus) != MP_EQ ||
+          mp_read_radix(&t, ecc_sets[x].Af, MP_RADIX_HEX) != MP_OKAY ||
+          mp_cmp(&t, a) != MP_EQ ||
+          mp_read_radix(&t, ecc_sets[x].Gx, MP_RADIX_HEX) != MP_OKAY ||
+          mp_cmp(&t, g->x) != MP_EQ ||
+          mp_read_radix(&t, ecc_sets[x].Gy, MP_RADIX_HEX) != MP_OKAY ||
+          mp_cmp(&t, g->y) != MP_EQ) {
+         continue;
+      }
+      err = MP_OKAY;
+   }
+
+   mp_clear(&t);
 
    return err;
 }
 
+/* look for g in the shared LUTs from start up to count, known is set when a
+   LUT for the curve of g exists */
+static fp_cache_t* find_gen_entry(ecc_point* g, mp_int* a, mp_int* modulus,
+                                  int start, int count, int* known)
+{
+   fp_gen_t* gen;
+   int       x;
+
+   for (x = start; x < count; x++) {
+      gen = &fp_gen[x];
+      if (mp_cmp(&gen->prime, modulus) != MP_EQ ||
+          mp_cmp(&gen->a, a) != MP_EQ) {
+         continue;
+      }
+      /* the curve's generator is known, g is either it or a key */
+      *known = 1;
+      if (mp_cmp(gen->fp.g->x, g->x) == MP_EQ &&
+          mp_cmp(gen->fp.g->y, g->y) == MP_EQ &&
+          mp_cmp(gen->fp.g->z, g->z) == MP_EQ) {
+         return &gen->fp;
+      }
+   }
+
+   return NULL;
+}
+
+/* build the shared LUT of generator g in the next free entry, caller holds
+   ecc_fp_gen_lock */
+static fp_cache_t* build_gen(ecc_point* g, mp_int* a, mp_int* modulus)
+{
+   fp_gen_t* gen = &fp_gen[fp_gen_count];
+   mp_digit  mp;
+   mp_int    mu;
+   int       err;
+
+   if (mp_init(&mu) != MP_OKAY) {
+      return NULL;
+   }
+
+   err = add_entry(&gen->fp, g);
+   if (err == MP_OKAY)
+      err = mp_montgomery_setup(modulus, &mp);
+   if (err == MP_OKAY)
+      err = mp_montgomery_calc_normalization(&mu, modulus);
+   if (err == MP_OKAY)
+      err = build_lut(&gen->fp, a, modulus, mp, &mu);
+   if (err == MP_OKAY)
+      err = mp_init_copy(&gen->prime, modulus);
+   if (err == MP_OKAY)
+      err = mp_init_copy(&gen->a, a);
+   mp_clear(&mu);
+
+   if (err != MP_OKAY) {
+      fp_free_entry(&gen->fp);
+      mp_clear(&gen->prime);
+      mp_clear(&gen->a);
+      return NULL;
+   }
+
+   /* publish the entry only once it is complete */
+   FP_GEN_COUNT_SET(fp_gen_count + 1);
+
+   return &gen->fp;
+}
+
+/* find the shared LUT when g is a curve generator, building it on first use
+   a built LUT is only read until wc_ecc_fp_cleanup, so lookups of built
+   entries do not take the lock, it is only held to build a missing one
+   returns NULL when g has no shared LUT */
+static fp_cache_t* find_gen(ecc_point* g, mp_int* a, mp_int* modulus)
+{
+   fp_cache_t* fp = NULL;
+   int         known = 0;
+   int         count = 0;
+
+#ifndef FP_GEN_LOCKED_LOOKUP
+   count = FP_GEN_COUNT_GET();
+   fp = find_gen_entry(g, a, modulus, 0, count, &known);
+   if (fp != NULL || known || count == FP_GEN_ENTRIES) {
+      return fp;
+   }
+#endif
+
+   if (initGenMutex == 0) { /* extra sanity check if wolfCrypt_Init not called */
+        wc_InitMutex(&ecc_fp_gen_lock);
+        initGenMutex = 1;
+   }
+
+   if (wc_LockMutex(&ecc_fp_gen_lock) != 0)
+      return NULL;
+
+   /* only entries added since count was read, another thread may have built
+      this one meanwhile */
+   fp = find_gen_entry(g, a, modulus, count, fp_gen_count, &known);
+   if (fp == NULL && !known && fp_gen_count < FP_GEN_ENTRIES &&
+                                  is_curve_gen(g, a, modulus) == MP_OKAY) {
+      fp = build_gen(g, a, modulus);
+   }
+
+   wc_UnLockMutex(&ecc_fp_gen_lock);
+
+   return fp;
+}
+#endif /* NO_FP_ECC_SHARED_GEN */
+
 /* perform a fixed point ECC mulmod */
-static int accel_fp_mul(int idx, mp_int* k, ecc_point *R, mp_int* a,
+static int accel_fp_mul(fp_cache_t* fp, mp_int* k, ecc_point *R, mp_int* a,
                         mp_int* modulus, mp_digit mp, int map)
 {
 #define KB_SIZE 128
@@ -9016,14 +9893,14 @@ static int accel_fp_mul(int idx, mp_int* k, ecc_point *R, mp_int* a,
 
           /* add if not first, otherwise copy */
           if (!first && z) {
-             if ((err = ecc_projective_add_point(R, fp_cache[idx].LUT[z], R, a,
+             if ((err = ecc_projective_add_point(R, fp->LUT[z], R, a,
                                                      modulus, mp)) != MP_OKAY) {
                 break;
              }
              if (mp_iszero(R->z)) {
                  /* When all zero then should have done an add */
                  if (mp_iszero(R->x) && mp_iszero(R->y)) {
-                     if ((err = ecc_projective_dbl_point(fp_cache[idx].LUT[z],
+                     if ((err = ecc_projective_dbl_point(fp->LUT[z],
                                                R, a, modulus, mp)) != MP_OKAY) {
                          break;
                      }
@@ -9038,7 +9915,7 @@ static int accel_fp_mul(int idx, mp_int* k, ecc_point *R, mp_int* a,
                     if (err != MP_OKAY) {
                        break;
                     }
-                    err = mp_copy(&fp_cache[idx].mu, R->z);
+                    err = mp_copy(&fp->mu, R->z);
                     if (err != MP_OKAY) {
                        break;
                     }
@@ -9046,9 +9923,9 @@ static int accel_fp_mul(int idx, mp_int* k, ecc_point *R, mp_int* a,
                  }
              }
           } else if (z) {
-             if ((mp_copy(fp_cache[idx].LUT[z]->x, R->x) != MP_OKAY) ||
-                 (mp_copy(fp_cache[idx].LUT[z]->y, R->y) != MP_OKAY) ||
-                 (mp_copy(&fp_cache[idx].mu,       R->z) != MP_OKAY)) {
+             if ((mp_copy(fp->LUT[z]->x, R->x) != MP_OKAY) ||
+                 (mp_copy(fp->LUT[z]->y, R->y) != MP_OKAY) ||
+                 (mp_copy(&fp->mu,       R->z) != MP_OKAY)) {
                  err = GEN_MEM_ERR;
                  break;
              }
@@ -9087,7 +9964,7 @@ done:
 #ifdef ECC_SHAMIR
 #ifndef WOLFSSL_SP_MATH
 /* perform a fixed point ECC mulmod */
-static int accel_fp_mul2add(int idx1, int idx2,
+static int accel_fp_mul2add(fp_cache_t* fpA, fp_cache_t* fpB,
                             mp_int* kA, mp_int* kB,
                             ecc_point *R, mp_int* a,
                             mp_int* modulus, mp_digit mp)
@@ -9252,7 +10129,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
 
              /* add if not first, otherwise copy */
              if (zA) {
-                if ((err = ecc_projective_add_point(R, fp_cache[idx1].LUT[zA],
+                if ((err = ecc_projective_add_point(R, fpA->LUT[zA],
                                                R, a, modulus, mp)) != MP_OKAY) {
                    break;
                 }
@@ -9260,7 +10137,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
                     /* When all zero then should have done an add */
                     if (mp_iszero(R->x) && mp_iszero(R->y)) {
                         if ((err = ecc_projective_dbl_point(
-                                                  fp_cache[idx1].LUT[zA], R,
+                                                  fpA->LUT[zA], R,
                                                   a, modulus, mp)) != MP_OKAY) {
                             break;
                         }
@@ -9275,7 +10152,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
                        if (err != MP_OKAY) {
                           break;
                        }
-                       err = mp_copy(&fp_cache[idx1].mu, R->z);
+                       err = mp_copy(&fpA->mu, R->z);
                        if (err != MP_OKAY) {
                           break;
                        }
@@ -9285,7 +10162,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
              }
 
              if (zB) {
-                if ((err = ecc_projective_add_point(R, fp_cache[idx2].LUT[zB],
+                if ((err = ecc_projective_add_point(R, fpB->LUT[zB],
                                                R, a, modulus, mp)) != MP_OKAY) {
                    break;
                 }
@@ -9293,7 +10170,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
                     /* When all zero then should have done an add */
                     if (mp_iszero(R->x) && mp_iszero(R->y)) {
                         if ((err = ecc_projective_dbl_point(
-                                                  fp_cache[idx2].LUT[zB], R,
+                                                  fpB->LUT[zB], R,
                                                   a, modulus, mp)) != MP_OKAY) {
                             break;
                         }
@@ -9308,7 +10185,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
                        if (err != MP_OKAY) {
                           break;
                        }
-                       err = mp_copy(&fp_cache[idx2].mu, R->z);
+                       err = mp_copy(&fpB->mu, R->z);
                        if (err != MP_OKAY) {
                           break;
                        }
@@ -9318,9 +10195,9 @@ static int accel_fp_mul2add(int idx1, int idx2,
              }
           } else {
              if (zA) {
-                 if ((mp_copy(fp_cache[idx1].LUT[zA]->x, R->x) != MP_OKAY) ||
-                     (mp_copy(fp_cache[idx1].LUT[zA]->y, R->y) != MP_OKAY) ||
-                     (mp_copy(&fp_cache[idx1].mu,        R->z) != MP_OKAY)) {
+                 if ((mp_copy(fpA->LUT[zA]->x, R->x) != MP_OKAY) ||
+                     (mp_copy(fpA->LUT[zA]->y, R->y) != MP_OKAY) ||
+                     (mp_copy(&fpA->mu,        R->z) != MP_OKAY)) {
                      err = GEN_MEM_ERR;
                      break;
                  }
@@ -9329,14 +10206,14 @@ static int accel_fp_mul2add(int idx1, int idx2,
              if (zB && first == 0) {
                 if (zB) {
                    if ((err = ecc_projective_add_point(R,
-                        fp_cache[idx2].LUT[zB], R, a, modulus, mp)) != MP_OKAY){
+                        fpB->LUT[zB], R, a, modulus, mp)) != MP_OKAY){
                       break;
                    }
                    if (mp_iszero(R->z)) {
                        /* When all zero then should have done an add */
                        if (mp_iszero(R->x) && mp_iszero(R->y)) {
                            if ((err = ecc_projective_dbl_point(
-                                                  fp_cache[idx2].LUT[zB], R,
+                                                  fpB->LUT[zB], R,
                                                   a, modulus, mp)) != MP_OKAY) {
                                break;
                            }
@@ -9351,7 +10228,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
                           if (err != MP_OKAY) {
                              break;
                           }
-                          err = mp_copy(&fp_cache[idx2].mu, R->z);
+                          err = mp_copy(&fpB->mu, R->z);
                           if (err != MP_OKAY) {
                              break;
                           }
@@ -9360,9 +10237,9 @@ static int accel_fp_mul2add(int idx1, int idx2,
                    }
                 }
              } else if (zB && first == 1) {
-                 if ((mp_copy(fp_cache[idx2].LUT[zB]->x, R->x) != MP_OKAY) ||
-                     (mp_copy(fp_cache[idx2].LUT[zB]->y, R->y) != MP_OKAY) ||
-                     (mp_copy(&fp_cache[idx2].mu,        R->z) != MP_OKAY)) {
+                 if ((mp_copy(fpB->LUT[zB]->x, R->x) != MP_OKAY) ||
+                     (mp_copy(fpB->LUT[zB]->y, R->y) != MP_OKAY) ||
+                     (mp_copy(&fpB->mu,        R->z) != MP_OKAY)) {
                      err = GEN_MEM_ERR;
                      break;
                  }
@@ -9419,11 +10296,19 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
    int  idx1 = -1, idx2 = -1, err, mpInit = 0;
    mp_digit mp;
    mp_int   mu;
+   fp_cache_t* fpA = NULL;
+   fp_cache_t* fpB = NULL;
 
    err = mp_init(&mu);
    if (err != MP_OKAY)
        return err;
 
+#ifndef NO_FP_ECC_SHARED_GEN
+   /* generators use the LUT shared by all threads */
+   fpA = find_gen(A, a, modulus);
+   fpB = find_gen(B, a, modulus);
+#endif
+
 #ifndef HAVE_THREAD_LS
    if (initMutex == 0) { /* extra sanity check if wolfCrypt_Init not called */
         wc_InitMutex(&ecc_fp_lock);
@@ -9434,22 +10319,29 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
       return BAD_MUTEX_E;
 #endif /* HAVE_THREAD_LS */
 
-      /* find point */
-      idx1 = find_base(A);
+      err = fp_cache_setup();
 
-      /* no entry? */
-      if (idx1 == -1) {
-         /* find hole and add it */
-         if ((idx1 = find_hole()) >= 0) {
-            err = add_entry(idx1, A);
-         }
-      }
-      if (err == MP_OKAY && idx1 != -1) {
-         /* increment LRU */
-         ++(fp_cache[idx1].lru_count);
+      if (err == MP_OKAY && fpA == NULL) {
+        /* find point */
+        idx1 = find_base(A);
+
+        /* no entry? */
+        if (idx1 == -1) {
+           /* find hole and add it */
+           if ((idx1 = find_hole()) >= 0) {
+              err = add_entry(&fp_cache[idx1], A);
+           }
+        }
+        if (err == MP_OKAY && idx1 != -1) {
+           /* increment LRU */
+           ++(fp_cache[idx1].lru_count);
+           /* don't evict it to make room for B */
+           fp_cache[idx1].lock = 1;
+           fpA = &fp_cache[idx1];
+        }
       }
 
-      if (err == MP_OKAY) {
+      if (err == MP_OKAY && fpB == NULL) {
         /* find point */
         idx2 = find_base(B);
 
@@ -9457,18 +10349,22 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
         if (idx2 == -1) {
            /* find hole and add it */
            if ((idx2 = find_hole()) >= 0)
-              err = add_entry(idx2, B);
-         }
+              err = add_entry(&fp_cache[idx2], B);
+        }
+        if (err == MP_OKAY && idx2 != -1) {
+           /* increment LRU */
+           ++(fp_cache[idx2].lru_count);
+           fpB = &fp_cache[idx2];
+        }
       }
 
-      if (err == MP_OKAY && idx2 != -1) {
-         /* increment LRU */
-         ++(fp_cache[idx2].lru_count);
+      if (idx1 >= 0) {
+        fp_cache[idx1].lock = 0;
       }
 
       if (err == MP_OKAY) {
         /* if it's >= 2 AND the LUT is not set build the LUT */
-        if (idx1 >= 0 && fp_cache[idx1].lru_count >= 2 && !fp_cache[idx1].LUT_set) {
+        if (fpA != NULL && fpA->lru_count >= 2 && !fpA->LUT_set) {
            /* compute mp */
            err = mp_montgomery_setup(modulus, &mp);
 
@@ -9479,13 +10375,13 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
 
            if (err == MP_OKAY)
              /* build the LUT */
-               err = build_lut(idx1, a, modulus, mp, &mu);
+               err = build_lut(fpA, a, modulus, mp, &mu);
         }
       }
 
       if (err == MP_OKAY) {
         /* if it's >= 2 AND the LUT is not set build the LUT */
-        if (idx2 >= 0 && fp_cache[idx2].lru_count >= 2 && !fp_cache[idx2].LUT_set) {
+        if (fpB != NULL && fpB->lru_count >= 2 && !fpB->LUT_set) {
            if (mpInit == 0) {
                 /* compute mp */
                 err = mp_montgomery_setup(modulus, &mp);
@@ -9497,20 +10393,19 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
 
             if (err == MP_OKAY)
             /* build the LUT */
-              err = build_lut(idx2, a, modulus, mp, &mu);
+              err = build_lut(fpB, a, modulus, mp, &mu);
         }
       }
 
 
       if (err == MP_OKAY) {
-        if (idx1 >=0 && idx2 >= 0 && fp_cache[idx1].LUT_set &&
-                                     fp_cache[idx2].LUT_set) {
+        if (fpA != NULL && fpB != NULL && fpA->LUT_set && fpB->LUT_set) {
            if (mpInit == 0) {
               /* compute mp */
               err = mp_montgomery_setup(modulus, &mp);
            }
            if (err == MP_OKAY)
-             err = accel_fp_mul2add(idx1, idx2, kA, kB, C, a, modulus, mp);
+             err = accel_fp_mul2add(fpA, fpB, kA, kB, C, a, modulus, mp);
         } else {
            err = normal_ecc_mul2add(A, kA, B, kB, C, a, modulus, heap);
         }
@@ -9540,15 +10435,28 @@ int wc_ecc_mulmod_ex(mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
     mp_int* modulus, int map, void* heap)
 {
 #ifndef WOLFSSL_SP_MATH
-   int   idx, err = MP_OKAY;
+   int   idx = -1, err = MP_OKAY;
    mp_digit mp;
    mp_int   mu;
    int      mpSetup = 0;
+#ifndef NO_FP_ECC_SHARED_GEN
+   fp_cache_t* gen;
+#endif
 
    if (k == NULL || G == NULL || R == NULL || a == NULL || modulus == NULL) {
        return ECC_BAD_ARG_E;
    }
 
+#ifndef NO_FP_ECC_SHARED_GEN
+   /* generators use the LUT shared by all threads */
+   if ((gen = find_gen(G, a, modulus)) != NULL) {
+      err = mp_montgomery_setup(modulus, &mp);
+      if (err == MP_OKAY)
+         err = accel_fp_mul(gen, k, R, a, modulus, mp, map);
+      return err;
+   }
+#endif
+
    if (mp_init(&mu) != MP_OKAY)
        return MP_INIT_E;
 
@@ -9562,16 +10470,19 @@ int wc_ecc_mulmod_ex(mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
       return BAD_MUTEX_E;
 #endif /* HAVE_THREAD_LS */
 
+      err = fp_cache_setup();
+
       /* find point */
-      idx = find_base(G);
+      if (err == MP_OKAY)
+         idx = find_base(G);
 
       /* no entry? */
-      if (idx == -1) {
+      if (err == MP_OKAY && idx == -1) {
          /* find hole and add it */
          idx = find_hole();
 
          if (idx >= 0)
-            err = add_entry(idx, G);
+            err = add_entry(&fp_cache[idx], G);
       }
       if (err == MP_OKAY && idx >= 0) {
          /* increment LRU */
@@ -9593,7 +10504,7 @@ int wc_ecc_mulmod_ex(mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
 
            if (err == MP_OKAY)
              /* build the LUT */
-             err = build_lut(idx, a, modulus, mp, &mu);
+             err = build_lut(&fp_cache[idx], a, modulus, mp, &mu);
         }
       }
 
@@ -9604,7 +10515,7 @@ int wc_ecc_mulmod_ex(mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
               err = mp_montgomery_setup(modulus, &mp);
            }
            if (err == MP_OKAY)
-             err = accel_fp_mul(idx, k, R, a, modulus, mp, map);
+             err = accel_fp_mul(&fp_cache[idx], k, R, a, modulus, mp, map);
         } else {
            err = normal_ecc_mulmod(k, G, R, a, modulus, map, heap);
         }
@@ -9635,30 +10546,6 @@ int wc_ecc_mulmod_ex(mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
 #endif
 }
 
-#ifndef WOLFSSL_SP_MATH
-/* helper function for freeing the cache ...
-   must be called with the cache mutex locked */
-static void wc_ecc_fp_free_cache(void)
-{
-   unsigned x, y;
-   for (x = 0; x < FP_ENTRIES; x++) {
-      if (fp_cache[x].g != NULL) {
-         for (y = 0; y < (1U<<FP_LUT); y++) {
-            wc_ecc_del_point(fp_cache[x].LUT[y]);
-            fp_cache[x].LUT[y] = NULL;
-         }
-         wc_ecc_del_point(fp_cache[x].g);
-         fp_cache[x].g         = NULL;
-         mp_clear(&fp_cache[x].mu);
-         fp_cache[x].LUT_set   = 0;
-         fp_cache[x].lru_count = 0;
-         fp_cache[x].lock = 0;
-      }
-   }
-}
-#endif
-
-
 /** Init the Fixed Point cache */
 void wc_ecc_fp_init(void)
 {
@@ -9669,7 +10556,32 @@ void wc_ecc_fp_init(void)
         initMutex = 1;
    }
 #endif
+#ifndef NO_FP_ECC_SHARED_GEN
+   if (initGenMutex == 0) {
+        wc_InitMutex(&ecc_fp_gen_lock);
+        initGenMutex = 1;
+   }
+#endif
+#endif
+}
+
+
+/** Set the number of entries of the Fixed Point key cache
+    Each thread resizes its cache on its next fixed point operation, which
+    drops the LUTs it has built. At least two entries are needed for Shamir's
+    trick.
+    entries  Number of public points to keep a LUT for
+    return 0 on success, BAD_FUNC_ARG when entries is out of range */
+int wc_ecc_fp_set_entries(int entries)
+{
+   if (entries < 2 || entries > FP_MAX_ENTRIES)
+      return BAD_FUNC_ARG;
+
+#ifndef WOLFSSL_SP_MATH
+   fp_entries = entries;
 #endif
+
+   return 0;
 }
 
 
@@ -9686,7 +10598,7 @@ void wc_ecc_fp_free(void)
    if (wc_LockMutex(&ecc_fp_lock) == 0) {
 #endif /* HAVE_THREAD_LS */
 
-       wc_ecc_fp_free_cache();
+       fp_free_cache();
 
 #ifndef HAVE_THREAD_LS
        wc_UnLockMutex(&ecc_fp_lock);
@@ -9698,6 +10610,32 @@ void wc_ecc_fp_free(void)
 }
 
 
+/** Free the curve generator LUTs shared by all threads, only once no thread
+    uses the Fixed Point cache anymore */
+void wc_ecc_fp_cleanup(void)
+{
+#if !defined(WOLFSSL_SP_MATH) && !defined(NO_FP_ECC_SHARED_GEN)
+   int x;
+
+   if (initGenMutex == 0)
+      return;
+
+   if (wc_LockMutex(&ecc_fp_gen_lock) == 0) {
+      for (x = 0; x < fp_gen_count; x++) {
+         fp_free_entry(&fp_gen[x].fp);
+         mp_clear(&fp_gen[x].prime);
+         mp_clear(&fp_gen[x].a);
+      }
+      FP_GEN_COUNT_SET(0);
+
+      wc_UnLockMutex(&ecc_fp_gen_lock);
+      wc_FreeMutex(&ecc_fp_gen_lock);
+      initGenMutex = 0;
+   }
+#endif
+}
+
+
 #endif /* FP_ECC */
 
 #ifdef HAVE_ECC_ENCRYPT
@@ -34,6 +34,9 @@
 #include <wolfssl/wolfcrypt/ed25519.h>
 #include <wolfssl/wolfcrypt/error-crypt.h>
 #include <wolfssl/wolfcrypt/hash.h>
+#ifdef WOLF_CRYPTO_CB
+    #include <wolfssl/wolfcrypt/cryptocb.h>
+#endif
 #ifdef NO_INLINE
     #include <wolfssl/wolfcrypt/misc.h>
 #else
@@ -102,6 +105,15 @@ int wc_ed25519_make_key(WC_RNG* rng, int keySz, ed25519_key* key)
     if (keySz != ED25519_KEY_SIZE)
         return BAD_FUNC_ARG;
 
+#ifdef WOLF_CRYPTO_CB
+    if (key->devId != INVALID_DEVID) {
+        ret = wc_CryptoCb_Ed25519Gen(rng, keySz, key);
+        if (ret != CRYPTOCB_UNAVAILABLE)
+            return ret;
+        /* fall-through when unavailable */
+    }
+#endif
+
     ret  = wc_RNG_GenerateBlock(rng, key->k, ED25519_KEY_SIZE);
     if (ret != 0)
         return ret;
@@ -154,6 +166,17 @@ static int ed25519_sign_msg(const byte* in, word32 inLen, byte* out,
                                          (context == NULL && contextLen != 0)) {
         return BAD_FUNC_ARG;
     }
+
+#ifdef WOLF_CRYPTO_CB
+    if (key->devId != INVALID_DEVID) {
+        ret = wc_CryptoCb_Ed25519Sign(in, inLen, out, outLen, key, type,
+                                      context, contextLen);
+        if (ret != CRYPTOCB_UNAVAILABLE)
+            return ret;
+        /* fall-through when unavailable */
+    }
+#endif
+
     if (!key->pubKeySet)
         return BAD_FUNC_ARG;
 
@@ -333,6 +356,72 @@ int wc_ed25519ph_sign_msg(const byte* in, word32 inLen, byte* out,
 
 #ifdef HAVE_ED25519_VERIFY
 
+#ifdef WOLFSSL_VERIFY_BATCH
+#if !defined(ED25519_SMALL) && !defined(FREESCALE_LTC_ECC) && \
+    !defined(WC_NO_RNG)
+    #define ED25519_VERIFY_BATCH_SHARED
+#endif
+#endif
+
+#ifdef ED25519_VERIFY_BATCH_SHARED
+#ifndef WC_ED25519_BATCH_SZ
+    #define WC_ED25519_BATCH_SZ 64 /* signatures checked with one equation */
+#endif
+
+/* return 1 when the encoded y coordinate is less than 2^255 - 19 */
+static int ed25519_is_canonical(const byte* y)
+{
+    int i;
+
+    if ((y[ED25519_KEY_SIZE-1] & 0x7f) != 0x7f)
+        return 1;
+    for (i = ED25519_KEY_SIZE - 2; i > 0; i--) {
+        if (y[i] != 0xff)
+            return 1;
+    }
+    return y[0] < 0xed;
+}
+
+/*
+   Checks the cofactored equation 8(SB - R - hA) = 0 of one signature, the
+   equation wc_ed25519_verify_batch() checks, so that both give the same
+   result for every signature. R must be canonical and neither R nor A may be
+   of small order.
+   sig     signature, R followed by S
+   h       H(R,A,M) reduced mod the group order
+   nA      the negated public key
+   return  0 when the signature verifies and SIG_VERIFY_E otherwise
+*/
+static int ed25519_verify_cofactored(const byte* sig, const byte* h,
+                                     const ge_p3* nA)
+{
+    int   ret;
+    byte  a[ED25519_KEY_SIZE * 2];
+    ge_p3 P[2];
+    ge_p2 r;
+
+    /* uncompress and negate R */
+    if (!ed25519_is_canonical(sig) ||
+                                 ge_frombytes_negate_vartime(&P[0], sig) != 0)
+        return SIG_VERIFY_E;
+    P[1] = *nA;
+    /* the cofactor would cancel h.A for any message */
+    if (ge_p3_is_small_order(&P[0]) || ge_p3_is_small_order(&P[1]))
+        return SIG_VERIFY_E;
+
+    /* SB - 1.R - h.A */
+    XMEMSET(a, 0, sizeof(a));
+    a[0] = 1;
+    XMEMCPY(a + ED25519_KEY_SIZE, h, ED25519_KEY_SIZE);
+    ret = ge_multi_scalarmult_vartime(&r, sig + (ED25519_SIG_SIZE/2), a, P, 2,
+                                      NULL);
+    if (ret == 0 && !ge_p2_is_small_order(&r))
+        ret = SIG_VERIFY_E;
+
+    return ret;
+}
+#endif /* ED25519_VERIFY_BATCH_SHARED */
+
 /*
    sig     is array of bytes containing the signature
    sigLen  is the length of sig byte array
@@ -346,11 +435,15 @@ static int ed25519_verify_msg(const byte* sig, word32 sigLen, const byte* msg,
                               word32 msgLen, int* res, ed25519_key* key,
                               byte type, const byte* context, byte contextLen)
 {
+#ifndef ED25519_VERIFY_BATCH_SHARED
     byte   rcheck[ED25519_KEY_SIZE];
+#endif
     byte   h[WC_SHA512_DIGEST_SIZE];
 #ifndef FREESCALE_LTC_ECC
     ge_p3  A;
+#ifndef ED25519_VERIFY_BATCH_SHARED
     ge_p2  R;
+#endif
 #endif
     int    ret;
     wc_Sha512 sha;
@@ -364,6 +457,16 @@ static int ed25519_verify_msg(const byte* sig, word32 sigLen, const byte* msg,
     /* set verification failed by default */
     *res = 0;
 
+#ifdef WOLF_CRYPTO_CB
+    if (key->devId != INVALID_DEVID) {
+        ret = wc_CryptoCb_Ed25519Verify(sig, sigLen, msg, msgLen, res, key,
+                                        type, context, contextLen);
+        if (ret != CRYPTOCB_UNAVAILABLE)
+            return ret;
+        /* fall-through when unavailable */
+    }
+#endif
+
     /* check on basics needed to verify signature */
     if (sigLen != ED25519_SIG_SIZE || (sig[ED25519_SIG_SIZE-1] & 224))
         return BAD_FUNC_ARG;
@@ -405,6 +508,12 @@ static int ed25519_verify_msg(const byte* sig, word32 sigLen, const byte* msg,
 #else
     sc_reduce(h);
 
+#ifdef ED25519_VERIFY_BATCH_SHARED
+    /* the same cofactored equation as the batch verify */
+    ret = ed25519_verify_cofactored(sig, h, &A);
+    if (ret != 0)
+        return ret;
+#else
     /*
        Uses a fast single-signature verification SB = R + H(R,A,M)A becomes
        SB - H(R,A,M)A saving decompression of R
@@ -414,12 +523,15 @@ static int ed25519_verify_msg(const byte* sig, word32 sigLen, const byte* msg,
         return ret;
 
     ge_tobytes(rcheck, &R);
+#endif /* ED25519_VERIFY_BATCH_SHARED */
 #endif /* FREESCALE_LTC_ECC */
 
+#ifndef ED25519_VERIFY_BATCH_SHARED
     /* comparison of R created to R in sig */
     ret = ConstantCompare(rcheck, sig, ED25519_SIG_SIZE/2);
     if (ret != 0)
         return SIG_VERIFY_E;
+#endif
 
     /* set the verification status */
     *res = 1;
@@ -506,17 +618,225 @@ int wc_ed25519ph_verify_msg(const byte* sig, word32 sigLen, const byte* msg,
     return wc_ed25519ph_verify_hash(sig, sigLen, hash, sizeof(hash), res, key,
                                                            context, contextLen);
 }
+
+#ifdef WOLFSSL_VERIFY_BATCH
+#ifdef ED25519_VERIFY_BATCH_SHARED
+
+/*
+   Checks the signatures listed in idx with one random linear combination
+   of their verification equations:
+     8((z[0]S[0] + ... )B - z[0]R[0] - z[0]h[0]A[0] - ... ) = 0
+   where z are 128-bit random values and h = H(R,A,M). The multiplication
+   by the cofactor makes the check independent of small order components.
+   An R or A of small order fails the batch, so that its signatures are left
+   to the single verify, which rejects them as well.
+   return  0 when all of the signatures verify and SIG_VERIFY_E otherwise
+*/
+static int ed25519_verify_batch_ex(const byte* const* sig,
+                                   const byte* const* msg,
+                                   const word32* msgLen,
+                                   ed25519_key* const* key, const int* idx,
+                                   int cnt, WC_RNG* rng)
+{
+    int        ret;
+    int        i;
+    byte       h[WC_SHA512_DIGEST_SIZE];
+    byte       b[ED25519_KEY_SIZE];
+    byte       zero[ED25519_KEY_SIZE];
+    byte*      z;  /* cnt scalars of 128 random bits */
+    byte*      a;  /* scalars for -R[0], ... , -R[cnt-1], -A[0], ... */
+    ge_p3*     P;  /* -R[0], ... , -R[cnt-1], -A[0], ... , -A[cnt-1] */
+    ge_p2      r;
+    wc_Sha512  sha;
+
+    z = (byte*)XMALLOC(ED25519_KEY_SIZE * cnt, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    a = (byte*)XMALLOC(ED25519_KEY_SIZE * 2 * cnt, NULL,
+                                                      DYNAMIC_TYPE_TMP_BUFFER);
+    P = (ge_p3*)XMALLOC(sizeof(ge_p3) * 2 * cnt, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    if (z == NULL || a == NULL || P == NULL) {
+        XFREE(P, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(a, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(z, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        return MEMORY_E;
+    }
+
+    XMEMSET(b, 0, sizeof(b));
+    XMEMSET(zero, 0, sizeof(zero));
+    XMEMSET(z, 0, ED25519_KEY_SIZE * cnt);
+
+    /* random values for the whole batch from one call */
+    ret = wc_RNG_GenerateBlock(rng, a, (ED25519_KEY_SIZE / 2) * cnt);
+    for (i = 0; ret == 0 && i < cnt; i++) {
+        XMEMCPY(z + ED25519_KEY_SIZE * i, a + (ED25519_KEY_SIZE / 2) * i,
+                                                         ED25519_KEY_SIZE / 2);
+    }
+
+    for (i = 0; ret == 0 && i < cnt; i++) {
+        const byte* sg = sig[idx[i]];
+        ed25519_key* k = key[idx[i]];
+        byte* zi = z + ED25519_KEY_SIZE * i;
+
+        /* uncompress and negate R and A */
+        if (ge_frombytes_negate_vartime(&P[i], sg) != 0 ||
+                ge_frombytes_negate_vartime(&P[cnt + i], k->p) != 0) {
+            ret = SIG_VERIFY_E;
+            break;
+        }
+        /* the cofactor would cancel h.A for any message */
+        if (ge_p3_is_small_order(&P[i]) || ge_p3_is_small_order(&P[cnt + i])) {
+            ret = SIG_VERIFY_E;
+            break;
+        }
+
+        /* find H(R,A,M) and store it as h */
+        ret = wc_InitSha512(&sha);
+        if (ret != 0)
+            break;
+        ret = wc_Sha512Update(&sha, sg, ED25519_SIG_SIZE/2);
+        if (ret == 0)
+            ret = wc_Sha512Update(&sha, k->p, ED25519_PUB_KEY_SIZE);
+        if (ret == 0)
+            ret = wc_Sha512Update(&sha, msg[idx[i]], msgLen[idx[i]]);
+        if (ret == 0)
+            ret = wc_Sha512Final(&sha, h);
+        wc_Sha512Free(&sha);
+        if (ret != 0)
+            break;
+        sc_reduce(h);
+
+        XMEMCPY(a + ED25519_KEY_SIZE * i, zi, ED25519_KEY_SIZE);
+        sc_muladd(a + ED25519_KEY_SIZE * (cnt + i), zi, h, zero);
+        sc_muladd(b, zi, sg + (ED25519_SIG_SIZE/2), b);
+    }
+
+    if (ret == 0)
+        ret = ge_multi_scalarmult_vartime(&r, b, a, P, 2 * cnt, NULL);
+    if (ret == 0 && !ge_p2_is_small_order(&r))
+        ret = SIG_VERIFY_E;
+
+    XFREE(P, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(a, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(z, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+#endif /* ED25519_VERIFY_BATCH_SHARED */
+
+/*
+   sig     array of count signatures
+   sigLen  array of count signature lengths
+   msg     array of count messages
+   msgLen  array of count message lengths
+   res     array of count results, 1 on successful verify and 0 on
+           unsuccessful
+   key     array of count Ed25519 public keys
+   count   number of signatures to verify
+   rng     random number generator for the batch coefficients
+   return  0 when all signatures verify and SIG_VERIFY_E when any do not
+
+   Signatures are checked together with the cofactored equation
+   8(SB - R - hA) = 0. With the batch built in, wc_ed25519_verify_msg()
+   checks the same equation for one signature and rejects an R or A of small
+   order, so res always matches it. When a batch fails its signatures are
+   checked again one at a time.
+*/
+int wc_ed25519_verify_batch(const byte* const* sig, const word32* sigLen,
+                            const byte* const* msg, const word32* msgLen,
+                            int* res, ed25519_key* const* key, int count,
+                            WC_RNG* rng)
+{
+    int ret = 0;
+    int i;
+    int valid = 1;
+#ifdef ED25519_VERIFY_BATCH_SHARED
+    int n;
+    int cnt;
+    int idx[WC_ED25519_BATCH_SZ];
+#endif
+
+    if (sig == NULL || sigLen == NULL || msg == NULL || msgLen == NULL ||
+                       res == NULL || key == NULL || count <= 0 || rng == NULL) {
+        return BAD_FUNC_ARG;
+    }
+    for (i = 0; i < count; i++) {
+        if (sig[i] == NULL || msg[i] == NULL || key[i] == NULL)
+            return BAD_FUNC_ARG;
+        res[i] = 0;
+    }
+
+#ifdef ED25519_VERIFY_BATCH_SHARED
+    for (n = 0; ret == 0 && n < count; ) {
+        /* well formed signatures go in the batch, others are left to the
+         * single verify */
+        for (cnt = 0; n < count && cnt < WC_ED25519_BATCH_SZ; n++) {
+        #ifdef WOLF_CRYPTO_CB
+            /* keys on a device are verified by the device */
+            if (key[n]->devId != INVALID_DEVID)
+                continue;
+        #endif
+            if (sigLen[n] == ED25519_SIG_SIZE &&
+                    (sig[n][ED25519_SIG_SIZE-1] & 224) == 0 &&
+                    ed25519_is_canonical(sig[n])) {
+                idx[cnt++] = n;
+            }
+        }
+        if (cnt < 2)
+            break;
+
+        ret = ed25519_verify_batch_ex(sig, msg, msgLen, key, idx, cnt, rng);
+        if (ret == 0) {
+            for (i = 0; i < cnt; i++)
+                res[idx[i]] = 1;
+        }
+        else if (ret == SIG_VERIFY_E) {
+            ret = 0;
+        }
+    }
+#endif
+
+    /* verify the rest one at a time */
+    for (i = 0; ret == 0 && i < count; i++) {
+        if (res[i] == 1)
+            continue;
+        ret = ed25519_verify_msg(sig[i], sigLen[i], msg[i], msgLen[i],
+                                 &res[i], key[i], (byte)Ed25519, NULL, 0);
+        /* a malformed signature only fails its own entry */
+        if (ret == SIG_VERIFY_E || ret == BAD_FUNC_ARG)
+            ret = 0;
+    }
+
+    for (i = 0; ret == 0 && i < count; i++) {
+        if (res[i] != 1)
+            valid = 0;
+    }
+    if (ret == 0 && !valid)
+        ret = SIG_VERIFY_E;
+
+#ifndef ED25519_VERIFY_BATCH_SHARED
+    (void)rng;
+#endif
+
+    return ret;
+}
+#endif /* WOLFSSL_VERIFY_BATCH */
 #endif /* HAVE_ED25519_VERIFY */
 
 
 /* initialize information and memory for key */
-int wc_ed25519_init(ed25519_key* key)
+int wc_ed25519_init_ex(ed25519_key* key, void* heap, int devId)
 {
     if (key == NULL)
         return BAD_FUNC_ARG;
 
     XMEMSET(key, 0, sizeof(ed25519_key));
 
+#ifdef WOLF_CRYPTO_CB
+    key->devId = devId;
+#else
+    (void)devId;
+#endif
+    (void)heap;
+
 #ifndef FREESCALE_LTC_ECC
     fe_init();
 #endif
@@ -524,6 +844,12 @@ int wc_ed25519_init(ed25519_key* key)
     return 0;
 }
 
+/* initialize key for use without a crypto callback device */
+int wc_ed25519_init(ed25519_key* key)
+{
+    return wc_ed25519_init_ex(key, NULL, INVALID_DEVID);
+}
+
 
 /* clear memory of key */
 void wc_ed25519_free(ed25519_key* key)
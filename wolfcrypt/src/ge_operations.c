@@ -9460,6 +9460,123 @@ int ge_double_scalarmult_vartime(ge_p2 *r, const unsigned char *a,
   return 0;
 }
 
+#ifdef WOLFSSL_VERIFY_BATCH
+/*
+r = b * B + a[0] * A[0] + ... + a[n-1] * A[n-1]
+where a[i] is the 32 byte scalar at a + 32 * i and b is as above.
+B is the Ed25519 base point (x,4/5) with x positive.
+The doublings are shared by all of the points (Straus' method).
+*/
+int ge_multi_scalarmult_vartime(ge_p2 *r, const unsigned char *b,
+                                const unsigned char *a, const ge_p3 *A, int n,
+                                void *heap)
+{
+  signed char bslide[256];
+  signed char *aslide;
+  ge_cached *Ai; /* A[j],3A[j],5A[j],...,15A[j] for each point */
+  ge_p1p1 t;
+  ge_p3 u;
+  ge_p3 A2;
+  int i;
+  int j;
+  int k;
+
+  aslide = (signed char*)XMALLOC(256 * n, heap, DYNAMIC_TYPE_TMP_BUFFER);
+  Ai = (ge_cached*)XMALLOC(sizeof(ge_cached) * 8 * n, heap,
+                           DYNAMIC_TYPE_TMP_BUFFER);
+  if (aslide == NULL || Ai == NULL) {
+    XFREE(Ai, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(aslide, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    return MEMORY_E;
+  }
+
+  slide(bslide,b);
+  for (j = 0;j < n;++j) {
+    ge_cached *c = Ai + 8 * j;
+
+    slide(aslide + 256 * j,a + 32 * j);
+
+    ge_p3_to_cached(&c[0],&A[j]);
+    ge_p3_dbl(&t,&A[j]); ge_p1p1_to_p3(&A2,&t);
+    for (k = 1;k < 8;++k) {
+      ge_add(&t,&A2,&c[k - 1]); ge_p1p1_to_p3(&u,&t); ge_p3_to_cached(&c[k],&u);
+    }
+  }
+
+  ge_p2_0(r);
+
+  for (i = 255;i >= 0;--i) {
+    if (bslide[i]) break;
+    for (j = 0;j < n;++j) {
+      if (aslide[256 * j + i]) break;
+    }
+    if (j < n) break;
+  }
+
+  for (;i >= 0;--i) {
+    ge_p2_dbl(&t,r);
+
+    for (j = 0;j < n;++j) {
+      signed char v = aslide[256 * j + i];
+
+      if (v > 0) {
+        ge_p1p1_to_p3(&u,&t);
+        ge_add(&t,&u,&Ai[8 * j + v/2]);
+      } else if (v < 0) {
+        ge_p1p1_to_p3(&u,&t);
+        ge_sub(&t,&u,&Ai[8 * j + (-v)/2]);
+      }
+    }
+
+    if (bslide[i] > 0) {
+      ge_p1p1_to_p3(&u,&t);
+      ge_madd(&t,&u,&Bi[bslide[i]/2]);
+    } else if (bslide[i] < 0) {
+      ge_p1p1_to_p3(&u,&t);
+      ge_msub(&t,&u,&Bi[(-bslide[i])/2]);
+    }
+
+    ge_p1p1_to_p2(r,&t);
+  }
+
+  XFREE(Ai, heap, DYNAMIC_TYPE_TMP_BUFFER);
+  XFREE(aslide, heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+  return 0;
+}
+
+/*
+return 1 when 8 * p is the neutral element (0,1) and 0 otherwise
+*/
+int ge_p2_is_small_order(const ge_p2 *p)
+{
+  ge_p2 r;
+  ge_p1p1 t;
+  ge y;
+  int i;
+
+  r = *p;
+  for (i = 0;i < 3;++i) {
+    ge_p2_dbl(&t,&r);
+    ge_p1p1_to_p2(&r,&t);
+  }
+
+  fe_sub(y,r.Y,r.Z);
+  return !fe_isnonzero(r.X) && !fe_isnonzero(y);
+}
+
+/*
+return 1 when 8 * p is the neutral element (0,1) and 0 otherwise
+*/
+int ge_p3_is_small_order(const ge_p3 *p)
+{
+  ge_p2 r;
+
+  ge_p3_to_p2(&r,p);
+  return ge_p2_is_small_order(&r);
+}
+#endif /* WOLFSSL_VERIFY_BATCH */
+
 #ifdef CURVED25519_ASM_64BIT
 static const ge d = {
     0x75eb4dca135978a3, 0x00700a4d4141d8ab, -0x7338bf8688861768, 0x52036cee2b6ffe73,
@@ -1149,6 +1149,85 @@ int wolfSSL_GetHmacMaxSize(void)
     return WC_MAX_DIGEST_SIZE;
 }
 
+#if defined(WOLFSSL_SHA256_MULTI_BUFFER) && !defined(NO_SHA256)
+/* HMAC-SHA256 of count independent messages, each with its own key, through
+ * wc_Sha256_MultiBufferPrefix(). The padded keys are hashed as the prefix
+ * block of the inner and outer hashes.
+ *
+ * key    The key of each message.
+ * keySz  The size of each key.
+ * data   The messages.
+ * sz     The size of each message.
+ * mac    Buffers of WC_SHA256_DIGEST_SIZE bytes for the results.
+ * count  The number of messages.
+ * returns 0 on success, otherwise failure.
+ */
+int wc_HmacSha256_MultiBuffer(const byte* const* key, const word32* keySz,
+    const byte* const* data, const word32* sz, byte* const* mac, word32 count)
+{
+    int    ret = 0;
+    word32 i, j, m, n = 0;
+    byte   pad[WC_SHA256_MB_LANES][WC_SHA256_BLOCK_SIZE];
+    byte   inner[WC_SHA256_MB_LANES][WC_SHA256_DIGEST_SIZE];
+    byte   hashedKey[WC_SHA256_DIGEST_SIZE];
+    const byte* pp[WC_SHA256_MB_LANES];
+    const byte* in[WC_SHA256_MB_LANES];
+    byte*  out[WC_SHA256_MB_LANES];
+    word32 inSz[WC_SHA256_MB_LANES];
+
+    if (key == NULL || keySz == NULL || data == NULL || sz == NULL ||
+            mac == NULL)
+        return BAD_FUNC_ARG;
+    for (i = 0; i < count; i++) {
+        if ((key[i] == NULL && keySz[i] > 0) || mac[i] == NULL)
+            return BAD_FUNC_ARG;
+    }
+
+    for (j = 0; j < WC_SHA256_MB_LANES; j++) {
+        pp[j]   = pad[j];
+        in[j]   = inner[j];
+        out[j]  = inner[j];
+        inSz[j] = WC_SHA256_DIGEST_SIZE;
+    }
+
+    for (i = 0; ret == 0 && i < count; i += n) {
+        n = min(count - i, WC_SHA256_MB_LANES);
+
+        for (j = 0; ret == 0 && j < n; j++) {
+            const byte* k = key[i + j];
+            word32 kSz = keySz[i + j];
+
+            if (kSz > WC_SHA256_BLOCK_SIZE) {
+                ret = wc_Sha256Hash(k, kSz, hashedKey);
+                k = hashedKey;
+                kSz = WC_SHA256_DIGEST_SIZE;
+            }
+            for (m = 0; m < kSz; m++)
+                pad[j][m] = k[m] ^ IPAD;
+            XMEMSET(&pad[j][kSz], IPAD, WC_SHA256_BLOCK_SIZE - kSz);
+        }
+
+        if (ret == 0) {
+            ret = wc_Sha256_MultiBufferPrefix(pp, data + i, sz + i, out, n);
+        }
+        if (ret == 0) {
+            /* turn the inner pad into the outer one */
+            for (j = 0; j < n; j++) {
+                for (m = 0; m < WC_SHA256_BLOCK_SIZE; m++)
+                    pad[j][m] ^= IPAD ^ OPAD;
+            }
+            ret = wc_Sha256_MultiBufferPrefix(pp, in, inSz, mac + i, n);
+        }
+    }
+
+    ForceZero(pad, sizeof(pad));
+    ForceZero(inner, sizeof(inner));
+    ForceZero(hashedKey, sizeof(hashedKey));
+
+    return ret;
+}
+#endif /* WOLFSSL_SHA256_MULTI_BUFFER && !NO_SHA256 */
+
 #ifdef HAVE_HKDF
     /* HMAC-KDF-Extract.
      * RFC 5869 - HMAC-based Extract-and-Expand Key Derivation Function (HKDF).
@@ -1159,10 +1238,13 @@ int wolfSSL_GetHmacMaxSize(void)
      * inKey    The input keying material.
      * inKeySz  The size of the input keying material.
      * out      The pseudorandom key with the length that of the hash.
+     * heap     The heap hint for the HMAC.
+     * devId    The crypto callback device to derive with.
      * returns 0 on success, otherwise failure.
      */
-    int wc_HKDF_Extract(int type, const byte* salt, word32 saltSz,
-                        const byte* inKey, word32 inKeySz, byte* out)
+    int wc_HKDF_Extract_ex(int type, const byte* salt, word32 saltSz,
+                           const byte* inKey, word32 inKeySz, byte* out,
+                           void* heap, int devId)
     {
         byte   tmp[WC_MAX_DIGEST_SIZE]; /* localSalt helper */
         Hmac   myHmac;
@@ -1182,7 +1264,18 @@ int wolfSSL_GetHmacMaxSize(void)
             saltSz    = hashSz;
         }
 
-        ret = wc_HmacInit(&myHmac, NULL, INVALID_DEVID);
+    #ifdef WOLF_CRYPTO_CB
+        if (devId != INVALID_DEVID) {
+            ret = wc_CryptoCb_Hkdf(devId, WC_KDF_TYPE_HKDF_EXTRACT, type,
+                                   inKey, inKeySz, localSalt, saltSz, NULL, 0,
+                                   out, (word32)hashSz);
+            if (ret != CRYPTOCB_UNAVAILABLE)
+                return ret;
+            /* fall-through when unavailable */
+        }
+    #endif
+
+        ret = wc_HmacInit(&myHmac, heap, devId);
         if (ret == 0) {
             ret = wc_HmacSetKey(&myHmac, type, localSalt, saltSz);
             if (ret == 0)
@@ -1195,6 +1288,13 @@ int wolfSSL_GetHmacMaxSize(void)
         return ret;
     }
 
+    int wc_HKDF_Extract(int type, const byte* salt, word32 saltSz,
+                        const byte* inKey, word32 inKeySz, byte* out)
+    {
+        return wc_HKDF_Extract_ex(type, salt, saltSz, inKey, inKeySz, out,
+                                  NULL, INVALID_DEVID);
+    }
+
     /* HMAC-KDF-Expand.
      * RFC 5869 - HMAC-based Extract-and-Expand Key Derivation Function (HKDF).
      *
@@ -1204,10 +1304,13 @@ int wolfSSL_GetHmacMaxSize(void)
      * info     The application specific information.
      * infoSz   The size of the application specific information.
      * out      The output keying material.
+     * heap     The heap hint for the HMAC.
+     * devId    The crypto callback device to derive with.
      * returns 0 on success, otherwise failure.
      */
-    int wc_HKDF_Expand(int type, const byte* inKey, word32 inKeySz,
-                       const byte* info, word32 infoSz, byte* out, word32 outSz)
+    int wc_HKDF_Expand_ex(int type, const byte* inKey, word32 inKeySz,
+                          const byte* info, word32 infoSz, byte* out,
+                          word32 outSz, void* heap, int devId)
     {
         byte   tmp[WC_MAX_DIGEST_SIZE];
         Hmac   myHmac;
@@ -1222,7 +1325,18 @@ int wolfSSL_GetHmacMaxSize(void)
         if (out == NULL || ((outSz/hashSz) + ((outSz % hashSz) != 0)) > 255)
             return BAD_FUNC_ARG;
 
-        ret = wc_HmacInit(&myHmac, NULL, INVALID_DEVID);
+    #ifdef WOLF_CRYPTO_CB
+        if (devId != INVALID_DEVID) {
+            ret = wc_CryptoCb_Hkdf(devId, WC_KDF_TYPE_HKDF_EXPAND, type,
+                                   inKey, inKeySz, NULL, 0, info, infoSz,
+                                   out, outSz);
+            if (ret != CRYPTOCB_UNAVAILABLE)
+                return ret;
+            /* fall-through when unavailable */
+        }
+    #endif
+
+        ret = wc_HmacInit(&myHmac, heap, devId);
         if (ret != 0)
             return ret;
 
@@ -1259,6 +1373,13 @@ int wolfSSL_GetHmacMaxSize(void)
         return ret;
     }
 
+    int wc_HKDF_Expand(int type, const byte* inKey, word32 inKeySz,
+                       const byte* info, word32 infoSz, byte* out, word32 outSz)
+    {
+        return wc_HKDF_Expand_ex(type, inKey, inKeySz, info, infoSz, out,
+                                 outSz, NULL, INVALID_DEVID);
+    }
+
     /* HMAC-KDF.
      * RFC 5869 - HMAC-based Extract-and-Expand Key Derivation Function (HKDF).
      *
@@ -105,6 +105,25 @@ static const word32 sigma[4] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
 /* "expand 16-byte k" as unsigned 16 byte */
 static const word32 tau[4] = {0x61707865, 0x3120646e, 0x79622d36, 0x6b206574};
 
+/**
+  * Set the crypto callback device used by the ChaCha20-Poly1305 AEAD of TLS.
+  */
+int wc_Chacha_Init(ChaCha* ctx, void* heap, int devId)
+{
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+#ifdef WOLF_CRYPTO_CB
+    ctx->devId = devId;
+    ctx->devCtx = NULL;
+#else
+    (void)devId;
+#endif
+    (void)heap;
+
+    return 0;
+}
+
 /**
   * Key setup. 8 word iv (nonce)
   */
@@ -166,6 +185,10 @@ int wc_Chacha_SetKey(ChaCha* ctx, const byte* key, word32 keySz)
     ctx->X[ 1] = constants[1];
     ctx->X[ 2] = constants[2];
     ctx->X[ 3] = constants[3];
+#ifdef WOLF_CRYPTO_CB
+    XMEMCPY(ctx->devKey, key, keySz);
+    ctx->keySz = keySz;
+#endif
 
     return 0;
 }
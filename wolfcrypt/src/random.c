@@ -103,6 +103,9 @@ int wc_RNG_GenerateByte(WC_RNG* rng, byte* b)
 #ifndef WC_NO_RNG /* if not FIPS and RNG is disabled then do not compile */
 
 #include <wolfssl/wolfcrypt/sha256.h>
+#ifdef HAVE_CTRDRBG
+    #include <wolfssl/wolfcrypt/aes.h>
+#endif
 
 #ifdef WOLF_CRYPTO_CB
     #include <wolfssl/wolfcrypt/cryptocb.h>
@@ -693,12 +696,374 @@ int wc_RNG_TestSeed(const byte* seed, word32 seedSz)
 
     return ret;
 }
+
+
+#if defined(WOLFSSL_THREAD_LOCAL_RNG) && !defined(CUSTOM_RAND_GENERATE_BLOCK)
+
+/* Number of child seeds a thread's parent DRBG hands out before it is
+ * reseeded from the OS. */
+#ifndef WC_THREAD_RNG_RESEED_INTERVAL
+    #define WC_THREAD_RNG_RESEED_INTERVAL 4096
+#endif
+#if WC_THREAD_RNG_RESEED_INTERVAL >= RESEED_INTERVAL
+    #error WC_THREAD_RNG_RESEED_INTERVAL must be less than WC_RESEED_INTERVAL
+#endif
+
+/* A forked child inherits the parent DRBG and would hand out the same seeds
+ * as the process it was forked from, so the parent records the process id it
+ * was instantiated in and is instantiated again when that changes. */
+#if !defined(WC_NO_THREAD_RNG_FORK_CHECK) && !defined(USE_WINDOWS_API) && \
+    (defined(__unix__) || defined(__APPLE__))
+    #include <unistd.h>
+    #define WC_THREAD_RNG_FORK_CHECK
+#endif
+
+/* if HAVE_THREAD_LS the parent DRBG is per thread, no locking needed */
+static THREAD_LS_T DRBG threadDrbg;
+static THREAD_LS_T byte threadDrbgStatus = DRBG_NOT_INIT;
+#ifdef WC_THREAD_RNG_FORK_CHECK
+static THREAD_LS_T pid_t threadDrbgPid;
+#endif
+
+#ifndef HAVE_THREAD_LS
+    static wolfSSL_Mutex thread_rng_lock;
+    static volatile int initThreadRngMutex = 0;
+#endif
+
+/* Fill seed from the calling thread's parent DRBG. The parent is
+ * instantiated from the OS on first use, and again after a fork, and
+ * reseeded from the OS every WC_THREAD_RNG_RESEED_INTERVAL calls.
+ * Returns: DRBG_SUCCESS, DRBG_FAILURE or DRBG_CONT_FAILURE */
+static int ThreadDrbg_GenerateSeed(OS_Seed* os, byte* seed, word32 seedSz)
+{
+    int  ret = DRBG_SUCCESS;
+    byte osSeed[MAX_SEED_SZ];
+
+#ifndef HAVE_THREAD_LS
+    if (initThreadRngMutex == 0) { /* extra sanity check if wolfCrypt_Init
+                                      not called */
+        wc_InitMutex(&thread_rng_lock);
+        initThreadRngMutex = 1;
+    }
+
+    if (wc_LockMutex(&thread_rng_lock) != 0)
+        return DRBG_FAILURE;
+#endif
+
+#ifdef WC_THREAD_RNG_FORK_CHECK
+    if (threadDrbgStatus == DRBG_OK && threadDrbgPid != getpid()) {
+        Hash_DRBG_Uninstantiate(&threadDrbg);
+        threadDrbgStatus = DRBG_NOT_INIT;
+    }
+#endif
+
+    if (threadDrbgStatus != DRBG_OK) {
+        if (wc_RNG_HealthTestLocal(0) != 0)
+            ret = DRBG_CONT_FAILURE;
+        else if (wc_GenerateSeed(os, osSeed, MAX_SEED_SZ) != 0)
+            ret = DRBG_FAILURE;
+        else
+            ret = wc_RNG_TestSeed(osSeed, MAX_SEED_SZ);
+
+        if (ret == DRBG_SUCCESS)
+            ret = Hash_DRBG_Instantiate(&threadDrbg, osSeed + SEED_BLOCK_SZ,
+                                        MAX_SEED_SZ - SEED_BLOCK_SZ, NULL, 0,
+                                        NULL, INVALID_DEVID);
+    #ifdef WC_THREAD_RNG_FORK_CHECK
+        threadDrbgPid = getpid();
+    #endif
+    }
+    else if (threadDrbg.reseedCtr >= WC_THREAD_RNG_RESEED_INTERVAL) {
+        if (wc_RNG_HealthTestLocal(1) != 0)
+            ret = DRBG_CONT_FAILURE;
+        else if (wc_GenerateSeed(os, osSeed, SEED_SZ + SEED_BLOCK_SZ) != 0)
+            ret = DRBG_FAILURE;
+        else
+            ret = wc_RNG_TestSeed(osSeed, SEED_SZ + SEED_BLOCK_SZ);
+
+        if (ret == DRBG_SUCCESS)
+            ret = Hash_DRBG_Reseed(&threadDrbg, osSeed + SEED_BLOCK_SZ,
+                                   SEED_SZ);
+    }
+    ForceZero(osSeed, sizeof(osSeed));
+
+    if (ret == DRBG_SUCCESS)
+        ret = Hash_DRBG_Generate(&threadDrbg, seed, seedSz);
+
+    if (ret == DRBG_SUCCESS) {
+        threadDrbgStatus = DRBG_OK;
+    }
+    else {
+        /* start over from the OS on the next call */
+        Hash_DRBG_Uninstantiate(&threadDrbg);
+        threadDrbgStatus = DRBG_NOT_INIT;
+    }
+
+#ifndef HAVE_THREAD_LS
+    wc_UnLockMutex(&thread_rng_lock);
+#endif
+
+    return ret;
+}
+
+#endif /* WOLFSSL_THREAD_LOCAL_RNG && !CUSTOM_RAND_GENERATE_BLOCK */
+
+
+#ifdef HAVE_CTRDRBG
+/* SP 800-90A CTR_DRBG using AES-256 with the derivation function. The
+ * seeding, health states and reseed interval are shared with the Hash_DRBG
+ * above. The working state is the AES key and the next counter block, which
+ * is kept in the Aes register so generate is a single AES-CTR pass. */
+
+#define CTR_DRBG_KEY_LEN   32
+#define CTR_DRBG_SEED_LEN  (CTR_DRBG_KEY_LEN + AES_BLOCK_SIZE)
+/* largest seed material passed to the derivation function */
+#define CTR_DRBG_MAX_DF_IN (MAX_SEED_SZ + SEED_SZ)
+
+#if defined(NO_AES) || !defined(WOLFSSL_AES_COUNTER) || \
+    !defined(WOLFSSL_AES_256) || !defined(HAVE_AES_CBC)
+    #error "CTR DRBG requires AES-256 with CTR and CBC modes"
+#endif
+#if defined(WOLFSSL_NO_MALLOC) && !defined(WOLFSSL_STATIC_MEMORY)
+    #error "CTR DRBG requires dynamic or static memory"
+#endif
+
+typedef struct CTR_DRBG {
+    Aes    aes;                    /* keyed with key, reg holds V + 1 */
+    byte   key[CTR_DRBG_KEY_LEN];
+    word32 reseedCtr;
+} CTR_DRBG;
+
+static int Ctr_DRBG_HealthTestLocal(void);
+
+/* Increment a big endian counter block */
+static WC_INLINE void Ctr_DRBG_IncV(byte* v)
+{
+    int i;
+    for (i = AES_BLOCK_SIZE - 1; i >= 0; i--) {
+        if (++v[i])
+            return;
+    }
+}
+
+/* Block_Cipher_df, out is CTR_DRBG_SEED_LEN bytes of inA || inB
+ * Returns: DRBG_SUCCESS or DRBG_FAILURE */
+static int Ctr_DRBG_df(Aes* aes, byte* out, const byte* inA, word32 inASz,
+                                              const byte* inB, word32 inBSz)
+{
+    static const byte dfKey[CTR_DRBG_KEY_LEN] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    };
+    /* IV || L || N || input || 0x80 || padding */
+    byte   s[AES_BLOCK_SIZE + 8 + CTR_DRBG_MAX_DF_IN + AES_BLOCK_SIZE];
+    byte   mac[AES_BLOCK_SIZE];
+    word32 inSz = inASz + inBSz;
+    word32 sSz, i, j;
+    int    ret = 0;
+
+    if (inSz > CTR_DRBG_MAX_DF_IN)
+        return DRBG_FAILURE;
+
+    XMEMSET(s, 0, sizeof(s));
+    c32toa(inSz, s + AES_BLOCK_SIZE);
+    c32toa(CTR_DRBG_SEED_LEN, s + AES_BLOCK_SIZE + 4);
+    XMEMCPY(s + AES_BLOCK_SIZE + 8, inA, inASz);
+    if (inBSz > 0)
+        XMEMCPY(s + AES_BLOCK_SIZE + 8 + inASz, inB, inBSz);
+    s[AES_BLOCK_SIZE + 8 + inSz] = 0x80;
+    sSz = AES_BLOCK_SIZE + 8 + inSz + 1;
+    sSz += (AES_BLOCK_SIZE - (sSz % AES_BLOCK_SIZE)) % AES_BLOCK_SIZE;
+
+    /* BCC over IV || S with the fixed key, one output block per IV */
+    ret = wc_AesSetKey(aes, dfKey, CTR_DRBG_KEY_LEN, NULL, AES_ENCRYPTION);
+    for (i = 0; ret == 0 && i < CTR_DRBG_SEED_LEN / AES_BLOCK_SIZE; i++) {
+        c32toa(i, s);
+        ret = wc_AesSetIV(aes, NULL);
+        for (j = 0; ret == 0 && j < sSz; j += AES_BLOCK_SIZE)
+            ret = wc_AesCbcEncrypt(aes, mac, s + j, AES_BLOCK_SIZE);
+        if (ret == 0)
+            XMEMCPY(out + i * AES_BLOCK_SIZE, mac, AES_BLOCK_SIZE);
+    }
+
+    /* K = leftmost key bytes, X = next block, out = E(K, X) chained */
+    if (ret == 0) {
+        ret = wc_AesSetKey(aes, out, CTR_DRBG_KEY_LEN, NULL, AES_ENCRYPTION);
+        XMEMCPY(mac, out + CTR_DRBG_KEY_LEN, AES_BLOCK_SIZE);
+    }
+    for (i = 0; ret == 0 && i < CTR_DRBG_SEED_LEN; i += AES_BLOCK_SIZE) {
+        ret = wc_AesSetIV(aes, NULL);
+        if (ret == 0)
+            ret = wc_AesCbcEncrypt(aes, mac, mac, AES_BLOCK_SIZE);
+        if (ret == 0)
+            XMEMCPY(out + i, mac, AES_BLOCK_SIZE);
+    }
+
+    ForceZero(s, sizeof(s));
+    ForceZero(mac, sizeof(mac));
+
+    return (ret == 0) ? DRBG_SUCCESS : DRBG_FAILURE;
+}
+
+/* CTR_DRBG_Update, data is CTR_DRBG_SEED_LEN bytes or NULL for zeros
+ * Returns: DRBG_SUCCESS or DRBG_FAILURE */
+static int Ctr_DRBG_Update(CTR_DRBG* drbg, const byte* data)
+{
+    byte temp[CTR_DRBG_SEED_LEN];
+    int  ret;
+
+    XMEMSET(temp, 0, sizeof(temp));
+    drbg->aes.left = 0;
+    ret = wc_AesCtrEncrypt(&drbg->aes, temp, temp, sizeof(temp));
+    if (ret == 0 && data != NULL)
+        xorbuf(temp, data, sizeof(temp));
+    if (ret == 0) {
+        /* new V is the last block, the register holds V + 1 */
+        Ctr_DRBG_IncV(temp + CTR_DRBG_KEY_LEN);
+        XMEMCPY(drbg->key, temp, CTR_DRBG_KEY_LEN);
+        ret = wc_AesSetKey(&drbg->aes, drbg->key, CTR_DRBG_KEY_LEN,
+                           temp + CTR_DRBG_KEY_LEN, AES_ENCRYPTION);
+    }
+    ForceZero(temp, sizeof(temp));
+
+    return (ret == 0) ? DRBG_SUCCESS : DRBG_FAILURE;
+}
+
+/* Returns: DRBG_SUCCESS or DRBG_FAILURE */
+static int Ctr_DRBG_Instantiate(CTR_DRBG* drbg, const byte* seed,
+                                word32 seedSz, const byte* nonce,
+                                word32 nonceSz, void* heap, int devId)
+{
+    byte iv[AES_BLOCK_SIZE];
+    byte seedMaterial[CTR_DRBG_SEED_LEN];
+    int  ret;
+
+    XMEMSET(drbg, 0, sizeof(CTR_DRBG));
+    ret = wc_AesInit(&drbg->aes, heap, devId);
+    if (ret == 0) {
+        ret = Ctr_DRBG_df(&drbg->aes, seedMaterial, seed, seedSz,
+                          nonce, nonceSz);
+    }
+    if (ret == DRBG_SUCCESS) {
+        /* Key = 0, V = 0 */
+        XMEMSET(iv, 0, sizeof(iv));
+        Ctr_DRBG_IncV(iv);
+        if (wc_AesSetKey(&drbg->aes, drbg->key, CTR_DRBG_KEY_LEN, iv,
+                                                       AES_ENCRYPTION) != 0)
+            ret = DRBG_FAILURE;
+    }
+    if (ret == DRBG_SUCCESS)
+        ret = Ctr_DRBG_Update(drbg, seedMaterial);
+    if (ret == DRBG_SUCCESS)
+        drbg->reseedCtr = 1;
+    ForceZero(seedMaterial, sizeof(seedMaterial));
+
+    return (ret == DRBG_SUCCESS) ? DRBG_SUCCESS : DRBG_FAILURE;
+}
+
+/* Returns: DRBG_SUCCESS or DRBG_FAILURE */
+static int Ctr_DRBG_Reseed(CTR_DRBG* drbg, const byte* seed, word32 seedSz)
+{
+    byte seedMaterial[CTR_DRBG_SEED_LEN];
+    byte v[AES_BLOCK_SIZE];
+    int  ret;
+
+    /* the derivation function rekeys the Aes, restore Key and V after */
+    XMEMCPY(v, drbg->aes.reg, AES_BLOCK_SIZE);
+    ret = Ctr_DRBG_df(&drbg->aes, seedMaterial, seed, seedSz, NULL, 0);
+    if (ret == DRBG_SUCCESS) {
+        if (wc_AesSetKey(&drbg->aes, drbg->key, CTR_DRBG_KEY_LEN, v,
+                                                       AES_ENCRYPTION) != 0)
+            ret = DRBG_FAILURE;
+    }
+    if (ret == DRBG_SUCCESS)
+        ret = Ctr_DRBG_Update(drbg, seedMaterial);
+    if (ret == DRBG_SUCCESS)
+        drbg->reseedCtr = 1;
+    ForceZero(seedMaterial, sizeof(seedMaterial));
+    ForceZero(v, sizeof(v));
+
+    return ret;
+}
+
+/* Returns: DRBG_SUCCESS, DRBG_NEED_RESEED or DRBG_FAILURE */
+static int Ctr_DRBG_Generate(CTR_DRBG* drbg, byte* out, word32 outSz)
+{
+    if (drbg->reseedCtr == RESEED_INTERVAL)
+        return DRBG_NEED_RESEED;
+
+    XMEMSET(out, 0, outSz);
+    drbg->aes.left = 0;
+    if (wc_AesCtrEncrypt(&drbg->aes, out, out, outSz) != 0)
+        return DRBG_FAILURE;
+    if (Ctr_DRBG_Update(drbg, NULL) != DRBG_SUCCESS)
+        return DRBG_FAILURE;
+    drbg->reseedCtr++;
+
+    return DRBG_SUCCESS;
+}
+
+/* Returns: DRBG_SUCCESS or DRBG_FAILURE */
+static int Ctr_DRBG_Uninstantiate(CTR_DRBG* drbg)
+{
+    wc_AesFree(&drbg->aes);
+    ForceZero(drbg, sizeof(CTR_DRBG));
+
+    return DRBG_SUCCESS;
+}
+#endif /* HAVE_CTRDRBG */
+
+
+/* Run the known answer test for the mechanism of an RNG being instantiated
+ * Returns 0 on success */
+static int wc_RNG_HealthTestInit(int drbgType, int threadLocal)
+{
+    (void)drbgType;
+    (void)threadLocal;
+
+#ifdef HAVE_CTRDRBG
+    if (drbgType == WC_DRBG_CTR)
+        return Ctr_DRBG_HealthTestLocal();
+#endif
+#ifdef WOLFSSL_THREAD_LOCAL_RNG
+    /* the thread's parent DRBG was health tested when it was instantiated */
+    if (threadLocal)
+        return 0;
+#endif
+
+    return wc_RNG_HealthTestLocal(0);
+}
+
+/* Returns: DRBG_SUCCESS, DRBG_NEED_RESEED or DRBG_FAILURE */
+static int wc_RNG_DrbgGenerate(WC_RNG* rng, byte* out, word32 outSz)
+{
+#ifdef HAVE_CTRDRBG
+    if (rng->ctrDrbg != NULL)
+        return Ctr_DRBG_Generate(rng->ctrDrbg, out, outSz);
+#endif
+    return Hash_DRBG_Generate(rng->drbg, out, outSz);
+}
+
+/* Returns: DRBG_SUCCESS or DRBG_FAILURE */
+static int wc_RNG_DrbgReseed(WC_RNG* rng, const byte* seed, word32 seedSz)
+{
+#ifdef HAVE_CTRDRBG
+    if (rng->ctrDrbg != NULL) {
+        if (Ctr_DRBG_HealthTestLocal() != 0)
+            return DRBG_CONT_FAILURE;
+        return Ctr_DRBG_Reseed(rng->ctrDrbg, seed, seedSz);
+    }
+#endif
+    return Hash_DRBG_Reseed(rng->drbg, seed, seedSz);
+}
 #endif /* HAVE_HASHDRBG */
 /* End NIST DRBG Code */
 
 
 static int _InitRng(WC_RNG* rng, byte* nonce, word32 nonceSz,
-                    void* heap, int devId)
+                    void* heap, int devId, int drbgType, int threadLocal)
 {
     int ret = RNG_FAILURE_E;
 #ifdef HAVE_HASHDRBG
@@ -707,11 +1072,20 @@ static int _InitRng(WC_RNG* rng, byte* nonce, word32 nonceSz,
 
     (void)nonce;
     (void)nonceSz;
+    (void)drbgType;
+    (void)threadLocal;
 
     if (rng == NULL)
         return BAD_FUNC_ARG;
     if (nonce == NULL && nonceSz != 0)
         return BAD_FUNC_ARG;
+    if (drbgType != WC_DRBG_HASH
+    #ifdef HAVE_CTRDRBG
+        && drbgType != WC_DRBG_CTR
+    #endif
+        ) {
+        return BAD_FUNC_ARG;
+    }
 
 #ifdef WOLFSSL_HEAP_TEST
     rng->heap = (void*)WOLFSSL_HEAP_TEST;
@@ -731,6 +1105,9 @@ static int _InitRng(WC_RNG* rng, byte* nonce, word32 nonceSz,
 #ifdef HAVE_HASHDRBG
     /* init the DBRG to known values */
     rng->drbg = NULL;
+#ifdef HAVE_CTRDRBG
+    rng->ctrDrbg = NULL;
+#endif
     rng->status = DRBG_NOT_INIT;
 #endif
 
@@ -760,7 +1137,7 @@ static int _InitRng(WC_RNG* rng, byte* nonce, word32 nonceSz,
     if (nonceSz == 0)
         seedSz = MAX_SEED_SZ;
 
-    if (wc_RNG_HealthTestLocal(0) == 0) {
+    if (wc_RNG_HealthTestInit(drbgType, threadLocal) == 0) {
     #ifdef WC_ASYNC_ENABLE_SHA256
         DECLARE_VAR(seed, byte, MAX_SEED_SZ, rng->heap);
         if (seed == NULL)
@@ -769,6 +1146,13 @@ static int _InitRng(WC_RNG* rng, byte* nonce, word32 nonceSz,
         byte seed[MAX_SEED_SZ];
     #endif
 
+#ifdef HAVE_CTRDRBG
+        if (drbgType == WC_DRBG_CTR) {
+            rng->ctrDrbg = (struct CTR_DRBG*)XMALLOC(sizeof(CTR_DRBG),
+                                                rng->heap, DYNAMIC_TYPE_RNG);
+        }
+        else
+#endif
 #if !defined(WOLFSSL_NO_MALLOC) || defined(WOLFSSL_STATIC_MEMORY)
         rng->drbg =
                 (struct DRBG*)XMALLOC(sizeof(DRBG), rng->heap,
@@ -781,22 +1165,50 @@ static int _InitRng(WC_RNG* rng, byte* nonce, word32 nonceSz,
         rng->drbg = (struct DRBG*)rng->drbg_data;
 #endif
 
-        if (rng->drbg == NULL) {
+        if (rng->drbg == NULL
+        #ifdef HAVE_CTRDRBG
+            && rng->ctrDrbg == NULL
+        #endif
+            ) {
             ret = MEMORY_E;
         }
         else {
-            ret = wc_GenerateSeed(&rng->seed, seed, seedSz);
-            if (ret != 0)
-                ret = DRBG_FAILURE;
+        #ifdef WOLFSSL_THREAD_LOCAL_RNG
+            if (threadLocal) {
+                /* seed from the thread's parent DRBG, not the OS */
+                ret = ThreadDrbg_GenerateSeed(&rng->seed, seed, seedSz);
+            }
             else
+        #endif
+            {
+                ret = wc_GenerateSeed(&rng->seed, seed, seedSz);
+                if (ret != 0)
+                    ret = DRBG_FAILURE;
+            }
+            if (ret == DRBG_SUCCESS)
                 ret = wc_RNG_TestSeed(seed, seedSz);
 
+        #ifdef HAVE_CTRDRBG
+            if (ret == DRBG_SUCCESS && rng->ctrDrbg != NULL) {
+                ret = Ctr_DRBG_Instantiate(rng->ctrDrbg,
+                            seed + SEED_BLOCK_SZ, seedSz - SEED_BLOCK_SZ,
+                            nonce, nonceSz, rng->heap, devId);
+            }
+            else
+        #endif
             if (ret == DRBG_SUCCESS)
                  ret = Hash_DRBG_Instantiate(rng->drbg,
                             seed + SEED_BLOCK_SZ, seedSz - SEED_BLOCK_SZ,
                             nonce, nonceSz, rng->heap, devId);
 
             if (ret != DRBG_SUCCESS) {
+            #ifdef HAVE_CTRDRBG
+                if (rng->ctrDrbg != NULL) {
+                    Ctr_DRBG_Uninstantiate(rng->ctrDrbg);
+                    XFREE(rng->ctrDrbg, rng->heap, DYNAMIC_TYPE_RNG);
+                    rng->ctrDrbg = NULL;
+                }
+            #endif
             #if !defined(WOLFSSL_NO_MALLOC) || defined(WOLFSSL_STATIC_MEMORY)
                 XFREE(rng->drbg, rng->heap, DYNAMIC_TYPE_RNG);
             #endif
@@ -841,7 +1253,8 @@ WC_RNG* wc_rng_new(byte* nonce, word32 nonceSz, void* heap)
 
     rng = (WC_RNG*)XMALLOC(sizeof(WC_RNG), heap, DYNAMIC_TYPE_RNG);
     if (rng) {
-        int error = _InitRng(rng, nonce, nonceSz, heap, INVALID_DEVID) != 0;
+        int error = _InitRng(rng, nonce, nonceSz, heap, INVALID_DEVID,
+                             WC_DRBG_HASH, 0) != 0;
         if (error) {
             XFREE(rng, heap, DYNAMIC_TYPE_RNG);
             rng = NULL;
@@ -868,29 +1281,101 @@ void wc_rng_free(WC_RNG* rng)
 
 int wc_InitRng(WC_RNG* rng)
 {
-    return _InitRng(rng, NULL, 0, NULL, INVALID_DEVID);
+    return _InitRng(rng, NULL, 0, NULL, INVALID_DEVID, WC_DRBG_HASH, 0);
 }
 
 
 int wc_InitRng_ex(WC_RNG* rng, void* heap, int devId)
 {
-    return _InitRng(rng, NULL, 0, heap, devId);
+    return _InitRng(rng, NULL, 0, heap, devId, WC_DRBG_HASH, 0);
 }
 
 
 int wc_InitRngNonce(WC_RNG* rng, byte* nonce, word32 nonceSz)
 {
-    return _InitRng(rng, nonce, nonceSz, NULL, INVALID_DEVID);
+    return _InitRng(rng, nonce, nonceSz, NULL, INVALID_DEVID, WC_DRBG_HASH,
+                    0);
 }
 
 
 int wc_InitRngNonce_ex(WC_RNG* rng, byte* nonce, word32 nonceSz,
                        void* heap, int devId)
 {
-    return _InitRng(rng, nonce, nonceSz, heap, devId);
+    return _InitRng(rng, nonce, nonceSz, heap, devId, WC_DRBG_HASH, 0);
+}
+
+
+/* Initialize rng with the DRBG mechanism drbgType, WC_DRBG_HASH or
+ * WC_DRBG_CTR when built with HAVE_CTRDRBG */
+int wc_InitRngType_ex(WC_RNG* rng, int drbgType, void* heap, int devId)
+{
+    return _InitRng(rng, NULL, 0, heap, devId, drbgType, 0);
+}
+
+
+#ifdef WOLFSSL_THREAD_LOCAL_RNG
+/* Initialize rng with a seed drawn from the calling thread's parent DRBG
+ * instead of the OS. The rng is independent of the parent once
+ * initialized and may be used from any thread. */
+int wc_InitRng_ThreadLocal(WC_RNG* rng, void* heap, int devId)
+{
+    return _InitRng(rng, NULL, 0, heap, devId, WC_DRBG_HASH, 1);
+}
+
+
+/* Uninstantiate the calling thread's parent DRBG. Threads that created RNGs
+ * with wc_InitRng_ThreadLocal should call this before exiting. */
+void wc_RNG_ThreadLocalFree(void)
+{
+#if defined(HAVE_HASHDRBG) && !defined(CUSTOM_RAND_GENERATE_BLOCK)
+#ifndef HAVE_THREAD_LS
+    if (initThreadRngMutex == 0) { /* extra sanity check if wolfCrypt_Init
+                                      not called */
+        wc_InitMutex(&thread_rng_lock);
+        initThreadRngMutex = 1;
+    }
+
+    if (wc_LockMutex(&thread_rng_lock) != 0)
+        return;
+#endif
+
+    if (threadDrbgStatus != DRBG_NOT_INIT) {
+        Hash_DRBG_Uninstantiate(&threadDrbg);
+        threadDrbgStatus = DRBG_NOT_INIT;
+    }
+
+#ifndef HAVE_THREAD_LS
+    wc_UnLockMutex(&thread_rng_lock);
+#endif
+#endif /* HAVE_HASHDRBG && !CUSTOM_RAND_GENERATE_BLOCK */
 }
 
 
+void wc_RNG_ThreadLocalInit(void)
+{
+#if defined(HAVE_HASHDRBG) && !defined(CUSTOM_RAND_GENERATE_BLOCK) && \
+    !defined(HAVE_THREAD_LS)
+    if (initThreadRngMutex == 0) {
+        wc_InitMutex(&thread_rng_lock);
+        initThreadRngMutex = 1;
+    }
+#endif
+}
+
+
+void wc_RNG_ThreadLocalCleanup(void)
+{
+#if defined(HAVE_HASHDRBG) && !defined(CUSTOM_RAND_GENERATE_BLOCK) && \
+    !defined(HAVE_THREAD_LS)
+    if (initThreadRngMutex != 0) {
+        wc_FreeMutex(&thread_rng_lock);
+        initThreadRngMutex = 0;
+    }
+#endif
+}
+#endif /* WOLFSSL_THREAD_LOCAL_RNG */
+
+
 /* place a generated block in output */
 WOLFSSL_ABI
 int wc_RNG_GenerateBlock(WC_RNG* rng, byte* output, word32 sz)
@@ -939,7 +1424,7 @@ int wc_RNG_GenerateBlock(WC_RNG* rng, byte* output, word32 sz)
     if (rng->status != DRBG_OK)
         return RNG_FAILURE_E;
 
-    ret = Hash_DRBG_Generate(rng->drbg, output, sz);
+    ret = wc_RNG_DrbgGenerate(rng, output, sz);
     if (ret == DRBG_NEED_RESEED) {
         if (wc_RNG_HealthTestLocal(1) == 0) {
             byte newSeed[SEED_SZ + SEED_BLOCK_SZ];
@@ -952,10 +1437,10 @@ int wc_RNG_GenerateBlock(WC_RNG* rng, byte* output, word32 sz)
                 ret = wc_RNG_TestSeed(newSeed, SEED_SZ + SEED_BLOCK_SZ);
 
             if (ret == DRBG_SUCCESS)
-                ret = Hash_DRBG_Reseed(rng->drbg, newSeed + SEED_BLOCK_SZ,
-                                       SEED_SZ);
+                ret = wc_RNG_DrbgReseed(rng, newSeed + SEED_BLOCK_SZ,
+                                        SEED_SZ);
             if (ret == DRBG_SUCCESS)
-                ret = Hash_DRBG_Generate(rng->drbg, output, sz);
+                ret = wc_RNG_DrbgGenerate(rng, output, sz);
 
             ForceZero(newSeed, sizeof(newSeed));
         }
@@ -1013,6 +1498,13 @@ int wc_FreeRng(WC_RNG* rng)
     #endif
         rng->drbg = NULL;
     }
+#ifdef HAVE_CTRDRBG
+    if (rng->ctrDrbg != NULL) {
+        Ctr_DRBG_Uninstantiate(rng->ctrDrbg);
+        XFREE(rng->ctrDrbg, rng->heap, DYNAMIC_TYPE_RNG);
+        rng->ctrDrbg = NULL;
+    }
+#endif
 
     rng->status = DRBG_NOT_INIT;
 #endif /* HAVE_HASHDRBG */
@@ -1219,6 +1711,149 @@ static int wc_RNG_HealthTestLocal(int reseed)
     return ret;
 }
 
+
+#ifdef HAVE_CTRDRBG
+int wc_RNG_CtrHealthTest_ex(int reseed, const byte* nonce, word32 nonceSz,
+                                  const byte* entropyA, word32 entropyASz,
+                                  const byte* entropyB, word32 entropyBSz,
+                                  byte* output, word32 outputSz,
+                                  void* heap, int devId)
+{
+    int ret = -1;
+    CTR_DRBG* drbg;
+#ifndef WOLFSSL_SMALL_STACK
+    CTR_DRBG  drbg_var;
+#endif
+
+    if (entropyA == NULL || output == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (reseed != 0 && entropyB == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (outputSz > RNG_MAX_BLOCK_LEN) {
+        return ret;
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    drbg = (CTR_DRBG*)XMALLOC(sizeof(CTR_DRBG), NULL, DYNAMIC_TYPE_RNG);
+    if (drbg == NULL) {
+        return MEMORY_E;
+    }
+#else
+    drbg = &drbg_var;
+#endif
+
+    if (Ctr_DRBG_Instantiate(drbg, entropyA, entropyASz, nonce, nonceSz,
+                             heap, devId) != 0) {
+        goto exit_rng_ht;
+    }
+
+    if (reseed) {
+        if (Ctr_DRBG_Reseed(drbg, entropyB, entropyBSz) != 0) {
+            goto exit_rng_ht;
+        }
+    }
+
+    /* As with the Hash_DRBG test, the first block is thrown away and the
+     * second is checked against the known answer. */
+    if (Ctr_DRBG_Generate(drbg, output, outputSz) != 0) {
+        goto exit_rng_ht;
+    }
+
+    if (Ctr_DRBG_Generate(drbg, output, outputSz) != 0) {
+        goto exit_rng_ht;
+    }
+
+    /* Mark success */
+    ret = 0;
+
+exit_rng_ht:
+
+    Ctr_DRBG_Uninstantiate(drbg);
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(drbg, NULL, DYNAMIC_TYPE_RNG);
+#endif
+
+    return ret;
+}
+
+
+/* NIST CAVP CTR_DRBG AES-256 use df, no reseed, COUNT 0 */
+static const byte ctrSeedA[] = {
+    0x36, 0x40, 0x19, 0x40, 0xfa, 0x8b, 0x1f, 0xba,
+    0x91, 0xa1, 0x66, 0x1f, 0x21, 0x1d, 0x78, 0xa0,
+    0xb9, 0x38, 0x9a, 0x74, 0xe5, 0xbc, 0xcf, 0xec,
+    0xe8, 0xd7, 0x66, 0xaf, 0x1a, 0x6d, 0x3b, 0x14
+};
+
+static const byte ctrNonceA[] = {
+    0x49, 0x6f, 0x25, 0xb0, 0xf1, 0x30, 0x1b, 0x4f,
+    0x50, 0x1b, 0xe3, 0x03, 0x80, 0xa1, 0x37, 0xeb
+};
+
+static const byte ctrOutputA[] = {
+    0x58, 0x62, 0xeb, 0x38, 0xbd, 0x55, 0x8d, 0xd9,
+    0x78, 0xa6, 0x96, 0xe6, 0xdf, 0x16, 0x47, 0x82,
+    0xdd, 0xd8, 0x87, 0xe7, 0xe9, 0xa6, 0xc9, 0xf3,
+    0xf1, 0xfb, 0xaf, 0xb7, 0x89, 0x41, 0xb5, 0x35,
+    0xa6, 0x49, 0x12, 0xdf, 0xd2, 0x24, 0xc6, 0xdc,
+    0x74, 0x54, 0xe5, 0x25, 0x0b, 0x3d, 0x97, 0x16,
+    0x5e, 0x16, 0x26, 0x0c, 0x2f, 0xaf, 0x1c, 0xc7,
+    0x73, 0x5c, 0xb7, 0x5f, 0xb4, 0xf0, 0x7e, 0x1d
+};
+
+static const byte ctrReseedSeedA[] = {
+    0xe6, 0x2b, 0x8a, 0x8e, 0xe8, 0xf1, 0x41, 0xb6,
+    0x98, 0x05, 0x66, 0xe3, 0xbf, 0xe3, 0xc0, 0x49,
+    0x03, 0xda, 0xd4, 0xac, 0x2c, 0xdf, 0x9f, 0x22,
+    0x80, 0x01, 0x0a, 0x67, 0x39, 0xbc, 0x83, 0xd3
+};
+
+/* ctrSeedA and ctrNonceA reseeded with ctrReseedSeedA */
+static const byte ctrOutputB[] = {
+    0xd6, 0x2a, 0x0d, 0xe8, 0xf3, 0x8e, 0x71, 0x1c,
+    0xc8, 0x93, 0x7f, 0x9f, 0xc1, 0x53, 0x8f, 0xf0,
+    0xe7, 0x79, 0xcc, 0x68, 0x20, 0xf5, 0x62, 0xbe,
+    0xea, 0x20, 0x33, 0xe4, 0xd1, 0x7f, 0x6e, 0xff,
+    0x12, 0x98, 0x27, 0xb6, 0x08, 0xad, 0x31, 0xac,
+    0xbe, 0x4f, 0x03, 0x04, 0xd2, 0xe7, 0xe4, 0xd2,
+    0x46, 0x31, 0x9e, 0x19, 0x45, 0x6f, 0x16, 0xb3,
+    0x01, 0x65, 0x70, 0x03, 0xdd, 0xb4, 0x5b, 0xf9
+};
+
+
+static int Ctr_DRBG_HealthTestLocal(void)
+{
+    int ret;
+    byte check[sizeof(ctrOutputA)];
+
+    ret = wc_RNG_CtrHealthTest_ex(0, ctrNonceA, sizeof(ctrNonceA),
+                                  ctrSeedA, sizeof(ctrSeedA), NULL, 0,
+                                  check, sizeof(check), NULL, INVALID_DEVID);
+    if (ret == 0) {
+        if (ConstantCompare(check, ctrOutputA, sizeof(ctrOutputA)) != 0)
+            ret = -1;
+    }
+    if (ret == 0) {
+        ret = wc_RNG_CtrHealthTest_ex(1, ctrNonceA, sizeof(ctrNonceA),
+                                  ctrSeedA, sizeof(ctrSeedA),
+                                  ctrReseedSeedA, sizeof(ctrReseedSeedA),
+                                  check, sizeof(check), NULL, INVALID_DEVID);
+    }
+    if (ret == 0) {
+        if (ConstantCompare(check, ctrOutputB, sizeof(ctrOutputB)) != 0)
+            ret = -1;
+    }
+    ForceZero(check, sizeof(check));
+
+    return ret;
+}
+#endif /* HAVE_CTRDRBG */
+
 #endif /* HAVE_HASHDRBG */
 
 
@@ -62,6 +62,12 @@ Possible RSA enable options:
  * WC_RSA_NONBLOCK:     Enables support for RSA non-blocking        default: off
  * WC_RSA_NONBLOCK_TIME:Enables support for time based blocking     default: off
  *                      time calculation.
+ * WC_RSA_PRECOMPUTE:   Enables wc_RsaPrecompute() to cache the     default: off
+ *                      Montgomery constants of p and q and a blinding
+ *                      pair that is refreshed by squaring. TLS keeps the
+ *                      CTX private key decoded and precomputed.
+ * WC_RSA_BLIND_REGEN_CNT: Private ops before a cached blinding pair is
+ *                      replaced with a fresh random one.       default: 1024
 */
 
 /*
@@ -317,6 +323,23 @@ int wc_InitRsaKey_ex(RsaKey* key, void* heap, int devId)
     }
 #endif
 
+#if defined(WC_RSA_PRECOMPUTE) && !defined(WOLFSSL_RSA_PUBLIC_ONLY)
+    key->precomputed = 0;
+#ifdef WC_RSA_PRECOMPUTE_MONT
+    ret = mp_init_multi(&key->pR2, &key->qR2, NULL, NULL, NULL, NULL);
+#endif
+#ifdef WC_RSA_BLINDING
+    if (ret == MP_OKAY)
+        ret = mp_init_multi(&key->blind, &key->blindInv, NULL, NULL, NULL,
+                                                                          NULL);
+    key->blindCnt = 0;
+#endif
+    if (ret != MP_OKAY) {
+        wc_FreeRsaKey(key);
+        return ret;
+    }
+#endif
+
 #ifdef WOLFSSL_XILINX_CRYPT
     key->pubExp = 0;
     key->mod    = NULL;
@@ -543,6 +566,20 @@ int wc_FreeRsaKey(RsaKey* key)
     mp_clear(&key->q);
     mp_clear(&key->p);
     mp_clear(&key->d);
+
+#ifdef WC_RSA_PRECOMPUTE
+    key->precomputed = 0;
+#ifdef WC_RSA_PRECOMPUTE_MONT
+    mp_clear(&key->qR2);
+    mp_clear(&key->pR2);
+#endif
+#ifdef WC_RSA_BLINDING
+    mp_forcezero(&key->blindInv);
+    mp_forcezero(&key->blind);
+    mp_clear(&key->blindInv);
+    mp_clear(&key->blind);
+#endif
+#endif /* WC_RSA_PRECOMPUTE */
 #endif /* WOLFSSL_RSA_PUBLIC_ONLY */
 
     /* public part */
@@ -2043,6 +2080,177 @@ done:
 }
 
 #else
+#if defined(WC_RSA_PRECOMPUTE) && !defined(WOLFSSL_RSA_PUBLIC_ONLY)
+#if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG) && \
+    !defined(WOLFSSL_SP_MATH)
+#ifndef WC_RSA_BLIND_REGEN_CNT
+    #define WC_RSA_BLIND_REGEN_CNT 1024
+#endif
+
+/* Generate a new random blinding pair into the key.
+ * blind = r^e mod n and blindInv = 1/r mod n
+ */
+static int RsaBlindGen(RsaKey* key, WC_RNG* rng)
+{
+    int ret;
+
+    ret = mp_rand(&key->blindInv, get_digit_count(&key->n), rng);
+
+    /* blind = r^e */
+    if (ret == 0 && mp_exptmod(&key->blindInv, &key->e, &key->n,
+                                                      &key->blind) != MP_OKAY)
+        ret = MP_EXPTMOD_E;
+
+    /* blindInv = 1/r mod n */
+    if (ret == 0 && mp_invmod(&key->blindInv, &key->n,
+                                                   &key->blindInv) != MP_OKAY)
+        ret = MP_INVMOD_E;
+
+    if (ret == 0)
+        key->blindCnt = 0;
+
+    return ret;
+}
+
+/* Take the cached blinding pair for this operation and advance the cache by
+ * squaring both values, since (r^2)^e = (r^e)^2. The pair is replaced with a
+ * fresh random one every WC_RSA_BLIND_REGEN_CNT uses.
+ */
+static int RsaBlindNext(RsaKey* key, WC_RNG* rng, mp_int* rnd, mp_int* rndi)
+{
+    int ret = 0;
+
+    if (key->blindCnt >= WC_RSA_BLIND_REGEN_CNT)
+        ret = RsaBlindGen(key, rng);
+
+    if (ret == 0 && mp_copy(&key->blind, rnd) != MP_OKAY)
+        ret = MP_READ_E;
+    if (ret == 0 && mp_copy(&key->blindInv, rndi) != MP_OKAY)
+        ret = MP_READ_E;
+
+    if (ret == 0 && mp_sqrmod(&key->blind, &key->n, &key->blind) != MP_OKAY)
+        ret = MP_MULMOD_E;
+    if (ret == 0 && mp_sqrmod(&key->blindInv, &key->n,
+                                                   &key->blindInv) != MP_OKAY)
+        ret = MP_MULMOD_E;
+
+    if (ret == 0)
+        key->blindCnt++;
+    else
+        key->blindCnt = WC_RSA_BLIND_REGEN_CNT; /* pair no longer trusted */
+
+    return ret;
+}
+#endif /* WC_RSA_BLINDING && !WC_NO_RNG && !WOLFSSL_SP_MATH */
+
+/* Cache the values that every private operation with this key recomputes:
+ * the Montgomery constants of p and q and, with blinding, a blinding pair.
+ * Call after the private key has been loaded. When rng is NULL the blinding
+ * pair is generated by the first private operation.
+ * Only callers that keep the RsaKey for many private operations gain from
+ * this. The TLS layer keeps the CTX private key precomputed and gives each
+ * handshake a copy, see wc_RsaPrecomputeCopy().
+ * The cached blinding pair changes on each private operation, so a key that
+ * has been precomputed must not be used by multiple threads at once.
+ */
+int wc_RsaPrecompute(RsaKey* key, WC_RNG* rng)
+{
+    int ret = 0;
+
+    if (key == NULL || key->type != RSA_PRIVATE) {
+        return BAD_FUNC_ARG;
+    }
+
+    key->precomputed = 0;
+
+#ifdef WC_RSA_PRECOMPUTE_MONT
+    if (mp_exptmod_mont_setup(&key->p, &key->pMp, &key->pR2) != MP_OKAY)
+        ret = MP_EXPTMOD_E;
+    if (ret == 0 &&
+            mp_exptmod_mont_setup(&key->q, &key->qMp, &key->qR2) != MP_OKAY)
+        ret = MP_EXPTMOD_E;
+#endif
+
+#if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG) && \
+    !defined(WOLFSSL_SP_MATH)
+    if (ret == 0) {
+        if (rng != NULL)
+            ret = RsaBlindGen(key, rng);
+        else
+            key->blindCnt = WC_RSA_BLIND_REGEN_CNT;
+    }
+#else
+    (void)rng;
+#endif
+
+    if (ret == 0)
+        key->precomputed = 1;
+
+    return ret;
+}
+
+/* Copy a precomputed private key into the initialized key dst, so that the
+ * key can be decoded and precomputed once and used by many private operations
+ * at the same time, one copy each. dst takes the next blinding pair of src
+ * and replaces it with a fresh random one after its first use, so no pair is
+ * used twice. rng is used when the pair of src is due to be replaced.
+ * Calls with the same src must not run at the same time.
+ */
+int wc_RsaPrecomputeCopy(RsaKey* src, RsaKey* dst, WC_RNG* rng)
+{
+    int ret = 0;
+
+    if (src == NULL || dst == NULL || src->type != RSA_PRIVATE ||
+                                                         !src->precomputed) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (mp_copy(&src->n, &dst->n) != MP_OKAY ||
+        mp_copy(&src->e, &dst->e) != MP_OKAY ||
+        mp_copy(&src->d, &dst->d) != MP_OKAY ||
+        mp_copy(&src->p, &dst->p) != MP_OKAY ||
+        mp_copy(&src->q, &dst->q) != MP_OKAY) {
+        ret = MP_READ_E;
+    }
+#if defined(WOLFSSL_KEY_GEN) || defined(OPENSSL_EXTRA) || !defined(RSA_LOW_MEM)
+    if (ret == 0 && (mp_copy(&src->dP, &dst->dP) != MP_OKAY ||
+                     mp_copy(&src->dQ, &dst->dQ) != MP_OKAY ||
+                     mp_copy(&src->u, &dst->u) != MP_OKAY)) {
+        ret = MP_READ_E;
+    }
+#endif
+#ifdef WC_RSA_PRECOMPUTE_MONT
+    if (ret == 0 && (mp_copy(&src->pR2, &dst->pR2) != MP_OKAY ||
+                     mp_copy(&src->qR2, &dst->qR2) != MP_OKAY)) {
+        ret = MP_READ_E;
+    }
+    dst->pMp = src->pMp;
+    dst->qMp = src->qMp;
+#endif
+
+#if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG) && \
+    !defined(WOLFSSL_SP_MATH)
+    if (ret == 0) {
+        if (src->blindCnt < WC_RSA_BLIND_REGEN_CNT || rng != NULL) {
+            ret = RsaBlindNext(src, rng, &dst->blind, &dst->blindInv);
+            dst->blindCnt = WC_RSA_BLIND_REGEN_CNT - 1;
+        }
+        else
+            dst->blindCnt = WC_RSA_BLIND_REGEN_CNT;
+    }
+#else
+    (void)rng;
+#endif
+
+    if (ret == 0) {
+        dst->type = RSA_PRIVATE;
+        dst->precomputed = 1;
+    }
+
+    return ret;
+}
+#endif /* WC_RSA_PRECOMPUTE && !WOLFSSL_RSA_PUBLIC_ONLY */
+
 static int wc_RsaFunctionSync(const byte* in, word32 inLen, byte* out,
                           word32* outLen, int type, RsaKey* key, WC_RNG* rng)
 {
@@ -2199,16 +2407,26 @@ static int wc_RsaFunctionSync(const byte* in, word32 inLen, byte* out,
         case RSA_PRIVATE_ENCRYPT:
         {
         #if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG)
-            /* blind */
-            ret = mp_rand(rnd, get_digit_count(&key->n), rng);
+        #ifdef WC_RSA_PRECOMPUTE
+            if (key->precomputed) {
+                /* blind with the cached pair */
+                ret = RsaBlindNext(key, rng, rnd, rndi);
+            }
+            else
+        #endif
+            {
+                /* blind */
+                ret = mp_rand(rnd, get_digit_count(&key->n), rng);
 
-            /* rndi = 1/rnd mod n */
-            if (ret == 0 && mp_invmod(rnd, &key->n, rndi) != MP_OKAY)
-                ret = MP_INVMOD_E;
+                /* rndi = 1/rnd mod n */
+                if (ret == 0 && mp_invmod(rnd, &key->n, rndi) != MP_OKAY)
+                    ret = MP_INVMOD_E;
 
-            /* rnd = rnd^e */
-            if (ret == 0 && mp_exptmod(rnd, &key->e, &key->n, rnd) != MP_OKAY)
-                ret = MP_EXPTMOD_E;
+                /* rnd = rnd^e */
+                if (ret == 0 && mp_exptmod(rnd, &key->e, &key->n,
+                                                                rnd) != MP_OKAY)
+                    ret = MP_EXPTMOD_E;
+            }
 
             /* tmp = tmp*rnd mod n */
             if (ret == 0 && mp_mulmod(tmp, rnd, &key->n, tmp) != MP_OKAY)
@@ -2251,15 +2469,31 @@ static int wc_RsaFunctionSync(const byte* in, word32 inLen, byte* out,
                         clearb = 1;
                 }
 
-                /* tmpa = tmp^dP mod p */
-                if (ret == 0 && mp_exptmod(tmp, &key->dP, &key->p,
+            #ifdef WC_RSA_PRECOMPUTE_MONT
+                if (key->precomputed) {
+                    /* tmpa = tmp^dP mod p using cached Montgomery values */
+                    if (ret == 0 && mp_exptmod_mont(tmp, &key->dP, &key->p,
+                                  key->pMp, &key->pR2, tmpa) != MP_OKAY)
+                        ret = MP_EXPTMOD_E;
+
+                    /* tmpb = tmp^dQ mod q using cached Montgomery values */
+                    if (ret == 0 && mp_exptmod_mont(tmp, &key->dQ, &key->q,
+                                  key->qMp, &key->qR2, tmpb) != MP_OKAY)
+                        ret = MP_EXPTMOD_E;
+                }
+                else
+            #endif
+                {
+                    /* tmpa = tmp^dP mod p */
+                    if (ret == 0 && mp_exptmod(tmp, &key->dP, &key->p,
                                                                tmpa) != MP_OKAY)
-                    ret = MP_EXPTMOD_E;
+                        ret = MP_EXPTMOD_E;
 
-                /* tmpb = tmp^dQ mod q */
-                if (ret == 0 && mp_exptmod(tmp, &key->dQ, &key->q,
+                    /* tmpb = tmp^dQ mod q */
+                    if (ret == 0 && mp_exptmod(tmp, &key->dQ, &key->q,
                                                                tmpb) != MP_OKAY)
-                    ret = MP_EXPTMOD_E;
+                        ret = MP_EXPTMOD_E;
+                }
 
                 /* tmp = (tmpa - tmpb) * qInv (mod p) */
                 if (ret == 0 && mp_sub(tmpa, tmpb, tmp) != MP_OKAY)
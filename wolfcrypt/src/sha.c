@@ -43,6 +43,7 @@
 #include <wolfssl/wolfcrypt/sha.h>
 #include <wolfssl/wolfcrypt/error-crypt.h>
 #include <wolfssl/wolfcrypt/hash.h>
+#include <wolfssl/wolfcrypt/cpuid.h>
 
 #ifdef WOLF_CRYPTO_CB
     #include <wolfssl/wolfcrypt/cryptocb.h>
@@ -332,6 +333,10 @@
     /* Software implementation */
     #define USE_SHA_SOFTWARE_IMPL
 
+    #if defined(USE_INTEL_SPEEDUP) && !defined(NO_SHA_NI_SUPPORT)
+        #define HAVE_INTEL_SHA
+    #endif
+
     static int InitSha(wc_Sha* sha)
     {
         int ret = 0;
@@ -365,7 +370,12 @@ static WC_INLINE void AddLength(wc_Sha* sha, word32 len)
 
 /* Check if custom wc_Sha transform is used */
 #ifndef XTRANSFORM
+  #ifdef HAVE_INTEL_SHA
+    #define XTRANSFORM(S,B)       (*Transform_Sha_p)((S),(B))
+    #define XTRANSFORM_LEN(S,B,L) (*Transform_Sha_Len_p)((S),(B),(L))
+  #else
     #define XTRANSFORM(S,B)   Transform((S),(B))
+  #endif
 
     #define blk0(i) (W[i] = *((word32*)&data[i*sizeof(word32)]))
     #define blk1(i) (W[(i)&15] = \
@@ -474,6 +484,38 @@ static WC_INLINE void AddLength(wc_Sha* sha, word32 len)
 
         return 0;
     }
+
+  #ifdef HAVE_INTEL_SHA
+    #ifdef __cplusplus
+    extern "C" {
+    #endif
+    /* Single block takes the words already in host order, the _Len variant
+     * takes the message as is and byte swaps it. */
+    extern int Transform_Sha_SHANI(wc_Sha* sha, const byte* data);
+    extern int Transform_Sha_SHANI_Len(wc_Sha* sha, const byte* data,
+                                       word32 len);
+    #ifdef __cplusplus
+    }  /* extern "C" */
+    #endif
+
+    static int (*Transform_Sha_p)(wc_Sha* sha, const byte* data) = Transform;
+    static int (*Transform_Sha_Len_p)(wc_Sha* sha, const byte* data,
+                                      word32 len) = NULL;
+    static int transform_check = 0;
+
+    static void Sha_SetTransform(void)
+    {
+        if (transform_check)
+            return;
+
+        if (IS_INTEL_SHA(cpuid_get_flags())) {
+            Transform_Sha_p = Transform_Sha_SHANI;
+            Transform_Sha_Len_p = Transform_Sha_SHANI_Len;
+        }
+
+        transform_check = 1;
+    }
+  #endif /* HAVE_INTEL_SHA */
 #endif /* !USE_CUSTOM_SHA_TRANSFORM */
 
 
@@ -498,6 +540,10 @@ int wc_InitSha_ex(wc_Sha* sha, void* heap, int devId)
     if (ret != 0)
         return ret;
 
+#ifdef HAVE_INTEL_SHA
+    Sha_SetTransform();
+#endif
+
 #if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_SHA)
     ret = wolfAsync_DevCtxInit(&sha->asyncDev, WOLFSSL_ASYNC_MARKER_SHA,
                                                             sha->heap, devId);
@@ -586,17 +632,23 @@ int wc_ShaUpdate(wc_Sha* sha, const byte* data, word32 len)
 
     /* process blocks */
 #ifdef XTRANSFORM_LEN
-    /* get number of blocks */
-    /* 64-1 = 0x3F (~ Inverted = 0xFFFFFFC0) */
-    /* len (masked by 0xFFFFFFC0) returns block aligned length */
-    blocksLen = len & ~(WC_SHA_BLOCK_SIZE-1);
-    if (blocksLen > 0) {
-        /* Byte reversal performed in function if required. */
-        XTRANSFORM_LEN(sha, data, blocksLen);
-        data += blocksLen;
-        len  -= blocksLen;
+    #ifdef HAVE_INTEL_SHA
+    if (Transform_Sha_Len_p != NULL)
+    #endif
+    {
+        /* get number of blocks */
+        /* 64-1 = 0x3F (~ Inverted = 0xFFFFFFC0) */
+        /* len (masked by 0xFFFFFFC0) returns block aligned length */
+        blocksLen = len & ~(WC_SHA_BLOCK_SIZE-1);
+        if (blocksLen > 0) {
+            /* Byte reversal performed in function if required. */
+            XTRANSFORM_LEN(sha, data, blocksLen);
+            data += blocksLen;
+            len  -= blocksLen;
+        }
     }
-#else
+#endif
+#if !defined(XTRANSFORM_LEN) || defined(HAVE_INTEL_SHA)
     while (len >= WC_SHA_BLOCK_SIZE) {
         word32* local32 = sha->buffer;
         /* optimization to avoid memcpy if data pointer is properly aligned */
@@ -632,7 +684,7 @@ int wc_ShaUpdate(wc_Sha* sha, const byte* data, word32 len)
         ret = XTRANSFORM(sha, (const byte*)local32);
     #endif
     }
-#endif /* XTRANSFORM_LEN */
+#endif /* !XTRANSFORM_LEN || HAVE_INTEL_SHA */
 
     /* save remainder */
     if (len > 0) {
@@ -157,6 +157,9 @@
     #ifndef NO_AVX2_SUPPORT
         #define HAVE_INTEL_AVX2
     #endif
+    #ifndef NO_SHA_NI_SUPPORT
+        #define HAVE_INTEL_SHA
+    #endif
 #endif /* USE_INTEL_SPEEDUP */
 
 #if defined(HAVE_INTEL_AVX2)
@@ -287,6 +290,11 @@ static int InitSha256(wc_Sha256* sha256)
                                                   const byte* data, word32 len);
         #endif /* HAVE_INTEL_RORX */
     #endif /* HAVE_INTEL_AVX2 */
+    #if defined(HAVE_INTEL_SHA)
+        extern int Transform_Sha256_SHANI(wc_Sha256 *sha256, const byte* data);
+        extern int Transform_Sha256_SHANI_Len(wc_Sha256* sha256,
+                                              const byte* data, word32 len);
+    #endif
 
 #ifdef __cplusplus
     }  /* extern "C" */
@@ -303,6 +311,15 @@ static int InitSha256(wc_Sha256* sha256)
     #define XTRANSFORM(S, D)         (*Transform_Sha256_p)((S),(D))
     #define XTRANSFORM_LEN(S, D, L)  (*Transform_Sha256_Len_p)((S),(D),(L))
 
+    /* The assembly transforms take the message big-endian and byte swap it
+     * themselves; only the C transform needs it reversed up front. */
+    #ifdef HAVE_INTEL_SHA
+        #define SHA256_REV_BYTES(f)  (!IS_INTEL_AVX1(f) && \
+                                      !IS_INTEL_AVX2(f) && !IS_INTEL_SHA(f))
+    #else
+        #define SHA256_REV_BYTES(f)  (!IS_INTEL_AVX1(f) && !IS_INTEL_AVX2(f))
+    #endif
+
     static void Sha256_SetTransform(void)
     {
 
@@ -311,6 +328,13 @@ static int InitSha256(wc_Sha256* sha256)
 
         intel_flags = cpuid_get_flags();
 
+    #ifdef HAVE_INTEL_SHA
+        if (IS_INTEL_SHA(intel_flags)) {
+            Transform_Sha256_p = Transform_Sha256_SHANI;
+            Transform_Sha256_Len_p = Transform_Sha256_SHANI_Len;
+        }
+        else
+    #endif
     #ifdef HAVE_INTEL_AVX2
         if (1 && IS_INTEL_AVX2(intel_flags)) {
         #ifdef HAVE_INTEL_RORX
@@ -939,7 +963,7 @@ static int InitSha256(wc_Sha256* sha256)
             if (sha256->buffLen == WC_SHA256_BLOCK_SIZE) {
             #if defined(LITTLE_ENDIAN_ORDER) && !defined(FREESCALE_MMCAU_SHA)
                 #if defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2)
-                if (!IS_INTEL_AVX1(intel_flags) && !IS_INTEL_AVX2(intel_flags))
+                if (SHA256_REV_BYTES(intel_flags))
                 #endif
                 {
                     ByteReverseWords(sha256->buffer, sha256->buffer,
@@ -1012,7 +1036,7 @@ static int InitSha256(wc_Sha256* sha256)
 
             #if defined(LITTLE_ENDIAN_ORDER) && !defined(FREESCALE_MMCAU_SHA)
                 #if defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2)
-                if (!IS_INTEL_AVX1(intel_flags) && !IS_INTEL_AVX2(intel_flags))
+                if (SHA256_REV_BYTES(intel_flags))
                 #endif
                 {
                     ByteReverseWords(local32, local32, WC_SHA256_BLOCK_SIZE);
@@ -1099,7 +1123,7 @@ static int InitSha256(wc_Sha256* sha256)
 
         #if defined(LITTLE_ENDIAN_ORDER) && !defined(FREESCALE_MMCAU_SHA)
             #if defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2)
-            if (!IS_INTEL_AVX1(intel_flags) && !IS_INTEL_AVX2(intel_flags))
+            if (SHA256_REV_BYTES(intel_flags))
             #endif
             {
                 ByteReverseWords(sha256->buffer, sha256->buffer,
@@ -1136,7 +1160,7 @@ static int InitSha256(wc_Sha256* sha256)
         /* store lengths */
     #if defined(LITTLE_ENDIAN_ORDER) && !defined(FREESCALE_MMCAU_SHA)
         #if defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2)
-        if (!IS_INTEL_AVX1(intel_flags) && !IS_INTEL_AVX2(intel_flags))
+        if (SHA256_REV_BYTES(intel_flags))
         #endif
         {
             ByteReverseWords(sha256->buffer, sha256->buffer,
@@ -1152,7 +1176,7 @@ static int InitSha256(wc_Sha256* sha256)
         defined(HAVE_INTEL_AVX2)
         /* Kinetis requires only these bytes reversed */
         #if defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2)
-        if (IS_INTEL_AVX1(intel_flags) || IS_INTEL_AVX2(intel_flags))
+        if (!SHA256_REV_BYTES(intel_flags))
         #endif
         {
             ByteReverseWords(
@@ -1651,6 +1675,217 @@ int wc_Sha256GetFlags(wc_Sha256* sha256, word32* flags)
     return 0;
 }
 #endif
+
+#ifdef WOLFSSL_SHA256_MULTI_BUFFER
+
+#if defined(HAVE_INTEL_AVX2) || defined(HAVE_INTEL_SHA)
+#ifdef __cplusplus
+    extern "C" {
+#endif
+    #if defined(HAVE_INTEL_AVX2)
+        extern int Transform_Sha256_AVX2_MB8(word32* state, const byte** data);
+    #endif
+    #if defined(HAVE_INTEL_SHA)
+        extern int Transform_Sha256_SHANI_MB2(word32* state, const byte** data);
+    #endif
+#ifdef __cplusplus
+    }  /* extern "C" */
+#endif
+
+/* Transform one block of each of width lanes. state holds the digest words of
+ * each lane, data points to the block of each lane. */
+typedef int (*Sha256MBTransformFunc)(word32* state, const byte** data);
+
+static const word32 sha256_h0[WC_SHA256_DIGEST_SIZE / sizeof(word32)] = {
+    0x6A09E667L, 0xBB67AE85L, 0x3C6EF372L, 0xA54FF53AL,
+    0x510E527FL, 0x9B05688CL, 0x1F83D9ABL, 0x5BE0CD19L
+};
+
+/* Hash up to WC_SHA256_MB_LANES messages side by side, one block of every
+ * lane per round, width lanes per call of the transform. A group of lanes
+ * that has run out of blocks is skipped; a finished lane inside a busy group
+ * hashes a scratch block as its digest has already been taken.
+ */
+static int Sha256_MultiBufferLanes(Sha256MBTransformFunc transform,
+    word32 width, const byte* const* prefix, const byte* const* data,
+    const word32* sz, byte* const* hash, word32 n)
+{
+    word32 state[WC_SHA256_MB_LANES][WC_SHA256_DIGEST_SIZE / sizeof(word32)];
+    byte   tail[WC_SHA256_MB_LANES][2 * WC_SHA256_BLOCK_SIZE];
+    word32 digest[WC_SHA256_DIGEST_SIZE / sizeof(word32)];
+    const byte* block[WC_SHA256_MB_LANES];
+    word32 full[WC_SHA256_MB_LANES];
+    word32 blocks[WC_SHA256_MB_LANES];
+    word32 pre = (prefix != NULL) ? 1 : 0;
+    word32 maxBlocks = 0;
+    word32 i, j, b, g;
+    int    ret = 0;
+
+    XMEMSET(blocks, 0, sizeof(blocks));
+    for (i = 0; i < n; i++) {
+        word32 rem = sz[i] & (WC_SHA256_BLOCK_SIZE - 1);
+        word32 tailSz = (rem < WC_SHA256_PAD_SIZE) ? WC_SHA256_BLOCK_SIZE :
+                                                     2 * WC_SHA256_BLOCK_SIZE;
+        word64 bits = ((word64)sz[i] + pre * WC_SHA256_BLOCK_SIZE) << 3;
+
+        full[i] = sz[i] / WC_SHA256_BLOCK_SIZE;
+        if (rem > 0)
+            XMEMCPY(tail[i], data[i] + full[i] * WC_SHA256_BLOCK_SIZE, rem);
+        tail[i][rem] = 0x80;
+        XMEMSET(&tail[i][rem + 1], 0, tailSz - rem - 1 - 8);
+        for (j = 0; j < 8; j++)
+            tail[i][tailSz - 1 - j] = (byte)(bits >> (8 * j));
+
+        blocks[i] = pre + full[i] + tailSz / WC_SHA256_BLOCK_SIZE;
+        if (blocks[i] > maxBlocks)
+            maxBlocks = blocks[i];
+    }
+
+    for (i = 0; i < WC_SHA256_MB_LANES; i++)
+        XMEMCPY(state[i], sha256_h0, sizeof(sha256_h0));
+
+    for (b = 0; ret == 0 && b < maxBlocks; b++) {
+        for (i = 0; i < WC_SHA256_MB_LANES; i++) {
+            if (b >= blocks[i])
+                block[i] = tail[0];
+            else if (b < pre)
+                block[i] = prefix[i];
+            else if (b - pre < full[i])
+                block[i] = data[i] + (b - pre) * WC_SHA256_BLOCK_SIZE;
+            else
+                block[i] = tail[i] + (b - pre - full[i]) * WC_SHA256_BLOCK_SIZE;
+        }
+
+        for (g = 0; ret == 0 && g < n; g += width) {
+            /* skip a group with no lane left to hash */
+            for (i = g; i < g + width; i++) {
+                if (b < blocks[i])
+                    break;
+            }
+            if (i < g + width)
+                ret = transform(state[g], &block[g]);
+        }
+
+        for (i = 0; i < n; i++) {
+            if (b + 1 != blocks[i])
+                continue;
+            ByteReverseWords(digest, state[i], WC_SHA256_DIGEST_SIZE);
+            XMEMCPY(hash[i], digest, WC_SHA256_DIGEST_SIZE);
+        }
+    }
+
+    /* lanes hold HMAC key state when called with a prefix */
+    ForceZero(state, sizeof(state));
+    ForceZero(tail, sizeof(tail));
+    ForceZero(digest, sizeof(digest));
+
+    return ret;
+}
+#endif /* HAVE_INTEL_AVX2 || HAVE_INTEL_SHA */
+
+/* One message at a time through the regular API. */
+static int Sha256_MultiBufferSerial(const byte* const* prefix,
+    const byte* const* data, const word32* sz, byte* const* hash, word32 n)
+{
+    int ret = 0;
+    word32 i;
+#ifdef WOLFSSL_SMALL_STACK
+    wc_Sha256* sha256;
+#else
+    wc_Sha256  sha256[1];
+#endif
+
+#ifdef WOLFSSL_SMALL_STACK
+    sha256 = (wc_Sha256*)XMALLOC(sizeof(wc_Sha256), NULL,
+                                 DYNAMIC_TYPE_TMP_BUFFER);
+    if (sha256 == NULL)
+        return MEMORY_E;
+#endif
+
+    for (i = 0; ret == 0 && i < n; i++) {
+        ret = wc_InitSha256_ex(sha256, NULL, INVALID_DEVID);
+        if (ret != 0)
+            break;
+        if (prefix != NULL)
+            ret = wc_Sha256Update(sha256, prefix[i], WC_SHA256_BLOCK_SIZE);
+        if (ret == 0)
+            ret = wc_Sha256Update(sha256, data[i], sz[i]);
+        if (ret == 0)
+            ret = wc_Sha256Final(sha256, hash[i]);
+        wc_Sha256Free(sha256);
+    }
+    ForceZero(sha256, sizeof(wc_Sha256));
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(sha256, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    return ret;
+}
+
+/* Hash count independent messages, each optionally preceded by one block of
+ * prefix (used by HMAC for the padded key). With AVX2 or SHA-NI up to
+ * WC_SHA256_MB_LANES messages are hashed at once.
+ */
+int wc_Sha256_MultiBufferPrefix(const byte* const* prefix,
+    const byte* const* data, const word32* sz, byte* const* hash, word32 count)
+{
+    int ret = 0;
+    word32 i, n;
+#if defined(HAVE_INTEL_AVX2) || defined(HAVE_INTEL_SHA)
+    Sha256MBTransformFunc transform = NULL;
+    word32 width = 0;
+#endif
+
+    if (data == NULL || sz == NULL || hash == NULL)
+        return BAD_FUNC_ARG;
+    for (i = 0; i < count; i++) {
+        if ((data[i] == NULL && sz[i] > 0) || hash[i] == NULL ||
+                (prefix != NULL && prefix[i] == NULL))
+            return BAD_FUNC_ARG;
+    }
+
+#if defined(HAVE_INTEL_AVX2) || defined(HAVE_INTEL_SHA)
+    Sha256_SetTransform();
+    /* SHA-NI beats eight AVX2 lanes; interleave two streams instead. */
+    #if defined(HAVE_INTEL_SHA)
+    if (IS_INTEL_SHA(intel_flags)) {
+        transform = Transform_Sha256_SHANI_MB2;
+        width = 2;
+    }
+    #endif
+    #if defined(HAVE_INTEL_AVX2)
+    if (transform == NULL && IS_INTEL_AVX2(intel_flags)) {
+        transform = Transform_Sha256_AVX2_MB8;
+        width = 8;
+    }
+    #endif
+#endif
+
+    for (i = 0; ret == 0 && i < count; i += n) {
+        n = min(count - i, WC_SHA256_MB_LANES);
+    #if defined(HAVE_INTEL_AVX2) || defined(HAVE_INTEL_SHA)
+        if (transform != NULL && n > 1) {
+            ret = Sha256_MultiBufferLanes(transform, width,
+                                          prefix ? prefix + i : NULL,
+                                          data + i, sz + i, hash + i, n);
+            continue;
+        }
+    #endif
+        ret = Sha256_MultiBufferSerial(prefix ? prefix + i : NULL,
+                                       data + i, sz + i, hash + i, n);
+    }
+
+    return ret;
+}
+
+int wc_Sha256_MultiBuffer(const byte* const* data, const word32* sz,
+                          byte* const* hash, word32 count)
+{
+    return wc_Sha256_MultiBufferPrefix(NULL, data, sz, hash, count);
+}
+
+#endif /* WOLFSSL_SHA256_MULTI_BUFFER */
 #endif /* !WOLFSSL_TI_HASH */
 
 #endif /* NO_SHA256 */
@@ -52,6 +52,32 @@
     #include <wolfcrypt/src/misc.c>
 #endif
 
+#if defined(WOLFSSL_X86_64_BUILD) && defined(USE_INTEL_SPEEDUP) && \
+    !defined(NO_SHA3_ASM)
+    #define USE_INTEL_SHA3_SPEEDUP
+#endif
+
+#ifdef USE_INTEL_SHA3_SPEEDUP
+    #include <wolfssl/wolfcrypt/cpuid.h>
+
+    #if defined(__GNUC__) && ((__GNUC__ < 4) || \
+                              (__GNUC__ == 4 && __GNUC_MINOR__ <= 8))
+        #undef  NO_AVX2_SUPPORT
+        #define NO_AVX2_SUPPORT
+    #endif
+    #if defined(__clang__) && ((__clang_major__ < 3) || \
+                               (__clang_major__ == 3 && __clang_minor__ <= 5))
+        #undef  NO_AVX2_SUPPORT
+        #define NO_AVX2_SUPPORT
+    #elif defined(__clang__) && defined(NO_AVX2_SUPPORT)
+        #undef NO_AVX2_SUPPORT
+    #endif
+
+    #ifndef NO_AVX2_SUPPORT
+        #define HAVE_INTEL_AVX2
+    #endif
+#endif
+
 
 #ifdef WOLFSSL_SHA3_SMALL
 /* Rotate a 64-bit value left.
@@ -538,6 +564,44 @@ static void BlockSha3(word64 *s)
 }
 #endif /* WOLFSSL_SHA3_SMALL */
 
+#if defined(USE_INTEL_SHA3_SPEEDUP) && defined(HAVE_INTEL_AVX2)
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+    extern void sha3_block_avx2(word64* s);
+    extern void sha3_blocksx4_avx2(word64* s);
+
+#ifdef __cplusplus
+    }  /* extern "C" */
+#endif
+
+/* Number of states permuted together by sha3_blocksx4_avx2(). The lanes of
+ * the states are interleaved: lane i of state j is at index i * 4 + j. */
+#define SHA3_X4_LANES   4
+
+static int transform_check = 0;
+static word32 intel_flags;
+static void (*sha3_block_p)(word64* s) = BlockSha3;
+
+/* Choose the permutation implementation for the CPU. */
+static void Sha3_SetTransform(void)
+{
+    if (transform_check)
+        return;
+
+    intel_flags = cpuid_get_flags();
+    if (IS_INTEL_AVX2(intel_flags))
+        sha3_block_p = sha3_block_avx2;
+
+    transform_check = 1;
+}
+
+#define SHA3_BLOCK(s)   (*sha3_block_p)(s)
+#else
+#define SHA3_BLOCK(s)   BlockSha3(s)
+#endif
+
 /* Convert the array of bytes, in little-endian order, to a 64-bit integer.
  *
  * a  Array of bytes.
@@ -558,6 +622,24 @@ static word64 Load64BitBigEndian(const byte* a)
 #endif
 }
 
+/* Copy bytes out of the state in little-endian order.
+ *
+ * s    The state.
+ * out  Buffer to hold the bytes.
+ * len  Number of bytes to copy. At most the size of the state.
+ */
+static void Sha3StateBytes(const word64* s, byte* out, word32 len)
+{
+#ifdef BIG_ENDIAN_ORDER
+    word32 i;
+
+    for (i = 0; i < len; i++)
+        out[i] = (byte)(s[i / 8] >> (8 * (i % 8)));
+#else
+    XMEMCPY(out, s, len);
+#endif
+}
+
 /* Initialize the state for a SHA3-224 hash operation.
  *
  * sha3   wc_Sha3 object holding state.
@@ -573,6 +655,9 @@ static int InitSha3(wc_Sha3* sha3)
 #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
     sha3->flags = 0;
 #endif
+#if defined(USE_INTEL_SHA3_SPEEDUP) && defined(HAVE_INTEL_AVX2)
+    Sha3_SetTransform();
+#endif
 
     return 0;
 }
@@ -609,7 +694,7 @@ static int Sha3Update(wc_Sha3* sha3, const byte* data, word32 len, byte p)
         {
             for (i = 0; i < p; i++)
                 sha3->s[i] ^= Load64BitBigEndian(sha3->t + 8 * i);
-            BlockSha3(sha3->s);
+            SHA3_BLOCK(sha3->s);
             sha3->i = 0;
         }
     }
@@ -617,7 +702,7 @@ static int Sha3Update(wc_Sha3* sha3, const byte* data, word32 len, byte p)
     {
         for (i = 0; i < p; i++)
             sha3->s[i] ^= Load64BitBigEndian(data + 8 * i);
-        BlockSha3(sha3->s);
+        SHA3_BLOCK(sha3->s);
         len -= p * 8;
         data += p * 8;
     }
@@ -629,6 +714,8 @@ static int Sha3Update(wc_Sha3* sha3, const byte* data, word32 len, byte p)
 }
 
 /* Calculate the SHA-3 hash based on all the message data seen.
+ * Output longer than a block is squeezed out one block at a time. When no
+ * output is requested the state is padded but not permuted.
  *
  * sha3  wc_Sha3 object holding state.
  * hash  Buffer to hold the hash result.
@@ -636,10 +723,11 @@ static int Sha3Update(wc_Sha3* sha3, const byte* data, word32 len, byte p)
  * len   Number of bytes in output.
  * returns 0 on success.
  */
-static int Sha3Final(wc_Sha3* sha3, byte padChar, byte* hash, byte p, byte l)
+static int Sha3Final(wc_Sha3* sha3, byte padChar, byte* hash, byte p, word32 l)
 {
+    word32 rate = p * 8;
+    word32 j;
     byte i;
-    byte *s8 = (byte *)sha3->s;
 
     sha3->t[p * 8 - 1]  = 0x00;
 #ifdef WOLFSSL_HASH_FLAGS
@@ -653,12 +741,14 @@ static int Sha3Final(wc_Sha3* sha3, byte padChar, byte* hash, byte p, byte l)
         sha3->t[i] = 0;
     for (i = 0; i < p; i++)
         sha3->s[i] ^= Load64BitBigEndian(sha3->t + 8 * i);
-    BlockSha3(sha3->s);
-#if defined(BIG_ENDIAN_ORDER)
-    ByteReverseWords64(sha3->s, sha3->s, ((l+7)/8)*8);
-#endif
-    for (i = 0; i < l; i++)
-        hash[i] = s8[i];
+    for (j = 0; l - j >= rate; j += rate) {
+        SHA3_BLOCK(sha3->s);
+        Sha3StateBytes(sha3->s, hash + j, rate);
+    }
+    if (j != l) {
+        SHA3_BLOCK(sha3->s);
+        Sha3StateBytes(sha3->s, hash + j, l - j);
+    }
 
     return 0;
 }
@@ -1144,6 +1234,305 @@ int wc_Sha3_GetFlags(wc_Sha3* sha3, word32* flags)
 }
 #endif
 
+#if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
+/* Absorb all the message data and pad, ready to squeeze out blocks.
+ *
+ * shake  wc_Shake object holding state.
+ * data   Message data to be hashed.
+ * len    Length of the message data.
+ * p      Number of 64-bit numbers in a block of data to process.
+ * returns 0 on success.
+ */
+static int ShakeAbsorb(wc_Shake* shake, const byte* data, word32 len, byte p)
+{
+    int ret;
+
+    if (shake == NULL || (data == NULL && len > 0)) {
+        return BAD_FUNC_ARG;
+    }
+
+    ret = Sha3Update(shake, data, len, p);
+    if (ret == 0) {
+        ret = Sha3Final(shake, 0x1f, NULL, p, 0);
+    }
+    /* No partial block of data left. */
+    shake->i = 0;
+
+    return ret;
+}
+
+/* Squeeze out whole blocks of output after absorbing.
+ *
+ * shake     wc_Shake object holding state.
+ * out       Buffer to hold the output. Must be blockCnt blocks long.
+ * blockCnt  Number of blocks to output.
+ * p         Number of 64-bit numbers in a block of data to process.
+ * returns 0 on success.
+ */
+static int ShakeSqueezeBlocks(wc_Shake* shake, byte* out, word32 blockCnt,
+                              byte p)
+{
+    if (shake == NULL || (out == NULL && blockCnt > 0)) {
+        return BAD_FUNC_ARG;
+    }
+
+    for (; blockCnt > 0; blockCnt--) {
+        SHA3_BLOCK(shake->s);
+        Sha3StateBytes(shake->s, out, p * 8);
+        out += p * 8;
+    }
+
+    return 0;
+}
+
+#if defined(USE_INTEL_SHA3_SPEEDUP) && defined(HAVE_INTEL_AVX2)
+/* SHAKE up to four messages with their Keccak permutations interleaved.
+ * Each message is absorbed and then squeezed by permuting its state in one of
+ * the lanes. Lanes of shorter messages start squeezing earlier.
+ *
+ * data   Messages to hash.
+ * sz     Length of each message.
+ * out    Buffers to hold the output of each message.
+ * outSz  Number of bytes to output for each message. Must not be zero.
+ * n      Number of messages - at most SHA3_X4_LANES.
+ * p      Number of 64-bit numbers in a block of data to process.
+ */
+static void ShakeMultiBuffer_x4(const byte* const* data, const word32* sz,
+    byte* const* out, word32 outSz, word32 n, byte p)
+{
+    word64 s[25 * SHA3_X4_LANES];
+    byte   last[WC_SHA3_128_COUNT * 8];
+    word32 blocks[SHA3_X4_LANES];
+    word32 rate = p * 8;
+    word32 squeeze = (outSz + rate - 1) / rate;
+    word32 steps = 0;
+    word32 step, j, w, o, len;
+    const byte* b;
+
+    /* Last block of each message is the padded one. */
+    for (j = 0; j < n; j++) {
+        blocks[j] = sz[j] / rate + 1;
+        if (blocks[j] + squeeze - 1 > steps)
+            steps = blocks[j] + squeeze - 1;
+    }
+
+    XMEMSET(s, 0, sizeof(s));
+    for (step = 0; step < steps; step++) {
+        for (j = 0; j < n; j++) {
+            if (step >= blocks[j])
+                continue;
+            b = data[j] + step * rate;
+            if (step == blocks[j] - 1) {
+                len = sz[j] - step * rate;
+                if (len > 0)
+                    XMEMCPY(last, b, len);
+                last[len] = 0x1f;
+                XMEMSET(last + len + 1, 0, rate - len - 1);
+                last[rate - 1] |= 0x80;
+                b = last;
+            }
+            for (w = 0; w < p; w++)
+                s[w * SHA3_X4_LANES + j] ^= Load64BitBigEndian(b + 8 * w);
+        }
+
+        sha3_blocksx4_avx2(s);
+
+        for (j = 0; j < n; j++) {
+            if (step + 1 < blocks[j])
+                continue;
+            o = (step + 1 - blocks[j]) * rate;
+            if (o >= outSz)
+                continue;
+            len = min(rate, outSz - o);
+            for (w = 0; w * 8 < len; w++) {
+                XMEMCPY(out[j] + o + w * 8, &s[w * SHA3_X4_LANES + j],
+                        min(8, len - w * 8));
+            }
+        }
+    }
+
+    ForceZero(s, sizeof(s));
+    ForceZero(last, sizeof(last));
+}
+#endif
+
+/* Hash each message with SHAKE and output outSz bytes for each.
+ * With AVX2, up to four messages are hashed at once.
+ *
+ * data   Messages to hash.
+ * sz     Length of each message.
+ * out    Buffers to hold the output of each message.
+ * outSz  Number of bytes to output for each message.
+ * count  Number of messages.
+ * p      Number of 64-bit numbers in a block of data to process.
+ * returns 0 on success and BAD_FUNC_ARG when a parameter is NULL.
+ */
+static int ShakeMultiBuffer(const byte* const* data, const word32* sz,
+    byte* const* out, word32 outSz, word32 count, byte p)
+{
+    int ret = 0;
+    word32 i;
+    wc_Shake shake;
+
+    if ((data == NULL || sz == NULL || out == NULL) && count > 0) {
+        return BAD_FUNC_ARG;
+    }
+    for (i = 0; i < count; i++) {
+        if ((data[i] == NULL && sz[i] > 0) || (out[i] == NULL && outSz > 0))
+            return BAD_FUNC_ARG;
+    }
+    if (outSz == 0) {
+        return 0;
+    }
+
+    i = 0;
+#if defined(USE_INTEL_SHA3_SPEEDUP) && defined(HAVE_INTEL_AVX2)
+    Sha3_SetTransform();
+    if (IS_INTEL_AVX2(intel_flags)) {
+        /* A lone message is faster on its own. */
+        while (count - i > 1) {
+            word32 n = min(count - i, SHA3_X4_LANES);
+
+            ShakeMultiBuffer_x4(data + i, sz + i, out + i, outSz, n, p);
+            i += n;
+        }
+    }
+#endif
+
+    for (; ret == 0 && i < count; i++) {
+        ret = InitSha3(&shake);
+        if (ret == 0)
+            ret = Sha3Update(&shake, data[i], sz[i], p);
+        if (ret == 0)
+            ret = Sha3Final(&shake, 0x1f, out[i], p, outSz);
+    }
+
+    ForceZero(&shake, sizeof(shake));
+
+    return ret;
+}
+#endif /* WOLFSSL_SHAKE128 || WOLFSSL_SHAKE256 */
+
+#if defined(WOLFSSL_SHAKE128)
+/* Initialize the state for a Shake128 hash operation.
+ *
+ * shake  wc_Shake object holding state.
+ * heap   Heap reference for dynamic memory allocation. (Used in async ops.)
+ * devId  Device identifier for asynchronous operation.
+ * returns 0 on success.
+ */
+int wc_InitShake128(wc_Shake* shake, void* heap, int devId)
+{
+    return wc_InitSha3(shake, heap, devId);
+}
+
+/* Update the SHAKE128 hash state with message data.
+ *
+ * shake  wc_Shake object holding state.
+ * data  Message data to be hashed.
+ * len   Length of the message data.
+ * returns 0 on success.
+ */
+int wc_Shake128_Update(wc_Shake* shake, const byte* data, word32 len)
+{
+    if (shake == NULL || (data == NULL && len > 0)) {
+         return BAD_FUNC_ARG;
+    }
+
+    if (data == NULL && len == 0) {
+        /* valid, but do nothing */
+        return 0;
+    }
+
+    return Sha3Update(shake, data, len, WC_SHA3_128_COUNT);
+}
+
+/* Calculate the SHAKE128 hash based on all the message data seen.
+ * The state is initialized ready for a new message to hash.
+ *
+ * shake    wc_Shake object holding state.
+ * hash     Buffer to hold the hash result.
+ * hashLen  Number of bytes of output.
+ * returns 0 on success.
+ */
+int wc_Shake128_Final(wc_Shake* shake, byte* hash, word32 hashLen)
+{
+    int ret;
+
+    if (shake == NULL || hash == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    ret = Sha3Final(shake, 0x1f, hash, WC_SHA3_128_COUNT, hashLen);
+    if (ret != 0)
+        return ret;
+
+    return InitSha3(shake);  /* reset state */
+}
+
+/* Absorb the message data for SHAKE128 and pad, ready to squeeze blocks.
+ *
+ * shake  wc_Shake object holding state.
+ * data  Message data to be hashed.
+ * len   Length of the message data.
+ * returns 0 on success.
+ */
+int wc_Shake128_Absorb(wc_Shake* shake, const byte* data, word32 len)
+{
+    return ShakeAbsorb(shake, data, len, WC_SHA3_128_COUNT);
+}
+
+/* Squeeze blocks of SHAKE128 output. Call after wc_Shake128_Absorb().
+ *
+ * shake     wc_Shake object holding state.
+ * out       Buffer to hold the output.
+ *           Must be blockCnt * WC_SHAKE128_BLOCK_SIZE bytes long.
+ * blockCnt  Number of blocks to output.
+ * returns 0 on success.
+ */
+int wc_Shake128_SqueezeBlocks(wc_Shake* shake, byte* out, word32 blockCnt)
+{
+    return ShakeSqueezeBlocks(shake, out, blockCnt, WC_SHA3_128_COUNT);
+}
+
+/* Dispose of any dynamically allocated data from the SHAKE128 operation.
+ * (Required for async ops.)
+ *
+ * shake  wc_Shake object holding state.
+ * returns 0 on success.
+ */
+void wc_Shake128_Free(wc_Shake* shake)
+{
+    wc_Sha3Free(shake);
+}
+
+/* Copy the state of the SHAKE128 operation.
+ *
+ * src  wc_Shake object holding state top copy.
+ * dst  wc_Shake object to copy into.
+ * returns 0 on success.
+ */
+int wc_Shake128_Copy(wc_Shake* src, wc_Shake* dst)
+{
+    return wc_Sha3Copy(src, dst);
+}
+
+/* Hash each message with SHAKE128 and output outSz bytes for each.
+ *
+ * data   Messages to hash.
+ * sz     Length of each message.
+ * out    Buffers to hold the output of each message.
+ * outSz  Number of bytes to output for each message.
+ * count  Number of messages.
+ * returns 0 on success.
+ */
+int wc_Shake128_MultiBuffer(const byte* const* data, const word32* sz,
+                            byte* const* out, word32 outSz, word32 count)
+{
+    return ShakeMultiBuffer(data, sz, out, outSz, count, WC_SHA3_128_COUNT);
+}
+#endif
+
 #if defined(WOLFSSL_SHAKE256)
 /* Initialize the state for a Shake256 hash operation.
  *
@@ -1181,8 +1570,9 @@ int wc_Shake256_Update(wc_Shake* shake, const byte* data, word32 len)
 /* Calculate the SHAKE256 hash based on all the message data seen.
  * The state is initialized ready for a new message to hash.
  *
- * shake  wc_Shake object holding state.
- * hash  Buffer to hold the hash result. Must be at least 64 bytes.
+ * shake    wc_Shake object holding state.
+ * hash     Buffer to hold the hash result.
+ * hashLen  Number of bytes of output.
  * returns 0 on success.
  */
 int wc_Shake256_Final(wc_Shake* shake, byte* hash, word32 hashLen)
@@ -1200,6 +1590,31 @@ int wc_Shake256_Final(wc_Shake* shake, byte* hash, word32 hashLen)
     return InitSha3(shake);  /* reset state */
 }
 
+/* Absorb the message data for SHAKE256 and pad, ready to squeeze blocks.
+ *
+ * shake  wc_Shake object holding state.
+ * data  Message data to be hashed.
+ * len   Length of the message data.
+ * returns 0 on success.
+ */
+int wc_Shake256_Absorb(wc_Shake* shake, const byte* data, word32 len)
+{
+    return ShakeAbsorb(shake, data, len, WC_SHA3_256_COUNT);
+}
+
+/* Squeeze blocks of SHAKE256 output. Call after wc_Shake256_Absorb().
+ *
+ * shake     wc_Shake object holding state.
+ * out       Buffer to hold the output.
+ *           Must be blockCnt * WC_SHAKE256_BLOCK_SIZE bytes long.
+ * blockCnt  Number of blocks to output.
+ * returns 0 on success.
+ */
+int wc_Shake256_SqueezeBlocks(wc_Shake* shake, byte* out, word32 blockCnt)
+{
+    return ShakeSqueezeBlocks(shake, out, blockCnt, WC_SHA3_256_COUNT);
+}
+
 /* Dispose of any dynamically allocated data from the SHAKE256 operation.
  * (Required for async ops.)
  *
@@ -1221,6 +1636,21 @@ int wc_Shake256_Copy(wc_Shake* src, wc_Shake* dst)
 {
     return wc_Sha3Copy(src, dst);
 }
+
+/* Hash each message with SHAKE256 and output outSz bytes for each.
+ *
+ * data   Messages to hash.
+ * sz     Length of each message.
+ * out    Buffers to hold the output of each message.
+ * outSz  Number of bytes to output for each message.
+ * count  Number of messages.
+ * returns 0 on success.
+ */
+int wc_Shake256_MultiBuffer(const byte* const* data, const word32* sz,
+                            byte* const* out, word32 outSz, word32 count)
+{
+    return ShakeMultiBuffer(data, sz, out, outSz, count, WC_SHA3_256_COUNT);
+}
 #endif
 
 #endif /* WOLFSSL_SHA3 */
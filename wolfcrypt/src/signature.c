@@ -533,4 +533,259 @@ int wc_SignatureGenerate_ex(
     return ret;
 }
 
+#ifdef WOLFSSL_SIGN_BATCH
+/* Initialize a batch of signatures made with one private key.
+ * sig_type is WC_SIGNATURE_TYPE_ECC or WC_SIGNATURE_TYPE_RSA and the key
+ * and rng must stay valid until wc_SignatureBatchFree().
+ * Only ECDSA batches are cheaper than single signatures. RSA requests are
+ * queued for the same interface but signed one at a time, with no speedup.
+ */
+int wc_SignatureBatchInit(wc_SignatureBatch* batch,
+    enum wc_SignatureType sig_type, void* key, word32 key_len, WC_RNG* rng)
+{
+    if (batch == NULL || key == NULL || key_len == 0 || rng == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    switch (sig_type) {
+        case WC_SIGNATURE_TYPE_ECC:
+#if !defined(HAVE_ECC) || !defined(HAVE_ECC_SIGN)
+            return SIG_TYPE_E;
+#else
+            if (key_len < sizeof(ecc_key))
+                return BAD_FUNC_ARG;
+            break;
+#endif
+        case WC_SIGNATURE_TYPE_RSA:
+#if defined(NO_RSA) || defined(WOLFSSL_RSA_PUBLIC_ONLY)
+            return SIG_TYPE_E;
+#else
+            if (key_len < sizeof(RsaKey))
+                return BAD_FUNC_ARG;
+            break;
+#endif
+        case WC_SIGNATURE_TYPE_RSA_W_ENC:
+        case WC_SIGNATURE_TYPE_NONE:
+        default:
+            return BAD_FUNC_ARG;
+    }
+
+    XMEMSET(batch, 0, sizeof(wc_SignatureBatch));
+    batch->sig_type = sig_type;
+    batch->key = key;
+    batch->key_len = key_len;
+    batch->rng = rng;
+
+#ifndef SINGLE_THREADED
+    if (wc_InitMutex(&batch->lock) != 0) {
+        return BAD_MUTEX_E;
+    }
+#endif
+
+    return 0;
+}
+
+/* Sign every queued request and publish the results. Called with the batch
+ * locked. */
+static void wc_SignatureBatchRun(wc_SignatureBatch* batch)
+{
+    int i;
+    int count = batch->count;
+
+    if (count == 0) {
+        return;
+    }
+
+    switch (batch->sig_type) {
+        case WC_SIGNATURE_TYPE_ECC:
+        {
+#if defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && !defined(NO_ASN)
+            const byte* in[WC_SIG_BATCH_MAX];
+            word32      inLen[WC_SIG_BATCH_MAX];
+            byte*       out[WC_SIG_BATCH_MAX];
+            word32      outLen[WC_SIG_BATCH_MAX];
+            int         res[WC_SIG_BATCH_MAX];
+            int         ret;
+
+            for (i = 0; i < WC_SIG_BATCH_MAX; i++) {
+                in[i] = NULL;
+                inLen[i] = 0;
+                out[i] = NULL;
+                outLen[i] = 0;
+                res[i] = 0;
+            }
+            for (i = 0; i < count; i++) {
+                in[i] = batch->req[i]->hash_data;
+                inLen[i] = batch->req[i]->hash_len;
+                out[i] = batch->req[i]->sig;
+                outLen[i] = *batch->req[i]->sig_len;
+            }
+
+            ret = wc_ecc_sign_hash_batch(in, inLen, out, outLen, res, count,
+                batch->rng, (ecc_key*)batch->key);
+
+            for (i = 0; i < count; i++) {
+                batch->req[i]->ret = (ret != 0) ? ret : res[i];
+                if (batch->req[i]->ret == 0)
+                    *batch->req[i]->sig_len = outLen[i];
+            }
+#elif defined(HAVE_ECC) && defined(HAVE_ECC_SIGN)
+            for (i = 0; i < count; i++) {
+                batch->req[i]->ret = wc_ecc_sign_hash(
+                    batch->req[i]->hash_data, batch->req[i]->hash_len,
+                    batch->req[i]->sig, batch->req[i]->sig_len,
+                    batch->rng, (ecc_key*)batch->key);
+            }
+#else
+            for (i = 0; i < count; i++) {
+                batch->req[i]->ret = SIG_TYPE_E;
+            }
+#endif
+            break;
+        }
+
+        case WC_SIGNATURE_TYPE_RSA:
+            /* one private key operation per request, the same cost as
+               wc_RsaSSL_Sign() called directly (SP code included) */
+            for (i = 0; i < count; i++) {
+#if !defined(NO_RSA) && !defined(WOLFSSL_RSA_PUBLIC_ONLY)
+                int ret = wc_RsaSSL_Sign(batch->req[i]->hash_data,
+                    batch->req[i]->hash_len, batch->req[i]->sig,
+                    *batch->req[i]->sig_len, (RsaKey*)batch->key,
+                    batch->rng);
+                if (ret >= 0) {
+                    *batch->req[i]->sig_len = ret;
+                    ret = 0;
+                }
+                batch->req[i]->ret = ret;
+#else
+                batch->req[i]->ret = SIG_TYPE_E;
+#endif
+            }
+            break;
+
+        case WC_SIGNATURE_TYPE_RSA_W_ENC:
+        case WC_SIGNATURE_TYPE_NONE:
+        default:
+            for (i = 0; i < count; i++) {
+                batch->req[i]->ret = SIG_TYPE_E;
+            }
+            break;
+    }
+
+    for (i = 0; i < count; i++) {
+        batch->req[i] = NULL;
+    }
+    batch->count = 0;
+}
+
+/* Queue a signature of hash_data on the batch.
+ * req, hash_data and sig are owned by the caller and must stay valid until
+ * the signature is done - the hash is not copied.
+ * Returns WC_PENDING_E while the request waits for the batch to be run, or
+ * the result of the signature when queueing it filled the batch.
+ */
+int wc_SignatureBatchSubmit(wc_SignatureBatch* batch,
+    wc_SignatureBatchReq* req, const byte* hash_data, word32 hash_len,
+    byte* sig, word32* sig_len)
+{
+    int ret;
+
+    if (batch == NULL || req == NULL || hash_data == NULL || hash_len == 0 ||
+        sig == NULL || sig_len == NULL || *sig_len == 0) {
+        return BAD_FUNC_ARG;
+    }
+
+    /* Validate signature len (needs to be at least max) */
+    if ((int)*sig_len < wc_SignatureGetSize(batch->sig_type, batch->key,
+                                            batch->key_len)) {
+        WOLFSSL_MSG("wc_SignatureBatchSubmit: Invalid sig type/len");
+        return BAD_FUNC_ARG;
+    }
+
+    req->hash_data = hash_data;
+    req->hash_len = hash_len;
+    req->sig = sig;
+    req->sig_len = sig_len;
+    req->ret = WC_PENDING_E;
+
+#ifndef SINGLE_THREADED
+    if (wc_LockMutex(&batch->lock) != 0) {
+        return BAD_MUTEX_E;
+    }
+#endif
+
+    batch->req[batch->count++] = req;
+    if (batch->count == WC_SIG_BATCH_MAX) {
+        wc_SignatureBatchRun(batch);
+    }
+    ret = req->ret;
+
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&batch->lock);
+#endif
+
+    return ret;
+}
+
+/* Run the requests queued on the batch without waiting for it to fill. */
+int wc_SignatureBatchFlush(wc_SignatureBatch* batch)
+{
+    if (batch == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+#ifndef SINGLE_THREADED
+    if (wc_LockMutex(&batch->lock) != 0) {
+        return BAD_MUTEX_E;
+    }
+#endif
+
+    wc_SignatureBatchRun(batch);
+
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&batch->lock);
+#endif
+
+    return 0;
+}
+
+/* Returns the result of a submitted request, WC_PENDING_E while queued. */
+int wc_SignatureBatchPoll(wc_SignatureBatch* batch, wc_SignatureBatchReq* req)
+{
+    int ret;
+
+    if (batch == NULL || req == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+#ifndef SINGLE_THREADED
+    if (wc_LockMutex(&batch->lock) != 0) {
+        return BAD_MUTEX_E;
+    }
+#endif
+
+    ret = req->ret;
+
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&batch->lock);
+#endif
+
+    return ret;
+}
+
+/* Runs any requests still queued and frees the batch. */
+void wc_SignatureBatchFree(wc_SignatureBatch* batch)
+{
+    if (batch == NULL) {
+        return;
+    }
+
+    wc_SignatureBatchFlush(batch);
+#ifndef SINGLE_THREADED
+    wc_FreeMutex(&batch->lock);
+#endif
+}
+#endif /* WOLFSSL_SIGN_BATCH */
+
 #endif /* NO_SIG_WRAPPER */
@@ -1563,9 +1563,11 @@ int fp_exptmod_nb(exptModNb_t* nb, fp_int* G, fp_int* X, fp_int* P, fp_int* Y)
 /* timing resistant montgomery ladder based exptmod
    Based on work by Marc Joye, Sung-Ming Yen, "The Montgomery Powering Ladder",
    Cryptographic Hardware and Embedded Systems, CHES 2002
+   When R2 is not NULL it holds R^2 mod P and mp the Montgomery constant of P,
+   as computed by fp_exptmod_mont_setup(), and setup is skipped.
 */
 static int _fp_exptmod_ct(fp_int * G, fp_int * X, int digits, fp_int * P,
-                          fp_int * Y)
+                          fp_int * R2, fp_digit mp, fp_int * Y)
 {
 #ifndef WOLFSSL_SMALL_STACK
 #ifdef WC_NO_CACHE_RESISTANT
@@ -1576,11 +1578,11 @@ static int _fp_exptmod_ct(fp_int * G, fp_int * X, int digits, fp_int * P,
 #else
    fp_int  *R;
 #endif
-  fp_digit buf, mp;
+  fp_digit buf;
   int      err, bitcnt, digidx, y;
 
   /* now setup montgomery  */
-  if ((err = fp_montgomery_setup (P, &mp)) != FP_OKAY) {
+  if (R2 == NULL && (err = fp_montgomery_setup (P, &mp)) != FP_OKAY) {
      return err;
   }
 
@@ -1599,9 +1601,6 @@ static int _fp_exptmod_ct(fp_int * G, fp_int * X, int digits, fp_int * P,
   fp_init(&R[2]);
 #endif
 
-  /* now we need R mod m */
-  fp_montgomery_calc_normalization (&R[0], P);
-
   /* now set R[0][1] to G * R mod m */
   if (fp_cmp_mag(P, G) != FP_GT) {
      /* G > P so we reduce it first */
@@ -1609,7 +1608,27 @@ static int _fp_exptmod_ct(fp_int * G, fp_int * X, int digits, fp_int * P,
   } else {
      fp_copy(G, &R[1]);
   }
-  fp_mulmod (&R[1], &R[0], P, &R[1]);
+
+  if (R2 == NULL) {
+     /* now we need R mod m */
+     fp_montgomery_calc_normalization (&R[0], P);
+     fp_mulmod (&R[1], &R[0], P, &R[1]);
+  }
+  else {
+     /* R mod m and G * R mod m by Montgomery reduction against R^2 */
+     fp_copy(R2, &R[0]);
+     err = fp_montgomery_reduce(&R[0], P, mp);
+     if (err == FP_OKAY)
+        err = fp_mul(&R[1], R2, &R[1]);
+     if (err == FP_OKAY)
+        err = fp_montgomery_reduce(&R[1], P, mp);
+     if (err != FP_OKAY) {
+     #ifdef WOLFSSL_SMALL_STACK
+        XFREE(R, NULL, DYNAMIC_TYPE_BIGINT);
+     #endif
+        return err;
+     }
+  }
 
   /* for j = t-1 downto 0 do
         r_!k = R0*R1; r_k = r_k^2
@@ -2350,7 +2369,8 @@ int fp_exptmod(fp_int * G, fp_int * X, fp_int * P, fp_int * Y)
          fp_copy(X, &tmp[1]);
          tmp[1].sign = FP_ZPOS;
 #ifdef TFM_TIMING_RESISTANT
-         err =  _fp_exptmod_ct(&tmp[0], &tmp[1], tmp[1].used, P, Y);
+         err =  _fp_exptmod_ct(&tmp[0], &tmp[1], tmp[1].used, P, NULL, 0,
+                                 Y);
 #else
          err =  _fp_exptmod_nct(&tmp[0], &tmp[1], P, Y);
 #endif
@@ -2372,7 +2392,7 @@ int fp_exptmod(fp_int * G, fp_int * X, fp_int * P, fp_int * Y)
    else {
       /* Positive exponent so just exptmod */
 #ifdef TFM_TIMING_RESISTANT
-      return _fp_exptmod_ct(G, X, X->used, P, Y);
+      return _fp_exptmod_ct(G, X, X->used, P, NULL, 0, Y);
 #else
       return _fp_exptmod_nct(G, X, P, Y);
 #endif
@@ -2427,7 +2447,7 @@ int fp_exptmod_ex(fp_int * G, fp_int * X, int digits, fp_int * P, fp_int * Y)
       if (err == FP_OKAY) {
          X->sign = FP_ZPOS;
 #ifdef TFM_TIMING_RESISTANT
-         err =  _fp_exptmod_ct(&tmp[0], X, digits, P, Y);
+         err =  _fp_exptmod_ct(&tmp[0], X, digits, P, NULL, 0, Y);
 #else
          err =  _fp_exptmod_nct(&tmp[0], X, P, Y);
          (void)digits;
@@ -2450,13 +2470,65 @@ int fp_exptmod_ex(fp_int * G, fp_int * X, int digits, fp_int * P, fp_int * Y)
    else {
       /* Positive exponent so just exptmod */
 #ifdef TFM_TIMING_RESISTANT
-      return _fp_exptmod_ct(G, X, digits, P, Y);
+      return _fp_exptmod_ct(G, X, digits, P, NULL, 0, Y);
 #else
       return  _fp_exptmod_nct(G, X, P, Y);
 #endif
    }
 }
 
+/* Computes the Montgomery constant mp = -1/P mod b and R2 = R^2 mod P so
+ * repeated exponentiations modulo the same P can use fp_exptmod_mont().
+ */
+int fp_exptmod_mont_setup(fp_int * P, fp_digit * mp, fp_int * R2)
+{
+   int err;
+
+   if (fp_iszero(P) || (P->used > (FP_SIZE/2))) {
+      return FP_VAL;
+   }
+
+   err = fp_montgomery_setup(P, mp);
+   if (err == FP_OKAY) {
+      fp_montgomery_calc_normalization(R2, P);
+      err = fp_sqrmod(R2, P, R2);
+   }
+
+   return err;
+}
+
+/* y = g**x (mod p) using the constants from fp_exptmod_mont_setup().
+ * x must be positive.
+ */
+int fp_exptmod_mont(fp_int * G, fp_int * X, fp_int * P, fp_digit mp,
+                    fp_int * R2, fp_int * Y)
+{
+   /* handle modulus of zero and prevent overflows */
+   if (fp_iszero(P) || (P->used > (FP_SIZE/2)) || X->sign == FP_NEG) {
+      return FP_VAL;
+   }
+   if (fp_isone(P)) {
+      fp_set(Y, 0);
+      return FP_OKAY;
+   }
+   if (fp_iszero(X)) {
+      fp_set(Y, 1);
+      return FP_OKAY;
+   }
+   if (fp_iszero(G)) {
+      fp_set(Y, 0);
+      return FP_OKAY;
+   }
+
+#ifdef TFM_TIMING_RESISTANT
+   return _fp_exptmod_ct(G, X, X->used, P, R2, mp, Y);
+#else
+   (void)mp;
+   (void)R2;
+   return _fp_exptmod_nct(G, X, P, Y);
+#endif
+}
+
 int fp_exptmod_nct(fp_int * G, fp_int * X, fp_int * P, fp_int * Y)
 {
 #if defined(WOLFSSL_ESP32WROOM32_CRYPT_RSA_PRI) && \
@@ -3746,6 +3818,17 @@ int mp_exptmod_nct (mp_int * G, mp_int * X, mp_int * P, mp_int * Y)
   return fp_exptmod_nct(G, X, P, Y);
 }
 
+int mp_exptmod_mont_setup (mp_int * P, mp_digit * mp, mp_int * R2)
+{
+  return fp_exptmod_mont_setup(P, mp, R2);
+}
+
+int mp_exptmod_mont (mp_int * G, mp_int * X, mp_int * P, mp_digit mp,
+                     mp_int * R2, mp_int * Y)
+{
+  return fp_exptmod_mont(G, X, P, mp, R2, Y);
+}
+
 
 /* compare two ints (signed)*/
 int mp_cmp (mp_int * a, mp_int * b)
@@ -35,6 +35,9 @@
 #ifdef WOLFSSL_ASYNC_CRYPT
     #include <wolfssl/wolfcrypt/async.h>
 #endif
+#ifdef WOLFSSL_THREAD_LOCAL_RNG
+    #include <wolfssl/wolfcrypt/random.h>
+#endif
 
 /* IPP header files for library initialization */
 #ifdef HAVE_FAST_RSA
@@ -232,6 +235,10 @@ int wolfCrypt_Init(void)
         }
     #endif
 
+#ifdef WOLFSSL_THREAD_LOCAL_RNG
+        wc_RNG_ThreadLocalInit();
+#endif
+
 #ifdef HAVE_ECC
     #ifdef FP_ECC
         wc_ecc_fp_init();
@@ -289,9 +296,15 @@ int wolfCrypt_Cleanup(void)
     if (initRefCount == 0) {
         WOLFSSL_ENTER("wolfCrypt_Cleanup");
 
+#ifdef WOLFSSL_THREAD_LOCAL_RNG
+        wc_RNG_ThreadLocalFree();
+        wc_RNG_ThreadLocalCleanup();
+#endif
+
 #ifdef HAVE_ECC
     #ifdef FP_ECC
         wc_ecc_fp_free();
+        wc_ecc_fp_cleanup();
     #endif
     #ifdef ECC_CACHE_CURVE
         wc_ecc_curve_cache_free();
@@ -1879,6 +1892,86 @@ int wolfSSL_CryptHwMutexUnLock(void) {
 
 #endif
 
+#ifdef WOLFSSL_USE_RWLOCK
+
+    int wc_InitRwLock(wolfSSL_RwLock* m)
+    {
+        if (pthread_rwlock_init(m, 0) == 0)
+            return 0;
+        else
+            return BAD_MUTEX_E;
+    }
+
+
+    int wc_FreeRwLock(wolfSSL_RwLock* m)
+    {
+        if (pthread_rwlock_destroy(m) == 0)
+            return 0;
+        else
+            return BAD_MUTEX_E;
+    }
+
+
+    int wc_LockRwLock_Rd(wolfSSL_RwLock* m)
+    {
+        if (pthread_rwlock_rdlock(m) == 0)
+            return 0;
+        else
+            return BAD_MUTEX_E;
+    }
+
+
+    int wc_LockRwLock_Wr(wolfSSL_RwLock* m)
+    {
+        if (pthread_rwlock_wrlock(m) == 0)
+            return 0;
+        else
+            return BAD_MUTEX_E;
+    }
+
+
+    int wc_UnLockRwLock(wolfSSL_RwLock* m)
+    {
+        if (pthread_rwlock_unlock(m) == 0)
+            return 0;
+        else
+            return BAD_MUTEX_E;
+    }
+
+#else
+
+    /* no native rwlock, readers and writers share one mutex */
+    int wc_InitRwLock(wolfSSL_RwLock* m)
+    {
+        return wc_InitMutex(m);
+    }
+
+
+    int wc_FreeRwLock(wolfSSL_RwLock* m)
+    {
+        return wc_FreeMutex(m);
+    }
+
+
+    int wc_LockRwLock_Rd(wolfSSL_RwLock* m)
+    {
+        return wc_LockMutex(m);
+    }
+
+
+    int wc_LockRwLock_Wr(wolfSSL_RwLock* m)
+    {
+        return wc_LockMutex(m);
+    }
+
+
+    int wc_UnLockRwLock(wolfSSL_RwLock* m)
+    {
+        return wc_UnLockMutex(m);
+    }
+
+#endif /* WOLFSSL_USE_RWLOCK */
+
 #ifndef NO_ASN_TIME
 #if defined(_WIN32_WCE)
 time_t windows_time(time_t* timer)
@@ -65,6 +65,13 @@ int wolfEvent_Poll(WOLF_EVENT* event, WOLF_EVENT_FLAG flags)
         ret = wolfAsync_EventPoll(event, flags);
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
+#ifdef WOLF_CRYPTO_CB_QUEUE
+    /* state is set by the crypto callback queue worker under queue lock */
+    if (event->type == WOLF_EVENT_TYPE_CRYPTOCB) {
+        (void)flags;
+        ret = 0;
+    }
+#endif
 
     return ret;
 }
@@ -284,6 +284,7 @@ int  sha256_test(void);
 int  sha512_test(void);
 int  sha384_test(void);
 int  sha3_test(void);
+int  shake128_test(void);
 int  shake256_test(void);
 int  hash_test(void);
 int  hmac_md5_test(void);
@@ -702,6 +703,13 @@ initDefaultName();
         test_pass("SHA-3    test passed!\n");
 #endif
 
+#ifdef WOLFSSL_SHAKE128
+    if ( (ret = shake128_test()) != 0)
+        return err_sys("SHAKE128 test failed!\n", ret);
+    else
+        test_pass("SHAKE128 test passed!\n");
+#endif
+
 #ifdef WOLFSSL_SHAKE256
     if ( (ret = shake256_test()) != 0)
         return err_sys("SHAKE256 test failed!\n", ret);
@@ -3068,12 +3076,152 @@ int sha3_test(void)
 }
 #endif /* WOLFSSL_SHA3 */
 
+#ifdef WOLFSSL_SHAKE128
+int shake128_test(void)
+{
+#ifndef WOLFSSL_NO_SHAKE128
+    wc_Shake  sha;
+    byte  hash[114];
+    byte  squeeze[3 * WC_SHAKE128_BLOCK_SIZE];
+    byte  full[3 * WC_SHAKE128_BLOCK_SIZE];
+
+    testVector a, b, c;
+    testVector test_sha[3];
+    int ret = 0;
+    int times = sizeof(test_sha) / sizeof(struct testVector), i;
+
+    byte large_input[1024];
+    const char* large_digest =
+        "\x88\xd7\x0e\x86\x46\x72\x6b\x3d\x7d\x22\xe1\xa9\x2d\x02\xdb\x35"
+        "\x92\x4f\x1b\x03\x90\xee\xa3\xce\xd1\x3a\x08\x3a\xd7\x4e\x10\xdf"
+        "\x09\x67\x33\x35\x4f\xdd\x38\x50\x5b\xcb\x75\xc7\xba\x65\xe5\xe8"
+        "\xb8\x76\xde\xc5\xee\xd7\xf1\x65\x93\x4e\x5e\xc4\xb1\xd7\x6b\xee"
+        "\x4b\x57\x48\xf5\x38\x49\x9e\x45\xa0\xf7\x32\xe9\x05\x26\x6a\x10"
+        "\x70\xd4\x7c\x19\x01\x1f\x6d\x37\xba\x7b\x74\xc2\xbc\xb6\xbc\x74"
+        "\xa3\x66\x6c\x9b\x11\x84\x9d\x4a\x36\xbc\x8a\x0d\x4c\xe3\x39\xfa"
+        "\xfa\x1b";
+    /* Bytes 336 - 367 of the output for "abc" - third block squeezed. */
+    const char* third_block =
+        "\x4c\xed\xd5\x0d\x30\xa2\x23\xe7\xd5\x4e\x9a\x24\xf0\xa2\x52\x6b"
+        "\x31\x00\x2a\xfb\xd1\xb4\xeb\xea\x69\xc8\x40\x0c\x3d\xeb\x4c\x1c";
+
+    a.input  = "";
+    a.output = "\x7f\x9c\x2b\xa4\xe8\x8f\x82\x7d\x61\x60\x45\x50\x76\x05\x85"
+               "\x3e\xd7\x3b\x80\x93\xf6\xef\xbc\x88\xeb\x1a\x6e\xac\xfa\x66"
+               "\xef\x26\x3c\xb1\xee\xa9\x88\x00\x4b\x93\x10\x3c\xfb\x0a\xee"
+               "\xfd\x2a\x68\x6e\x01\xfa\x4a\x58\xe8\xa3\x63\x9c\xa8\xa1\xe3"
+               "\xf9\xae\x57\xe2\x35\xb8\xcc\x87\x3c\x23\xdc\x62\xb8\xd2\x60"
+               "\x16\x9a\xfa\x2f\x75\xab\x91\x6a\x58\xd9\x74\x91\x88\x35\xd2"
+               "\x5e\x6a\x43\x50\x85\xb2\xba\xdf\xd6\xdf\xaa\xc3\x59\xa5\xef"
+               "\xbb\x7b\xcc\x4b\x59\xd5\x38\xdf\x9a";
+    a.inLen  = XSTRLEN(a.input);
+    a.outLen = sizeof(hash);
+
+    b.input  = "abc";
+    b.output = "\x58\x81\x09\x2d\xd8\x18\xbf\x5c\xf8\xa3\xdd\xb7\x93\xfb\xcb"
+               "\xa7\x40\x97\xd5\xc5\x26\xa6\xd3\x5f\x97\xb8\x33\x51\x94\x0f"
+               "\x2c\xc8\x44\xc5\x0a\xf3\x2a\xcd\x3f\x2c\xdd\x06\x65\x68\x70"
+               "\x6f\x50\x9b\xc1\xbd\xde\x58\x29\x5d\xae\x3f\x89\x1a\x9a\x0f"
+               "\xca\x57\x83\x78\x9a\x41\xf8\x61\x12\x14\xce\x61\x23\x94\xdf"
+               "\x28\x6a\x62\xd1\xa2\x25\x2a\xa9\x4d\xb9\xc5\x38\x95\x6c\x71"
+               "\x7d\xc2\xbe\xd4\xf2\x32\xa0\x29\x4c\x85\x7c\x73\x0a\xa1\x60"
+               "\x67\xac\x10\x62\xf1\x20\x1f\xb0\xd3";
+    b.inLen  = XSTRLEN(b.input);
+    b.outLen = sizeof(hash);
+
+    c.input  = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    c.output = "\x1a\x96\x18\x2b\x50\xfb\x8c\x7e\x74\xe0\xa7\x07\x78\x8f\x55"
+               "\xe9\x82\x09\xb8\xd9\x1f\xad\xe8\xf3\x2f\x8d\xd5\xcf\xf7\xbf"
+               "\x21\xf5\x4e\xe5\xf1\x95\x50\x82\x5a\x6e\x07\x00\x30\x51\x9e"
+               "\x94\x42\x63\xac\x1c\x67\x65\x28\x70\x65\x62\x1f\x9f\xcb\x32"
+               "\x01\x72\x3e\x32\x23\xb6\x3a\x46\xc2\x93\x8a\xa9\x53\xba\x84"
+               "\x01\xd0\xea\x77\xb8\xd2\x64\x90\x77\x55\x66\x40\x7b\x95\x67"
+               "\x3c\x0f\x4c\xc1\xce\x9f\xd9\x66\x14\x8d\x7e\xfd\xff\x26\xbb"
+               "\xf9\xf4\x8a\x21\xc6\xda\x35\xbf\xaa";
+    c.inLen  = XSTRLEN(c.input);
+    c.outLen = sizeof(hash);
+
+    test_sha[0] = a;
+    test_sha[1] = b;
+    test_sha[2] = c;
+
+    ret = wc_InitShake128(&sha, HEAP_HINT, devId);
+    if (ret != 0)
+        return -3120;
+
+    for (i = 0; i < times; ++i) {
+        ret = wc_Shake128_Update(&sha, (byte*)test_sha[i].input,
+            (word32)test_sha[i].inLen);
+        if (ret != 0)
+            ERROR_OUT(-3121 - i, exit);
+        ret = wc_Shake128_Final(&sha, hash, (word32)test_sha[i].outLen);
+        if (ret != 0)
+            ERROR_OUT(-3124 - i, exit);
+
+        if (XMEMCMP(hash, test_sha[i].output, test_sha[i].outLen) != 0)
+            ERROR_OUT(-3127 - i, exit);
+    }
+
+    /* Output of more than one block - squeezed and in one call. */
+    ret = wc_Shake128_Absorb(&sha, (byte*)b.input, (word32)b.inLen);
+    if (ret != 0)
+        ERROR_OUT(-3130, exit);
+    ret = wc_Shake128_SqueezeBlocks(&sha, squeeze, 1);
+    if (ret == 0)
+        ret = wc_Shake128_SqueezeBlocks(&sha, squeeze + WC_SHAKE128_BLOCK_SIZE,
+                                        2);
+    if (ret != 0)
+        ERROR_OUT(-3131, exit);
+    ret = wc_InitShake128(&sha, HEAP_HINT, devId);
+    if (ret == 0)
+        ret = wc_Shake128_Update(&sha, (byte*)b.input, (word32)b.inLen);
+    if (ret == 0)
+        ret = wc_Shake128_Final(&sha, full, (word32)sizeof(full) - 1);
+    if (ret != 0)
+        ERROR_OUT(-3132, exit);
+    if (XMEMCMP(squeeze, b.output, b.outLen) != 0)
+        ERROR_OUT(-3133, exit);
+    if (XMEMCMP(squeeze, full, sizeof(full) - 1) != 0)
+        ERROR_OUT(-3134, exit);
+    if (XMEMCMP(squeeze + 2 * WC_SHAKE128_BLOCK_SIZE, third_block, 32) != 0)
+        ERROR_OUT(-3135, exit);
+
+    /* BEGIN LARGE HASH TEST */ {
+    for (i = 0; i < (int)sizeof(large_input); i++) {
+        large_input[i] = (byte)(i & 0xFF);
+    }
+    times = 100;
+    for (i = 0; i < times; ++i) {
+        ret = wc_Shake128_Update(&sha, (byte*)large_input,
+            (word32)sizeof(large_input));
+        if (ret != 0)
+            ERROR_OUT(-3136, exit);
+    }
+    ret = wc_Shake128_Final(&sha, hash, (word32)sizeof(hash));
+    if (ret != 0)
+        ERROR_OUT(-3137, exit);
+    if (XMEMCMP(hash, large_digest, sizeof(hash)) != 0)
+        ERROR_OUT(-3138, exit);
+    } /* END LARGE HASH TEST */
+
+exit:
+    wc_Shake128_Free(&sha);
+
+    return ret;
+#else
+    return 0;
+#endif
+}
+#endif
+
 #ifdef WOLFSSL_SHAKE256
 int shake256_test(void)
 {
 #ifndef WOLFSSL_NO_SHAKE256
     wc_Shake  sha;
     byte  hash[114];
+    byte  squeeze[3 * WC_SHAKE256_BLOCK_SIZE];
+    byte  full[3 * WC_SHAKE256_BLOCK_SIZE];
 
     testVector a, b, c;
     testVector test_sha[3];
@@ -3081,6 +3229,10 @@ int shake256_test(void)
     int times = sizeof(test_sha) / sizeof(struct testVector), i;
 
     byte large_input[1024];
+    /* Bytes 272 - 303 of the output for "abc" - third block squeezed. */
+    const char* third_block =
+        "\xf3\x33\x45\x60\xea\x1d\x36\x39\x66\xca\xa7\xd8\xdd\xcb\xec\x7d"
+        "\xa5\x2b\x42\x21\x5c\x11\xd5\xf8\xee\x57\xf3\x41\xe3\x99\x34\x3c";
     const char* large_digest =
         "\x90\x32\x4a\xcc\xd1\xdf\xb8\x0b\x79\x1f\xb8\xc8\x5b\x54\xc8\xe7"
         "\x45\xf5\x60\x6b\x38\x26\xb2\x0a\xee\x38\x01\xf3\xd9\xfa\x96\x9f"
@@ -3148,6 +3300,30 @@ int shake256_test(void)
             ERROR_OUT(-3103 - i, exit);
     }
 
+    /* Output of more than one block - squeezed and in one call. */
+    ret = wc_Shake256_Absorb(&sha, (byte*)b.input, (word32)b.inLen);
+    if (ret != 0)
+        ERROR_OUT(-3107, exit);
+    ret = wc_Shake256_SqueezeBlocks(&sha, squeeze, 1);
+    if (ret == 0)
+        ret = wc_Shake256_SqueezeBlocks(&sha, squeeze + WC_SHAKE256_BLOCK_SIZE,
+                                        2);
+    if (ret != 0)
+        ERROR_OUT(-3108, exit);
+    ret = wc_InitShake256(&sha, HEAP_HINT, devId);
+    if (ret == 0)
+        ret = wc_Shake256_Update(&sha, (byte*)b.input, (word32)b.inLen);
+    if (ret == 0)
+        ret = wc_Shake256_Final(&sha, full, (word32)sizeof(full) - 1);
+    if (ret != 0)
+        ERROR_OUT(-3109, exit);
+    if (XMEMCMP(squeeze, b.output, b.outLen) != 0)
+        ERROR_OUT(-3110, exit);
+    if (XMEMCMP(squeeze, full, sizeof(full) - 1) != 0)
+        ERROR_OUT(-3111, exit);
+    if (XMEMCMP(squeeze + 2 * WC_SHAKE256_BLOCK_SIZE, third_block, 32) != 0)
+        ERROR_OUT(-3112, exit);
+
     /* BEGIN LARGE HASH TEST */ {
     for (i = 0; i < (int)sizeof(large_input); i++) {
         large_input[i] = (byte)(i & 0xFF);
@@ -10021,6 +10197,83 @@ static int random_rng_test(void)
 
 #if defined(HAVE_HASHDRBG) && !defined(CUSTOM_RAND_GENERATE_BLOCK)
 
+#ifdef HAVE_CTRDRBG
+static int random_ctr_drbg_test(void)
+{
+    /* NIST CAVP CTR_DRBG AES-256 use df, no reseed, COUNT 0 */
+    const byte testEntropy[] =
+    {
+        0x36, 0x40, 0x19, 0x40, 0xfa, 0x8b, 0x1f, 0xba, 0x91, 0xa1, 0x66, 0x1f,
+        0x21, 0x1d, 0x78, 0xa0, 0xb9, 0x38, 0x9a, 0x74, 0xe5, 0xbc, 0xcf, 0xec,
+        0xe8, 0xd7, 0x66, 0xaf, 0x1a, 0x6d, 0x3b, 0x14
+    };
+    const byte testNonce[] =
+    {
+        0x49, 0x6f, 0x25, 0xb0, 0xf1, 0x30, 0x1b, 0x4f, 0x50, 0x1b, 0xe3, 0x03,
+        0x80, 0xa1, 0x37, 0xeb
+    };
+    const byte testOutput[] =
+    {
+        0x58, 0x62, 0xeb, 0x38, 0xbd, 0x55, 0x8d, 0xd9, 0x78, 0xa6, 0x96, 0xe6,
+        0xdf, 0x16, 0x47, 0x82, 0xdd, 0xd8, 0x87, 0xe7, 0xe9, 0xa6, 0xc9, 0xf3,
+        0xf1, 0xfb, 0xaf, 0xb7, 0x89, 0x41, 0xb5, 0x35, 0xa6, 0x49, 0x12, 0xdf,
+        0xd2, 0x24, 0xc6, 0xdc, 0x74, 0x54, 0xe5, 0x25, 0x0b, 0x3d, 0x97, 0x16,
+        0x5e, 0x16, 0x26, 0x0c, 0x2f, 0xaf, 0x1c, 0xc7, 0x73, 0x5c, 0xb7, 0x5f,
+        0xb4, 0xf0, 0x7e, 0x1d
+    };
+    /* same instantiation, reseeded */
+    const byte testReseedEntropy[] =
+    {
+        0xe6, 0x2b, 0x8a, 0x8e, 0xe8, 0xf1, 0x41, 0xb6, 0x98, 0x05, 0x66, 0xe3,
+        0xbf, 0xe3, 0xc0, 0x49, 0x03, 0xda, 0xd4, 0xac, 0x2c, 0xdf, 0x9f, 0x22,
+        0x80, 0x01, 0x0a, 0x67, 0x39, 0xbc, 0x83, 0xd3
+    };
+    const byte testReseedOutput[] =
+    {
+        0xd6, 0x2a, 0x0d, 0xe8, 0xf3, 0x8e, 0x71, 0x1c, 0xc8, 0x93, 0x7f, 0x9f,
+        0xc1, 0x53, 0x8f, 0xf0, 0xe7, 0x79, 0xcc, 0x68, 0x20, 0xf5, 0x62, 0xbe,
+        0xea, 0x20, 0x33, 0xe4, 0xd1, 0x7f, 0x6e, 0xff, 0x12, 0x98, 0x27, 0xb6,
+        0x08, 0xad, 0x31, 0xac, 0xbe, 0x4f, 0x03, 0x04, 0xd2, 0xe7, 0xe4, 0xd2,
+        0x46, 0x31, 0x9e, 0x19, 0x45, 0x6f, 0x16, 0xb3, 0x01, 0x65, 0x70, 0x03,
+        0xdd, 0xb4, 0x5b, 0xf9
+    };
+
+    byte   output[sizeof(testOutput)];
+    WC_RNG rng;
+    int    ret;
+
+    ret = wc_RNG_CtrHealthTest_ex(0, testNonce, sizeof(testNonce),
+                                  testEntropy, sizeof(testEntropy), NULL, 0,
+                                  output, sizeof(output), HEAP_HINT, devId);
+    if (ret != 0)
+        return -6807;
+    if (XMEMCMP(testOutput, output, sizeof(output)) != 0)
+        return -6808;
+
+    ret = wc_RNG_CtrHealthTest_ex(1, testNonce, sizeof(testNonce),
+                                  testEntropy, sizeof(testEntropy),
+                                  testReseedEntropy, sizeof(testReseedEntropy),
+                                  output, sizeof(output), HEAP_HINT, devId);
+    if (ret != 0)
+        return -6809;
+    if (XMEMCMP(testReseedOutput, output, sizeof(output)) != 0)
+        return -6810;
+
+    if (wc_InitRngType_ex(&rng, -1, HEAP_HINT, devId) != BAD_FUNC_ARG)
+        return -6811;
+
+    ret = wc_InitRngType_ex(&rng, WC_DRBG_CTR, HEAP_HINT, devId);
+    if (ret != 0)
+        return -6812;
+
+    ret = _rng_test(&rng, -6320);
+
+    wc_FreeRng(&rng);
+
+    return ret;
+}
+#endif /* HAVE_CTRDRBG */
+
 int random_test(void)
 {
     const byte test1Entropy[] =
@@ -10126,6 +10379,11 @@ int random_test(void)
             return -6806;
     }
 #endif
+
+#ifdef HAVE_CTRDRBG
+    if ((ret = random_ctr_drbg_test()) != 0)
+        return ret;
+#endif
     return 0;
 }
 
@@ -17611,6 +17869,23 @@ int hkdf_test(void)
 
     if (XMEMCMP(okm1, res4, L) != 0)
         return -9507;
+
+    /* extract and expand as separate steps, on the device when set */
+    {
+        byte prk[WC_SHA256_DIGEST_SIZE];
+
+        ret = wc_HKDF_Extract_ex(WC_SHA256, salt1, 13, ikm1, 22, prk,
+                                 HEAP_HINT, devId);
+        if (ret != 0)
+            return -9508;
+        XMEMSET(okm1, 0, L);
+        ret = wc_HKDF_Expand_ex(WC_SHA256, prk, sizeof(prk), info1, 10, okm1,
+                                L, HEAP_HINT, devId);
+        if (ret != 0)
+            return -9509;
+        if (XMEMCMP(okm1, res4, L) != 0)
+            return -9510;
+    }
 #endif /* HAVE_FIPS */
 #endif /* NO_SHA256 */
 
@@ -20813,9 +21088,9 @@ int curve25519_test(void)
     if (ret != 0)
         return -10300;
 
-    wc_curve25519_init(&userA);
-    wc_curve25519_init(&userB);
-    wc_curve25519_init(&pubKey);
+    wc_curve25519_init_ex(&userA, HEAP_HINT, devId);
+    wc_curve25519_init_ex(&userB, HEAP_HINT, devId);
+    wc_curve25519_init_ex(&pubKey, HEAP_HINT, devId);
 
     /* make curve25519 keys */
     if (wc_curve25519_make_key(&rng, 32, &userA) != 0)
@@ -21737,10 +22012,10 @@ int ed25519_test(void)
     if (ret != 0)
         return -10600;
 
-    wc_ed25519_init(&key);
-    wc_ed25519_init(&key2);
+    wc_ed25519_init_ex(&key, HEAP_HINT, devId);
+    wc_ed25519_init_ex(&key2, HEAP_HINT, devId);
 #ifndef NO_ASN
-    wc_ed25519_init(&key3);
+    wc_ed25519_init_ex(&key3, HEAP_HINT, devId);
 #endif
     wc_ed25519_make_key(&rng, ED25519_KEY_SIZE, &key);
     wc_ed25519_make_key(&rng, ED25519_KEY_SIZE, &key2);
@@ -28355,6 +28630,109 @@ static int myCryptoDevCb(int devIdArg, wc_CryptoInfo* info, void* ctx)
             info->pk.ecdh.private_key->devId = devIdArg;
         }
     #endif /* HAVE_ECC */
+    #ifdef HAVE_CURVE25519
+        if (info->pk.type == WC_PK_TYPE_CURVE25519_KEYGEN) {
+            /* set devId to invalid, so software is used */
+            info->pk.curve25519kg.key->devId = INVALID_DEVID;
+
+            ret = wc_curve25519_make_key(info->pk.curve25519kg.rng,
+                info->pk.curve25519kg.size, info->pk.curve25519kg.key);
+
+            /* reset devId */
+            info->pk.curve25519kg.key->devId = devIdArg;
+        }
+    #ifdef HAVE_CURVE25519_SHARED_SECRET
+        else if (info->pk.type == WC_PK_TYPE_CURVE25519) {
+            /* set devId to invalid, so software is used */
+            info->pk.curve25519.private_key->devId = INVALID_DEVID;
+
+            ret = wc_curve25519_shared_secret_ex(
+                info->pk.curve25519.private_key,
+                info->pk.curve25519.public_key,
+                info->pk.curve25519.out, info->pk.curve25519.outlen,
+                info->pk.curve25519.endian);
+
+            /* reset devId */
+            info->pk.curve25519.private_key->devId = devIdArg;
+        }
+    #endif
+    #endif /* HAVE_CURVE25519 */
+    #ifdef HAVE_ED25519
+        if (info->pk.type == WC_PK_TYPE_ED25519_KEYGEN) {
+            /* set devId to invalid, so software is used */
+            info->pk.ed25519kg.key->devId = INVALID_DEVID;
+
+            ret = wc_ed25519_make_key(info->pk.ed25519kg.rng,
+                info->pk.ed25519kg.size, info->pk.ed25519kg.key);
+
+            /* reset devId */
+            info->pk.ed25519kg.key->devId = devIdArg;
+        }
+    #ifdef HAVE_ED25519_SIGN
+        else if (info->pk.type == WC_PK_TYPE_ED25519) {
+            /* set devId to invalid, so software is used */
+            info->pk.ed25519sign.key->devId = INVALID_DEVID;
+
+            if (info->pk.ed25519sign.type == (byte)Ed25519) {
+                ret = wc_ed25519_sign_msg(
+                    info->pk.ed25519sign.in, info->pk.ed25519sign.inLen,
+                    info->pk.ed25519sign.out, info->pk.ed25519sign.outLen,
+                    info->pk.ed25519sign.key);
+            }
+            else if (info->pk.ed25519sign.type == (byte)Ed25519ctx) {
+                ret = wc_ed25519ctx_sign_msg(
+                    info->pk.ed25519sign.in, info->pk.ed25519sign.inLen,
+                    info->pk.ed25519sign.out, info->pk.ed25519sign.outLen,
+                    info->pk.ed25519sign.key, info->pk.ed25519sign.context,
+                    info->pk.ed25519sign.contextLen);
+            }
+            else {
+                /* Ed25519ph is passed the hash of the message */
+                ret = wc_ed25519ph_sign_hash(
+                    info->pk.ed25519sign.in, info->pk.ed25519sign.inLen,
+                    info->pk.ed25519sign.out, info->pk.ed25519sign.outLen,
+                    info->pk.ed25519sign.key, info->pk.ed25519sign.context,
+                    info->pk.ed25519sign.contextLen);
+            }
+
+            /* reset devId */
+            info->pk.ed25519sign.key->devId = devIdArg;
+        }
+    #endif
+    #ifdef HAVE_ED25519_VERIFY
+        else if (info->pk.type == WC_PK_TYPE_ED25519_VERIFY) {
+            /* set devId to invalid, so software is used */
+            info->pk.ed25519verify.key->devId = INVALID_DEVID;
+
+            if (info->pk.ed25519verify.type == (byte)Ed25519) {
+                ret = wc_ed25519_verify_msg(
+                    info->pk.ed25519verify.sig, info->pk.ed25519verify.sigLen,
+                    info->pk.ed25519verify.msg, info->pk.ed25519verify.msgLen,
+                    info->pk.ed25519verify.res, info->pk.ed25519verify.key);
+            }
+            else if (info->pk.ed25519verify.type == (byte)Ed25519ctx) {
+                ret = wc_ed25519ctx_verify_msg(
+                    info->pk.ed25519verify.sig, info->pk.ed25519verify.sigLen,
+                    info->pk.ed25519verify.msg, info->pk.ed25519verify.msgLen,
+                    info->pk.ed25519verify.res, info->pk.ed25519verify.key,
+                    info->pk.ed25519verify.context,
+                    info->pk.ed25519verify.contextLen);
+            }
+            else {
+                /* Ed25519ph is passed the hash of the message */
+                ret = wc_ed25519ph_verify_hash(
+                    info->pk.ed25519verify.sig, info->pk.ed25519verify.sigLen,
+                    info->pk.ed25519verify.msg, info->pk.ed25519verify.msgLen,
+                    info->pk.ed25519verify.res, info->pk.ed25519verify.key,
+                    info->pk.ed25519verify.context,
+                    info->pk.ed25519verify.contextLen);
+            }
+
+            /* reset devId */
+            info->pk.ed25519verify.key->devId = devIdArg;
+        }
+    #endif
+    #endif /* HAVE_ED25519 */
     }
     else if (info->algo_type == WC_ALGO_TYPE_CIPHER) {
 #if !defined(NO_AES) || !defined(NO_DES3)
@@ -28462,7 +28840,8 @@ static int myCryptoDevCb(int devIdArg, wc_CryptoInfo* info, void* ctx)
     #endif /* !NO_DES3 */
 #endif /* !NO_AES || !NO_DES3 */
     }
-#if !defined(NO_SHA) || !defined(NO_SHA256)
+#if !defined(NO_SHA) || !defined(NO_SHA256) || defined(WOLFSSL_SHA384) || \
+    defined(WOLFSSL_SHA512)
     else if (info->algo_type == WC_ALGO_TYPE_HASH) {
     #if !defined(NO_SHA)
         if (info->hash.type == WC_HASH_TYPE_SHA) {
@@ -28513,11 +28892,61 @@ static int myCryptoDevCb(int devIdArg, wc_CryptoInfo* info, void* ctx)
             info->hash.sha256->devId = devIdArg;
         }
         else
+    #endif
+    #ifdef WOLFSSL_SHA384
+        if (info->hash.type == WC_HASH_TYPE_SHA384) {
+            if (info->hash.sha384 == NULL)
+                return NOT_COMPILED_IN;
+
+            /* set devId to invalid, so software is used */
+            info->hash.sha384->devId = INVALID_DEVID;
+
+            if (info->hash.in != NULL) {
+                ret = wc_Sha384Update(
+                    info->hash.sha384,
+                    info->hash.in,
+                    info->hash.inSz);
+            }
+            if (info->hash.digest != NULL) {
+                ret = wc_Sha384Final(
+                    info->hash.sha384,
+                    info->hash.digest);
+            }
+
+            /* reset devId */
+            info->hash.sha384->devId = devIdArg;
+        }
+        else
+    #endif
+    #ifdef WOLFSSL_SHA512
+        if (info->hash.type == WC_HASH_TYPE_SHA512) {
+            if (info->hash.sha512 == NULL)
+                return NOT_COMPILED_IN;
+
+            /* set devId to invalid, so software is used */
+            info->hash.sha512->devId = INVALID_DEVID;
+
+            if (info->hash.in != NULL) {
+                ret = wc_Sha512Update(
+                    info->hash.sha512,
+                    info->hash.in,
+                    info->hash.inSz);
+            }
+            if (info->hash.digest != NULL) {
+                ret = wc_Sha512Final(
+                    info->hash.sha512,
+                    info->hash.digest);
+            }
+
+            /* reset devId */
+            info->hash.sha512->devId = devIdArg;
+        }
+        else
     #endif
         {
         }
     }
-#endif /* !NO_SHA || !NO_SHA256 */
+#endif /* !NO_SHA || !NO_SHA256 || WOLFSSL_SHA384 || WOLFSSL_SHA512 */
 #ifndef NO_HMAC
     else if (info->algo_type == WC_ALGO_TYPE_HMAC) {
         if (info->hmac.hmac == NULL)
@@ -28542,6 +28971,23 @@ static int myCryptoDevCb(int devIdArg, wc_CryptoInfo* info, void* ctx)
         info->hmac.hmac->devId = devIdArg;
     }
 #endif
+#ifdef HAVE_HKDF
+    else if (info->algo_type == WC_ALGO_TYPE_KDF) {
+        /* use software with an invalid devId */
+        if (info->kdf.type == WC_KDF_TYPE_HKDF_EXTRACT) {
+            ret = wc_HKDF_Extract_ex(info->kdf.hashType,
+                info->kdf.salt, info->kdf.saltSz,
+                info->kdf.inKey, info->kdf.inKeySz,
+                info->kdf.out, HEAP_HINT, INVALID_DEVID);
+        }
+        else if (info->kdf.type == WC_KDF_TYPE_HKDF_EXPAND) {
+            ret = wc_HKDF_Expand_ex(info->kdf.hashType,
+                info->kdf.inKey, info->kdf.inKeySz,
+                info->kdf.info, info->kdf.infoSz,
+                info->kdf.out, info->kdf.outSz, HEAP_HINT, INVALID_DEVID);
+        }
+    }
+#endif
 
     (void)devIdArg;
     (void)myCtx;
@@ -28613,6 +29059,26 @@ int cryptocb_test(void)
         ret = pbkdf2_test();
     #endif
 #endif
+#ifdef WOLFSSL_SHA384
+    if (ret == 0)
+        ret = sha384_test();
+#endif
+#ifdef WOLFSSL_SHA512
+    if (ret == 0)
+        ret = sha512_test();
+#endif
+#if defined(HAVE_HKDF) && (!defined(NO_SHA) || !defined(NO_SHA256))
+    if (ret == 0)
+        ret = hkdf_test();
+#endif
+#ifdef HAVE_CURVE25519
+    if (ret == 0)
+        ret = curve25519_test();
+#endif
+#ifdef HAVE_ED25519
+    if (ret == 0)
+        ret = ed25519_test();
+#endif
 
     /* reset devId */
     devId = INVALID_DEVID;
@@ -1677,6 +1677,12 @@ WOLFSSL_LOCAL int  CheckVersion(WOLFSSL *ssl, ProtocolVersion pv);
 WOLFSSL_LOCAL int  PickHashSigAlgo(WOLFSSL* ssl, const byte* hashSigAlgo,
                                    word32 hashSigAlgoSz);
 WOLFSSL_LOCAL int  DecodePrivateKey(WOLFSSL *ssl, word16* length);
+#if defined(WC_RSA_PRECOMPUTE) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_RSA_PUBLIC_ONLY) && !defined(NO_CERTS)
+    /* CTX keeps its RSA private key decoded and precomputed */
+    #define WOLFSSL_CTX_RSA_KEY
+WOLFSSL_LOCAL void FreeCtxRsaKey(WOLFSSL_CTX* ctx);
+#endif
 #ifdef HAVE_PK_CALLBACKS
 WOLFSSL_LOCAL int GetPrivateKeySigSize(WOLFSSL* ssl);
 #ifndef NO_ASN
@@ -1783,6 +1789,17 @@ enum {
     #define STATIC_BUFFER_LEN RECORD_HEADER_SZ
 #endif
 
+#ifdef WOLFSSL_IO_SENDV
+    /* records SendData builds before handing them to one vectored send */
+    #ifndef WOLFSSL_SENDV_RECORDS
+        #define WOLFSSL_SENDV_RECORDS 8
+    #endif
+    /* iovec entries passed to the vectored send callback per call */
+    #ifndef WOLFSSL_SENDV_MAX_IOV
+        #define WOLFSSL_SENDV_MAX_IOV 16
+    #endif
+#endif
+
 typedef struct {
     ALIGN16 byte staticBuffer[STATIC_BUFFER_LEN];
     byte*  buffer;       /* place holder for static or dynamic buffer */
@@ -1862,13 +1879,52 @@ struct WOLFSSL_CIPHER {
     typedef struct WOLFSSL_OCSP WOLFSSL_OCSP;
 #endif
 
+#ifndef OCSP_TABLE_SIZE
+    #define OCSP_TABLE_SIZE 11
+#endif
+#ifndef OCSP_STATUS_TABLE_SIZE
+    #define OCSP_STATUS_TABLE_SIZE 97
+#endif
+
+#if defined(HAVE_OCSP_REFRESH) && !defined(WOLFSSL_PTHREADS)
+    #undef HAVE_OCSP_REFRESH
+#endif
+
+#if !defined(NO_WOLFSSL_SERVER) && defined(HAVE_OCSP) && \
+    defined(HAVE_TLS_EXTENSIONS) && !defined(NO_WOLFSSL_STAPLE_CACHE) && \
+    (defined(HAVE_CERTIFICATE_STATUS_REQUEST) || \
+     defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2))
+    #define WOLFSSL_STAPLE_CACHE
+
+/* Encoded CertificateStatus body for a CTX certificate, shared by its
+ * handshakes. Reference counted under the stapling OCSP lock. */
+typedef struct StapleCache {
+    int    refCount;        /* CTX and handshakes sending it */
+    word32 generation;      /* OCSP cache generation it was built from */
+    long   nextUpdate;      /* response nextUpdate, 0 if unknown */
+    word32 length;          /* length of msg */
+    byte   msg[1];          /* status_type, length and OCSP response */
+} StapleCache;
+#endif
+
 /* wolfSSL OCSP controller */
 #ifdef HAVE_OCSP
 struct WOLFSSL_OCSP {
     WOLFSSL_CERT_MANAGER* cm;            /* pointer back to cert manager */
     OcspEntry*            ocspList;      /* OCSP response list */
+    OcspEntry*            ocspTable[OCSP_TABLE_SIZE]; /* ocspList by issuer */
+    CertStatus*           statusTable[OCSP_STATUS_TABLE_SIZE]; /* by serial */
     wolfSSL_Mutex         ocspLock;      /* OCSP list lock */
     int                   error;
+    word32                hits;          /* status served from cache */
+    word32                misses;        /* status fetched from responder */
+    word32                refreshes;     /* status renewed ahead of expiry */
+    word32                generation;    /* bumped when a status is stored */
+#ifdef HAVE_OCSP_REFRESH
+    pthread_cond_t        cond;          /* wakes refresh thread to stop */
+    pthread_t             tid;           /* refresh thread */
+    int                   refreshStop;   /* refresh thread stop predicate */
+#endif
 #if defined(OPENSSL_ALL) || defined(OPENSSL_EXTRA) || \
     defined(WOLFSSL_NGINX) || defined(WOLFSSL_HAPROXY)
     int(*statusCb)(WOLFSSL*, void*);
@@ -1892,9 +1948,14 @@ typedef struct CRL_Entry CRL_Entry;
     typedef struct RevokedCert RevokedCert;
 #endif
 
+#ifndef CRL_TABLE_SIZE
+    #define CRL_TABLE_SIZE 11
+#endif
+
 /* Complete CRL */
 struct CRL_Entry {
     CRL_Entry* next;                      /* next entry */
+    CRL_Entry* tableNext;                 /* next entry in issuer table row */
     byte    issuerHash[CRL_DIGEST_SIZE];  /* issuer hash                 */
     /* byte    crlHash[CRL_DIGEST_SIZE];      raw crl data hash           */
     /* restore the hash here if needed for optimized comparisons */
@@ -1903,8 +1964,12 @@ struct CRL_Entry {
     byte    lastDateFormat;          /* last date format */
     byte    nextDateFormat;          /* next date format */
     RevokedCert* certs;              /* revoked cert list  */
+    RevokedCert** certsIndex;        /* certs sorted by serial, may be NULL */
     int          totalCerts;         /* number on list     */
+    int          totalIndex;         /* number in certsIndex */
     int     verified;
+    int     refCount;               /* list and CRL check references */
+    int     verifying;              /* checks using the signed data */
     byte*   toBeSigned;
     word32  tbsSz;
     byte*   signature;
@@ -1934,10 +1999,11 @@ struct CRL_Monitor {
 struct WOLFSSL_CRL {
     WOLFSSL_CERT_MANAGER* cm;            /* pointer back to cert manager */
     CRL_Entry*            crlList;       /* our CRL list */
+    CRL_Entry*            crlTable[CRL_TABLE_SIZE]; /* crlList by issuer */
 #ifdef HAVE_CRL_IO
     CbCrlIO               crlIOCb;
 #endif
-    wolfSSL_Mutex         crlLock;       /* CRL list lock */
+    wolfSSL_Mutex         crlLock;       /* CRL list and entry ref lock */
     CRL_Monitor           monitors[2];   /* PEM and DER possible */
 #ifdef HAVE_CRL_MONITOR
     pthread_cond_t        cond;          /* condition to signal setup */
@@ -1958,15 +2024,90 @@ struct WOLFSSL_CRL {
 
 
 #ifndef CA_TABLE_SIZE
-    #define CA_TABLE_SIZE 11
+    #define CA_TABLE_SIZE 11        /* initial rows, table grows as needed */
+#endif
+#ifndef CA_TABLE_MAX_LOAD
+    #define CA_TABLE_MAX_LOAD 2     /* average signers per row before growing */
 #endif
+
+#if defined(WOLFSSL_CERT_VERIFY_CACHE) && (defined(NO_SHA256) || \
+                                           defined(NO_ASN))
+    #undef WOLFSSL_CERT_VERIFY_CACHE
+#endif
+
+/* CA directory loads decode files on worker threads */
+#if defined(WOLFSSL_PARALLEL_CA_LOAD) && (defined(SINGLE_THREADED) || \
+    !defined(WOLFSSL_PTHREADS) || defined(NO_FILESYSTEM) || \
+    defined(NO_WOLFSSL_DIR) || !defined(WOLFSSL_PEM_TO_DER) || \
+    defined(WOLFSSL_WPAS) || defined(WOLFSSL_RENESAS_TSIP_TLS))
+    #undef WOLFSSL_PARALLEL_CA_LOAD
+#endif
+#ifndef WOLFSSL_CA_LOAD_THREADS
+    #define WOLFSSL_CA_LOAD_THREADS 4   /* default CA directory load workers */
+#endif
+
+/* read-only CA table snapshots build on the persistent cert cache */
+#if defined(WOLFSSL_CA_SNAPSHOT) && !defined(PERSIST_CERT_CACHE)
+    #undef WOLFSSL_CA_SNAPSHOT
+#endif
+
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    #ifndef CERT_VERIFY_CACHE_SZ
+        #define CERT_VERIFY_CACHE_SZ 256   /* default maximum entries */
+    #endif
+
+/* Chain CA cert whose signature a signer has already verified, keyed by the
+   digest of the DER. Keeps the decoded fields chain processing uses. */
+typedef struct VerifiedCert VerifiedCert;
+struct VerifiedCert {
+    VerifiedCert* next;                     /* next on hash row */
+    VerifiedCert* lruPrev;                  /* more recently used */
+    VerifiedCert* lruNext;                  /* less recently used */
+    byte    derHash[WC_SHA256_DIGEST_SIZE]; /* SHA-256 of the DER cert */
+    byte    signerHash[SIGNER_DIGEST_SIZE]; /* CA table hash of the signer */
+    byte    subjectHash[KEYID_SIZE];        /* hash of all subject names */
+    byte    extSubjKeyId[KEYID_SIZE];       /* subject key id */
+    word32  keyOID;
+    word32  pubKeySize;
+#ifndef NO_ASN_TIME
+    byte    beforeDate[MAX_DATE_SIZE];
+    byte    afterDate[MAX_DATE_SIZE];
+    byte    beforeDateFormat;
+    byte    afterDateFormat;
+#endif
+    byte    extSubjKeyIdSet;
+    byte    extAuthKeyIdSet;
+};
+#endif /* WOLFSSL_CERT_VERIFY_CACHE */
 #ifdef WOLFSSL_TRUST_PEER_CERT
     #define TP_TABLE_SIZE 11
 #endif
 
 /* wolfSSL Certificate Manager */
 struct WOLFSSL_CERT_MANAGER {
-    Signer*         caTable[CA_TABLE_SIZE]; /* the CA signer table */
+    Signer**        caTable;             /* the CA signer table, by SKID */
+#ifndef NO_SKID
+    Signer**        caNameTable;         /* same signers, by subject name */
+#endif
+    word32          caTableSz;           /* rows in caTable (and caNameTable) */
+    word32          caCount;             /* signers in caTable */
+#ifdef WOLFSSL_CA_SNAPSHOT
+    const byte*     caSnap;              /* attached read-only CA snapshot */
+    word32          caSnapSz;
+    byte            caSnapOwned;         /* unmap or free caSnap on detach */
+#endif
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    VerifiedCert**  vcTable;             /* verified certs, by DER digest */
+    VerifiedCert*   vcLruHead;           /* most recently used */
+    VerifiedCert*   vcLruTail;           /* least recently used */
+    word32          vcTableSz;           /* rows in vcTable */
+    word32          vcCount;             /* entries in vcTable */
+    word32          vcMax;               /* maximum entries, 0 is disabled */
+    word32          vcHits;              /* parse and verify skipped */
+    word32          vcMisses;            /* looked up and not found */
+    word32          vcEvictions;         /* dropped to stay within vcMax */
+    wolfSSL_Mutex   vcLock;              /* verified cert cache lock */
+#endif
     void*           heap;                /* heap helper */
 #ifdef WOLFSSL_TRUST_PEER_CERT
     TrustedPeerCert* tpTable[TP_TABLE_SIZE]; /* table of trusted peer certs */
@@ -1987,7 +2128,7 @@ struct WOLFSSL_CERT_MANAGER {
     CbMissingCRL    cbMissingCRL;        /* notify through cb of missing crl */
     CbOCSPIO        ocspIOCb;            /* I/O callback for OCSP lookup */
     CbOCSPRespFree  ocspRespFreeCb;      /* Frees OCSP Response from IO Cb */
-    wolfSSL_Mutex   caLock;              /* CA list lock */
+    wolfSSL_RwLock  caLock;              /* CA table lock */
     byte            crlEnabled;          /* is CRL on ? */
     byte            crlCheckAll;         /* always leaf, but all ? */
     byte            ocspEnabled;         /* is OCSP on ? */
@@ -2009,6 +2150,13 @@ WOLFSSL_LOCAL int CM_RestoreCertCache(WOLFSSL_CERT_MANAGER*, const char*);
 WOLFSSL_LOCAL int CM_MemSaveCertCache(WOLFSSL_CERT_MANAGER*, void*, int, int*);
 WOLFSSL_LOCAL int CM_MemRestoreCertCache(WOLFSSL_CERT_MANAGER*, const void*, int);
 WOLFSSL_LOCAL int CM_GetCertCacheMemSize(WOLFSSL_CERT_MANAGER*);
+#ifdef WOLFSSL_CA_SNAPSHOT
+WOLFSSL_LOCAL int CM_SaveCASnapshot(WOLFSSL_CERT_MANAGER*, const char*);
+WOLFSSL_LOCAL int CM_MapCASnapshot(WOLFSSL_CERT_MANAGER*, const char*);
+WOLFSSL_LOCAL int CM_MemSaveCASnapshot(WOLFSSL_CERT_MANAGER*, void*, int, int*);
+WOLFSSL_LOCAL int CM_UseCASnapshot(WOLFSSL_CERT_MANAGER*, const void*, int);
+WOLFSSL_LOCAL int CM_GetCASnapshotMemSize(WOLFSSL_CERT_MANAGER*);
+#endif
 WOLFSSL_LOCAL int CM_VerifyBuffer_ex(WOLFSSL_CERT_MANAGER* cm, const byte* buff,
                                     long sz, int format, int err_val);
 
@@ -2630,7 +2778,14 @@ struct WOLFSSL_CTX {
     byte        privateKeyId:1;
     int         privateKeySz;
     int         privateKeyDevId;
+#ifdef WOLFSSL_CTX_RSA_KEY
+    RsaKey*     rsaKey;            /* privateKey decoded and precomputed */
+    wolfSSL_Mutex rsaKeyMutex;     /* rsaKey creation and blinding pair */
+#endif
     WOLFSSL_CERT_MANAGER* cm;      /* our cert manager, ctx owns SSL will use */
+#ifdef WOLFSSL_PARALLEL_CA_LOAD
+    word16      caLoadThreads;     /* threads decoding CA directory loads */
+#endif
 #endif
 #ifdef KEEP_OUR_CERT
     WOLFSSL_X509*    ourCert;     /* keep alive a X509 struct of cert */
@@ -2719,6 +2874,9 @@ struct WOLFSSL_CTX {
 #endif
     CallbackIORecv CBIORecv;
     CallbackIOSend CBIOSend;
+#ifdef WOLFSSL_IO_SENDV
+    CallbackIOSendv CBIOSendv;
+#endif
 #ifdef WOLFSSL_DTLS
     CallbackGenCookie CBIOCookie;       /* gen cookie callback */
 #ifdef WOLFSSL_SESSION_EXPORT
@@ -2803,6 +2961,9 @@ struct WOLFSSL_CTX {
          || defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2)
             OcspRequest* certOcspRequest;
         #endif
+        #ifdef WOLFSSL_STAPLE_CACHE
+            StapleCache* staple;        /* encoded status for certificate */
+        #endif
         #if defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2)
             OcspRequest* chainOcspRequest[MAX_CHAIN_DEPTH];
         #endif
@@ -2903,6 +3064,14 @@ int ProcessOldClientHello(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
     int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify);
     WOLFSSL_LOCAL
     int AlreadySigner(WOLFSSL_CERT_MANAGER* cm, byte* hash);
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    WOLFSSL_LOCAL
+    int GetVerifiedCert(WOLFSSL_CERT_MANAGER* cm, const byte* derHash,
+                        VerifiedCert* vc);
+    WOLFSSL_LOCAL
+    int AddVerifiedCert(WOLFSSL_CERT_MANAGER* cm, const byte* derHash,
+                        DecodedCert* cert);
+#endif
 #ifdef WOLFSSL_TRUST_PEER_CERT
     WOLFSSL_LOCAL
     int AddTrustedPeer(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int verify);
@@ -3181,6 +3350,9 @@ struct WOLFSSL_SESSION {
 #if defined(HAVE_EXT_CACHE) || defined(OPENSSL_EXTRA)
     byte               isAlloced;
 #endif
+#ifdef HAVE_EXT_CACHE
+    WOLFSSL_CTX*       ownerCtx;                  /* rem_sess_cb on eviction  */
+#endif
 #ifdef HAVE_EX_DATA
     WOLFSSL_CRYPTO_EX_DATA ex_data;
 #endif
@@ -3262,6 +3434,10 @@ typedef struct Buffers {
     bufferStatic    outputBuffer;
     buffer          domainName;            /* for client check */
     buffer          clearOutputBuffer;
+#ifdef WOLFSSL_ZERO_COPY_READ
+    byte*           userInput;             /* caller's record buffer */
+    word32          userInputSz;
+#endif
     buffer          sig;                   /* signature data */
     buffer          digest;                /* digest data */
     int             prevSent;              /* previous plain text bytes sent
@@ -3906,6 +4082,9 @@ struct WOLFSSL {
 #endif
     CallbackIORecv  CBIORecv;
     CallbackIOSend  CBIOSend;
+#ifdef WOLFSSL_IO_SENDV
+    CallbackIOSendv CBIOSendv;
+#endif
 #ifdef WOLFSSL_STATIC_MEMORY
     WOLFSSL_HEAP_HINT heap_hint;
 #endif
@@ -4354,6 +4533,9 @@ WOLFSSL_LOCAL int SendChangeCipher(WOLFSSL*);
 WOLFSSL_LOCAL int SendTicket(WOLFSSL*);
 WOLFSSL_LOCAL int DoClientTicket(WOLFSSL*, const byte*, word32);
 WOLFSSL_LOCAL int SendData(WOLFSSL*, const void*, int);
+#ifdef WOLFSSL_IO_SENDV
+WOLFSSL_LOCAL int SendDataV(WOLFSSL*, const struct iovec*, int, int);
+#endif
 #ifdef WOLFSSL_TLS13
 WOLFSSL_LOCAL int SendTls13ServerHello(WOLFSSL*, byte);
 #endif
@@ -4371,6 +4553,10 @@ WOLFSSL_LOCAL int SendCertificateStatus(WOLFSSL*);
 WOLFSSL_LOCAL int SendServerKeyExchange(WOLFSSL*);
 WOLFSSL_LOCAL int SendBuffered(WOLFSSL*);
 WOLFSSL_LOCAL int ReceiveData(WOLFSSL*, byte*, int, int);
+#ifdef WOLFSSL_ZERO_COPY_READ
+WOLFSSL_LOCAL int ReceiveDataBorrow(WOLFSSL*, const byte**);
+WOLFSSL_LOCAL int ReceiveDataRelease(WOLFSSL*, int);
+#endif
 WOLFSSL_LOCAL int SendFinished(WOLFSSL*);
 WOLFSSL_LOCAL int SendAlert(WOLFSSL*, int, int);
 WOLFSSL_LOCAL int ProcessReply(WOLFSSL*);
@@ -4379,6 +4565,9 @@ WOLFSSL_LOCAL int SetCipherSpecs(WOLFSSL*);
 WOLFSSL_LOCAL int MakeMasterSecret(WOLFSSL*);
 
 WOLFSSL_LOCAL int AddSession(WOLFSSL*);
+#if defined(HAVE_EXT_CACHE) && !defined(NO_SESSION_CACHE)
+WOLFSSL_LOCAL void RemoveSessionCacheOwner(WOLFSSL_CTX* ctx);
+#endif
 WOLFSSL_LOCAL int DeriveKeys(WOLFSSL* ssl);
 WOLFSSL_LOCAL int StoreKeys(WOLFSSL* ssl, const byte* keyData, int side);
 
@@ -60,6 +60,13 @@ WOLFSSL_LOCAL int  CheckOcspRequest(WOLFSSL_OCSP* ocsp,
 WOLFSSL_LOCAL int CheckOcspResponse(WOLFSSL_OCSP *ocsp, byte *response, int responseSz,
                                     WOLFSSL_BUFFER_INFO *responseBuffer, CertStatus *status,
                                     OcspEntry *entry, OcspRequest *ocspRequest);
+WOLFSSL_LOCAL int  RefreshOCSP(WOLFSSL_OCSP* ocsp, long margin);
+WOLFSSL_LOCAL long OcspNextUpdate(WOLFSSL_OCSP* ocsp, OcspRequest* request);
+#ifdef HAVE_OCSP_REFRESH
+WOLFSSL_LOCAL int  StartOCSPRefresh(WOLFSSL_OCSP* ocsp, int interval,
+                                                                  long margin);
+WOLFSSL_LOCAL void StopOCSPRefresh(WOLFSSL_OCSP* ocsp);
+#endif
 
 #if defined(OPENSSL_ALL) || defined(WOLFSSL_NGINX) || defined(WOLFSSL_HAPROXY) || \
     defined(WOLFSSL_APACHE_HTTPD)
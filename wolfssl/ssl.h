@@ -796,6 +796,7 @@ WOLFSSL_API int wolfSSL_CTX_load_verify_locations_ex(WOLFSSL_CTX*, const char*,
                                                 const char*, unsigned int);
 WOLFSSL_ABI WOLFSSL_API int wolfSSL_CTX_load_verify_locations(WOLFSSL_CTX*,
                                                       const char*, const char*);
+WOLFSSL_API int wolfSSL_CTX_SetLoadVerifyThreads(WOLFSSL_CTX*, int threads);
 #ifdef WOLFSSL_TRUST_PEER_CERT
 WOLFSSL_API int wolfSSL_CTX_trust_peer_cert(WOLFSSL_CTX*, const char*, int);
 #endif
@@ -861,6 +862,13 @@ WOLFSSL_ABI WOLFSSL_API int  wolfSSL_connect(WOLFSSL*);
 WOLFSSL_ABI WOLFSSL_API int  wolfSSL_write(WOLFSSL*, const void*, int);
 WOLFSSL_ABI WOLFSSL_API int  wolfSSL_read(WOLFSSL*, void*, int);
 WOLFSSL_API int  wolfSSL_peek(WOLFSSL*, void*, int);
+#ifdef WOLFSSL_ZERO_COPY_READ
+/* record header, 2^14 bytes of data and 2048 bytes of expansion */
+#define WOLFSSL_READ_BUFFER_SZ (5 + 16384 + 2048)
+WOLFSSL_API int  wolfSSL_read_borrow(WOLFSSL*, const unsigned char**);
+WOLFSSL_API int  wolfSSL_read_release(WOLFSSL*, int);
+WOLFSSL_API int  wolfSSL_set_read_buffer(WOLFSSL*, unsigned char*, int);
+#endif
 WOLFSSL_API int  wolfSSL_accept(WOLFSSL*);
 WOLFSSL_API int  wolfSSL_CTX_mutual_auth(WOLFSSL_CTX* ctx, int req);
 WOLFSSL_API int  wolfSSL_mutual_auth(WOLFSSL* ssl, int req);
@@ -1001,12 +1009,36 @@ WOLFSSL_API int  wolfSSL_memsave_session_cache(void*, int);
 WOLFSSL_API int  wolfSSL_memrestore_session_cache(const void*, int);
 WOLFSSL_API int  wolfSSL_get_session_cache_memsize(void);
 
+#ifdef WOLFSSL_DYNAMIC_SESSION_CACHE
+/* session cache eviction for a full row */
+enum {
+    WOLFSSL_SESSION_EVICT_ROUND_ROBIN = 0, /* oldest added session */
+    WOLFSSL_SESSION_EVICT_LRU         = 1  /* least recently used session */
+};
+/* run time session cache size, call before wolfSSL_Init */
+WOLFSSL_API int  wolfSSL_SetSessionCacheSize(unsigned int sessions, int evict);
+WOLFSSL_API unsigned int wolfSSL_GetSessionCacheSize(void);
+#if defined(WOLFSSL_SHARED_SESSION_CACHE) && defined(HAVE_SESSION_TICKET)
+WOLFSSL_API unsigned int wolfSSL_GetSessionCacheDroppedTickets(void);
+#endif
+#endif
+
 /* certificate cache persistence, uses ctx since certs are per ctx */
 WOLFSSL_API int  wolfSSL_CTX_save_cert_cache(WOLFSSL_CTX*, const char*);
 WOLFSSL_API int  wolfSSL_CTX_restore_cert_cache(WOLFSSL_CTX*, const char*);
 WOLFSSL_API int  wolfSSL_CTX_memsave_cert_cache(WOLFSSL_CTX*, void*, int, int*);
 WOLFSSL_API int  wolfSSL_CTX_memrestore_cert_cache(WOLFSSL_CTX*, const void*, int);
 WOLFSSL_API int  wolfSSL_CTX_get_cert_cache_memsize(WOLFSSL_CTX*);
+#ifdef WOLFSSL_CA_SNAPSHOT
+/* read-only CA table snapshots, mapped files are shared between processes,
+   saving over a mapped file leaves existing mappings on the old snapshot */
+WOLFSSL_API int  wolfSSL_CTX_save_ca_snapshot(WOLFSSL_CTX*, const char*);
+WOLFSSL_API int  wolfSSL_CTX_map_ca_snapshot(WOLFSSL_CTX*, const char*);
+WOLFSSL_API int  wolfSSL_CTX_memsave_ca_snapshot(WOLFSSL_CTX*, void*, int,
+                                                 int*);
+WOLFSSL_API int  wolfSSL_CTX_use_ca_snapshot(WOLFSSL_CTX*, const void*, int);
+WOLFSSL_API int  wolfSSL_CTX_get_ca_snapshot_memsize(WOLFSSL_CTX*);
+#endif
 
 /* only supports full name from cipher_name[] delimited by : */
 WOLFSSL_API int  wolfSSL_CTX_set_cipher_list(WOLFSSL_CTX*, const char*);
@@ -2282,6 +2314,10 @@ WOLFSSL_API int wolfSSL_make_eap_keys(WOLFSSL*, void* key, unsigned int len,
 #ifndef NO_CERTS
     /* SSL_CTX versions */
     WOLFSSL_API int wolfSSL_CTX_UnloadCAs(WOLFSSL_CTX*);
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    WOLFSSL_API int wolfSSL_CTX_EnableVerifyCache(WOLFSSL_CTX*, int maxEntries);
+    WOLFSSL_API int wolfSSL_CTX_DisableVerifyCache(WOLFSSL_CTX*);
+#endif
 #ifdef WOLFSSL_TRUST_PEER_CERT
     WOLFSSL_API int wolfSSL_CTX_Unload_trust_peers(WOLFSSL_CTX*);
     WOLFSSL_API int wolfSSL_CTX_trust_peer_buffer(WOLFSSL_CTX*,
@@ -2717,6 +2753,15 @@ WOLFSSL_API void* wolfSSL_GetRsaDecCtx(WOLFSSL* ssl);
     WOLFSSL_API int wolfSSL_CertManagerLoadCABuffer(WOLFSSL_CERT_MANAGER*,
                                   const unsigned char* in, long sz, int format);
     WOLFSSL_API int wolfSSL_CertManagerUnloadCAs(WOLFSSL_CERT_MANAGER* cm);
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    WOLFSSL_API int wolfSSL_CertManagerEnableVerifyCache(WOLFSSL_CERT_MANAGER*,
+                                                                int maxEntries);
+    WOLFSSL_API int wolfSSL_CertManagerDisableVerifyCache(
+                                                         WOLFSSL_CERT_MANAGER*);
+    WOLFSSL_API int wolfSSL_CertManagerGetVerifyCacheStats(
+                       WOLFSSL_CERT_MANAGER*, unsigned int* hits,
+                       unsigned int* misses, unsigned int* evictions);
+#endif
 #ifdef WOLFSSL_TRUST_PEER_CERT
     WOLFSSL_API int wolfSSL_CertManagerUnload_trust_peers(WOLFSSL_CERT_MANAGER* cm);
 #endif
@@ -2756,6 +2801,17 @@ WOLFSSL_API void* wolfSSL_GetRsaDecCtx(WOLFSSL* ssl);
                                                                    const char*);
     WOLFSSL_API int wolfSSL_CertManagerSetOCSP_Cb(WOLFSSL_CERT_MANAGER*,
                                                CbOCSPIO, CbOCSPRespFree, void*);
+#if defined(HAVE_OCSP)
+    WOLFSSL_API int wolfSSL_CertManagerRefreshOCSP(WOLFSSL_CERT_MANAGER*,
+                                                                   long margin);
+    WOLFSSL_API int wolfSSL_CertManagerGetOCSPStats(WOLFSSL_CERT_MANAGER*,
+          unsigned int* hits, unsigned int* misses, unsigned int* refreshes);
+#endif
+#ifdef HAVE_OCSP_REFRESH
+    WOLFSSL_API int wolfSSL_CertManagerStartOCSPRefresh(WOLFSSL_CERT_MANAGER*,
+                                                  int interval, long margin);
+    WOLFSSL_API int wolfSSL_CertManagerStopOCSPRefresh(WOLFSSL_CERT_MANAGER*);
+#endif
 
     WOLFSSL_API int wolfSSL_CertManagerEnableOCSPStapling(
                                                       WOLFSSL_CERT_MANAGER* cm);
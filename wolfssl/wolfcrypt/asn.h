@@ -964,6 +964,9 @@ struct Signer {
     word32 cm_idx;
 #endif
     Signer* next;
+#ifndef NO_SKID
+    Signer* nameNext;                /* next on subject name hash row */
+#endif
 };
 
 
@@ -1225,10 +1228,13 @@ enum Ocsp_Verify_Error {
 
 typedef struct OcspRequest  OcspRequest;
 typedef struct OcspResponse OcspResponse;
+typedef struct OcspEntry    OcspEntry;
 
 
 struct CertStatus {
     CertStatus* next;
+    CertStatus* tableNext;   /* next status in same OCSP hash row */
+    OcspEntry*  entry;       /* issuer entry this status belongs to */
 
     byte serial[EXTERNAL_SERIAL_SIZE];
     int serialSz;
@@ -1248,6 +1254,9 @@ struct CertStatus {
 
     byte*  rawOcspResponse;
     word32 rawOcspResponseSz;
+
+    byte*  url;              /* responder used, for refreshing */
+    int    urlSz;
 };
 
 
@@ -1301,8 +1310,6 @@ struct OcspRequest {
     void*  ssl;
 };
 
-typedef struct OcspEntry OcspEntry;
-
 #ifdef NO_SHA
 #define OCSP_DIGEST_SIZE WC_SHA256_DIGEST_SIZE
 #else
@@ -1312,6 +1319,7 @@ typedef struct OcspEntry OcspEntry;
 struct OcspEntry
 {
     OcspEntry *next;                      /* next entry             */
+    OcspEntry *tableNext;                 /* next entry in hash row */
     byte issuerHash[OCSP_DIGEST_SIZE];    /* issuer hash            */
     byte issuerKeyHash[OCSP_DIGEST_SIZE]; /* issuer public key hash */
     CertStatus *status;                   /* OCSP response list     */
@@ -62,6 +62,12 @@ typedef struct ChaCha {
     /* vpshufd reads 16 bytes but we only use bottom 4. */
     byte extra[12];
 #endif
+#ifdef WOLF_CRYPTO_CB
+    int    devId;
+    void*  devCtx;
+    word32 devKey[CHACHA_MAX_KEY_SZ / sizeof(word32)]; /* raw key */
+    word32 keySz;
+#endif
 } ChaCha;
 
 /**
@@ -73,6 +79,7 @@ WOLFSSL_API int wc_Chacha_SetIV(ChaCha* ctx, const byte* inIv, word32 counter);
 WOLFSSL_API int wc_Chacha_Process(ChaCha* ctx, byte* cipher, const byte* plain,
                               word32 msglen);
 WOLFSSL_API int wc_Chacha_SetKey(ChaCha* ctx, const byte* key, word32 keySz);
+WOLFSSL_API int wc_Chacha_Init(ChaCha* ctx, void* heap, int devId);
 
 #ifdef __cplusplus
     } /* extern "C" */
@@ -29,7 +29,7 @@
 
 /* Defines the Crypto Callback interface version, for compatibility */
 /* Increment this when Crypto Callback interface changes are made */
-#define CRYPTO_CB_VER   2
+#define CRYPTO_CB_VER   3
 
 
 #ifdef WOLF_CRYPTO_CB
@@ -49,6 +49,18 @@
 #ifndef NO_SHA256
     #include <wolfssl/wolfcrypt/sha256.h>
 #endif
+#if defined(WOLFSSL_SHA384) || defined(WOLFSSL_SHA512)
+    #include <wolfssl/wolfcrypt/sha512.h>
+#endif
+#ifdef HAVE_CURVE25519
+    #include <wolfssl/wolfcrypt/curve25519.h>
+#endif
+#ifdef HAVE_ED25519
+    #include <wolfssl/wolfcrypt/ed25519.h>
+#endif
+#if defined(HAVE_CHACHA) && defined(HAVE_POLY1305)
+    #include <wolfssl/wolfcrypt/chacha.h>
+#endif
 #ifndef NO_HMAC
     #include <wolfssl/wolfcrypt/hmac.h>
 #endif
@@ -58,12 +70,16 @@
 #ifndef NO_DES3
     #include <wolfssl/wolfcrypt/des3.h>
 #endif
+#ifdef WOLF_CRYPTO_CB_QUEUE
+    #include <wolfssl/wolfcrypt/wolfevent.h>
+#endif
 
 
 /* Crypto Information Structure for callbacks */
 typedef struct wc_CryptoInfo {
     int algo_type; /* enum wc_AlgoType */
-#if !defined(NO_RSA) || defined(HAVE_ECC)
+#if !defined(NO_RSA) || defined(HAVE_ECC) || defined(HAVE_CURVE25519) || \
+    defined(HAVE_ED25519)
     struct {
         int type; /* enum wc_PkType */
         union {
@@ -116,10 +132,53 @@ typedef struct wc_CryptoInfo {
                 ecc_key*    key;
             } eccverify;
         #endif
+        #ifdef HAVE_CURVE25519
+            struct {
+                WC_RNG*         rng;
+                int             size;
+                curve25519_key* key;
+            } curve25519kg;
+            struct {
+                curve25519_key* private_key;
+                curve25519_key* public_key;
+                byte*           out;
+                word32*         outlen;
+                int             endian;
+            } curve25519;
+        #endif
+        #ifdef HAVE_ED25519
+            struct {
+                WC_RNG*      rng;
+                int          size;
+                ed25519_key* key;
+            } ed25519kg;
+            struct {
+                const byte*  in;
+                word32       inLen;
+                byte*        out;
+                word32*      outLen;
+                ed25519_key* key;
+                byte         type;
+                const byte*  context;
+                byte         contextLen;
+            } ed25519sign;
+            struct {
+                const byte*  sig;
+                word32       sigLen;
+                const byte*  msg;
+                word32       msgLen;
+                int*         res;
+                ed25519_key* key;
+                byte         type;
+                const byte*  context;
+                byte         contextLen;
+            } ed25519verify;
+        #endif
         };
     } pk;
-#endif /* !NO_RSA || HAVE_ECC */
-#if !defined(NO_AES) || !defined(NO_DES3)
+#endif /* !NO_RSA || HAVE_ECC || HAVE_CURVE25519 || HAVE_ED25519 */
+#if !defined(NO_AES) || !defined(NO_DES3) || \
+    (defined(HAVE_CHACHA) && defined(HAVE_POLY1305))
     struct {
         int type; /* enum wc_CipherType */
         int enc;
@@ -166,10 +225,34 @@ typedef struct wc_CryptoInfo {
                 word32      sz;
             } des3;
         #endif
+        #if defined(HAVE_CHACHA) && defined(HAVE_POLY1305)
+            /* key is chacha->devKey, tag check failure is MAC_CMP_FAILED_E */
+            struct {
+                ChaCha*     chacha;
+                byte*       out;
+                const byte* in;
+                word32      sz;
+                const byte* iv;
+                byte*       authTag;
+                const byte* authIn;
+                word32      authInSz;
+            } chachapoly_enc;
+            struct {
+                ChaCha*     chacha;
+                byte*       out;
+                const byte* in;
+                word32      sz;
+                const byte* iv;
+                const byte* authTag;
+                const byte* authIn;
+                word32      authInSz;
+            } chachapoly_dec;
+        #endif
         };
     } cipher;
-#endif /* !NO_AES || !NO_DES3 */
-#if !defined(NO_SHA) || !defined(NO_SHA256)
+#endif /* !NO_AES || !NO_DES3 || (HAVE_CHACHA && HAVE_POLY1305) */
+#if !defined(NO_SHA) || !defined(NO_SHA256) || defined(WOLFSSL_SHA384) || \
+    defined(WOLFSSL_SHA512)
     struct {
         int type; /* enum wc_HashType */
         const byte* in;
@@ -182,9 +265,15 @@ typedef struct wc_CryptoInfo {
         #ifndef NO_SHA256
             wc_Sha256* sha256;
         #endif
+        #ifdef WOLFSSL_SHA384
+            wc_Sha384* sha384;
+        #endif
+        #ifdef WOLFSSL_SHA512
+            wc_Sha512* sha512;
+        #endif
         };
     } hash;
-#endif /* !NO_SHA || !NO_SHA256 */
+#endif /* !NO_SHA || !NO_SHA256 || WOLFSSL_SHA384 || WOLFSSL_SHA512 */
 #ifndef NO_HMAC
     struct {
         int macType; /* enum wc_HashType */
@@ -194,6 +283,20 @@ typedef struct wc_CryptoInfo {
         Hmac* hmac;
     } hmac;
 #endif
+#ifdef HAVE_HKDF
+    struct {
+        int type;     /* enum wc_KdfType */
+        int hashType; /* enum wc_HashType */
+        const byte* inKey;
+        word32 inKeySz;
+        const byte* salt; /* extract only */
+        word32 saltSz;
+        const byte* info; /* expand only */
+        word32 infoSz;
+        byte* out;
+        word32 outSz;
+    } kdf;
+#endif
 #ifndef WC_NO_RNG
     struct {
         WC_RNG* rng;
@@ -220,6 +323,31 @@ WOLFSSL_API void wc_CryptoCb_UnRegisterDevice(int devId);
 #define wc_CryptoDev_RegisterDevice   wc_CryptoCb_RegisterDevice
 #define wc_CryptoDev_UnRegisterDevice wc_CryptoCb_UnRegisterDevice
 
+#ifdef WOLF_CRYPTO_CB_QUEUE
+/* Queued crypto callback device.
+ * Public key and cipher operations on an object using the queue's devId
+ * return WC_PENDING_E and are completed by a pool of worker threads. Each
+ * completion is a WOLF_EVENT whose context is the wolfCrypt object (RsaKey,
+ * ecc_key, Aes, Des3) and whose ret is the operation result. Posted
+ * operations are dispatched to the workers as one batch by Submit, Poll or
+ * Wait. The object and every buffer passed to the operation must stay
+ * untouched until its event completes. A RSA operation is finished by
+ * calling the same function again; other results are final on completion.
+ * A NULL cb selects the built-in software device. */
+typedef struct wc_CryptoCbQueue wc_CryptoCbQueue;
+
+WOLFSSL_API int  wc_CryptoCb_QueueInit(wc_CryptoCbQueue** queue, int devId,
+    int threads, CryptoDevCallbackFunc cb, void* ctx, void* heap);
+WOLFSSL_API int  wc_CryptoCb_QueueSubmit(wc_CryptoCbQueue* queue);
+WOLFSSL_API int  wc_CryptoCb_QueuePoll(wc_CryptoCbQueue* queue, void* context,
+    WOLF_EVENT** events, int maxEvents, int* eventCount);
+WOLFSSL_API int  wc_CryptoCb_QueueWait(wc_CryptoCbQueue* queue, void* context,
+    int* result);
+WOLFSSL_API void wc_CryptoCb_QueueEventFree(wc_CryptoCbQueue* queue,
+    WOLF_EVENT* event);
+WOLFSSL_API void wc_CryptoCb_QueueFree(wc_CryptoCbQueue* queue);
+#endif /* WOLF_CRYPTO_CB_QUEUE */
+
 
 #ifndef NO_RSA
 WOLFSSL_LOCAL int wc_CryptoCb_Rsa(const byte* in, word32 inLen, byte* out,
@@ -245,6 +373,27 @@ WOLFSSL_LOCAL int wc_CryptoCb_EccVerify(const byte* sig, word32 siglen,
     const byte* hash, word32 hashlen, int* res, ecc_key* key);
 #endif /* HAVE_ECC */
 
+#ifdef HAVE_CURVE25519
+WOLFSSL_LOCAL int wc_CryptoCb_Curve25519Gen(WC_RNG* rng, int keySize,
+    curve25519_key* key);
+
+WOLFSSL_LOCAL int wc_CryptoCb_Curve25519(curve25519_key* private_key,
+    curve25519_key* public_key, byte* out, word32* outlen, int endian);
+#endif /* HAVE_CURVE25519 */
+
+#ifdef HAVE_ED25519
+WOLFSSL_LOCAL int wc_CryptoCb_Ed25519Gen(WC_RNG* rng, int keySize,
+    ed25519_key* key);
+
+WOLFSSL_LOCAL int wc_CryptoCb_Ed25519Sign(const byte* in, word32 inLen,
+    byte* out, word32 *outLen, ed25519_key* key, byte type,
+    const byte* context, byte contextLen);
+
+WOLFSSL_LOCAL int wc_CryptoCb_Ed25519Verify(const byte* sig, word32 sigLen,
+    const byte* msg, word32 msgLen, int* res, ed25519_key* key, byte type,
+    const byte* context, byte contextLen);
+#endif /* HAVE_ED25519 */
+
 #ifndef NO_AES
 #ifdef HAVE_AESGCM
 WOLFSSL_LOCAL int wc_CryptoCb_AesGcmEncrypt(Aes* aes, byte* out,
@@ -271,6 +420,15 @@ WOLFSSL_LOCAL int wc_CryptoCb_Des3Decrypt(Des3* des3, byte* out,
                                const byte* in, word32 sz);
 #endif /* !NO_DES3 */
 
+#if defined(HAVE_CHACHA) && defined(HAVE_POLY1305)
+WOLFSSL_LOCAL int wc_CryptoCb_ChaCha20Poly1305Encrypt(ChaCha* chacha,
+    byte* out, const byte* in, word32 sz, const byte* iv, byte* authTag,
+    const byte* authIn, word32 authInSz);
+WOLFSSL_LOCAL int wc_CryptoCb_ChaCha20Poly1305Decrypt(ChaCha* chacha,
+    byte* out, const byte* in, word32 sz, const byte* iv,
+    const byte* authTag, const byte* authIn, word32 authInSz);
+#endif /* HAVE_CHACHA && HAVE_POLY1305 */
+
 #ifndef NO_SHA
 WOLFSSL_LOCAL int wc_CryptoCb_ShaHash(wc_Sha* sha, const byte* in,
     word32 inSz, byte* digest);
@@ -280,11 +438,28 @@ WOLFSSL_LOCAL int wc_CryptoCb_ShaHash(wc_Sha* sha, const byte* in,
 WOLFSSL_LOCAL int wc_CryptoCb_Sha256Hash(wc_Sha256* sha256, const byte* in,
     word32 inSz, byte* digest);
 #endif /* !NO_SHA256 */
+
+#ifdef WOLFSSL_SHA384
+WOLFSSL_LOCAL int wc_CryptoCb_Sha384Hash(wc_Sha384* sha384, const byte* in,
+    word32 inSz, byte* digest);
+#endif /* WOLFSSL_SHA384 */
+
+#ifdef WOLFSSL_SHA512
+WOLFSSL_LOCAL int wc_CryptoCb_Sha512Hash(wc_Sha512* sha512, const byte* in,
+    word32 inSz, byte* digest);
+#endif /* WOLFSSL_SHA512 */
+
 #ifndef NO_HMAC
 WOLFSSL_LOCAL int wc_CryptoCb_Hmac(Hmac* hmac, int macType, const byte* in,
     word32 inSz, byte* digest);
 #endif /* !NO_HMAC */
 
+#ifdef HAVE_HKDF
+WOLFSSL_LOCAL int wc_CryptoCb_Hkdf(int devId, int kdfType, int hashType,
+    const byte* inKey, word32 inKeySz, const byte* salt, word32 saltSz,
+    const byte* info, word32 infoSz, byte* out, word32 outSz);
+#endif /* HAVE_HKDF */
+
 #ifndef WC_NO_RNG
 WOLFSSL_LOCAL int wc_CryptoCb_RandomBlock(WC_RNG* rng, byte* out, word32 sz);
 WOLFSSL_LOCAL int wc_CryptoCb_RandomSeed(OS_Seed* os, byte* seed, word32 sz);
@@ -492,6 +492,12 @@ int wc_ecc_sign_hash_ex(const byte* in, word32 inlen, WC_RNG* rng,
 WOLFSSL_API
 int wc_ecc_sign_set_k(const byte* k, word32 klen, ecc_key* key);
 #endif
+#ifdef WOLFSSL_SIGN_BATCH
+WOLFSSL_API
+int wc_ecc_sign_hash_batch(const byte* const* in, const word32* inlen,
+                           byte* const* out, word32* outlen, int* res,
+                           int count, WC_RNG* rng, ecc_key* key);
+#endif
 #endif /* HAVE_ECC_SIGN */
 
 #ifdef HAVE_ECC_VERIFY
@@ -501,6 +507,12 @@ int wc_ecc_verify_hash(const byte* sig, word32 siglen, const byte* hash,
 WOLFSSL_API
 int wc_ecc_verify_hash_ex(mp_int *r, mp_int *s, const byte* hash,
                           word32 hashlen, int* stat, ecc_key* key);
+#if defined(WOLFSSL_VERIFY_BATCH) && !defined(NO_ASN)
+WOLFSSL_API
+int wc_ecc_verify_hash_batch(const byte* const* sig, const word32* siglen,
+                             const byte* const* hash, const word32* hashlen,
+                             int* res, ecc_key* const* key, int count);
+#endif
 #endif /* HAVE_ECC_VERIFY */
 
 WOLFSSL_API
@@ -522,8 +534,12 @@ WOLFSSL_API
 int wc_ecc_set_flags(ecc_key* key, word32 flags);
 WOLFSSL_API
 void wc_ecc_fp_free(void);
+WOLFSSL_API
+int wc_ecc_fp_set_entries(int entries);
 WOLFSSL_LOCAL
 void wc_ecc_fp_init(void);
+WOLFSSL_LOCAL
+void wc_ecc_fp_cleanup(void);
 
 WOLFSSL_API
 int wc_ecc_set_curve(ecc_key* key, int keysize, int curve_id);
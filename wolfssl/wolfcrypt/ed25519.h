@@ -87,6 +87,10 @@ struct ed25519_key {
 #ifdef WOLFSSL_ASYNC_CRYPT
     WC_ASYNC_DEV asyncDev;
 #endif
+#ifdef WOLF_CRYPTO_CB
+    int devId;
+    void* devCtx; /* generic crypto callback context */
+#endif
 };
 
 
@@ -125,9 +129,19 @@ WOLFSSL_API
 int wc_ed25519ph_verify_msg(const byte* sig, word32 sigLen, const byte* msg,
                             word32 msgLen, int* stat, ed25519_key* key,
                             const byte* context, byte contextLen);
+#ifdef WOLFSSL_VERIFY_BATCH
+/* Ed25519 signatures, single or batched, are checked cofactored */
+WOLFSSL_API
+int wc_ed25519_verify_batch(const byte* const* sig, const word32* sigLen,
+                            const byte* const* msg, const word32* msgLen,
+                            int* res, ed25519_key* const* key, int count,
+                            WC_RNG* rng);
+#endif
 WOLFSSL_API
 int wc_ed25519_init(ed25519_key* key);
 WOLFSSL_API
+int wc_ed25519_init_ex(ed25519_key* key, void* heap, int devId);
+WOLFSSL_API
 void wc_ed25519_free(ed25519_key* key);
 WOLFSSL_API
 int wc_ed25519_import_public(const byte* in, word32 inLen, ed25519_key* key);
@@ -106,6 +106,13 @@ typedef struct {
   ge T2d;
 } ge_cached;
 
+#ifdef WOLFSSL_VERIFY_BATCH
+WOLFSSL_LOCAL int  ge_multi_scalarmult_vartime(ge_p2 *,const unsigned char *,
+                                const unsigned char *,const ge_p3 *,int,void *);
+WOLFSSL_LOCAL int  ge_p2_is_small_order(const ge_p2 *);
+WOLFSSL_LOCAL int  ge_p3_is_small_order(const ge_p3 *);
+#endif
+
 #endif /* !ED25519_SMALL */
 
 #endif /* HAVE_ED25519 */
@@ -182,6 +182,12 @@ WOLFSSL_API int wolfSSL_GetHmacMaxSize(void);
 
 WOLFSSL_LOCAL int _InitHmac(Hmac* hmac, int type, void* heap);
 
+#if defined(WOLFSSL_SHA256_MULTI_BUFFER) && !defined(NO_SHA256)
+WOLFSSL_API int wc_HmacSha256_MultiBuffer(const byte* const* key,
+                            const word32* keySz, const byte* const* data,
+                            const word32* sz, byte* const* mac, word32 count);
+#endif
+
 #ifdef HAVE_HKDF
 
 WOLFSSL_API int wc_HKDF_Extract(int type, const byte* salt, word32 saltSz,
@@ -189,6 +195,13 @@ WOLFSSL_API int wc_HKDF_Extract(int type, const byte* salt, word32 saltSz,
 WOLFSSL_API int wc_HKDF_Expand(int type, const byte* inKey, word32 inKeySz,
                                const byte* info, word32 infoSz,
                                byte* out,        word32 outSz);
+WOLFSSL_API int wc_HKDF_Extract_ex(int type, const byte* salt, word32 saltSz,
+                                   const byte* inKey, word32 inKeySz,
+                                   byte* out, void* heap, int devId);
+WOLFSSL_API int wc_HKDF_Expand_ex(int type, const byte* inKey, word32 inKeySz,
+                                  const byte* info, word32 infoSz,
+                                  byte* out, word32 outSz, void* heap,
+                                  int devId);
 
 WOLFSSL_API int wc_HKDF(int type, const byte* inKey, word32 inKeySz,
                     const byte* salt, word32 saltSz,
@@ -76,6 +76,12 @@
 #endif
 
 
+/* DRBG mechanisms for wc_InitRngType_ex */
+enum {
+    WC_DRBG_HASH = 0, /* SP 800-90A Hash_DRBG with SHA-256, the default */
+    WC_DRBG_CTR  = 1  /* SP 800-90A CTR_DRBG with AES-256, HAVE_CTRDRBG */
+};
+
 /* avoid redefinition of structs */
 #if !defined(HAVE_FIPS) || \
     (defined(HAVE_FIPS_VERSION) && (HAVE_FIPS_VERSION >= 2))
@@ -156,6 +162,10 @@ struct WC_RNG {
 #ifdef HAVE_HASHDRBG
     /* Hash-based Deterministic Random Bit Generator */
     struct DRBG* drbg;
+#ifdef HAVE_CTRDRBG
+    /* AES-256 CTR_DRBG, used instead of drbg when set */
+    struct CTR_DRBG* ctrDrbg;
+#endif
 #if defined(WOLFSSL_NO_MALLOC) && !defined(WOLFSSL_STATIC_MEMORY)
     #define DRBG_STRUCT_SZ ((sizeof(word32)*3) + (DRBG_SEED_LEN*2))
     #ifdef WOLFSSL_SMALL_STACK_CACHE
@@ -213,6 +223,19 @@ WOLFSSL_API int  wc_InitRngNonce_ex(WC_RNG* rng, byte* nonce, word32 nonceSz,
 WOLFSSL_ABI WOLFSSL_API int wc_RNG_GenerateBlock(WC_RNG*, byte*, word32 sz);
 WOLFSSL_API int  wc_RNG_GenerateByte(WC_RNG*, byte*);
 WOLFSSL_API int  wc_FreeRng(WC_RNG*);
+WOLFSSL_API int  wc_InitRngType_ex(WC_RNG* rng, int drbgType, void* heap,
+                                   int devId);
+#ifdef WOLFSSL_THREAD_LOCAL_RNG
+    /* RNGs seeded from a per thread parent DRBG. On unix the parent is
+     * instantiated again in a forked child on its first use there, unless
+     * WC_NO_THREAD_RNG_FORK_CHECK. Otherwise a forked child must call
+     * wc_RNG_ThreadLocalFree before creating new RNGs. */
+    WOLFSSL_API int  wc_InitRng_ThreadLocal(WC_RNG* rng, void* heap,
+                                            int devId);
+    WOLFSSL_API void wc_RNG_ThreadLocalFree(void);
+    WOLFSSL_LOCAL void wc_RNG_ThreadLocalInit(void);
+    WOLFSSL_LOCAL void wc_RNG_ThreadLocalCleanup(void);
+#endif
 #else
 #include <wolfssl/wolfcrypt/error-crypt.h>
 #define wc_InitRng(rng) NOT_COMPILED_IN
@@ -222,6 +245,7 @@ WOLFSSL_API int  wc_FreeRng(WC_RNG*);
 #define wc_RNG_GenerateBlock(rng, b, s) NOT_COMPILED_IN
 #define wc_RNG_GenerateByte(rng, b) NOT_COMPILED_IN
 #define wc_FreeRng(rng) (void)NOT_COMPILED_IN
+#define wc_InitRngType_ex(rng, t, h, d) NOT_COMPILED_IN
 #endif
 
 
@@ -240,6 +264,14 @@ WOLFSSL_API int  wc_FreeRng(WC_RNG*);
                                         const byte* entropyB, word32 entropyBSz,
                                         byte* output, word32 outputSz,
                                         void* heap, int devId);
+    #ifdef HAVE_CTRDRBG
+    WOLFSSL_API int wc_RNG_CtrHealthTest_ex(int reseed,
+                                        const byte* nonce, word32 nonceSz,
+                                        const byte* entropyA, word32 entropyASz,
+                                        const byte* entropyB, word32 entropyBSz,
+                                        byte* output, word32 outputSz,
+                                        void* heap, int devId);
+    #endif
 #endif /* HAVE_HASHDRBG */
 
 #ifdef __cplusplus
@@ -140,6 +140,12 @@ enum {
 #endif
 };
 
+#if defined(WC_RSA_PRECOMPUTE) && defined(USE_FAST_MATH) && \
+    !defined(RSA_LOW_MEM)
+    /* Montgomery constants of p and q are cached with the key */
+    #define WC_RSA_PRECOMPUTE_MONT
+#endif
+
 #ifdef WC_RSA_NONBLOCK
 typedef struct RsaNb {
     exptModNb_t exptmod; /* non-block expt_mod */
@@ -195,6 +201,17 @@ struct RsaKey {
 #if defined(WOLFSSL_CRYPTOCELL)
     rsa_context_t ctx;
 #endif
+#if defined(WC_RSA_PRECOMPUTE) && !defined(WOLFSSL_RSA_PUBLIC_ONLY)
+    byte   precomputed;           /* set by wc_RsaPrecompute() */
+    #ifdef WC_RSA_PRECOMPUTE_MONT
+    mp_int pR2, qR2;              /* R^2 mod p and R^2 mod q */
+    mp_digit pMp, qMp;            /* Montgomery constants of p and q */
+    #endif
+    #ifdef WC_RSA_BLINDING
+    mp_int blind, blindInv;       /* r^e mod n and 1/r mod n */
+    word32 blindCnt;              /* uses since blinding pair was generated */
+    #endif
+#endif
 };
 
 #ifndef WC_RSAKEY_TYPE_DEFINED
@@ -212,6 +229,10 @@ WOLFSSL_API int wc_InitRsaKey_Id(RsaKey* key, unsigned char* id, int len,
                                  void* heap, int devId);
 #endif
 WOLFSSL_API int  wc_CheckRsaKey(RsaKey* key);
+#if defined(WC_RSA_PRECOMPUTE) && !defined(WOLFSSL_RSA_PUBLIC_ONLY)
+WOLFSSL_API int  wc_RsaPrecompute(RsaKey* key, WC_RNG* rng);
+WOLFSSL_API int  wc_RsaPrecomputeCopy(RsaKey* src, RsaKey* dst, WC_RNG* rng);
+#endif
 #ifdef WOLFSSL_XILINX_CRYPT
 WOLFSSL_LOCAL int wc_InitRsaHw(RsaKey* key);
 #endif /* WOLFSSL_XILINX_CRYPT */
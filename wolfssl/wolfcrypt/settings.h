@@ -2223,6 +2223,17 @@ extern void uITRON4_free(void *p) ;
     #define WOLF_CRYPTO_CB
 #endif
 
+/* Queued crypto callbacks are completed through wolf events */
+#ifdef WOLF_CRYPTO_CB_QUEUE
+    #ifdef SINGLE_THREADED
+        #error WOLF_CRYPTO_CB_QUEUE requires thread support
+    #endif
+    #undef  WOLF_CRYPTO_CB
+    #define WOLF_CRYPTO_CB
+    #undef  HAVE_WOLF_EVENT
+    #define HAVE_WOLF_EVENT
+#endif
+
 #if defined(WOLFSSL_TLS13) && defined(WOLFSSL_NO_SIGALG)
     #error TLS 1.3 requires the Signature Algorithms extension to be enabled
 #endif
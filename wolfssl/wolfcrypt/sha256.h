@@ -204,6 +204,17 @@ WOLFSSL_API void wc_Sha256SizeSet(wc_Sha256*, word32);
     WOLFSSL_API int wc_Sha256GetFlags(wc_Sha256* sha256, word32* flags);
 #endif
 
+#ifdef WOLFSSL_SHA256_MULTI_BUFFER
+    /* messages hashed side by side by wc_Sha256_MultiBuffer */
+    #define WC_SHA256_MB_LANES 8
+
+    WOLFSSL_API int wc_Sha256_MultiBuffer(const byte* const* data,
+                            const word32* sz, byte* const* hash, word32 count);
+    WOLFSSL_LOCAL int wc_Sha256_MultiBufferPrefix(const byte* const* prefix,
+                            const byte* const* data, const word32* sz,
+                            byte* const* hash, word32 count);
+#endif
+
 #ifdef WOLFSSL_SHA224
 /* avoid redefinition of structs */
 #if !defined(HAVE_FIPS) || \
@@ -42,6 +42,8 @@
 
 /* in bytes */
 enum {
+    WC_SHA3_128_COUNT        = 21,
+
     WC_SHA3_224              = WC_HASH_TYPE_SHA3_224,
     WC_SHA3_224_DIGEST_SIZE  = 28,
     WC_SHA3_224_COUNT        = 18,
@@ -66,6 +68,10 @@ enum {
     WC_SHA3_384_BLOCK_SIZE = 104,
     WC_SHA3_512_BLOCK_SIZE = 72,
 #endif
+
+    /* Bytes of output in each block squeezed out of SHAKE. */
+    WC_SHAKE128_BLOCK_SIZE = 168,
+    WC_SHAKE256_BLOCK_SIZE = 136,
 };
 
 #ifndef NO_OLD_WC_NAMES
@@ -145,11 +151,25 @@ WOLFSSL_API void wc_Sha3_512_Free(wc_Sha3*);
 WOLFSSL_API int wc_Sha3_512_GetHash(wc_Sha3*, byte*);
 WOLFSSL_API int wc_Sha3_512_Copy(wc_Sha3* src, wc_Sha3* dst);
 
+WOLFSSL_API int wc_InitShake128(wc_Shake*, void*, int);
+WOLFSSL_API int wc_Shake128_Update(wc_Shake*, const byte*, word32);
+WOLFSSL_API int wc_Shake128_Final(wc_Shake*, byte*, word32);
+WOLFSSL_API int wc_Shake128_Absorb(wc_Shake*, const byte*, word32);
+WOLFSSL_API int wc_Shake128_SqueezeBlocks(wc_Shake*, byte*, word32);
+WOLFSSL_API void wc_Shake128_Free(wc_Shake*);
+WOLFSSL_API int wc_Shake128_Copy(wc_Shake* src, wc_Sha3* dst);
+WOLFSSL_API int wc_Shake128_MultiBuffer(const byte* const* data,
+    const word32* sz, byte* const* out, word32 outSz, word32 count);
+
 WOLFSSL_API int wc_InitShake256(wc_Shake*, void*, int);
 WOLFSSL_API int wc_Shake256_Update(wc_Shake*, const byte*, word32);
 WOLFSSL_API int wc_Shake256_Final(wc_Shake*, byte*, word32);
+WOLFSSL_API int wc_Shake256_Absorb(wc_Shake*, const byte*, word32);
+WOLFSSL_API int wc_Shake256_SqueezeBlocks(wc_Shake*, byte*, word32);
 WOLFSSL_API void wc_Shake256_Free(wc_Shake*);
 WOLFSSL_API int wc_Shake256_Copy(wc_Shake* src, wc_Sha3* dst);
+WOLFSSL_API int wc_Shake256_MultiBuffer(const byte* const* data,
+    const word32* sz, byte* const* out, word32 outSz, word32 count);
 
 #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
     WOLFSSL_API int wc_Sha3_SetFlags(wc_Sha3* sha3, word32 flags);
@@ -80,6 +80,45 @@ WOLFSSL_API int wc_SignatureGenerate_ex(
     const void* key, word32 key_len,
     WC_RNG* rng, int verify);
 
+#ifdef WOLFSSL_SIGN_BATCH
+#ifndef WC_SIG_BATCH_MAX
+    #define WC_SIG_BATCH_MAX 16   /* requests queued before a batch is run */
+#endif
+
+/* Signature request queued on a batch, owned by the caller */
+typedef struct wc_SignatureBatchReq {
+    const byte* hash_data;
+    word32      hash_len;
+    byte*       sig;
+    word32*     sig_len;
+    int         ret;          /* WC_PENDING_E until the batch has run */
+} wc_SignatureBatchReq;
+
+/* Queue of signatures made with the same private key, ECDSA batches share
+   the modular inversions, RSA requests are signed one at a time */
+typedef struct wc_SignatureBatch {
+    enum wc_SignatureType  sig_type;
+    void*                  key;
+    word32                 key_len;
+    WC_RNG*                rng;
+    int                    count;
+    wc_SignatureBatchReq*  req[WC_SIG_BATCH_MAX];
+#ifndef SINGLE_THREADED
+    wolfSSL_Mutex          lock;
+#endif
+} wc_SignatureBatch;
+
+WOLFSSL_API int wc_SignatureBatchInit(wc_SignatureBatch* batch,
+    enum wc_SignatureType sig_type, void* key, word32 key_len, WC_RNG* rng);
+WOLFSSL_API int wc_SignatureBatchSubmit(wc_SignatureBatch* batch,
+    wc_SignatureBatchReq* req, const byte* hash_data, word32 hash_len,
+    byte* sig, word32* sig_len);
+WOLFSSL_API int wc_SignatureBatchFlush(wc_SignatureBatch* batch);
+WOLFSSL_API int wc_SignatureBatchPoll(wc_SignatureBatch* batch,
+    wc_SignatureBatchReq* req);
+WOLFSSL_API void wc_SignatureBatchFree(wc_SignatureBatch* batch);
+#endif /* WOLFSSL_SIGN_BATCH */
+
 #ifdef __cplusplus
     } /* extern "C" */
 #endif
@@ -558,6 +558,9 @@ int fp_montgomery_reduce(fp_int *a, fp_int *m, fp_digit mp);
 int fp_exptmod(fp_int *a, fp_int *b, fp_int *c, fp_int *d);
 int fp_exptmod_ex(fp_int *a, fp_int *b, int minDigits, fp_int *c, fp_int *d);
 int fp_exptmod_nct(fp_int *a, fp_int *b, fp_int *c, fp_int *d);
+int fp_exptmod_mont_setup(fp_int *p, fp_digit *mp, fp_int *r2);
+int fp_exptmod_mont(fp_int *a, fp_int *b, fp_int *c, fp_digit mp, fp_int *r2,
+                    fp_int *d);
 
 #ifdef WC_RSA_NONBLOCK
 
@@ -750,6 +753,9 @@ MP_API int  mp_exptmod (mp_int * g, mp_int * x, mp_int * p, mp_int * y);
 MP_API int  mp_exptmod_ex (mp_int * g, mp_int * x, int minDigits, mp_int * p,
                            mp_int * y);
 MP_API int  mp_exptmod_nct (mp_int * g, mp_int * x, mp_int * p, mp_int * y);
+MP_API int  mp_exptmod_mont_setup (mp_int * p, mp_digit * mp, mp_int * r2);
+MP_API int  mp_exptmod_mont (mp_int * g, mp_int * x, mp_int * p, mp_digit mp,
+                             mp_int * r2, mp_int * y);
 MP_API int  mp_mul_2d(mp_int *a, int b, mp_int *c);
 MP_API int  mp_2expt(mp_int* a, int b);
 
@@ -671,6 +671,7 @@
         DYNAMIC_TYPE_NAME_ENTRY   = 90,
         DYNAMIC_TYPE_CURVE448     = 91,
         DYNAMIC_TYPE_ED448        = 92,
+        DYNAMIC_TYPE_SESSION_CACHE= 93,
         DYNAMIC_TYPE_SNIFFER_SERVER     = 1000,
         DYNAMIC_TYPE_SNIFFER_SESSION    = 1001,
         DYNAMIC_TYPE_SNIFFER_PB         = 1002,
@@ -699,8 +700,9 @@
         WC_ALGO_TYPE_RNG = 4,
         WC_ALGO_TYPE_SEED = 5,
         WC_ALGO_TYPE_HMAC = 6,
+        WC_ALGO_TYPE_KDF = 7,
 
-        WC_ALGO_TYPE_MAX = WC_ALGO_TYPE_HMAC
+        WC_ALGO_TYPE_MAX = WC_ALGO_TYPE_KDF
     };
 
     /* hash types */
@@ -763,8 +765,9 @@
         WC_CIPHER_CHACHA = 9,
         WC_CIPHER_HC128 = 10,
         WC_CIPHER_IDEA = 11,
+        WC_CIPHER_CHACHA20_POLY1305 = 12,
 
-        WC_CIPHER_MAX = WC_CIPHER_HC128
+        WC_CIPHER_MAX = WC_CIPHER_CHACHA20_POLY1305
     };
 
     /* PK=public key (asymmetric) based algorithms */
@@ -779,8 +782,20 @@
         WC_PK_TYPE_CURVE25519 = 7,
         WC_PK_TYPE_RSA_KEYGEN = 8,
         WC_PK_TYPE_EC_KEYGEN = 9,
+        WC_PK_TYPE_ED25519_VERIFY = 10,
+        WC_PK_TYPE_ED25519_KEYGEN = 11,
+        WC_PK_TYPE_CURVE25519_KEYGEN = 12,
 
-        WC_PK_TYPE_MAX = WC_PK_TYPE_EC_KEYGEN
+        WC_PK_TYPE_MAX = WC_PK_TYPE_CURVE25519_KEYGEN
+    };
+
+    /* key derivation functions */
+    enum wc_KdfType {
+        WC_KDF_TYPE_NONE = 0,
+        WC_KDF_TYPE_HKDF_EXTRACT = 1,
+        WC_KDF_TYPE_HKDF_EXPAND = 2,
+
+        WC_KDF_TYPE_MAX = WC_KDF_TYPE_HKDF_EXPAND
     };
 
 
@@ -48,6 +48,16 @@
     #endif
 #endif
 
+/* vectored send needs struct iovec */
+#if defined(WOLFSSL_IO_SENDV) && \
+    (defined(NO_WRITEV) || defined(USE_WINDOWS_API) || defined(_WIN32))
+    #undef WOLFSSL_IO_SENDV
+#endif
+#ifdef WOLFSSL_IO_SENDV
+    #include <sys/types.h>
+    #include <sys/uio.h>
+#endif
+
 
 #if defined(USE_WOLFSSL_IO) || defined(HAVE_HTTP_CLIENT)
 
@@ -352,6 +362,10 @@ WOLFSSL_API  int wolfIO_TcpConnect(SOCKET_T* sockfd, const char* ip,
     unsigned short port, int to_sec);
 WOLFSSL_API  int wolfIO_Send(SOCKET_T sd, char *buf, int sz, int wrFlags);
 WOLFSSL_API  int wolfIO_Recv(SOCKET_T sd, char *buf, int sz, int rdFlags);
+#ifdef WOLFSSL_IO_SENDV
+WOLFSSL_API  int wolfIO_Sendv(SOCKET_T sd, const struct iovec* iov, int iovcnt,
+    int wrFlags);
+#endif
 
 #endif /* USE_WOLFSSL_IO || HAVE_HTTP_CLIENT */
 
@@ -385,6 +399,10 @@ WOLFSSL_API int BioReceive(WOLFSSL* ssl, char* buf, int sz, void* ctx);
     /* default IO callbacks */
     WOLFSSL_API int EmbedReceive(WOLFSSL* ssl, char* buf, int sz, void* ctx);
     WOLFSSL_API int EmbedSend(WOLFSSL* ssl, char* buf, int sz, void* ctx);
+    #ifdef WOLFSSL_IO_SENDV
+        WOLFSSL_API int EmbedSendv(WOLFSSL* ssl, const struct iovec* iov,
+                                   int iovcnt, void* ctx);
+    #endif
 
     #ifdef WOLFSSL_DTLS
         WOLFSSL_API int EmbedReceiveFrom(WOLFSSL* ssl, char* buf, int sz, void*);
@@ -454,6 +472,16 @@ WOLFSSL_API void wolfSSL_SSLSetIOSend(WOLFSSL*, CallbackIOSend);
 #define wolfSSL_SetIORecv wolfSSL_CTX_SetIORecv
 #define wolfSSL_SetIOSend wolfSSL_CTX_SetIOSend
 
+#ifdef WOLFSSL_IO_SENDV
+/* Vectored send: iov holds the pending TLS records in order, one entry per
+ * record. Returns bytes sent or a WOLFSSL_CBIO_ERR_* value. Setting a plain
+ * send callback clears the vectored one, so set this after CallbackIOSend. */
+typedef int (*CallbackIOSendv)(WOLFSSL *ssl, const struct iovec *iov,
+                               int iovcnt, void *ctx);
+WOLFSSL_API void wolfSSL_CTX_SetIOSendv(WOLFSSL_CTX*, CallbackIOSendv);
+WOLFSSL_API void wolfSSL_SSLSetIOSendv(WOLFSSL*, CallbackIOSendv);
+#endif
+
 WOLFSSL_API void wolfSSL_SetIOReadCtx( WOLFSSL* ssl, void *ctx);
 WOLFSSL_API void wolfSSL_SetIOWriteCtx(WOLFSSL* ssl, void *ctx);
 